@@ -0,0 +1,259 @@
+//------------------------------------------------------------------------------
+//  sbc_encode.c
+//
+//  Measures the encoding throughput of sokol_bcenc.h for every output
+//  format and quality tier, and checks the quality of the result by
+//  decoding the blocks again and computing the PSNR against the source
+//  image. Returns a non-zero exit code if a PSNR falls below its minimum,
+//  or if a higher quality tier gives a worse PSNR than a lower one.
+//
+//      cc -O2 -I.. -I../util sbc_encode.c -o sbc_encode -lm
+//------------------------------------------------------------------------------
+#include "sokol_gfx.h"
+#define SOKOL_IMPL
+#include "sokol_time.h"
+#include "sokol_bcenc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define WIDTH (512)
+#define HEIGHT (512)
+#define NUM_ITERS (4)
+
+//== reference decoders ========================================================
+static void decode_565(uint16_t c, int* rgb) {
+    const int r = (c >> 11) & 31;
+    const int g = (c >> 5) & 63;
+    const int b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// the color block of BC1 (and BC3, which always uses 4 colors)
+static void decode_bc1(const uint8_t* b, uint8_t out[16][4], bool always_4_colors) {
+    const uint16_t c0 = (uint16_t)(b[0] | (b[1] << 8));
+    const uint16_t c1 = (uint16_t)(b[2] | (b[3] << 8));
+    int p[4][4];
+    decode_565(c0, p[0]);
+    decode_565(c1, p[1]);
+    p[0][3] = p[1][3] = 255;
+    if ((c0 > c1) || always_4_colors) {
+        for (int c = 0; c < 3; c++) {
+            p[2][c] = (2 * p[0][c] + p[1][c]) / 3;
+            p[3][c] = (p[0][c] + 2 * p[1][c]) / 3;
+        }
+        p[2][3] = p[3][3] = 255;
+    }
+    else {
+        for (int c = 0; c < 3; c++) {
+            p[2][c] = (p[0][c] + p[1][c]) / 2;
+            p[3][c] = 0;
+        }
+        p[2][3] = 255;
+        p[3][3] = 0;
+    }
+    const uint32_t indices = b[4] | (b[5] << 8) | (b[6] << 16) | ((uint32_t)b[7] << 24);
+    for (int i = 0; i < 16; i++) {
+        const int k = (indices >> (2 * i)) & 3;
+        for (int c = 0; c < 4; c++) {
+            out[i][c] = (uint8_t)p[k][c];
+        }
+    }
+}
+
+// a single-channel block of BC4/BC5, and the alpha block of BC3
+static void decode_bc4(const uint8_t* b, uint8_t out[16][4], int channel) {
+    const int v0 = b[0];
+    const int v1 = b[1];
+    int p[8];
+    p[0] = v0;
+    p[1] = v1;
+    if (v0 > v1) {
+        for (int i = 2; i < 8; i++) {
+            p[i] = ((8 - i) * v0 + (i - 1) * v1) / 7;
+        }
+    }
+    else {
+        for (int i = 2; i < 6; i++) {
+            p[i] = ((6 - i) * v0 + (i - 1) * v1) / 5;
+        }
+        p[6] = 0;
+        p[7] = 255;
+    }
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; i++) {
+        indices |= (uint64_t)b[2 + i] << (8 * i);
+    }
+    for (int i = 0; i < 16; i++) {
+        out[i][channel] = (uint8_t)p[(indices >> (3 * i)) & 7];
+    }
+}
+
+static int get_bits(const uint8_t* b, int* pos, int num) {
+    int v = 0;
+    for (int i = 0; i < num; i++, (*pos)++) {
+        v |= ((b[*pos >> 3] >> (*pos & 7)) & 1) << i;
+    }
+    return v;
+}
+
+// BC7 mode 6, the only mode written by the encoder
+static bool decode_bc7(const uint8_t* b, uint8_t out[16][4]) {
+    static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+    int pos = 0;
+    if (get_bits(b, &pos, 7) != 64) {
+        return false;
+    }
+    int e[2][4];
+    for (int c = 0; c < 4; c++) {
+        e[0][c] = get_bits(b, &pos, 7);
+        e[1][c] = get_bits(b, &pos, 7);
+    }
+    const int p0 = get_bits(b, &pos, 1);
+    const int p1 = get_bits(b, &pos, 1);
+    for (int c = 0; c < 4; c++) {
+        e[0][c] = (e[0][c] << 1) | p0;
+        e[1][c] = (e[1][c] << 1) | p1;
+    }
+    for (int i = 0; i < 16; i++) {
+        const int w = weights[get_bits(b, &pos, (i == 0) ? 3 : 4)];
+        for (int c = 0; c < 4; c++) {
+            out[i][c] = (uint8_t)(((64 - w) * e[0][c] + w * e[1][c] + 32) >> 6);
+        }
+    }
+    return true;
+}
+
+//== benchmark =================================================================
+typedef struct {
+    sg_pixel_format fmt;
+    const char* name;
+    int block_size;
+    int num_channels;       // the channels which are compared for the PSNR
+    double min_psnr;        // required in every quality tier
+} format_t;
+
+static const format_t formats[] = {
+    { SG_PIXELFORMAT_BC1_RGBA, "BC1", 8, 3, 30.0 },
+    { SG_PIXELFORMAT_BC3_RGBA, "BC3", 16, 4, 30.0 },
+    { SG_PIXELFORMAT_BC4_R, "BC4", 8, 1, 38.0 },
+    { SG_PIXELFORMAT_BC5_RG, "BC5", 16, 2, 38.0 },
+    { SG_PIXELFORMAT_BC7_RGBA, "BC7", 16, 4, 34.0 },
+};
+
+static const char* quality_names[] = { "", "fast", "normal", "high" };
+
+// returns the PSNR in dB, or a negative value if a block couldn't be decoded
+static double psnr(const format_t* f, const uint8_t* blocks, const uint8_t* pixels) {
+    double sq_err = 0.0;
+    for (int by = 0; by < HEIGHT / 4; by++) {
+        for (int bx = 0; bx < WIDTH / 4; bx++, blocks += f->block_size) {
+            uint8_t out[16][4] = { { 0 } };
+            switch (f->fmt) {
+                case SG_PIXELFORMAT_BC1_RGBA:
+                    decode_bc1(blocks, out, false);
+                    break;
+                case SG_PIXELFORMAT_BC3_RGBA:
+                    decode_bc1(blocks + 8, out, true);
+                    decode_bc4(blocks, out, 3);
+                    break;
+                case SG_PIXELFORMAT_BC4_R:
+                    decode_bc4(blocks, out, 0);
+                    break;
+                case SG_PIXELFORMAT_BC5_RG:
+                    decode_bc4(blocks, out, 0);
+                    decode_bc4(blocks + 8, out, 1);
+                    break;
+                default:
+                    if (!decode_bc7(blocks, out)) {
+                        return -1.0;
+                    }
+                    break;
+            }
+            for (int i = 0; i < 16; i++) {
+                const uint8_t* src = pixels + ((by * 4 + (i >> 2)) * WIDTH + bx * 4 + (i & 3)) * 4;
+                for (int c = 0; c < f->num_channels; c++) {
+                    const double d = (double)out[i][c] - (double)src[c];
+                    sq_err += d * d;
+                }
+            }
+        }
+    }
+    const double mse = sq_err / ((double)WIDTH * HEIGHT * f->num_channels);
+    return (mse == 0.0) ? 99.0 : 10.0 * log10(255.0 * 255.0 / mse);
+}
+
+int main(void) {
+    stm_setup();
+
+    // smooth gradients with some noise, alpha is a horizontal ramp
+    uint8_t* pixels = (uint8_t*) malloc(WIDTH * HEIGHT * 4);
+    uint32_t seed = 1;
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            uint8_t* p = pixels + (y * WIDTH + x) * 4;
+            const float fx = (float)x / WIDTH;
+            const float fy = (float)y / HEIGHT;
+            const float rgb[3] = {
+                127.5f + 127.5f * sinf(fx * 13.0f + fy * 3.0f),
+                255.0f * fx * fy,
+                127.5f + 127.5f * cosf(fy * 9.0f)
+            };
+            for (int c = 0; c < 3; c++) {
+                seed = seed * 1664525u + 1013904223u;
+                const int v = (int)rgb[c] + (int)(seed >> 29) - 4;
+                p[c] = (uint8_t)((v < 0) ? 0 : ((v > 255) ? 255 : v));
+            }
+            p[3] = (uint8_t)(255.0f * fx);
+        }
+    }
+    // BC1 only has 1-bit alpha, so it is tested with an opaque image
+    uint8_t* opaque = (uint8_t*) malloc(WIDTH * HEIGHT * 4);
+    memcpy(opaque, pixels, WIDTH * HEIGHT * 4);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        opaque[i * 4 + 3] = 255;
+    }
+
+    int num_failed = 0;
+    for (size_t fi = 0; fi < sizeof(formats) / sizeof(formats[0]); fi++) {
+        const format_t* f = &formats[fi];
+        const uint8_t* src_pixels = (f->fmt == SG_PIXELFORMAT_BC1_RGBA) ? opaque : pixels;
+        double prev_psnr = 0.0;
+        for (int q = SBC_QUALITY_FAST; q <= SBC_QUALITY_HIGH; q++) {
+            sbc_desc_t desc = {
+                .pixel_format = f->fmt,
+                .quality = (sbc_quality_t)q,
+                .width = WIDTH,
+                .height = HEIGHT,
+            };
+            desc.buffer.size = sbc_buffer_size(&desc);
+            desc.buffer.ptr = malloc((size_t)desc.buffer.size);
+            sg_image_content src = { 0 };
+            src.subimage[0][0].ptr = src_pixels;
+            src.subimage[0][0].size = WIDTH * HEIGHT * 4;
+            sg_image_content dst;
+            bool ok = true;
+            const uint64_t t0 = stm_now();
+            for (int i = 0; i < NUM_ITERS; i++) {
+                ok &= sbc_encode(&desc, &src, &dst);
+            }
+            const double secs = stm_sec(stm_since(t0));
+            const double mpix_per_sec = ((double)WIDTH * HEIGHT * NUM_ITERS) / secs * 1e-6;
+            const double p = ok ? psnr(f, (const uint8_t*)dst.subimage[0][0].ptr, src_pixels) : -1.0;
+            const bool passed = (p >= f->min_psnr) && (p >= prev_psnr - 0.05);
+            printf("%s %-6s: %6.1f Mpixels/s, PSNR %5.2f dB%s\n",
+                f->name, quality_names[q], mpix_per_sec, p, passed ? "" : "  FAILED");
+            if (!passed) {
+                num_failed++;
+            }
+            prev_psnr = p;
+            free(desc.buffer.ptr);
+        }
+    }
+    free(opaque);
+    free(pixels);
+    return (num_failed == 0) ? 0 : 1;
+}
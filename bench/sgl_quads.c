@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+//  sgl_quads.c
+//
+//  Measures how many vertices per second go through sgl_v2f_t2f_c1i()
+//  when recording quads, including sgl_draw() on the dummy backend, and
+//  reports the vertex data uploaded per frame.
+//
+//      cc -O2 -I.. -I../util sgl_quads.c -o sgl_quads -lm
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#include "sokol_gfx.h"
+#include "sokol_time.h"
+#include "sokol_gl.h"
+#include <stdio.h>
+
+#define NUM_QUADS (10000)
+#define NUM_FRAMES (500)
+
+int main(void) {
+    stm_setup();
+    sg_setup(&(sg_desc){ 0 });
+    sgl_setup(&(sgl_desc_t){ .max_vertices = 1<<16 });
+
+    int upload_bytes = 0;
+    const uint64_t start = stm_now();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        sgl_begin_quads();
+        for (int i = 0; i < NUM_QUADS; i++) {
+            const float x = (float)(i & 127);
+            const float y = (float)(i >> 7);
+            sgl_v2f_t2f_c1i(x, y, 0.0f, 0.0f, 0xFFFFFFFF);
+            sgl_v2f_t2f_c1i(x + 1.0f, y, 1.0f, 0.0f, 0xFFFFFFFF);
+            sgl_v2f_t2f_c1i(x + 1.0f, y + 1.0f, 1.0f, 1.0f, 0xFFFFFFFF);
+            sgl_v2f_t2f_c1i(x, y + 1.0f, 0.0f, 1.0f, 0xFFFFFFFF);
+        }
+        sgl_end();
+        sg_begin_default_pass(&(sg_pass_action){ 0 }, 640, 480);
+        sgl_draw();
+        sg_end_pass();
+        sg_commit();
+        upload_bytes = sg_dummy_query_frame_stats().upload_bytes;
+    }
+    const double secs = stm_sec(stm_since(start));
+    const double num_vertices = (double)NUM_QUADS * 4 * NUM_FRAMES;
+    printf("sgl_v2f_t2f_c1i: %.1f Mvertices/s, %d quads per frame, %d bytes uploaded per frame\n",
+        num_vertices / secs * 1e-6, NUM_QUADS, upload_bytes);
+
+    const int failed = (sgl_error() != SGL_NO_ERROR);
+    if (failed) {
+        printf("sgl_error() reported an error\n");
+    }
+    sgl_shutdown();
+    sg_shutdown();
+    return failed;
+}
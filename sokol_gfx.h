@@ -21,6 +21,7 @@
         #define SOKOL_D3D11
         #define SOKOL_METAL
         #define SOKOL_WGPU
+        #define SOKOL_SW
         #define SOKOL_DUMMY_BACKEND
 
     I.e. for the GL 3.3 Core Profile it should look like this:
@@ -35,6 +36,11 @@
     stub functions. This is useful for writing tests that need to run on the
     command line.
 
+    The SOKOL_SW backend is a multithreaded software rasterizer which
+    renders into CPU memory, it needs no GPU or window system and can be
+    used for headless rendering (e.g. thumbnails or reference images in
+    automated tests). See the section SOFTWARE RASTERIZER below for details.
+
     Optionally provide the following defines with your own implementations:
 
     SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
@@ -46,6 +52,7 @@
     SOKOL_API_DECL      - same as SOKOL_GFX_API_DECL
     SOKOL_API_IMPL      - public function implementation prefix (default: -)
     SOKOL_TRACE_HOOKS   - enable trace hook callbacks (search below for TRACE HOOKS)
+    SOKOL_PROFILER      - enable the CPU pass- and debug-group profiler (search below for PROFILER)
 
     If sokol_gfx.h is compiled as a DLL, define the following before
     including the declaration or implementation:
@@ -239,6 +246,12 @@
 
             bool sg_query_buffer_overflow(sg_buffer buf)
 
+        ...or check upfront whether appending a number of bytes in the
+        current frame would overflow the buffer (this is useful to skip
+        the sg_append_buffer() call, which would fail validation):
+
+            bool sg_query_buffer_will_overflow(sg_buffer buf, int data_size)
+
         NOTE: Due to restrictions in underlying 3D-APIs, appended chunks of
         data will be 4-byte aligned in the destination buffer. This means
         that there will be gaps in index buffers containing 16-bit indices
@@ -247,6 +260,102 @@
         is associated with one draw call, but will be problematic when
         a single indexed draw call spans several appended chunks of indices.
 
+    --- to update dynamic or stream images without blocking the render
+        thread on a copy from client memory, reserve sokol_gfx owned staging
+        memory, write the pixel data into it, and queue the upload:
+
+            sg_image_upload upload = sg_begin_image_upload(img);
+            if (upload.id != SG_INVALID_ID) {
+                for each face and mipmap:
+                    memcpy(upload.subimage[face][mip].ptr, ..., upload.subimage[face][mip].size);
+                sg_end_image_upload(&upload);
+            }
+
+        The actual texture update happens in sg_commit(), before that the
+        upload counts as a regular image update for the current frame
+        (so no sg_update_image() on the same image in the same frame).
+        sg_begin_image_upload() and sg_end_image_upload() must be called
+        in the same frame. The progress of an upload can be checked with:
+
+            sg_upload_state sg_query_image_upload_state(uint32_t upload_id)
+
+        On the GL 3.3 backend, the staging memory is a mapped pixel unpack
+        buffer, so that the driver can copy the pixel data asynchronously,
+        on all other backends it's CPU memory which is copied into the
+        texture in sg_commit(). There is one staging buffer of
+        sg_desc.upload_buffer_size bytes per frame in flight, staging
+        memory is allocated on first use.
+
+    --- to create buffers and images from loader threads without blocking
+        on the render thread, reserve a resource id and enqueue the
+        initialization (both functions can be called from any thread):
+
+            sg_image img = sg_reserve_image();
+            if (img.id != SG_INVALID_ID) {
+                sg_enqueue_init_image(img, &(sg_image_desc){ ... });
+            }
+
+        sg_enqueue_init_buffer() and sg_enqueue_init_image() copy the
+        desc struct including all content data and the label string, so
+        the loader thread can free its data immediately. The render thread
+        initializes queued resources in sg_commit() until
+        sg_desc.init_queue_frame_budget bytes of content data have been
+        processed, or explicitly (for instance under a time budget) with:
+
+            int sg_process_init_queue(int max_bytes)
+
+        ...which initializes at least one queued resource and returns the
+        number of initialized resources. Until then the reserved
+        resource is in the ALLOC state, the progress can be checked on the
+        render thread with sg_query_buffer_state() or sg_query_image_state().
+        Reserved ids are taken from a pool of sg_desc.reserve_pool_size
+        pre-allocated ids which is refilled in sg_commit(),
+        sg_reserve_buffer() and sg_reserve_image() return an invalid id
+        when the pool is empty. The pool is disabled by default (so that
+        applications which don't create resources on loader threads don't
+        keep idle resource slots allocated), set sg_desc.reserve_pool_size
+        to a non-zero value to enable it.
+
+    --- to avoid hitches when pipelines are created in the middle of a
+        session, record the pipeline descs of a session and create those
+        pipelines upfront in the next session:
+
+            sg_begin_pipeline_recording();
+            ...
+            int size = sg_save_pipeline_recording(0, 0);
+            void* ptr = malloc(size);
+            sg_save_pipeline_recording(ptr, size);
+            // write ptr..size to a file
+            ...
+            sg_end_pipeline_recording();
+
+        While recording, each unique sg_make_pipeline() call adds a compact
+        record to the recording. Shaders are identified by a hash of their
+        sg_shader_desc content, so a record refers to 'the same shader'
+        across sessions, independent of the shader's resource id.
+
+        In the next session, load the recording once after sg_setup():
+
+            bool sg_load_pipeline_warmup(const void* ptr, int num_bytes)
+
+        ...this copies the data and returns false if it isn't a valid
+        recording of the same version. sg_commit() then creates up to
+        sg_desc.pipeline_warmup_frame_budget pipelines per frame, or
+        create them explicitly, for instance all at once behind a
+        loading screen:
+
+            int sg_process_pipeline_warmup(int max_pipelines)
+
+        A record is only created after a shader with the same content
+        hash exists, so shaders should be created first. When
+        sg_make_pipeline() is later called with an identical desc, it
+        returns the pre-created pipeline instead of creating a new one.
+        Note that some GL drivers defer a part of the shader compilation
+        to the first draw call with a new render state combination, which
+        this doesn't prevent. Unclaimed pipelines can be destroyed with
+        sg_discard_pipeline_warmup() and are destroyed in sg_shutdown(),
+        the progress can be checked with sg_query_pipeline_warmup_info().
+
     --- to check at runtime for optional features, limits and pixelformat support,
         call:
 
@@ -276,6 +385,37 @@
         to sokol_gfx.h internals, and may change more often than other
         public API functions and structs.
 
+    --- you can query the estimated GPU memory usage of all buffers and images,
+        broken down by resource type, usage and pixel format with:
+
+            sg_memory_info sg_query_memory_info(void)
+
+        ...and install a callback which is called when resource creation
+        exceeds a memory budget with:
+
+            void sg_set_memory_budget(const sg_memory_budget* budget)
+
+    --- when compiled with SOKOL_DUMMY_BACKEND, sokol_gfx.h records the
+        driver-level operations a real backend would perform after
+        filtering redundant state changes (program switches, render state
+        changes, vertex attribute setups, texture binds, uploads, ...),
+        and weights them with a per-operation cost table into a simulated
+        driver cost score. The results of the last frame are returned by:
+
+            sg_dummy_frame_stats sg_dummy_query_frame_stats(void)
+
+        ...and the cost table can be changed with:
+
+            void sg_dummy_set_driver_costs(const sg_dummy_driver_costs* costs)
+
+        This allows to catch state-thrashing regressions in automated tests
+        without a GPU. On all other backends the returned stats are zero.
+
+    --- when compiled with SOKOL_SW, the rendered pixels of the default
+        framebuffer or a render target image can be read back with:
+
+            bool sg_sw_read_pixels(sg_image img, void* ptr, int num_bytes)
+
     --- you can ask at runtime what backend sokol_gfx.h has been compiled
         for, or whether the GLES3 backend had to fall back to GLES2 with:
 
@@ -470,6 +610,36 @@
 
     https://github.com/floooh/sokol-samples/blob/master/glfw/multiwindow-glfw.c
 
+    Each context keeps a list of its resources, so that sg_discard_context()
+    and sg_shutdown() only need to visit the resources which are actually
+    alive instead of scanning all resource pool slots.
+
+    RESOURCE GROUPS
+    ===============
+    Resource groups allow to destroy a set of resources with a single call,
+    for instance all resources which have been loaded for a game level:
+
+    --- sg_group sg_make_group():
+        Creates a new resource group, the number of groups which can exist
+        at the same time is defined by sg_desc.group_pool_size.
+
+    --- void sg_begin_group(sg_group grp)
+        All resources which are initialized (or set to the failed state)
+        until sg_end_group() is called are added to the group. Note that
+        this happens when the resource is *initialized*, not when its id
+        is allocated, sg_begin_group() and sg_end_group() can't be nested.
+
+    --- void sg_destroy_group(sg_group grp)
+        Destroys all resources in the group (like calling sg_destroy_buffer()
+        etc. on each of them) and the group itself. Resources can also still
+        be destroyed individually, this removes them from the group. Like
+        individual resources, a group's resources must be destroyed under
+        the same context they've been created with, resources of other
+        contexts are removed from the group without being destroyed.
+
+    --- sg_group_info sg_query_group_info(sg_group grp)
+        Returns the number of resources of each type in the group.
+
     TRACE HOOKS:
     ============
     sokol_gfx.h optionally allows to install "trace hook" callbacks for
@@ -499,6 +669,53 @@
     imgui/sokol_gfx_imgui.h header which implements a realtime
     debugging UI for sokol_gfx.h on top of Dear ImGui.
 
+    PROFILER:
+    =========
+    When compiled with SOKOL_PROFILER, sokol_gfx.h measures the CPU time
+    spent on the render thread inside each pass and each debug group
+    (between sg_push_debug_group() and sg_pop_debug_group()). This shows
+    which passes and groups are expensive to record, without an
+    external profiler.
+
+    Each frame (the time between two sg_commit() calls) is recorded as a
+    tree of nodes: passes and debug groups which are pushed multiple
+    times at the same place in the tree within a frame are merged into
+    one node with a call count and the summed duration. The last
+    sg_desc.profiler_num_frames frames are kept in a ring buffer:
+
+        sg_profiler_frame sg_query_profiler_frame(int frames_ago)
+
+    ...returns a completed frame (0 is the frame which was finished
+    by the last sg_commit()). The nodes are stored in the order they were
+    first entered, so a parent is always before its children; use .parent,
+    .first_child and .next_sibling to walk the tree. The node pointer is valid until
+    the frame is overwritten, which is sg_desc.profiler_num_frames
+    sg_commit() calls later. At most sg_desc.profiler_max_nodes nodes are
+    recorded per frame, if more nodes are needed, the frame's overflow
+    flag is set.
+
+    All recorded frames can be exported as Chrome trace JSON, which
+    can be loaded into chrome://tracing or https://ui.perfetto.dev:
+
+        int size = sg_save_profiler_trace(0, 0);
+        char* ptr = malloc(size);
+        sg_save_profiler_trace(ptr, size);
+
+    The returned size includes the terminating zero, the data is only
+    written if the buffer is big enough. Since merged nodes only have a
+    summed duration, each node is written as one event which is moved
+    (if needed) so that it doesn't overlap its siblings and stays inside
+    its parent, the timeline is exact for nodes which were entered once.
+
+    Passes show up with their sg_pass_desc.label, or "default pass",
+    or "pass" if no label was provided. Timestamps are nanoseconds since
+    sg_setup(). Without SOKOL_PROFILER, the profiler functions return
+    empty results.
+
+    The timestamps are taken with the same platform timers as sokol_time.h,
+    on Linux and other POSIX platforms this is clock_gettime(), which
+    needs _POSIX_C_SOURCE >= 199309L when compiling in strict C99 mode.
+
     A NOTE ON PORTABLE PACKED VERTEX FORMATS:
     =========================================
     There are two things to consider when using packed
@@ -531,6 +748,9 @@
 
     - SG_VERTEXFORMAT_UINT10_N2 is not supported on WebGL/GLES2
 
+    - the half-float formats SG_VERTEXFORMAT_HALF2 and SG_VERTEXFORMAT_HALF4
+      are not supported on WebGL/GLES2
+
     So for a vertex input layout which works on all platforms, only use the following
     vertex formats, and if needed "expand" the normalized vertex shader
     inputs in the vertex shader by multiplying with 127.0, 255.0, 32767.0 or
@@ -547,6 +767,68 @@
         - SG_VERTEXFORMAT_SHORT4N,
         - SG_VERTEXFORMAT_USHORT4N
 
+    SOFTWARE RASTERIZER:
+    ====================
+    When compiled with SOKOL_SW, sokol_gfx.h renders on the CPU into
+    memory owned by sokol_gfx.h. The same sequence of sg_* calls which
+    renders on a GPU produces pixels on machines without a GPU, with
+    deterministic results (the output doesn't depend on the number of
+    threads).
+
+    Shaders are plain C functions provided in sg_shader_desc.sw_vs_func and
+    sg_shader_desc.sw_fs_func (see sg_sw_vs_args and sg_sw_fs_args for their
+    inputs and outputs):
+
+        static void vs(sg_sw_vs_args* args) {
+            const params_t* params = (const params_t*) args->uniforms[0];
+            mat44_transform(args->pos, &params->mvp, args->attrs[0]);
+            memcpy(args->varyings, args->attrs[1], 4 * sizeof(float));
+        }
+        static bool fs(sg_sw_fs_args* args) {
+            memcpy(args->color[0], args->varyings, 4 * sizeof(float));
+            return true;
+        }
+        ...
+        sg_shader shd = sg_make_shader(&(sg_shader_desc){
+            .vs.uniform_blocks[0].size = sizeof(params_t),
+            .sw_vs_func = vs,
+            .sw_fs_func = fs,
+            .sw_num_varyings = 4
+        });
+
+    Vertices are processed in sg_draw(), and the resulting triangles are
+    binned into 64x64 pixel screen tiles. The tiles are rasterized in
+    sg_end_pass() on .sw_num_threads threads, 4 pixels at a time with SSE2 or
+    NEON (unless SOKOL_SW_NO_SIMD is defined). Each tile renders its
+    triangles in submission order, so blending and depth testing behave
+    exactly like on a GPU. Images used by a pass must not be updated or
+    destroyed before sg_end_pass() has been called.
+
+    After sg_end_pass(), the pixels of the default framebuffer (which has
+    the size passed to sg_begin_default_pass()) or of a render target image
+    can be copied with:
+
+        bool sg_sw_read_pixels(sg_image img, void* ptr, int num_bytes)
+
+    Pass SG_INVALID_ID as image to read the default framebuffer (always
+    SG_PIXELFORMAT_RGBA8), rows are stored top to bottom without padding.
+
+    Supported features and limitations:
+
+        - only triangle primitives (SG_PRIMITIVETYPE_TRIANGLES and
+          SG_PRIMITIVETYPE_TRIANGLE_STRIP)
+        - only 2D images in the pixel formats R8, RG8, RGBA8, BGRA8, R32F,
+          RG32F, RGBA32F, DEPTH and DEPTH_STENCIL (the stencil part is
+          ignored), textures are sampled from the top mip level
+        - depth testing, blending and face culling are fully supported,
+          stencil operations, depth bias, alpha-to-coverage and MSAA are
+          not supported
+        - triangles are clipped against the near plane, everything outside
+          the viewport and scissor rect is discarded
+        - the worker threads use pthreads or Win32 threads, on emscripten
+          or if SOKOL_SW_NO_THREADS is defined everything runs on the
+          calling thread
+
     TODO:
     ====
     - talk about asynchronous resource creation
@@ -623,6 +905,7 @@ typedef struct sg_shader   { uint32_t id; } sg_shader;
 typedef struct sg_pipeline { uint32_t id; } sg_pipeline;
 typedef struct sg_pass     { uint32_t id; } sg_pass;
 typedef struct sg_context  { uint32_t id; } sg_context;
+typedef struct sg_group    { uint32_t id; } sg_group;
 
 /*
     various compile-time constants
@@ -641,7 +924,9 @@ enum {
     SG_MAX_UB_MEMBERS = 16,
     SG_MAX_VERTEX_ATTRIBUTES = 16,      /* NOTE: actual max vertex attrs can be less on GLES2, see sg_limits! */
     SG_MAX_MIPMAPS = 16,
-    SG_MAX_TEXTUREARRAY_LAYERS = 128
+    SG_MAX_TEXTUREARRAY_LAYERS = 128,
+    SG_SW_MAX_VARYINGS = 16,
+    SG_MAX_PROFILER_NAME_SIZE = 32
 };
 
 /*
@@ -665,6 +950,7 @@ typedef enum sg_backend {
     SG_BACKEND_METAL_SIMULATOR,
     SG_BACKEND_WGPU,
     SG_BACKEND_DUMMY,
+    SG_BACKEND_SW,
 } sg_backend;
 
 /*
@@ -1128,6 +1414,8 @@ typedef enum sg_vertex_format {
     SG_VERTEXFORMAT_SHORT4N,
     SG_VERTEXFORMAT_USHORT4N,
     SG_VERTEXFORMAT_UINT10_N2,
+    SG_VERTEXFORMAT_HALF2,
+    SG_VERTEXFORMAT_HALF4,
     _SG_VERTEXFORMAT_NUM,
     _SG_VERTEXFORMAT_FORCE_U32 = 0x7FFFFFFF
 } sg_vertex_format;
@@ -1543,6 +1831,59 @@ typedef struct sg_image_content {
     sg_subimage_content subimage[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS];
 } sg_image_content;
 
+/*
+    sg_image_upload
+
+    Returned by sg_begin_image_upload(), describes where the pixel
+    data of each subimage must be written into sokol_gfx owned staging
+    memory. The layout of the subimage ranges is the same as for
+    sg_image_content, but the pointers are writable.
+
+    If the staging memory couldn't be reserved, the id will be
+    SG_INVALID_ID and all subimage ranges will be zero.
+
+    The id can be used to query the progress of the upload
+    with sg_query_image_upload_state() until sg_desc.upload_pool_size
+    newer uploads have been started.
+*/
+typedef struct sg_upload_range {
+    void* ptr;          /* pointer into staging memory */
+    int size;           /* size in bytes of the staging range */
+} sg_upload_range;
+
+typedef struct sg_image_upload {
+    uint32_t id;
+    sg_upload_range subimage[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS];
+} sg_image_upload;
+
+/*
+    sg_upload_state
+
+    The state of an asynchronous image upload:
+
+    SG_UPLOADSTATE_INVALID:     the upload id is unknown or has expired
+    SG_UPLOADSTATE_PENDING:     the staging memory has been reserved with
+                                sg_begin_image_upload() but sg_end_image_upload()
+                                hasn't been called yet
+    SG_UPLOADSTATE_QUEUED:      sg_end_image_upload() has been called, the
+                                texture update will happen in sg_commit()
+    SG_UPLOADSTATE_COMPLETE:    the texture update has been issued in sg_commit(),
+                                rendering in the next frame will see the
+                                new image content
+    SG_UPLOADSTATE_FAILED:      the image has been destroyed or updated
+                                otherwise before the upload could happen,
+                                or sg_end_image_upload() wasn't called
+                                in the same frame as sg_begin_image_upload()
+*/
+typedef enum sg_upload_state {
+    SG_UPLOADSTATE_INVALID,
+    SG_UPLOADSTATE_PENDING,
+    SG_UPLOADSTATE_QUEUED,
+    SG_UPLOADSTATE_COMPLETE,
+    SG_UPLOADSTATE_FAILED,
+    _SG_UPLOADSTATE_FORCE_U32 = 0x7FFFFFFF
+} sg_upload_state;
+
 /*
     sg_image_desc
 
@@ -1650,6 +1991,64 @@ typedef struct sg_image_desc {
     uint32_t _end_canary;
 } sg_image_desc;
 
+/*
+    sg_sw_texture, sg_sw_vs_args, sg_sw_fs_args
+
+    Shader functions for the SOKOL_SW software rasterizer backend.
+
+    The vertex shader function is called once per vertex with the vertex
+    attributes converted to floats (missing components are filled with
+    0.0, and 1.0 for the 4th component), and must write the clip space
+    position to args->pos, and args->num_varyings floats to args->varyings.
+
+    The fragment shader function is called once per fragment with the
+    perspective-correct interpolated varyings and must write the output
+    colors to args->color[] (one per color attachment). If it returns false,
+    the fragment is discarded.
+
+    Clip space and the framebuffer follow the D3D11/Metal conventions: the
+    visible depth range is 0.0 <= z <= w, and the framebuffer and texture
+    origin is in the top-left corner (sg_features.origin_top_left is true).
+
+    Uniform blocks are passed as pointers to the data provided in
+    sg_apply_uniforms(), and textures as sg_sw_texture pointers which can be
+    sampled with sg_sw_sample(). Shader functions are called from the
+    rasterizer worker threads and must not modify shared state.
+*/
+typedef struct sg_sw_texture {
+    int width;
+    int height;
+    int pitch;                      /* bytes per pixel row */
+    sg_pixel_format pixel_format;
+    sg_filter filter;               /* NEAREST or LINEAR (top mip level only) */
+    sg_wrap wrap_u;
+    sg_wrap wrap_v;
+    const void* pixels;             /* 0 if no image is bound */
+} sg_sw_texture;
+
+typedef struct sg_sw_vs_args {
+    float attrs[SG_MAX_VERTEX_ATTRIBUTES][4];           /* in: vertex attributes */
+    const void* uniforms[SG_MAX_SHADERSTAGE_UBS];       /* in: uniform blocks */
+    const sg_sw_texture* textures[SG_MAX_SHADERSTAGE_IMAGES]; /* in: textures */
+    int vertex_index;                                   /* in: index of the vertex */
+    int instance_index;                                 /* in: index of the instance */
+    int num_varyings;                                   /* in: number of varyings to write */
+    float pos[4];                                       /* out: clip space position */
+    float varyings[SG_SW_MAX_VARYINGS];                 /* out: vertex shader outputs */
+} sg_sw_vs_args;
+
+typedef struct sg_sw_fs_args {
+    float varyings[SG_SW_MAX_VARYINGS];                 /* in: interpolated vertex shader outputs */
+    float frag_coord[4];                                /* in: window space x, y, depth and 1/w */
+    bool front_facing;                                  /* in: true if the triangle is front facing */
+    const void* uniforms[SG_MAX_SHADERSTAGE_UBS];       /* in: uniform blocks */
+    const sg_sw_texture* textures[SG_MAX_SHADERSTAGE_IMAGES]; /* in: textures */
+    float color[SG_MAX_COLOR_ATTACHMENTS][4];           /* out: fragment colors */
+} sg_sw_fs_args;
+
+typedef void (*sg_sw_vs_func)(sg_sw_vs_args* args);
+typedef bool (*sg_sw_fs_func)(sg_sw_fs_args* args);
+
 /*
     sg_shader_desc
 
@@ -1683,6 +2082,11 @@ typedef struct sg_image_desc {
     source code, you can provide an optional target string via
     sg_shader_stage_desc.d3d11_target, the default target is "vs_4_0" for the
     vertex shader stage and "ps_4_0" for the pixel shader stage.
+
+    For the SOKOL_SW backend, the shader stages are C functions which
+    must be provided in sg_shader_desc.sw_vs_func and .sw_fs_func, together
+    with the number of float varyings written by the vertex shader function
+    in .sw_num_varyings (see sg_sw_vs_args and sg_sw_fs_args).
 */
 typedef struct sg_shader_attr_desc {
     const char* name;           /* GLSL vertex attribute name (only required for GLES2) */
@@ -1722,6 +2126,9 @@ typedef struct sg_shader_desc {
     sg_shader_attr_desc attrs[SG_MAX_VERTEX_ATTRIBUTES];
     sg_shader_stage_desc vs;
     sg_shader_stage_desc fs;
+    sg_sw_vs_func sw_vs_func;   /* SOKOL_SW: vertex shader function */
+    sg_sw_fs_func sw_fs_func;   /* SOKOL_SW: fragment shader function */
+    int sw_num_varyings;        /* SOKOL_SW: number of floats passed from vertex to fragment shader */
     const char* label;
     uint32_t _end_canary;
 } sg_shader_desc;
@@ -1891,6 +2298,9 @@ typedef struct sg_pipeline_desc {
     - the same sample count
 
     In addition, all color-attachment images must have the same pixel format.
+
+    The optional .label is passed to the trace hooks, and is used as the
+    pass name by the profiler (see PROFILER).
 */
 typedef struct sg_attachment_desc {
     sg_image image;
@@ -1934,6 +2344,8 @@ typedef struct sg_trace_hooks {
     void (*update_buffer)(sg_buffer buf, const void* data_ptr, int data_size, void* user_data);
     void (*update_image)(sg_image img, const sg_image_content* data, void* user_data);
     void (*append_buffer)(sg_buffer buf, const void* data_ptr, int data_size, int result, void* user_data);
+    void (*begin_image_upload)(sg_image img, const sg_image_upload* result, void* user_data);
+    void (*end_image_upload)(const sg_image_upload* upload, void* user_data);
     void (*begin_default_pass)(const sg_pass_action* pass_action, int width, int height, void* user_data);
     void (*begin_pass)(sg_pass pass, const sg_pass_action* pass_action, void* user_data);
     void (*apply_viewport)(int x, int y, int width, int height, bool origin_top_left, void* user_data);
@@ -2040,6 +2452,232 @@ typedef struct sg_pass_info {
     sg_slot_info slot;              /* resource pool slot info */
 } sg_pass_info;
 
+typedef struct sg_group_info {
+    sg_slot_info slot;              /* resource pool slot info */
+    int num_buffers;                /* number of initialized resources in the group */
+    int num_images;
+    int num_shaders;
+    int num_pipelines;
+    int num_passes;
+} sg_group_info;
+
+/*
+    sg_memory_info
+
+    Estimated GPU memory usage of all valid buffer and image resources,
+    returned by sg_query_memory_info(). The numbers are computed from
+    the resource creation parameters, the actual memory usage in the
+    3D-API driver will differ because of alignment, padding, compression
+    or driver-side shadow copies.
+
+    Dynamic- and stream-usage resources are counted SG_NUM_INFLIGHT_FRAMES
+    times because sokol_gfx rotates through that many copies of the
+    3D-API objects, multisampled render targets additionally count the
+    MSAA surface.
+
+    .total_bytes            overall estimated size of all buffers and images
+    .buffer_bytes           size of all buffers
+    .image_bytes            size of all images (including render targets)
+    .render_target_bytes    size of render target images only
+    .usage_bytes[]          size of all buffers and images per sg_usage
+    .pixelformat_bytes[]    size of all images per sg_pixel_format
+    .num_buffers            number of accounted buffers
+    .num_images             number of accounted images
+*/
+typedef struct sg_memory_info {
+    uint64_t total_bytes;
+    uint64_t buffer_bytes;
+    uint64_t image_bytes;
+    uint64_t render_target_bytes;
+    uint64_t usage_bytes[_SG_USAGE_NUM];
+    uint64_t pixelformat_bytes[_SG_PIXELFORMAT_NUM];
+    int num_buffers;
+    int num_images;
+} sg_memory_info;
+
+/*
+    sg_pipeline_warmup_info
+
+    Returned by sg_query_pipeline_warmup_info(), see the pipeline
+    warm-up entry in the STEP BY STEP section.
+
+    .num_recorded   number of unique pipelines in the current recording
+    .num_pending    loaded pipelines which haven't been created yet
+    .num_created    pipelines which have been created, but not yet
+                    claimed by sg_make_pipeline()
+    .num_claimed    pipelines handed out by sg_make_pipeline()
+    .num_failed     pipelines which failed to be created
+*/
+typedef struct sg_pipeline_warmup_info {
+    int num_recorded;
+    int num_pending;
+    int num_created;
+    int num_claimed;
+    int num_failed;
+} sg_pipeline_warmup_info;
+
+/*
+    sg_profiler_frame
+
+    A frame recorded by the profiler (see the PROFILER section), returned
+    by sg_query_profiler_frame(). All times are in nanoseconds, timestamps
+    are relative to sg_setup().
+
+    .valid          false if the frame doesn't exist (yet)
+    .frame_index    the frame counter value of the frame
+    .start_ns       the time of the sg_commit() which started the frame
+    .duration_ns    the time until the sg_commit() which finished the frame
+    .overflow       true if nodes were dropped (see sg_desc.profiler_max_nodes)
+    .num_nodes      number of items in .nodes
+    .nodes          the pass- and debug-group nodes, parents before children
+
+    sg_profiler_node:
+
+    .type           SG_PROFILERNODETYPE_PASS or SG_PROFILERNODETYPE_GROUP
+    .name           the debug group name or pass label (truncated)
+    .pass           the pass object of offscreen passes
+    .parent         index of the parent node, or -1
+    .first_child    index of the first child node, or -1
+    .next_sibling   index of the next node with the same parent, or -1
+    .depth          nesting depth, root nodes are 0
+    .num_calls      how often the node was entered in this frame
+    .start_ns       the time the node was first entered
+    .duration_ns    the summed time of all calls
+*/
+typedef enum sg_profiler_node_type {
+    SG_PROFILERNODETYPE_PASS,
+    SG_PROFILERNODETYPE_GROUP,
+    _SG_PROFILERNODETYPE_FORCE_U32 = 0x7FFFFFFF
+} sg_profiler_node_type;
+
+typedef struct sg_profiler_node {
+    sg_profiler_node_type type;
+    char name[SG_MAX_PROFILER_NAME_SIZE];
+    sg_pass pass;
+    int parent;
+    int first_child;
+    int next_sibling;
+    int depth;
+    int num_calls;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+} sg_profiler_node;
+
+typedef struct sg_profiler_frame {
+    bool valid;
+    uint32_t frame_index;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    bool overflow;
+    int num_nodes;
+    const sg_profiler_node* nodes;
+} sg_profiler_frame;
+
+/*
+    sg_memory_budget
+
+    Used with sg_set_memory_budget() to install a callback which is
+    called whenever the creation of a buffer or image resource leaves the
+    estimated memory usage (sg_memory_info.total_bytes) above num_bytes.
+    The callback is called at the end of the resource creation function
+    and may destroy resources (for instance to evict streamed textures).
+
+    A num_bytes value of 0 disables the budget check.
+*/
+typedef struct sg_memory_budget {
+    uint64_t num_bytes;
+    void (*exceeded_cb)(const sg_memory_info* info);
+    void (*exceeded_userdata_cb)(const sg_memory_info* info, void* user_data);
+    void* user_data;
+} sg_memory_budget;
+
+/*
+    sg_dummy_op
+
+    The driver-level operations which are recorded by the dummy backend,
+    these are the operations a real backend would perform after its own
+    redundant-state filtering:
+
+    SG_DUMMYOP_PASS:            a render target switch in sg_begin_pass()
+                                or sg_begin_default_pass()
+    SG_DUMMYOP_VIEWPORT:        sg_apply_viewport()
+    SG_DUMMYOP_SCISSOR:         sg_apply_scissor_rect()
+    SG_DUMMYOP_PROGRAM:         a shader program switch
+    SG_DUMMYOP_RENDER_STATE:    a depth-stencil-, blend- or rasterizer-state change
+    SG_DUMMYOP_VERTEX_ATTR:     a vertex attribute setup (one per changed attribute)
+    SG_DUMMYOP_INDEX_BUFFER:    an index buffer bind
+    SG_DUMMYOP_TEXTURE:         a texture bind (one per changed texture slot)
+    SG_DUMMYOP_UNIFORMS:        a uniform block update
+    SG_DUMMYOP_DRAW:            a draw call
+    SG_DUMMYOP_BUFFER_UPLOAD:   a buffer content upload (creation, update or append)
+    SG_DUMMYOP_IMAGE_UPLOAD:    an image content upload (creation or update)
+    SG_DUMMYOP_CREATE:          a resource object creation
+    SG_DUMMYOP_DESTROY:         a resource object destruction
+*/
+typedef enum sg_dummy_op {
+    SG_DUMMYOP_PASS,
+    SG_DUMMYOP_VIEWPORT,
+    SG_DUMMYOP_SCISSOR,
+    SG_DUMMYOP_PROGRAM,
+    SG_DUMMYOP_RENDER_STATE,
+    SG_DUMMYOP_VERTEX_ATTR,
+    SG_DUMMYOP_INDEX_BUFFER,
+    SG_DUMMYOP_TEXTURE,
+    SG_DUMMYOP_UNIFORMS,
+    SG_DUMMYOP_DRAW,
+    SG_DUMMYOP_BUFFER_UPLOAD,
+    SG_DUMMYOP_IMAGE_UPLOAD,
+    SG_DUMMYOP_CREATE,
+    SG_DUMMYOP_DESTROY,
+    _SG_DUMMYOP_NUM,
+    _SG_DUMMYOP_FORCE_U32 = 0x7FFFFFFF
+} sg_dummy_op;
+
+/*
+    sg_dummy_driver_costs
+
+    The cost model of the dummy backend, used with
+    sg_dummy_set_driver_costs(). Each recorded operation adds its cost
+    from the op[] table to the frame's driver cost score, uploads
+    additionally cost upload_kbyte per KByte of data.
+
+    The default costs are:
+
+        PASS            20.0
+        VIEWPORT        0.5
+        SCISSOR         0.5
+        PROGRAM         10.0
+        RENDER_STATE    4.0
+        VERTEX_ATTR     1.0
+        INDEX_BUFFER    1.0
+        TEXTURE         2.0
+        UNIFORMS        1.0
+        DRAW            1.0
+        BUFFER_UPLOAD   5.0
+        IMAGE_UPLOAD    10.0
+        CREATE          50.0
+        DESTROY         10.0
+        upload_kbyte    0.1
+*/
+typedef struct sg_dummy_driver_costs {
+    float op[_SG_DUMMYOP_NUM];
+    float upload_kbyte;
+} sg_dummy_driver_costs;
+
+/*
+    sg_dummy_frame_stats
+
+    The driver operations recorded by the dummy backend during the
+    last frame (between the last two calls to sg_commit()), returned
+    by sg_dummy_query_frame_stats().
+*/
+typedef struct sg_dummy_frame_stats {
+    uint32_t frame_index;           /* the frame index of the recorded frame */
+    int num_ops[_SG_DUMMYOP_NUM];   /* number of operations by type */
+    int upload_bytes;               /* number of uploaded bytes */
+    float cost;                     /* simulated driver cost score */
+} sg_dummy_frame_stats;
+
 /*
     sg_desc
 
@@ -2061,9 +2699,77 @@ typedef struct sg_pass_info {
     .pipeline_pool_size     64
     .pass_pool_size         16
     .context_pool_size      16
+    .group_pool_size        16
     .sampler_cache_size     64
     .uniform_buffer_size    4 MB (4*1024*1024)
     .staging_buffer_size    8 MB (8*1024*1024)
+    .upload_buffer_size     4 MB (4*1024*1024)
+    .upload_pool_size       256
+    .validate_cache_size    256
+    .validate_sample_rate   1
+    .reserve_pool_size      0 (disabled)
+    .init_queue_frame_budget 8 MB (8*1024*1024)
+    .pipeline_warmup_frame_budget 4
+    .profiler_num_frames    4 (only with SOKOL_PROFILER)
+    .profiler_max_nodes     256 (only with SOKOL_PROFILER)
+    .sw_num_threads         4
+
+    Thread-safe resource creation options:
+        .reserve_pool_size
+            number of buffer and image ids each which are allocated
+            upfront so that sg_reserve_buffer() and sg_reserve_image() can
+            hand them out from any thread without locking, the reserve is
+            refilled in sg_commit(), the default of 0 disables the reserve
+            (sg_reserve_buffer() and sg_reserve_image() then always return
+            an invalid id)
+        .init_queue_frame_budget
+            the number of content-data bytes of queued resources which
+            are initialized in sg_commit() (at least one resource is
+            initialized per frame), set this to -1 to disable processing
+            in sg_commit() and call sg_process_init_queue() instead
+
+    Pipeline warm-up options:
+        .pipeline_warmup_frame_budget
+            the number of pipelines from a loaded pipeline recording
+            which are created in sg_commit(), set this to -1 to disable
+            this and call sg_process_pipeline_warmup() instead
+
+    Deferred destruction options:
+        .deferred_destroy
+            if true, sg_destroy_buffer(), sg_destroy_image(), sg_destroy_shader(),
+            sg_destroy_pipeline() and sg_destroy_pass() invalidate the handle
+            immediately, but keep the 3D-API objects alive until all frames
+            which might still use the resource have finished on the GPU,
+            the resource is then released in the (SG_NUM_INFLIGHT_FRAMES + 1)th
+            sg_commit() after the destroy call: the frame which is recorded
+            when the resource is destroyed only goes in flight with the
+            next sg_commit(), and is only guaranteed to be finished once
+            SG_NUM_INFLIGHT_FRAMES more frames have been started
+            (sg_uninit_*() always destroys immediately)
+
+    Profiler options (only used with SOKOL_PROFILER):
+        .profiler_num_frames
+            the number of completed frames which are kept in the
+            profiler's ring buffer
+        .profiler_max_nodes
+            the max number of pass- and debug-group nodes per frame
+
+    Validation options (only used in debug mode):
+        .validate_cache_size
+            number of pipeline/bindings combinations which are remembered
+            after they passed validation in sg_apply_bindings(), remembered
+            combinations are not validated again until a resource object
+            is created or destroyed
+        .validate_sample_rate
+            if this is > 1, only every Nth sg_apply_bindings() call which
+            isn't covered by the validation cache will be fully validated,
+            this trades safety for speed in debug builds
+
+    Software rasterizer options (only used with SOKOL_SW):
+        .sw_num_threads
+            the number of threads which rasterize screen tiles in
+            sg_end_pass(), including the calling thread (so 1 means
+            that no worker threads are started)
 
     .context.color_format: default value depends on selected backend:
         all GL backends:    SG_PIXELFORMAT_RGBA8
@@ -2203,9 +2909,21 @@ typedef struct sg_desc {
     int pipeline_pool_size;
     int pass_pool_size;
     int context_pool_size;
+    int group_pool_size;
     int uniform_buffer_size;
     int staging_buffer_size;
     int sampler_cache_size;
+    int upload_buffer_size;
+    int upload_pool_size;
+    int validate_cache_size;
+    int validate_sample_rate;
+    int reserve_pool_size;
+    int init_queue_frame_budget;
+    int pipeline_warmup_frame_budget;
+    bool deferred_destroy;
+    int profiler_num_frames;
+    int profiler_max_nodes;
+    int sw_num_threads;
     sg_context_desc context;
     uint32_t _end_canary;
 } sg_desc;
@@ -2234,6 +2952,29 @@ SOKOL_GFX_API_DECL void sg_update_buffer(sg_buffer buf, const void* data_ptr, in
 SOKOL_GFX_API_DECL void sg_update_image(sg_image img, const sg_image_content* data);
 SOKOL_GFX_API_DECL int sg_append_buffer(sg_buffer buf, const void* data_ptr, int data_size);
 SOKOL_GFX_API_DECL bool sg_query_buffer_overflow(sg_buffer buf);
+SOKOL_GFX_API_DECL bool sg_query_buffer_will_overflow(sg_buffer buf, int data_size);
+SOKOL_GFX_API_DECL sg_image_upload sg_begin_image_upload(sg_image img);
+SOKOL_GFX_API_DECL void sg_end_image_upload(const sg_image_upload* upload);
+SOKOL_GFX_API_DECL sg_upload_state sg_query_image_upload_state(uint32_t upload_id);
+/* thread-safe resource creation (reserve and enqueue can be called from any thread) */
+SOKOL_GFX_API_DECL sg_buffer sg_reserve_buffer(void);
+SOKOL_GFX_API_DECL sg_image sg_reserve_image(void);
+SOKOL_GFX_API_DECL bool sg_enqueue_init_buffer(sg_buffer buf, const sg_buffer_desc* desc);
+SOKOL_GFX_API_DECL bool sg_enqueue_init_image(sg_image img, const sg_image_desc* desc);
+SOKOL_GFX_API_DECL int sg_process_init_queue(int max_bytes);
+
+/* pipeline warm-up */
+SOKOL_GFX_API_DECL void sg_begin_pipeline_recording(void);
+SOKOL_GFX_API_DECL int sg_save_pipeline_recording(void* ptr, int num_bytes);
+SOKOL_GFX_API_DECL void sg_end_pipeline_recording(void);
+SOKOL_GFX_API_DECL bool sg_load_pipeline_warmup(const void* ptr, int num_bytes);
+SOKOL_GFX_API_DECL int sg_process_pipeline_warmup(int max_pipelines);
+SOKOL_GFX_API_DECL void sg_discard_pipeline_warmup(void);
+SOKOL_GFX_API_DECL sg_pipeline_warmup_info sg_query_pipeline_warmup_info(void);
+
+/* CPU profiler (only with SOKOL_PROFILER) */
+SOKOL_GFX_API_DECL sg_profiler_frame sg_query_profiler_frame(int frames_ago);
+SOKOL_GFX_API_DECL int sg_save_profiler_trace(char* ptr, int num_bytes);
 
 /* rendering functions */
 SOKOL_GFX_API_DECL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height);
@@ -2253,6 +2994,9 @@ SOKOL_GFX_API_DECL sg_backend sg_query_backend(void);
 SOKOL_GFX_API_DECL sg_features sg_query_features(void);
 SOKOL_GFX_API_DECL sg_limits sg_query_limits(void);
 SOKOL_GFX_API_DECL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt);
+/* estimated GPU memory usage of resources, and a budget callback */
+SOKOL_GFX_API_DECL sg_memory_info sg_query_memory_info(void);
+SOKOL_GFX_API_DECL void sg_set_memory_budget(const sg_memory_budget* budget);
 /* get current state of a resource (INITIAL, ALLOC, VALID, FAILED, INVALID) */
 SOKOL_GFX_API_DECL sg_resource_state sg_query_buffer_state(sg_buffer buf);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_image_state(sg_image img);
@@ -2304,6 +3048,13 @@ SOKOL_GFX_API_DECL sg_context sg_setup_context(void);
 SOKOL_GFX_API_DECL void sg_activate_context(sg_context ctx_id);
 SOKOL_GFX_API_DECL void sg_discard_context(sg_context ctx_id);
 
+/* resource groups (optional) */
+SOKOL_GFX_API_DECL sg_group sg_make_group(void);
+SOKOL_GFX_API_DECL void sg_destroy_group(sg_group grp_id);
+SOKOL_GFX_API_DECL void sg_begin_group(sg_group grp_id);
+SOKOL_GFX_API_DECL void sg_end_group(void);
+SOKOL_GFX_API_DECL sg_group_info sg_query_group_info(sg_group grp_id);
+
 /* Backend-specific helper functions, these may come in handy for mixing
    sokol-gfx rendering with 'native backend' rendering functions.
 
@@ -2319,6 +3070,14 @@ SOKOL_GFX_API_DECL const void* sg_mtl_device(void);
 /* Metal: return __bridge-casted MTLRenderCommandEncoder in current pass (or zero if outside pass) */
 SOKOL_GFX_API_DECL const void* sg_mtl_render_command_encoder(void);
 
+/* Dummy: set the driver cost model, and get the driver operations recorded in the last frame */
+SOKOL_GFX_API_DECL void sg_dummy_set_driver_costs(const sg_dummy_driver_costs* costs);
+SOKOL_GFX_API_DECL sg_dummy_frame_stats sg_dummy_query_frame_stats(void);
+
+/* SW: sample a texture in a shader function, and read back rendered pixels (SG_INVALID_ID for the default framebuffer) */
+SOKOL_GFX_API_DECL void sg_sw_sample(const sg_sw_texture* tex, float u, float v, float* out_rgba);
+SOKOL_GFX_API_DECL bool sg_sw_read_pixels(sg_image img, void* ptr, int num_bytes);
+
 #ifdef __cplusplus
 } /* extern "C" */
 
@@ -2355,8 +3114,8 @@ inline void sg_init_pass(sg_pass pass_id, const sg_pass_desc& desc) { return sg_
 #ifdef SOKOL_GFX_IMPL
 #define SOKOL_GFX_IMPL_INCLUDED (1)
 
-#if !(defined(SOKOL_GLCORE33)||defined(SOKOL_GLES2)||defined(SOKOL_GLES3)||defined(SOKOL_D3D11)||defined(SOKOL_METAL)||defined(SOKOL_WGPU)||defined(SOKOL_DUMMY_BACKEND))
-#error "Please select a backend with SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU or SOKOL_DUMMY_BACKEND"
+#if !(defined(SOKOL_GLCORE33)||defined(SOKOL_GLES2)||defined(SOKOL_GLES3)||defined(SOKOL_D3D11)||defined(SOKOL_METAL)||defined(SOKOL_WGPU)||defined(SOKOL_DUMMY_BACKEND)||defined(SOKOL_SW))
+#error "Please select a backend with SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU, SOKOL_SW or SOKOL_DUMMY_BACKEND"
 #endif
 #include <string.h> /* memset */
 #include <float.h> /* FLT_MAX */
@@ -2601,15 +3360,71 @@ inline void sg_init_pass(sg_pass pass_id, const sg_pass_desc& desc) { return sg_
     #else
         #include <dawn/webgpu.h>
     #endif
+#elif defined(SOKOL_SW)
+    #if defined(SOKOL_SW_NO_THREADS) || defined(__EMSCRIPTEN__)
+        #define _SG_SW_HAS_THREADS (0)
+    #elif defined(_WIN32)
+        #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+        #endif
+        #ifndef NOMINMAX
+        #define NOMINMAX
+        #endif
+        #include <windows.h>
+        #define _SG_SW_HAS_THREADS (1)
+    #else
+        #include <pthread.h>
+        #define _SG_SW_HAS_THREADS (1)
+    #endif
+    #if !defined(SOKOL_SW_NO_SIMD)
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+            #include <emmintrin.h>
+            #define _SG_SW_SSE2 (1)
+        #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+            #include <arm_neon.h>
+            #define _SG_SW_NEON (1)
+        #endif
+    #endif
+    #include <math.h>   /* floorf, ceilf */
+#endif
+#if defined(_MSC_VER)
+    #include <intrin.h> /* _InterlockedCompareExchange etc. */
+#endif
+#if defined(SOKOL_PROFILER)
+    #if defined(_WIN32)
+        #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+        #endif
+        #ifndef NOMINMAX
+        #define NOMINMAX
+        #endif
+        #include <windows.h>
+    #elif defined(__APPLE__) && defined(__MACH__)
+        #include <mach/mach_time.h>
+    #elif defined(__EMSCRIPTEN__)
+        #include <emscripten/emscripten.h>
+    #else
+        #include <time.h>
+    #endif
 #endif
 
 /*=== COMMON BACKEND STUFF ===================================================*/
 
+/* links of a resource in the live lists of its context and group (slot indices, 0 is none) */
+typedef struct {
+    int prev;
+    int next;
+} _sg_live_link_t;
+
 /* resource pool slots */
 typedef struct {
     uint32_t id;
     uint32_t ctx_id;
     sg_resource_state state;
+    uint32_t group_id;
+    _sg_live_link_t ctx_link;
+    _sg_live_link_t group_link;
+    bool retired;       /* destroyed, but still alive for in-flight frames (sg_desc.deferred_destroy) */
 } _sg_slot_t;
 
 /* constants */
@@ -2624,9 +3439,20 @@ enum {
     _SG_DEFAULT_PIPELINE_POOL_SIZE = 64,
     _SG_DEFAULT_PASS_POOL_SIZE = 16,
     _SG_DEFAULT_CONTEXT_POOL_SIZE = 16,
+    _SG_DEFAULT_GROUP_POOL_SIZE = 16,
     _SG_DEFAULT_SAMPLER_CACHE_CAPACITY = 64,
     _SG_DEFAULT_UB_SIZE = 4 * 1024 * 1024,
     _SG_DEFAULT_STAGING_SIZE = 8 * 1024 * 1024,
+    _SG_DEFAULT_UPLOAD_BUFFER_SIZE = 4 * 1024 * 1024,
+    _SG_DEFAULT_UPLOAD_POOL_SIZE = 256,
+    _SG_DEFAULT_VALIDATE_CACHE_SIZE = 256,
+    _SG_DEFAULT_INIT_QUEUE_FRAME_BUDGET = 8 * 1024 * 1024,
+    _SG_DEFAULT_PIPELINE_WARMUP_FRAME_BUDGET = 4,
+    _SG_DEFAULT_PROFILER_NUM_FRAMES = 4,
+    _SG_DEFAULT_PROFILER_MAX_NODES = 256,
+    _SG_PROFILER_MAX_DEPTH = 32,
+    _SG_UPLOAD_ALIGNMENT = 16,
+    _SG_INIT_REQUEST_ALIGNMENT = 16,
 };
 
 /* fixed-size string */
@@ -2728,9 +3554,82 @@ typedef struct {
 
 typedef struct {
     _sg_shader_stage_t stage[SG_NUM_SHADER_STAGES];
+    uint64_t hash;      /* content hash, identifies the shader in pipeline warm-up records */
 } _sg_shader_common_t;
 
+/* 64-bit FNV-1a */
+_SOKOL_PRIVATE uint64_t _sg_hash_bytes(uint64_t h, const void* ptr, int num_bytes) {
+    const uint8_t* p = (const uint8_t*) ptr;
+    for (int i = 0; i < num_bytes; i++) {
+        h = (h ^ p[i]) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+_SOKOL_PRIVATE uint64_t _sg_hash_u32(uint64_t h, uint32_t val) {
+    return _sg_hash_bytes(h, &val, sizeof(val));
+}
+
+_SOKOL_PRIVATE uint64_t _sg_hash_str(uint64_t h, const char* str) {
+    if (str) {
+        h = _sg_hash_bytes(h, str, (int)strlen(str));
+    }
+    /* terminator, so that "ab"+"c" and "a"+"bc" hash differently */
+    return _sg_hash_u32(h, 0xFFFFFFFF);
+}
+
+/* hash everything in a shader desc which identifies the shader, with SOKOL_SW
+   this includes the shader function pointers (which are only stable within
+   one application run)
+*/
+_SOKOL_PRIVATE uint64_t _sg_shader_desc_hash(const sg_shader_desc* desc) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        const sg_shader_attr_desc* attr = &desc->attrs[attr_index];
+        h = _sg_hash_str(h, attr->name);
+        h = _sg_hash_str(h, attr->sem_name);
+        h = _sg_hash_u32(h, (uint32_t)attr->sem_index);
+    }
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        const sg_shader_stage_desc* stage = (stage_index == SG_SHADERSTAGE_VS) ? &desc->vs : &desc->fs;
+        h = _sg_hash_str(h, stage->source);
+        if (stage->byte_code) {
+            h = _sg_hash_bytes(h, stage->byte_code, stage->byte_code_size);
+        }
+        h = _sg_hash_u32(h, (uint32_t)stage->byte_code_size);
+        h = _sg_hash_str(h, stage->entry);
+        h = _sg_hash_str(h, stage->d3d11_target);
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            const sg_shader_uniform_block_desc* ub = &stage->uniform_blocks[ub_index];
+            h = _sg_hash_u32(h, (uint32_t)ub->size);
+            for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+                const sg_shader_uniform_desc* u = &ub->uniforms[u_index];
+                if (u->type == SG_UNIFORMTYPE_INVALID) {
+                    break;
+                }
+                h = _sg_hash_str(h, u->name);
+                h = _sg_hash_u32(h, (uint32_t)u->type);
+                h = _sg_hash_u32(h, (uint32_t)u->array_count);
+            }
+        }
+        for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+            const sg_shader_image_desc* img = &stage->images[img_index];
+            h = _sg_hash_str(h, img->name);
+            h = _sg_hash_u32(h, (uint32_t)img->type);
+            h = _sg_hash_u32(h, (uint32_t)img->sampler_type);
+        }
+    }
+    h = _sg_hash_u32(h, (uint32_t)desc->sw_num_varyings);
+    #if defined(SOKOL_SW)
+    h = _sg_hash_bytes(h, &desc->sw_vs_func, (int)sizeof(desc->sw_vs_func));
+    h = _sg_hash_bytes(h, &desc->sw_fs_func, (int)sizeof(desc->sw_fs_func));
+    #endif
+    h = _sg_hash_str(h, desc->label);
+    return h;
+}
+
 _SOKOL_PRIVATE void _sg_shader_common_init(_sg_shader_common_t* cmn, const sg_shader_desc* desc) {
+    cmn->hash = _sg_shader_desc_hash(desc);
     for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
         const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS) ? &desc->vs : &desc->fs;
         _sg_shader_stage_t* stage = &cmn->stage[stage_index];
@@ -2798,6 +3697,7 @@ typedef struct {
     int num_color_atts;
     _sg_attachment_common_t color_atts[SG_MAX_COLOR_ATTACHMENTS];
     _sg_attachment_common_t ds_att;
+    _sg_str_t label;    /* the pass name in the profiler */
 } _sg_pass_common_t;
 
 _SOKOL_PRIVATE void _sg_pass_common_init(_sg_pass_common_t* cmn, const sg_pass_desc* desc) {
@@ -2941,10 +3841,23 @@ typedef struct {
 } _sg_dummy_shader_t;
 typedef _sg_dummy_shader_t _sg_shader_t;
 
+typedef struct {
+    int vb_index;           /* -1 if attr is not enabled */
+    int offset;
+    int stride;
+    sg_vertex_format format;
+} _sg_dummy_attr_t;
+
 typedef struct {
     _sg_slot_t slot;
     _sg_shader_t* shader;
     _sg_pipeline_common_t cmn;
+    struct {
+        _sg_dummy_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
+        sg_depth_stencil_state depth_stencil;
+        sg_blend_state blend;
+        sg_rasterizer_state rast;
+    } dmy;
 } _sg_dummy_pipeline_t;
 typedef _sg_dummy_pipeline_t _sg_pipeline_t;
 
@@ -2968,6 +3881,37 @@ typedef struct {
 } _sg_dummy_context_t;
 typedef _sg_dummy_context_t _sg_context_t;
 
+/* a buffer or image with its active slot, this is what a real backend binds */
+typedef struct {
+    uint32_t id;
+    int slot;
+} _sg_dummy_binding_t;
+
+typedef struct {
+    _sg_dummy_attr_t attr;
+    _sg_dummy_binding_t vb;
+} _sg_dummy_cache_attr_t;
+
+/* the state a real backend would track to filter redundant state changes */
+typedef struct {
+    uint32_t cur_pipeline_id;
+    uint32_t cur_shader_id;
+    bool render_state_valid;
+    sg_depth_stencil_state depth_stencil;
+    sg_blend_state blend;
+    sg_rasterizer_state rast;
+    _sg_dummy_cache_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
+    _sg_dummy_binding_t ib;
+    _sg_dummy_binding_t textures[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_IMAGES];
+} _sg_dummy_state_cache_t;
+
+typedef struct {
+    sg_dummy_driver_costs costs;
+    _sg_dummy_state_cache_t cache;
+    sg_dummy_frame_stats cur_frame;
+    sg_dummy_frame_stats last_frame;
+} _sg_dummy_backend_t;
+
 /*== GL BACKEND DECLARATIONS =================================================*/
 #elif defined(_SOKOL_ANY_GL)
 typedef struct {
@@ -3123,6 +4067,9 @@ typedef struct {
     bool ext_anisotropic;
     GLint max_anisotropy;
     GLint max_combined_texture_image_units;
+    #if defined(SOKOL_GLCORE33)
+    GLuint upload_pbo[SG_NUM_INFLIGHT_FRAMES];
+    #endif
 } _sg_gl_backend_t;
 
 /*== D3D11 BACKEND DECLARATIONS ==============================================*/
@@ -3524,6 +4471,199 @@ typedef struct {
     _sg_wgpu_ubpool_t ub;
     _sg_wgpu_stagingpool_t staging;
 } _sg_wgpu_backend_t;
+
+/*== SOFTWARE RASTERIZER BACKEND DECLARATIONS ===============================*/
+#elif defined(SOKOL_SW)
+
+enum {
+    _SG_SW_TILE_SHIFT = 6,
+    _SG_SW_TILE_SIZE = (1<<_SG_SW_TILE_SHIFT),
+    _SG_SW_MAX_THREADS = 32,
+    _SG_SW_DEFAULT_NUM_THREADS = 4,
+    _SG_SW_UNIFORM_ALIGNMENT = 16,
+};
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_buffer_common_t cmn;
+    struct {
+        uint8_t* ptr;
+    } sw;
+} _sg_sw_buffer_t;
+typedef _sg_sw_buffer_t _sg_buffer_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_image_common_t cmn;
+    struct {
+        int bytes_per_pixel;
+        uint8_t* ptr;                       /* all mip levels in one allocation */
+        int mip_offsets[SG_MAX_MIPMAPS];
+    } sw;
+} _sg_sw_image_t;
+typedef _sg_sw_image_t _sg_image_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_shader_common_t cmn;
+    struct {
+        sg_sw_vs_func vs_func;
+        sg_sw_fs_func fs_func;
+        int num_varyings;
+    } sw;
+} _sg_sw_shader_t;
+typedef _sg_sw_shader_t _sg_shader_t;
+
+typedef struct {
+    int vb_index;           /* -1 if attr is not enabled */
+    int offset;
+    int stride;
+    sg_vertex_format format;
+    sg_vertex_step step_func;
+    int step_rate;
+} _sg_sw_attr_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_shader_t* shader;
+    _sg_pipeline_common_t cmn;
+    struct {
+        _sg_sw_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
+        sg_primitive_type primitive_type;
+        sg_depth_stencil_state depth_stencil;
+        sg_blend_state blend;
+        sg_cull_mode cull_mode;
+        sg_face_winding face_winding;
+    } sw;
+} _sg_sw_pipeline_t;
+typedef _sg_sw_pipeline_t _sg_pipeline_t;
+
+typedef struct {
+    _sg_image_t* image;
+} _sg_sw_attachment_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_pass_common_t cmn;
+    struct {
+        _sg_sw_attachment_t color_atts[SG_MAX_COLOR_ATTACHMENTS];
+        _sg_sw_attachment_t ds_att;
+    } sw;
+} _sg_sw_pass_t;
+typedef _sg_sw_pass_t _sg_pass_t;
+typedef _sg_attachment_common_t _sg_attachment_t;
+
+typedef struct {
+    _sg_slot_t slot;
+} _sg_sw_context_t;
+typedef _sg_sw_context_t _sg_context_t;
+
+#if _SG_SW_HAS_THREADS
+#if defined(_WIN32)
+typedef HANDLE _sg_sw_thread_t;
+typedef CRITICAL_SECTION _sg_sw_mutex_t;
+typedef CONDITION_VARIABLE _sg_sw_cond_t;
+#else
+typedef pthread_t _sg_sw_thread_t;
+typedef pthread_mutex_t _sg_sw_mutex_t;
+typedef pthread_cond_t _sg_sw_cond_t;
+#endif
+#endif
+
+/* the rasterizer threads, the calling thread is thread 0 */
+typedef struct {
+    int num_threads;
+    #if _SG_SW_HAS_THREADS
+    _sg_sw_thread_t threads[_SG_SW_MAX_THREADS];
+    _sg_sw_mutex_t mutex;
+    _sg_sw_cond_t work_cond;
+    _sg_sw_cond_t done_cond;
+    #endif
+    uint32_t generation;    /* bumped when new work is available */
+    bool quit;
+    int next_tile;
+    int num_tiles;
+    int num_busy;           /* worker threads which haven't finished the current work */
+} _sg_sw_pool_t;
+
+/* a growable array, items are addressed by index since the storage may move */
+typedef struct {
+    uint8_t* ptr;
+    int num;
+    int cap;
+} _sg_sw_array_t;
+
+/* a color render target: one mip level of an image, or the default framebuffer */
+typedef struct {
+    uint8_t* ptr;
+    int pitch;
+    sg_pixel_format format;
+} _sg_sw_surface_t;
+
+/* a vertex shader output */
+typedef struct {
+    float pos[4];
+    float varyings[SG_SW_MAX_VARYINGS];
+} _sg_sw_vertex_t;
+
+/* the state of a draw call which is needed for deferred rasterization */
+typedef struct {
+    const _sg_pipeline_t* pip;
+    int ub_offsets[SG_MAX_SHADERSTAGE_UBS];     /* fragment shader uniforms, -1 if not applied */
+    sg_sw_texture textures[SG_MAX_SHADERSTAGE_IMAGES];
+    int clip_x0, clip_y0, clip_x1, clip_y1;     /* viewport and scissor rect, x1/y1 exclusive */
+} _sg_sw_draw_t;
+
+/* a window-space triangle */
+typedef struct {
+    int draw_index;
+    int v[3];                   /* indices into the vertex array */
+    float a[3], b[3], c[3];     /* edge functions a*x+b*y+c, positive inside */
+    bool top_left[3];           /* pixel centers exactly on the edge are inside */
+    float inv_area;
+    float z[3];
+    float inv_w[3];
+    int x0, y0, x1, y1;         /* covered pixels, x1/y1 exclusive */
+    bool front_facing;
+} _sg_sw_tri_t;
+
+typedef struct {
+    bool valid;
+    bool in_pass;
+    _sg_sw_pool_t pool;
+    /* the default framebuffer */
+    int def_width;
+    int def_height;
+    int def_capacity;           /* in pixels */
+    uint8_t* def_color;         /* RGBA8 */
+    float* def_depth;
+    /* the current pass */
+    int fb_width;
+    int fb_height;
+    int num_color_atts;
+    _sg_sw_surface_t colors[SG_MAX_COLOR_ATTACHMENTS];
+    float* depth;               /* 0 if the pass has no depth buffer */
+    int depth_pitch;            /* in floats */
+    int vp_x, vp_y, vp_w, vp_h;
+    int sc_x, sc_y, sc_w, sc_h;
+    /* the current pipeline and bindings */
+    const _sg_pipeline_t* cur_pipeline;
+    const _sg_buffer_t* vbs[SG_MAX_SHADERSTAGE_BUFFERS];
+    int vb_offsets[SG_MAX_SHADERSTAGE_BUFFERS];
+    const _sg_buffer_t* ib;
+    int ib_offset;
+    sg_sw_texture textures[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_IMAGES];
+    int ub_offsets[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+    /* work recorded in the current pass, rasterized in sg_end_pass() */
+    _sg_sw_array_t uniforms;    /* uint8_t */
+    _sg_sw_array_t verts;       /* _sg_sw_vertex_t */
+    _sg_sw_array_t draws;       /* _sg_sw_draw_t */
+    _sg_sw_array_t tris;        /* _sg_sw_tri_t */
+    _sg_sw_array_t tile_starts; /* int, start of each tile's triangle list in tile_tris */
+    _sg_sw_array_t tile_tris;   /* int, triangle indices binned by tile */
+    int tiles_x;
+    int tiles_y;
+} _sg_sw_backend_t;
 #endif
 
 /*=== RESOURCE POOL DECLARATIONS =============================================*/
@@ -3538,6 +4678,26 @@ typedef struct {
     int* free_queue;
 } _sg_pool_t;
 
+typedef enum {
+    _SG_LIVETYPE_BUFFER,
+    _SG_LIVETYPE_IMAGE,
+    _SG_LIVETYPE_SHADER,
+    _SG_LIVETYPE_PIPELINE,
+    _SG_LIVETYPE_PASS,
+    _SG_LIVETYPE_NUM
+} _sg_live_type_t;
+
+/* the initialized (VALID or FAILED) resources of a context or group, per resource type */
+typedef struct {
+    int first[_SG_LIVETYPE_NUM];
+    int count[_SG_LIVETYPE_NUM];
+} _sg_live_list_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_live_list_t live;
+} _sg_group_t;
+
 typedef struct {
     _sg_pool_t buffer_pool;
     _sg_pool_t image_pool;
@@ -3545,12 +4705,16 @@ typedef struct {
     _sg_pool_t pipeline_pool;
     _sg_pool_t pass_pool;
     _sg_pool_t context_pool;
+    _sg_pool_t group_pool;
     _sg_buffer_t* buffers;
     _sg_image_t* images;
     _sg_shader_t* shaders;
     _sg_pipeline_t* pipelines;
     _sg_pass_t* passes;
     _sg_context_t* contexts;
+    _sg_group_t* groups;
+    /* live resources per context slot, slot 0 has the resources created without a context */
+    _sg_live_list_t* ctx_live;
 } _sg_pools_t;
 
 /*=== VALIDATION LAYER DECLARATIONS ==========================================*/
@@ -3582,6 +4746,8 @@ typedef enum {
     _SG_VALIDATE_SHADERDESC_SOURCE,
     _SG_VALIDATE_SHADERDESC_BYTECODE,
     _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE,
+    _SG_VALIDATE_SHADERDESC_SW_FUNCS,
+    _SG_VALIDATE_SHADERDESC_SW_VARYINGS,
     _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE,
     _SG_VALIDATE_SHADERDESC_NO_CONT_UBS,
     _SG_VALIDATE_SHADERDESC_NO_CONT_IMGS,
@@ -3674,25 +4840,211 @@ typedef enum {
     _SG_VALIDATE_UPDIMG_NOTENOUGHDATA,
     _SG_VALIDATE_UPDIMG_SIZE,
     _SG_VALIDATE_UPDIMG_COMPRESSED,
-    _SG_VALIDATE_UPDIMG_ONCE
+    _SG_VALIDATE_UPDIMG_ONCE,
+
+    /* sg_begin_image_upload validation */
+    _SG_VALIDATE_UPLOADIMG_USAGE,
+    _SG_VALIDATE_UPLOADIMG_COMPRESSED,
+    _SG_VALIDATE_UPLOADIMG_ONCE,
+
+    /* sg_end_image_upload validation */
+    _SG_VALIDATE_ENDUPLOAD_NOTPENDING
 } _sg_validate_error_t;
 
+#if defined(SOKOL_DEBUG)
+/* remembers pipeline/bindings combinations which passed validation */
+typedef struct {
+    uint32_t epoch;
+    uint32_t pip_id;
+    uint64_t hash;
+    sg_bindings bindings;
+} _sg_validate_cache_item_t;
+
+typedef struct {
+    int size;
+    _sg_validate_cache_item_t* items;
+    uint32_t epoch;         /* bumped when resources are created or destroyed */
+    uint32_t sample_counter;
+} _sg_validate_cache_t;
+#endif
+
 /*=== GENERIC BACKEND STATE ==================================================*/
 
+/* estimated resource memory usage */
 typedef struct {
-    bool valid;
-    sg_desc desc;       /* original desc with default values patched in */
-    uint32_t frame_index;
-    sg_context active_context;
-    sg_pass cur_pass;
-    sg_pipeline cur_pipeline;
-    bool pass_valid;
-    bool bindings_valid;
-    bool next_draw_valid;
-    #if defined(SOKOL_DEBUG)
-    _sg_validate_error_t validate_error;
-    #endif
-    _sg_pools_t pools;
+    sg_memory_info info;
+    sg_memory_budget budget;
+} _sg_mem_t;
+
+/* an asynchronous image upload */
+typedef struct {
+    uint32_t id;
+    uint32_t img_id;
+    sg_upload_state state;
+    int offset;             /* start offset in the frame's staging buffer */
+} _sg_upload_t;
+
+typedef struct {
+    int pool_size;
+    _sg_upload_t* items;    /* ring buffer indexed by (upload_id % pool_size) */
+    uint32_t next_id;       /* id of the next upload */
+    uint32_t frame_id;      /* id of the first upload in the current frame */
+    int pos;                /* allocation offset in the current staging buffer */
+    uint8_t* mapped;        /* current staging buffer, 0 if not mapped */
+    uint8_t* buf[SG_NUM_INFLIGHT_FRAMES];   /* CPU-side staging buffers */
+} _sg_uploads_t;
+
+/* a resource initialization request from sg_enqueue_init_*(), followed
+   by an owned copy of the content data and label string
+*/
+typedef enum {
+    _SG_INITREQUEST_BUFFER,
+    _SG_INITREQUEST_IMAGE,
+} _sg_init_request_type_t;
+
+typedef struct _sg_init_request_t {
+    struct _sg_init_request_t* next;
+    _sg_init_request_type_t type;
+    uint32_t id;
+    int num_bytes;          /* size of the content data, for the per-frame budget */
+    union {
+        sg_buffer_desc buf;
+        sg_image_desc img;
+    } desc;
+} _sg_init_request_t;
+
+/* ring of pre-allocated resource ids, filled by the render thread and
+   drained lock-free by sg_reserve_*() from any thread
+*/
+typedef struct {
+    uint32_t size;          /* power of 2 */
+    uint32_t* ids;
+    volatile uint32_t head; /* advanced by any thread */
+    volatile uint32_t tail; /* advanced by the render thread */
+} _sg_reserve_ring_t;
+
+typedef struct {
+    _sg_reserve_ring_t buffers;
+    _sg_reserve_ring_t images;
+    void* volatile incoming;            /* lock-free LIFO of new _sg_init_request_t */
+    _sg_init_request_t* pending_first;  /* FIFO of requests waiting for the render thread */
+    _sg_init_request_t* pending_last;
+} _sg_init_queue_t;
+
+/* pipeline warm-up: a record is a pipeline desc (with default values patched
+   in) in a compact varint encoding, prefixed with the hash of its shader
+*/
+typedef enum {
+    _SG_WARMUPITEM_PENDING,     /* not created yet, maybe waiting for its shader */
+    _SG_WARMUPITEM_CREATED,     /* created, waiting for sg_make_pipeline() to claim it */
+    _SG_WARMUPITEM_CLAIMED,     /* handed out by sg_make_pipeline() */
+    _SG_WARMUPITEM_FAILED,
+} _sg_warmup_item_state_t;
+
+typedef struct {
+    _sg_warmup_item_state_t state;
+    uint64_t key;           /* hash of the record bytes */
+    uint64_t shader_hash;   /* the shader the pipeline waits for */
+    int offset;             /* record position in _sg_warmup_t.data */
+    int size;
+    uint32_t pip_id;
+} _sg_warmup_item_t;
+
+typedef struct {
+    uint8_t* ptr;
+    int size;
+    int cap;
+} _sg_warmup_buf_t;
+
+typedef struct {
+    /* recording */
+    bool recording;
+    _sg_warmup_buf_t rec;           /* size-prefixed records */
+    _sg_warmup_buf_t rec_keys;      /* uint64_t record hashes to filter duplicates */
+    int num_recorded;
+    /* warm-up */
+    uint8_t* data;                  /* owned copy of the loaded records */
+    _sg_warmup_item_t* items;
+    int num_items;
+    int num_pending;
+    int num_created;
+    int num_claimed;
+    int num_failed;
+    uint32_t shader_epoch;          /* incremented for each initialized shader */
+    uint32_t idle_epoch;            /* shader_epoch when no pending pipeline could be created */
+} _sg_warmup_t;
+
+/* deferred destruction: resources destroyed with sg_desc.deferred_destroy */
+typedef struct {
+    uint32_t frame_index;   /* frame index at which it is safe to release this resource */
+    uint32_t res_id;
+    _sg_live_type_t type;
+} _sg_retire_item_t;
+
+typedef struct {
+    int num_slots;
+    int front;
+    int back;
+    int num;
+    _sg_retire_item_t* queue;
+    _sg_retire_item_t* scratch;     /* the items released in one sg_commit() */
+} _sg_retire_queue_t;
+
+/* CPU profiler, only with SOKOL_PROFILER */
+#if defined(SOKOL_PROFILER)
+typedef struct {
+    int node;           /* index into the current frame's nodes, -1 if dropped */
+    uint64_t start;
+} _sg_profiler_open_t;
+
+typedef struct {
+    bool valid;
+    int num_frames;                 /* completed frames plus the frame being recorded */
+    int max_nodes;
+    int cur_frame;
+    sg_profiler_frame* frames;
+    sg_profiler_node* nodes;        /* num_frames * max_nodes */
+    int depth;
+    int skip_depth;                 /* pushes beyond _SG_PROFILER_MAX_DEPTH */
+    _sg_profiler_open_t stack[_SG_PROFILER_MAX_DEPTH];
+    #if defined(_WIN32)
+    LARGE_INTEGER freq;
+    LARGE_INTEGER start;
+    #elif defined(__APPLE__) && defined(__MACH__)
+    mach_timebase_info_data_t timebase;
+    uint64_t start;
+    #elif defined(__EMSCRIPTEN__)
+    double start;
+    #else
+    uint64_t start;
+    #endif
+} _sg_profiler_t;
+#endif
+
+typedef struct {
+    bool valid;
+    sg_desc desc;       /* original desc with default values patched in */
+    uint32_t frame_index;
+    sg_context active_context;
+    sg_group active_group;
+    sg_pass cur_pass;
+    sg_pipeline cur_pipeline;
+    bool pass_valid;
+    bool bindings_valid;
+    bool next_draw_valid;
+    #if defined(SOKOL_DEBUG)
+    _sg_validate_error_t validate_error;
+    _sg_validate_cache_t validate_cache;
+    #endif
+    _sg_pools_t pools;
+    _sg_uploads_t uploads;
+    _sg_init_queue_t init_queue;
+    _sg_warmup_t warmup;
+    _sg_retire_queue_t retire;
+    #if defined(SOKOL_PROFILER)
+    _sg_profiler_t prof;
+    #endif
+    _sg_mem_t mem;
     sg_backend backend;
     sg_features features;
     sg_limits limits;
@@ -3705,6 +5057,10 @@ typedef struct {
     _sg_d3d11_backend_t d3d11;
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_backend_t wgpu;
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_backend_t dmy;
+    #elif defined(SOKOL_SW)
+    _sg_sw_backend_t sw;
     #endif
     #if defined(SOKOL_TRACE_HOOKS)
     sg_trace_hooks hooks;
@@ -3755,6 +5111,8 @@ _SOKOL_PRIVATE int _sg_vertexformat_bytesize(sg_vertex_format fmt) {
         case SG_VERTEXFORMAT_SHORT4N:   return 8;
         case SG_VERTEXFORMAT_USHORT4N:  return 8;
         case SG_VERTEXFORMAT_UINT10_N2: return 4;
+        case SG_VERTEXFORMAT_HALF2:     return 4;
+        case SG_VERTEXFORMAT_HALF4:     return 8;
         case SG_VERTEXFORMAT_INVALID:   return 0;
         default:
             SOKOL_UNREACHABLE;
@@ -3859,6 +5217,8 @@ _SOKOL_PRIVATE int _sg_pixelformat_bytesize(sg_pixel_format fmt) {
         case SG_PIXELFORMAT_BGRA8:
         case SG_PIXELFORMAT_RGB10A2:
         case SG_PIXELFORMAT_RG11B10F:
+        case SG_PIXELFORMAT_DEPTH:
+        case SG_PIXELFORMAT_DEPTH_STENCIL:
             return 4;
 
         case SG_PIXELFORMAT_RG32UI:
@@ -4070,10 +5430,76 @@ _SOKOL_PRIVATE void _sg_resolve_default_pass_action(const sg_pass_action* from,
 /*== DUMMY BACKEND IMPL ======================================================*/
 #if defined(SOKOL_DUMMY_BACKEND)
 
+/*-- driver operation recording ----------------------------------------------*/
+_SOKOL_PRIVATE void _sg_dummy_init_default_costs(sg_dummy_driver_costs* costs) {
+    memset(costs, 0, sizeof(sg_dummy_driver_costs));
+    costs->op[SG_DUMMYOP_PASS] = 20.0f;
+    costs->op[SG_DUMMYOP_VIEWPORT] = 0.5f;
+    costs->op[SG_DUMMYOP_SCISSOR] = 0.5f;
+    costs->op[SG_DUMMYOP_PROGRAM] = 10.0f;
+    costs->op[SG_DUMMYOP_RENDER_STATE] = 4.0f;
+    costs->op[SG_DUMMYOP_VERTEX_ATTR] = 1.0f;
+    costs->op[SG_DUMMYOP_INDEX_BUFFER] = 1.0f;
+    costs->op[SG_DUMMYOP_TEXTURE] = 2.0f;
+    costs->op[SG_DUMMYOP_UNIFORMS] = 1.0f;
+    costs->op[SG_DUMMYOP_DRAW] = 1.0f;
+    costs->op[SG_DUMMYOP_BUFFER_UPLOAD] = 5.0f;
+    costs->op[SG_DUMMYOP_IMAGE_UPLOAD] = 10.0f;
+    costs->op[SG_DUMMYOP_CREATE] = 50.0f;
+    costs->op[SG_DUMMYOP_DESTROY] = 10.0f;
+    costs->upload_kbyte = 0.1f;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_record(sg_dummy_op op) {
+    _sg.dmy.cur_frame.num_ops[op]++;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_record_upload(sg_dummy_op op, int num_bytes) {
+    _sg.dmy.cur_frame.num_ops[op]++;
+    _sg.dmy.cur_frame.upload_bytes += num_bytes;
+}
+
+_SOKOL_PRIVATE int _sg_dummy_image_content_size(const sg_image_content* content) {
+    int num_bytes = 0;
+    for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+        for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+            const sg_subimage_content* sub = &content->subimage[face_index][mip_index];
+            if (sub->ptr) {
+                num_bytes += sub->size;
+            }
+        }
+    }
+    return num_bytes;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_end_frame(void) {
+    sg_dummy_frame_stats* stats = &_sg.dmy.cur_frame;
+    stats->frame_index = _sg.frame_index;
+    stats->cost = ((float)stats->upload_bytes / 1024.0f) * _sg.dmy.costs.upload_kbyte;
+    for (int i = 0; i < _SG_DUMMYOP_NUM; i++) {
+        stats->cost += (float)stats->num_ops[i] * _sg.dmy.costs.op[i];
+    }
+    _sg.dmy.last_frame = *stats;
+    memset(stats, 0, sizeof(sg_dummy_frame_stats));
+}
+
+_SOKOL_PRIVATE void _sg_dummy_clear_state_cache(void) {
+    memset(&_sg.dmy.cache, 0, sizeof(_sg.dmy.cache));
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        _sg.dmy.cache.attrs[i].attr.vb_index = -1;
+    }
+}
+
+_SOKOL_PRIVATE bool _sg_dummy_binding_equal(const _sg_dummy_binding_t* a, const _sg_dummy_binding_t* b) {
+    return (a->id == b->id) && (a->slot == b->slot);
+}
+
 _SOKOL_PRIVATE void _sg_dummy_setup_backend(const sg_desc* desc) {
     SOKOL_ASSERT(desc);
     _SOKOL_UNUSED(desc);
     _sg.backend = SG_BACKEND_DUMMY;
+    _sg_dummy_init_default_costs(&_sg.dmy.costs);
+    _sg_dummy_clear_state_cache();
     for (int i = SG_PIXELFORMAT_R8; i < SG_PIXELFORMAT_BC1_RGBA; i++) {
         _sg.formats[i].sample = true;
         _sg.formats[i].filter = true;
@@ -4090,7 +5516,7 @@ _SOKOL_PRIVATE void _sg_dummy_discard_backend(void) {
 }
 
 _SOKOL_PRIVATE void _sg_dummy_reset_state_cache(void) {
-    /* empty*/
+    _sg_dummy_clear_state_cache();
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_context(_sg_context_t* ctx) {
@@ -4105,61 +5531,87 @@ _SOKOL_PRIVATE void _sg_dummy_destroy_context(_sg_context_t* ctx) {
 }
 
 _SOKOL_PRIVATE void _sg_dummy_activate_context(_sg_context_t* ctx) {
-    SOKOL_ASSERT(ctx);
+    /* NOTE: ctx can be 0 to unset the current context */
     _SOKOL_UNUSED(ctx);
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
     SOKOL_ASSERT(buf && desc);
     _sg_buffer_common_init(&buf->cmn, desc);
+    _sg_dummy_record(SG_DUMMYOP_CREATE);
+    if (desc->content) {
+        _sg_dummy_record_upload(SG_DUMMYOP_BUFFER_UPLOAD, desc->size);
+    }
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf);
     _SOKOL_UNUSED(buf);
+    _sg_dummy_record(SG_DUMMYOP_DESTROY);
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_image(_sg_image_t* img, const sg_image_desc* desc) {
     SOKOL_ASSERT(img && desc);
     _sg_image_common_init(&img->cmn, desc);
+    _sg_dummy_record(SG_DUMMYOP_CREATE);
+    const int num_bytes = _sg_dummy_image_content_size(&desc->content);
+    if (num_bytes > 0) {
+        _sg_dummy_record_upload(SG_DUMMYOP_IMAGE_UPLOAD, num_bytes);
+    }
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_image(_sg_image_t* img) {
     SOKOL_ASSERT(img);
     _SOKOL_UNUSED(img);
+    _sg_dummy_record(SG_DUMMYOP_DESTROY);
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
     SOKOL_ASSERT(shd && desc);
     _sg_shader_common_init(&shd->cmn, desc);
+    _sg_dummy_record(SG_DUMMYOP_CREATE);
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_shader(_sg_shader_t* shd) {
     SOKOL_ASSERT(shd);
     _SOKOL_UNUSED(shd);
+    _sg_dummy_record(SG_DUMMYOP_DESTROY);
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
     SOKOL_ASSERT(pip && desc);
     pip->shader = shd;
     _sg_pipeline_common_init(&pip->cmn, desc);
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        pip->dmy.attrs[attr_index].vb_index = -1;
+    }
     for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
         const sg_vertex_attr_desc* a_desc = &desc->layout.attrs[attr_index];
         if (a_desc->format == SG_VERTEXFORMAT_INVALID) {
             break;
         }
         SOKOL_ASSERT((a_desc->buffer_index >= 0) && (a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
+        _sg_dummy_attr_t* attr = &pip->dmy.attrs[attr_index];
+        attr->vb_index = a_desc->buffer_index;
+        attr->offset = a_desc->offset;
+        attr->stride = desc->layout.buffers[a_desc->buffer_index].stride;
+        attr->format = a_desc->format;
         pip->cmn.vertex_layout_valid[a_desc->buffer_index] = true;
     }
+    pip->dmy.depth_stencil = desc->depth_stencil;
+    pip->dmy.blend = desc->blend;
+    pip->dmy.rast = desc->rasterizer;
+    _sg_dummy_record(SG_DUMMYOP_CREATE);
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
     _SOKOL_UNUSED(pip);
+    _sg_dummy_record(SG_DUMMYOP_DESTROY);
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_pass(_sg_pass_t* pass, _sg_image_t** att_images, const sg_pass_desc* desc) {
@@ -4186,12 +5638,14 @@ _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_pass(_sg_pass_t* pass, _sg_ima
         SOKOL_ASSERT(_sg_is_valid_rendertarget_depth_format(att_images[ds_img_index]->cmn.pixel_format));
         pass->dmy.ds_att.image = att_images[ds_img_index];
     }
+    _sg_dummy_record(SG_DUMMYOP_CREATE);
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_pass(_sg_pass_t* pass) {
     SOKOL_ASSERT(pass);
     _SOKOL_UNUSED(pass);
+    _sg_dummy_record(SG_DUMMYOP_DESTROY);
 }
 
 _SOKOL_PRIVATE _sg_image_t* _sg_dummy_pass_color_image(const _sg_pass_t* pass, int index) {
@@ -4212,6 +5666,7 @@ _SOKOL_PRIVATE void _sg_dummy_begin_pass(_sg_pass_t* pass, const sg_pass_action*
     _SOKOL_UNUSED(action);
     _SOKOL_UNUSED(w);
     _SOKOL_UNUSED(h);
+    _sg_dummy_record(SG_DUMMYOP_PASS);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_end_pass(void) {
@@ -4219,7 +5674,7 @@ _SOKOL_PRIVATE void _sg_dummy_end_pass(void) {
 }
 
 _SOKOL_PRIVATE void _sg_dummy_commit(void) {
-    /* empty */
+    _sg_dummy_end_frame();
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
@@ -4228,6 +5683,7 @@ _SOKOL_PRIVATE void _sg_dummy_apply_viewport(int x, int y, int w, int h, bool or
     _SOKOL_UNUSED(w);
     _SOKOL_UNUSED(h);
     _SOKOL_UNUSED(origin_top_left);
+    _sg_dummy_record(SG_DUMMYOP_VIEWPORT);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
@@ -4236,11 +5692,34 @@ _SOKOL_PRIVATE void _sg_dummy_apply_scissor_rect(int x, int y, int w, int h, boo
     _SOKOL_UNUSED(w);
     _SOKOL_UNUSED(h);
     _SOKOL_UNUSED(origin_top_left);
+    _sg_dummy_record(SG_DUMMYOP_SCISSOR);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
-    _SOKOL_UNUSED(pip);
+    _sg_dummy_state_cache_t* cache = &_sg.dmy.cache;
+    if (cache->cur_pipeline_id == pip->slot.id) {
+        return;
+    }
+    cache->cur_pipeline_id = pip->slot.id;
+    SOKOL_ASSERT(pip->shader);
+    if (cache->cur_shader_id != pip->shader->slot.id) {
+        cache->cur_shader_id = pip->shader->slot.id;
+        _sg_dummy_record(SG_DUMMYOP_PROGRAM);
+    }
+    if (!cache->render_state_valid || (0 != memcmp(&cache->depth_stencil, &pip->dmy.depth_stencil, sizeof(sg_depth_stencil_state)))) {
+        cache->depth_stencil = pip->dmy.depth_stencil;
+        _sg_dummy_record(SG_DUMMYOP_RENDER_STATE);
+    }
+    if (!cache->render_state_valid || (0 != memcmp(&cache->blend, &pip->dmy.blend, sizeof(sg_blend_state)))) {
+        cache->blend = pip->dmy.blend;
+        _sg_dummy_record(SG_DUMMYOP_RENDER_STATE);
+    }
+    if (!cache->render_state_valid || (0 != memcmp(&cache->rast, &pip->dmy.rast, sizeof(sg_rasterizer_state)))) {
+        cache->rast = pip->dmy.rast;
+        _sg_dummy_record(SG_DUMMYOP_RENDER_STATE);
+    }
+    cache->render_state_valid = true;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_bindings(
@@ -4254,11 +5733,58 @@ _SOKOL_PRIVATE void _sg_dummy_apply_bindings(
     SOKOL_ASSERT(vbs && vb_offsets);
     SOKOL_ASSERT(vs_imgs);
     SOKOL_ASSERT(fs_imgs);
-    _SOKOL_UNUSED(pip);
-    _SOKOL_UNUSED(vbs); _SOKOL_UNUSED(vb_offsets); _SOKOL_UNUSED(num_vbs);
-    _SOKOL_UNUSED(ib); _SOKOL_UNUSED(ib_offset);
-    _SOKOL_UNUSED(vs_imgs); _SOKOL_UNUSED(num_vs_imgs);
-    _SOKOL_UNUSED(fs_imgs); _SOKOL_UNUSED(num_fs_imgs);
+    _SOKOL_UNUSED(num_vbs);
+    _SOKOL_UNUSED(ib_offset);
+    _sg_dummy_state_cache_t* cache = &_sg.dmy.cache;
+
+    /* vertex attributes */
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        _sg_dummy_attr_t attr = pip->dmy.attrs[attr_index];
+        _sg_dummy_binding_t vb = { 0, 0 };
+        if (attr.vb_index >= 0) {
+            SOKOL_ASSERT(attr.vb_index < num_vbs);
+            const _sg_buffer_t* buf = vbs[attr.vb_index];
+            vb.id = buf->slot.id;
+            vb.slot = buf->cmn.active_slot;
+            attr.offset += vb_offsets[attr.vb_index];
+        }
+        _sg_dummy_cache_attr_t* cache_attr = &cache->attrs[attr_index];
+        if ((cache_attr->attr.vb_index != attr.vb_index) ||
+            (cache_attr->attr.offset != attr.offset) ||
+            (cache_attr->attr.stride != attr.stride) ||
+            (cache_attr->attr.format != attr.format) ||
+            !_sg_dummy_binding_equal(&cache_attr->vb, &vb))
+        {
+            cache_attr->attr = attr;
+            cache_attr->vb = vb;
+            _sg_dummy_record(SG_DUMMYOP_VERTEX_ATTR);
+        }
+    }
+
+    /* index buffer */
+    _sg_dummy_binding_t ib_binding = { 0, 0 };
+    if (ib) {
+        ib_binding.id = ib->slot.id;
+        ib_binding.slot = ib->cmn.active_slot;
+    }
+    if (!_sg_dummy_binding_equal(&cache->ib, &ib_binding)) {
+        cache->ib = ib_binding;
+        _sg_dummy_record(SG_DUMMYOP_INDEX_BUFFER);
+    }
+
+    /* textures */
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        _sg_image_t** imgs = (stage_index == SG_SHADERSTAGE_VS) ? vs_imgs : fs_imgs;
+        const int num_imgs = (stage_index == SG_SHADERSTAGE_VS) ? num_vs_imgs : num_fs_imgs;
+        for (int img_index = 0; img_index < num_imgs; img_index++) {
+            const _sg_dummy_binding_t tex = { imgs[img_index]->slot.id, imgs[img_index]->cmn.active_slot };
+            _sg_dummy_binding_t* cache_tex = &cache->textures[stage_index][img_index];
+            if (!_sg_dummy_binding_equal(cache_tex, &tex)) {
+                *cache_tex = tex;
+                _sg_dummy_record(SG_DUMMYOP_TEXTURE);
+            }
+        }
+    }
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
@@ -4269,42 +5795,44 @@ _SOKOL_PRIVATE void _sg_dummy_apply_uniforms(sg_shader_stage stage_index, int ub
     _SOKOL_UNUSED(ub_index);
     _SOKOL_UNUSED(data);
     _SOKOL_UNUSED(num_bytes);
+    _sg_dummy_record(SG_DUMMYOP_UNIFORMS);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_draw(int base_element, int num_elements, int num_instances) {
     _SOKOL_UNUSED(base_element);
     _SOKOL_UNUSED(num_elements);
     _SOKOL_UNUSED(num_instances);
+    _sg_dummy_record(SG_DUMMYOP_DRAW);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_update_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size) {
     SOKOL_ASSERT(buf && data && (data_size > 0));
     _SOKOL_UNUSED(data);
-    _SOKOL_UNUSED(data_size);
     if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
         buf->cmn.active_slot = 0;
     }
+    _sg_dummy_record_upload(SG_DUMMYOP_BUFFER_UPLOAD, (int)data_size);
 }
 
 _SOKOL_PRIVATE uint32_t _sg_dummy_append_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size, bool new_frame) {
     SOKOL_ASSERT(buf && data && (data_size > 0));
     _SOKOL_UNUSED(data);
-    _SOKOL_UNUSED(data_size);
     if (new_frame) {
         if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
             buf->cmn.active_slot = 0;
         }
     }
+    _sg_dummy_record_upload(SG_DUMMYOP_BUFFER_UPLOAD, (int)data_size);
     /* NOTE: this is a requirement from WebGPU, but we want identical behaviour across all backend */
     return _sg_roundup(data_size, 4);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_content* data) {
     SOKOL_ASSERT(img && data);
-    _SOKOL_UNUSED(data);
     if (++img->cmn.active_slot >= img->cmn.num_slots) {
         img->cmn.active_slot = 0;
     }
+    _sg_dummy_record_upload(SG_DUMMYOP_IMAGE_UPLOAD, _sg_dummy_image_content_size(data));
 }
 
 /*== GL BACKEND ==============================================================*/
@@ -4365,6 +5893,8 @@ _SOKOL_PRIVATE GLint _sg_gl_vertexformat_size(sg_vertex_format fmt) {
         case SG_VERTEXFORMAT_SHORT4N:   return 4;
         case SG_VERTEXFORMAT_USHORT4N:  return 4;
         case SG_VERTEXFORMAT_UINT10_N2: return 4;
+        case SG_VERTEXFORMAT_HALF2:     return 2;
+        case SG_VERTEXFORMAT_HALF4:     return 4;
         default: SOKOL_UNREACHABLE; return 0;
     }
 }
@@ -4392,6 +5922,9 @@ _SOKOL_PRIVATE GLenum _sg_gl_vertexformat_type(sg_vertex_format fmt) {
             return GL_UNSIGNED_SHORT;
         case SG_VERTEXFORMAT_UINT10_N2:
             return GL_UNSIGNED_INT_2_10_10_10_REV;
+        case SG_VERTEXFORMAT_HALF2:
+        case SG_VERTEXFORMAT_HALF4:
+            return GL_HALF_FLOAT;
         default:
             SOKOL_UNREACHABLE; return 0;
     }
@@ -6915,6 +8448,51 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_content
     _sg_gl_cache_restore_texture_binding(0);
 }
 
+#if defined(SOKOL_GLCORE33)
+/* image upload staging memory is a pixel unpack buffer per frame in flight */
+_SOKOL_PRIVATE void* _sg_gl_map_upload_buffer(int slot, int size) {
+    SOKOL_ASSERT((slot >= 0) && (slot < SG_NUM_INFLIGHT_FRAMES) && (size > 0));
+    if (0 == _sg.gl.upload_pbo[slot]) {
+        glGenBuffers(1, &_sg.gl.upload_pbo[slot]);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.upload_pbo[slot]);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, 0, GL_STREAM_DRAW);
+    }
+    else {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.upload_pbo[slot]);
+    }
+    /* invalidating lets the driver orphan the buffer if the GPU is still busy with it */
+    void* ptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT|GL_MAP_INVALIDATE_BUFFER_BIT);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    _SG_GL_CHECK_ERROR();
+    return ptr;
+}
+
+/* unmap the upload buffer and keep it bound, so that the following
+   glTexSubImage calls source their pixel data from the buffer
+*/
+_SOKOL_PRIVATE void _sg_gl_unmap_upload_buffer(int slot) {
+    SOKOL_ASSERT((slot >= 0) && (slot < SG_NUM_INFLIGHT_FRAMES));
+    SOKOL_ASSERT(0 != _sg.gl.upload_pbo[slot]);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.upload_pbo[slot]);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE void _sg_gl_unbind_upload_buffer(void) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_upload_buffers(void) {
+    for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
+        if (0 != _sg.gl.upload_pbo[i]) {
+            glDeleteBuffers(1, &_sg.gl.upload_pbo[i]);
+            _sg.gl.upload_pbo[i] = 0;
+        }
+    }
+    _SG_GL_CHECK_ERROR();
+}
+#endif
+
 /*== D3D11 BACKEND IMPLEMENTATION ============================================*/
 #elif defined(SOKOL_D3D11)
 
@@ -7463,6 +9041,8 @@ _SOKOL_PRIVATE DXGI_FORMAT _sg_d3d11_vertex_format(sg_vertex_format fmt) {
         case SG_VERTEXFORMAT_SHORT4N:   return DXGI_FORMAT_R16G16B16A16_SNORM;
         case SG_VERTEXFORMAT_USHORT4N:  return DXGI_FORMAT_R16G16B16A16_UNORM;
         case SG_VERTEXFORMAT_UINT10_N2: return DXGI_FORMAT_R10G10B10A2_UNORM;
+        case SG_VERTEXFORMAT_HALF2:     return DXGI_FORMAT_R16G16_FLOAT;
+        case SG_VERTEXFORMAT_HALF4:     return DXGI_FORMAT_R16G16B16A16_FLOAT;
         default: SOKOL_UNREACHABLE; return (DXGI_FORMAT) 0;
     }
 }
@@ -8808,6 +10388,8 @@ _SOKOL_PRIVATE MTLVertexFormat _sg_mtl_vertex_format(sg_vertex_format fmt) {
         case SG_VERTEXFORMAT_SHORT4N:   return MTLVertexFormatShort4Normalized;
         case SG_VERTEXFORMAT_USHORT4N:  return MTLVertexFormatUShort4Normalized;
         case SG_VERTEXFORMAT_UINT10_N2: return MTLVertexFormatUInt1010102Normalized;
+        case SG_VERTEXFORMAT_HALF2:     return MTLVertexFormatHalf2;
+        case SG_VERTEXFORMAT_HALF4:     return MTLVertexFormatHalf4;
         default: SOKOL_UNREACHABLE; return (MTLVertexFormat)0;
     }
 }
@@ -10550,6 +12132,8 @@ _SOKOL_PRIVATE WGPUVertexFormat _sg_wgpu_vertexformat(sg_vertex_format f) {
         case SG_VERTEXFORMAT_SHORT4:        return WGPUVertexFormat_Short4;
         case SG_VERTEXFORMAT_SHORT4N:       return WGPUVertexFormat_Short4Norm;
         case SG_VERTEXFORMAT_USHORT4N:      return WGPUVertexFormat_UShort4Norm;
+        case SG_VERTEXFORMAT_HALF2:         return WGPUVertexFormat_Half2;
+        case SG_VERTEXFORMAT_HALF4:         return WGPUVertexFormat_Half4;
         /* FIXME! UINT10_N2 */
         case SG_VERTEXFORMAT_UINT10_N2:
         default:
@@ -12139,2001 +13723,5197 @@ _SOKOL_PRIVATE void _sg_wgpu_update_image(_sg_image_t* img, const sg_image_conte
     SOKOL_ASSERT(success);
     _SOKOL_UNUSED(success);
 }
-#endif
 
-/*== BACKEND API WRAPPERS ====================================================*/
-static inline void _sg_setup_backend(const sg_desc* desc) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_setup_backend(desc);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_setup_backend(desc);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_setup_backend(desc);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_setup_backend(desc);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_setup_backend(desc);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+/*== SOFTWARE RASTERIZER BACKEND IMPLEMENTATION ==============================*/
+#elif defined(SOKOL_SW)
+
+/*-- 4-wide float helpers ----------------------------------------------------*/
+#if defined(_SG_SW_SSE2)
+typedef __m128 _sg_sw_f4;
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_set1(float f) { return _mm_set1_ps(f); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_load(const float* p) { return _mm_loadu_ps(p); }
+_SOKOL_PRIVATE void _sg_sw_f4_store(float* p, _sg_sw_f4 a) { _mm_storeu_ps(p, a); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_add(_sg_sw_f4 a, _sg_sw_f4 b) { return _mm_add_ps(a, b); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_sub(_sg_sw_f4 a, _sg_sw_f4 b) { return _mm_sub_ps(a, b); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_mul(_sg_sw_f4 a, _sg_sw_f4 b) { return _mm_mul_ps(a, b); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_div(_sg_sw_f4 a, _sg_sw_f4 b) { return _mm_div_ps(a, b); }
+_SOKOL_PRIVATE int _sg_sw_f4_gt(_sg_sw_f4 a, _sg_sw_f4 b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+_SOKOL_PRIVATE int _sg_sw_f4_ge(_sg_sw_f4 a, _sg_sw_f4 b) { return _mm_movemask_ps(_mm_cmpge_ps(a, b)); }
+_SOKOL_PRIVATE int _sg_sw_f4_eq(_sg_sw_f4 a, _sg_sw_f4 b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+#elif defined(_SG_SW_NEON)
+typedef float32x4_t _sg_sw_f4;
+_SOKOL_PRIVATE int _sg_sw_u4_bits(uint32x4_t m) {
+    return (int)((vgetq_lane_u32(m, 0) & 1) | (vgetq_lane_u32(m, 1) & 2) | (vgetq_lane_u32(m, 2) & 4) | (vgetq_lane_u32(m, 3) & 8));
+}
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_set1(float f) { return vdupq_n_f32(f); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_load(const float* p) { return vld1q_f32(p); }
+_SOKOL_PRIVATE void _sg_sw_f4_store(float* p, _sg_sw_f4 a) { vst1q_f32(p, a); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_add(_sg_sw_f4 a, _sg_sw_f4 b) { return vaddq_f32(a, b); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_sub(_sg_sw_f4 a, _sg_sw_f4 b) { return vsubq_f32(a, b); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_mul(_sg_sw_f4 a, _sg_sw_f4 b) { return vmulq_f32(a, b); }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_div(_sg_sw_f4 a, _sg_sw_f4 b) {
+    float fa[4], fb[4];
+    vst1q_f32(fa, a); vst1q_f32(fb, b);
+    for (int i = 0; i < 4; i++) {
+        fa[i] /= fb[i];
+    }
+    return vld1q_f32(fa);
 }
+_SOKOL_PRIVATE int _sg_sw_f4_gt(_sg_sw_f4 a, _sg_sw_f4 b) { return _sg_sw_u4_bits(vcgtq_f32(a, b)); }
+_SOKOL_PRIVATE int _sg_sw_f4_ge(_sg_sw_f4 a, _sg_sw_f4 b) { return _sg_sw_u4_bits(vcgeq_f32(a, b)); }
+_SOKOL_PRIVATE int _sg_sw_f4_eq(_sg_sw_f4 a, _sg_sw_f4 b) { return _sg_sw_u4_bits(vceqq_f32(a, b)); }
+#else
+typedef struct { float v[4]; } _sg_sw_f4;
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_set1(float f) { _sg_sw_f4 r = { { f, f, f, f } }; return r; }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_load(const float* p) { _sg_sw_f4 r = { { p[0], p[1], p[2], p[3] } }; return r; }
+_SOKOL_PRIVATE void _sg_sw_f4_store(float* p, _sg_sw_f4 a) { p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3]; }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_add(_sg_sw_f4 a, _sg_sw_f4 b) { for (int i = 0; i < 4; i++) { a.v[i] += b.v[i]; } return a; }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_sub(_sg_sw_f4 a, _sg_sw_f4 b) { for (int i = 0; i < 4; i++) { a.v[i] -= b.v[i]; } return a; }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_mul(_sg_sw_f4 a, _sg_sw_f4 b) { for (int i = 0; i < 4; i++) { a.v[i] *= b.v[i]; } return a; }
+_SOKOL_PRIVATE _sg_sw_f4 _sg_sw_f4_div(_sg_sw_f4 a, _sg_sw_f4 b) { for (int i = 0; i < 4; i++) { a.v[i] /= b.v[i]; } return a; }
+_SOKOL_PRIVATE int _sg_sw_f4_gt(_sg_sw_f4 a, _sg_sw_f4 b) { int r = 0; for (int i = 0; i < 4; i++) { r |= (a.v[i] > b.v[i]) ? (1<<i) : 0; } return r; }
+_SOKOL_PRIVATE int _sg_sw_f4_ge(_sg_sw_f4 a, _sg_sw_f4 b) { int r = 0; for (int i = 0; i < 4; i++) { r |= (a.v[i] >= b.v[i]) ? (1<<i) : 0; } return r; }
+_SOKOL_PRIVATE int _sg_sw_f4_eq(_sg_sw_f4 a, _sg_sw_f4 b) { int r = 0; for (int i = 0; i < 4; i++) { r |= (a.v[i] == b.v[i]) ? (1<<i) : 0; } return r; }
+#endif
 
-static inline void _sg_discard_backend(void) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_discard_backend();
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_discard_backend();
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_discard_backend();
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_discard_backend();
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_discard_backend();
-    #else
-    #error("INVALID BACKEND");
-    #endif
-}
+/*-- threading ---------------------------------------------------------------*/
+#if _SG_SW_HAS_THREADS
+#if defined(_WIN32)
+_SOKOL_PRIVATE void _sg_sw_mutex_init(_sg_sw_mutex_t* m) { InitializeCriticalSection(m); }
+_SOKOL_PRIVATE void _sg_sw_mutex_discard(_sg_sw_mutex_t* m) { DeleteCriticalSection(m); }
+_SOKOL_PRIVATE void _sg_sw_mutex_lock(_sg_sw_mutex_t* m) { EnterCriticalSection(m); }
+_SOKOL_PRIVATE void _sg_sw_mutex_unlock(_sg_sw_mutex_t* m) { LeaveCriticalSection(m); }
+_SOKOL_PRIVATE void _sg_sw_cond_init(_sg_sw_cond_t* c) { InitializeConditionVariable(c); }
+_SOKOL_PRIVATE void _sg_sw_cond_discard(_sg_sw_cond_t* c) { _SOKOL_UNUSED(c); }
+_SOKOL_PRIVATE void _sg_sw_cond_wait(_sg_sw_cond_t* c, _sg_sw_mutex_t* m) { SleepConditionVariableCS(c, m, INFINITE); }
+_SOKOL_PRIVATE void _sg_sw_cond_broadcast(_sg_sw_cond_t* c) { WakeAllConditionVariable(c); }
+#else
+_SOKOL_PRIVATE void _sg_sw_mutex_init(_sg_sw_mutex_t* m) { pthread_mutex_init(m, 0); }
+_SOKOL_PRIVATE void _sg_sw_mutex_discard(_sg_sw_mutex_t* m) { pthread_mutex_destroy(m); }
+_SOKOL_PRIVATE void _sg_sw_mutex_lock(_sg_sw_mutex_t* m) { pthread_mutex_lock(m); }
+_SOKOL_PRIVATE void _sg_sw_mutex_unlock(_sg_sw_mutex_t* m) { pthread_mutex_unlock(m); }
+_SOKOL_PRIVATE void _sg_sw_cond_init(_sg_sw_cond_t* c) { pthread_cond_init(c, 0); }
+_SOKOL_PRIVATE void _sg_sw_cond_discard(_sg_sw_cond_t* c) { pthread_cond_destroy(c); }
+_SOKOL_PRIVATE void _sg_sw_cond_wait(_sg_sw_cond_t* c, _sg_sw_mutex_t* m) { pthread_cond_wait(c, m); }
+_SOKOL_PRIVATE void _sg_sw_cond_broadcast(_sg_sw_cond_t* c) { pthread_cond_broadcast(c); }
+#endif
+#endif
 
-static inline void _sg_reset_state_cache(void) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_reset_state_cache();
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_reset_state_cache();
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_reset_state_cache();
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_reset_state_cache();
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_reset_state_cache();
-    #else
-    #error("INVALID BACKEND");
-    #endif
+/* forward decl */
+_SOKOL_PRIVATE void _sg_sw_raster_tile(int tile_index);
+
+/* rasterize tiles until no tiles are left, called on all threads */
+_SOKOL_PRIVATE void _sg_sw_run_tiles(void) {
+    _sg_sw_pool_t* pool = &_sg.sw.pool;
+    while (true) {
+        #if _SG_SW_HAS_THREADS
+        _sg_sw_mutex_lock(&pool->mutex);
+        #endif
+        const int tile_index = pool->next_tile++;
+        #if _SG_SW_HAS_THREADS
+        _sg_sw_mutex_unlock(&pool->mutex);
+        #endif
+        if (tile_index >= pool->num_tiles) {
+            break;
+        }
+        _sg_sw_raster_tile(tile_index);
+    }
 }
 
-static inline void _sg_activate_context(_sg_context_t* ctx) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_activate_context(ctx);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_activate_context(ctx);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_activate_context(ctx);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_activate_context(ctx);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_activate_context(ctx);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+#if _SG_SW_HAS_THREADS
+_SOKOL_PRIVATE void _sg_sw_worker_loop(void) {
+    _sg_sw_pool_t* pool = &_sg.sw.pool;
+    uint32_t generation = 0;
+    _sg_sw_mutex_lock(&pool->mutex);
+    while (true) {
+        while (!pool->quit && (generation == pool->generation)) {
+            _sg_sw_cond_wait(&pool->work_cond, &pool->mutex);
+        }
+        if (pool->quit) {
+            break;
+        }
+        generation = pool->generation;
+        _sg_sw_mutex_unlock(&pool->mutex);
+        _sg_sw_run_tiles();
+        _sg_sw_mutex_lock(&pool->mutex);
+        if (--pool->num_busy == 0) {
+            _sg_sw_cond_broadcast(&pool->done_cond);
+        }
+    }
+    _sg_sw_mutex_unlock(&pool->mutex);
 }
 
-static inline sg_resource_state _sg_create_context(_sg_context_t* ctx) {
-    #if defined(_SOKOL_ANY_GL)
-    return _sg_gl_create_context(ctx);
-    #elif defined(SOKOL_METAL)
-    return _sg_mtl_create_context(ctx);
-    #elif defined(SOKOL_D3D11)
-    return _sg_d3d11_create_context(ctx);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_create_context(ctx);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    return _sg_dummy_create_context(ctx);
+#if defined(_WIN32)
+_SOKOL_PRIVATE DWORD WINAPI _sg_sw_worker_func(LPVOID arg) {
+    _SOKOL_UNUSED(arg);
+    _sg_sw_worker_loop();
+    return 0;
+}
+#else
+_SOKOL_PRIVATE void* _sg_sw_worker_func(void* arg) {
+    _SOKOL_UNUSED(arg);
+    _sg_sw_worker_loop();
+    return 0;
+}
+#endif
+#endif /* _SG_SW_HAS_THREADS */
+
+_SOKOL_PRIVATE void _sg_sw_setup_pool(int num_threads) {
+    _sg_sw_pool_t* pool = &_sg.sw.pool;
+    #if _SG_SW_HAS_THREADS
+        pool->num_threads = _sg_clamp(num_threads, 1, _SG_SW_MAX_THREADS);
+        _sg_sw_mutex_init(&pool->mutex);
+        _sg_sw_cond_init(&pool->work_cond);
+        _sg_sw_cond_init(&pool->done_cond);
+        for (int i = 1; i < pool->num_threads; i++) {
+            #if defined(_WIN32)
+                pool->threads[i] = CreateThread(NULL, 0, _sg_sw_worker_func, 0, 0, NULL);
+                SOKOL_ASSERT(pool->threads[i] != NULL);
+            #else
+                int res = pthread_create(&pool->threads[i], 0, _sg_sw_worker_func, 0);
+                SOKOL_ASSERT(0 == res); _SOKOL_UNUSED(res);
+            #endif
+        }
     #else
-    #error("INVALID BACKEND");
+        _SOKOL_UNUSED(num_threads);
+        pool->num_threads = 1;
     #endif
 }
 
-static inline void _sg_destroy_context(_sg_context_t* ctx) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_destroy_context(ctx);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_destroy_context(ctx);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_destroy_context(ctx);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_destroy_context(ctx);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_destroy_context(ctx);
+_SOKOL_PRIVATE void _sg_sw_discard_pool(void) {
+    _sg_sw_pool_t* pool = &_sg.sw.pool;
+    #if _SG_SW_HAS_THREADS
+        _sg_sw_mutex_lock(&pool->mutex);
+        pool->quit = true;
+        _sg_sw_cond_broadcast(&pool->work_cond);
+        _sg_sw_mutex_unlock(&pool->mutex);
+        for (int i = 1; i < pool->num_threads; i++) {
+            #if defined(_WIN32)
+                WaitForSingleObject(pool->threads[i], INFINITE);
+                CloseHandle(pool->threads[i]);
+            #else
+                pthread_join(pool->threads[i], 0);
+            #endif
+        }
+        _sg_sw_cond_discard(&pool->done_cond);
+        _sg_sw_cond_discard(&pool->work_cond);
+        _sg_sw_mutex_discard(&pool->mutex);
     #else
-    #error("INVALID BACKEND");
+        _SOKOL_UNUSED(pool);
     #endif
 }
 
-static inline sg_resource_state _sg_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
-    #if defined(_SOKOL_ANY_GL)
-    return _sg_gl_create_buffer(buf, desc);
-    #elif defined(SOKOL_METAL)
-    return _sg_mtl_create_buffer(buf, desc);
-    #elif defined(SOKOL_D3D11)
-    return _sg_d3d11_create_buffer(buf, desc);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_create_buffer(buf, desc);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    return _sg_dummy_create_buffer(buf, desc);
-    #else
-    #error("INVALID BACKEND");
+/* rasterize all tiles on all threads, returns when all tiles are done */
+_SOKOL_PRIVATE void _sg_sw_dispatch_tiles(int num_tiles) {
+    _sg_sw_pool_t* pool = &_sg.sw.pool;
+    #if _SG_SW_HAS_THREADS
+    if (pool->num_threads > 1) {
+        _sg_sw_mutex_lock(&pool->mutex);
+        pool->next_tile = 0;
+        pool->num_tiles = num_tiles;
+        pool->num_busy = pool->num_threads - 1;
+        pool->generation++;
+        _sg_sw_cond_broadcast(&pool->work_cond);
+        _sg_sw_mutex_unlock(&pool->mutex);
+        _sg_sw_run_tiles();
+        _sg_sw_mutex_lock(&pool->mutex);
+        while (pool->num_busy > 0) {
+            _sg_sw_cond_wait(&pool->done_cond, &pool->mutex);
+        }
+        _sg_sw_mutex_unlock(&pool->mutex);
+        return;
+    }
     #endif
+    pool->next_tile = 0;
+    pool->num_tiles = num_tiles;
+    _sg_sw_run_tiles();
 }
 
-static inline void _sg_destroy_buffer(_sg_buffer_t* buf) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_destroy_buffer(buf);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_destroy_buffer(buf);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_destroy_buffer(buf);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_destroy_buffer(buf);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_destroy_buffer(buf);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+/*-- growable arrays ---------------------------------------------------------*/
+
+/* append num items and return a pointer to the first, this invalidates pointers to existing items */
+_SOKOL_PRIVATE void* _sg_sw_array_push(_sg_sw_array_t* arr, int item_size, int num) {
+    SOKOL_ASSERT(arr && (item_size > 0) && (num >= 0));
+    if ((arr->num + num) > arr->cap) {
+        int new_cap = _sg_max(arr->cap * 2, 256);
+        while (new_cap < (arr->num + num)) {
+            new_cap *= 2;
+        }
+        uint8_t* new_ptr = (uint8_t*) SOKOL_MALLOC((size_t)new_cap * (size_t)item_size);
+        SOKOL_ASSERT(new_ptr);
+        if (arr->ptr) {
+            memcpy(new_ptr, arr->ptr, (size_t)arr->num * (size_t)item_size);
+            SOKOL_FREE(arr->ptr);
+        }
+        arr->ptr = new_ptr;
+        arr->cap = new_cap;
+    }
+    void* res = arr->ptr + (size_t)arr->num * (size_t)item_size;
+    arr->num += num;
+    return res;
 }
 
-static inline sg_resource_state _sg_create_image(_sg_image_t* img, const sg_image_desc* desc) {
-    #if defined(_SOKOL_ANY_GL)
-    return _sg_gl_create_image(img, desc);
-    #elif defined(SOKOL_METAL)
-    return _sg_mtl_create_image(img, desc);
-    #elif defined(SOKOL_D3D11)
-    return _sg_d3d11_create_image(img, desc);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_create_image(img, desc);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    return _sg_dummy_create_image(img, desc);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_array_discard(_sg_sw_array_t* arr) {
+    if (arr->ptr) {
+        SOKOL_FREE(arr->ptr);
+    }
+    memset(arr, 0, sizeof(_sg_sw_array_t));
 }
 
-static inline void _sg_destroy_image(_sg_image_t* img) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_destroy_image(img);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_destroy_image(img);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_destroy_image(img);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_destroy_image(img);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_destroy_image(img);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+#define _sg_sw_item(arr, type, index) (((type*)(arr).ptr)[index])
+
+/*-- pixel and vertex formats ------------------------------------------------*/
+
+/* bytes per pixel of supported formats, 0 if not supported */
+_SOKOL_PRIVATE int _sg_sw_pixelformat_bytesize(sg_pixel_format fmt) {
+    switch (fmt) {
+        case SG_PIXELFORMAT_R8:             return 1;
+        case SG_PIXELFORMAT_RG8:            return 2;
+        case SG_PIXELFORMAT_RGBA8:          return 4;
+        case SG_PIXELFORMAT_BGRA8:          return 4;
+        case SG_PIXELFORMAT_R32F:           return 4;
+        case SG_PIXELFORMAT_RG32F:          return 8;
+        case SG_PIXELFORMAT_RGBA32F:        return 16;
+        case SG_PIXELFORMAT_DEPTH:          return 4;
+        case SG_PIXELFORMAT_DEPTH_STENCIL:  return 4;
+        default:                            return 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_sw_load_texel(sg_pixel_format fmt, const uint8_t* p, float* rgba) {
+    const float s = 1.0f / 255.0f;
+    rgba[0] = 0.0f; rgba[1] = 0.0f; rgba[2] = 0.0f; rgba[3] = 1.0f;
+    switch (fmt) {
+        case SG_PIXELFORMAT_R8:
+            rgba[0] = p[0] * s;
+            break;
+        case SG_PIXELFORMAT_RG8:
+            rgba[0] = p[0] * s; rgba[1] = p[1] * s;
+            break;
+        case SG_PIXELFORMAT_RGBA8:
+            rgba[0] = p[0] * s; rgba[1] = p[1] * s; rgba[2] = p[2] * s; rgba[3] = p[3] * s;
+            break;
+        case SG_PIXELFORMAT_BGRA8:
+            rgba[0] = p[2] * s; rgba[1] = p[1] * s; rgba[2] = p[0] * s; rgba[3] = p[3] * s;
+            break;
+        case SG_PIXELFORMAT_R32F:
+            memcpy(rgba, p, 4);
+            break;
+        case SG_PIXELFORMAT_RG32F:
+            memcpy(rgba, p, 8);
+            break;
+        case SG_PIXELFORMAT_RGBA32F:
+            memcpy(rgba, p, 16);
+            break;
+        default:
+            break;
+    }
 }
 
-static inline sg_resource_state _sg_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
-    #if defined(_SOKOL_ANY_GL)
-    return _sg_gl_create_shader(shd, desc);
-    #elif defined(SOKOL_METAL)
-    return _sg_mtl_create_shader(shd, desc);
-    #elif defined(SOKOL_D3D11)
-    return _sg_d3d11_create_shader(shd, desc);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_create_shader(shd, desc);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    return _sg_dummy_create_shader(shd, desc);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE uint8_t _sg_sw_unorm8(float f) {
+    f = _sg_clamp(f, 0.0f, 1.0f);
+    return (uint8_t)(f * 255.0f + 0.5f);
 }
 
-static inline void _sg_destroy_shader(_sg_shader_t* shd) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_destroy_shader(shd);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_destroy_shader(shd);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_destroy_shader(shd);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_destroy_shader(shd);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_destroy_shader(shd);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_store_texel(sg_pixel_format fmt, uint8_t* p, const float* rgba) {
+    switch (fmt) {
+        case SG_PIXELFORMAT_R8:
+            p[0] = _sg_sw_unorm8(rgba[0]);
+            break;
+        case SG_PIXELFORMAT_RG8:
+            p[0] = _sg_sw_unorm8(rgba[0]); p[1] = _sg_sw_unorm8(rgba[1]);
+            break;
+        case SG_PIXELFORMAT_RGBA8:
+            p[0] = _sg_sw_unorm8(rgba[0]); p[1] = _sg_sw_unorm8(rgba[1]);
+            p[2] = _sg_sw_unorm8(rgba[2]); p[3] = _sg_sw_unorm8(rgba[3]);
+            break;
+        case SG_PIXELFORMAT_BGRA8:
+            p[0] = _sg_sw_unorm8(rgba[2]); p[1] = _sg_sw_unorm8(rgba[1]);
+            p[2] = _sg_sw_unorm8(rgba[0]); p[3] = _sg_sw_unorm8(rgba[3]);
+            break;
+        case SG_PIXELFORMAT_R32F:
+            memcpy(p, rgba, 4);
+            break;
+        case SG_PIXELFORMAT_RG32F:
+            memcpy(p, rgba, 8);
+            break;
+        case SG_PIXELFORMAT_RGBA32F:
+            memcpy(p, rgba, 16);
+            break;
+        default:
+            break;
+    }
 }
 
-static inline sg_resource_state _sg_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
-    #if defined(_SOKOL_ANY_GL)
-    return _sg_gl_create_pipeline(pip, shd, desc);
-    #elif defined(SOKOL_METAL)
-    return _sg_mtl_create_pipeline(pip, shd, desc);
-    #elif defined(SOKOL_D3D11)
-    return _sg_d3d11_create_pipeline(pip, shd, desc);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_create_pipeline(pip, shd, desc);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    return _sg_dummy_create_pipeline(pip, shd, desc);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE float _sg_sw_half_to_float(uint16_t h) {
+    const uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    const uint32_t exp = (h >> 10) & 0x1F;
+    uint32_t mant = h & 0x3FF;
+    uint32_t bits;
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        }
+        else {
+            /* denormal, normalize */
+            int e = -1;
+            do {
+                e++;
+                mant <<= 1;
+            } while ((mant & 0x400) == 0);
+            bits = sign | ((uint32_t)(127 - 15 - e) << 23) | ((mant & 0x3FF) << 13);
+        }
+    }
+    else if (exp == 0x1F) {
+        bits = sign | 0x7F800000 | (mant << 13);
+    }
+    else {
+        bits = sign | ((exp + (127 - 15)) << 23) | (mant << 13);
+    }
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
 }
 
-static inline void _sg_destroy_pipeline(_sg_pipeline_t* pip) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_destroy_pipeline(pip);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_destroy_pipeline(pip);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_destroy_pipeline(pip);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_destroy_pipeline(pip);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_destroy_pipeline(pip);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+/* convert a vertex attribute to float4 */
+_SOKOL_PRIVATE void _sg_sw_load_attr(sg_vertex_format fmt, const uint8_t* p, float* out) {
+    out[0] = 0.0f; out[1] = 0.0f; out[2] = 0.0f; out[3] = 1.0f;
+    int16_t s[4]; uint16_t us[4]; uint32_t u;
+    switch (fmt) {
+        case SG_VERTEXFORMAT_FLOAT:     memcpy(out, p, 4); break;
+        case SG_VERTEXFORMAT_FLOAT2:    memcpy(out, p, 8); break;
+        case SG_VERTEXFORMAT_FLOAT3:    memcpy(out, p, 12); break;
+        case SG_VERTEXFORMAT_FLOAT4:    memcpy(out, p, 16); break;
+        case SG_VERTEXFORMAT_BYTE4:
+            for (int i = 0; i < 4; i++) { out[i] = (float)(int8_t)p[i]; }
+            break;
+        case SG_VERTEXFORMAT_BYTE4N:
+            for (int i = 0; i < 4; i++) { out[i] = _sg_max((float)(int8_t)p[i] / 127.0f, -1.0f); }
+            break;
+        case SG_VERTEXFORMAT_UBYTE4:
+            for (int i = 0; i < 4; i++) { out[i] = (float)p[i]; }
+            break;
+        case SG_VERTEXFORMAT_UBYTE4N:
+            for (int i = 0; i < 4; i++) { out[i] = (float)p[i] / 255.0f; }
+            break;
+        case SG_VERTEXFORMAT_SHORT2:
+            memcpy(s, p, 4);
+            for (int i = 0; i < 2; i++) { out[i] = (float)s[i]; }
+            break;
+        case SG_VERTEXFORMAT_SHORT2N:
+            memcpy(s, p, 4);
+            for (int i = 0; i < 2; i++) { out[i] = _sg_max((float)s[i] / 32767.0f, -1.0f); }
+            break;
+        case SG_VERTEXFORMAT_USHORT2N:
+            memcpy(us, p, 4);
+            for (int i = 0; i < 2; i++) { out[i] = (float)us[i] / 65535.0f; }
+            break;
+        case SG_VERTEXFORMAT_SHORT4:
+            memcpy(s, p, 8);
+            for (int i = 0; i < 4; i++) { out[i] = (float)s[i]; }
+            break;
+        case SG_VERTEXFORMAT_SHORT4N:
+            memcpy(s, p, 8);
+            for (int i = 0; i < 4; i++) { out[i] = _sg_max((float)s[i] / 32767.0f, -1.0f); }
+            break;
+        case SG_VERTEXFORMAT_USHORT4N:
+            memcpy(us, p, 8);
+            for (int i = 0; i < 4; i++) { out[i] = (float)us[i] / 65535.0f; }
+            break;
+        case SG_VERTEXFORMAT_UINT10_N2:
+            memcpy(&u, p, 4);
+            out[0] = (float)(u & 0x3FF) / 1023.0f;
+            out[1] = (float)((u >> 10) & 0x3FF) / 1023.0f;
+            out[2] = (float)((u >> 20) & 0x3FF) / 1023.0f;
+            out[3] = (float)((u >> 30) & 0x3) / 3.0f;
+            break;
+        case SG_VERTEXFORMAT_HALF2:
+            memcpy(us, p, 4);
+            for (int i = 0; i < 2; i++) { out[i] = _sg_sw_half_to_float(us[i]); }
+            break;
+        case SG_VERTEXFORMAT_HALF4:
+            memcpy(us, p, 8);
+            for (int i = 0; i < 4; i++) { out[i] = _sg_sw_half_to_float(us[i]); }
+            break;
+        default:
+            break;
+    }
 }
 
-static inline sg_resource_state _sg_create_pass(_sg_pass_t* pass, _sg_image_t** att_images, const sg_pass_desc* desc) {
-    #if defined(_SOKOL_ANY_GL)
-    return _sg_gl_create_pass(pass, att_images, desc);
-    #elif defined(SOKOL_METAL)
-    return _sg_mtl_create_pass(pass, att_images, desc);
-    #elif defined(SOKOL_D3D11)
-    return _sg_d3d11_create_pass(pass, att_images, desc);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_create_pass(pass, att_images, desc);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    return _sg_dummy_create_pass(pass, att_images, desc);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+/*-- texture sampling --------------------------------------------------------*/
+_SOKOL_PRIVATE int _sg_sw_wrap(sg_wrap wrap, int i, int n) {
+    switch (wrap) {
+        case SG_WRAP_REPEAT:
+            i %= n;
+            return (i < 0) ? (i + n) : i;
+        case SG_WRAP_MIRRORED_REPEAT:
+            i %= (2 * n);
+            if (i < 0) {
+                i += 2 * n;
+            }
+            return (i >= n) ? (2 * n - 1 - i) : i;
+        default:
+            /* clamp-to-border isn't supported and falls back to clamp-to-edge */
+            return _sg_clamp(i, 0, n - 1);
+    }
 }
 
-static inline void _sg_destroy_pass(_sg_pass_t* pass) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_destroy_pass(pass);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_destroy_pass(pass);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_destroy_pass(pass);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_destroy_pass(pass);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_destroy_pass(pass);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_fetch(const sg_sw_texture* tex, int x, int y, float* rgba) {
+    x = _sg_sw_wrap(tex->wrap_u, x, tex->width);
+    y = _sg_sw_wrap(tex->wrap_v, y, tex->height);
+    const int bpp = _sg_sw_pixelformat_bytesize(tex->pixel_format);
+    _sg_sw_load_texel(tex->pixel_format, (const uint8_t*)tex->pixels + y * tex->pitch + x * bpp, rgba);
 }
 
-static inline _sg_image_t* _sg_pass_color_image(const _sg_pass_t* pass, int index) {
-    #if defined(_SOKOL_ANY_GL)
-    return _sg_gl_pass_color_image(pass, index);
-    #elif defined(SOKOL_METAL)
-    return _sg_mtl_pass_color_image(pass, index);
-    #elif defined(SOKOL_D3D11)
-    return _sg_d3d11_pass_color_image(pass, index);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_pass_color_image(pass, index);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    return _sg_dummy_pass_color_image(pass, index);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_sample(const sg_sw_texture* tex, float u, float v, float* rgba) {
+    if (!tex || !tex->pixels) {
+        rgba[0] = rgba[1] = rgba[2] = rgba[3] = 0.0f;
+        return;
+    }
+    /* avoid integer overflow for very large or non-finite coordinates,
+       NaN would pass through the clamp, so map it to 0 first
+    */
+    if (!(u == u)) {
+        u = 0.0f;
+    }
+    if (!(v == v)) {
+        v = 0.0f;
+    }
+    u = _sg_clamp(u, -65536.0f, 65536.0f);
+    v = _sg_clamp(v, -65536.0f, 65536.0f);
+    const float x = u * (float)tex->width;
+    const float y = v * (float)tex->height;
+    if (tex->filter == SG_FILTER_LINEAR) {
+        const float fx = x - 0.5f;
+        const float fy = y - 0.5f;
+        const float x0 = floorf(fx);
+        const float y0 = floorf(fy);
+        const float tx = fx - x0;
+        const float ty = fy - y0;
+        float c00[4], c10[4], c01[4], c11[4];
+        _sg_sw_fetch(tex, (int)x0, (int)y0, c00);
+        _sg_sw_fetch(tex, (int)x0 + 1, (int)y0, c10);
+        _sg_sw_fetch(tex, (int)x0, (int)y0 + 1, c01);
+        _sg_sw_fetch(tex, (int)x0 + 1, (int)y0 + 1, c11);
+        for (int i = 0; i < 4; i++) {
+            const float c0 = c00[i] + (c10[i] - c00[i]) * tx;
+            const float c1 = c01[i] + (c11[i] - c01[i]) * tx;
+            rgba[i] = c0 + (c1 - c0) * ty;
+        }
+    }
+    else {
+        _sg_sw_fetch(tex, (int)floorf(x), (int)floorf(y), rgba);
+    }
 }
 
-static inline _sg_image_t* _sg_pass_ds_image(const _sg_pass_t* pass) {
-    #if defined(_SOKOL_ANY_GL)
-    return _sg_gl_pass_ds_image(pass);
-    #elif defined(SOKOL_METAL)
-    return _sg_mtl_pass_ds_image(pass);
-    #elif defined(SOKOL_D3D11)
-    return _sg_d3d11_pass_ds_image(pass);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_pass_ds_image(pass);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    return _sg_dummy_pass_ds_image(pass);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_init_texture(sg_sw_texture* tex, const _sg_image_t* img) {
+    SOKOL_ASSERT(tex && img);
+    tex->width = img->cmn.width;
+    tex->height = img->cmn.height;
+    tex->pitch = img->cmn.width * img->sw.bytes_per_pixel;
+    tex->pixel_format = img->cmn.pixel_format;
+    tex->filter = (img->cmn.mag_filter == SG_FILTER_LINEAR) ? SG_FILTER_LINEAR : SG_FILTER_NEAREST;
+    tex->wrap_u = img->cmn.wrap_u;
+    tex->wrap_v = img->cmn.wrap_v;
+    tex->pixels = img->sw.ptr;
 }
 
-static inline void _sg_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_begin_pass(pass, action, w, h);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_begin_pass(pass, action, w, h);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_begin_pass(pass, action, w, h);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_begin_pass(pass, action, w, h);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_begin_pass(pass, action, w, h);
-    #else
-    #error("INVALID BACKEND");
-    #endif
-}
+/*-- backend functions -------------------------------------------------------*/
+_SOKOL_PRIVATE void _sg_sw_setup_backend(const sg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    _sg.backend = SG_BACKEND_SW;
+    _sg.sw.valid = true;
+    _sg_sw_setup_pool(_sg_def(desc->sw_num_threads, _SG_SW_DEFAULT_NUM_THREADS));
 
-static inline void _sg_end_pass(void) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_end_pass();
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_end_pass();
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_end_pass();
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_end_pass();
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_end_pass();
-    #else
-    #error("INVALID BACKEND");
-    #endif
-}
+    _sg.features.instancing = true;
+    _sg.features.origin_top_left = true;
+    _sg.features.multiple_render_targets = true;
+    _sg.features.msaa_render_targets = false;
+    _sg.features.imagetype_3d = false;
+    _sg.features.imagetype_array = false;
+    _sg.features.image_clamp_to_border = false;
 
-static inline void _sg_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_apply_viewport(x, y, w, h, origin_top_left);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_apply_viewport(x, y, w, h, origin_top_left);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_apply_viewport(x, y, w, h, origin_top_left);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_apply_viewport(x, y, w, h, origin_top_left);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_apply_viewport(x, y, w, h, origin_top_left);
-    #else
-    #error("INVALID BACKEND");
-    #endif
-}
+    _sg.limits.max_image_size_2d = 16 * 1024;
+    _sg.limits.max_vertex_attrs = SG_MAX_VERTEX_ATTRIBUTES;
 
-static inline void _sg_apply_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_apply_scissor_rect(x, y, w, h, origin_top_left);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_apply_scissor_rect(x, y, w, h, origin_top_left);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_apply_scissor_rect(x, y, w, h, origin_top_left);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_apply_scissor_rect(x, y, w, h, origin_top_left);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_apply_scissor_rect(x, y, w, h, origin_top_left);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+    for (int fmt = SG_PIXELFORMAT_NONE + 1; fmt < _SG_PIXELFORMAT_NUM; fmt++) {
+        if (_sg_sw_pixelformat_bytesize((sg_pixel_format)fmt) > 0) {
+            if ((fmt == SG_PIXELFORMAT_DEPTH) || (fmt == SG_PIXELFORMAT_DEPTH_STENCIL)) {
+                _sg.formats[fmt].render = true;
+                _sg.formats[fmt].depth = true;
+            }
+            else {
+                _sg_pixelformat_sf(&_sg.formats[fmt]);
+                _sg.formats[fmt].render = true;
+                _sg.formats[fmt].blend = true;
+            }
+        }
+    }
 }
 
-static inline void _sg_apply_pipeline(_sg_pipeline_t* pip) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_apply_pipeline(pip);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_apply_pipeline(pip);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_apply_pipeline(pip);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_apply_pipeline(pip);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_apply_pipeline(pip);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_discard_backend(void) {
+    SOKOL_ASSERT(_sg.sw.valid);
+    _sg_sw_discard_pool();
+    _sg_sw_array_discard(&_sg.sw.uniforms);
+    _sg_sw_array_discard(&_sg.sw.verts);
+    _sg_sw_array_discard(&_sg.sw.draws);
+    _sg_sw_array_discard(&_sg.sw.tris);
+    _sg_sw_array_discard(&_sg.sw.tile_starts);
+    _sg_sw_array_discard(&_sg.sw.tile_tris);
+    if (_sg.sw.def_color) {
+        SOKOL_FREE(_sg.sw.def_color);
+    }
+    if (_sg.sw.def_depth) {
+        SOKOL_FREE(_sg.sw.def_depth);
+    }
+    _sg.sw.valid = false;
 }
 
-static inline void _sg_apply_bindings(
-    _sg_pipeline_t* pip,
-    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
-    _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
-{
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_reset_state_cache(void) {
+    /* empty */
 }
 
-static inline void _sg_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_apply_uniforms(stage_index, ub_index, data, num_bytes);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_apply_uniforms(stage_index, ub_index, data, num_bytes);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_apply_uniforms(stage_index, ub_index, data, num_bytes);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_apply_uniforms(stage_index, ub_index, data, num_bytes);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_apply_uniforms(stage_index, ub_index, data, num_bytes);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE sg_resource_state _sg_sw_create_context(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    _SOKOL_UNUSED(ctx);
+    return SG_RESOURCESTATE_VALID;
 }
 
-static inline void _sg_draw(int base_element, int num_elements, int num_instances) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_draw(base_element, num_elements, num_instances);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_draw(base_element, num_elements, num_instances);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_draw(base_element, num_elements, num_instances);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_draw(base_element, num_elements, num_instances);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_draw(base_element, num_elements, num_instances);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_destroy_context(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    _SOKOL_UNUSED(ctx);
 }
 
-static inline void _sg_commit(void) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_commit();
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_commit();
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_commit();
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_commit();
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_commit();
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_activate_context(_sg_context_t* ctx) {
+    /* NOTE: ctx can be 0 to unset the current context */
+    _SOKOL_UNUSED(ctx);
 }
 
-static inline void _sg_update_buffer(_sg_buffer_t* buf, const void* data_ptr, uint32_t data_size) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_update_buffer(buf, data_ptr, data_size);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_update_buffer(buf, data_ptr, data_size);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_update_buffer(buf, data_ptr, data_size);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_update_buffer(buf, data_ptr, data_size);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_update_buffer(buf, data_ptr, data_size);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE sg_resource_state _sg_sw_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(buf && desc);
+    _sg_buffer_common_init(&buf->cmn, desc);
+    buf->sw.ptr = (uint8_t*) SOKOL_MALLOC((size_t)buf->cmn.size);
+    SOKOL_ASSERT(buf->sw.ptr);
+    if (desc->content) {
+        memcpy(buf->sw.ptr, desc->content, (size_t)buf->cmn.size);
+    }
+    else {
+        memset(buf->sw.ptr, 0, (size_t)buf->cmn.size);
+    }
+    return SG_RESOURCESTATE_VALID;
 }
 
-static inline uint32_t _sg_append_buffer(_sg_buffer_t* buf, const void* data_ptr, uint32_t data_size, bool new_frame) {
-    #if defined(_SOKOL_ANY_GL)
-    return _sg_gl_append_buffer(buf, data_ptr, data_size, new_frame);
-    #elif defined(SOKOL_METAL)
-    return _sg_mtl_append_buffer(buf, data_ptr, data_size, new_frame);
-    #elif defined(SOKOL_D3D11)
-    return _sg_d3d11_append_buffer(buf, data_ptr, data_size, new_frame);
-    #elif defined(SOKOL_WGPU)
-    return _sg_wgpu_append_buffer(buf, data_ptr, data_size, new_frame);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    return _sg_dummy_append_buffer(buf, data_ptr, data_size, new_frame);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_destroy_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    if (buf->sw.ptr) {
+        SOKOL_FREE(buf->sw.ptr);
+    }
 }
 
-static inline void _sg_update_image(_sg_image_t* img, const sg_image_content* data) {
-    #if defined(_SOKOL_ANY_GL)
-    _sg_gl_update_image(img, data);
-    #elif defined(SOKOL_METAL)
-    _sg_mtl_update_image(img, data);
-    #elif defined(SOKOL_D3D11)
-    _sg_d3d11_update_image(img, data);
-    #elif defined(SOKOL_WGPU)
-    _sg_wgpu_update_image(img, data);
-    #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_update_image(img, data);
-    #else
-    #error("INVALID BACKEND");
-    #endif
+_SOKOL_PRIVATE void _sg_sw_copy_image_content(_sg_image_t* img, const sg_image_content* content) {
+    for (int mip_index = 0; mip_index < img->cmn.num_mipmaps; mip_index++) {
+        const sg_subimage_content* sub = &content->subimage[0][mip_index];
+        if (sub->ptr) {
+            const int mip_width = _sg_max(img->cmn.width >> mip_index, 1);
+            const int mip_height = _sg_max(img->cmn.height >> mip_index, 1);
+            const int mip_size = mip_width * mip_height * img->sw.bytes_per_pixel;
+            memcpy(img->sw.ptr + img->sw.mip_offsets[mip_index], sub->ptr, (size_t)_sg_min(sub->size, mip_size));
+        }
+    }
 }
 
-/*== RESOURCE POOLS ==========================================================*/
-
-_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num) {
-    SOKOL_ASSERT(pool && (num >= 1));
-    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
-    pool->size = num + 1;
-    pool->queue_top = 0;
-    /* generation counters indexable by pool slot index, slot 0 is reserved */
-    size_t gen_ctrs_size = sizeof(uint32_t) * pool->size;
-    pool->gen_ctrs = (uint32_t*) SOKOL_MALLOC(gen_ctrs_size);
-    SOKOL_ASSERT(pool->gen_ctrs);
-    memset(pool->gen_ctrs, 0, gen_ctrs_size);
-    /* it's not a bug to only reserve 'num' here */
-    pool->free_queue = (int*) SOKOL_MALLOC(sizeof(int)*num);
-    SOKOL_ASSERT(pool->free_queue);
-    /* never allocate the zero-th pool item since the invalid id is 0 */
-    for (int i = pool->size-1; i >= 1; i--) {
-        pool->free_queue[pool->queue_top++] = i;
+_SOKOL_PRIVATE sg_resource_state _sg_sw_create_image(_sg_image_t* img, const sg_image_desc* desc) {
+    SOKOL_ASSERT(img && desc);
+    _sg_image_common_init(&img->cmn, desc);
+    if (img->cmn.type != SG_IMAGETYPE_2D) {
+        SOKOL_LOG("sokol_gfx.h: the SW backend only supports 2D images\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    img->sw.bytes_per_pixel = _sg_sw_pixelformat_bytesize(img->cmn.pixel_format);
+    if (0 == img->sw.bytes_per_pixel) {
+        SOKOL_LOG("sokol_gfx.h: pixel format not supported by the SW backend\n");
+        return SG_RESOURCESTATE_FAILED;
     }
+    int num_bytes = 0;
+    for (int mip_index = 0; mip_index < img->cmn.num_mipmaps; mip_index++) {
+        const int mip_width = _sg_max(img->cmn.width >> mip_index, 1);
+        const int mip_height = _sg_max(img->cmn.height >> mip_index, 1);
+        img->sw.mip_offsets[mip_index] = num_bytes;
+        num_bytes += mip_width * mip_height * img->sw.bytes_per_pixel;
+    }
+    img->sw.ptr = (uint8_t*) SOKOL_MALLOC((size_t)num_bytes);
+    SOKOL_ASSERT(img->sw.ptr);
+    memset(img->sw.ptr, 0, (size_t)num_bytes);
+    _sg_sw_copy_image_content(img, &desc->content);
+    return SG_RESOURCESTATE_VALID;
 }
 
-_SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
-    SOKOL_ASSERT(pool);
-    SOKOL_ASSERT(pool->free_queue);
-    SOKOL_FREE(pool->free_queue);
-    pool->free_queue = 0;
-    SOKOL_ASSERT(pool->gen_ctrs);
-    SOKOL_FREE(pool->gen_ctrs);
-    pool->gen_ctrs = 0;
-    pool->size = 0;
-    pool->queue_top = 0;
+_SOKOL_PRIVATE void _sg_sw_destroy_image(_sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    if (img->sw.ptr) {
+        SOKOL_FREE(img->sw.ptr);
+    }
 }
 
-_SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
-    SOKOL_ASSERT(pool);
-    SOKOL_ASSERT(pool->free_queue);
-    if (pool->queue_top > 0) {
-        int slot_index = pool->free_queue[--pool->queue_top];
-        SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
-        return slot_index;
-    }
-    else {
-        /* pool exhausted */
-        return _SG_INVALID_SLOT_INDEX;
+_SOKOL_PRIVATE sg_resource_state _sg_sw_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
+    SOKOL_ASSERT(shd && desc);
+    _sg_shader_common_init(&shd->cmn, desc);
+    if (!desc->sw_vs_func || !desc->sw_fs_func || (desc->sw_num_varyings < 0) || (desc->sw_num_varyings > SG_SW_MAX_VARYINGS)) {
+        SOKOL_LOG("sokol_gfx.h: invalid SW shader functions\n");
+        return SG_RESOURCESTATE_FAILED;
     }
+    shd->sw.vs_func = desc->sw_vs_func;
+    shd->sw.fs_func = desc->sw_fs_func;
+    shd->sw.num_varyings = desc->sw_num_varyings;
+    return SG_RESOURCESTATE_VALID;
 }
 
-_SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
-    SOKOL_ASSERT(pool);
-    SOKOL_ASSERT(pool->free_queue);
-    SOKOL_ASSERT(pool->queue_top < pool->size);
-    #ifdef SOKOL_DEBUG
-    /* debug check against double-free */
-    for (int i = 0; i < pool->queue_top; i++) {
-        SOKOL_ASSERT(pool->free_queue[i] != slot_index);
-    }
-    #endif
-    pool->free_queue[pool->queue_top++] = slot_index;
-    SOKOL_ASSERT(pool->queue_top <= (pool->size-1));
+_SOKOL_PRIVATE void _sg_sw_destroy_shader(_sg_shader_t* shd) {
+    SOKOL_ASSERT(shd);
+    _SOKOL_UNUSED(shd);
 }
 
-_SOKOL_PRIVATE void _sg_reset_slot(_sg_slot_t* slot) {
-    SOKOL_ASSERT(slot);
-    memset(slot, 0, sizeof(_sg_slot_t));
+_SOKOL_PRIVATE sg_resource_state _sg_sw_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
+    SOKOL_ASSERT(pip && shd && desc);
+    pip->shader = shd;
+    _sg_pipeline_common_init(&pip->cmn, desc);
+    if ((desc->primitive_type != SG_PRIMITIVETYPE_TRIANGLES) && (desc->primitive_type != SG_PRIMITIVETYPE_TRIANGLE_STRIP)) {
+        SOKOL_LOG("sokol_gfx.h: the SW backend only supports triangle primitives\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        pip->sw.attrs[attr_index].vb_index = -1;
+    }
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        const sg_vertex_attr_desc* a_desc = &desc->layout.attrs[attr_index];
+        if (a_desc->format == SG_VERTEXFORMAT_INVALID) {
+            break;
+        }
+        SOKOL_ASSERT((a_desc->buffer_index >= 0) && (a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
+        const sg_buffer_layout_desc* l_desc = &desc->layout.buffers[a_desc->buffer_index];
+        _sg_sw_attr_t* attr = &pip->sw.attrs[attr_index];
+        attr->vb_index = a_desc->buffer_index;
+        attr->offset = a_desc->offset;
+        attr->stride = l_desc->stride;
+        attr->format = a_desc->format;
+        attr->step_func = l_desc->step_func;
+        attr->step_rate = l_desc->step_rate;
+        pip->cmn.vertex_layout_valid[a_desc->buffer_index] = true;
+    }
+    pip->sw.primitive_type = desc->primitive_type;
+    pip->sw.depth_stencil = desc->depth_stencil;
+    pip->sw.blend = desc->blend;
+    pip->sw.cull_mode = desc->rasterizer.cull_mode;
+    pip->sw.face_winding = desc->rasterizer.face_winding;
+    return SG_RESOURCESTATE_VALID;
 }
 
-_SOKOL_PRIVATE void _sg_reset_buffer(_sg_buffer_t* buf) {
-    SOKOL_ASSERT(buf);
-    _sg_slot_t slot = buf->slot;
-    memset(buf, 0, sizeof(_sg_buffer_t));
-    buf->slot = slot;
-    buf->slot.state = SG_RESOURCESTATE_ALLOC;
+_SOKOL_PRIVATE void _sg_sw_destroy_pipeline(_sg_pipeline_t* pip) {
+    SOKOL_ASSERT(pip);
+    _SOKOL_UNUSED(pip);
 }
 
-_SOKOL_PRIVATE void _sg_reset_image(_sg_image_t* img) {
-    SOKOL_ASSERT(img);
-    _sg_slot_t slot = img->slot;
-    memset(img, 0, sizeof(_sg_image_t));
-    img->slot = slot;
-    img->slot.state = SG_RESOURCESTATE_ALLOC;
+_SOKOL_PRIVATE sg_resource_state _sg_sw_create_pass(_sg_pass_t* pass, _sg_image_t** att_images, const sg_pass_desc* desc) {
+    SOKOL_ASSERT(pass && desc);
+    SOKOL_ASSERT(att_images && att_images[0]);
+    _sg_pass_common_init(&pass->cmn, desc);
+    const sg_attachment_desc* att_desc;
+    for (int i = 0; i < pass->cmn.num_color_atts; i++) {
+        att_desc = &desc->color_attachments[i];
+        SOKOL_ASSERT(att_desc->image.id != SG_INVALID_ID);
+        SOKOL_ASSERT(0 == pass->sw.color_atts[i].image);
+        SOKOL_ASSERT(att_images[i] && (att_images[i]->slot.id == att_desc->image.id));
+        SOKOL_ASSERT(_sg_is_valid_rendertarget_color_format(att_images[i]->cmn.pixel_format));
+        pass->sw.color_atts[i].image = att_images[i];
+    }
+    SOKOL_ASSERT(0 == pass->sw.ds_att.image);
+    att_desc = &desc->depth_stencil_attachment;
+    const int ds_img_index = SG_MAX_COLOR_ATTACHMENTS;
+    if (att_desc->image.id != SG_INVALID_ID) {
+        SOKOL_ASSERT(att_images[ds_img_index] && (att_images[ds_img_index]->slot.id == att_desc->image.id));
+        SOKOL_ASSERT(_sg_is_valid_rendertarget_depth_format(att_images[ds_img_index]->cmn.pixel_format));
+        pass->sw.ds_att.image = att_images[ds_img_index];
+    }
+    return SG_RESOURCESTATE_VALID;
 }
 
-_SOKOL_PRIVATE void _sg_reset_shader(_sg_shader_t* shd) {
-    SOKOL_ASSERT(shd);
-    _sg_slot_t slot = shd->slot;
-    memset(shd, 0, sizeof(_sg_shader_t));
-    shd->slot = slot;
-    shd->slot.state = SG_RESOURCESTATE_ALLOC;
+_SOKOL_PRIVATE void _sg_sw_destroy_pass(_sg_pass_t* pass) {
+    SOKOL_ASSERT(pass);
+    _SOKOL_UNUSED(pass);
 }
 
-_SOKOL_PRIVATE void _sg_reset_pipeline(_sg_pipeline_t* pip) {
-    SOKOL_ASSERT(pip);
-    _sg_slot_t slot = pip->slot;
-    memset(pip, 0, sizeof(_sg_pipeline_t));
-    pip->slot = slot;
-    pip->slot.state = SG_RESOURCESTATE_ALLOC;
+_SOKOL_PRIVATE _sg_image_t* _sg_sw_pass_color_image(const _sg_pass_t* pass, int index) {
+    SOKOL_ASSERT(pass && (index >= 0) && (index < SG_MAX_COLOR_ATTACHMENTS));
+    /* NOTE: may return null */
+    return pass->sw.color_atts[index].image;
 }
 
-_SOKOL_PRIVATE void _sg_reset_pass(_sg_pass_t* pass) {
+_SOKOL_PRIVATE _sg_image_t* _sg_sw_pass_ds_image(const _sg_pass_t* pass) {
+    /* NOTE: may return null */
     SOKOL_ASSERT(pass);
-    _sg_slot_t slot = pass->slot;
-    memset(pass, 0, sizeof(_sg_pass_t));
-    pass->slot = slot;
-    pass->slot.state = SG_RESOURCESTATE_ALLOC;
+    return pass->sw.ds_att.image;
 }
 
-_SOKOL_PRIVATE void _sg_reset_context(_sg_context_t* ctx) {
-    SOKOL_ASSERT(ctx);
-    _sg_slot_t slot = ctx->slot;
-    memset(ctx, 0, sizeof(_sg_context_t));
-    ctx->slot = slot;
-    ctx->slot.state = SG_RESOURCESTATE_ALLOC;
+_SOKOL_PRIVATE void _sg_sw_clear_surface(const _sg_sw_surface_t* surf, int w, int h, const float* rgba) {
+    uint8_t texel[16];
+    const int bpp = _sg_sw_pixelformat_bytesize(surf->format);
+    _sg_sw_store_texel(surf->format, texel, rgba);
+    for (int x = 0; x < w; x++) {
+        memcpy(surf->ptr + x * bpp, texel, (size_t)bpp);
+    }
+    for (int y = 1; y < h; y++) {
+        memcpy(surf->ptr + y * surf->pitch, surf->ptr, (size_t)(w * bpp));
+    }
 }
 
-_SOKOL_PRIVATE void _sg_setup_pools(_sg_pools_t* p, const sg_desc* desc) {
-    SOKOL_ASSERT(p);
-    SOKOL_ASSERT(desc);
-    /* note: the pools here will have an additional item, since slot 0 is reserved */
-    SOKOL_ASSERT((desc->buffer_pool_size > 0) && (desc->buffer_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size);
-    size_t buffer_pool_byte_size = sizeof(_sg_buffer_t) * p->buffer_pool.size;
-    p->buffers = (_sg_buffer_t*) SOKOL_MALLOC(buffer_pool_byte_size);
-    SOKOL_ASSERT(p->buffers);
-    memset(p->buffers, 0, buffer_pool_byte_size);
-
-    SOKOL_ASSERT((desc->image_pool_size > 0) && (desc->image_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->image_pool, desc->image_pool_size);
-    size_t image_pool_byte_size = sizeof(_sg_image_t) * p->image_pool.size;
-    p->images = (_sg_image_t*) SOKOL_MALLOC(image_pool_byte_size);
-    SOKOL_ASSERT(p->images);
-    memset(p->images, 0, image_pool_byte_size);
-
-    SOKOL_ASSERT((desc->shader_pool_size > 0) && (desc->shader_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->shader_pool, desc->shader_pool_size);
-    size_t shader_pool_byte_size = sizeof(_sg_shader_t) * p->shader_pool.size;
-    p->shaders = (_sg_shader_t*) SOKOL_MALLOC(shader_pool_byte_size);
-    SOKOL_ASSERT(p->shaders);
-    memset(p->shaders, 0, shader_pool_byte_size);
-
-    SOKOL_ASSERT((desc->pipeline_pool_size > 0) && (desc->pipeline_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size);
-    size_t pipeline_pool_byte_size = sizeof(_sg_pipeline_t) * p->pipeline_pool.size;
-    p->pipelines = (_sg_pipeline_t*) SOKOL_MALLOC(pipeline_pool_byte_size);
-    SOKOL_ASSERT(p->pipelines);
-    memset(p->pipelines, 0, pipeline_pool_byte_size);
-
-    SOKOL_ASSERT((desc->pass_pool_size > 0) && (desc->pass_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pass_pool, desc->pass_pool_size);
-    size_t pass_pool_byte_size = sizeof(_sg_pass_t) * p->pass_pool.size;
-    p->passes = (_sg_pass_t*) SOKOL_MALLOC(pass_pool_byte_size);
-    SOKOL_ASSERT(p->passes);
-    memset(p->passes, 0, pass_pool_byte_size);
+_SOKOL_PRIVATE void _sg_sw_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
+    SOKOL_ASSERT(action);
+    SOKOL_ASSERT(!_sg.sw.in_pass);
+    _sg.sw.in_pass = true;
+    if (pass) {
+        _sg.sw.num_color_atts = pass->cmn.num_color_atts;
+        for (int i = 0; i < pass->cmn.num_color_atts; i++) {
+            const _sg_image_t* img = pass->sw.color_atts[i].image;
+            const int mip_level = pass->cmn.color_atts[i].mip_level;
+            _sg_sw_surface_t* surf = &_sg.sw.colors[i];
+            surf->ptr = img->sw.ptr + img->sw.mip_offsets[mip_level];
+            surf->pitch = _sg_max(img->cmn.width >> mip_level, 1) * img->sw.bytes_per_pixel;
+            surf->format = img->cmn.pixel_format;
+            if (i == 0) {
+                w = _sg_max(img->cmn.width >> mip_level, 1);
+                h = _sg_max(img->cmn.height >> mip_level, 1);
+            }
+        }
+        const _sg_image_t* ds_img = pass->sw.ds_att.image;
+        if (ds_img) {
+            const int mip_level = pass->cmn.ds_att.mip_level;
+            _sg.sw.depth = (float*) (ds_img->sw.ptr + ds_img->sw.mip_offsets[mip_level]);
+            _sg.sw.depth_pitch = _sg_max(ds_img->cmn.width >> mip_level, 1);
+        }
+        else {
+            _sg.sw.depth = 0;
+            _sg.sw.depth_pitch = 0;
+        }
+    }
+    else {
+        /* the default framebuffer is resized to the size of the default pass */
+        w = _sg_max(w, 1);
+        h = _sg_max(h, 1);
+        if ((w * h) > _sg.sw.def_capacity) {
+            if (_sg.sw.def_color) {
+                SOKOL_FREE(_sg.sw.def_color);
+                SOKOL_FREE(_sg.sw.def_depth);
+            }
+            _sg.sw.def_capacity = w * h;
+            _sg.sw.def_color = (uint8_t*) SOKOL_MALLOC((size_t)_sg.sw.def_capacity * 4);
+            _sg.sw.def_depth = (float*) SOKOL_MALLOC((size_t)_sg.sw.def_capacity * sizeof(float));
+            SOKOL_ASSERT(_sg.sw.def_color && _sg.sw.def_depth);
+            memset(_sg.sw.def_color, 0, (size_t)_sg.sw.def_capacity * 4);
+            memset(_sg.sw.def_depth, 0, (size_t)_sg.sw.def_capacity * sizeof(float));
+        }
+        _sg.sw.def_width = w;
+        _sg.sw.def_height = h;
+        _sg.sw.num_color_atts = 1;
+        _sg.sw.colors[0].ptr = _sg.sw.def_color;
+        _sg.sw.colors[0].pitch = w * 4;
+        _sg.sw.colors[0].format = SG_PIXELFORMAT_RGBA8;
+        _sg.sw.depth = _sg.sw.def_depth;
+        _sg.sw.depth_pitch = w;
+    }
+    _sg.sw.fb_width = w;
+    _sg.sw.fb_height = h;
+    _sg.sw.vp_x = 0; _sg.sw.vp_y = 0; _sg.sw.vp_w = w; _sg.sw.vp_h = h;
+    _sg.sw.sc_x = 0; _sg.sw.sc_y = 0; _sg.sw.sc_w = w; _sg.sw.sc_h = h;
+    _sg.sw.cur_pipeline = 0;
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            _sg.sw.ub_offsets[stage_index][ub_index] = -1;
+        }
+    }
 
-    SOKOL_ASSERT((desc->context_pool_size > 0) && (desc->context_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->context_pool, desc->context_pool_size);
-    size_t context_pool_byte_size = sizeof(_sg_context_t) * p->context_pool.size;
-    p->contexts = (_sg_context_t*) SOKOL_MALLOC(context_pool_byte_size);
-    SOKOL_ASSERT(p->contexts);
-    memset(p->contexts, 0, context_pool_byte_size);
+    /* clear attachments */
+    for (int i = 0; i < _sg.sw.num_color_atts; i++) {
+        if (action->colors[i].action == SG_ACTION_CLEAR) {
+            _sg_sw_clear_surface(&_sg.sw.colors[i], w, h, action->colors[i].val);
+        }
+    }
+    if (_sg.sw.depth && (action->depth.action == SG_ACTION_CLEAR)) {
+        for (int y = 0; y < h; y++) {
+            float* row = _sg.sw.depth + y * _sg.sw.depth_pitch;
+            for (int x = 0; x < w; x++) {
+                row[x] = action->depth.val;
+            }
+        }
+    }
 }
 
-_SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
-    SOKOL_ASSERT(p);
-    SOKOL_FREE(p->contexts);    p->contexts = 0;
-    SOKOL_FREE(p->passes);      p->passes = 0;
-    SOKOL_FREE(p->pipelines);   p->pipelines = 0;
-    SOKOL_FREE(p->shaders);     p->shaders = 0;
-    SOKOL_FREE(p->images);      p->images = 0;
-    SOKOL_FREE(p->buffers);     p->buffers = 0;
-    _sg_discard_pool(&p->context_pool);
-    _sg_discard_pool(&p->pass_pool);
-    _sg_discard_pool(&p->pipeline_pool);
-    _sg_discard_pool(&p->shader_pool);
-    _sg_discard_pool(&p->image_pool);
-    _sg_discard_pool(&p->buffer_pool);
+_SOKOL_PRIVATE void _sg_sw_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
+    SOKOL_ASSERT(_sg.sw.in_pass);
+    _sg.sw.vp_x = x;
+    _sg.sw.vp_y = origin_top_left ? y : (_sg.sw.fb_height - (y + h));
+    _sg.sw.vp_w = w;
+    _sg.sw.vp_h = h;
 }
 
-/* allocate the slot at slot_index:
-    - bump the slot's generation counter
-    - create a resource id from the generation counter and slot index
-    - set the slot's id to this id
-    - set the slot's state to ALLOC
-    - return the resource id
-*/
-_SOKOL_PRIVATE uint32_t _sg_slot_alloc(_sg_pool_t* pool, _sg_slot_t* slot, int slot_index) {
-    /* FIXME: add handling for an overflowing generation counter,
-       for now, just overflow (another option is to disable
-       the slot)
-    */
-    SOKOL_ASSERT(pool && pool->gen_ctrs);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
-    SOKOL_ASSERT((slot->state == SG_RESOURCESTATE_INITIAL) && (slot->id == SG_INVALID_ID));
-    uint32_t ctr = ++pool->gen_ctrs[slot_index];
-    slot->id = (ctr<<_SG_SLOT_SHIFT)|(slot_index & _SG_SLOT_MASK);
-    slot->state = SG_RESOURCESTATE_ALLOC;
-    return slot->id;
+_SOKOL_PRIVATE void _sg_sw_apply_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
+    SOKOL_ASSERT(_sg.sw.in_pass);
+    _sg.sw.sc_x = x;
+    _sg.sw.sc_y = origin_top_left ? y : (_sg.sw.fb_height - (y + h));
+    _sg.sw.sc_w = w;
+    _sg.sw.sc_h = h;
 }
 
-/* extract slot index from id */
-_SOKOL_PRIVATE int _sg_slot_index(uint32_t id) {
-    int slot_index = (int) (id & _SG_SLOT_MASK);
-    SOKOL_ASSERT(_SG_INVALID_SLOT_INDEX != slot_index);
-    return slot_index;
+_SOKOL_PRIVATE void _sg_sw_apply_pipeline(_sg_pipeline_t* pip) {
+    SOKOL_ASSERT(pip && pip->shader);
+    _sg.sw.cur_pipeline = pip;
 }
 
-/* returns pointer to resource by id without matching id check */
-_SOKOL_PRIVATE _sg_buffer_t* _sg_buffer_at(const _sg_pools_t* p, uint32_t buf_id) {
-    SOKOL_ASSERT(p && (SG_INVALID_ID != buf_id));
-    int slot_index = _sg_slot_index(buf_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
-    return &p->buffers[slot_index];
+_SOKOL_PRIVATE void _sg_sw_apply_bindings(
+    _sg_pipeline_t* pip,
+    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
+    _sg_buffer_t* ib, int ib_offset,
+    _sg_image_t** vs_imgs, int num_vs_imgs,
+    _sg_image_t** fs_imgs, int num_fs_imgs)
+{
+    SOKOL_ASSERT(pip);
+    SOKOL_ASSERT(vbs && vb_offsets);
+    SOKOL_ASSERT(vs_imgs);
+    SOKOL_ASSERT(fs_imgs);
+    _SOKOL_UNUSED(pip);
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        _sg.sw.vbs[i] = (i < num_vbs) ? vbs[i] : 0;
+        _sg.sw.vb_offsets[i] = (i < num_vbs) ? vb_offsets[i] : 0;
+    }
+    _sg.sw.ib = ib;
+    _sg.sw.ib_offset = ib_offset;
+    memset(_sg.sw.textures, 0, sizeof(_sg.sw.textures));
+    for (int i = 0; i < num_vs_imgs; i++) {
+        _sg_sw_init_texture(&_sg.sw.textures[SG_SHADERSTAGE_VS][i], vs_imgs[i]);
+    }
+    for (int i = 0; i < num_fs_imgs; i++) {
+        _sg_sw_init_texture(&_sg.sw.textures[SG_SHADERSTAGE_FS][i], fs_imgs[i]);
+    }
 }
 
-_SOKOL_PRIVATE _sg_image_t* _sg_image_at(const _sg_pools_t* p, uint32_t img_id) {
-    SOKOL_ASSERT(p && (SG_INVALID_ID != img_id));
-    int slot_index = _sg_slot_index(img_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
-    return &p->images[slot_index];
+_SOKOL_PRIVATE void _sg_sw_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
+    SOKOL_ASSERT(data && (num_bytes > 0));
+    SOKOL_ASSERT((stage_index >= 0) && ((int)stage_index < SG_NUM_SHADER_STAGES));
+    SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
+    /* the data must survive until the pass is rasterized, so copy it into the uniform arena */
+    const int offset = _sg.sw.uniforms.num;
+    uint8_t* dst = (uint8_t*) _sg_sw_array_push(&_sg.sw.uniforms, 1, _sg_roundup(num_bytes, _SG_SW_UNIFORM_ALIGNMENT));
+    memcpy(dst, data, (size_t)num_bytes);
+    _sg.sw.ub_offsets[stage_index][ub_index] = offset;
+}
+
+/* project a clipped triangle to window space and record it for rasterization */
+_SOKOL_PRIVATE void _sg_sw_setup_tri(int draw_index, int i0, int i1, int i2) {
+    const _sg_sw_draw_t* draw = &_sg_sw_item(_sg.sw.draws, _sg_sw_draw_t, draw_index);
+    const _sg_pipeline_t* pip = draw->pip;
+    const int vi[3] = { i0, i1, i2 };
+    float x[3], y[3], z[3], inv_w[3];
+    for (int i = 0; i < 3; i++) {
+        const float* pos = _sg_sw_item(_sg.sw.verts, _sg_sw_vertex_t, vi[i]).pos;
+        if (pos[3] <= 0.0f) {
+            return;
+        }
+        inv_w[i] = 1.0f / pos[3];
+        /* snap to 1/256 pixel so that shared edges are rasterized identically */
+        const float fx = (float)_sg.sw.vp_x + (pos[0] * inv_w[i] * 0.5f + 0.5f) * (float)_sg.sw.vp_w;
+        const float fy = (float)_sg.sw.vp_y + (0.5f - pos[1] * inv_w[i] * 0.5f) * (float)_sg.sw.vp_h;
+        x[i] = floorf(fx * 256.0f + 0.5f) * (1.0f / 256.0f);
+        y[i] = floorf(fy * 256.0f + 0.5f) * (1.0f / 256.0f);
+        z[i] = pos[2] * inv_w[i];
+    }
+
+    /* signed area in window space (y down), positive means clockwise in clip space */
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (area == 0.0f) {
+        return;
+    }
+    const bool front_facing = (pip->sw.face_winding == SG_FACEWINDING_CW) ? (area > 0.0f) : (area < 0.0f);
+    if (((pip->sw.cull_mode == SG_CULLMODE_BACK) && !front_facing) ||
+        ((pip->sw.cull_mode == SG_CULLMODE_FRONT) && front_facing))
+    {
+        return;
+    }
+
+    /* pixel bounding box, clipped against viewport and scissor rect */
+    const float min_x = _sg_min(_sg_min(x[0], x[1]), x[2]);
+    const float max_x = _sg_max(_sg_max(x[0], x[1]), x[2]);
+    const float min_y = _sg_min(_sg_min(y[0], y[1]), y[2]);
+    const float max_y = _sg_max(_sg_max(y[0], y[1]), y[2]);
+    const float lim = 65536.0f;
+    const int bx0 = _sg_max((int)ceilf(_sg_clamp(min_x - 0.5f, -lim, lim)), draw->clip_x0);
+    const int by0 = _sg_max((int)ceilf(_sg_clamp(min_y - 0.5f, -lim, lim)), draw->clip_y0);
+    const int bx1 = _sg_min((int)floorf(_sg_clamp(max_x - 0.5f, -lim, lim)) + 1, draw->clip_x1);
+    const int by1 = _sg_min((int)floorf(_sg_clamp(max_y - 0.5f, -lim, lim)) + 1, draw->clip_y1);
+    if ((bx0 >= bx1) || (by0 >= by1)) {
+        return;
+    }
+
+    _sg_sw_tri_t* tri = (_sg_sw_tri_t*) _sg_sw_array_push(&_sg.sw.tris, sizeof(_sg_sw_tri_t), 1);
+    tri->draw_index = draw_index;
+    tri->front_facing = front_facing;
+    tri->x0 = bx0; tri->y0 = by0; tri->x1 = bx1; tri->y1 = by1;
+    const float sign = (area < 0.0f) ? -1.0f : 1.0f;
+    for (int i = 0; i < 3; i++) {
+        /* edge i is opposite of vertex i */
+        const int j = (i + 1) % 3;
+        const int k = (i + 2) % 3;
+        tri->v[i] = vi[i];
+        tri->a[i] = (y[j] - y[k]) * sign;
+        tri->b[i] = (x[k] - x[j]) * sign;
+        tri->c[i] = -(tri->a[i] * x[j] + tri->b[i] * y[j]);
+        tri->top_left[i] = (tri->a[i] > 0.0f) || ((tri->a[i] == 0.0f) && (tri->b[i] > 0.0f));
+        tri->z[i] = z[i];
+        tri->inv_w[i] = inv_w[i];
+    }
+    tri->inv_area = 1.0f / (area * sign);
+}
+
+/* clip a triangle against the near plane (z >= 0) */
+_SOKOL_PRIVATE void _sg_sw_clip_tri(int draw_index, int num_varyings, int i0, int i1, int i2) {
+    const int in[3] = { i0, i1, i2 };
+    float d[3];
+    int num_inside = 0;
+    for (int i = 0; i < 3; i++) {
+        d[i] = _sg_sw_item(_sg.sw.verts, _sg_sw_vertex_t, in[i]).pos[2];
+        num_inside += (d[i] >= 0.0f) ? 1 : 0;
+    }
+    if (num_inside == 3) {
+        _sg_sw_setup_tri(draw_index, i0, i1, i2);
+        return;
+    }
+    if (num_inside == 0) {
+        return;
+    }
+    int out[4];
+    int num_out = 0;
+    for (int i = 0; i < 3; i++) {
+        const int j = (i + 1) % 3;
+        if (d[i] >= 0.0f) {
+            out[num_out++] = in[i];
+        }
+        if ((d[i] >= 0.0f) != (d[j] >= 0.0f)) {
+            const float t = d[i] / (d[i] - d[j]);
+            const int new_index = _sg.sw.verts.num;
+            _sg_sw_vertex_t* v = (_sg_sw_vertex_t*) _sg_sw_array_push(&_sg.sw.verts, sizeof(_sg_sw_vertex_t), 1);
+            const _sg_sw_vertex_t* a = &_sg_sw_item(_sg.sw.verts, _sg_sw_vertex_t, in[i]);
+            const _sg_sw_vertex_t* b = &_sg_sw_item(_sg.sw.verts, _sg_sw_vertex_t, in[j]);
+            for (int c = 0; c < 4; c++) {
+                v->pos[c] = a->pos[c] + (b->pos[c] - a->pos[c]) * t;
+            }
+            v->pos[2] = 0.0f;
+            for (int c = 0; c < num_varyings; c++) {
+                v->varyings[c] = a->varyings[c] + (b->varyings[c] - a->varyings[c]) * t;
+            }
+            out[num_out++] = new_index;
+        }
+    }
+    for (int i = 1; i < (num_out - 1); i++) {
+        _sg_sw_setup_tri(draw_index, out[0], out[i], out[i + 1]);
+    }
 }
 
-_SOKOL_PRIVATE _sg_shader_t* _sg_shader_at(const _sg_pools_t* p, uint32_t shd_id) {
-    SOKOL_ASSERT(p && (SG_INVALID_ID != shd_id));
-    int slot_index = _sg_slot_index(shd_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->shader_pool.size));
-    return &p->shaders[slot_index];
+_SOKOL_PRIVATE int _sg_sw_index(const uint8_t* indices, sg_index_type index_type, int i) {
+    if (index_type == SG_INDEXTYPE_UINT16) {
+        uint16_t idx;
+        memcpy(&idx, indices + i * 2, 2);
+        return (int)idx;
+    }
+    else {
+        uint32_t idx;
+        memcpy(&idx, indices + i * 4, 4);
+        return (int)idx;
+    }
 }
 
-_SOKOL_PRIVATE _sg_pipeline_t* _sg_pipeline_at(const _sg_pools_t* p, uint32_t pip_id) {
-    SOKOL_ASSERT(p && (SG_INVALID_ID != pip_id));
-    int slot_index = _sg_slot_index(pip_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pipeline_pool.size));
-    return &p->pipelines[slot_index];
-}
-
-_SOKOL_PRIVATE _sg_pass_t* _sg_pass_at(const _sg_pools_t* p, uint32_t pass_id) {
-    SOKOL_ASSERT(p && (SG_INVALID_ID != pass_id));
-    int slot_index = _sg_slot_index(pass_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pass_pool.size));
-    return &p->passes[slot_index];
-}
-
-_SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t context_id) {
-    SOKOL_ASSERT(p && (SG_INVALID_ID != context_id));
-    int slot_index = _sg_slot_index(context_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->context_pool.size));
-    return &p->contexts[slot_index];
-}
-
-/* returns pointer to resource with matching id check, may return 0 */
-_SOKOL_PRIVATE _sg_buffer_t* _sg_lookup_buffer(const _sg_pools_t* p, uint32_t buf_id) {
-    if (SG_INVALID_ID != buf_id) {
-        _sg_buffer_t* buf = _sg_buffer_at(p, buf_id);
-        if (buf->slot.id == buf_id) {
-            return buf;
+_SOKOL_PRIVATE void _sg_sw_run_vertex_shader(const _sg_pipeline_t* pip, sg_sw_vs_args* args, int vertex_index, int instance_index, _sg_sw_vertex_t* out) {
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        const _sg_sw_attr_t* attr = &pip->sw.attrs[attr_index];
+        float* dst = args->attrs[attr_index];
+        dst[0] = 0.0f; dst[1] = 0.0f; dst[2] = 0.0f; dst[3] = 1.0f;
+        if (attr->vb_index < 0) {
+            continue;
         }
-    }
-    return 0;
-}
-
-_SOKOL_PRIVATE _sg_image_t* _sg_lookup_image(const _sg_pools_t* p, uint32_t img_id) {
-    if (SG_INVALID_ID != img_id) {
-        _sg_image_t* img = _sg_image_at(p, img_id);
-        if (img->slot.id == img_id) {
-            return img;
+        const _sg_buffer_t* vb = _sg.sw.vbs[attr->vb_index];
+        if (!vb) {
+            continue;
         }
-    }
-    return 0;
-}
-
-_SOKOL_PRIVATE _sg_shader_t* _sg_lookup_shader(const _sg_pools_t* p, uint32_t shd_id) {
-    SOKOL_ASSERT(p);
-    if (SG_INVALID_ID != shd_id) {
-        _sg_shader_t* shd = _sg_shader_at(p, shd_id);
-        if (shd->slot.id == shd_id) {
-            return shd;
+        int element_index = vertex_index;
+        if (attr->step_func == SG_VERTEXSTEP_PER_INSTANCE) {
+            element_index = instance_index / _sg_max(attr->step_rate, 1);
+        }
+        const int offset = _sg.sw.vb_offsets[attr->vb_index] + attr->offset + element_index * attr->stride;
+        if ((offset >= 0) && ((offset + _sg_vertexformat_bytesize(attr->format)) <= vb->cmn.size)) {
+            _sg_sw_load_attr(attr->format, vb->sw.ptr + offset, dst);
         }
     }
-    return 0;
+    args->vertex_index = vertex_index;
+    args->instance_index = instance_index;
+    pip->shader->sw.vs_func(args);
+    memcpy(out->pos, args->pos, sizeof(out->pos));
+    memcpy(out->varyings, args->varyings, sizeof(out->varyings));
 }
 
-_SOKOL_PRIVATE _sg_pipeline_t* _sg_lookup_pipeline(const _sg_pools_t* p, uint32_t pip_id) {
-    SOKOL_ASSERT(p);
-    if (SG_INVALID_ID != pip_id) {
-        _sg_pipeline_t* pip = _sg_pipeline_at(p, pip_id);
-        if (pip->slot.id == pip_id) {
-            return pip;
-        }
+_SOKOL_PRIVATE void _sg_sw_draw(int base_element, int num_elements, int num_instances) {
+    SOKOL_ASSERT(_sg.sw.in_pass);
+    const _sg_pipeline_t* pip = _sg.sw.cur_pipeline;
+    if (!pip || (num_elements <= 0) || (num_instances <= 0)) {
+        return;
     }
-    return 0;
-}
+    const _sg_shader_t* shd = pip->shader;
+    const int num_varyings = shd->sw.num_varyings;
 
-_SOKOL_PRIVATE _sg_pass_t* _sg_lookup_pass(const _sg_pools_t* p, uint32_t pass_id) {
-    SOKOL_ASSERT(p);
-    if (SG_INVALID_ID != pass_id) {
-        _sg_pass_t* pass = _sg_pass_at(p, pass_id);
-        if (pass->slot.id == pass_id) {
-            return pass;
+    /* remember the state for rasterization */
+    const int clip_x0 = _sg_max(_sg_max(_sg.sw.vp_x, _sg.sw.sc_x), 0);
+    const int clip_y0 = _sg_max(_sg_max(_sg.sw.vp_y, _sg.sw.sc_y), 0);
+    const int clip_x1 = _sg_min(_sg_min(_sg.sw.vp_x + _sg.sw.vp_w, _sg.sw.sc_x + _sg.sw.sc_w), _sg.sw.fb_width);
+    const int clip_y1 = _sg_min(_sg_min(_sg.sw.vp_y + _sg.sw.vp_h, _sg.sw.sc_y + _sg.sw.sc_h), _sg.sw.fb_height);
+    if ((clip_x0 >= clip_x1) || (clip_y0 >= clip_y1)) {
+        return;
+    }
+    const int draw_index = _sg.sw.draws.num;
+    _sg_sw_draw_t* draw = (_sg_sw_draw_t*) _sg_sw_array_push(&_sg.sw.draws, sizeof(_sg_sw_draw_t), 1);
+    draw->pip = pip;
+    memcpy(draw->ub_offsets, _sg.sw.ub_offsets[SG_SHADERSTAGE_FS], sizeof(draw->ub_offsets));
+    memcpy(draw->textures, _sg.sw.textures[SG_SHADERSTAGE_FS], sizeof(draw->textures));
+    draw->clip_x0 = clip_x0;
+    draw->clip_y0 = clip_y0;
+    draw->clip_x1 = clip_x1;
+    draw->clip_y1 = clip_y1;
+
+    /* the range of referenced vertices */
+    const bool indexed = (pip->cmn.index_type != SG_INDEXTYPE_NONE);
+    const uint8_t* indices = 0;
+    int min_index = base_element;
+    int max_index = base_element + num_elements - 1;
+    if (indexed) {
+        const _sg_buffer_t* ib = _sg.sw.ib;
+        SOKOL_ASSERT(ib);
+        const int index_size = (pip->cmn.index_type == SG_INDEXTYPE_UINT16) ? 2 : 4;
+        const int start = _sg.sw.ib_offset + base_element * index_size;
+        if ((start < 0) || ((start + num_elements * index_size) > ib->cmn.size)) {
+            SOKOL_LOG("sokol_gfx.h: SW backend: index buffer range out of bounds\n");
+            return;
+        }
+        indices = ib->sw.ptr + start;
+        min_index = max_index = _sg_sw_index(indices, pip->cmn.index_type, 0);
+        for (int i = 1; i < num_elements; i++) {
+            const int idx = _sg_sw_index(indices, pip->cmn.index_type, i);
+            min_index = _sg_min(min_index, idx);
+            max_index = _sg_max(max_index, idx);
+        }
+    }
+    /* shade the whole vertex range once if it's dense, otherwise each element */
+    const int range = max_index - min_index + 1;
+    const bool shade_range = range <= (2 * num_elements);
+    const int num_shaded = shade_range ? range : num_elements;
+
+    sg_sw_vs_args args;
+    memset(&args, 0, sizeof(args));
+    args.num_varyings = num_varyings;
+    for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+        const int offset = _sg.sw.ub_offsets[SG_SHADERSTAGE_VS][ub_index];
+        args.uniforms[ub_index] = (offset >= 0) ? (_sg.sw.uniforms.ptr + offset) : 0;
+    }
+    for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+        args.textures[img_index] = &_sg.sw.textures[SG_SHADERSTAGE_VS][img_index];
+    }
+
+    for (int instance_index = 0; instance_index < num_instances; instance_index++) {
+        const int first_vertex = _sg.sw.verts.num;
+        _sg_sw_array_push(&_sg.sw.verts, sizeof(_sg_sw_vertex_t), num_shaded);
+        for (int i = 0; i < num_shaded; i++) {
+            int vertex_index;
+            if (shade_range) {
+                vertex_index = min_index + i;
+            }
+            else {
+                vertex_index = indexed ? _sg_sw_index(indices, pip->cmn.index_type, i) : (base_element + i);
+            }
+            _sg_sw_vertex_t* v = &_sg_sw_item(_sg.sw.verts, _sg_sw_vertex_t, first_vertex + i);
+            _sg_sw_run_vertex_shader(pip, &args, vertex_index, instance_index, v);
+        }
+
+        /* assemble, clip and setup triangles */
+        int elm_verts[3];
+        int num_elm_verts = 0;
+        for (int i = 0; i < num_elements; i++) {
+            int v;
+            if (shade_range) {
+                const int idx = indexed ? _sg_sw_index(indices, pip->cmn.index_type, i) : (base_element + i);
+                v = first_vertex + (idx - min_index);
+            }
+            else {
+                v = first_vertex + i;
+            }
+            if (pip->sw.primitive_type == SG_PRIMITIVETYPE_TRIANGLES) {
+                elm_verts[num_elm_verts++] = v;
+                if (num_elm_verts == 3) {
+                    _sg_sw_clip_tri(draw_index, num_varyings, elm_verts[0], elm_verts[1], elm_verts[2]);
+                    num_elm_verts = 0;
+                }
+            }
+            else {
+                /* triangle strip, every 2nd triangle has its winding flipped */
+                if (i >= 2) {
+                    if (i & 1) {
+                        _sg_sw_clip_tri(draw_index, num_varyings, elm_verts[1], elm_verts[0], v);
+                    }
+                    else {
+                        _sg_sw_clip_tri(draw_index, num_varyings, elm_verts[0], elm_verts[1], v);
+                    }
+                    elm_verts[0] = elm_verts[1];
+                    elm_verts[1] = v;
+                }
+                else {
+                    elm_verts[i] = v;
+                }
+            }
         }
     }
-    return 0;
 }
 
-_SOKOL_PRIVATE _sg_context_t* _sg_lookup_context(const _sg_pools_t* p, uint32_t ctx_id) {
-    SOKOL_ASSERT(p);
-    if (SG_INVALID_ID != ctx_id) {
-        _sg_context_t* ctx = _sg_context_at(p, ctx_id);
-        if (ctx->slot.id == ctx_id) {
-            return ctx;
+/*-- tile rasterization ------------------------------------------------------*/
+
+/* conservative test whether a triangle overlaps a screen tile */
+_SOKOL_PRIVATE bool _sg_sw_tri_overlaps_tile(const _sg_sw_tri_t* tri, int tx, int ty) {
+    const float x0 = (float)(tx << _SG_SW_TILE_SHIFT) + 0.5f;
+    const float y0 = (float)(ty << _SG_SW_TILE_SHIFT) + 0.5f;
+    const float x1 = x0 + (float)(_SG_SW_TILE_SIZE - 1);
+    const float y1 = y0 + (float)(_SG_SW_TILE_SIZE - 1);
+    for (int i = 0; i < 3; i++) {
+        const float x = (tri->a[i] > 0.0f) ? x1 : x0;
+        const float y = (tri->b[i] > 0.0f) ? y1 : y0;
+        if ((tri->a[i] * x + tri->b[i] * y + tri->c[i]) < 0.0f) {
+            return false;
         }
     }
-    return 0;
+    return true;
 }
 
-_SOKOL_PRIVATE void _sg_destroy_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
-    /*  this is a bit dumb since it loops over all pool slots to
-        find the occupied slots, on the other hand it is only ever
-        executed at shutdown
-        NOTE: ONLY EXECUTE THIS AT SHUTDOWN
-              ...because the free queues will not be reset
-              and the resource slots not be cleared!
-    */
-    for (int i = 1; i < p->buffer_pool.size; i++) {
-        if (p->buffers[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->buffers[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_buffer(&p->buffers[i]);
+/* sort triangles into screen tiles, keeping the submission order in each tile */
+_SOKOL_PRIVATE int _sg_sw_bin_tris(void) {
+    const int tiles_x = (_sg.sw.fb_width + _SG_SW_TILE_SIZE - 1) >> _SG_SW_TILE_SHIFT;
+    const int tiles_y = (_sg.sw.fb_height + _SG_SW_TILE_SIZE - 1) >> _SG_SW_TILE_SHIFT;
+    const int num_tiles = tiles_x * tiles_y;
+    _sg.sw.tiles_x = tiles_x;
+    _sg.sw.tiles_y = tiles_y;
+    _sg.sw.tile_starts.num = 0;
+    _sg.sw.tile_tris.num = 0;
+    int* starts = (int*) _sg_sw_array_push(&_sg.sw.tile_starts, sizeof(int), num_tiles + 1);
+    memset(starts, 0, (size_t)(num_tiles + 1) * sizeof(int));
+
+    /* count the triangles in each tile */
+    const int num_tris = _sg.sw.tris.num;
+    for (int tri_index = 0; tri_index < num_tris; tri_index++) {
+        const _sg_sw_tri_t* tri = &_sg_sw_item(_sg.sw.tris, _sg_sw_tri_t, tri_index);
+        for (int ty = tri->y0 >> _SG_SW_TILE_SHIFT; ty <= ((tri->y1 - 1) >> _SG_SW_TILE_SHIFT); ty++) {
+            for (int tx = tri->x0 >> _SG_SW_TILE_SHIFT; tx <= ((tri->x1 - 1) >> _SG_SW_TILE_SHIFT); tx++) {
+                if (_sg_sw_tri_overlaps_tile(tri, tx, ty)) {
+                    starts[ty * tiles_x + tx + 1]++;
+                }
             }
         }
     }
-    for (int i = 1; i < p->image_pool.size; i++) {
-        if (p->images[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->images[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_image(&p->images[i]);
-            }
-        }
+    for (int i = 0; i < num_tiles; i++) {
+        starts[i + 1] += starts[i];
     }
-    for (int i = 1; i < p->shader_pool.size; i++) {
-        if (p->shaders[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->shaders[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_shader(&p->shaders[i]);
+
+    /* ...and fill the per-tile triangle lists */
+    int* tile_tris = (int*) _sg_sw_array_push(&_sg.sw.tile_tris, sizeof(int), starts[num_tiles]);
+    for (int tri_index = 0; tri_index < num_tris; tri_index++) {
+        const _sg_sw_tri_t* tri = &_sg_sw_item(_sg.sw.tris, _sg_sw_tri_t, tri_index);
+        for (int ty = tri->y0 >> _SG_SW_TILE_SHIFT; ty <= ((tri->y1 - 1) >> _SG_SW_TILE_SHIFT); ty++) {
+            for (int tx = tri->x0 >> _SG_SW_TILE_SHIFT; tx <= ((tri->x1 - 1) >> _SG_SW_TILE_SHIFT); tx++) {
+                if (_sg_sw_tri_overlaps_tile(tri, tx, ty)) {
+                    tile_tris[starts[ty * tiles_x + tx]++] = tri_index;
+                }
             }
         }
     }
-    for (int i = 1; i < p->pipeline_pool.size; i++) {
-        if (p->pipelines[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->pipelines[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_pipeline(&p->pipelines[i]);
+    /* the fill loop advanced each start to the next tile's start */
+    for (int i = num_tiles; i > 0; i--) {
+        starts[i] = starts[i - 1];
+    }
+    starts[0] = 0;
+    return num_tiles;
+}
+
+_SOKOL_PRIVATE int _sg_sw_depth_test(sg_compare_func func, _sg_sw_f4 z, _sg_sw_f4 d) {
+    switch (func) {
+        case SG_COMPAREFUNC_NEVER:          return 0;
+        case SG_COMPAREFUNC_LESS:           return _sg_sw_f4_gt(d, z);
+        case SG_COMPAREFUNC_EQUAL:          return _sg_sw_f4_eq(z, d);
+        case SG_COMPAREFUNC_LESS_EQUAL:     return _sg_sw_f4_ge(d, z);
+        case SG_COMPAREFUNC_GREATER:        return _sg_sw_f4_gt(z, d);
+        case SG_COMPAREFUNC_NOT_EQUAL:      return _sg_sw_f4_eq(z, d) ^ 0xF;
+        case SG_COMPAREFUNC_GREATER_EQUAL:  return _sg_sw_f4_ge(z, d);
+        default:                            return 0xF;
+    }
+}
+
+_SOKOL_PRIVATE float _sg_sw_blend_factor(sg_blend_factor factor, const float* src, const float* dst, const float* blend_color, int c) {
+    switch (factor) {
+        case SG_BLENDFACTOR_ZERO:                   return 0.0f;
+        case SG_BLENDFACTOR_ONE:                    return 1.0f;
+        case SG_BLENDFACTOR_SRC_COLOR:              return src[c];
+        case SG_BLENDFACTOR_ONE_MINUS_SRC_COLOR:    return 1.0f - src[c];
+        case SG_BLENDFACTOR_SRC_ALPHA:              return src[3];
+        case SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA:    return 1.0f - src[3];
+        case SG_BLENDFACTOR_DST_COLOR:              return dst[c];
+        case SG_BLENDFACTOR_ONE_MINUS_DST_COLOR:    return 1.0f - dst[c];
+        case SG_BLENDFACTOR_DST_ALPHA:              return dst[3];
+        case SG_BLENDFACTOR_ONE_MINUS_DST_ALPHA:    return 1.0f - dst[3];
+        case SG_BLENDFACTOR_SRC_ALPHA_SATURATED:    return (c == 3) ? 1.0f : _sg_min(src[3], 1.0f - dst[3]);
+        case SG_BLENDFACTOR_BLEND_COLOR:            return blend_color[c];
+        case SG_BLENDFACTOR_ONE_MINUS_BLEND_COLOR:  return 1.0f - blend_color[c];
+        case SG_BLENDFACTOR_BLEND_ALPHA:            return blend_color[3];
+        case SG_BLENDFACTOR_ONE_MINUS_BLEND_ALPHA:  return 1.0f - blend_color[3];
+        default:                                    return 1.0f;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_sw_write_color(const _sg_pipeline_t* pip, const _sg_sw_surface_t* surf, int x, int y, const float* src) {
+    const sg_blend_state* bs = &pip->sw.blend;
+    const int mask = bs->color_write_mask & SG_COLORMASK_RGBA;
+    if (0 == mask) {
+        return;
+    }
+    uint8_t* ptr = surf->ptr + y * surf->pitch + x * _sg_sw_pixelformat_bytesize(surf->format);
+    float dst[4];
+    float res[4];
+    if (bs->enabled || (mask != SG_COLORMASK_RGBA)) {
+        _sg_sw_load_texel(surf->format, ptr, dst);
+    }
+    for (int c = 0; c < 4; c++) {
+        if (bs->enabled) {
+            const bool alpha = (c == 3);
+            const float sf = _sg_sw_blend_factor(alpha ? bs->src_factor_alpha : bs->src_factor_rgb, src, dst, pip->cmn.blend_color, c);
+            const float df = _sg_sw_blend_factor(alpha ? bs->dst_factor_alpha : bs->dst_factor_rgb, src, dst, pip->cmn.blend_color, c);
+            switch (alpha ? bs->op_alpha : bs->op_rgb) {
+                case SG_BLENDOP_SUBTRACT:           res[c] = src[c] * sf - dst[c] * df; break;
+                case SG_BLENDOP_REVERSE_SUBTRACT:   res[c] = dst[c] * df - src[c] * sf; break;
+                default:                            res[c] = src[c] * sf + dst[c] * df; break;
             }
         }
-    }
-    for (int i = 1; i < p->pass_pool.size; i++) {
-        if (p->passes[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->passes[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_pass(&p->passes[i]);
+        else {
+            res[c] = src[c];
+        }
+        if (0 == (mask & (1<<c))) {
+            res[c] = dst[c];
+        }
+    }
+    _sg_sw_store_texel(surf->format, ptr, res);
+}
+
+/* rasterize all triangles of a screen tile, 4 pixels at a time */
+_SOKOL_PRIVATE void _sg_sw_raster_tile(int tile_index) {
+    const int tx = tile_index % _sg.sw.tiles_x;
+    const int ty = tile_index / _sg.sw.tiles_x;
+    const int tile_x0 = tx << _SG_SW_TILE_SHIFT;
+    const int tile_y0 = ty << _SG_SW_TILE_SHIFT;
+    const int tile_x1 = _sg_min(tile_x0 + _SG_SW_TILE_SIZE, _sg.sw.fb_width);
+    const int tile_y1 = _sg_min(tile_y0 + _SG_SW_TILE_SIZE, _sg.sw.fb_height);
+    const int* starts = (const int*) _sg.sw.tile_starts.ptr;
+    const int* tile_tris = (const int*) _sg.sw.tile_tris.ptr;
+    const float lane_offsets_f[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+    const _sg_sw_f4 lane_offsets = _sg_sw_f4_load(lane_offsets_f);
+    const _sg_sw_f4 zero = _sg_sw_f4_set1(0.0f);
+    const _sg_sw_f4 one = _sg_sw_f4_set1(1.0f);
+    sg_sw_fs_args args;
+    memset(&args, 0, sizeof(args));
+
+    for (int i = starts[tile_index]; i < starts[tile_index + 1]; i++) {
+        const _sg_sw_tri_t* tri = &_sg_sw_item(_sg.sw.tris, _sg_sw_tri_t, tile_tris[i]);
+        const _sg_sw_draw_t* draw = &_sg_sw_item(_sg.sw.draws, _sg_sw_draw_t, tri->draw_index);
+        const _sg_pipeline_t* pip = draw->pip;
+        const _sg_shader_t* shd = pip->shader;
+        const int num_varyings = shd->sw.num_varyings;
+        const _sg_sw_vertex_t* v0 = &_sg_sw_item(_sg.sw.verts, _sg_sw_vertex_t, tri->v[0]);
+        const _sg_sw_vertex_t* v1 = &_sg_sw_item(_sg.sw.verts, _sg_sw_vertex_t, tri->v[1]);
+        const _sg_sw_vertex_t* v2 = &_sg_sw_item(_sg.sw.verts, _sg_sw_vertex_t, tri->v[2]);
+        const bool depth_test = (0 != _sg.sw.depth);
+        const bool depth_write = depth_test && pip->sw.depth_stencil.depth_write_enabled;
+        const sg_compare_func depth_func = pip->sw.depth_stencil.depth_compare_func;
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            const int offset = draw->ub_offsets[ub_index];
+            args.uniforms[ub_index] = (offset >= 0) ? (_sg.sw.uniforms.ptr + offset) : 0;
+        }
+        for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+            args.textures[img_index] = &draw->textures[img_index];
+        }
+        args.front_facing = tri->front_facing;
+
+        const int x0 = _sg_max(tri->x0, tile_x0);
+        const int y0 = _sg_max(tri->y0, tile_y0);
+        const int x1 = _sg_min(tri->x1, tile_x1);
+        const int y1 = _sg_min(tri->y1, tile_y1);
+        for (int y = y0; y < y1; y++) {
+            const _sg_sw_f4 py = _sg_sw_f4_set1((float)y + 0.5f);
+            float* depth_row = depth_test ? (_sg.sw.depth + y * _sg.sw.depth_pitch) : 0;
+            for (int x = x0; x < x1; x += 4) {
+                /* evaluate the edge functions at 4 pixel centers */
+                const _sg_sw_f4 px = _sg_sw_f4_add(_sg_sw_f4_set1((float)x), lane_offsets);
+                _sg_sw_f4 e[3];
+                int mask = (x1 - x >= 4) ? 0xF : ((1 << (x1 - x)) - 1);
+                for (int k = 0; k < 3; k++) {
+                    e[k] = _sg_sw_f4_add(_sg_sw_f4_add(_sg_sw_f4_mul(_sg_sw_f4_set1(tri->a[k]), px),
+                                                       _sg_sw_f4_mul(_sg_sw_f4_set1(tri->b[k]), py)),
+                                         _sg_sw_f4_set1(tri->c[k]));
+                    mask &= tri->top_left[k] ? _sg_sw_f4_ge(e[k], zero) : _sg_sw_f4_gt(e[k], zero);
+                }
+                if (0 == mask) {
+                    continue;
+                }
+                /* barycentrics and depth */
+                const _sg_sw_f4 inv_area = _sg_sw_f4_set1(tri->inv_area);
+                const _sg_sw_f4 l0 = _sg_sw_f4_mul(e[0], inv_area);
+                const _sg_sw_f4 l1 = _sg_sw_f4_mul(e[1], inv_area);
+                const _sg_sw_f4 l2 = _sg_sw_f4_mul(e[2], inv_area);
+                const _sg_sw_f4 z = _sg_sw_f4_add(_sg_sw_f4_add(
+                    _sg_sw_f4_mul(l0, _sg_sw_f4_set1(tri->z[0])),
+                    _sg_sw_f4_mul(l1, _sg_sw_f4_set1(tri->z[1]))),
+                    _sg_sw_f4_mul(l2, _sg_sw_f4_set1(tri->z[2])));
+                mask &= _sg_sw_f4_ge(z, zero) & _sg_sw_f4_ge(one, z);
+                if (depth_test && mask) {
+                    float d[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                    for (int lane = 0; lane < 4; lane++) {
+                        if ((x + lane) < x1) {
+                            d[lane] = depth_row[x + lane];
+                        }
+                    }
+                    mask &= _sg_sw_depth_test(depth_func, z, _sg_sw_f4_load(d));
+                }
+                if (0 == mask) {
+                    continue;
+                }
+                /* perspective-correct barycentrics */
+                const _sg_sw_f4 w0 = _sg_sw_f4_mul(l0, _sg_sw_f4_set1(tri->inv_w[0]));
+                const _sg_sw_f4 w1 = _sg_sw_f4_mul(l1, _sg_sw_f4_set1(tri->inv_w[1]));
+                const _sg_sw_f4 w2 = _sg_sw_f4_mul(l2, _sg_sw_f4_set1(tri->inv_w[2]));
+                const _sg_sw_f4 inv_w = _sg_sw_f4_add(_sg_sw_f4_add(w0, w1), w2);
+                const _sg_sw_f4 rcp_w = _sg_sw_f4_div(one, inv_w);
+                float p[3][4], zs[4], iws[4];
+                _sg_sw_f4_store(p[0], _sg_sw_f4_mul(w0, rcp_w));
+                _sg_sw_f4_store(p[1], _sg_sw_f4_mul(w1, rcp_w));
+                _sg_sw_f4_store(p[2], _sg_sw_f4_mul(w2, rcp_w));
+                _sg_sw_f4_store(zs, z);
+                _sg_sw_f4_store(iws, inv_w);
+
+                /* run the fragment shader for each covered pixel */
+                for (int lane = 0; lane < 4; lane++) {
+                    if (0 == (mask & (1<<lane))) {
+                        continue;
+                    }
+                    const _sg_sw_f4 p0 = _sg_sw_f4_set1(p[0][lane]);
+                    const _sg_sw_f4 p1 = _sg_sw_f4_set1(p[1][lane]);
+                    const _sg_sw_f4 p2 = _sg_sw_f4_set1(p[2][lane]);
+                    for (int k = 0; k < num_varyings; k += 4) {
+                        _sg_sw_f4_store(&args.varyings[k], _sg_sw_f4_add(_sg_sw_f4_add(
+                            _sg_sw_f4_mul(p0, _sg_sw_f4_load(&v0->varyings[k])),
+                            _sg_sw_f4_mul(p1, _sg_sw_f4_load(&v1->varyings[k]))),
+                            _sg_sw_f4_mul(p2, _sg_sw_f4_load(&v2->varyings[k]))));
+                    }
+                    args.frag_coord[0] = (float)(x + lane) + 0.5f;
+                    args.frag_coord[1] = (float)y + 0.5f;
+                    args.frag_coord[2] = zs[lane];
+                    args.frag_coord[3] = iws[lane];
+                    memset(args.color, 0, sizeof(args.color));
+                    if (!shd->sw.fs_func(&args)) {
+                        continue;
+                    }
+                    if (depth_write) {
+                        depth_row[x + lane] = zs[lane];
+                    }
+                    for (int att_index = 0; att_index < _sg.sw.num_color_atts; att_index++) {
+                        _sg_sw_write_color(pip, &_sg.sw.colors[att_index], x + lane, y, args.color[att_index]);
+                    }
+                }
             }
         }
     }
 }
 
-/*== VALIDATION LAYER ========================================================*/
-#if defined(SOKOL_DEBUG)
-/* return a human readable string for an _sg_validate_error */
-_SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
-    switch (err) {
-        /* buffer creation validation errors */
-        case _SG_VALIDATE_BUFFERDESC_CANARY:        return "sg_buffer_desc not initialized";
-        case _SG_VALIDATE_BUFFERDESC_SIZE:          return "sg_buffer_desc.size cannot be 0";
-        case _SG_VALIDATE_BUFFERDESC_CONTENT:       return "immutable buffers must be initialized with content (sg_buffer_desc.content)";
-        case _SG_VALIDATE_BUFFERDESC_NO_CONTENT:    return "dynamic/stream usage buffers cannot be initialized with content";
-
-        /* image creation validation errros */
-        case _SG_VALIDATE_IMAGEDESC_CANARY:             return "sg_image_desc not initialized";
-        case _SG_VALIDATE_IMAGEDESC_WIDTH:              return "sg_image_desc.width must be > 0";
-        case _SG_VALIDATE_IMAGEDESC_HEIGHT:             return "sg_image_desc.height must be > 0";
-        case _SG_VALIDATE_IMAGEDESC_RT_PIXELFORMAT:     return "invalid pixel format for render-target image";
-        case _SG_VALIDATE_IMAGEDESC_NONRT_PIXELFORMAT:  return "invalid pixel format for non-render-target image";
-        case _SG_VALIDATE_IMAGEDESC_MSAA_BUT_NO_RT:     return "non-render-target images cannot be multisampled";
-        case _SG_VALIDATE_IMAGEDESC_NO_MSAA_RT_SUPPORT: return "MSAA not supported for this pixel format";
-        case _SG_VALIDATE_IMAGEDESC_RT_IMMUTABLE:       return "render target images must be SG_USAGE_IMMUTABLE";
-        case _SG_VALIDATE_IMAGEDESC_RT_NO_CONTENT:      return "render target images cannot be initialized with content";
-        case _SG_VALIDATE_IMAGEDESC_CONTENT:            return "missing or invalid content for immutable image";
-        case _SG_VALIDATE_IMAGEDESC_NO_CONTENT:         return "dynamic/stream usage images cannot be initialized with content";
-
-        /* shader creation */
-        case _SG_VALIDATE_SHADERDESC_CANARY:                return "sg_shader_desc not initialized";
-        case _SG_VALIDATE_SHADERDESC_SOURCE:                return "shader source code required";
-        case _SG_VALIDATE_SHADERDESC_BYTECODE:              return "shader byte code required";
-        case _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE:    return "shader source or byte code required";
-        case _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE:      return "shader byte code length (in bytes) required";
-        case _SG_VALIDATE_SHADERDESC_NO_CONT_UBS:           return "shader uniform blocks must occupy continuous slots";
-        case _SG_VALIDATE_SHADERDESC_NO_CONT_UB_MEMBERS:    return "uniform block members must occupy continuous slots";
-        case _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS:         return "GL backend requires uniform block member declarations";
-        case _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME:        return "uniform block member name missing";
-        case _SG_VALIDATE_SHADERDESC_UB_SIZE_MISMATCH:      return "size of uniform block members doesn't match uniform block size";
-        case _SG_VALIDATE_SHADERDESC_NO_CONT_IMGS:          return "shader images must occupy continuous slots";
-        case _SG_VALIDATE_SHADERDESC_IMG_NAME:              return "GL backend requires uniform block member names";
-        case _SG_VALIDATE_SHADERDESC_ATTR_NAMES:            return "GLES2 backend requires vertex attribute names";
-        case _SG_VALIDATE_SHADERDESC_ATTR_SEMANTICS:        return "D3D11 backend requires vertex attribute semantics";
-        case _SG_VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG:  return "vertex attribute name/semantic string too long (max len 16)";
-
-        /* pipeline creation */
-        case _SG_VALIDATE_PIPELINEDESC_CANARY:          return "sg_pipeline_desc not initialized";
-        case _SG_VALIDATE_PIPELINEDESC_SHADER:          return "sg_pipeline_desc.shader missing or invalid";
-        case _SG_VALIDATE_PIPELINEDESC_NO_ATTRS:        return "sg_pipeline_desc.layout.attrs is empty or not continuous";
-        case _SG_VALIDATE_PIPELINEDESC_LAYOUT_STRIDE4:  return "sg_pipeline_desc.layout.buffers[].stride must be multiple of 4";
-        case _SG_VALIDATE_PIPELINEDESC_ATTR_NAME:       return "GLES2/WebGL missing vertex attribute name in shader";
-        case _SG_VALIDATE_PIPELINEDESC_ATTR_SEMANTICS:  return "D3D11 missing vertex attribute semantics in shader";
-
-        /* pass creation */
-        case _SG_VALIDATE_PASSDESC_CANARY:                  return "sg_pass_desc not initialized";
-        case _SG_VALIDATE_PASSDESC_NO_COLOR_ATTS:           return "sg_pass_desc.color_attachments[0] must be valid";
-        case _SG_VALIDATE_PASSDESC_NO_CONT_COLOR_ATTS:      return "color attachments must occupy continuous slots";
-        case _SG_VALIDATE_PASSDESC_IMAGE:                   return "pass attachment image is not valid";
-        case _SG_VALIDATE_PASSDESC_MIPLEVEL:                return "pass attachment mip level is bigger than image has mipmaps";
-        case _SG_VALIDATE_PASSDESC_FACE:                    return "pass attachment image is cubemap, but face index is too big";
-        case _SG_VALIDATE_PASSDESC_LAYER:                   return "pass attachment image is array texture, but layer index is too big";
-        case _SG_VALIDATE_PASSDESC_SLICE:                   return "pass attachment image is 3d texture, but slice value is too big";
-        case _SG_VALIDATE_PASSDESC_IMAGE_NO_RT:             return "pass attachment image must be render targets";
-        case _SG_VALIDATE_PASSDESC_COLOR_PIXELFORMATS:      return "all pass color attachment images must have the same pixel format";
-        case _SG_VALIDATE_PASSDESC_COLOR_INV_PIXELFORMAT:   return "pass color-attachment images must have a renderable pixel format";
-        case _SG_VALIDATE_PASSDESC_DEPTH_INV_PIXELFORMAT:   return "pass depth-attachment image must have depth pixel format";
-        case _SG_VALIDATE_PASSDESC_IMAGE_SIZES:             return "all pass attachments must have the same size";
-        case _SG_VALIDATE_PASSDESC_IMAGE_SAMPLE_COUNTS:     return "all pass attachments must have the same sample count";
-
-        /* sg_begin_pass */
-        case _SG_VALIDATE_BEGINPASS_PASS:       return "sg_begin_pass: pass must be valid";
-        case _SG_VALIDATE_BEGINPASS_IMAGE:      return "sg_begin_pass: one or more attachment images are not valid";
-
-        /* sg_apply_pipeline */
-        case _SG_VALIDATE_APIP_PIPELINE_VALID_ID:   return "sg_apply_pipeline: invalid pipeline id provided";
-        case _SG_VALIDATE_APIP_PIPELINE_EXISTS:     return "sg_apply_pipeline: pipeline object no longer alive";
-        case _SG_VALIDATE_APIP_PIPELINE_VALID:      return "sg_apply_pipeline: pipeline object not in valid state";
-        case _SG_VALIDATE_APIP_SHADER_EXISTS:       return "sg_apply_pipeline: shader object no longer alive";
-        case _SG_VALIDATE_APIP_SHADER_VALID:        return "sg_apply_pipeline: shader object not in valid state";
-        case _SG_VALIDATE_APIP_ATT_COUNT:           return "sg_apply_pipeline: color_attachment_count in pipeline doesn't match number of pass color attachments";
-        case _SG_VALIDATE_APIP_COLOR_FORMAT:        return "sg_apply_pipeline: color_format in pipeline doesn't match pass color attachment pixel format";
-        case _SG_VALIDATE_APIP_DEPTH_FORMAT:        return "sg_apply_pipeline: depth_format in pipeline doesn't match pass depth attachment pixel format";
-        case _SG_VALIDATE_APIP_SAMPLE_COUNT:        return "sg_apply_pipeline: MSAA sample count in pipeline doesn't match render pass attachment sample count";
-
-        /* sg_apply_bindings */
-        case _SG_VALIDATE_ABND_PIPELINE:            return "sg_apply_bindings: must be called after sg_apply_pipeline";
-        case _SG_VALIDATE_ABND_PIPELINE_EXISTS:     return "sg_apply_bindings: currently applied pipeline object no longer alive";
-        case _SG_VALIDATE_ABND_PIPELINE_VALID:      return "sg_apply_bindings: currently applied pipeline object not in valid state";
-        case _SG_VALIDATE_ABND_VBS:                 return "sg_apply_bindings: number of vertex buffers doesn't match number of pipeline vertex layouts";
-        case _SG_VALIDATE_ABND_VB_EXISTS:           return "sg_apply_bindings: vertex buffer no longer alive";
-        case _SG_VALIDATE_ABND_VB_TYPE:             return "sg_apply_bindings: buffer in vertex buffer slot is not a SG_BUFFERTYPE_VERTEXBUFFER";
-        case _SG_VALIDATE_ABND_VB_OVERFLOW:         return "sg_apply_bindings: buffer in vertex buffer slot is overflown";
-        case _SG_VALIDATE_ABND_NO_IB:               return "sg_apply_bindings: pipeline object defines indexed rendering, but no index buffer provided";
-        case _SG_VALIDATE_ABND_IB:                  return "sg_apply_bindings: pipeline object defines non-indexed rendering, but index buffer provided";
-        case _SG_VALIDATE_ABND_IB_EXISTS:           return "sg_apply_bindings: index buffer no longer alive";
-        case _SG_VALIDATE_ABND_IB_TYPE:             return "sg_apply_bindings: buffer in index buffer slot is not a SG_BUFFERTYPE_INDEXBUFFER";
-        case _SG_VALIDATE_ABND_IB_OVERFLOW:         return "sg_apply_bindings: buffer in index buffer slot is overflown";
-        case _SG_VALIDATE_ABND_VS_IMGS:             return "sg_apply_bindings: vertex shader image count doesn't match sg_shader_desc";
-        case _SG_VALIDATE_ABND_VS_IMG_EXISTS:       return "sg_apply_bindings: vertex shader image no longer alive";
-        case _SG_VALIDATE_ABND_VS_IMG_TYPES:        return "sg_apply_bindings: one or more vertex shader image types don't match sg_shader_desc";
-        case _SG_VALIDATE_ABND_FS_IMGS:             return "sg_apply_bindings: fragment shader image count doesn't match sg_shader_desc";
-        case _SG_VALIDATE_ABND_FS_IMG_EXISTS:       return "sg_apply_bindings: fragment shader image no longer alive";
-        case _SG_VALIDATE_ABND_FS_IMG_TYPES:        return "sg_apply_bindings: one or more fragment shader image types don't match sg_shader_desc";
-
-        /* sg_apply_uniforms */
-        case _SG_VALIDATE_AUB_NO_PIPELINE:      return "sg_apply_uniforms: must be called after sg_apply_pipeline()";
-        case _SG_VALIDATE_AUB_NO_UB_AT_SLOT:    return "sg_apply_uniforms: no uniform block declaration at this shader stage UB slot";
-        case _SG_VALIDATE_AUB_SIZE:             return "sg_apply_uniforms: data size exceeds declared uniform block size";
-
-        /* sg_update_buffer */
-        case _SG_VALIDATE_UPDATEBUF_USAGE:      return "sg_update_buffer: cannot update immutable buffer";
-        case _SG_VALIDATE_UPDATEBUF_SIZE:       return "sg_update_buffer: update size is bigger than buffer size";
-        case _SG_VALIDATE_UPDATEBUF_ONCE:       return "sg_update_buffer: only one update allowed per buffer and frame";
-        case _SG_VALIDATE_UPDATEBUF_APPEND:     return "sg_update_buffer: cannot call sg_update_buffer and sg_append_buffer in same frame";
-
-        /* sg_append_buffer */
-        case _SG_VALIDATE_APPENDBUF_USAGE:      return "sg_append_buffer: cannot append to immutable buffer";
-        case _SG_VALIDATE_APPENDBUF_SIZE:       return "sg_append_buffer: overall appended size is bigger than buffer size";
-        case _SG_VALIDATE_APPENDBUF_UPDATE:     return "sg_append_buffer: cannot call sg_append_buffer and sg_update_buffer in same frame";
-
-        /* sg_update_image */
-        case _SG_VALIDATE_UPDIMG_USAGE:         return "sg_update_image: cannot update immutable image";
-        case _SG_VALIDATE_UPDIMG_NOTENOUGHDATA: return "sg_update_image: not enough subimage data provided";
-        case _SG_VALIDATE_UPDIMG_SIZE:          return "sg_update_image: provided subimage data size too big";
-        case _SG_VALIDATE_UPDIMG_COMPRESSED:    return "sg_update_image: cannot update images with compressed format";
-        case _SG_VALIDATE_UPDIMG_ONCE:          return "sg_update_image: only one update allowed per image and frame";
-
-        default: return "unknown validation error";
+_SOKOL_PRIVATE void _sg_sw_end_pass(void) {
+    SOKOL_ASSERT(_sg.sw.in_pass);
+    if (_sg.sw.tris.num > 0) {
+        const int num_tiles = _sg_sw_bin_tris();
+        _sg_sw_dispatch_tiles(num_tiles);
     }
+    _sg.sw.uniforms.num = 0;
+    _sg.sw.verts.num = 0;
+    _sg.sw.draws.num = 0;
+    _sg.sw.tris.num = 0;
+    _sg.sw.cur_pipeline = 0;
+    _sg.sw.in_pass = false;
 }
-#endif /* defined(SOKOL_DEBUG) */
 
-/*-- validation checks -------------------------------------------------------*/
-#if defined(SOKOL_DEBUG)
-_SOKOL_PRIVATE void _sg_validate_begin(void) {
-    _sg.validate_error = _SG_VALIDATE_SUCCESS;
+_SOKOL_PRIVATE void _sg_sw_commit(void) {
+    SOKOL_ASSERT(!_sg.sw.in_pass);
 }
 
-_SOKOL_PRIVATE void _sg_validate(bool cond, _sg_validate_error_t err) {
-    if (!cond) {
-        _sg.validate_error = err;
-        SOKOL_LOG(_sg_validate_string(err));
-    }
+_SOKOL_PRIVATE void _sg_sw_update_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size) {
+    SOKOL_ASSERT(buf && data && (data_size > 0));
+    /* NOTE: vertices are processed in sg_draw(), so updating in place is safe */
+    memcpy(buf->sw.ptr, data, (size_t)_sg_min((int)data_size, buf->cmn.size));
 }
 
-_SOKOL_PRIVATE bool _sg_validate_end(void) {
-    if (_sg.validate_error != _SG_VALIDATE_SUCCESS) {
-        #if !defined(SOKOL_VALIDATE_NON_FATAL)
-            SOKOL_LOG("^^^^  VALIDATION FAILED, TERMINATING ^^^^");
-            SOKOL_ASSERT(false);
-        #endif
+_SOKOL_PRIVATE uint32_t _sg_sw_append_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size, bool new_frame) {
+    SOKOL_ASSERT(buf && data && (data_size > 0));
+    _SOKOL_UNUSED(new_frame);
+    const int offset = buf->cmn.append_pos;
+    memcpy(buf->sw.ptr + offset, data, (size_t)_sg_min((int)data_size, buf->cmn.size - offset));
+    /* NOTE: this is a requirement from WebGPU, but we want identical behaviour across all backend */
+    return _sg_roundup(data_size, 4);
+}
+
+_SOKOL_PRIVATE void _sg_sw_update_image(_sg_image_t* img, const sg_image_content* data) {
+    SOKOL_ASSERT(img && data);
+    _sg_sw_copy_image_content(img, data);
+}
+
+/* img is null for the default framebuffer */
+_SOKOL_PRIVATE bool _sg_sw_read_pixels(const _sg_image_t* img, void* ptr, int num_bytes) {
+    SOKOL_ASSERT(ptr && (num_bytes >= 0));
+    if (_sg.sw.in_pass) {
+        SOKOL_LOG("sokol_gfx.h: sg_sw_read_pixels() must be called outside of a pass\n");
         return false;
     }
+    const uint8_t* src;
+    int size;
+    if (img) {
+        src = img->sw.ptr;
+        size = img->cmn.width * img->cmn.height * img->sw.bytes_per_pixel;
+    }
     else {
-        return true;
+        src = _sg.sw.def_color;
+        size = _sg.sw.def_width * _sg.sw.def_height * 4;
+    }
+    if (!src || (num_bytes < size)) {
+        return false;
     }
+    memcpy(ptr, src, (size_t)size);
+    return true;
 }
 #endif
 
-_SOKOL_PRIVATE bool _sg_validate_buffer_desc(const sg_buffer_desc* desc) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(desc);
-        return true;
+/*== BACKEND API WRAPPERS ====================================================*/
+static inline void _sg_setup_backend(const sg_desc* desc) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_setup_backend(desc);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_setup_backend(desc);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_setup_backend(desc);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_setup_backend(desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_setup_backend(desc);
+    #elif defined(SOKOL_SW)
+    _sg_sw_setup_backend(desc);
     #else
-        SOKOL_ASSERT(desc);
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_BUFFERDESC_CANARY);
-        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_BUFFERDESC_CANARY);
-        SOKOL_VALIDATE(desc->size > 0, _SG_VALIDATE_BUFFERDESC_SIZE);
-        bool injected = (0 != desc->gl_buffers[0]) ||
-                        (0 != desc->mtl_buffers[0]) ||
-                        (0 != desc->d3d11_buffer) ||
-                        (0 != desc->wgpu_buffer);
-        if (!injected && (desc->usage == SG_USAGE_IMMUTABLE)) {
-            SOKOL_VALIDATE(0 != desc->content, _SG_VALIDATE_BUFFERDESC_CONTENT);
-        }
-        else {
-            SOKOL_VALIDATE(0 == desc->content, _SG_VALIDATE_BUFFERDESC_NO_CONTENT);
-        }
-        return SOKOL_VALIDATE_END();
+    #error("INVALID BACKEND");
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_image_desc(const sg_image_desc* desc) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(desc);
-        return true;
+static inline void _sg_discard_backend(void) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_discard_backend();
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_discard_backend();
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_discard_backend();
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_discard_backend();
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_discard_backend();
+    #elif defined(SOKOL_SW)
+    _sg_sw_discard_backend();
     #else
-        SOKOL_ASSERT(desc);
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_IMAGEDESC_CANARY);
-        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_IMAGEDESC_CANARY);
-        SOKOL_VALIDATE(desc->width > 0, _SG_VALIDATE_IMAGEDESC_WIDTH);
-        SOKOL_VALIDATE(desc->height > 0, _SG_VALIDATE_IMAGEDESC_HEIGHT);
-        const sg_pixel_format fmt = desc->pixel_format;
-        const sg_usage usage = desc->usage;
-        const bool injected = (0 != desc->gl_textures[0]) ||
-                              (0 != desc->mtl_textures[0]) ||
-                              (0 != desc->d3d11_texture) ||
-                              (0 != desc->wgpu_texture);
-        if (desc->render_target) {
-            SOKOL_ASSERT(((int)fmt >= 0) && ((int)fmt < _SG_PIXELFORMAT_NUM));
-            SOKOL_VALIDATE(_sg.formats[fmt].render, _SG_VALIDATE_IMAGEDESC_RT_PIXELFORMAT);
-            /* on GLES2, sample count for render targets is completely ignored */
-            #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
-            if (!_sg.gl.gles2) {
-            #endif
-                if (desc->sample_count > 1) {
-                    SOKOL_VALIDATE(_sg.features.msaa_render_targets && _sg.formats[fmt].msaa, _SG_VALIDATE_IMAGEDESC_NO_MSAA_RT_SUPPORT);
-                }
-            #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
-            }
-            #endif
-            SOKOL_VALIDATE(usage == SG_USAGE_IMMUTABLE, _SG_VALIDATE_IMAGEDESC_RT_IMMUTABLE);
-            SOKOL_VALIDATE(desc->content.subimage[0][0].ptr==0, _SG_VALIDATE_IMAGEDESC_RT_NO_CONTENT);
-        }
-        else {
-            SOKOL_VALIDATE(desc->sample_count <= 1, _SG_VALIDATE_IMAGEDESC_MSAA_BUT_NO_RT);
-            const bool valid_nonrt_fmt = !_sg_is_valid_rendertarget_depth_format(fmt);
-            SOKOL_VALIDATE(valid_nonrt_fmt, _SG_VALIDATE_IMAGEDESC_NONRT_PIXELFORMAT);
-            /* FIXME: should use the same "expected size" computation as in _sg_validate_update_image() here */
-            if (!injected && (usage == SG_USAGE_IMMUTABLE)) {
-                const int num_faces = desc->type == SG_IMAGETYPE_CUBE ? 6:1;
-                const int num_mips = desc->num_mipmaps;
-                for (int face_index = 0; face_index < num_faces; face_index++) {
-                    for (int mip_index = 0; mip_index < num_mips; mip_index++) {
-                        const bool has_data = desc->content.subimage[face_index][mip_index].ptr != 0;
-                        const bool has_size = desc->content.subimage[face_index][mip_index].size > 0;
-                        SOKOL_VALIDATE(has_data && has_size, _SG_VALIDATE_IMAGEDESC_CONTENT);
-                    }
-                }
-            }
-            else {
-                for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
-                    for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
-                        const bool no_data = 0 == desc->content.subimage[face_index][mip_index].ptr;
-                        const bool no_size = 0 == desc->content.subimage[face_index][mip_index].size;
-                        SOKOL_VALIDATE(no_data && no_size, _SG_VALIDATE_IMAGEDESC_NO_CONTENT);
-                    }
-                }
-            }
-        }
-        return SOKOL_VALIDATE_END();
+    #error("INVALID BACKEND");
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(desc);
-        return true;
+static inline void _sg_reset_state_cache(void) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_reset_state_cache();
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_reset_state_cache();
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_reset_state_cache();
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_reset_state_cache();
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_reset_state_cache();
+    #elif defined(SOKOL_SW)
+    _sg_sw_reset_state_cache();
     #else
-        SOKOL_ASSERT(desc);
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_SHADERDESC_CANARY);
-        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_SHADERDESC_CANARY);
-        #if defined(SOKOL_GLES2)
-            SOKOL_VALIDATE(0 != desc->attrs[0].name, _SG_VALIDATE_SHADERDESC_ATTR_NAMES);
-        #elif defined(SOKOL_D3D11)
-            SOKOL_VALIDATE(0 != desc->attrs[0].sem_name, _SG_VALIDATE_SHADERDESC_ATTR_SEMANTICS);
-        #endif
-        #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
-            /* on GL, must provide shader source code */
-            SOKOL_VALIDATE(0 != desc->vs.source, _SG_VALIDATE_SHADERDESC_SOURCE);
-            SOKOL_VALIDATE(0 != desc->fs.source, _SG_VALIDATE_SHADERDESC_SOURCE);
-        #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
-            /* on Metal or D3D11, must provide shader source code or byte code */
-            SOKOL_VALIDATE((0 != desc->vs.source)||(0 != desc->vs.byte_code), _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
-            SOKOL_VALIDATE((0 != desc->fs.source)||(0 != desc->fs.byte_code), _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
-        #elif defined(SOKOL_WGPU)
-            /* on WGPU byte code must be provided */
-            SOKOL_VALIDATE((0 != desc->vs.byte_code), _SG_VALIDATE_SHADERDESC_BYTECODE);
-            SOKOL_VALIDATE((0 != desc->fs.byte_code), _SG_VALIDATE_SHADERDESC_BYTECODE);
-        #else
-            /* Dummy Backend, don't require source or bytecode */
-        #endif
-        for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
-            if (desc->attrs[i].name) {
-                SOKOL_VALIDATE(strlen(desc->attrs[i].name) < _SG_STRING_SIZE, _SG_VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG);
-            }
-            if (desc->attrs[i].sem_name) {
-                SOKOL_VALIDATE(strlen(desc->attrs[i].sem_name) < _SG_STRING_SIZE, _SG_VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG);
-            }
-        }
-        /* if shader byte code, the size must also be provided */
-        if (0 != desc->vs.byte_code) {
-            SOKOL_VALIDATE(desc->vs.byte_code_size > 0, _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE);
-        }
-        if (0 != desc->fs.byte_code) {
-            SOKOL_VALIDATE(desc->fs.byte_code_size > 0, _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE);
-        }
-        for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-            const sg_shader_stage_desc* stage_desc = (stage_index == 0)? &desc->vs : &desc->fs;
-            bool uniform_blocks_continuous = true;
-            for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
-                const sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
-                if (ub_desc->size > 0) {
-                    SOKOL_VALIDATE(uniform_blocks_continuous, _SG_VALIDATE_SHADERDESC_NO_CONT_UBS);
-                    bool uniforms_continuous = true;
-                    int uniform_offset = 0;
-                    int num_uniforms = 0;
-                    for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
-                        const sg_shader_uniform_desc* u_desc = &ub_desc->uniforms[u_index];
-                        if (u_desc->type != SG_UNIFORMTYPE_INVALID) {
-                            SOKOL_VALIDATE(uniforms_continuous, _SG_VALIDATE_SHADERDESC_NO_CONT_UB_MEMBERS);
-                            #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
-                            SOKOL_VALIDATE(0 != u_desc->name, _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME);
-                            #endif
-                            const int array_count = u_desc->array_count;
-                            uniform_offset += _sg_uniform_size(u_desc->type, array_count);
-                            num_uniforms++;
-                        }
-                        else {
-                            uniforms_continuous = false;
-                        }
-                    }
-                    #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
-                    SOKOL_VALIDATE(uniform_offset == ub_desc->size, _SG_VALIDATE_SHADERDESC_UB_SIZE_MISMATCH);
-                    SOKOL_VALIDATE(num_uniforms > 0, _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS);
-                    #endif
-                }
-                else {
-                    uniform_blocks_continuous = false;
-                }
-            }
-            bool images_continuous = true;
-            for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
-                const sg_shader_image_desc* img_desc = &stage_desc->images[img_index];
-                if (img_desc->type != _SG_IMAGETYPE_DEFAULT) {
-                    SOKOL_VALIDATE(images_continuous, _SG_VALIDATE_SHADERDESC_NO_CONT_IMGS);
-                    #if defined(SOKOL_GLES2)
-                    SOKOL_VALIDATE(0 != img_desc->name, _SG_VALIDATE_SHADERDESC_IMG_NAME);
-                    #endif
-                }
-                else {
-                    images_continuous = false;
-                }
-            }
-        }
-        return SOKOL_VALIDATE_END();
+    #error("INVALID BACKEND");
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_pipeline_desc(const sg_pipeline_desc* desc) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(desc);
-        return true;
+static inline void _sg_activate_context(_sg_context_t* ctx) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_activate_context(ctx);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_activate_context(ctx);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_activate_context(ctx);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_activate_context(ctx);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_activate_context(ctx);
+    #elif defined(SOKOL_SW)
+    _sg_sw_activate_context(ctx);
     #else
-        SOKOL_ASSERT(desc);
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_PIPELINEDESC_CANARY);
-        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_PIPELINEDESC_CANARY);
-        SOKOL_VALIDATE(desc->shader.id != SG_INVALID_ID, _SG_VALIDATE_PIPELINEDESC_SHADER);
-        for (int buf_index = 0; buf_index < SG_MAX_SHADERSTAGE_BUFFERS; buf_index++) {
-            const sg_buffer_layout_desc* l_desc = &desc->layout.buffers[buf_index];
-            if (l_desc->stride == 0) {
-                continue;
-            }
-            SOKOL_VALIDATE((l_desc->stride & 3) == 0, _SG_VALIDATE_PIPELINEDESC_LAYOUT_STRIDE4);
-        }
-        SOKOL_VALIDATE(desc->layout.attrs[0].format != SG_VERTEXFORMAT_INVALID, _SG_VALIDATE_PIPELINEDESC_NO_ATTRS);
-        const _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
-        SOKOL_VALIDATE(0 != shd, _SG_VALIDATE_PIPELINEDESC_SHADER);
-        if (shd) {
-            SOKOL_VALIDATE(shd->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_PIPELINEDESC_SHADER);
-            bool attrs_cont = true;
-            for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
-                const sg_vertex_attr_desc* a_desc = &desc->layout.attrs[attr_index];
-                if (a_desc->format == SG_VERTEXFORMAT_INVALID) {
-                    attrs_cont = false;
-                    continue;
-                }
-                SOKOL_VALIDATE(attrs_cont, _SG_VALIDATE_PIPELINEDESC_NO_ATTRS);
-                SOKOL_ASSERT(a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS);
-                #if defined(SOKOL_GLES2)
-                /* on GLES2, vertex attribute names must be provided */
-                SOKOL_VALIDATE(!_sg_strempty(&shd->gl.attrs[attr_index].name), _SG_VALIDATE_PIPELINEDESC_ATTR_NAME);
-                #elif defined(SOKOL_D3D11)
-                /* on D3D11, semantic names (and semantic indices) must be provided */
-                SOKOL_VALIDATE(!_sg_strempty(&shd->d3d11.attrs[attr_index].sem_name), _SG_VALIDATE_PIPELINEDESC_ATTR_SEMANTICS);
-                #endif
-            }
-        }
-        return SOKOL_VALIDATE_END();
+    #error("INVALID BACKEND");
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_pass_desc(const sg_pass_desc* desc) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(desc);
-        return true;
+static inline sg_resource_state _sg_create_context(_sg_context_t* ctx) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_create_context(ctx);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_create_context(ctx);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_create_context(ctx);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_create_context(ctx);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_create_context(ctx);
+    #elif defined(SOKOL_SW)
+    return _sg_sw_create_context(ctx);
     #else
-        SOKOL_ASSERT(desc);
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_PASSDESC_CANARY);
-        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_PASSDESC_CANARY);
-        bool atts_cont = true;
-        sg_pixel_format color_fmt = SG_PIXELFORMAT_NONE;
-        int width = -1, height = -1, sample_count = -1;
-        for (int att_index = 0; att_index < SG_MAX_COLOR_ATTACHMENTS; att_index++) {
-            const sg_attachment_desc* att = &desc->color_attachments[att_index];
-            if (att->image.id == SG_INVALID_ID) {
-                SOKOL_VALIDATE(att_index > 0, _SG_VALIDATE_PASSDESC_NO_COLOR_ATTS);
-                atts_cont = false;
-                continue;
-            }
-            SOKOL_VALIDATE(atts_cont, _SG_VALIDATE_PASSDESC_NO_CONT_COLOR_ATTS);
-            const _sg_image_t* img = _sg_lookup_image(&_sg.pools, att->image.id);
-            SOKOL_VALIDATE((0 != img) && (img->slot.state == SG_RESOURCESTATE_VALID), _SG_VALIDATE_PASSDESC_IMAGE);
-            SOKOL_VALIDATE(att->mip_level < img->cmn.num_mipmaps, _SG_VALIDATE_PASSDESC_MIPLEVEL);
-            if (img->cmn.type == SG_IMAGETYPE_CUBE) {
-                SOKOL_VALIDATE(att->slice < 6, _SG_VALIDATE_PASSDESC_FACE);
-            }
-            else if (img->cmn.type == SG_IMAGETYPE_ARRAY) {
-                SOKOL_VALIDATE(att->slice < img->cmn.num_slices, _SG_VALIDATE_PASSDESC_LAYER);
-            }
-            else if (img->cmn.type == SG_IMAGETYPE_3D) {
-                SOKOL_VALIDATE(att->slice < img->cmn.num_slices, _SG_VALIDATE_PASSDESC_SLICE);
-            }
-            SOKOL_VALIDATE(img->cmn.render_target, _SG_VALIDATE_PASSDESC_IMAGE_NO_RT);
-            if (att_index == 0) {
-                color_fmt = img->cmn.pixel_format;
-                width = img->cmn.width >> att->mip_level;
-                height = img->cmn.height >> att->mip_level;
-                sample_count = img->cmn.sample_count;
-            }
-            else {
-                SOKOL_VALIDATE(img->cmn.pixel_format == color_fmt, _SG_VALIDATE_PASSDESC_COLOR_PIXELFORMATS);
-                SOKOL_VALIDATE(width == img->cmn.width >> att->mip_level, _SG_VALIDATE_PASSDESC_IMAGE_SIZES);
-                SOKOL_VALIDATE(height == img->cmn.height >> att->mip_level, _SG_VALIDATE_PASSDESC_IMAGE_SIZES);
-                SOKOL_VALIDATE(sample_count == img->cmn.sample_count, _SG_VALIDATE_PASSDESC_IMAGE_SAMPLE_COUNTS);
-            }
-            SOKOL_VALIDATE(_sg_is_valid_rendertarget_color_format(img->cmn.pixel_format), _SG_VALIDATE_PASSDESC_COLOR_INV_PIXELFORMAT);
-        }
-        if (desc->depth_stencil_attachment.image.id != SG_INVALID_ID) {
-            const sg_attachment_desc* att = &desc->depth_stencil_attachment;
-            const _sg_image_t* img = _sg_lookup_image(&_sg.pools, att->image.id);
-            SOKOL_VALIDATE((0 != img) && (img->slot.state == SG_RESOURCESTATE_VALID), _SG_VALIDATE_PASSDESC_IMAGE);
-            SOKOL_VALIDATE(att->mip_level < img->cmn.num_mipmaps, _SG_VALIDATE_PASSDESC_MIPLEVEL);
-            if (img->cmn.type == SG_IMAGETYPE_CUBE) {
-                SOKOL_VALIDATE(att->slice < 6, _SG_VALIDATE_PASSDESC_FACE);
-            }
-            else if (img->cmn.type == SG_IMAGETYPE_ARRAY) {
-                SOKOL_VALIDATE(att->slice < img->cmn.num_slices, _SG_VALIDATE_PASSDESC_LAYER);
-            }
-            else if (img->cmn.type == SG_IMAGETYPE_3D) {
-                SOKOL_VALIDATE(att->slice < img->cmn.num_slices, _SG_VALIDATE_PASSDESC_SLICE);
-            }
-            SOKOL_VALIDATE(img->cmn.render_target, _SG_VALIDATE_PASSDESC_IMAGE_NO_RT);
-            SOKOL_VALIDATE(width == img->cmn.width >> att->mip_level, _SG_VALIDATE_PASSDESC_IMAGE_SIZES);
-            SOKOL_VALIDATE(height == img->cmn.height >> att->mip_level, _SG_VALIDATE_PASSDESC_IMAGE_SIZES);
-            SOKOL_VALIDATE(sample_count == img->cmn.sample_count, _SG_VALIDATE_PASSDESC_IMAGE_SAMPLE_COUNTS);
-            SOKOL_VALIDATE(_sg_is_valid_rendertarget_depth_format(img->cmn.pixel_format), _SG_VALIDATE_PASSDESC_DEPTH_INV_PIXELFORMAT);
-        }
-        return SOKOL_VALIDATE_END();
+    #error("INVALID BACKEND");
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_begin_pass(_sg_pass_t* pass) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(pass);
-        return true;
+static inline void _sg_destroy_context(_sg_context_t* ctx) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_destroy_context(ctx);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_destroy_context(ctx);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_destroy_context(ctx);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_destroy_context(ctx);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_destroy_context(ctx);
+    #elif defined(SOKOL_SW)
+    _sg_sw_destroy_context(ctx);
     #else
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(pass->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_BEGINPASS_PASS);
+    #error("INVALID BACKEND");
+    #endif
+}
 
-        for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
-            const _sg_attachment_t* att = &pass->cmn.color_atts[i];
-            const _sg_image_t* img = _sg_pass_color_image(pass, i);
-            if (img) {
-                SOKOL_VALIDATE(img->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_BEGINPASS_IMAGE);
-                SOKOL_VALIDATE(img->slot.id == att->image_id.id, _SG_VALIDATE_BEGINPASS_IMAGE);
-            }
-        }
-        const _sg_image_t* ds_img = _sg_pass_ds_image(pass);
-        if (ds_img) {
-            const _sg_attachment_t* att = &pass->cmn.ds_att;
-            SOKOL_VALIDATE(ds_img->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_BEGINPASS_IMAGE);
-            SOKOL_VALIDATE(ds_img->slot.id == att->image_id.id, _SG_VALIDATE_BEGINPASS_IMAGE);
-        }
-        return SOKOL_VALIDATE_END();
+static inline sg_resource_state _sg_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_create_buffer(buf, desc);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_create_buffer(buf, desc);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_create_buffer(buf, desc);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_create_buffer(buf, desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_create_buffer(buf, desc);
+    #elif defined(SOKOL_SW)
+    return _sg_sw_create_buffer(buf, desc);
+    #else
+    #error("INVALID BACKEND");
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_apply_pipeline(sg_pipeline pip_id) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(pip_id);
-        return true;
+static inline void _sg_destroy_buffer(_sg_buffer_t* buf) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_destroy_buffer(buf);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_destroy_buffer(buf);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_destroy_buffer(buf);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_destroy_buffer(buf);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_destroy_buffer(buf);
+    #elif defined(SOKOL_SW)
+    _sg_sw_destroy_buffer(buf);
     #else
-        SOKOL_VALIDATE_BEGIN();
-        /* the pipeline object must be alive and valid */
-        SOKOL_VALIDATE(pip_id.id != SG_INVALID_ID, _SG_VALIDATE_APIP_PIPELINE_VALID_ID);
-        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-        SOKOL_VALIDATE(pip != 0, _SG_VALIDATE_APIP_PIPELINE_EXISTS);
-        if (!pip) {
-            return SOKOL_VALIDATE_END();
-        }
-        SOKOL_VALIDATE(pip->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_APIP_PIPELINE_VALID);
-        /* the pipeline's shader must be alive and valid */
-        SOKOL_ASSERT(pip->shader);
-        SOKOL_VALIDATE(pip->shader->slot.id == pip->cmn.shader_id.id, _SG_VALIDATE_APIP_SHADER_EXISTS);
-        SOKOL_VALIDATE(pip->shader->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_APIP_SHADER_VALID);
-        /* check that pipeline attributes match current pass attributes */
-        const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, _sg.cur_pass.id);
-        if (pass) {
-            /* an offscreen pass */
-            const _sg_image_t* att_img = _sg_pass_color_image(pass, 0);
-            SOKOL_VALIDATE(pip->cmn.color_attachment_count == pass->cmn.num_color_atts, _SG_VALIDATE_APIP_ATT_COUNT);
-            SOKOL_VALIDATE(pip->cmn.color_format == att_img->cmn.pixel_format, _SG_VALIDATE_APIP_COLOR_FORMAT);
-            SOKOL_VALIDATE(pip->cmn.sample_count == att_img->cmn.sample_count, _SG_VALIDATE_APIP_SAMPLE_COUNT);
-            const _sg_image_t* att_dsimg = _sg_pass_ds_image(pass);
-            if (att_dsimg) {
-                SOKOL_VALIDATE(pip->cmn.depth_format == att_dsimg->cmn.pixel_format, _SG_VALIDATE_APIP_DEPTH_FORMAT);
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline sg_resource_state _sg_create_image(_sg_image_t* img, const sg_image_desc* desc) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_create_image(img, desc);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_create_image(img, desc);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_create_image(img, desc);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_create_image(img, desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_create_image(img, desc);
+    #elif defined(SOKOL_SW)
+    return _sg_sw_create_image(img, desc);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_destroy_image(_sg_image_t* img) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_destroy_image(img);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_destroy_image(img);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_destroy_image(img);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_destroy_image(img);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_destroy_image(img);
+    #elif defined(SOKOL_SW)
+    _sg_sw_destroy_image(img);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline sg_resource_state _sg_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_create_shader(shd, desc);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_create_shader(shd, desc);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_create_shader(shd, desc);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_create_shader(shd, desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_create_shader(shd, desc);
+    #elif defined(SOKOL_SW)
+    return _sg_sw_create_shader(shd, desc);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_destroy_shader(_sg_shader_t* shd) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_destroy_shader(shd);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_destroy_shader(shd);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_destroy_shader(shd);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_destroy_shader(shd);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_destroy_shader(shd);
+    #elif defined(SOKOL_SW)
+    _sg_sw_destroy_shader(shd);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline sg_resource_state _sg_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_create_pipeline(pip, shd, desc);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_create_pipeline(pip, shd, desc);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_create_pipeline(pip, shd, desc);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_create_pipeline(pip, shd, desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_create_pipeline(pip, shd, desc);
+    #elif defined(SOKOL_SW)
+    return _sg_sw_create_pipeline(pip, shd, desc);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_destroy_pipeline(_sg_pipeline_t* pip) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_destroy_pipeline(pip);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_destroy_pipeline(pip);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_destroy_pipeline(pip);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_destroy_pipeline(pip);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_destroy_pipeline(pip);
+    #elif defined(SOKOL_SW)
+    _sg_sw_destroy_pipeline(pip);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline sg_resource_state _sg_create_pass(_sg_pass_t* pass, _sg_image_t** att_images, const sg_pass_desc* desc) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_create_pass(pass, att_images, desc);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_create_pass(pass, att_images, desc);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_create_pass(pass, att_images, desc);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_create_pass(pass, att_images, desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_create_pass(pass, att_images, desc);
+    #elif defined(SOKOL_SW)
+    return _sg_sw_create_pass(pass, att_images, desc);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_destroy_pass(_sg_pass_t* pass) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_destroy_pass(pass);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_destroy_pass(pass);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_destroy_pass(pass);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_destroy_pass(pass);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_destroy_pass(pass);
+    #elif defined(SOKOL_SW)
+    _sg_sw_destroy_pass(pass);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline _sg_image_t* _sg_pass_color_image(const _sg_pass_t* pass, int index) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_pass_color_image(pass, index);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_pass_color_image(pass, index);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_pass_color_image(pass, index);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_pass_color_image(pass, index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_pass_color_image(pass, index);
+    #elif defined(SOKOL_SW)
+    return _sg_sw_pass_color_image(pass, index);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline _sg_image_t* _sg_pass_ds_image(const _sg_pass_t* pass) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_pass_ds_image(pass);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_pass_ds_image(pass);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_pass_ds_image(pass);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_pass_ds_image(pass);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_pass_ds_image(pass);
+    #elif defined(SOKOL_SW)
+    return _sg_sw_pass_ds_image(pass);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_begin_pass(pass, action, w, h);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_begin_pass(pass, action, w, h);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_begin_pass(pass, action, w, h);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_begin_pass(pass, action, w, h);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_begin_pass(pass, action, w, h);
+    #elif defined(SOKOL_SW)
+    _sg_sw_begin_pass(pass, action, w, h);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_end_pass(void) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_end_pass();
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_end_pass();
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_end_pass();
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_end_pass();
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_end_pass();
+    #elif defined(SOKOL_SW)
+    _sg_sw_end_pass();
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_apply_viewport(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_apply_viewport(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_apply_viewport(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_apply_viewport(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_apply_viewport(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_SW)
+    _sg_sw_apply_viewport(x, y, w, h, origin_top_left);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_apply_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_apply_scissor_rect(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_apply_scissor_rect(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_apply_scissor_rect(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_apply_scissor_rect(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_apply_scissor_rect(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_SW)
+    _sg_sw_apply_scissor_rect(x, y, w, h, origin_top_left);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_apply_pipeline(_sg_pipeline_t* pip) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_apply_pipeline(pip);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_apply_pipeline(pip);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_apply_pipeline(pip);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_apply_pipeline(pip);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_apply_pipeline(pip);
+    #elif defined(SOKOL_SW)
+    _sg_sw_apply_pipeline(pip);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_apply_bindings(
+    _sg_pipeline_t* pip,
+    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
+    _sg_buffer_t* ib, int ib_offset,
+    _sg_image_t** vs_imgs, int num_vs_imgs,
+    _sg_image_t** fs_imgs, int num_fs_imgs)
+{
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    #elif defined(SOKOL_SW)
+    _sg_sw_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_apply_uniforms(stage_index, ub_index, data, num_bytes);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_apply_uniforms(stage_index, ub_index, data, num_bytes);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_apply_uniforms(stage_index, ub_index, data, num_bytes);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_apply_uniforms(stage_index, ub_index, data, num_bytes);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_apply_uniforms(stage_index, ub_index, data, num_bytes);
+    #elif defined(SOKOL_SW)
+    _sg_sw_apply_uniforms(stage_index, ub_index, data, num_bytes);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_draw(int base_element, int num_elements, int num_instances) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_draw(base_element, num_elements, num_instances);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_draw(base_element, num_elements, num_instances);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_draw(base_element, num_elements, num_instances);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_draw(base_element, num_elements, num_instances);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_draw(base_element, num_elements, num_instances);
+    #elif defined(SOKOL_SW)
+    _sg_sw_draw(base_element, num_elements, num_instances);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_commit(void) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_commit();
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_commit();
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_commit();
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_commit();
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_commit();
+    #elif defined(SOKOL_SW)
+    _sg_sw_commit();
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_update_buffer(_sg_buffer_t* buf, const void* data_ptr, uint32_t data_size) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_update_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_update_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_update_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_update_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_update_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_SW)
+    _sg_sw_update_buffer(buf, data_ptr, data_size);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline uint32_t _sg_append_buffer(_sg_buffer_t* buf, const void* data_ptr, uint32_t data_size, bool new_frame) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_append_buffer(buf, data_ptr, data_size, new_frame);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_append_buffer(buf, data_ptr, data_size, new_frame);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_append_buffer(buf, data_ptr, data_size, new_frame);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_append_buffer(buf, data_ptr, data_size, new_frame);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_append_buffer(buf, data_ptr, data_size, new_frame);
+    #elif defined(SOKOL_SW)
+    return _sg_sw_append_buffer(buf, data_ptr, data_size, new_frame);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_update_image(_sg_image_t* img, const sg_image_content* data) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_update_image(img, data);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_update_image(img, data);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_update_image(img, data);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_update_image(img, data);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_update_image(img, data);
+    #elif defined(SOKOL_SW)
+    _sg_sw_update_image(img, data);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+/*== RESOURCE MEMORY ACCOUNTING ==============================================*/
+_SOKOL_PRIVATE uint64_t _sg_buffer_mem_size(const _sg_buffer_t* buf) {
+    return (uint64_t)buf->cmn.size * (uint64_t)buf->cmn.num_slots;
+}
+
+_SOKOL_PRIVATE uint64_t _sg_image_mem_size(const _sg_image_t* img) {
+    const _sg_image_common_t* cmn = &img->cmn;
+    const int num_faces = (cmn->type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+    uint64_t size = 0;
+    for (int mip_index = 0; mip_index < cmn->num_mipmaps; mip_index++) {
+        const int mip_width = _sg_max(cmn->width >> mip_index, 1);
+        const int mip_height = _sg_max(cmn->height >> mip_index, 1);
+        int mip_slices = 1;
+        if (SG_IMAGETYPE_3D == cmn->type) {
+            mip_slices = _sg_max(cmn->num_slices >> mip_index, 1);
+        }
+        else if (SG_IMAGETYPE_ARRAY == cmn->type) {
+            mip_slices = cmn->num_slices;
+        }
+        size += (uint64_t)_sg_surface_pitch(cmn->pixel_format, mip_width, mip_height, 1) * (uint64_t)mip_slices;
+    }
+    size *= (uint64_t)num_faces;
+    if (cmn->render_target && (cmn->sample_count > 1)) {
+        /* the separate MSAA surface which is resolved into the texture */
+        const uint64_t msaa_size = (uint64_t)_sg_surface_pitch(cmn->pixel_format, cmn->width, cmn->height, 1) * (uint64_t)cmn->sample_count;
+        size += msaa_size * (uint64_t)num_faces;
+    }
+    return size * (uint64_t)cmn->num_slots;
+}
+
+_SOKOL_PRIVATE void _sg_mem_add_buffer(const _sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf && (buf->slot.state == SG_RESOURCESTATE_VALID));
+    const uint64_t size = _sg_buffer_mem_size(buf);
+    _sg.mem.info.total_bytes += size;
+    _sg.mem.info.buffer_bytes += size;
+    _sg.mem.info.usage_bytes[buf->cmn.usage] += size;
+    _sg.mem.info.num_buffers++;
+}
+
+_SOKOL_PRIVATE void _sg_mem_remove_buffer(const _sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf && (buf->slot.state == SG_RESOURCESTATE_VALID));
+    const uint64_t size = _sg_buffer_mem_size(buf);
+    SOKOL_ASSERT((_sg.mem.info.buffer_bytes >= size) && (_sg.mem.info.num_buffers > 0));
+    _sg.mem.info.total_bytes -= size;
+    _sg.mem.info.buffer_bytes -= size;
+    _sg.mem.info.usage_bytes[buf->cmn.usage] -= size;
+    _sg.mem.info.num_buffers--;
+}
+
+_SOKOL_PRIVATE void _sg_mem_add_image(const _sg_image_t* img) {
+    SOKOL_ASSERT(img && (img->slot.state == SG_RESOURCESTATE_VALID));
+    const uint64_t size = _sg_image_mem_size(img);
+    _sg.mem.info.total_bytes += size;
+    _sg.mem.info.image_bytes += size;
+    if (img->cmn.render_target) {
+        _sg.mem.info.render_target_bytes += size;
+    }
+    _sg.mem.info.usage_bytes[img->cmn.usage] += size;
+    _sg.mem.info.pixelformat_bytes[img->cmn.pixel_format] += size;
+    _sg.mem.info.num_images++;
+}
+
+_SOKOL_PRIVATE void _sg_mem_remove_image(const _sg_image_t* img) {
+    SOKOL_ASSERT(img && (img->slot.state == SG_RESOURCESTATE_VALID));
+    const uint64_t size = _sg_image_mem_size(img);
+    SOKOL_ASSERT((_sg.mem.info.image_bytes >= size) && (_sg.mem.info.num_images > 0));
+    _sg.mem.info.total_bytes -= size;
+    _sg.mem.info.image_bytes -= size;
+    if (img->cmn.render_target) {
+        _sg.mem.info.render_target_bytes -= size;
+    }
+    _sg.mem.info.usage_bytes[img->cmn.usage] -= size;
+    _sg.mem.info.pixelformat_bytes[img->cmn.pixel_format] -= size;
+    _sg.mem.info.num_images--;
+}
+
+_SOKOL_PRIVATE void _sg_mem_check_budget(void) {
+    if ((_sg.mem.budget.num_bytes > 0) && (_sg.mem.info.total_bytes > _sg.mem.budget.num_bytes)) {
+        /* the callback gets a copy, since it may destroy resources */
+        const sg_memory_info info = _sg.mem.info;
+        if (_sg.mem.budget.exceeded_cb) {
+            _sg.mem.budget.exceeded_cb(&info);
+        }
+        else if (_sg.mem.budget.exceeded_userdata_cb) {
+            _sg.mem.budget.exceeded_userdata_cb(&info, _sg.mem.budget.user_data);
+        }
+    }
+}
+
+/*== RESOURCE POOLS ==========================================================*/
+
+_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num) {
+    SOKOL_ASSERT(pool && (num >= 1));
+    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
+    pool->size = num + 1;
+    pool->queue_top = 0;
+    /* generation counters indexable by pool slot index, slot 0 is reserved */
+    size_t gen_ctrs_size = sizeof(uint32_t) * pool->size;
+    pool->gen_ctrs = (uint32_t*) SOKOL_MALLOC(gen_ctrs_size);
+    SOKOL_ASSERT(pool->gen_ctrs);
+    memset(pool->gen_ctrs, 0, gen_ctrs_size);
+    /* it's not a bug to only reserve 'num' here */
+    pool->free_queue = (int*) SOKOL_MALLOC(sizeof(int)*num);
+    SOKOL_ASSERT(pool->free_queue);
+    /* never allocate the zero-th pool item since the invalid id is 0 */
+    for (int i = pool->size-1; i >= 1; i--) {
+        pool->free_queue[pool->queue_top++] = i;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool);
+    SOKOL_ASSERT(pool->free_queue);
+    SOKOL_FREE(pool->free_queue);
+    pool->free_queue = 0;
+    SOKOL_ASSERT(pool->gen_ctrs);
+    SOKOL_FREE(pool->gen_ctrs);
+    pool->gen_ctrs = 0;
+    pool->size = 0;
+    pool->queue_top = 0;
+}
+
+_SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool);
+    SOKOL_ASSERT(pool->free_queue);
+    if (pool->queue_top > 0) {
+        int slot_index = pool->free_queue[--pool->queue_top];
+        SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
+        return slot_index;
+    }
+    else {
+        /* pool exhausted */
+        return _SG_INVALID_SLOT_INDEX;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
+    SOKOL_ASSERT(pool);
+    SOKOL_ASSERT(pool->free_queue);
+    SOKOL_ASSERT(pool->queue_top < pool->size);
+    #ifdef SOKOL_DEBUG
+    /* debug check against double-free */
+    for (int i = 0; i < pool->queue_top; i++) {
+        SOKOL_ASSERT(pool->free_queue[i] != slot_index);
+    }
+    #endif
+    pool->free_queue[pool->queue_top++] = slot_index;
+    SOKOL_ASSERT(pool->queue_top <= (pool->size-1));
+}
+
+_SOKOL_PRIVATE void _sg_reset_slot(_sg_slot_t* slot) {
+    SOKOL_ASSERT(slot);
+    memset(slot, 0, sizeof(_sg_slot_t));
+}
+
+_SOKOL_PRIVATE void _sg_reset_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    _sg_slot_t slot = buf->slot;
+    memset(buf, 0, sizeof(_sg_buffer_t));
+    buf->slot = slot;
+    buf->slot.state = SG_RESOURCESTATE_ALLOC;
+}
+
+_SOKOL_PRIVATE void _sg_reset_image(_sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    _sg_slot_t slot = img->slot;
+    memset(img, 0, sizeof(_sg_image_t));
+    img->slot = slot;
+    img->slot.state = SG_RESOURCESTATE_ALLOC;
+}
+
+_SOKOL_PRIVATE void _sg_reset_shader(_sg_shader_t* shd) {
+    SOKOL_ASSERT(shd);
+    _sg_slot_t slot = shd->slot;
+    memset(shd, 0, sizeof(_sg_shader_t));
+    shd->slot = slot;
+    shd->slot.state = SG_RESOURCESTATE_ALLOC;
+}
+
+_SOKOL_PRIVATE void _sg_reset_pipeline(_sg_pipeline_t* pip) {
+    SOKOL_ASSERT(pip);
+    _sg_slot_t slot = pip->slot;
+    memset(pip, 0, sizeof(_sg_pipeline_t));
+    pip->slot = slot;
+    pip->slot.state = SG_RESOURCESTATE_ALLOC;
+}
+
+_SOKOL_PRIVATE void _sg_reset_pass(_sg_pass_t* pass) {
+    SOKOL_ASSERT(pass);
+    _sg_slot_t slot = pass->slot;
+    memset(pass, 0, sizeof(_sg_pass_t));
+    pass->slot = slot;
+    pass->slot.state = SG_RESOURCESTATE_ALLOC;
+}
+
+_SOKOL_PRIVATE void _sg_reset_context(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    _sg_slot_t slot = ctx->slot;
+    memset(ctx, 0, sizeof(_sg_context_t));
+    ctx->slot = slot;
+    ctx->slot.state = SG_RESOURCESTATE_ALLOC;
+}
+
+_SOKOL_PRIVATE void _sg_setup_pools(_sg_pools_t* p, const sg_desc* desc) {
+    SOKOL_ASSERT(p);
+    SOKOL_ASSERT(desc);
+    /* note: the pools here will have an additional item, since slot 0 is reserved */
+    SOKOL_ASSERT((desc->buffer_pool_size > 0) && (desc->buffer_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size);
+    size_t buffer_pool_byte_size = sizeof(_sg_buffer_t) * p->buffer_pool.size;
+    p->buffers = (_sg_buffer_t*) SOKOL_MALLOC(buffer_pool_byte_size);
+    SOKOL_ASSERT(p->buffers);
+    memset(p->buffers, 0, buffer_pool_byte_size);
+
+    SOKOL_ASSERT((desc->image_pool_size > 0) && (desc->image_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->image_pool, desc->image_pool_size);
+    size_t image_pool_byte_size = sizeof(_sg_image_t) * p->image_pool.size;
+    p->images = (_sg_image_t*) SOKOL_MALLOC(image_pool_byte_size);
+    SOKOL_ASSERT(p->images);
+    memset(p->images, 0, image_pool_byte_size);
+
+    SOKOL_ASSERT((desc->shader_pool_size > 0) && (desc->shader_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->shader_pool, desc->shader_pool_size);
+    size_t shader_pool_byte_size = sizeof(_sg_shader_t) * p->shader_pool.size;
+    p->shaders = (_sg_shader_t*) SOKOL_MALLOC(shader_pool_byte_size);
+    SOKOL_ASSERT(p->shaders);
+    memset(p->shaders, 0, shader_pool_byte_size);
+
+    SOKOL_ASSERT((desc->pipeline_pool_size > 0) && (desc->pipeline_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size);
+    size_t pipeline_pool_byte_size = sizeof(_sg_pipeline_t) * p->pipeline_pool.size;
+    p->pipelines = (_sg_pipeline_t*) SOKOL_MALLOC(pipeline_pool_byte_size);
+    SOKOL_ASSERT(p->pipelines);
+    memset(p->pipelines, 0, pipeline_pool_byte_size);
+
+    SOKOL_ASSERT((desc->pass_pool_size > 0) && (desc->pass_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->pass_pool, desc->pass_pool_size);
+    size_t pass_pool_byte_size = sizeof(_sg_pass_t) * p->pass_pool.size;
+    p->passes = (_sg_pass_t*) SOKOL_MALLOC(pass_pool_byte_size);
+    SOKOL_ASSERT(p->passes);
+    memset(p->passes, 0, pass_pool_byte_size);
+
+    SOKOL_ASSERT((desc->context_pool_size > 0) && (desc->context_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->context_pool, desc->context_pool_size);
+    size_t context_pool_byte_size = sizeof(_sg_context_t) * p->context_pool.size;
+    p->contexts = (_sg_context_t*) SOKOL_MALLOC(context_pool_byte_size);
+    SOKOL_ASSERT(p->contexts);
+    memset(p->contexts, 0, context_pool_byte_size);
+    size_t ctx_live_byte_size = sizeof(_sg_live_list_t) * p->context_pool.size;
+    p->ctx_live = (_sg_live_list_t*) SOKOL_MALLOC(ctx_live_byte_size);
+    SOKOL_ASSERT(p->ctx_live);
+    memset(p->ctx_live, 0, ctx_live_byte_size);
+
+    SOKOL_ASSERT((desc->group_pool_size > 0) && (desc->group_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->group_pool, desc->group_pool_size);
+    size_t group_pool_byte_size = sizeof(_sg_group_t) * p->group_pool.size;
+    p->groups = (_sg_group_t*) SOKOL_MALLOC(group_pool_byte_size);
+    SOKOL_ASSERT(p->groups);
+    memset(p->groups, 0, group_pool_byte_size);
+}
+
+_SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
+    SOKOL_ASSERT(p);
+    SOKOL_FREE(p->groups);      p->groups = 0;
+    SOKOL_FREE(p->ctx_live);    p->ctx_live = 0;
+    SOKOL_FREE(p->contexts);    p->contexts = 0;
+    SOKOL_FREE(p->passes);      p->passes = 0;
+    SOKOL_FREE(p->pipelines);   p->pipelines = 0;
+    SOKOL_FREE(p->shaders);     p->shaders = 0;
+    SOKOL_FREE(p->images);      p->images = 0;
+    SOKOL_FREE(p->buffers);     p->buffers = 0;
+    _sg_discard_pool(&p->group_pool);
+    _sg_discard_pool(&p->context_pool);
+    _sg_discard_pool(&p->pass_pool);
+    _sg_discard_pool(&p->pipeline_pool);
+    _sg_discard_pool(&p->shader_pool);
+    _sg_discard_pool(&p->image_pool);
+    _sg_discard_pool(&p->buffer_pool);
+}
+
+/* allocate the slot at slot_index:
+    - bump the slot's generation counter
+    - create a resource id from the generation counter and slot index
+    - set the slot's id to this id
+    - set the slot's state to ALLOC
+    - return the resource id
+*/
+_SOKOL_PRIVATE uint32_t _sg_slot_alloc(_sg_pool_t* pool, _sg_slot_t* slot, int slot_index) {
+    /* FIXME: add handling for an overflowing generation counter,
+       for now, just overflow (another option is to disable
+       the slot)
+    */
+    SOKOL_ASSERT(pool && pool->gen_ctrs);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
+    SOKOL_ASSERT((slot->state == SG_RESOURCESTATE_INITIAL) && (slot->id == SG_INVALID_ID));
+    uint32_t ctr = ++pool->gen_ctrs[slot_index];
+    slot->id = (ctr<<_SG_SLOT_SHIFT)|(slot_index & _SG_SLOT_MASK);
+    slot->state = SG_RESOURCESTATE_ALLOC;
+    return slot->id;
+}
+
+/* extract slot index from id */
+_SOKOL_PRIVATE int _sg_slot_index(uint32_t id) {
+    int slot_index = (int) (id & _SG_SLOT_MASK);
+    SOKOL_ASSERT(_SG_INVALID_SLOT_INDEX != slot_index);
+    return slot_index;
+}
+
+/* returns pointer to resource by id without matching id check */
+_SOKOL_PRIVATE _sg_buffer_t* _sg_buffer_at(const _sg_pools_t* p, uint32_t buf_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != buf_id));
+    int slot_index = _sg_slot_index(buf_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
+    return &p->buffers[slot_index];
+}
+
+_SOKOL_PRIVATE _sg_image_t* _sg_image_at(const _sg_pools_t* p, uint32_t img_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != img_id));
+    int slot_index = _sg_slot_index(img_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
+    return &p->images[slot_index];
+}
+
+_SOKOL_PRIVATE _sg_shader_t* _sg_shader_at(const _sg_pools_t* p, uint32_t shd_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != shd_id));
+    int slot_index = _sg_slot_index(shd_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->shader_pool.size));
+    return &p->shaders[slot_index];
+}
+
+_SOKOL_PRIVATE _sg_pipeline_t* _sg_pipeline_at(const _sg_pools_t* p, uint32_t pip_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != pip_id));
+    int slot_index = _sg_slot_index(pip_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pipeline_pool.size));
+    return &p->pipelines[slot_index];
+}
+
+_SOKOL_PRIVATE _sg_pass_t* _sg_pass_at(const _sg_pools_t* p, uint32_t pass_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != pass_id));
+    int slot_index = _sg_slot_index(pass_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pass_pool.size));
+    return &p->passes[slot_index];
+}
+
+_SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t context_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != context_id));
+    int slot_index = _sg_slot_index(context_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->context_pool.size));
+    return &p->contexts[slot_index];
+}
+
+/* returns pointer to resource with matching id check, may return 0 */
+_SOKOL_PRIVATE _sg_buffer_t* _sg_lookup_buffer(const _sg_pools_t* p, uint32_t buf_id) {
+    if (SG_INVALID_ID != buf_id) {
+        _sg_buffer_t* buf = _sg_buffer_at(p, buf_id);
+        if ((buf->slot.id == buf_id) && !buf->slot.retired) {
+            return buf;
+        }
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE _sg_image_t* _sg_lookup_image(const _sg_pools_t* p, uint32_t img_id) {
+    if (SG_INVALID_ID != img_id) {
+        _sg_image_t* img = _sg_image_at(p, img_id);
+        if ((img->slot.id == img_id) && !img->slot.retired) {
+            return img;
+        }
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE _sg_shader_t* _sg_lookup_shader(const _sg_pools_t* p, uint32_t shd_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != shd_id) {
+        _sg_shader_t* shd = _sg_shader_at(p, shd_id);
+        if ((shd->slot.id == shd_id) && !shd->slot.retired) {
+            return shd;
+        }
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE _sg_pipeline_t* _sg_lookup_pipeline(const _sg_pools_t* p, uint32_t pip_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != pip_id) {
+        _sg_pipeline_t* pip = _sg_pipeline_at(p, pip_id);
+        if ((pip->slot.id == pip_id) && !pip->slot.retired) {
+            return pip;
+        }
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE _sg_pass_t* _sg_lookup_pass(const _sg_pools_t* p, uint32_t pass_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != pass_id) {
+        _sg_pass_t* pass = _sg_pass_at(p, pass_id);
+        if ((pass->slot.id == pass_id) && !pass->slot.retired) {
+            return pass;
+        }
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE _sg_context_t* _sg_lookup_context(const _sg_pools_t* p, uint32_t ctx_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != ctx_id) {
+        _sg_context_t* ctx = _sg_context_at(p, ctx_id);
+        if (ctx->slot.id == ctx_id) {
+            return ctx;
+        }
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE _sg_group_t* _sg_lookup_group(const _sg_pools_t* p, uint32_t group_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != group_id) {
+        int slot_index = _sg_slot_index(group_id);
+        SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->group_pool.size));
+        _sg_group_t* grp = &p->groups[slot_index];
+        if (grp->slot.id == group_id) {
+            return grp;
+        }
+    }
+    return 0;
+}
+
+/*-- live resource lists -------------------------------------------------------
+    Each context and each resource group has an intrusive doubly-linked
+    list per resource type with its initialized (VALID or FAILED) resources,
+    so that destroying all resources of a context or group only touches
+    those resources instead of scanning all pool slots.
+*/
+_SOKOL_PRIVATE _sg_slot_t* _sg_live_slot(const _sg_pools_t* p, _sg_live_type_t type, int slot_index) {
+    switch (type) {
+        case _SG_LIVETYPE_BUFFER:   return &p->buffers[slot_index].slot;
+        case _SG_LIVETYPE_IMAGE:    return &p->images[slot_index].slot;
+        case _SG_LIVETYPE_SHADER:   return &p->shaders[slot_index].slot;
+        case _SG_LIVETYPE_PIPELINE: return &p->pipelines[slot_index].slot;
+        case _SG_LIVETYPE_PASS:     return &p->passes[slot_index].slot;
+        default: SOKOL_UNREACHABLE; return 0;
+    }
+}
+
+_SOKOL_PRIVATE _sg_live_link_t* _sg_live_link(const _sg_pools_t* p, _sg_live_type_t type, int slot_index, bool group) {
+    _sg_slot_t* slot = _sg_live_slot(p, type, slot_index);
+    return group ? &slot->group_link : &slot->ctx_link;
+}
+
+/* a context's live list, resources which were created without a live context
+   (no context or a stale context id) share the list at index 0, a stale id must
+   not select the list of another context which has reused the slot
+*/
+_SOKOL_PRIVATE _sg_live_list_t* _sg_live_ctx_list(const _sg_pools_t* p, uint32_t ctx_id) {
+    return &p->ctx_live[_sg_lookup_context(p, ctx_id) ? _sg_slot_index(ctx_id) : 0];
+}
+
+_SOKOL_PRIVATE void _sg_live_insert(const _sg_pools_t* p, _sg_live_list_t* list, _sg_live_type_t type, int slot_index, bool group) {
+    _sg_live_link_t* link = _sg_live_link(p, type, slot_index, group);
+    link->prev = _SG_INVALID_SLOT_INDEX;
+    link->next = list->first[type];
+    if (list->first[type] != _SG_INVALID_SLOT_INDEX) {
+        _sg_live_link(p, type, list->first[type], group)->prev = slot_index;
+    }
+    list->first[type] = slot_index;
+    list->count[type]++;
+}
+
+_SOKOL_PRIVATE void _sg_live_remove(const _sg_pools_t* p, _sg_live_list_t* list, _sg_live_type_t type, int slot_index, bool group) {
+    _sg_live_link_t* link = _sg_live_link(p, type, slot_index, group);
+    if (link->prev != _SG_INVALID_SLOT_INDEX) {
+        _sg_live_link(p, type, link->prev, group)->next = link->next;
+    }
+    else {
+        SOKOL_ASSERT(list->first[type] == slot_index);
+        list->first[type] = link->next;
+    }
+    if (link->next != _SG_INVALID_SLOT_INDEX) {
+        _sg_live_link(p, type, link->next, group)->prev = link->prev;
+    }
+    link->prev = link->next = _SG_INVALID_SLOT_INDEX;
+    SOKOL_ASSERT(list->count[type] > 0);
+    list->count[type]--;
+}
+
+/* called when an allocated resource is initialized (or set to failed) */
+_SOKOL_PRIVATE void _sg_live_add(const _sg_pools_t* p, _sg_live_type_t type, _sg_slot_t* slot, uint32_t ctx_id, uint32_t group_id) {
+    const int slot_index = _sg_slot_index(slot->id);
+    slot->ctx_id = ctx_id;
+    _sg_live_insert(p, _sg_live_ctx_list(p, ctx_id), type, slot_index, false);
+    _sg_group_t* grp = _sg_lookup_group(p, group_id);
+    if (grp) {
+        slot->group_id = group_id;
+        _sg_live_insert(p, &grp->live, type, slot_index, true);
+    }
+    else {
+        slot->group_id = SG_INVALID_ID;
+    }
+}
+
+/* called when an initialized resource is destroyed */
+_SOKOL_PRIVATE void _sg_live_del(const _sg_pools_t* p, _sg_live_type_t type, _sg_slot_t* slot) {
+    SOKOL_ASSERT((slot->state == SG_RESOURCESTATE_VALID) || (slot->state == SG_RESOURCESTATE_FAILED));
+    const int slot_index = _sg_slot_index(slot->id);
+    _sg_live_remove(p, _sg_live_ctx_list(p, slot->ctx_id), type, slot_index, false);
+    _sg_group_t* grp = _sg_lookup_group(p, slot->group_id);
+    if (grp) {
+        _sg_live_remove(p, &grp->live, type, slot_index, true);
+    }
+    slot->group_id = SG_INVALID_ID;
+}
+
+/* destroy an initialized resource without checking the active context and free its slot */
+_SOKOL_PRIVATE void _sg_destroy_live_resource(_sg_pools_t* p, _sg_live_type_t type, int slot_index) {
+    _sg_slot_t* slot = _sg_live_slot(p, type, slot_index);
+    _sg_live_del(p, type, slot);
+    const bool valid = (slot->state == SG_RESOURCESTATE_VALID);
+    switch (type) {
+        case _SG_LIVETYPE_BUFFER:
+            if (valid) {
+                _sg_mem_remove_buffer(&p->buffers[slot_index]);
+            }
+            _sg_destroy_buffer(&p->buffers[slot_index]);
+            _sg_reset_buffer(&p->buffers[slot_index]);
+            _sg_pool_free_index(&p->buffer_pool, slot_index);
+            break;
+        case _SG_LIVETYPE_IMAGE:
+            if (valid) {
+                _sg_mem_remove_image(&p->images[slot_index]);
+            }
+            _sg_destroy_image(&p->images[slot_index]);
+            _sg_reset_image(&p->images[slot_index]);
+            _sg_pool_free_index(&p->image_pool, slot_index);
+            break;
+        case _SG_LIVETYPE_SHADER:
+            _sg_destroy_shader(&p->shaders[slot_index]);
+            _sg_reset_shader(&p->shaders[slot_index]);
+            _sg_pool_free_index(&p->shader_pool, slot_index);
+            break;
+        case _SG_LIVETYPE_PIPELINE:
+            _sg_destroy_pipeline(&p->pipelines[slot_index]);
+            _sg_reset_pipeline(&p->pipelines[slot_index]);
+            _sg_pool_free_index(&p->pipeline_pool, slot_index);
+            break;
+        case _SG_LIVETYPE_PASS:
+            _sg_destroy_pass(&p->passes[slot_index]);
+            _sg_reset_pass(&p->passes[slot_index]);
+            _sg_pool_free_index(&p->pass_pool, slot_index);
+            break;
+        default:
+            SOKOL_UNREACHABLE;
+            break;
+    }
+    _sg_reset_slot(slot);
+}
+
+/* destroy all resources of a context, passes first since they reference images */
+_SOKOL_PRIVATE void _sg_destroy_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
+    SOKOL_ASSERT(_sg_lookup_context(p, ctx_id));
+    _sg_live_list_t* list = _sg_live_ctx_list(p, ctx_id);
+    for (int i = _SG_LIVETYPE_NUM - 1; i >= 0; i--) {
+        const _sg_live_type_t type = (_sg_live_type_t)i;
+        while (list->first[type] != _SG_INVALID_SLOT_INDEX) {
+            _sg_destroy_live_resource(p, type, list->first[type]);
+        }
+    }
+}
+
+/*== VALIDATION LAYER ========================================================*/
+#if defined(SOKOL_DEBUG)
+/* return a human readable string for an _sg_validate_error */
+_SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
+    switch (err) {
+        /* buffer creation validation errors */
+        case _SG_VALIDATE_BUFFERDESC_CANARY:        return "sg_buffer_desc not initialized";
+        case _SG_VALIDATE_BUFFERDESC_SIZE:          return "sg_buffer_desc.size cannot be 0";
+        case _SG_VALIDATE_BUFFERDESC_CONTENT:       return "immutable buffers must be initialized with content (sg_buffer_desc.content)";
+        case _SG_VALIDATE_BUFFERDESC_NO_CONTENT:    return "dynamic/stream usage buffers cannot be initialized with content";
+
+        /* image creation validation errros */
+        case _SG_VALIDATE_IMAGEDESC_CANARY:             return "sg_image_desc not initialized";
+        case _SG_VALIDATE_IMAGEDESC_WIDTH:              return "sg_image_desc.width must be > 0";
+        case _SG_VALIDATE_IMAGEDESC_HEIGHT:             return "sg_image_desc.height must be > 0";
+        case _SG_VALIDATE_IMAGEDESC_RT_PIXELFORMAT:     return "invalid pixel format for render-target image";
+        case _SG_VALIDATE_IMAGEDESC_NONRT_PIXELFORMAT:  return "invalid pixel format for non-render-target image";
+        case _SG_VALIDATE_IMAGEDESC_MSAA_BUT_NO_RT:     return "non-render-target images cannot be multisampled";
+        case _SG_VALIDATE_IMAGEDESC_NO_MSAA_RT_SUPPORT: return "MSAA not supported for this pixel format";
+        case _SG_VALIDATE_IMAGEDESC_RT_IMMUTABLE:       return "render target images must be SG_USAGE_IMMUTABLE";
+        case _SG_VALIDATE_IMAGEDESC_RT_NO_CONTENT:      return "render target images cannot be initialized with content";
+        case _SG_VALIDATE_IMAGEDESC_CONTENT:            return "missing or invalid content for immutable image";
+        case _SG_VALIDATE_IMAGEDESC_NO_CONTENT:         return "dynamic/stream usage images cannot be initialized with content";
+
+        /* shader creation */
+        case _SG_VALIDATE_SHADERDESC_CANARY:                return "sg_shader_desc not initialized";
+        case _SG_VALIDATE_SHADERDESC_SOURCE:                return "shader source code required";
+        case _SG_VALIDATE_SHADERDESC_BYTECODE:              return "shader byte code required";
+        case _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE:    return "shader source or byte code required";
+        case _SG_VALIDATE_SHADERDESC_SW_FUNCS:              return "shader function pointers required (SOKOL_SW)";
+        case _SG_VALIDATE_SHADERDESC_SW_VARYINGS:           return "too many shader varyings (SOKOL_SW)";
+        case _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE:      return "shader byte code length (in bytes) required";
+        case _SG_VALIDATE_SHADERDESC_NO_CONT_UBS:           return "shader uniform blocks must occupy continuous slots";
+        case _SG_VALIDATE_SHADERDESC_NO_CONT_UB_MEMBERS:    return "uniform block members must occupy continuous slots";
+        case _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS:         return "GL backend requires uniform block member declarations";
+        case _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME:        return "uniform block member name missing";
+        case _SG_VALIDATE_SHADERDESC_UB_SIZE_MISMATCH:      return "size of uniform block members doesn't match uniform block size";
+        case _SG_VALIDATE_SHADERDESC_NO_CONT_IMGS:          return "shader images must occupy continuous slots";
+        case _SG_VALIDATE_SHADERDESC_IMG_NAME:              return "GL backend requires uniform block member names";
+        case _SG_VALIDATE_SHADERDESC_ATTR_NAMES:            return "GLES2 backend requires vertex attribute names";
+        case _SG_VALIDATE_SHADERDESC_ATTR_SEMANTICS:        return "D3D11 backend requires vertex attribute semantics";
+        case _SG_VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG:  return "vertex attribute name/semantic string too long (max len 16)";
+
+        /* pipeline creation */
+        case _SG_VALIDATE_PIPELINEDESC_CANARY:          return "sg_pipeline_desc not initialized";
+        case _SG_VALIDATE_PIPELINEDESC_SHADER:          return "sg_pipeline_desc.shader missing or invalid";
+        case _SG_VALIDATE_PIPELINEDESC_NO_ATTRS:        return "sg_pipeline_desc.layout.attrs is empty or not continuous";
+        case _SG_VALIDATE_PIPELINEDESC_LAYOUT_STRIDE4:  return "sg_pipeline_desc.layout.buffers[].stride must be multiple of 4";
+        case _SG_VALIDATE_PIPELINEDESC_ATTR_NAME:       return "GLES2/WebGL missing vertex attribute name in shader";
+        case _SG_VALIDATE_PIPELINEDESC_ATTR_SEMANTICS:  return "D3D11 missing vertex attribute semantics in shader";
+
+        /* pass creation */
+        case _SG_VALIDATE_PASSDESC_CANARY:                  return "sg_pass_desc not initialized";
+        case _SG_VALIDATE_PASSDESC_NO_COLOR_ATTS:           return "sg_pass_desc.color_attachments[0] must be valid";
+        case _SG_VALIDATE_PASSDESC_NO_CONT_COLOR_ATTS:      return "color attachments must occupy continuous slots";
+        case _SG_VALIDATE_PASSDESC_IMAGE:                   return "pass attachment image is not valid";
+        case _SG_VALIDATE_PASSDESC_MIPLEVEL:                return "pass attachment mip level is bigger than image has mipmaps";
+        case _SG_VALIDATE_PASSDESC_FACE:                    return "pass attachment image is cubemap, but face index is too big";
+        case _SG_VALIDATE_PASSDESC_LAYER:                   return "pass attachment image is array texture, but layer index is too big";
+        case _SG_VALIDATE_PASSDESC_SLICE:                   return "pass attachment image is 3d texture, but slice value is too big";
+        case _SG_VALIDATE_PASSDESC_IMAGE_NO_RT:             return "pass attachment image must be render targets";
+        case _SG_VALIDATE_PASSDESC_COLOR_PIXELFORMATS:      return "all pass color attachment images must have the same pixel format";
+        case _SG_VALIDATE_PASSDESC_COLOR_INV_PIXELFORMAT:   return "pass color-attachment images must have a renderable pixel format";
+        case _SG_VALIDATE_PASSDESC_DEPTH_INV_PIXELFORMAT:   return "pass depth-attachment image must have depth pixel format";
+        case _SG_VALIDATE_PASSDESC_IMAGE_SIZES:             return "all pass attachments must have the same size";
+        case _SG_VALIDATE_PASSDESC_IMAGE_SAMPLE_COUNTS:     return "all pass attachments must have the same sample count";
+
+        /* sg_begin_pass */
+        case _SG_VALIDATE_BEGINPASS_PASS:       return "sg_begin_pass: pass must be valid";
+        case _SG_VALIDATE_BEGINPASS_IMAGE:      return "sg_begin_pass: one or more attachment images are not valid";
+
+        /* sg_apply_pipeline */
+        case _SG_VALIDATE_APIP_PIPELINE_VALID_ID:   return "sg_apply_pipeline: invalid pipeline id provided";
+        case _SG_VALIDATE_APIP_PIPELINE_EXISTS:     return "sg_apply_pipeline: pipeline object no longer alive";
+        case _SG_VALIDATE_APIP_PIPELINE_VALID:      return "sg_apply_pipeline: pipeline object not in valid state";
+        case _SG_VALIDATE_APIP_SHADER_EXISTS:       return "sg_apply_pipeline: shader object no longer alive";
+        case _SG_VALIDATE_APIP_SHADER_VALID:        return "sg_apply_pipeline: shader object not in valid state";
+        case _SG_VALIDATE_APIP_ATT_COUNT:           return "sg_apply_pipeline: color_attachment_count in pipeline doesn't match number of pass color attachments";
+        case _SG_VALIDATE_APIP_COLOR_FORMAT:        return "sg_apply_pipeline: color_format in pipeline doesn't match pass color attachment pixel format";
+        case _SG_VALIDATE_APIP_DEPTH_FORMAT:        return "sg_apply_pipeline: depth_format in pipeline doesn't match pass depth attachment pixel format";
+        case _SG_VALIDATE_APIP_SAMPLE_COUNT:        return "sg_apply_pipeline: MSAA sample count in pipeline doesn't match render pass attachment sample count";
+
+        /* sg_apply_bindings */
+        case _SG_VALIDATE_ABND_PIPELINE:            return "sg_apply_bindings: must be called after sg_apply_pipeline";
+        case _SG_VALIDATE_ABND_PIPELINE_EXISTS:     return "sg_apply_bindings: currently applied pipeline object no longer alive";
+        case _SG_VALIDATE_ABND_PIPELINE_VALID:      return "sg_apply_bindings: currently applied pipeline object not in valid state";
+        case _SG_VALIDATE_ABND_VBS:                 return "sg_apply_bindings: number of vertex buffers doesn't match number of pipeline vertex layouts";
+        case _SG_VALIDATE_ABND_VB_EXISTS:           return "sg_apply_bindings: vertex buffer no longer alive";
+        case _SG_VALIDATE_ABND_VB_TYPE:             return "sg_apply_bindings: buffer in vertex buffer slot is not a SG_BUFFERTYPE_VERTEXBUFFER";
+        case _SG_VALIDATE_ABND_VB_OVERFLOW:         return "sg_apply_bindings: buffer in vertex buffer slot is overflown";
+        case _SG_VALIDATE_ABND_NO_IB:               return "sg_apply_bindings: pipeline object defines indexed rendering, but no index buffer provided";
+        case _SG_VALIDATE_ABND_IB:                  return "sg_apply_bindings: pipeline object defines non-indexed rendering, but index buffer provided";
+        case _SG_VALIDATE_ABND_IB_EXISTS:           return "sg_apply_bindings: index buffer no longer alive";
+        case _SG_VALIDATE_ABND_IB_TYPE:             return "sg_apply_bindings: buffer in index buffer slot is not a SG_BUFFERTYPE_INDEXBUFFER";
+        case _SG_VALIDATE_ABND_IB_OVERFLOW:         return "sg_apply_bindings: buffer in index buffer slot is overflown";
+        case _SG_VALIDATE_ABND_VS_IMGS:             return "sg_apply_bindings: vertex shader image count doesn't match sg_shader_desc";
+        case _SG_VALIDATE_ABND_VS_IMG_EXISTS:       return "sg_apply_bindings: vertex shader image no longer alive";
+        case _SG_VALIDATE_ABND_VS_IMG_TYPES:        return "sg_apply_bindings: one or more vertex shader image types don't match sg_shader_desc";
+        case _SG_VALIDATE_ABND_FS_IMGS:             return "sg_apply_bindings: fragment shader image count doesn't match sg_shader_desc";
+        case _SG_VALIDATE_ABND_FS_IMG_EXISTS:       return "sg_apply_bindings: fragment shader image no longer alive";
+        case _SG_VALIDATE_ABND_FS_IMG_TYPES:        return "sg_apply_bindings: one or more fragment shader image types don't match sg_shader_desc";
+
+        /* sg_apply_uniforms */
+        case _SG_VALIDATE_AUB_NO_PIPELINE:      return "sg_apply_uniforms: must be called after sg_apply_pipeline()";
+        case _SG_VALIDATE_AUB_NO_UB_AT_SLOT:    return "sg_apply_uniforms: no uniform block declaration at this shader stage UB slot";
+        case _SG_VALIDATE_AUB_SIZE:             return "sg_apply_uniforms: data size exceeds declared uniform block size";
+
+        /* sg_update_buffer */
+        case _SG_VALIDATE_UPDATEBUF_USAGE:      return "sg_update_buffer: cannot update immutable buffer";
+        case _SG_VALIDATE_UPDATEBUF_SIZE:       return "sg_update_buffer: update size is bigger than buffer size";
+        case _SG_VALIDATE_UPDATEBUF_ONCE:       return "sg_update_buffer: only one update allowed per buffer and frame";
+        case _SG_VALIDATE_UPDATEBUF_APPEND:     return "sg_update_buffer: cannot call sg_update_buffer and sg_append_buffer in same frame";
+
+        /* sg_append_buffer */
+        case _SG_VALIDATE_APPENDBUF_USAGE:      return "sg_append_buffer: cannot append to immutable buffer";
+        case _SG_VALIDATE_APPENDBUF_SIZE:       return "sg_append_buffer: overall appended size is bigger than buffer size";
+        case _SG_VALIDATE_APPENDBUF_UPDATE:     return "sg_append_buffer: cannot call sg_append_buffer and sg_update_buffer in same frame";
+
+        /* sg_update_image */
+        case _SG_VALIDATE_UPDIMG_USAGE:         return "sg_update_image: cannot update immutable image";
+        case _SG_VALIDATE_UPDIMG_NOTENOUGHDATA: return "sg_update_image: not enough subimage data provided";
+        case _SG_VALIDATE_UPDIMG_SIZE:          return "sg_update_image: provided subimage data size too big";
+        case _SG_VALIDATE_UPDIMG_COMPRESSED:    return "sg_update_image: cannot update images with compressed format";
+        case _SG_VALIDATE_UPDIMG_ONCE:          return "sg_update_image: only one update allowed per image and frame";
+
+        /* sg_begin_image_upload */
+        case _SG_VALIDATE_UPLOADIMG_USAGE:      return "sg_begin_image_upload: cannot upload to immutable image";
+        case _SG_VALIDATE_UPLOADIMG_COMPRESSED: return "sg_begin_image_upload: cannot upload to images with compressed format";
+        case _SG_VALIDATE_UPLOADIMG_ONCE:       return "sg_begin_image_upload: only one update or upload allowed per image and frame";
+
+        /* sg_end_image_upload */
+        case _SG_VALIDATE_ENDUPLOAD_NOTPENDING: return "sg_end_image_upload: upload not pending (already ended, or begun in a previous frame?)";
+
+        default: return "unknown validation error";
+    }
+}
+#endif /* defined(SOKOL_DEBUG) */
+
+/*-- validation checks -------------------------------------------------------*/
+#if defined(SOKOL_DEBUG)
+_SOKOL_PRIVATE void _sg_validate_begin(void) {
+    _sg.validate_error = _SG_VALIDATE_SUCCESS;
+}
+
+_SOKOL_PRIVATE void _sg_validate(bool cond, _sg_validate_error_t err) {
+    if (!cond) {
+        _sg.validate_error = err;
+        SOKOL_LOG(_sg_validate_string(err));
+    }
+}
+
+_SOKOL_PRIVATE bool _sg_validate_end(void) {
+    if (_sg.validate_error != _SG_VALIDATE_SUCCESS) {
+        #if !defined(SOKOL_VALIDATE_NON_FATAL)
+            SOKOL_LOG("^^^^  VALIDATION FAILED, TERMINATING ^^^^");
+            SOKOL_ASSERT(false);
+        #endif
+        return false;
+    }
+    else {
+        return true;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_setup_validate_cache(const sg_desc* desc) {
+    SOKOL_ASSERT(desc && (desc->validate_cache_size > 0));
+    _sg.validate_cache.size = desc->validate_cache_size;
+    const size_t byte_size = sizeof(_sg_validate_cache_item_t) * (size_t)_sg.validate_cache.size;
+    _sg.validate_cache.items = (_sg_validate_cache_item_t*) SOKOL_MALLOC(byte_size);
+    SOKOL_ASSERT(_sg.validate_cache.items);
+    memset(_sg.validate_cache.items, 0, byte_size);
+    /* items with epoch 0 are empty */
+    _sg.validate_cache.epoch = 1;
+}
+
+_SOKOL_PRIVATE void _sg_discard_validate_cache(void) {
+    SOKOL_ASSERT(_sg.validate_cache.items);
+    SOKOL_FREE(_sg.validate_cache.items);
+    _sg.validate_cache.items = 0;
+}
+
+/* FNV-1a over the pipeline id and the 32-bit words of the bindings struct */
+_SOKOL_PRIVATE uint64_t _sg_validate_cache_hash(uint32_t pip_id, const sg_bindings* bindings) {
+    const uint32_t* words = (const uint32_t*) bindings;
+    const int num_words = (int)(sizeof(sg_bindings) / sizeof(uint32_t));
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = (hash ^ pip_id) * 0x100000001B3ULL;
+    for (int i = 0; i < num_words; i++) {
+        hash = (hash ^ words[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+#endif
+
+/* must be called whenever a resource is created, destroyed or goes into
+   a state which might turn a previously validated combination invalid
+*/
+_SOKOL_PRIVATE void _sg_validate_cache_invalidate(void) {
+    #if defined(SOKOL_DEBUG)
+        _sg.validate_cache.epoch++;
+        if (0 == _sg.validate_cache.epoch) {
+            _sg.validate_cache.epoch = 1;
+            memset(_sg.validate_cache.items, 0, sizeof(_sg_validate_cache_item_t) * (size_t)_sg.validate_cache.size);
+        }
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_buffer_desc(const sg_buffer_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        SOKOL_ASSERT(desc);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_BUFFERDESC_CANARY);
+        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_BUFFERDESC_CANARY);
+        SOKOL_VALIDATE(desc->size > 0, _SG_VALIDATE_BUFFERDESC_SIZE);
+        bool injected = (0 != desc->gl_buffers[0]) ||
+                        (0 != desc->mtl_buffers[0]) ||
+                        (0 != desc->d3d11_buffer) ||
+                        (0 != desc->wgpu_buffer);
+        if (!injected && (desc->usage == SG_USAGE_IMMUTABLE)) {
+            SOKOL_VALIDATE(0 != desc->content, _SG_VALIDATE_BUFFERDESC_CONTENT);
+        }
+        else {
+            SOKOL_VALIDATE(0 == desc->content, _SG_VALIDATE_BUFFERDESC_NO_CONTENT);
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_image_desc(const sg_image_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        SOKOL_ASSERT(desc);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_IMAGEDESC_CANARY);
+        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_IMAGEDESC_CANARY);
+        SOKOL_VALIDATE(desc->width > 0, _SG_VALIDATE_IMAGEDESC_WIDTH);
+        SOKOL_VALIDATE(desc->height > 0, _SG_VALIDATE_IMAGEDESC_HEIGHT);
+        const sg_pixel_format fmt = desc->pixel_format;
+        const sg_usage usage = desc->usage;
+        const bool injected = (0 != desc->gl_textures[0]) ||
+                              (0 != desc->mtl_textures[0]) ||
+                              (0 != desc->d3d11_texture) ||
+                              (0 != desc->wgpu_texture);
+        if (desc->render_target) {
+            SOKOL_ASSERT(((int)fmt >= 0) && ((int)fmt < _SG_PIXELFORMAT_NUM));
+            SOKOL_VALIDATE(_sg.formats[fmt].render, _SG_VALIDATE_IMAGEDESC_RT_PIXELFORMAT);
+            /* on GLES2, sample count for render targets is completely ignored */
+            #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+            if (!_sg.gl.gles2) {
+            #endif
+                if (desc->sample_count > 1) {
+                    SOKOL_VALIDATE(_sg.features.msaa_render_targets && _sg.formats[fmt].msaa, _SG_VALIDATE_IMAGEDESC_NO_MSAA_RT_SUPPORT);
+                }
+            #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+            }
+            #endif
+            SOKOL_VALIDATE(usage == SG_USAGE_IMMUTABLE, _SG_VALIDATE_IMAGEDESC_RT_IMMUTABLE);
+            SOKOL_VALIDATE(desc->content.subimage[0][0].ptr==0, _SG_VALIDATE_IMAGEDESC_RT_NO_CONTENT);
+        }
+        else {
+            SOKOL_VALIDATE(desc->sample_count <= 1, _SG_VALIDATE_IMAGEDESC_MSAA_BUT_NO_RT);
+            const bool valid_nonrt_fmt = !_sg_is_valid_rendertarget_depth_format(fmt);
+            SOKOL_VALIDATE(valid_nonrt_fmt, _SG_VALIDATE_IMAGEDESC_NONRT_PIXELFORMAT);
+            /* FIXME: should use the same "expected size" computation as in _sg_validate_update_image() here */
+            if (!injected && (usage == SG_USAGE_IMMUTABLE)) {
+                const int num_faces = desc->type == SG_IMAGETYPE_CUBE ? 6:1;
+                const int num_mips = desc->num_mipmaps;
+                for (int face_index = 0; face_index < num_faces; face_index++) {
+                    for (int mip_index = 0; mip_index < num_mips; mip_index++) {
+                        const bool has_data = desc->content.subimage[face_index][mip_index].ptr != 0;
+                        const bool has_size = desc->content.subimage[face_index][mip_index].size > 0;
+                        SOKOL_VALIDATE(has_data && has_size, _SG_VALIDATE_IMAGEDESC_CONTENT);
+                    }
+                }
+            }
+            else {
+                for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+                    for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+                        const bool no_data = 0 == desc->content.subimage[face_index][mip_index].ptr;
+                        const bool no_size = 0 == desc->content.subimage[face_index][mip_index].size;
+                        SOKOL_VALIDATE(no_data && no_size, _SG_VALIDATE_IMAGEDESC_NO_CONTENT);
+                    }
+                }
+            }
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        SOKOL_ASSERT(desc);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_SHADERDESC_CANARY);
+        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_SHADERDESC_CANARY);
+        #if defined(SOKOL_GLES2)
+            SOKOL_VALIDATE(0 != desc->attrs[0].name, _SG_VALIDATE_SHADERDESC_ATTR_NAMES);
+        #elif defined(SOKOL_D3D11)
+            SOKOL_VALIDATE(0 != desc->attrs[0].sem_name, _SG_VALIDATE_SHADERDESC_ATTR_SEMANTICS);
+        #endif
+        #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+            /* on GL, must provide shader source code */
+            SOKOL_VALIDATE(0 != desc->vs.source, _SG_VALIDATE_SHADERDESC_SOURCE);
+            SOKOL_VALIDATE(0 != desc->fs.source, _SG_VALIDATE_SHADERDESC_SOURCE);
+        #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
+            /* on Metal or D3D11, must provide shader source code or byte code */
+            SOKOL_VALIDATE((0 != desc->vs.source)||(0 != desc->vs.byte_code), _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
+            SOKOL_VALIDATE((0 != desc->fs.source)||(0 != desc->fs.byte_code), _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
+        #elif defined(SOKOL_WGPU)
+            /* on WGPU byte code must be provided */
+            SOKOL_VALIDATE((0 != desc->vs.byte_code), _SG_VALIDATE_SHADERDESC_BYTECODE);
+            SOKOL_VALIDATE((0 != desc->fs.byte_code), _SG_VALIDATE_SHADERDESC_BYTECODE);
+        #elif defined(SOKOL_SW)
+            /* on the software rasterizer, must provide C shader functions */
+            SOKOL_VALIDATE((0 != desc->sw_vs_func) && (0 != desc->sw_fs_func), _SG_VALIDATE_SHADERDESC_SW_FUNCS);
+            SOKOL_VALIDATE((desc->sw_num_varyings >= 0) && (desc->sw_num_varyings <= SG_SW_MAX_VARYINGS), _SG_VALIDATE_SHADERDESC_SW_VARYINGS);
+        #else
+            /* Dummy Backend, don't require source or bytecode */
+        #endif
+        for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+            if (desc->attrs[i].name) {
+                SOKOL_VALIDATE(strlen(desc->attrs[i].name) < _SG_STRING_SIZE, _SG_VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG);
+            }
+            if (desc->attrs[i].sem_name) {
+                SOKOL_VALIDATE(strlen(desc->attrs[i].sem_name) < _SG_STRING_SIZE, _SG_VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG);
+            }
+        }
+        /* if shader byte code, the size must also be provided */
+        if (0 != desc->vs.byte_code) {
+            SOKOL_VALIDATE(desc->vs.byte_code_size > 0, _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE);
+        }
+        if (0 != desc->fs.byte_code) {
+            SOKOL_VALIDATE(desc->fs.byte_code_size > 0, _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE);
+        }
+        for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+            const sg_shader_stage_desc* stage_desc = (stage_index == 0)? &desc->vs : &desc->fs;
+            bool uniform_blocks_continuous = true;
+            for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+                const sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
+                if (ub_desc->size > 0) {
+                    SOKOL_VALIDATE(uniform_blocks_continuous, _SG_VALIDATE_SHADERDESC_NO_CONT_UBS);
+                    bool uniforms_continuous = true;
+                    int uniform_offset = 0;
+                    int num_uniforms = 0;
+                    for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+                        const sg_shader_uniform_desc* u_desc = &ub_desc->uniforms[u_index];
+                        if (u_desc->type != SG_UNIFORMTYPE_INVALID) {
+                            SOKOL_VALIDATE(uniforms_continuous, _SG_VALIDATE_SHADERDESC_NO_CONT_UB_MEMBERS);
+                            #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+                            SOKOL_VALIDATE(0 != u_desc->name, _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME);
+                            #endif
+                            const int array_count = u_desc->array_count;
+                            uniform_offset += _sg_uniform_size(u_desc->type, array_count);
+                            num_uniforms++;
+                        }
+                        else {
+                            uniforms_continuous = false;
+                        }
+                    }
+                    #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+                    SOKOL_VALIDATE(uniform_offset == ub_desc->size, _SG_VALIDATE_SHADERDESC_UB_SIZE_MISMATCH);
+                    SOKOL_VALIDATE(num_uniforms > 0, _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS);
+                    #endif
+                }
+                else {
+                    uniform_blocks_continuous = false;
+                }
+            }
+            bool images_continuous = true;
+            for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+                const sg_shader_image_desc* img_desc = &stage_desc->images[img_index];
+                if (img_desc->type != _SG_IMAGETYPE_DEFAULT) {
+                    SOKOL_VALIDATE(images_continuous, _SG_VALIDATE_SHADERDESC_NO_CONT_IMGS);
+                    #if defined(SOKOL_GLES2)
+                    SOKOL_VALIDATE(0 != img_desc->name, _SG_VALIDATE_SHADERDESC_IMG_NAME);
+                    #endif
+                }
+                else {
+                    images_continuous = false;
+                }
+            }
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_pipeline_desc(const sg_pipeline_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        SOKOL_ASSERT(desc);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_PIPELINEDESC_CANARY);
+        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_PIPELINEDESC_CANARY);
+        SOKOL_VALIDATE(desc->shader.id != SG_INVALID_ID, _SG_VALIDATE_PIPELINEDESC_SHADER);
+        for (int buf_index = 0; buf_index < SG_MAX_SHADERSTAGE_BUFFERS; buf_index++) {
+            const sg_buffer_layout_desc* l_desc = &desc->layout.buffers[buf_index];
+            if (l_desc->stride == 0) {
+                continue;
+            }
+            SOKOL_VALIDATE((l_desc->stride & 3) == 0, _SG_VALIDATE_PIPELINEDESC_LAYOUT_STRIDE4);
+        }
+        SOKOL_VALIDATE(desc->layout.attrs[0].format != SG_VERTEXFORMAT_INVALID, _SG_VALIDATE_PIPELINEDESC_NO_ATTRS);
+        const _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
+        SOKOL_VALIDATE(0 != shd, _SG_VALIDATE_PIPELINEDESC_SHADER);
+        if (shd) {
+            SOKOL_VALIDATE(shd->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_PIPELINEDESC_SHADER);
+            bool attrs_cont = true;
+            for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+                const sg_vertex_attr_desc* a_desc = &desc->layout.attrs[attr_index];
+                if (a_desc->format == SG_VERTEXFORMAT_INVALID) {
+                    attrs_cont = false;
+                    continue;
+                }
+                SOKOL_VALIDATE(attrs_cont, _SG_VALIDATE_PIPELINEDESC_NO_ATTRS);
+                SOKOL_ASSERT(a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS);
+                #if defined(SOKOL_GLES2)
+                /* on GLES2, vertex attribute names must be provided */
+                SOKOL_VALIDATE(!_sg_strempty(&shd->gl.attrs[attr_index].name), _SG_VALIDATE_PIPELINEDESC_ATTR_NAME);
+                #elif defined(SOKOL_D3D11)
+                /* on D3D11, semantic names (and semantic indices) must be provided */
+                SOKOL_VALIDATE(!_sg_strempty(&shd->d3d11.attrs[attr_index].sem_name), _SG_VALIDATE_PIPELINEDESC_ATTR_SEMANTICS);
+                #endif
+            }
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_pass_desc(const sg_pass_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        SOKOL_ASSERT(desc);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_PASSDESC_CANARY);
+        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_PASSDESC_CANARY);
+        bool atts_cont = true;
+        sg_pixel_format color_fmt = SG_PIXELFORMAT_NONE;
+        int width = -1, height = -1, sample_count = -1;
+        for (int att_index = 0; att_index < SG_MAX_COLOR_ATTACHMENTS; att_index++) {
+            const sg_attachment_desc* att = &desc->color_attachments[att_index];
+            if (att->image.id == SG_INVALID_ID) {
+                SOKOL_VALIDATE(att_index > 0, _SG_VALIDATE_PASSDESC_NO_COLOR_ATTS);
+                atts_cont = false;
+                continue;
+            }
+            SOKOL_VALIDATE(atts_cont, _SG_VALIDATE_PASSDESC_NO_CONT_COLOR_ATTS);
+            const _sg_image_t* img = _sg_lookup_image(&_sg.pools, att->image.id);
+            SOKOL_VALIDATE((0 != img) && (img->slot.state == SG_RESOURCESTATE_VALID), _SG_VALIDATE_PASSDESC_IMAGE);
+            SOKOL_VALIDATE(att->mip_level < img->cmn.num_mipmaps, _SG_VALIDATE_PASSDESC_MIPLEVEL);
+            if (img->cmn.type == SG_IMAGETYPE_CUBE) {
+                SOKOL_VALIDATE(att->slice < 6, _SG_VALIDATE_PASSDESC_FACE);
+            }
+            else if (img->cmn.type == SG_IMAGETYPE_ARRAY) {
+                SOKOL_VALIDATE(att->slice < img->cmn.num_slices, _SG_VALIDATE_PASSDESC_LAYER);
+            }
+            else if (img->cmn.type == SG_IMAGETYPE_3D) {
+                SOKOL_VALIDATE(att->slice < img->cmn.num_slices, _SG_VALIDATE_PASSDESC_SLICE);
+            }
+            SOKOL_VALIDATE(img->cmn.render_target, _SG_VALIDATE_PASSDESC_IMAGE_NO_RT);
+            if (att_index == 0) {
+                color_fmt = img->cmn.pixel_format;
+                width = img->cmn.width >> att->mip_level;
+                height = img->cmn.height >> att->mip_level;
+                sample_count = img->cmn.sample_count;
+            }
+            else {
+                SOKOL_VALIDATE(img->cmn.pixel_format == color_fmt, _SG_VALIDATE_PASSDESC_COLOR_PIXELFORMATS);
+                SOKOL_VALIDATE(width == img->cmn.width >> att->mip_level, _SG_VALIDATE_PASSDESC_IMAGE_SIZES);
+                SOKOL_VALIDATE(height == img->cmn.height >> att->mip_level, _SG_VALIDATE_PASSDESC_IMAGE_SIZES);
+                SOKOL_VALIDATE(sample_count == img->cmn.sample_count, _SG_VALIDATE_PASSDESC_IMAGE_SAMPLE_COUNTS);
+            }
+            SOKOL_VALIDATE(_sg_is_valid_rendertarget_color_format(img->cmn.pixel_format), _SG_VALIDATE_PASSDESC_COLOR_INV_PIXELFORMAT);
+        }
+        if (desc->depth_stencil_attachment.image.id != SG_INVALID_ID) {
+            const sg_attachment_desc* att = &desc->depth_stencil_attachment;
+            const _sg_image_t* img = _sg_lookup_image(&_sg.pools, att->image.id);
+            SOKOL_VALIDATE((0 != img) && (img->slot.state == SG_RESOURCESTATE_VALID), _SG_VALIDATE_PASSDESC_IMAGE);
+            SOKOL_VALIDATE(att->mip_level < img->cmn.num_mipmaps, _SG_VALIDATE_PASSDESC_MIPLEVEL);
+            if (img->cmn.type == SG_IMAGETYPE_CUBE) {
+                SOKOL_VALIDATE(att->slice < 6, _SG_VALIDATE_PASSDESC_FACE);
+            }
+            else if (img->cmn.type == SG_IMAGETYPE_ARRAY) {
+                SOKOL_VALIDATE(att->slice < img->cmn.num_slices, _SG_VALIDATE_PASSDESC_LAYER);
+            }
+            else if (img->cmn.type == SG_IMAGETYPE_3D) {
+                SOKOL_VALIDATE(att->slice < img->cmn.num_slices, _SG_VALIDATE_PASSDESC_SLICE);
+            }
+            SOKOL_VALIDATE(img->cmn.render_target, _SG_VALIDATE_PASSDESC_IMAGE_NO_RT);
+            SOKOL_VALIDATE(width == img->cmn.width >> att->mip_level, _SG_VALIDATE_PASSDESC_IMAGE_SIZES);
+            SOKOL_VALIDATE(height == img->cmn.height >> att->mip_level, _SG_VALIDATE_PASSDESC_IMAGE_SIZES);
+            SOKOL_VALIDATE(sample_count == img->cmn.sample_count, _SG_VALIDATE_PASSDESC_IMAGE_SAMPLE_COUNTS);
+            SOKOL_VALIDATE(_sg_is_valid_rendertarget_depth_format(img->cmn.pixel_format), _SG_VALIDATE_PASSDESC_DEPTH_INV_PIXELFORMAT);
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_begin_pass(_sg_pass_t* pass) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(pass);
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(pass->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_BEGINPASS_PASS);
+
+        for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+            const _sg_attachment_t* att = &pass->cmn.color_atts[i];
+            const _sg_image_t* img = _sg_pass_color_image(pass, i);
+            if (img) {
+                SOKOL_VALIDATE(img->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_BEGINPASS_IMAGE);
+                SOKOL_VALIDATE(img->slot.id == att->image_id.id, _SG_VALIDATE_BEGINPASS_IMAGE);
+            }
+        }
+        const _sg_image_t* ds_img = _sg_pass_ds_image(pass);
+        if (ds_img) {
+            const _sg_attachment_t* att = &pass->cmn.ds_att;
+            SOKOL_VALIDATE(ds_img->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_BEGINPASS_IMAGE);
+            SOKOL_VALIDATE(ds_img->slot.id == att->image_id.id, _SG_VALIDATE_BEGINPASS_IMAGE);
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_apply_pipeline(sg_pipeline pip_id) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(pip_id);
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        /* the pipeline object must be alive and valid */
+        SOKOL_VALIDATE(pip_id.id != SG_INVALID_ID, _SG_VALIDATE_APIP_PIPELINE_VALID_ID);
+        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+        SOKOL_VALIDATE(pip != 0, _SG_VALIDATE_APIP_PIPELINE_EXISTS);
+        if (!pip) {
+            return SOKOL_VALIDATE_END();
+        }
+        SOKOL_VALIDATE(pip->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_APIP_PIPELINE_VALID);
+        /* the pipeline's shader must be alive and valid */
+        SOKOL_ASSERT(pip->shader);
+        SOKOL_VALIDATE(pip->shader->slot.id == pip->cmn.shader_id.id, _SG_VALIDATE_APIP_SHADER_EXISTS);
+        SOKOL_VALIDATE(pip->shader->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_APIP_SHADER_VALID);
+        /* check that pipeline attributes match current pass attributes */
+        const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, _sg.cur_pass.id);
+        if (pass) {
+            /* an offscreen pass */
+            const _sg_image_t* att_img = _sg_pass_color_image(pass, 0);
+            SOKOL_VALIDATE(pip->cmn.color_attachment_count == pass->cmn.num_color_atts, _SG_VALIDATE_APIP_ATT_COUNT);
+            SOKOL_VALIDATE(pip->cmn.color_format == att_img->cmn.pixel_format, _SG_VALIDATE_APIP_COLOR_FORMAT);
+            SOKOL_VALIDATE(pip->cmn.sample_count == att_img->cmn.sample_count, _SG_VALIDATE_APIP_SAMPLE_COUNT);
+            const _sg_image_t* att_dsimg = _sg_pass_ds_image(pass);
+            if (att_dsimg) {
+                SOKOL_VALIDATE(pip->cmn.depth_format == att_dsimg->cmn.pixel_format, _SG_VALIDATE_APIP_DEPTH_FORMAT);
+            }
+            else {
+                SOKOL_VALIDATE(pip->cmn.depth_format == SG_PIXELFORMAT_NONE, _SG_VALIDATE_APIP_DEPTH_FORMAT);
+            }
+        }
+        else {
+            /* default pass */
+            SOKOL_VALIDATE(pip->cmn.color_attachment_count == 1, _SG_VALIDATE_APIP_ATT_COUNT);
+            SOKOL_VALIDATE(pip->cmn.color_format == _sg.desc.context.color_format, _SG_VALIDATE_APIP_COLOR_FORMAT);
+            SOKOL_VALIDATE(pip->cmn.depth_format == _sg.desc.context.depth_format, _SG_VALIDATE_APIP_DEPTH_FORMAT);
+            SOKOL_VALIDATE(pip->cmn.sample_count == _sg.desc.context.sample_count, _SG_VALIDATE_APIP_SAMPLE_COUNT);
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_apply_bindings_full(const sg_bindings* bindings) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(bindings);
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+
+        /* a pipeline object must have been applied */
+        SOKOL_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, _SG_VALIDATE_ABND_PIPELINE);
+        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+        SOKOL_VALIDATE(pip != 0, _SG_VALIDATE_ABND_PIPELINE_EXISTS);
+        if (!pip) {
+            return SOKOL_VALIDATE_END();
+        }
+        SOKOL_VALIDATE(pip->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_ABND_PIPELINE_VALID);
+        SOKOL_ASSERT(pip->shader && (pip->cmn.shader_id.id == pip->shader->slot.id));
+
+        /* has expected vertex buffers, and vertex buffers still exist */
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+            if (bindings->vertex_buffers[i].id != SG_INVALID_ID) {
+                SOKOL_VALIDATE(pip->cmn.vertex_layout_valid[i], _SG_VALIDATE_ABND_VBS);
+                /* buffers in vertex-buffer-slots must be of type SG_BUFFERTYPE_VERTEXBUFFER */
+                const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
+                SOKOL_VALIDATE(buf != 0, _SG_VALIDATE_ABND_VB_EXISTS);
+                if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
+                    SOKOL_VALIDATE(SG_BUFFERTYPE_VERTEXBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_VB_TYPE);
+                    SOKOL_VALIDATE(!buf->cmn.append_overflow, _SG_VALIDATE_ABND_VB_OVERFLOW);
+                }
+            }
+            else {
+                /* vertex buffer provided in a slot which has no vertex layout in pipeline */
+                SOKOL_VALIDATE(!pip->cmn.vertex_layout_valid[i], _SG_VALIDATE_ABND_VBS);
+            }
+        }
+
+        /* index buffer expected or not, and index buffer still exists */
+        if (pip->cmn.index_type == SG_INDEXTYPE_NONE) {
+            /* pipeline defines non-indexed rendering, but index buffer provided */
+            SOKOL_VALIDATE(bindings->index_buffer.id == SG_INVALID_ID, _SG_VALIDATE_ABND_IB);
+        }
+        else {
+            /* pipeline defines indexed rendering, but no index buffer provided */
+            SOKOL_VALIDATE(bindings->index_buffer.id != SG_INVALID_ID, _SG_VALIDATE_ABND_NO_IB);
+        }
+        if (bindings->index_buffer.id != SG_INVALID_ID) {
+            /* buffer in index-buffer-slot must be of type SG_BUFFERTYPE_INDEXBUFFER */
+            const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
+            SOKOL_VALIDATE(buf != 0, _SG_VALIDATE_ABND_IB_EXISTS);
+            if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
+                SOKOL_VALIDATE(SG_BUFFERTYPE_INDEXBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_IB_TYPE);
+                SOKOL_VALIDATE(!buf->cmn.append_overflow, _SG_VALIDATE_ABND_IB_OVERFLOW);
+            }
+        }
+
+        /* has expected vertex shader images */
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+            _sg_shader_stage_t* stage = &pip->shader->cmn.stage[SG_SHADERSTAGE_VS];
+            if (bindings->vs_images[i].id != SG_INVALID_ID) {
+                SOKOL_VALIDATE(i < stage->num_images, _SG_VALIDATE_ABND_VS_IMGS);
+                const _sg_image_t* img = _sg_lookup_image(&_sg.pools, bindings->vs_images[i].id);
+                SOKOL_VALIDATE(img != 0, _SG_VALIDATE_ABND_VS_IMG_EXISTS);
+                if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
+                    SOKOL_VALIDATE(img->cmn.type == stage->images[i].type, _SG_VALIDATE_ABND_VS_IMG_TYPES);
+                }
+            }
+            else {
+                SOKOL_VALIDATE(i >= stage->num_images, _SG_VALIDATE_ABND_VS_IMGS);
+            }
+        }
+
+        /* has expected fragment shader images */
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+            _sg_shader_stage_t* stage = &pip->shader->cmn.stage[SG_SHADERSTAGE_FS];
+            if (bindings->fs_images[i].id != SG_INVALID_ID) {
+                SOKOL_VALIDATE(i < stage->num_images, _SG_VALIDATE_ABND_FS_IMGS);
+                const _sg_image_t* img = _sg_lookup_image(&_sg.pools, bindings->fs_images[i].id);
+                SOKOL_VALIDATE(img != 0, _SG_VALIDATE_ABND_FS_IMG_EXISTS);
+                if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
+                    SOKOL_VALIDATE(img->cmn.type == stage->images[i].type, _SG_VALIDATE_ABND_FS_IMG_TYPES);
+                }
+            }
+            else {
+                SOKOL_VALIDATE(i >= stage->num_images, _SG_VALIDATE_ABND_FS_IMGS);
+            }
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(bindings);
+        return true;
+    #else
+        /* a combination which already passed validation, and none of the
+           involved resources has changed since then, doesn't need to be
+           validated again
+        */
+        const uint64_t hash = _sg_validate_cache_hash(_sg.cur_pipeline.id, bindings);
+        _sg_validate_cache_item_t* item = &_sg.validate_cache.items[hash % (uint64_t)_sg.validate_cache.size];
+        if ((item->epoch == _sg.validate_cache.epoch) &&
+            (item->hash == hash) &&
+            (item->pip_id == _sg.cur_pipeline.id) &&
+            (0 == memcmp(&item->bindings, bindings, sizeof(sg_bindings))))
+        {
+            return true;
+        }
+        /* in sampling mode, only fully validate every Nth call */
+        if (_sg.desc.validate_sample_rate > 1) {
+            if (0 != (_sg.validate_cache.sample_counter++ % (uint32_t)_sg.desc.validate_sample_rate)) {
+                return true;
+            }
+        }
+        if (!_sg_validate_apply_bindings_full(bindings)) {
+            return false;
+        }
+        item->epoch = _sg.validate_cache.epoch;
+        item->pip_id = _sg.cur_pipeline.id;
+        item->hash = hash;
+        item->bindings = *bindings;
+        return true;
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
+    _SOKOL_UNUSED(data);
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(stage_index);
+        _SOKOL_UNUSED(ub_index);
+        _SOKOL_UNUSED(num_bytes);
+        return true;
+    #else
+        SOKOL_ASSERT((stage_index == SG_SHADERSTAGE_VS) || (stage_index == SG_SHADERSTAGE_FS));
+        SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, _SG_VALIDATE_AUB_NO_PIPELINE);
+        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+        SOKOL_ASSERT(pip && (pip->slot.id == _sg.cur_pipeline.id));
+        SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
+
+        /* check that there is a uniform block at 'stage' and 'ub_index' */
+        const _sg_shader_stage_t* stage = &pip->shader->cmn.stage[stage_index];
+        SOKOL_VALIDATE(ub_index < stage->num_uniform_blocks, _SG_VALIDATE_AUB_NO_UB_AT_SLOT);
+
+        /* check that the provided data size doesn't exceed the uniform block size */
+        SOKOL_VALIDATE(num_bytes <= stage->uniform_blocks[ub_index].size, _SG_VALIDATE_AUB_SIZE);
+
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_update_buffer(const _sg_buffer_t* buf, const void* data, int size) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(buf);
+        _SOKOL_UNUSED(data);
+        _SOKOL_UNUSED(size);
+        return true;
+    #else
+        SOKOL_ASSERT(buf && data);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(buf->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_UPDATEBUF_USAGE);
+        SOKOL_VALIDATE(buf->cmn.size >= size, _SG_VALIDATE_UPDATEBUF_SIZE);
+        SOKOL_VALIDATE(buf->cmn.update_frame_index != _sg.frame_index, _SG_VALIDATE_UPDATEBUF_ONCE);
+        SOKOL_VALIDATE(buf->cmn.append_frame_index != _sg.frame_index, _SG_VALIDATE_UPDATEBUF_APPEND);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_append_buffer(const _sg_buffer_t* buf, const void* data, int size) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(buf);
+        _SOKOL_UNUSED(data);
+        _SOKOL_UNUSED(size);
+        return true;
+    #else
+        SOKOL_ASSERT(buf && data);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(buf->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_APPENDBUF_USAGE);
+        SOKOL_VALIDATE(buf->cmn.size >= (buf->cmn.append_pos+size), _SG_VALIDATE_APPENDBUF_SIZE);
+        SOKOL_VALIDATE(buf->cmn.update_frame_index != _sg.frame_index, _SG_VALIDATE_APPENDBUF_UPDATE);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_image_content* data) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        _SOKOL_UNUSED(data);
+        return true;
+    #else
+        SOKOL_ASSERT(img && data);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(img->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_UPDIMG_USAGE);
+        SOKOL_VALIDATE(img->cmn.upd_frame_index != _sg.frame_index, _SG_VALIDATE_UPDIMG_ONCE);
+        SOKOL_VALIDATE(!_sg_is_compressed_pixel_format(img->cmn.pixel_format), _SG_VALIDATE_UPDIMG_COMPRESSED);
+        const int num_faces = (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+        const int num_mips = img->cmn.num_mipmaps;
+        for (int face_index = 0; face_index < num_faces; face_index++) {
+            for (int mip_index = 0; mip_index < num_mips; mip_index++) {
+                SOKOL_VALIDATE(0 != data->subimage[face_index][mip_index].ptr, _SG_VALIDATE_UPDIMG_NOTENOUGHDATA);
+                const int mip_width = _sg_max(img->cmn.width >> mip_index, 1);
+                const int mip_height = _sg_max(img->cmn.height >> mip_index, 1);
+                const int bytes_per_slice = _sg_surface_pitch(img->cmn.pixel_format, mip_width, mip_height, 1);
+                const int expected_size = bytes_per_slice * img->cmn.num_slices;
+                SOKOL_VALIDATE(data->subimage[face_index][mip_index].size <= expected_size, _SG_VALIDATE_UPDIMG_SIZE);
+            }
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_begin_image_upload(const _sg_image_t* img) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        return true;
+    #else
+        SOKOL_ASSERT(img);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(img->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_UPLOADIMG_USAGE);
+        SOKOL_VALIDATE(!_sg_is_compressed_pixel_format(img->cmn.pixel_format), _SG_VALIDATE_UPLOADIMG_COMPRESSED);
+        SOKOL_VALIDATE(img->cmn.upd_frame_index != _sg.frame_index, _SG_VALIDATE_UPLOADIMG_ONCE);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_end_image_upload(const _sg_upload_t* upl) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(upl);
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(upl && (upl->state == SG_UPLOADSTATE_PENDING), _SG_VALIDATE_ENDUPLOAD_NOTPENDING);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+/*== fill in desc default values =============================================*/
+_SOKOL_PRIVATE sg_buffer_desc _sg_buffer_desc_defaults(const sg_buffer_desc* desc) {
+    sg_buffer_desc def = *desc;
+    def.type = _sg_def(def.type, SG_BUFFERTYPE_VERTEXBUFFER);
+    def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
+    return def;
+}
+
+_SOKOL_PRIVATE sg_image_desc _sg_image_desc_defaults(const sg_image_desc* desc) {
+    sg_image_desc def = *desc;
+    def.type = _sg_def(def.type, SG_IMAGETYPE_2D);
+    def.num_slices = _sg_def(def.num_slices, 1);
+    def.num_mipmaps = _sg_def(def.num_mipmaps, 1);
+    def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
+    if (desc->render_target) {
+        def.pixel_format = _sg_def(def.pixel_format, _sg.desc.context.color_format);
+        def.sample_count = _sg_def(def.sample_count, _sg.desc.context.sample_count);
+    }
+    else {
+        def.pixel_format = _sg_def(def.pixel_format, SG_PIXELFORMAT_RGBA8);
+        def.sample_count = _sg_def(def.sample_count, 1);
+    }
+    def.min_filter = _sg_def(def.min_filter, SG_FILTER_NEAREST);
+    def.mag_filter = _sg_def(def.mag_filter, SG_FILTER_NEAREST);
+    def.wrap_u = _sg_def(def.wrap_u, SG_WRAP_REPEAT);
+    def.wrap_v = _sg_def(def.wrap_v, SG_WRAP_REPEAT);
+    def.wrap_w = _sg_def(def.wrap_w, SG_WRAP_REPEAT);
+    def.border_color = _sg_def(def.border_color, SG_BORDERCOLOR_OPAQUE_BLACK);
+    def.max_anisotropy = _sg_def(def.max_anisotropy, 1);
+    def.max_lod = _sg_def_flt(def.max_lod, FLT_MAX);
+    return def;
+}
+
+_SOKOL_PRIVATE sg_shader_desc _sg_shader_desc_defaults(const sg_shader_desc* desc) {
+    sg_shader_desc def = *desc;
+    #if defined(SOKOL_METAL)
+        def.vs.entry = _sg_def(def.vs.entry, "_main");
+        def.fs.entry = _sg_def(def.fs.entry, "_main");
+    #else
+        def.vs.entry = _sg_def(def.vs.entry, "main");
+        def.fs.entry = _sg_def(def.fs.entry, "main");
+    #endif
+    #if defined(SOKOL_D3D11)
+        if (def.vs.source) {
+            def.vs.d3d11_target = _sg_def(def.vs.d3d11_target, "vs_4_0");
+        }
+        if (def.fs.source) {
+            def.fs.d3d11_target = _sg_def(def.fs.d3d11_target, "ps_4_0");
+        }
+    #endif
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &def.vs : &def.fs;
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
+            if (0 == ub_desc->size) {
+                break;
+            }
+            for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+                sg_shader_uniform_desc* u_desc = &ub_desc->uniforms[u_index];
+                if (u_desc->type == SG_UNIFORMTYPE_INVALID) {
+                    break;
+                }
+                u_desc->array_count = _sg_def(u_desc->array_count, 1);
+            }
+        }
+        for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+            sg_shader_image_desc* img_desc = &stage_desc->images[img_index];
+            if (img_desc->type == _SG_IMAGETYPE_DEFAULT) {
+                break;
+            }
+            img_desc->sampler_type = _sg_def(img_desc->sampler_type, SG_SAMPLERTYPE_FLOAT);
+        }
+    }
+    return def;
+}
+
+_SOKOL_PRIVATE sg_pipeline_desc _sg_pipeline_desc_defaults(const sg_pipeline_desc* desc) {
+    sg_pipeline_desc def = *desc;
+
+    def.primitive_type = _sg_def(def.primitive_type, SG_PRIMITIVETYPE_TRIANGLES);
+    def.index_type = _sg_def(def.index_type, SG_INDEXTYPE_NONE);
+
+    def.depth_stencil.stencil_front.fail_op = _sg_def(def.depth_stencil.stencil_front.fail_op, SG_STENCILOP_KEEP);
+    def.depth_stencil.stencil_front.depth_fail_op = _sg_def(def.depth_stencil.stencil_front.depth_fail_op, SG_STENCILOP_KEEP);
+    def.depth_stencil.stencil_front.pass_op = _sg_def(def.depth_stencil.stencil_front.pass_op, SG_STENCILOP_KEEP);
+    def.depth_stencil.stencil_front.compare_func = _sg_def(def.depth_stencil.stencil_front.compare_func, SG_COMPAREFUNC_ALWAYS);
+    def.depth_stencil.stencil_back.fail_op = _sg_def(def.depth_stencil.stencil_back.fail_op, SG_STENCILOP_KEEP);
+    def.depth_stencil.stencil_back.depth_fail_op = _sg_def(def.depth_stencil.stencil_back.depth_fail_op, SG_STENCILOP_KEEP);
+    def.depth_stencil.stencil_back.pass_op = _sg_def(def.depth_stencil.stencil_back.pass_op, SG_STENCILOP_KEEP);
+    def.depth_stencil.stencil_back.compare_func = _sg_def(def.depth_stencil.stencil_back.compare_func, SG_COMPAREFUNC_ALWAYS);
+    def.depth_stencil.depth_compare_func = _sg_def(def.depth_stencil.depth_compare_func, SG_COMPAREFUNC_ALWAYS);
+
+    def.blend.src_factor_rgb = _sg_def(def.blend.src_factor_rgb, SG_BLENDFACTOR_ONE);
+    def.blend.dst_factor_rgb = _sg_def(def.blend.dst_factor_rgb, SG_BLENDFACTOR_ZERO);
+    def.blend.op_rgb = _sg_def(def.blend.op_rgb, SG_BLENDOP_ADD);
+    def.blend.src_factor_alpha = _sg_def(def.blend.src_factor_alpha, SG_BLENDFACTOR_ONE);
+    def.blend.dst_factor_alpha = _sg_def(def.blend.dst_factor_alpha, SG_BLENDFACTOR_ZERO);
+    def.blend.op_alpha = _sg_def(def.blend.op_alpha, SG_BLENDOP_ADD);
+    if (def.blend.color_write_mask == SG_COLORMASK_NONE) {
+        def.blend.color_write_mask = 0;
+    }
+    else {
+        def.blend.color_write_mask = (uint8_t) _sg_def((sg_color_mask)def.blend.color_write_mask, SG_COLORMASK_RGBA);
+    }
+    def.blend.color_attachment_count = _sg_def(def.blend.color_attachment_count, 1);
+    def.blend.color_format = _sg_def(def.blend.color_format, _sg.desc.context.color_format);
+    def.blend.depth_format = _sg_def(def.blend.depth_format, _sg.desc.context.depth_format);
+
+    def.rasterizer.cull_mode = _sg_def(def.rasterizer.cull_mode, SG_CULLMODE_NONE);
+    def.rasterizer.face_winding = _sg_def(def.rasterizer.face_winding, SG_FACEWINDING_CW);
+    def.rasterizer.sample_count = _sg_def(def.rasterizer.sample_count, _sg.desc.context.sample_count);
+
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        sg_vertex_attr_desc* a_desc = &def.layout.attrs[attr_index];
+        if (a_desc->format == SG_VERTEXFORMAT_INVALID) {
+            break;
+        }
+        SOKOL_ASSERT((a_desc->buffer_index >= 0) && (a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
+        sg_buffer_layout_desc* b_desc = &def.layout.buffers[a_desc->buffer_index];
+        b_desc->step_func = _sg_def(b_desc->step_func, SG_VERTEXSTEP_PER_VERTEX);
+        b_desc->step_rate = _sg_def(b_desc->step_rate, 1);
+    }
+
+    /* resolve vertex layout strides and offsets */
+    int auto_offset[SG_MAX_SHADERSTAGE_BUFFERS];
+    memset(auto_offset, 0, sizeof(auto_offset));
+    bool use_auto_offset = true;
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        /* to use computed offsets, *all* attr offsets must be 0 */
+        if (def.layout.attrs[attr_index].offset != 0) {
+            use_auto_offset = false;
+        }
+    }
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        sg_vertex_attr_desc* a_desc = &def.layout.attrs[attr_index];
+        if (a_desc->format == SG_VERTEXFORMAT_INVALID) {
+            break;
+        }
+        SOKOL_ASSERT((a_desc->buffer_index >= 0) && (a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
+        if (use_auto_offset) {
+            a_desc->offset = auto_offset[a_desc->buffer_index];
+        }
+        auto_offset[a_desc->buffer_index] += _sg_vertexformat_bytesize(a_desc->format);
+    }
+    /* compute vertex strides if needed */
+    for (int buf_index = 0; buf_index < SG_MAX_SHADERSTAGE_BUFFERS; buf_index++) {
+        sg_buffer_layout_desc* l_desc = &def.layout.buffers[buf_index];
+        if (l_desc->stride == 0) {
+            l_desc->stride = auto_offset[buf_index];
+        }
+    }
+
+    return def;
+}
+
+_SOKOL_PRIVATE sg_pass_desc _sg_pass_desc_defaults(const sg_pass_desc* desc) {
+    /* FIXME: no values to replace in sg_pass_desc? */
+    sg_pass_desc def = *desc;
+    return def;
+}
+
+/*== allocate/initialize resource private functions ==========================*/
+_SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
+    sg_buffer res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.buffer_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &_sg.pools.buffers[slot_index].slot, slot_index);
+    }
+    else {
+        /* pool is exhausted */
+        res.id = SG_INVALID_ID;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE sg_image _sg_alloc_image(void) {
+    sg_image res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.image_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &_sg.pools.images[slot_index].slot, slot_index);
+    }
+    else {
+        /* pool is exhausted */
+        res.id = SG_INVALID_ID;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE sg_shader _sg_alloc_shader(void) {
+    sg_shader res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.shader_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &_sg.pools.shaders[slot_index].slot, slot_index);
+    }
+    else {
+        /* pool is exhausted */
+        res.id = SG_INVALID_ID;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE sg_pipeline _sg_alloc_pipeline(void) {
+    sg_pipeline res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.pipeline_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        res.id =_sg_slot_alloc(&_sg.pools.pipeline_pool, &_sg.pools.pipelines[slot_index].slot, slot_index);
+    }
+    else {
+        /* pool is exhausted */
+        res.id = SG_INVALID_ID;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
+    sg_pass res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.pass_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &_sg.pools.passes[slot_index].slot, slot_index);
+    }
+    else {
+        /* pool is exhausted */
+        res.id = SG_INVALID_ID;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE void _sg_dealloc_buffer(sg_buffer buf_id) {
+    SOKOL_ASSERT(buf_id.id != SG_INVALID_ID);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    SOKOL_ASSERT(buf && buf->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_reset_slot(&buf->slot);
+    _sg_pool_free_index(&_sg.pools.buffer_pool, _sg_slot_index(buf_id.id));
+    _sg_validate_cache_invalidate();
+}
+
+_SOKOL_PRIVATE void _sg_dealloc_image(sg_image img_id) {
+    SOKOL_ASSERT(img_id.id != SG_INVALID_ID);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    SOKOL_ASSERT(img && img->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_reset_slot(&img->slot);
+    _sg_pool_free_index(&_sg.pools.image_pool, _sg_slot_index(img_id.id));
+    _sg_validate_cache_invalidate();
+}
+
+_SOKOL_PRIVATE void _sg_dealloc_shader(sg_shader shd_id) {
+    SOKOL_ASSERT(shd_id.id != SG_INVALID_ID);
+    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
+    SOKOL_ASSERT(shd && shd->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_reset_slot(&shd->slot);
+    _sg_pool_free_index(&_sg.pools.shader_pool, _sg_slot_index(shd_id.id));
+    _sg_validate_cache_invalidate();
+}
+
+_SOKOL_PRIVATE void _sg_dealloc_pipeline(sg_pipeline pip_id) {
+    SOKOL_ASSERT(pip_id.id != SG_INVALID_ID);
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    SOKOL_ASSERT(pip && pip->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_reset_slot(&pip->slot);
+    _sg_pool_free_index(&_sg.pools.pipeline_pool, _sg_slot_index(pip_id.id));
+    _sg_validate_cache_invalidate();
+}
+
+_SOKOL_PRIVATE void _sg_dealloc_pass(sg_pass pass_id) {
+    SOKOL_ASSERT(pass_id.id != SG_INVALID_ID);
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    SOKOL_ASSERT(pass && pass->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_reset_slot(&pass->slot);
+    _sg_pool_free_index(&_sg.pools.pass_pool, _sg_slot_index(pass_id.id));
+}
+
+_SOKOL_PRIVATE void _sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(buf_id.id != SG_INVALID_ID && desc);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    SOKOL_ASSERT(buf && buf->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_BUFFER, &buf->slot, _sg.active_context.id, _sg.active_group.id);
+    if (_sg_validate_buffer_desc(desc)) {
+        buf->slot.state = _sg_create_buffer(buf, desc);
+    }
+    else {
+        buf->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    SOKOL_ASSERT((buf->slot.state == SG_RESOURCESTATE_VALID)||(buf->slot.state == SG_RESOURCESTATE_FAILED));
+    _sg_validate_cache_invalidate();
+    if (buf->slot.state == SG_RESOURCESTATE_VALID) {
+        _sg_mem_add_buffer(buf);
+        _sg_mem_check_budget();
+    }
+}
+
+_SOKOL_PRIVATE void _sg_init_image(sg_image img_id, const sg_image_desc* desc) {
+    SOKOL_ASSERT(img_id.id != SG_INVALID_ID && desc);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    SOKOL_ASSERT(img && img->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_IMAGE, &img->slot, _sg.active_context.id, _sg.active_group.id);
+    if (_sg_validate_image_desc(desc)) {
+        img->slot.state = _sg_create_image(img, desc);
+    }
+    else {
+        img->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    SOKOL_ASSERT((img->slot.state == SG_RESOURCESTATE_VALID)||(img->slot.state == SG_RESOURCESTATE_FAILED));
+    _sg_validate_cache_invalidate();
+    if (img->slot.state == SG_RESOURCESTATE_VALID) {
+        _sg_mem_add_image(img);
+        _sg_mem_check_budget();
+    }
+}
+
+_SOKOL_PRIVATE void _sg_init_shader(sg_shader shd_id, const sg_shader_desc* desc) {
+    SOKOL_ASSERT(shd_id.id != SG_INVALID_ID && desc);
+    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
+    SOKOL_ASSERT(shd && shd->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_SHADER, &shd->slot, _sg.active_context.id, _sg.active_group.id);
+    if (_sg_validate_shader_desc(desc)) {
+        shd->slot.state = _sg_create_shader(shd, desc);
+    }
+    else {
+        shd->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID)||(shd->slot.state == SG_RESOURCESTATE_FAILED));
+    _sg_validate_cache_invalidate();
+    /* pending warm-up pipelines may be waiting for this shader */
+    _sg.warmup.shader_epoch++;
+}
+
+_SOKOL_PRIVATE void _sg_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc* desc) {
+    SOKOL_ASSERT(pip_id.id != SG_INVALID_ID && desc);
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    SOKOL_ASSERT(pip && pip->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_PIPELINE, &pip->slot, _sg.active_context.id, _sg.active_group.id);
+    if (_sg_validate_pipeline_desc(desc)) {
+        _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
+        if (shd && (shd->slot.state == SG_RESOURCESTATE_VALID)) {
+            pip->slot.state = _sg_create_pipeline(pip, shd, desc);
+        }
+        else {
+            pip->slot.state = SG_RESOURCESTATE_FAILED;
+        }
+    }
+    else {
+        pip->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID)||(pip->slot.state == SG_RESOURCESTATE_FAILED));
+    _sg_validate_cache_invalidate();
+}
+
+_SOKOL_PRIVATE void _sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
+    SOKOL_ASSERT(pass_id.id != SG_INVALID_ID && desc);
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    SOKOL_ASSERT(pass && pass->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_PASS, &pass->slot, _sg.active_context.id, _sg.active_group.id);
+    if (_sg_validate_pass_desc(desc)) {
+        /* lookup pass attachment image pointers */
+        _sg_image_t* att_imgs[SG_MAX_COLOR_ATTACHMENTS + 1];
+        for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+            if (desc->color_attachments[i].image.id) {
+                att_imgs[i] = _sg_lookup_image(&_sg.pools, desc->color_attachments[i].image.id);
+                /* FIXME: this shouldn't be an assertion, but result in a SG_RESOURCESTATE_FAILED pass */
+                SOKOL_ASSERT(att_imgs[i] && att_imgs[i]->slot.state == SG_RESOURCESTATE_VALID);
             }
             else {
-                SOKOL_VALIDATE(pip->cmn.depth_format == SG_PIXELFORMAT_NONE, _SG_VALIDATE_APIP_DEPTH_FORMAT);
+                att_imgs[i] = 0;
             }
         }
+        const int ds_att_index = SG_MAX_COLOR_ATTACHMENTS;
+        if (desc->depth_stencil_attachment.image.id) {
+            att_imgs[ds_att_index] = _sg_lookup_image(&_sg.pools, desc->depth_stencil_attachment.image.id);
+            /* FIXME: this shouldn't be an assertion, but result in a SG_RESOURCESTATE_FAILED pass */
+            SOKOL_ASSERT(att_imgs[ds_att_index] && att_imgs[ds_att_index]->slot.state == SG_RESOURCESTATE_VALID);
+        }
         else {
-            /* default pass */
-            SOKOL_VALIDATE(pip->cmn.color_attachment_count == 1, _SG_VALIDATE_APIP_ATT_COUNT);
-            SOKOL_VALIDATE(pip->cmn.color_format == _sg.desc.context.color_format, _SG_VALIDATE_APIP_COLOR_FORMAT);
-            SOKOL_VALIDATE(pip->cmn.depth_format == _sg.desc.context.depth_format, _SG_VALIDATE_APIP_DEPTH_FORMAT);
-            SOKOL_VALIDATE(pip->cmn.sample_count == _sg.desc.context.sample_count, _SG_VALIDATE_APIP_SAMPLE_COUNT);
+            att_imgs[ds_att_index] = 0;
         }
-        return SOKOL_VALIDATE_END();
-    #endif
+        pass->slot.state = _sg_create_pass(pass, att_imgs, desc);
+        _sg_strcpy(&pass->cmn.label, desc->label);
+    }
+    else {
+        pass->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID)||(pass->slot.state == SG_RESOURCESTATE_FAILED));
 }
 
-_SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(bindings);
-        return true;
-    #else
-        SOKOL_VALIDATE_BEGIN();
-
-        /* a pipeline object must have been applied */
-        SOKOL_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, _SG_VALIDATE_ABND_PIPELINE);
-        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
-        SOKOL_VALIDATE(pip != 0, _SG_VALIDATE_ABND_PIPELINE_EXISTS);
-        if (!pip) {
-            return SOKOL_VALIDATE_END();
-        }
-        SOKOL_VALIDATE(pip->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_ABND_PIPELINE_VALID);
-        SOKOL_ASSERT(pip->shader && (pip->cmn.shader_id.id == pip->shader->slot.id));
-
-        /* has expected vertex buffers, and vertex buffers still exist */
-        for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
-            if (bindings->vertex_buffers[i].id != SG_INVALID_ID) {
-                SOKOL_VALIDATE(pip->cmn.vertex_layout_valid[i], _SG_VALIDATE_ABND_VBS);
-                /* buffers in vertex-buffer-slots must be of type SG_BUFFERTYPE_VERTEXBUFFER */
-                const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
-                SOKOL_VALIDATE(buf != 0, _SG_VALIDATE_ABND_VB_EXISTS);
-                if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
-                    SOKOL_VALIDATE(SG_BUFFERTYPE_VERTEXBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_VB_TYPE);
-                    SOKOL_VALIDATE(!buf->cmn.append_overflow, _SG_VALIDATE_ABND_VB_OVERFLOW);
-                }
+_SOKOL_PRIVATE bool _sg_uninit_buffer(sg_buffer buf_id) {
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf) {
+        if (buf->slot.ctx_id == _sg.active_context.id) {
+            if (buf->slot.state == SG_RESOURCESTATE_VALID) {
+                _sg_mem_remove_buffer(buf);
             }
-            else {
-                /* vertex buffer provided in a slot which has no vertex layout in pipeline */
-                SOKOL_VALIDATE(!pip->cmn.vertex_layout_valid[i], _SG_VALIDATE_ABND_VBS);
+            if ((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED)) {
+                _sg_live_del(&_sg.pools, _SG_LIVETYPE_BUFFER, &buf->slot);
             }
+            _sg_destroy_buffer(buf);
+            _sg_reset_buffer(buf);
+            _sg_validate_cache_invalidate();
+            return true;
+        }
+        else {
+            SOKOL_LOG("_sg_uninit_buffer: active context mismatch (must be same as for creation)");
+            _SG_TRACE_NOARGS(err_context_mismatch);
         }
+    }
+    return false;
+}
 
-        /* index buffer expected or not, and index buffer still exists */
-        if (pip->cmn.index_type == SG_INDEXTYPE_NONE) {
-            /* pipeline defines non-indexed rendering, but index buffer provided */
-            SOKOL_VALIDATE(bindings->index_buffer.id == SG_INVALID_ID, _SG_VALIDATE_ABND_IB);
+_SOKOL_PRIVATE bool _sg_uninit_image(sg_image img_id) {
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img) {
+        if (img->slot.ctx_id == _sg.active_context.id) {
+            if (img->slot.state == SG_RESOURCESTATE_VALID) {
+                _sg_mem_remove_image(img);
+            }
+            if ((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED)) {
+                _sg_live_del(&_sg.pools, _SG_LIVETYPE_IMAGE, &img->slot);
+            }
+            _sg_destroy_image(img);
+            _sg_reset_image(img);
+            _sg_validate_cache_invalidate();
+            return true;
         }
         else {
-            /* pipeline defines indexed rendering, but no index buffer provided */
-            SOKOL_VALIDATE(bindings->index_buffer.id != SG_INVALID_ID, _SG_VALIDATE_ABND_NO_IB);
+            SOKOL_LOG("_sg_uninit_image: active context mismatch (must be same as for creation)");
+            _SG_TRACE_NOARGS(err_context_mismatch);
         }
-        if (bindings->index_buffer.id != SG_INVALID_ID) {
-            /* buffer in index-buffer-slot must be of type SG_BUFFERTYPE_INDEXBUFFER */
-            const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
-            SOKOL_VALIDATE(buf != 0, _SG_VALIDATE_ABND_IB_EXISTS);
-            if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
-                SOKOL_VALIDATE(SG_BUFFERTYPE_INDEXBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_IB_TYPE);
-                SOKOL_VALIDATE(!buf->cmn.append_overflow, _SG_VALIDATE_ABND_IB_OVERFLOW);
+    }
+    return false;
+}
+
+_SOKOL_PRIVATE bool _sg_uninit_shader(sg_shader shd_id) {
+    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
+    if (shd) {
+        if (shd->slot.ctx_id == _sg.active_context.id) {
+            if ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED)) {
+                _sg_live_del(&_sg.pools, _SG_LIVETYPE_SHADER, &shd->slot);
             }
+            _sg_destroy_shader(shd);
+            _sg_reset_shader(shd);
+            _sg_validate_cache_invalidate();
+            return true;
+        }
+        else {
+            SOKOL_LOG("_sg_uninit_shader: active context mismatch (must be same as for creation)");
+            _SG_TRACE_NOARGS(err_context_mismatch);
         }
+    }
+    return false;
+}
 
-        /* has expected vertex shader images */
-        for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
-            _sg_shader_stage_t* stage = &pip->shader->cmn.stage[SG_SHADERSTAGE_VS];
-            if (bindings->vs_images[i].id != SG_INVALID_ID) {
-                SOKOL_VALIDATE(i < stage->num_images, _SG_VALIDATE_ABND_VS_IMGS);
-                const _sg_image_t* img = _sg_lookup_image(&_sg.pools, bindings->vs_images[i].id);
-                SOKOL_VALIDATE(img != 0, _SG_VALIDATE_ABND_VS_IMG_EXISTS);
-                if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
-                    SOKOL_VALIDATE(img->cmn.type == stage->images[i].type, _SG_VALIDATE_ABND_VS_IMG_TYPES);
-                }
-            }
-            else {
-                SOKOL_VALIDATE(i >= stage->num_images, _SG_VALIDATE_ABND_VS_IMGS);
+_SOKOL_PRIVATE bool _sg_uninit_pipeline(sg_pipeline pip_id) {
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (pip) {
+        if (pip->slot.ctx_id == _sg.active_context.id) {
+            if ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED)) {
+                _sg_live_del(&_sg.pools, _SG_LIVETYPE_PIPELINE, &pip->slot);
             }
+            _sg_destroy_pipeline(pip);
+            _sg_reset_pipeline(pip);
+            _sg_validate_cache_invalidate();
+            return true;
         }
+        else {
+            SOKOL_LOG("_sg_uninit_pipeline: active context mismatch (must be same as for creation)");
+            _SG_TRACE_NOARGS(err_context_mismatch);
+        }
+    }
+    return false;
+}
 
-        /* has expected fragment shader images */
-        for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
-            _sg_shader_stage_t* stage = &pip->shader->cmn.stage[SG_SHADERSTAGE_FS];
-            if (bindings->fs_images[i].id != SG_INVALID_ID) {
-                SOKOL_VALIDATE(i < stage->num_images, _SG_VALIDATE_ABND_FS_IMGS);
-                const _sg_image_t* img = _sg_lookup_image(&_sg.pools, bindings->fs_images[i].id);
-                SOKOL_VALIDATE(img != 0, _SG_VALIDATE_ABND_FS_IMG_EXISTS);
-                if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
-                    SOKOL_VALIDATE(img->cmn.type == stage->images[i].type, _SG_VALIDATE_ABND_FS_IMG_TYPES);
-                }
-            }
-            else {
-                SOKOL_VALIDATE(i >= stage->num_images, _SG_VALIDATE_ABND_FS_IMGS);
+_SOKOL_PRIVATE bool _sg_uninit_pass(sg_pass pass_id) {
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    if (pass) {
+        if (pass->slot.ctx_id == _sg.active_context.id) {
+            if ((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED)) {
+                _sg_live_del(&_sg.pools, _SG_LIVETYPE_PASS, &pass->slot);
             }
+            _sg_destroy_pass(pass);
+            _sg_reset_pass(pass);
+            return true;
         }
-        return SOKOL_VALIDATE_END();
-    #endif
+        else {
+            SOKOL_LOG("_sg_uninit_pass: active context mismatch (must be same as for creation)");
+            _SG_TRACE_NOARGS(err_context_mismatch);
+        }
+    }
+    return false;
 }
 
-_SOKOL_PRIVATE bool _sg_validate_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
-    _SOKOL_UNUSED(data);
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(stage_index);
-        _SOKOL_UNUSED(ub_index);
-        _SOKOL_UNUSED(num_bytes);
-        return true;
-    #else
-        SOKOL_ASSERT((stage_index == SG_SHADERSTAGE_VS) || (stage_index == SG_SHADERSTAGE_FS));
-        SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, _SG_VALIDATE_AUB_NO_PIPELINE);
-        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
-        SOKOL_ASSERT(pip && (pip->slot.id == _sg.cur_pipeline.id));
-        SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
+/*== DEFERRED DESTRUCTION =====================================================*/
+_SOKOL_PRIVATE void _sg_setup_retire_queue(const sg_desc* desc) {
+    memset(&_sg.retire, 0, sizeof(_sg.retire));
+    if (!desc->deferred_destroy) {
+        return;
+    }
+    /* a slot can only be retired once at a time, but stale items of resources
+       which have been destroyed with their context may stay in the queue
+    */
+    const _sg_pools_t* p = &_sg.pools;
+    _sg.retire.num_slots = 2 * (p->buffer_pool.size + p->image_pool.size + p->shader_pool.size + p->pipeline_pool.size + p->pass_pool.size);
+    const size_t size = (size_t)_sg.retire.num_slots * sizeof(_sg_retire_item_t);
+    _sg.retire.queue = (_sg_retire_item_t*) SOKOL_MALLOC(size);
+    _sg.retire.scratch = (_sg_retire_item_t*) SOKOL_MALLOC(size);
+    SOKOL_ASSERT(_sg.retire.queue && _sg.retire.scratch);
+}
 
-        /* check that there is a uniform block at 'stage' and 'ub_index' */
-        const _sg_shader_stage_t* stage = &pip->shader->cmn.stage[stage_index];
-        SOKOL_VALIDATE(ub_index < stage->num_uniform_blocks, _SG_VALIDATE_AUB_NO_UB_AT_SLOT);
+_SOKOL_PRIVATE void _sg_discard_retire_queue(void) {
+    if (_sg.retire.queue) {
+        SOKOL_FREE(_sg.retire.queue);
+    }
+    if (_sg.retire.scratch) {
+        SOKOL_FREE(_sg.retire.scratch);
+    }
+    memset(&_sg.retire, 0, sizeof(_sg.retire));
+}
 
-        /* check that the provided data size doesn't exceed the uniform block size */
-        SOKOL_VALIDATE(num_bytes <= stage->uniform_blocks[ub_index].size, _SG_VALIDATE_AUB_SIZE);
+_SOKOL_PRIVATE void _sg_retire_push(const _sg_retire_item_t* item) {
+    SOKOL_ASSERT(_sg.retire.num < _sg.retire.num_slots);
+    _sg.retire.queue[_sg.retire.front] = *item;
+    _sg.retire.front = (_sg.retire.front + 1) % _sg.retire.num_slots;
+    _sg.retire.num++;
+}
 
-        return SOKOL_VALIDATE_END();
-    #endif
+/* returns the slot of a retired resource, or 0 if the resource has been destroyed otherwise */
+_SOKOL_PRIVATE _sg_slot_t* _sg_retired_slot(const _sg_retire_item_t* item) {
+    _sg_slot_t* slot = _sg_live_slot(&_sg.pools, item->type, _sg_slot_index(item->res_id));
+    return ((slot->id == item->res_id) && slot->retired) ? slot : 0;
 }
 
-_SOKOL_PRIVATE bool _sg_validate_update_buffer(const _sg_buffer_t* buf, const void* data, int size) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(buf);
-        _SOKOL_UNUSED(data);
-        _SOKOL_UNUSED(size);
-        return true;
+/* sort released items by descending slot index, so that the lowest slot
+   index ends up on top of the pool's free queue and is reused first, this
+   keeps the live resources packed at the start of the pool arrays
+*/
+_SOKOL_PRIVATE int _sg_retire_item_cmp(const void* a, const void* b) {
+    const _sg_retire_item_t* ia = (const _sg_retire_item_t*) a;
+    const _sg_retire_item_t* ib = (const _sg_retire_item_t*) b;
+    if (ia->type != ib->type) {
+        return (int)ia->type - (int)ib->type;
+    }
+    return _sg_slot_index(ib->res_id) - _sg_slot_index(ia->res_id);
+}
+
+/* release retired resources which are no longer used by in-flight frames */
+_SOKOL_PRIVATE void _sg_retire_collect(uint32_t frame_index) {
+    int num = 0;
+    while ((_sg.retire.num > 0) && (frame_index >= _sg.retire.queue[_sg.retire.back].frame_index)) {
+        _sg.retire.scratch[num++] = _sg.retire.queue[_sg.retire.back];
+        _sg.retire.back = (_sg.retire.back + 1) % _sg.retire.num_slots;
+        _sg.retire.num--;
+    }
+    if (num == 0) {
+        return;
+    }
+    qsort(_sg.retire.scratch, (size_t)num, sizeof(_sg_retire_item_t), _sg_retire_item_cmp);
+    for (int i = 0; i < num; i++) {
+        _sg_retire_item_t* item = &_sg.retire.scratch[i];
+        _sg_slot_t* slot = _sg_retired_slot(item);
+        if (0 == slot) {
+            continue;
+        }
+        if (slot->ctx_id == _sg.active_context.id) {
+            _sg_destroy_live_resource(&_sg.pools, item->type, _sg_slot_index(item->res_id));
+        }
+        else {
+            /* must be destroyed under its own context, try again next frame */
+            item->frame_index = frame_index + 1;
+            _sg_retire_push(item);
+        }
+    }
+}
+
+/* called from sg_destroy_*(), returns true if the resource has been retired */
+_SOKOL_PRIVATE bool _sg_retire_resource(_sg_live_type_t type, uint32_t res_id) {
+    if ((0 == _sg.retire.queue) || (SG_INVALID_ID == res_id)) {
+        return false;
+    }
+    _sg_slot_t* slot = 0;
+    switch (type) {
+        case _SG_LIVETYPE_BUFFER:   { _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, res_id); slot = buf ? &buf->slot : 0; } break;
+        case _SG_LIVETYPE_IMAGE:    { _sg_image_t* img = _sg_lookup_image(&_sg.pools, res_id); slot = img ? &img->slot : 0; } break;
+        case _SG_LIVETYPE_SHADER:   { _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, res_id); slot = shd ? &shd->slot : 0; } break;
+        case _SG_LIVETYPE_PIPELINE: { _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, res_id); slot = pip ? &pip->slot : 0; } break;
+        case _SG_LIVETYPE_PASS:     { _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, res_id); slot = pass ? &pass->slot : 0; } break;
+        default: SOKOL_UNREACHABLE; break;
+    }
+    /* resources without 3D-API objects, and context mismatches are handled by the regular destroy path */
+    if ((0 == slot) || (slot->state != SG_RESOURCESTATE_VALID) || (slot->ctx_id != _sg.active_context.id)) {
+        return false;
+    }
+    if (_sg.retire.num == _sg.retire.num_slots) {
+        SOKOL_LOG("deferred destroy queue full, releasing the oldest resource early");
+        _sg_retire_item_t oldest = _sg.retire.queue[_sg.retire.back];
+        _sg.retire.back = (_sg.retire.back + 1) % _sg.retire.num_slots;
+        _sg.retire.num--;
+        _sg_slot_t* oldest_slot = _sg_retired_slot(&oldest);
+        if (oldest_slot) {
+            _sg_destroy_live_resource(&_sg.pools, oldest.type, _sg_slot_index(oldest.res_id));
+        }
+    }
+    /* the resource can no longer be part of a group since the group may be destroyed first */
+    _sg_group_t* grp = _sg_lookup_group(&_sg.pools, slot->group_id);
+    if (grp) {
+        _sg_live_remove(&_sg.pools, &grp->live, type, _sg_slot_index(res_id), true);
+    }
+    slot->group_id = SG_INVALID_ID;
+    slot->retired = true;
+    _sg_retire_item_t item;
+    /* the current frame is only submitted in the next sg_commit(), the extra
+       frame on top of SG_NUM_INFLIGHT_FRAMES covers the frame being recorded
+       (same as the Metal backend's release queue)
+    */
+    item.frame_index = _sg.frame_index + SG_NUM_INFLIGHT_FRAMES + 1;
+    item.res_id = res_id;
+    item.type = type;
+    _sg_retire_push(&item);
+    _sg_validate_cache_invalidate();
+    return true;
+}
+
+/*== PROFILER ================================================================*/
+#if defined(SOKOL_PROFILER)
+_SOKOL_PRIVATE void _sg_profiler_clock_init(void) {
+    #if defined(_WIN32)
+        QueryPerformanceFrequency(&_sg.prof.freq);
+        QueryPerformanceCounter(&_sg.prof.start);
+    #elif defined(__APPLE__) && defined(__MACH__)
+        mach_timebase_info(&_sg.prof.timebase);
+        _sg.prof.start = mach_absolute_time();
+    #elif defined(__EMSCRIPTEN__)
+        _sg.prof.start = emscripten_get_now();
     #else
-        SOKOL_ASSERT(buf && data);
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(buf->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_UPDATEBUF_USAGE);
-        SOKOL_VALIDATE(buf->cmn.size >= size, _SG_VALIDATE_UPDATEBUF_SIZE);
-        SOKOL_VALIDATE(buf->cmn.update_frame_index != _sg.frame_index, _SG_VALIDATE_UPDATEBUF_ONCE);
-        SOKOL_VALIDATE(buf->cmn.append_frame_index != _sg.frame_index, _SG_VALIDATE_UPDATEBUF_APPEND);
-        return SOKOL_VALIDATE_END();
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        _sg.prof.start = (uint64_t)ts.tv_sec*1000000000 + (uint64_t)ts.tv_nsec;
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_append_buffer(const _sg_buffer_t* buf, const void* data, int size) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(buf);
-        _SOKOL_UNUSED(data);
-        _SOKOL_UNUSED(size);
-        return true;
+#if defined(_WIN32) || (defined(__APPLE__) && defined(__MACH__))
+/* prevent 64-bit overflow when converting to nanoseconds */
+_SOKOL_PRIVATE int64_t _sg_profiler_muldiv(int64_t value, int64_t numer, int64_t denom) {
+    int64_t q = value / denom;
+    int64_t r = value % denom;
+    return q * numer + r * numer / denom;
+}
+#endif
+
+/* nanoseconds since sg_setup() */
+_SOKOL_PRIVATE uint64_t _sg_profiler_now(void) {
+    #if defined(_WIN32)
+        LARGE_INTEGER qpc_t;
+        QueryPerformanceCounter(&qpc_t);
+        return (uint64_t) _sg_profiler_muldiv(qpc_t.QuadPart - _sg.prof.start.QuadPart, 1000000000, _sg.prof.freq.QuadPart);
+    #elif defined(__APPLE__) && defined(__MACH__)
+        const uint64_t mach_now = mach_absolute_time() - _sg.prof.start;
+        return (uint64_t) _sg_profiler_muldiv((int64_t)mach_now, _sg.prof.timebase.numer, _sg.prof.timebase.denom);
+    #elif defined(__EMSCRIPTEN__)
+        const double js_now = emscripten_get_now() - _sg.prof.start;
+        return (js_now > 0.0) ? (uint64_t)(js_now * 1000000.0) : 0;
     #else
-        SOKOL_ASSERT(buf && data);
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(buf->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_APPENDBUF_USAGE);
-        SOKOL_VALIDATE(buf->cmn.size >= (buf->cmn.append_pos+size), _SG_VALIDATE_APPENDBUF_SIZE);
-        SOKOL_VALIDATE(buf->cmn.update_frame_index != _sg.frame_index, _SG_VALIDATE_APPENDBUF_UPDATE);
-        return SOKOL_VALIDATE_END();
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ((uint64_t)ts.tv_sec*1000000000 + (uint64_t)ts.tv_nsec) - _sg.prof.start;
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_image_content* data) {
-    #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(img);
-        _SOKOL_UNUSED(data);
-        return true;
-    #else
-        SOKOL_ASSERT(img && data);
-        SOKOL_VALIDATE_BEGIN();
-        SOKOL_VALIDATE(img->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_UPDIMG_USAGE);
-        SOKOL_VALIDATE(img->cmn.upd_frame_index != _sg.frame_index, _SG_VALIDATE_UPDIMG_ONCE);
-        SOKOL_VALIDATE(!_sg_is_compressed_pixel_format(img->cmn.pixel_format), _SG_VALIDATE_UPDIMG_COMPRESSED);
-        const int num_faces = (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1;
-        const int num_mips = img->cmn.num_mipmaps;
-        for (int face_index = 0; face_index < num_faces; face_index++) {
-            for (int mip_index = 0; mip_index < num_mips; mip_index++) {
-                SOKOL_VALIDATE(0 != data->subimage[face_index][mip_index].ptr, _SG_VALIDATE_UPDIMG_NOTENOUGHDATA);
-                const int mip_width = _sg_max(img->cmn.width >> mip_index, 1);
-                const int mip_height = _sg_max(img->cmn.height >> mip_index, 1);
-                const int bytes_per_slice = _sg_surface_pitch(img->cmn.pixel_format, mip_width, mip_height, 1);
-                const int expected_size = bytes_per_slice * img->cmn.num_slices;
-                SOKOL_VALIDATE(data->subimage[face_index][mip_index].size <= expected_size, _SG_VALIDATE_UPDIMG_SIZE);
-            }
+_SOKOL_PRIVATE sg_profiler_node* _sg_profiler_frame_nodes(int frame_index) {
+    SOKOL_ASSERT((frame_index >= 0) && (frame_index < _sg.prof.num_frames));
+    return &_sg.prof.nodes[frame_index * _sg.prof.max_nodes];
+}
+
+_SOKOL_PRIVATE void _sg_profiler_begin_frame(uint64_t now) {
+    sg_profiler_frame* frame = &_sg.prof.frames[_sg.prof.cur_frame];
+    memset(frame, 0, sizeof(sg_profiler_frame));
+    frame->frame_index = _sg.frame_index;
+    frame->start_ns = now;
+    frame->nodes = _sg_profiler_frame_nodes(_sg.prof.cur_frame);
+    _sg.prof.depth = 0;
+    _sg.prof.skip_depth = 0;
+}
+
+_SOKOL_PRIVATE void _sg_setup_profiler(const sg_desc* desc) {
+    SOKOL_ASSERT((desc->profiler_num_frames > 0) && (desc->profiler_max_nodes > 0));
+    memset(&_sg.prof, 0, sizeof(_sg.prof));
+    _sg.prof.num_frames = desc->profiler_num_frames + 1;
+    _sg.prof.max_nodes = desc->profiler_max_nodes;
+    const size_t frames_size = sizeof(sg_profiler_frame) * (size_t)_sg.prof.num_frames;
+    _sg.prof.frames = (sg_profiler_frame*) SOKOL_MALLOC(frames_size);
+    SOKOL_ASSERT(_sg.prof.frames);
+    memset(_sg.prof.frames, 0, frames_size);
+    const size_t nodes_size = sizeof(sg_profiler_node) * (size_t)(_sg.prof.num_frames * _sg.prof.max_nodes);
+    _sg.prof.nodes = (sg_profiler_node*) SOKOL_MALLOC(nodes_size);
+    SOKOL_ASSERT(_sg.prof.nodes);
+    _sg_profiler_clock_init();
+    _sg.prof.valid = true;
+    _sg_profiler_begin_frame(_sg_profiler_now());
+}
+
+_SOKOL_PRIVATE void _sg_discard_profiler(void) {
+    if (_sg.prof.valid) {
+        SOKOL_FREE(_sg.prof.frames);
+        SOKOL_FREE(_sg.prof.nodes);
+        memset(&_sg.prof, 0, sizeof(_sg.prof));
+    }
+}
+
+/* find the node for a pass or group under the current parent node, or create a new one */
+_SOKOL_PRIVATE int _sg_profiler_find_or_add_node(sg_profiler_node_type type, const char* name, sg_pass pass, uint64_t now) {
+    sg_profiler_frame* frame = &_sg.prof.frames[_sg.prof.cur_frame];
+    sg_profiler_node* nodes = _sg_profiler_frame_nodes(_sg.prof.cur_frame);
+    int parent = -1;
+    if (_sg.prof.depth > 0) {
+        parent = _sg.prof.stack[_sg.prof.depth - 1].node;
+        if (parent < 0) {
+            /* the parent node has been dropped */
+            return -1;
         }
-        return SOKOL_VALIDATE_END();
+    }
+    /* nodes entered repeatedly at the same place in the tree are merged */
+    int last = -1;
+    int cur = (parent >= 0) ? nodes[parent].first_child : ((frame->num_nodes > 0) ? 0 : -1);
+    while (cur >= 0) {
+        const sg_profiler_node* node = &nodes[cur];
+        if ((node->type == type) && (node->pass.id == pass.id) && (0 == strncmp(node->name, name, SG_MAX_PROFILER_NAME_SIZE - 1))) {
+            return cur;
+        }
+        last = cur;
+        cur = node->next_sibling;
+    }
+    if (frame->num_nodes >= _sg.prof.max_nodes) {
+        frame->overflow = true;
+        return -1;
+    }
+    const int index = frame->num_nodes++;
+    sg_profiler_node* node = &nodes[index];
+    memset(node, 0, sizeof(sg_profiler_node));
+    node->type = type;
+    #if defined(_MSC_VER)
+    strncpy_s(node->name, SG_MAX_PROFILER_NAME_SIZE, name, (SG_MAX_PROFILER_NAME_SIZE-1));
+    #else
+    strncpy(node->name, name, SG_MAX_PROFILER_NAME_SIZE);
     #endif
+    node->name[SG_MAX_PROFILER_NAME_SIZE-1] = 0;
+    node->pass = pass;
+    node->parent = parent;
+    node->first_child = -1;
+    node->next_sibling = -1;
+    node->depth = _sg.prof.depth;
+    node->start_ns = now;
+    if (last >= 0) {
+        nodes[last].next_sibling = index;
+    }
+    else if (parent >= 0) {
+        nodes[parent].first_child = index;
+    }
+    return index;
 }
 
-/*== fill in desc default values =============================================*/
-_SOKOL_PRIVATE sg_buffer_desc _sg_buffer_desc_defaults(const sg_buffer_desc* desc) {
-    sg_buffer_desc def = *desc;
-    def.type = _sg_def(def.type, SG_BUFFERTYPE_VERTEXBUFFER);
-    def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
-    return def;
+_SOKOL_PRIVATE void _sg_profiler_push(sg_profiler_node_type type, const char* name, sg_pass pass) {
+    SOKOL_ASSERT(name);
+    if (_sg.prof.depth >= _SG_PROFILER_MAX_DEPTH) {
+        _sg.prof.frames[_sg.prof.cur_frame].overflow = true;
+        _sg.prof.skip_depth++;
+        return;
+    }
+    const uint64_t now = _sg_profiler_now();
+    const int node_index = _sg_profiler_find_or_add_node(type, name, pass, now);
+    if (node_index >= 0) {
+        _sg_profiler_frame_nodes(_sg.prof.cur_frame)[node_index].num_calls++;
+    }
+    _sg_profiler_open_t* open = &_sg.prof.stack[_sg.prof.depth++];
+    open->node = node_index;
+    open->start = now;
 }
 
-_SOKOL_PRIVATE sg_image_desc _sg_image_desc_defaults(const sg_image_desc* desc) {
-    sg_image_desc def = *desc;
-    def.type = _sg_def(def.type, SG_IMAGETYPE_2D);
-    def.num_slices = _sg_def(def.num_slices, 1);
-    def.num_mipmaps = _sg_def(def.num_mipmaps, 1);
-    def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
-    if (desc->render_target) {
-        def.pixel_format = _sg_def(def.pixel_format, _sg.desc.context.color_format);
-        def.sample_count = _sg_def(def.sample_count, _sg.desc.context.sample_count);
+_SOKOL_PRIVATE void _sg_profiler_close(uint64_t now) {
+    SOKOL_ASSERT(_sg.prof.depth > 0);
+    const _sg_profiler_open_t* open = &_sg.prof.stack[--_sg.prof.depth];
+    if (open->node >= 0) {
+        _sg_profiler_frame_nodes(_sg.prof.cur_frame)[open->node].duration_ns += now - open->start;
     }
-    else {
-        def.pixel_format = _sg_def(def.pixel_format, SG_PIXELFORMAT_RGBA8);
-        def.sample_count = _sg_def(def.sample_count, 1);
+}
+
+_SOKOL_PRIVATE sg_profiler_node_type _sg_profiler_top_type(void) {
+    SOKOL_ASSERT(_sg.prof.depth > 0);
+    const int node_index = _sg.prof.stack[_sg.prof.depth - 1].node;
+    if (node_index >= 0) {
+        return _sg_profiler_frame_nodes(_sg.prof.cur_frame)[node_index].type;
     }
-    def.min_filter = _sg_def(def.min_filter, SG_FILTER_NEAREST);
-    def.mag_filter = _sg_def(def.mag_filter, SG_FILTER_NEAREST);
-    def.wrap_u = _sg_def(def.wrap_u, SG_WRAP_REPEAT);
-    def.wrap_v = _sg_def(def.wrap_v, SG_WRAP_REPEAT);
-    def.wrap_w = _sg_def(def.wrap_w, SG_WRAP_REPEAT);
-    def.border_color = _sg_def(def.border_color, SG_BORDERCOLOR_OPAQUE_BLACK);
-    def.max_anisotropy = _sg_def(def.max_anisotropy, 1);
-    def.max_lod = _sg_def_flt(def.max_lod, FLT_MAX);
-    return def;
+    /* a dropped node, assume a debug group */
+    return SG_PROFILERNODETYPE_GROUP;
 }
 
-_SOKOL_PRIVATE sg_shader_desc _sg_shader_desc_defaults(const sg_shader_desc* desc) {
-    sg_shader_desc def = *desc;
-    #if defined(SOKOL_METAL)
-        def.vs.entry = _sg_def(def.vs.entry, "_main");
-        def.fs.entry = _sg_def(def.fs.entry, "_main");
-    #else
-        def.vs.entry = _sg_def(def.vs.entry, "main");
-        def.fs.entry = _sg_def(def.fs.entry, "main");
-    #endif
-    #if defined(SOKOL_D3D11)
-        if (def.vs.source) {
-            def.vs.d3d11_target = _sg_def(def.vs.d3d11_target, "vs_4_0");
-        }
-        if (def.fs.source) {
-            def.fs.d3d11_target = _sg_def(def.fs.d3d11_target, "ps_4_0");
-        }
-    #endif
-    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-        sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &def.vs : &def.fs;
-        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
-            sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
-            if (0 == ub_desc->size) {
-                break;
-            }
-            for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
-                sg_shader_uniform_desc* u_desc = &ub_desc->uniforms[u_index];
-                if (u_desc->type == SG_UNIFORMTYPE_INVALID) {
-                    break;
-                }
-                u_desc->array_count = _sg_def(u_desc->array_count, 1);
-            }
-        }
-        for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
-            sg_shader_image_desc* img_desc = &stage_desc->images[img_index];
-            if (img_desc->type == _SG_IMAGETYPE_DEFAULT) {
-                break;
-            }
-            img_desc->sampler_type = _sg_def(img_desc->sampler_type, SG_SAMPLERTYPE_FLOAT);
+_SOKOL_PRIVATE void _sg_profiler_pop_group(void) {
+    if (_sg.prof.skip_depth > 0) {
+        _sg.prof.skip_depth--;
+    }
+    else if ((_sg.prof.depth > 0) && (_sg_profiler_top_type() == SG_PROFILERNODETYPE_GROUP)) {
+        _sg_profiler_close(_sg_profiler_now());
+    }
+}
+
+/* close the current pass, and all debug groups which were left open inside the pass */
+_SOKOL_PRIVATE void _sg_profiler_end_pass(void) {
+    const uint64_t now = _sg_profiler_now();
+    _sg.prof.skip_depth = 0;
+    while (_sg.prof.depth > 0) {
+        const bool is_pass = _sg_profiler_top_type() == SG_PROFILERNODETYPE_PASS;
+        _sg_profiler_close(now);
+        if (is_pass) {
+            break;
         }
     }
-    return def;
 }
 
-_SOKOL_PRIVATE sg_pipeline_desc _sg_pipeline_desc_defaults(const sg_pipeline_desc* desc) {
-    sg_pipeline_desc def = *desc;
+_SOKOL_PRIVATE void _sg_profiler_commit(void) {
+    const uint64_t now = _sg_profiler_now();
+    while (_sg.prof.depth > 0) {
+        _sg_profiler_close(now);
+    }
+    sg_profiler_frame* frame = &_sg.prof.frames[_sg.prof.cur_frame];
+    frame->duration_ns = now - frame->start_ns;
+    frame->valid = true;
+    _sg.prof.cur_frame = (_sg.prof.cur_frame + 1) % _sg.prof.num_frames;
+    _sg_profiler_begin_frame(now);
+}
 
-    def.primitive_type = _sg_def(def.primitive_type, SG_PRIMITIVETYPE_TRIANGLES);
-    def.index_type = _sg_def(def.index_type, SG_INDEXTYPE_NONE);
+_SOKOL_PRIVATE const sg_profiler_frame* _sg_profiler_completed_frame(int frames_ago) {
+    if ((frames_ago < 0) || (frames_ago >= (_sg.prof.num_frames - 1))) {
+        return 0;
+    }
+    const int index = (_sg.prof.cur_frame + _sg.prof.num_frames - 1 - frames_ago) % _sg.prof.num_frames;
+    const sg_profiler_frame* frame = &_sg.prof.frames[index];
+    return frame->valid ? frame : 0;
+}
 
-    def.depth_stencil.stencil_front.fail_op = _sg_def(def.depth_stencil.stencil_front.fail_op, SG_STENCILOP_KEEP);
-    def.depth_stencil.stencil_front.depth_fail_op = _sg_def(def.depth_stencil.stencil_front.depth_fail_op, SG_STENCILOP_KEEP);
-    def.depth_stencil.stencil_front.pass_op = _sg_def(def.depth_stencil.stencil_front.pass_op, SG_STENCILOP_KEEP);
-    def.depth_stencil.stencil_front.compare_func = _sg_def(def.depth_stencil.stencil_front.compare_func, SG_COMPAREFUNC_ALWAYS);
-    def.depth_stencil.stencil_back.fail_op = _sg_def(def.depth_stencil.stencil_back.fail_op, SG_STENCILOP_KEEP);
-    def.depth_stencil.stencil_back.depth_fail_op = _sg_def(def.depth_stencil.stencil_back.depth_fail_op, SG_STENCILOP_KEEP);
-    def.depth_stencil.stencil_back.pass_op = _sg_def(def.depth_stencil.stencil_back.pass_op, SG_STENCILOP_KEEP);
-    def.depth_stencil.stencil_back.compare_func = _sg_def(def.depth_stencil.stencil_back.compare_func, SG_COMPAREFUNC_ALWAYS);
-    def.depth_stencil.depth_compare_func = _sg_def(def.depth_stencil.depth_compare_func, SG_COMPAREFUNC_ALWAYS);
+/* Chrome trace JSON writer, only counts the bytes if ptr is null */
+typedef struct {
+    char* ptr;
+    int pos;
+} _sg_profiler_writer_t;
 
-    def.blend.src_factor_rgb = _sg_def(def.blend.src_factor_rgb, SG_BLENDFACTOR_ONE);
-    def.blend.dst_factor_rgb = _sg_def(def.blend.dst_factor_rgb, SG_BLENDFACTOR_ZERO);
-    def.blend.op_rgb = _sg_def(def.blend.op_rgb, SG_BLENDOP_ADD);
-    def.blend.src_factor_alpha = _sg_def(def.blend.src_factor_alpha, SG_BLENDFACTOR_ONE);
-    def.blend.dst_factor_alpha = _sg_def(def.blend.dst_factor_alpha, SG_BLENDFACTOR_ZERO);
-    def.blend.op_alpha = _sg_def(def.blend.op_alpha, SG_BLENDOP_ADD);
-    if (def.blend.color_write_mask == SG_COLORMASK_NONE) {
-        def.blend.color_write_mask = 0;
+_SOKOL_PRIVATE void _sg_profiler_put_char(_sg_profiler_writer_t* w, char c) {
+    if (w->ptr) {
+        w->ptr[w->pos] = c;
     }
-    else {
-        def.blend.color_write_mask = (uint8_t) _sg_def((sg_color_mask)def.blend.color_write_mask, SG_COLORMASK_RGBA);
+    w->pos++;
+}
+
+_SOKOL_PRIVATE void _sg_profiler_put_str(_sg_profiler_writer_t* w, const char* str) {
+    while (*str) {
+        _sg_profiler_put_char(w, *str++);
     }
-    def.blend.color_attachment_count = _sg_def(def.blend.color_attachment_count, 1);
-    def.blend.color_format = _sg_def(def.blend.color_format, _sg.desc.context.color_format);
-    def.blend.depth_format = _sg_def(def.blend.depth_format, _sg.desc.context.depth_format);
+}
 
-    def.rasterizer.cull_mode = _sg_def(def.rasterizer.cull_mode, SG_CULLMODE_NONE);
-    def.rasterizer.face_winding = _sg_def(def.rasterizer.face_winding, SG_FACEWINDING_CW);
-    def.rasterizer.sample_count = _sg_def(def.rasterizer.sample_count, _sg.desc.context.sample_count);
+_SOKOL_PRIVATE void _sg_profiler_put_json_str(_sg_profiler_writer_t* w, const char* str) {
+    static const char* hex = "0123456789abcdef";
+    _sg_profiler_put_char(w, '"');
+    for (; *str; str++) {
+        const uint8_t c = (uint8_t)*str;
+        if ((c == '"') || (c == '\\')) {
+            _sg_profiler_put_char(w, '\\');
+            _sg_profiler_put_char(w, (char)c);
+        }
+        else if (c < 0x20) {
+            _sg_profiler_put_str(w, "\\u00");
+            _sg_profiler_put_char(w, hex[c >> 4]);
+            _sg_profiler_put_char(w, hex[c & 0xF]);
+        }
+        else {
+            _sg_profiler_put_char(w, (char)c);
+        }
+    }
+    _sg_profiler_put_char(w, '"');
+}
+
+_SOKOL_PRIVATE void _sg_profiler_put_u64(_sg_profiler_writer_t* w, uint64_t val) {
+    char buf[24];
+    int i = 0;
+    do {
+        buf[i++] = (char)('0' + (val % 10));
+        val /= 10;
+    } while (val > 0);
+    while (i > 0) {
+        _sg_profiler_put_char(w, buf[--i]);
+    }
+}
+
+/* Chrome trace timestamps are microseconds, keep nanosecond precision */
+_SOKOL_PRIVATE void _sg_profiler_put_usec(_sg_profiler_writer_t* w, uint64_t ns) {
+    _sg_profiler_put_u64(w, ns / 1000);
+    const uint64_t frac = ns % 1000;
+    _sg_profiler_put_char(w, '.');
+    _sg_profiler_put_char(w, (char)('0' + (frac / 100)));
+    _sg_profiler_put_char(w, (char)('0' + ((frac / 10) % 10)));
+    _sg_profiler_put_char(w, (char)('0' + (frac % 10)));
+}
+
+_SOKOL_PRIVATE void _sg_profiler_put_event(_sg_profiler_writer_t* w, const char* name, const char* cat, uint64_t start_ns, uint64_t duration_ns, const char* arg_name, uint64_t arg_val) {
+    _sg_profiler_put_str(w, "{\"name\":");
+    _sg_profiler_put_json_str(w, name);
+    _sg_profiler_put_str(w, ",\"cat\":\"");
+    _sg_profiler_put_str(w, cat);
+    _sg_profiler_put_str(w, "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":");
+    _sg_profiler_put_usec(w, start_ns);
+    _sg_profiler_put_str(w, ",\"dur\":");
+    _sg_profiler_put_usec(w, duration_ns);
+    _sg_profiler_put_str(w, ",\"args\":{\"");
+    _sg_profiler_put_str(w, arg_name);
+    _sg_profiler_put_str(w, "\":");
+    _sg_profiler_put_u64(w, arg_val);
+    _sg_profiler_put_str(w, "}}");
+}
+
+/* write a chain of sibling nodes and their children inside the parent's time range,
+   a merged node only has a summed duration, so it starts as close as possible to its
+   first call, but after the previous sibling and early enough that the following
+   siblings still fit before the parent's end
+*/
+_SOKOL_PRIVATE void _sg_profiler_write_nodes(_sg_profiler_writer_t* w, const sg_profiler_node* nodes, int first, uint64_t parent_start_ns, uint64_t parent_end_ns) {
+    uint64_t remaining_ns = 0;
+    for (int i = first; i >= 0; i = nodes[i].next_sibling) {
+        remaining_ns += nodes[i].duration_ns;
+    }
+    uint64_t cursor_ns = parent_start_ns;
+    for (int i = first; i >= 0; i = nodes[i].next_sibling) {
+        const sg_profiler_node* node = &nodes[i];
+        const uint64_t limit_ns = ((parent_end_ns - cursor_ns) >= remaining_ns) ? (parent_end_ns - remaining_ns) : cursor_ns;
+        uint64_t start_ns = (node->start_ns < limit_ns) ? node->start_ns : limit_ns;
+        if (start_ns < cursor_ns) {
+            start_ns = cursor_ns;
+        }
+        _sg_profiler_put_char(w, ',');
+        const char* cat = (node->type == SG_PROFILERNODETYPE_PASS) ? "pass" : "group";
+        _sg_profiler_put_event(w, node->name, cat, start_ns, node->duration_ns, "calls", (uint64_t)node->num_calls);
+        _sg_profiler_write_nodes(w, nodes, node->first_child, start_ns, start_ns + node->duration_ns);
+        cursor_ns = start_ns + node->duration_ns;
+        remaining_ns -= node->duration_ns;
+    }
+}
+
+/* write all completed frames, oldest first, merged nodes are written as one event */
+_SOKOL_PRIVATE void _sg_profiler_write_trace(_sg_profiler_writer_t* w) {
+    _sg_profiler_put_str(w, "{\"traceEvents\":[");
+    bool first = true;
+    for (int frames_ago = _sg.prof.num_frames - 2; frames_ago >= 0; frames_ago--) {
+        const sg_profiler_frame* frame = _sg_profiler_completed_frame(frames_ago);
+        if (0 == frame) {
+            continue;
+        }
+        if (!first) {
+            _sg_profiler_put_char(w, ',');
+        }
+        first = false;
+        _sg_profiler_put_event(w, "frame", "frame", frame->start_ns, frame->duration_ns, "frame_index", frame->frame_index);
+        if (frame->num_nodes > 0) {
+            _sg_profiler_write_nodes(w, frame->nodes, 0, frame->start_ns, frame->start_ns + frame->duration_ns);
+        }
+    }
+    _sg_profiler_put_str(w, "],\"displayTimeUnit\":\"ns\"}");
+    _sg_profiler_put_char(w, 0);
+}
+#endif /* SOKOL_PROFILER */
 
-    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
-        sg_vertex_attr_desc* a_desc = &def.layout.attrs[attr_index];
-        if (a_desc->format == SG_VERTEXFORMAT_INVALID) {
-            break;
+/*== ASYNC IMAGE UPLOADS =====================================================*/
+
+/* compute the staging memory layout of an image's subimages, returns
+   the overall size in bytes, base is either a CPU address or an
+   offset into a bound GL pixel unpack buffer
+*/
+_SOKOL_PRIVATE int _sg_upload_layout(const _sg_image_t* img, uintptr_t base, sg_image_content* content) {
+    SOKOL_ASSERT(img && content);
+    memset(content, 0, sizeof(sg_image_content));
+    const int num_faces = (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+    const int num_mips = img->cmn.num_mipmaps;
+    int offset = 0;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < num_mips; mip_index++) {
+            const int mip_width = _sg_max(img->cmn.width >> mip_index, 1);
+            const int mip_height = _sg_max(img->cmn.height >> mip_index, 1);
+            const int bytes_per_slice = _sg_surface_pitch(img->cmn.pixel_format, mip_width, mip_height, 1);
+            const int size = bytes_per_slice * img->cmn.num_slices;
+            content->subimage[face_index][mip_index].ptr = (const void*)(base + (uintptr_t)offset);
+            content->subimage[face_index][mip_index].size = size;
+            offset = _sg_roundup(offset + size, _SG_UPLOAD_ALIGNMENT);
         }
-        SOKOL_ASSERT((a_desc->buffer_index >= 0) && (a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
-        sg_buffer_layout_desc* b_desc = &def.layout.buffers[a_desc->buffer_index];
-        b_desc->step_func = _sg_def(b_desc->step_func, SG_VERTEXSTEP_PER_VERTEX);
-        b_desc->step_rate = _sg_def(b_desc->step_rate, 1);
     }
+    return offset;
+}
 
-    /* resolve vertex layout strides and offsets */
-    int auto_offset[SG_MAX_SHADERSTAGE_BUFFERS];
-    memset(auto_offset, 0, sizeof(auto_offset));
-    bool use_auto_offset = true;
-    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
-        /* to use computed offsets, *all* attr offsets must be 0 */
-        if (def.layout.attrs[attr_index].offset != 0) {
-            use_auto_offset = false;
+_SOKOL_PRIVATE uint8_t* _sg_map_upload_buffer(void) {
+    if (0 == _sg.uploads.mapped) {
+        const int slot = (int)(_sg.frame_index % SG_NUM_INFLIGHT_FRAMES);
+        #if defined(SOKOL_GLCORE33)
+            _sg.uploads.mapped = (uint8_t*) _sg_gl_map_upload_buffer(slot, _sg.desc.upload_buffer_size);
+        #else
+            if (0 == _sg.uploads.buf[slot]) {
+                _sg.uploads.buf[slot] = (uint8_t*) SOKOL_MALLOC((size_t)_sg.desc.upload_buffer_size);
+            }
+            _sg.uploads.mapped = _sg.uploads.buf[slot];
+        #endif
+    }
+    return _sg.uploads.mapped;
+}
+
+_SOKOL_PRIVATE _sg_upload_t* _sg_lookup_upload(uint32_t upload_id) {
+    if ((SG_INVALID_ID != upload_id) && _sg.uploads.items) {
+        _sg_upload_t* upl = &_sg.uploads.items[upload_id % (uint32_t)_sg.uploads.pool_size];
+        if (upl->id == upload_id) {
+            return upl;
         }
     }
-    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
-        sg_vertex_attr_desc* a_desc = &def.layout.attrs[attr_index];
-        if (a_desc->format == SG_VERTEXFORMAT_INVALID) {
-            break;
+    return 0;
+}
+
+_SOKOL_PRIVATE bool _sg_begin_image_upload(_sg_image_t* img, sg_image_upload* upload) {
+    SOKOL_ASSERT(img && upload);
+    if (0 == _sg.uploads.items) {
+        SOKOL_ASSERT(_sg.desc.upload_pool_size > 0);
+        _sg.uploads.pool_size = _sg.desc.upload_pool_size;
+        const size_t pool_byte_size = sizeof(_sg_upload_t) * (size_t)_sg.uploads.pool_size;
+        _sg.uploads.items = (_sg_upload_t*) SOKOL_MALLOC(pool_byte_size);
+        SOKOL_ASSERT(_sg.uploads.items);
+        memset(_sg.uploads.items, 0, pool_byte_size);
+        _sg.uploads.next_id = 1;
+        _sg.uploads.frame_id = 1;
+    }
+    /* all uploads of the current frame must fit into the ring buffer */
+    if ((_sg.uploads.next_id - _sg.uploads.frame_id) >= (uint32_t)_sg.uploads.pool_size) {
+        return false;
+    }
+    sg_image_content layout;
+    const int size = _sg_upload_layout(img, 0, &layout);
+    if ((_sg.uploads.pos + size) > _sg.desc.upload_buffer_size) {
+        return false;
+    }
+    uint8_t* base = _sg_map_upload_buffer();
+    if (0 == base) {
+        return false;
+    }
+    const int offset = _sg.uploads.pos;
+    _sg.uploads.pos += size;
+    _sg_upload_layout(img, (uintptr_t)(base + offset), &layout);
+    for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+        for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+            upload->subimage[face_index][mip_index].ptr = (void*) layout.subimage[face_index][mip_index].ptr;
+            upload->subimage[face_index][mip_index].size = layout.subimage[face_index][mip_index].size;
+        }
+    }
+    const uint32_t upload_id = _sg.uploads.next_id++;
+    _sg_upload_t* upl = &_sg.uploads.items[upload_id % (uint32_t)_sg.uploads.pool_size];
+    upl->id = upload_id;
+    upl->img_id = img->slot.id;
+    upl->state = SG_UPLOADSTATE_PENDING;
+    upl->offset = offset;
+    upload->id = upload_id;
+    /* the upload counts as the image's update for this frame */
+    img->cmn.upd_frame_index = _sg.frame_index;
+    return true;
+}
+
+/* called from sg_commit(), perform all queued uploads of the current frame */
+_SOKOL_PRIVATE void _sg_flush_image_uploads(void) {
+    if (0 == _sg.uploads.mapped) {
+        return;
+    }
+    #if defined(SOKOL_GLCORE33)
+        _sg_gl_unmap_upload_buffer((int)(_sg.frame_index % SG_NUM_INFLIGHT_FRAMES));
+    #endif
+    for (uint32_t upload_id = _sg.uploads.frame_id; upload_id != _sg.uploads.next_id; upload_id++) {
+        _sg_upload_t* upl = &_sg.uploads.items[upload_id % (uint32_t)_sg.uploads.pool_size];
+        SOKOL_ASSERT(upl->id == upload_id);
+        if (SG_UPLOADSTATE_QUEUED == upl->state) {
+            _sg_image_t* img = _sg_lookup_image(&_sg.pools, upl->img_id);
+            if (img && (img->slot.state == SG_RESOURCESTATE_VALID)) {
+                sg_image_content content;
+                #if defined(SOKOL_GLCORE33)
+                    /* with a bound pixel unpack buffer, 'pointers' are buffer offsets */
+                    _sg_upload_layout(img, (uintptr_t)upl->offset, &content);
+                #else
+                    _sg_upload_layout(img, (uintptr_t)(_sg.uploads.mapped + upl->offset), &content);
+                #endif
+                _sg_update_image(img, &content);
+                upl->state = SG_UPLOADSTATE_COMPLETE;
+            }
+            else {
+                upl->state = SG_UPLOADSTATE_FAILED;
+            }
         }
-        SOKOL_ASSERT((a_desc->buffer_index >= 0) && (a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
-        if (use_auto_offset) {
-            a_desc->offset = auto_offset[a_desc->buffer_index];
+        else {
+            /* sg_end_image_upload() wasn't called this frame */
+            SOKOL_ASSERT(SG_UPLOADSTATE_PENDING == upl->state);
+            upl->state = SG_UPLOADSTATE_FAILED;
         }
-        auto_offset[a_desc->buffer_index] += _sg_vertexformat_bytesize(a_desc->format);
     }
-    /* compute vertex strides if needed */
-    for (int buf_index = 0; buf_index < SG_MAX_SHADERSTAGE_BUFFERS; buf_index++) {
-        sg_buffer_layout_desc* l_desc = &def.layout.buffers[buf_index];
-        if (l_desc->stride == 0) {
-            l_desc->stride = auto_offset[buf_index];
+    #if defined(SOKOL_GLCORE33)
+        _sg_gl_unbind_upload_buffer();
+    #endif
+    _sg.uploads.mapped = 0;
+    _sg.uploads.pos = 0;
+    _sg.uploads.frame_id = _sg.uploads.next_id;
+}
+
+_SOKOL_PRIVATE void _sg_discard_image_uploads(void) {
+    #if defined(SOKOL_GLCORE33)
+        _sg_gl_discard_upload_buffers();
+    #endif
+    for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
+        if (_sg.uploads.buf[i]) {
+            SOKOL_FREE(_sg.uploads.buf[i]);
         }
     }
+    if (_sg.uploads.items) {
+        SOKOL_FREE(_sg.uploads.items);
+    }
+    memset(&_sg.uploads, 0, sizeof(_sg.uploads));
+}
+
+/*== THREAD-SAFE RESOURCE CREATION QUEUE =====================================*/
+#if defined(_MSC_VER)
+_SOKOL_PRIVATE uint32_t _sg_atomic_load_u32(volatile uint32_t* ptr) {
+    return (uint32_t) _InterlockedOr((volatile long*)ptr, 0);
+}
+
+_SOKOL_PRIVATE void _sg_atomic_store_u32(volatile uint32_t* ptr, uint32_t val) {
+    _InterlockedExchange((volatile long*)ptr, (long)val);
+}
+
+_SOKOL_PRIVATE bool _sg_atomic_cas_u32(volatile uint32_t* ptr, uint32_t expected, uint32_t desired) {
+    return (long)expected == _InterlockedCompareExchange((volatile long*)ptr, (long)desired, (long)expected);
+}
+
+_SOKOL_PRIVATE void* _sg_atomic_load_ptr(void* volatile* ptr) {
+    return _InterlockedCompareExchangePointer(ptr, 0, 0);
+}
+
+_SOKOL_PRIVATE bool _sg_atomic_cas_ptr(void* volatile* ptr, void* expected, void* desired) {
+    return expected == _InterlockedCompareExchangePointer(ptr, desired, expected);
+}
+
+_SOKOL_PRIVATE void* _sg_atomic_exchange_ptr(void* volatile* ptr, void* val) {
+    return _InterlockedExchangePointer(ptr, val);
+}
+#else
+_SOKOL_PRIVATE uint32_t _sg_atomic_load_u32(volatile uint32_t* ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
 
-    return def;
+_SOKOL_PRIVATE void _sg_atomic_store_u32(volatile uint32_t* ptr, uint32_t val) {
+    __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
 }
 
-_SOKOL_PRIVATE sg_pass_desc _sg_pass_desc_defaults(const sg_pass_desc* desc) {
-    /* FIXME: no values to replace in sg_pass_desc? */
-    sg_pass_desc def = *desc;
-    return def;
+_SOKOL_PRIVATE bool _sg_atomic_cas_u32(volatile uint32_t* ptr, uint32_t expected, uint32_t desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
 }
 
-/*== allocate/initialize resource private functions ==========================*/
-_SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
-    sg_buffer res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.buffer_pool);
-    if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &_sg.pools.buffers[slot_index].slot, slot_index);
-    }
-    else {
-        /* pool is exhausted */
-        res.id = SG_INVALID_ID;
-    }
-    return res;
+_SOKOL_PRIVATE void* _sg_atomic_load_ptr(void* volatile* ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
 }
 
-_SOKOL_PRIVATE sg_image _sg_alloc_image(void) {
-    sg_image res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.image_pool);
-    if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &_sg.pools.images[slot_index].slot, slot_index);
-    }
-    else {
-        /* pool is exhausted */
-        res.id = SG_INVALID_ID;
-    }
-    return res;
+_SOKOL_PRIVATE bool _sg_atomic_cas_ptr(void* volatile* ptr, void* expected, void* desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
 }
 
-_SOKOL_PRIVATE sg_shader _sg_alloc_shader(void) {
-    sg_shader res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.shader_pool);
-    if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &_sg.pools.shaders[slot_index].slot, slot_index);
-    }
-    else {
-        /* pool is exhausted */
-        res.id = SG_INVALID_ID;
-    }
-    return res;
+_SOKOL_PRIVATE void* _sg_atomic_exchange_ptr(void* volatile* ptr, void* val) {
+    return __atomic_exchange_n(ptr, val, __ATOMIC_ACQ_REL);
 }
+#endif
 
-_SOKOL_PRIVATE sg_pipeline _sg_alloc_pipeline(void) {
-    sg_pipeline res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.pipeline_pool);
-    if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id =_sg_slot_alloc(&_sg.pools.pipeline_pool, &_sg.pools.pipelines[slot_index].slot, slot_index);
-    }
-    else {
-        /* pool is exhausted */
-        res.id = SG_INVALID_ID;
+_SOKOL_PRIVATE void _sg_init_reserve_ring(_sg_reserve_ring_t* ring, int num) {
+    SOKOL_ASSERT(ring && (num > 0));
+    uint32_t size = 1;
+    while (size < (uint32_t)num) {
+        size <<= 1;
     }
-    return res;
+    ring->size = size;
+    const size_t ids_byte_size = sizeof(uint32_t) * size;
+    ring->ids = (uint32_t*) SOKOL_MALLOC(ids_byte_size);
+    SOKOL_ASSERT(ring->ids);
+    memset(ring->ids, 0, ids_byte_size);
+    ring->head = 0;
+    ring->tail = 0;
 }
 
-_SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
-    sg_pass res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.pass_pool);
-    if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &_sg.pools.passes[slot_index].slot, slot_index);
+_SOKOL_PRIVATE void _sg_discard_reserve_ring(_sg_reserve_ring_t* ring) {
+    SOKOL_ASSERT(ring);
+    if (ring->ids) {
+        SOKOL_FREE(ring->ids);
     }
-    else {
-        /* pool is exhausted */
-        res.id = SG_INVALID_ID;
+    memset(ring, 0, sizeof(_sg_reserve_ring_t));
+}
+
+/* called from any thread, returns SG_INVALID_ID if the ring is empty */
+_SOKOL_PRIVATE uint32_t _sg_reserve_ring_take(_sg_reserve_ring_t* ring) {
+    const uint32_t mask = ring->size - 1;
+    for (;;) {
+        const uint32_t head = _sg_atomic_load_u32(&ring->head);
+        const uint32_t tail = _sg_atomic_load_u32(&ring->tail);
+        if (head == tail) {
+            return SG_INVALID_ID;
+        }
+        /* the render thread only overwrites this item after head has moved past it,
+           in that case the compare-exchange fails and the loop starts over
+        */
+        const uint32_t id = _sg_atomic_load_u32(&ring->ids[head & mask]);
+        if (_sg_atomic_cas_u32(&ring->head, head, head + 1)) {
+            return id;
+        }
     }
-    return res;
 }
 
-_SOKOL_PRIVATE void _sg_dealloc_buffer(sg_buffer buf_id) {
-    SOKOL_ASSERT(buf_id.id != SG_INVALID_ID);
-    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
-    SOKOL_ASSERT(buf && buf->slot.state == SG_RESOURCESTATE_ALLOC);
-    _sg_reset_slot(&buf->slot);
-    _sg_pool_free_index(&_sg.pools.buffer_pool, _sg_slot_index(buf_id.id));
+/* called on the render thread only */
+_SOKOL_PRIVATE bool _sg_reserve_ring_full(_sg_reserve_ring_t* ring) {
+    return (ring->tail - _sg_atomic_load_u32(&ring->head)) >= ring->size;
 }
 
-_SOKOL_PRIVATE void _sg_dealloc_image(sg_image img_id) {
-    SOKOL_ASSERT(img_id.id != SG_INVALID_ID);
-    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
-    SOKOL_ASSERT(img && img->slot.state == SG_RESOURCESTATE_ALLOC);
-    _sg_reset_slot(&img->slot);
-    _sg_pool_free_index(&_sg.pools.image_pool, _sg_slot_index(img_id.id));
+_SOKOL_PRIVATE void _sg_reserve_ring_put(_sg_reserve_ring_t* ring, uint32_t id) {
+    SOKOL_ASSERT(!_sg_reserve_ring_full(ring));
+    const uint32_t tail = ring->tail;
+    _sg_atomic_store_u32(&ring->ids[tail & (ring->size - 1)], id);
+    _sg_atomic_store_u32(&ring->tail, tail + 1);
 }
 
-_SOKOL_PRIVATE void _sg_dealloc_shader(sg_shader shd_id) {
-    SOKOL_ASSERT(shd_id.id != SG_INVALID_ID);
-    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
-    SOKOL_ASSERT(shd && shd->slot.state == SG_RESOURCESTATE_ALLOC);
-    _sg_reset_slot(&shd->slot);
-    _sg_pool_free_index(&_sg.pools.shader_pool, _sg_slot_index(shd_id.id));
+_SOKOL_PRIVATE void _sg_refill_reserve_rings(void) {
+    while (!_sg_reserve_ring_full(&_sg.init_queue.buffers)) {
+        sg_buffer buf = _sg_alloc_buffer();
+        if (SG_INVALID_ID == buf.id) {
+            break;
+        }
+        _sg_reserve_ring_put(&_sg.init_queue.buffers, buf.id);
+    }
+    while (!_sg_reserve_ring_full(&_sg.init_queue.images)) {
+        sg_image img = _sg_alloc_image();
+        if (SG_INVALID_ID == img.id) {
+            break;
+        }
+        _sg_reserve_ring_put(&_sg.init_queue.images, img.id);
+    }
 }
 
-_SOKOL_PRIVATE void _sg_dealloc_pipeline(sg_pipeline pip_id) {
-    SOKOL_ASSERT(pip_id.id != SG_INVALID_ID);
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    SOKOL_ASSERT(pip && pip->slot.state == SG_RESOURCESTATE_ALLOC);
-    _sg_reset_slot(&pip->slot);
-    _sg_pool_free_index(&_sg.pools.pipeline_pool, _sg_slot_index(pip_id.id));
+_SOKOL_PRIVATE void _sg_setup_init_queue(const sg_desc* desc) {
+    SOKOL_ASSERT(desc && (desc->reserve_pool_size >= 0));
+    if (desc->reserve_pool_size > 0) {
+        _sg_init_reserve_ring(&_sg.init_queue.buffers, desc->reserve_pool_size);
+        _sg_init_reserve_ring(&_sg.init_queue.images, desc->reserve_pool_size);
+    }
+    _sg.init_queue.incoming = 0;
+    _sg.init_queue.pending_first = 0;
+    _sg.init_queue.pending_last = 0;
 }
 
-_SOKOL_PRIVATE void _sg_dealloc_pass(sg_pass pass_id) {
-    SOKOL_ASSERT(pass_id.id != SG_INVALID_ID);
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    SOKOL_ASSERT(pass && pass->slot.state == SG_RESOURCESTATE_ALLOC);
-    _sg_reset_slot(&pass->slot);
-    _sg_pool_free_index(&_sg.pools.pass_pool, _sg_slot_index(pass_id.id));
+_SOKOL_PRIVATE void _sg_free_init_requests(_sg_init_request_t* req) {
+    while (req) {
+        _sg_init_request_t* next = req->next;
+        SOKOL_FREE(req);
+        req = next;
+    }
 }
 
-_SOKOL_PRIVATE void _sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
-    SOKOL_ASSERT(buf_id.id != SG_INVALID_ID && desc);
-    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
-    SOKOL_ASSERT(buf && buf->slot.state == SG_RESOURCESTATE_ALLOC);
-    buf->slot.ctx_id = _sg.active_context.id;
-    if (_sg_validate_buffer_desc(desc)) {
-        buf->slot.state = _sg_create_buffer(buf, desc);
+_SOKOL_PRIVATE void _sg_discard_init_queue(void) {
+    _sg_free_init_requests((_sg_init_request_t*) _sg_atomic_exchange_ptr(&_sg.init_queue.incoming, 0));
+    _sg_free_init_requests(_sg.init_queue.pending_first);
+    _sg_discard_reserve_ring(&_sg.init_queue.buffers);
+    _sg_discard_reserve_ring(&_sg.init_queue.images);
+    memset(&_sg.init_queue, 0, sizeof(_sg.init_queue));
+}
+
+/* allocate a request with room for the content data and label string */
+_SOKOL_PRIVATE _sg_init_request_t* _sg_alloc_init_request(_sg_init_request_type_t type, uint32_t id, int num_bytes, const char* label, uint8_t** out_data, const char** out_label) {
+    const int header_size = _sg_roundup((int)sizeof(_sg_init_request_t), _SG_INIT_REQUEST_ALIGNMENT);
+    const int label_size = label ? ((int)strlen(label) + 1) : 0;
+    _sg_init_request_t* req = (_sg_init_request_t*) SOKOL_MALLOC((size_t)(header_size + num_bytes + label_size));
+    if (0 == req) {
+        return 0;
+    }
+    memset(req, 0, sizeof(_sg_init_request_t));
+    req->type = type;
+    req->id = id;
+    req->num_bytes = num_bytes;
+    *out_data = ((uint8_t*)req) + header_size;
+    if (label) {
+        char* dst_label = (char*)(*out_data + num_bytes);
+        memcpy(dst_label, label, (size_t)label_size);
+        *out_label = dst_label;
     }
     else {
-        buf->slot.state = SG_RESOURCESTATE_FAILED;
+        *out_label = 0;
     }
-    SOKOL_ASSERT((buf->slot.state == SG_RESOURCESTATE_VALID)||(buf->slot.state == SG_RESOURCESTATE_FAILED));
+    return req;
 }
 
-_SOKOL_PRIVATE void _sg_init_image(sg_image img_id, const sg_image_desc* desc) {
-    SOKOL_ASSERT(img_id.id != SG_INVALID_ID && desc);
-    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
-    SOKOL_ASSERT(img && img->slot.state == SG_RESOURCESTATE_ALLOC);
-    img->slot.ctx_id = _sg.active_context.id;
-    if (_sg_validate_image_desc(desc)) {
-        img->slot.state = _sg_create_image(img, desc);
+/* push a request from any thread */
+_SOKOL_PRIVATE void _sg_push_init_request(_sg_init_request_t* req) {
+    void* head;
+    do {
+        head = _sg_atomic_load_ptr(&_sg.init_queue.incoming);
+        req->next = (_sg_init_request_t*) head;
+    } while (!_sg_atomic_cas_ptr(&_sg.init_queue.incoming, head, req));
+}
+
+_SOKOL_PRIVATE bool _sg_enqueue_init_buffer(uint32_t buf_id, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(desc);
+    const int num_bytes = (desc->content && (desc->size > 0)) ? desc->size : 0;
+    uint8_t* data = 0;
+    const char* label = 0;
+    _sg_init_request_t* req = _sg_alloc_init_request(_SG_INITREQUEST_BUFFER, buf_id, num_bytes, desc->label, &data, &label);
+    if (0 == req) {
+        return false;
     }
-    else {
-        img->slot.state = SG_RESOURCESTATE_FAILED;
+    req->desc.buf = *desc;
+    if (num_bytes > 0) {
+        memcpy(data, desc->content, (size_t)num_bytes);
+        req->desc.buf.content = data;
     }
-    SOKOL_ASSERT((img->slot.state == SG_RESOURCESTATE_VALID)||(img->slot.state == SG_RESOURCESTATE_FAILED));
+    req->desc.buf.label = label;
+    _sg_push_init_request(req);
+    return true;
 }
 
-_SOKOL_PRIVATE void _sg_init_shader(sg_shader shd_id, const sg_shader_desc* desc) {
-    SOKOL_ASSERT(shd_id.id != SG_INVALID_ID && desc);
-    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
-    SOKOL_ASSERT(shd && shd->slot.state == SG_RESOURCESTATE_ALLOC);
-    shd->slot.ctx_id = _sg.active_context.id;
-    if (_sg_validate_shader_desc(desc)) {
-        shd->slot.state = _sg_create_shader(shd, desc);
+_SOKOL_PRIVATE bool _sg_enqueue_init_image(uint32_t img_id, const sg_image_desc* desc) {
+    SOKOL_ASSERT(desc);
+    int num_bytes = 0;
+    for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+        for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+            const sg_subimage_content* sub = &desc->content.subimage[face_index][mip_index];
+            if (sub->ptr && (sub->size > 0)) {
+                num_bytes += _sg_roundup(sub->size, _SG_INIT_REQUEST_ALIGNMENT);
+            }
+        }
     }
-    else {
-        shd->slot.state = SG_RESOURCESTATE_FAILED;
+    uint8_t* data = 0;
+    const char* label = 0;
+    _sg_init_request_t* req = _sg_alloc_init_request(_SG_INITREQUEST_IMAGE, img_id, num_bytes, desc->label, &data, &label);
+    if (0 == req) {
+        return false;
     }
-    SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID)||(shd->slot.state == SG_RESOURCESTATE_FAILED));
+    req->desc.img = *desc;
+    for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+        for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+            sg_subimage_content* sub = &req->desc.img.content.subimage[face_index][mip_index];
+            if (sub->ptr && (sub->size > 0)) {
+                memcpy(data, sub->ptr, (size_t)sub->size);
+                sub->ptr = data;
+                data += _sg_roundup(sub->size, _SG_INIT_REQUEST_ALIGNMENT);
+            }
+        }
+    }
+    req->desc.img.label = label;
+    _sg_push_init_request(req);
+    return true;
 }
 
-_SOKOL_PRIVATE void _sg_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc* desc) {
-    SOKOL_ASSERT(pip_id.id != SG_INVALID_ID && desc);
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    SOKOL_ASSERT(pip && pip->slot.state == SG_RESOURCESTATE_ALLOC);
-    pip->slot.ctx_id = _sg.active_context.id;
-    if (_sg_validate_pipeline_desc(desc)) {
-        _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
-        if (shd && (shd->slot.state == SG_RESOURCESTATE_VALID)) {
-            pip->slot.state = _sg_create_pipeline(pip, shd, desc);
+/* render thread: initialize queued resources in submission order until
+   max_bytes of content data have been processed (but at least one resource)
+*/
+_SOKOL_PRIVATE int _sg_process_init_queue(int max_bytes) {
+    /* move new requests from the LIFO to the end of the pending FIFO */
+    _sg_init_request_t* req = (_sg_init_request_t*) _sg_atomic_exchange_ptr(&_sg.init_queue.incoming, 0);
+    _sg_init_request_t* first = 0;
+    _sg_init_request_t* last = req;
+    while (req) {
+        _sg_init_request_t* next = req->next;
+        req->next = first;
+        first = req;
+        req = next;
+    }
+    if (first) {
+        if (_sg.init_queue.pending_last) {
+            _sg.init_queue.pending_last->next = first;
         }
         else {
-            pip->slot.state = SG_RESOURCESTATE_FAILED;
+            _sg.init_queue.pending_first = first;
         }
+        _sg.init_queue.pending_last = last;
     }
-    else {
-        pip->slot.state = SG_RESOURCESTATE_FAILED;
+
+    int num_processed = 0;
+    int num_bytes = 0;
+    while (_sg.init_queue.pending_first) {
+        req = _sg.init_queue.pending_first;
+        if ((num_processed > 0) && ((num_bytes + req->num_bytes) > max_bytes)) {
+            break;
+        }
+        _sg.init_queue.pending_first = req->next;
+        if (0 == _sg.init_queue.pending_first) {
+            _sg.init_queue.pending_last = 0;
+        }
+        /* skip resources which have been initialized in the meantime */
+        switch (req->type) {
+            case _SG_INITREQUEST_BUFFER:
+                {
+                    sg_buffer buf_id = { req->id };
+                    if (SG_RESOURCESTATE_ALLOC == sg_query_buffer_state(buf_id)) {
+                        sg_init_buffer(buf_id, &req->desc.buf);
+                    }
+                }
+                break;
+            case _SG_INITREQUEST_IMAGE:
+                {
+                    sg_image img_id = { req->id };
+                    if (SG_RESOURCESTATE_ALLOC == sg_query_image_state(img_id)) {
+                        sg_init_image(img_id, &req->desc.img);
+                    }
+                }
+                break;
+            default:
+                SOKOL_UNREACHABLE;
+                break;
+        }
+        num_bytes += req->num_bytes;
+        num_processed++;
+        SOKOL_FREE(req);
     }
-    SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID)||(pip->slot.state == SG_RESOURCESTATE_FAILED));
+    return num_processed;
 }
 
-_SOKOL_PRIVATE void _sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
-    SOKOL_ASSERT(pass_id.id != SG_INVALID_ID && desc);
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    SOKOL_ASSERT(pass && pass->slot.state == SG_RESOURCESTATE_ALLOC);
-    pass->slot.ctx_id = _sg.active_context.id;
-    if (_sg_validate_pass_desc(desc)) {
-        /* lookup pass attachment image pointers */
-        _sg_image_t* att_imgs[SG_MAX_COLOR_ATTACHMENTS + 1];
-        for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
-            if (desc->color_attachments[i].image.id) {
-                att_imgs[i] = _sg_lookup_image(&_sg.pools, desc->color_attachments[i].image.id);
-                /* FIXME: this shouldn't be an assertion, but result in a SG_RESOURCESTATE_FAILED pass */
-                SOKOL_ASSERT(att_imgs[i] && att_imgs[i]->slot.state == SG_RESOURCESTATE_VALID);
-            }
-            else {
-                att_imgs[i] = 0;
-            }
-        }
-        const int ds_att_index = SG_MAX_COLOR_ATTACHMENTS;
-        if (desc->depth_stencil_attachment.image.id) {
-            att_imgs[ds_att_index] = _sg_lookup_image(&_sg.pools, desc->depth_stencil_attachment.image.id);
-            /* FIXME: this shouldn't be an assertion, but result in a SG_RESOURCESTATE_FAILED pass */
-            SOKOL_ASSERT(att_imgs[ds_att_index] && att_imgs[ds_att_index]->slot.state == SG_RESOURCESTATE_VALID);
+/*== PIPELINE WARM-UP ========================================================*/
+#define _SG_WARMUP_VERSION (1)
+
+typedef struct {
+    _sg_warmup_buf_t* buf;  /* if not null, encode into buf */
+    const uint8_t* ptr;     /* otherwise decode from ptr..end */
+    const uint8_t* end;
+    bool error;
+} _sg_warmup_stream_t;
+
+_SOKOL_PRIVATE void _sg_warmup_buf_reserve(_sg_warmup_buf_t* buf, int num_bytes) {
+    if ((buf->size + num_bytes) > buf->cap) {
+        int new_cap = _sg_max(buf->cap * 2, 1024);
+        while (new_cap < (buf->size + num_bytes)) {
+            new_cap *= 2;
         }
-        else {
-            att_imgs[ds_att_index] = 0;
+        uint8_t* new_ptr = (uint8_t*) SOKOL_MALLOC((size_t)new_cap);
+        SOKOL_ASSERT(new_ptr);
+        if (buf->ptr) {
+            memcpy(new_ptr, buf->ptr, (size_t)buf->size);
+            SOKOL_FREE(buf->ptr);
         }
-        pass->slot.state = _sg_create_pass(pass, att_imgs, desc);
+        buf->ptr = new_ptr;
+        buf->cap = new_cap;
     }
-    else {
-        pass->slot.state = SG_RESOURCESTATE_FAILED;
+}
+
+_SOKOL_PRIVATE void _sg_warmup_buf_append(_sg_warmup_buf_t* buf, const void* data, int num_bytes) {
+    _sg_warmup_buf_reserve(buf, num_bytes);
+    memcpy(buf->ptr + buf->size, data, (size_t)num_bytes);
+    buf->size += num_bytes;
+}
+
+_SOKOL_PRIVATE void _sg_warmup_buf_discard(_sg_warmup_buf_t* buf) {
+    if (buf->ptr) {
+        SOKOL_FREE(buf->ptr);
     }
-    SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID)||(pass->slot.state == SG_RESOURCESTATE_FAILED));
+    memset(buf, 0, sizeof(_sg_warmup_buf_t));
 }
 
-_SOKOL_PRIVATE bool _sg_uninit_buffer(sg_buffer buf_id) {
-    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
-    if (buf) {
-        if (buf->slot.ctx_id == _sg.active_context.id) {
-            _sg_destroy_buffer(buf);
-            _sg_reset_buffer(buf);
-            return true;
+_SOKOL_PRIVATE void _sg_warmup_put_varint(_sg_warmup_buf_t* buf, uint32_t val) {
+    uint8_t bytes[5];
+    int num = 0;
+    do {
+        bytes[num] = (uint8_t)(val & 0x7F);
+        val >>= 7;
+        if (val) {
+            bytes[num] |= 0x80;
         }
-        else {
-            SOKOL_LOG("_sg_uninit_buffer: active context mismatch (must be same as for creation)");
-            _SG_TRACE_NOARGS(err_context_mismatch);
+        num++;
+    } while (val);
+    _sg_warmup_buf_append(buf, bytes, num);
+}
+
+_SOKOL_PRIVATE uint32_t _sg_warmup_get_varint(_sg_warmup_stream_t* s) {
+    uint32_t val = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (s->ptr >= s->end) {
+            s->error = true;
+            return 0;
+        }
+        const uint8_t b = *s->ptr++;
+        val |= (uint32_t)(b & 0x7F) << shift;
+        if (0 == (b & 0x80)) {
+            return val;
         }
     }
-    return false;
+    s->error = true;
+    return 0;
 }
 
-_SOKOL_PRIVATE bool _sg_uninit_image(sg_image img_id) {
-    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
-    if (img) {
-        if (img->slot.ctx_id == _sg.active_context.id) {
-            _sg_destroy_image(img);
-            _sg_reset_image(img);
-            return true;
+/* encode or decode a 1- or 4-byte field */
+_SOKOL_PRIVATE void _sg_warmup_field(_sg_warmup_stream_t* s, void* ptr, int size, bool is_bool) {
+    SOKOL_ASSERT((size == 1) || (size == 4));
+    if (s->buf) {
+        uint32_t val = 0;
+        if (size == 1) {
+            uint8_t u8;
+            memcpy(&u8, ptr, 1);
+            val = u8;
         }
         else {
-            SOKOL_LOG("_sg_uninit_image: active context mismatch (must be same as for creation)");
-            _SG_TRACE_NOARGS(err_context_mismatch);
+            memcpy(&val, ptr, 4);
+        }
+        _sg_warmup_put_varint(s->buf, val);
+    }
+    else {
+        uint32_t val = _sg_warmup_get_varint(s);
+        if (size == 1) {
+            if ((val > 0xFF) || (is_bool && (val > 1))) {
+                s->error = true;
+                val = 0;
+            }
+            const uint8_t u8 = (uint8_t)val;
+            memcpy(ptr, &u8, 1);
+        }
+        else {
+            memcpy(ptr, &val, 4);
+        }
+    }
+}
+#define _sg_warmup_val(s, field) _sg_warmup_field(s, &(field), (int)sizeof(field), false)
+#define _sg_warmup_bool(s, field) _sg_warmup_field(s, &(field), (int)sizeof(field), true)
+
+_SOKOL_PRIVATE void _sg_warmup_stencil_state(_sg_warmup_stream_t* s, sg_stencil_state* st) {
+    _sg_warmup_val(s, st->fail_op);
+    _sg_warmup_val(s, st->depth_fail_op);
+    _sg_warmup_val(s, st->pass_op);
+    _sg_warmup_val(s, st->compare_func);
+}
+
+/* encode or decode everything in a pipeline desc except the shader and label */
+_SOKOL_PRIVATE void _sg_warmup_pipeline_desc(_sg_warmup_stream_t* s, sg_pipeline_desc* desc) {
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        sg_buffer_layout_desc* l = &desc->layout.buffers[i];
+        _sg_warmup_val(s, l->stride);
+        _sg_warmup_val(s, l->step_func);
+        _sg_warmup_val(s, l->step_rate);
+    }
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        sg_vertex_attr_desc* a = &desc->layout.attrs[i];
+        _sg_warmup_val(s, a->buffer_index);
+        _sg_warmup_val(s, a->offset);
+        _sg_warmup_val(s, a->format);
+    }
+    _sg_warmup_val(s, desc->primitive_type);
+    _sg_warmup_val(s, desc->index_type);
+    sg_depth_stencil_state* ds = &desc->depth_stencil;
+    _sg_warmup_stencil_state(s, &ds->stencil_front);
+    _sg_warmup_stencil_state(s, &ds->stencil_back);
+    _sg_warmup_val(s, ds->depth_compare_func);
+    _sg_warmup_bool(s, ds->depth_write_enabled);
+    _sg_warmup_bool(s, ds->stencil_enabled);
+    _sg_warmup_val(s, ds->stencil_read_mask);
+    _sg_warmup_val(s, ds->stencil_write_mask);
+    _sg_warmup_val(s, ds->stencil_ref);
+    sg_blend_state* bs = &desc->blend;
+    _sg_warmup_bool(s, bs->enabled);
+    _sg_warmup_val(s, bs->src_factor_rgb);
+    _sg_warmup_val(s, bs->dst_factor_rgb);
+    _sg_warmup_val(s, bs->op_rgb);
+    _sg_warmup_val(s, bs->src_factor_alpha);
+    _sg_warmup_val(s, bs->dst_factor_alpha);
+    _sg_warmup_val(s, bs->op_alpha);
+    _sg_warmup_val(s, bs->color_write_mask);
+    _sg_warmup_val(s, bs->color_attachment_count);
+    _sg_warmup_val(s, bs->color_format);
+    _sg_warmup_val(s, bs->depth_format);
+    for (int i = 0; i < 4; i++) {
+        _sg_warmup_val(s, bs->blend_color[i]);
+    }
+    sg_rasterizer_state* rs = &desc->rasterizer;
+    _sg_warmup_bool(s, rs->alpha_to_coverage_enabled);
+    _sg_warmup_val(s, rs->cull_mode);
+    _sg_warmup_val(s, rs->face_winding);
+    _sg_warmup_val(s, rs->sample_count);
+    _sg_warmup_val(s, rs->depth_bias);
+    _sg_warmup_val(s, rs->depth_bias_slope_scale);
+    _sg_warmup_val(s, rs->depth_bias_clamp);
+}
+
+/* encode a pipeline desc into a record, returns false if the shader isn't valid */
+_SOKOL_PRIVATE bool _sg_warmup_encode(_sg_warmup_buf_t* buf, const sg_pipeline_desc* desc) {
+    const _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
+    if (!shd || (shd->slot.state != SG_RESOURCESTATE_VALID)) {
+        return false;
+    }
+    uint8_t hash_bytes[8];
+    for (int i = 0; i < 8; i++) {
+        hash_bytes[i] = (uint8_t)(shd->cmn.hash >> (i * 8));
+    }
+    _sg_warmup_buf_append(buf, hash_bytes, 8);
+    _sg_warmup_stream_t s;
+    memset(&s, 0, sizeof(s));
+    s.buf = buf;
+    sg_pipeline_desc tmp = *desc;
+    _sg_warmup_pipeline_desc(&s, &tmp);
+    return true;
+}
+
+/* decode a record into a pipeline desc, without the shader */
+_SOKOL_PRIVATE bool _sg_warmup_decode(const uint8_t* ptr, int size, uint64_t* out_shader_hash, sg_pipeline_desc* out_desc) {
+    if (size < 8) {
+        return false;
+    }
+    uint64_t hash = 0;
+    for (int i = 0; i < 8; i++) {
+        hash |= (uint64_t)ptr[i] << (i * 8);
+    }
+    *out_shader_hash = hash;
+    _sg_warmup_stream_t s;
+    memset(&s, 0, sizeof(s));
+    s.ptr = ptr + 8;
+    s.end = ptr + size;
+    memset(out_desc, 0, sizeof(sg_pipeline_desc));
+    _sg_warmup_pipeline_desc(&s, out_desc);
+    return !s.error && (s.ptr == s.end);
+}
+
+_SOKOL_PRIVATE sg_shader _sg_warmup_find_shader(uint64_t hash) {
+    sg_shader res = { SG_INVALID_ID };
+    const _sg_pool_t* pool = &_sg.pools.shader_pool;
+    for (int i = 1; i < pool->size; i++) {
+        const _sg_shader_t* shd = &_sg.pools.shaders[i];
+        if ((shd->slot.state == SG_RESOURCESTATE_VALID) && !shd->slot.retired && (shd->cmn.hash == hash)) {
+            res.id = shd->slot.id;
+            break;
         }
     }
-    return false;
+    return res;
 }
 
-_SOKOL_PRIVATE bool _sg_uninit_shader(sg_shader shd_id) {
-    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
-    if (shd) {
-        if (shd->slot.ctx_id == _sg.active_context.id) {
-            _sg_destroy_shader(shd);
-            _sg_reset_shader(shd);
-            return true;
+/* called by sg_make_pipeline() with default values patched in */
+_SOKOL_PRIVATE void _sg_warmup_record(const sg_pipeline_desc* desc) {
+    _sg_warmup_buf_t rec;
+    memset(&rec, 0, sizeof(rec));
+    if (_sg_warmup_encode(&rec, desc)) {
+        const uint64_t key = _sg_hash_bytes(0xCBF29CE484222325ULL, rec.ptr, rec.size);
+        const uint64_t* keys = (const uint64_t*) _sg.warmup.rec_keys.ptr;
+        bool is_new = true;
+        for (int i = 0; i < _sg.warmup.num_recorded; i++) {
+            if (keys[i] == key) {
+                is_new = false;
+                break;
+            }
         }
-        else {
-            SOKOL_LOG("_sg_uninit_shader: active context mismatch (must be same as for creation)");
-            _SG_TRACE_NOARGS(err_context_mismatch);
+        if (is_new) {
+            _sg_warmup_buf_append(&_sg.warmup.rec_keys, &key, sizeof(key));
+            _sg_warmup_put_varint(&_sg.warmup.rec, (uint32_t)rec.size);
+            _sg_warmup_buf_append(&_sg.warmup.rec, rec.ptr, rec.size);
+            _sg.warmup.num_recorded++;
         }
     }
-    return false;
+    _sg_warmup_buf_discard(&rec);
 }
 
-_SOKOL_PRIVATE bool _sg_uninit_pipeline(sg_pipeline pip_id) {
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    if (pip) {
-        if (pip->slot.ctx_id == _sg.active_context.id) {
-            _sg_destroy_pipeline(pip);
-            _sg_reset_pipeline(pip);
-            return true;
+/* called by sg_make_pipeline(), returns a pre-created pipeline for an identical
+   desc which was also created with the requested shader (there may be several
+   shaders with the same hash, warm-up pipelines use the first one found)
+*/
+_SOKOL_PRIVATE sg_pipeline _sg_warmup_claim(const sg_pipeline_desc* desc) {
+    sg_pipeline res = { SG_INVALID_ID };
+    _sg_warmup_buf_t rec;
+    memset(&rec, 0, sizeof(rec));
+    if (_sg_warmup_encode(&rec, desc)) {
+        const uint64_t key = _sg_hash_bytes(0xCBF29CE484222325ULL, rec.ptr, rec.size);
+        for (int i = 0; i < _sg.warmup.num_items; i++) {
+            _sg_warmup_item_t* item = &_sg.warmup.items[i];
+            if ((item->state == _SG_WARMUPITEM_CREATED) && (item->key == key) &&
+                (item->size == rec.size) && (0 == memcmp(&_sg.warmup.data[item->offset], rec.ptr, (size_t)rec.size)))
+            {
+                const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, item->pip_id);
+                if (!pip) {
+                    /* the pre-created pipeline has been destroyed (e.g. with its context or group) */
+                    item->state = _SG_WARMUPITEM_FAILED;
+                    _sg.warmup.num_created--;
+                    _sg.warmup.num_failed++;
+                    break;
+                }
+                if (pip->cmn.shader_id.id != desc->shader.id) {
+                    /* leave the warm-up pipeline for a caller with the right shader */
+                    break;
+                }
+                item->state = _SG_WARMUPITEM_CLAIMED;
+                _sg.warmup.num_created--;
+                _sg.warmup.num_claimed++;
+                sg_pipeline pip_id = { item->pip_id };
+                if (sg_query_pipeline_state(pip_id) == SG_RESOURCESTATE_VALID) {
+                    res = pip_id;
+                }
+                break;
+            }
         }
-        else {
-            SOKOL_LOG("_sg_uninit_pipeline: active context mismatch (must be same as for creation)");
-            _SG_TRACE_NOARGS(err_context_mismatch);
+    }
+    _sg_warmup_buf_discard(&rec);
+    return res;
+}
+
+_SOKOL_PRIVATE void _sg_discard_pipeline_warmup(void) {
+    for (int i = 0; i < _sg.warmup.num_items; i++) {
+        _sg_warmup_item_t* item = &_sg.warmup.items[i];
+        if (item->state == _SG_WARMUPITEM_CREATED) {
+            sg_pipeline pip_id = { item->pip_id };
+            sg_destroy_pipeline(pip_id);
         }
     }
-    return false;
+    if (_sg.warmup.items) {
+        SOKOL_FREE(_sg.warmup.items);
+    }
+    if (_sg.warmup.data) {
+        SOKOL_FREE(_sg.warmup.data);
+    }
+    _sg.warmup.items = 0;
+    _sg.warmup.data = 0;
+    _sg.warmup.num_items = 0;
+    _sg.warmup.num_pending = 0;
+    _sg.warmup.num_created = 0;
+    _sg.warmup.num_claimed = 0;
+    _sg.warmup.num_failed = 0;
 }
 
-_SOKOL_PRIVATE bool _sg_uninit_pass(sg_pass pass_id) {
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    if (pass) {
-        if (pass->slot.ctx_id == _sg.active_context.id) {
-            _sg_destroy_pass(pass);
-            _sg_reset_pass(pass);
-            return true;
+_SOKOL_PRIVATE void _sg_discard_pipeline_recording(void) {
+    _sg_warmup_buf_discard(&_sg.warmup.rec);
+    _sg_warmup_buf_discard(&_sg.warmup.rec_keys);
+    _sg.warmup.num_recorded = 0;
+    _sg.warmup.recording = false;
+}
+
+/* create up to max_pipelines pending pipelines whose shaders exist (but at least one) */
+_SOKOL_PRIVATE int _sg_process_pipeline_warmup(int max_pipelines) {
+    /* if no shader has been created since the last unsuccessful pass, all
+       pending pipelines are still waiting for their shaders
+    */
+    if (_sg.warmup.idle_epoch == _sg.warmup.shader_epoch) {
+        return 0;
+    }
+    int num_processed = 0;
+    bool stopped = false;
+    for (int i = 0; (i < _sg.warmup.num_items) && (_sg.warmup.num_pending > 0); i++) {
+        if ((num_processed > 0) && (num_processed >= max_pipelines)) {
+            stopped = true;
+            break;
+        }
+        _sg_warmup_item_t* item = &_sg.warmup.items[i];
+        if (item->state != _SG_WARMUPITEM_PENDING) {
+            continue;
+        }
+        const sg_shader shd_id = _sg_warmup_find_shader(item->shader_hash);
+        if (shd_id.id == SG_INVALID_ID) {
+            /* the shader hasn't been created yet, try again later */
+            continue;
+        }
+        uint64_t shader_hash = 0;
+        sg_pipeline_desc desc;
+        const bool decoded = _sg_warmup_decode(&_sg.warmup.data[item->offset], item->size, &shader_hash, &desc);
+        SOKOL_ASSERT(decoded && (shader_hash == item->shader_hash)); _SOKOL_UNUSED(decoded);
+        desc.shader = shd_id;
+        /* NOTE: creates the pipeline without going through the warm-up cache,
+           the make_pipeline trace hook is called when sg_make_pipeline()
+           claims the pipeline (with the caller's desc and label)
+        */
+        sg_pipeline pip_id = _sg_alloc_pipeline();
+        if (pip_id.id != SG_INVALID_ID) {
+            sg_pipeline_desc desc_def = _sg_pipeline_desc_defaults(&desc);
+            _sg_init_pipeline(pip_id, &desc_def);
+        }
+        _sg.warmup.num_pending--;
+        if (sg_query_pipeline_state(pip_id) == SG_RESOURCESTATE_VALID) {
+            item->state = _SG_WARMUPITEM_CREATED;
+            item->pip_id = pip_id.id;
+            _sg.warmup.num_created++;
         }
         else {
-            SOKOL_LOG("_sg_uninit_pass: active context mismatch (must be same as for creation)");
-            _SG_TRACE_NOARGS(err_context_mismatch);
+            if (pip_id.id != SG_INVALID_ID) {
+                sg_destroy_pipeline(pip_id);
+            }
+            item->state = _SG_WARMUPITEM_FAILED;
+            _sg.warmup.num_failed++;
         }
+        num_processed++;
     }
-    return false;
+    if (!stopped) {
+        /* all remaining pending pipelines wait for shaders which don't exist yet */
+        _sg.warmup.idle_epoch = _sg.warmup.shader_epoch;
+    }
+    return num_processed;
 }
 
 /*== PUBLIC API FUNCTIONS ====================================================*/
@@ -14174,15 +18954,35 @@ SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
     _sg.desc.pipeline_pool_size = _sg_def(_sg.desc.pipeline_pool_size, _SG_DEFAULT_PIPELINE_POOL_SIZE);
     _sg.desc.pass_pool_size = _sg_def(_sg.desc.pass_pool_size, _SG_DEFAULT_PASS_POOL_SIZE);
     _sg.desc.context_pool_size = _sg_def(_sg.desc.context_pool_size, _SG_DEFAULT_CONTEXT_POOL_SIZE);
+    _sg.desc.group_pool_size = _sg_def(_sg.desc.group_pool_size, _SG_DEFAULT_GROUP_POOL_SIZE);
     _sg.desc.uniform_buffer_size = _sg_def(_sg.desc.uniform_buffer_size, _SG_DEFAULT_UB_SIZE);
     _sg.desc.staging_buffer_size = _sg_def(_sg.desc.staging_buffer_size, _SG_DEFAULT_STAGING_SIZE);
     _sg.desc.sampler_cache_size = _sg_def(_sg.desc.sampler_cache_size, _SG_DEFAULT_SAMPLER_CACHE_CAPACITY);
+    _sg.desc.upload_buffer_size = _sg_def(_sg.desc.upload_buffer_size, _SG_DEFAULT_UPLOAD_BUFFER_SIZE);
+    _sg.desc.upload_pool_size = _sg_def(_sg.desc.upload_pool_size, _SG_DEFAULT_UPLOAD_POOL_SIZE);
+    _sg.desc.validate_cache_size = _sg_def(_sg.desc.validate_cache_size, _SG_DEFAULT_VALIDATE_CACHE_SIZE);
+    _sg.desc.validate_sample_rate = _sg_def(_sg.desc.validate_sample_rate, 1);
+    _sg.desc.init_queue_frame_budget = _sg_def(_sg.desc.init_queue_frame_budget, _SG_DEFAULT_INIT_QUEUE_FRAME_BUDGET);
+    _sg.desc.pipeline_warmup_frame_budget = _sg_def(_sg.desc.pipeline_warmup_frame_budget, _SG_DEFAULT_PIPELINE_WARMUP_FRAME_BUDGET);
+    _sg.desc.profiler_num_frames = _sg_def(_sg.desc.profiler_num_frames, _SG_DEFAULT_PROFILER_NUM_FRAMES);
+    _sg.desc.profiler_max_nodes = _sg_def(_sg.desc.profiler_max_nodes, _SG_DEFAULT_PROFILER_MAX_NODES);
 
     _sg_setup_pools(&_sg.pools, &_sg.desc);
+    #if defined(SOKOL_DEBUG)
+    _sg_setup_validate_cache(&_sg.desc);
+    #endif
     _sg.frame_index = 1;
     _sg_setup_backend(&_sg.desc);
     _sg.valid = true;
     sg_setup_context();
+    _sg_setup_init_queue(&_sg.desc);
+    _sg_setup_retire_queue(&_sg.desc);
+    #if defined(SOKOL_PROFILER)
+    _sg_setup_profiler(&_sg.desc);
+    #endif
+    if (_sg.desc.reserve_pool_size > 0) {
+        _sg_refill_reserve_rings();
+    }
 }
 
 SOKOL_API_IMPL void sg_shutdown(void) {
@@ -14190,14 +18990,26 @@ SOKOL_API_IMPL void sg_shutdown(void) {
     contexts are used, the app code must take care of properly releasing them
     (since only the app code can switch between 3D-API contexts)
     */
+    _sg_discard_init_queue();
+    _sg_discard_pipeline_warmup();
+    _sg_discard_pipeline_recording();
     if (_sg.active_context.id != SG_INVALID_ID) {
         _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, _sg.active_context.id);
         if (ctx) {
+            /* this also destroys retired resources of the context */
             _sg_destroy_all_resources(&_sg.pools, _sg.active_context.id);
             _sg_destroy_context(ctx);
         }
     }
+    _sg_discard_retire_queue();
+    #if defined(SOKOL_PROFILER)
+    _sg_discard_profiler();
+    #endif
+    _sg_discard_image_uploads();
     _sg_discard_backend();
+    #if defined(SOKOL_DEBUG)
+    _sg_discard_validate_cache();
+    #endif
     _sg_discard_pools(&_sg.pools);
     _sg.valid = false;
 }
@@ -14233,6 +19045,18 @@ SOKOL_API_IMPL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt) {
     return _sg.formats[fmt_index];
 }
 
+SOKOL_API_IMPL sg_memory_info sg_query_memory_info(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.mem.info;
+}
+
+SOKOL_API_IMPL void sg_set_memory_budget(const sg_memory_budget* budget) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(budget);
+    _sg.mem.budget = *budget;
+    _sg_mem_check_budget();
+}
+
 SOKOL_API_IMPL sg_context sg_setup_context(void) {
     SOKOL_ASSERT(_sg.valid);
     sg_context res;
@@ -14254,9 +19078,10 @@ SOKOL_API_IMPL sg_context sg_setup_context(void) {
 
 SOKOL_API_IMPL void sg_discard_context(sg_context ctx_id) {
     SOKOL_ASSERT(_sg.valid);
-    _sg_destroy_all_resources(&_sg.pools, ctx_id.id);
+    _sg_validate_cache_invalidate();
     _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
     if (ctx) {
+        _sg_destroy_all_resources(&_sg.pools, ctx_id.id);
         _sg_destroy_context(ctx);
         _sg_reset_context(ctx);
         _sg_reset_slot(&ctx->slot);
@@ -14274,6 +19099,93 @@ SOKOL_API_IMPL void sg_activate_context(sg_context ctx_id) {
     _sg_activate_context(ctx);
 }
 
+/*-- resource groups ---------------------------------------------------------*/
+SOKOL_API_IMPL sg_group sg_make_group(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_group res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.group_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        _sg_group_t* grp = &_sg.pools.groups[slot_index];
+        res.id = _sg_slot_alloc(&_sg.pools.group_pool, &grp->slot, slot_index);
+        memset(&grp->live, 0, sizeof(grp->live));
+        grp->slot.ctx_id = _sg.active_context.id;
+        grp->slot.state = SG_RESOURCESTATE_VALID;
+    }
+    else {
+        SOKOL_LOG("group pool exhausted!");
+        res.id = SG_INVALID_ID;
+    }
+    return res;
+}
+
+SOKOL_API_IMPL void sg_destroy_group(sg_group grp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pools_t* p = &_sg.pools;
+    _sg_group_t* grp = _sg_lookup_group(p, grp_id.id);
+    if (!grp) {
+        return;
+    }
+    for (int i = _SG_LIVETYPE_NUM - 1; i >= 0; i--) {
+        const _sg_live_type_t type = (_sg_live_type_t)i;
+        while (grp->live.first[type] != _SG_INVALID_SLOT_INDEX) {
+            const int slot_index = grp->live.first[type];
+            _sg_slot_t* slot = _sg_live_slot(p, type, slot_index);
+            if (slot->ctx_id == _sg.active_context.id) {
+                /* go through the public functions so that trace hooks see each resource */
+                switch (type) {
+                    case _SG_LIVETYPE_BUFFER:   { sg_buffer id = { slot->id }; sg_destroy_buffer(id); } break;
+                    case _SG_LIVETYPE_IMAGE:    { sg_image id = { slot->id }; sg_destroy_image(id); } break;
+                    case _SG_LIVETYPE_SHADER:   { sg_shader id = { slot->id }; sg_destroy_shader(id); } break;
+                    case _SG_LIVETYPE_PIPELINE: { sg_pipeline id = { slot->id }; sg_destroy_pipeline(id); } break;
+                    case _SG_LIVETYPE_PASS:     { sg_pass id = { slot->id }; sg_destroy_pass(id); } break;
+                    default: SOKOL_UNREACHABLE; break;
+                }
+            }
+            else {
+                SOKOL_LOG("sg_destroy_group: active context mismatch, resource removed from group but not destroyed");
+                _sg_live_remove(p, &grp->live, type, slot_index, true);
+                slot->group_id = SG_INVALID_ID;
+            }
+        }
+    }
+    if (_sg.active_group.id == grp_id.id) {
+        _sg.active_group.id = SG_INVALID_ID;
+    }
+    _sg_reset_slot(&grp->slot);
+    _sg_pool_free_index(&p->group_pool, _sg_slot_index(grp_id.id));
+}
+
+SOKOL_API_IMPL void sg_begin_group(sg_group grp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(_sg.active_group.id == SG_INVALID_ID);
+    SOKOL_ASSERT(_sg_lookup_group(&_sg.pools, grp_id.id));
+    _sg.active_group = grp_id;
+}
+
+SOKOL_API_IMPL void sg_end_group(void) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(_sg.active_group.id != SG_INVALID_ID);
+    _sg.active_group.id = SG_INVALID_ID;
+}
+
+SOKOL_API_IMPL sg_group_info sg_query_group_info(sg_group grp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_group_info info;
+    memset(&info, 0, sizeof(info));
+    const _sg_group_t* grp = _sg_lookup_group(&_sg.pools, grp_id.id);
+    if (grp) {
+        info.slot.state = grp->slot.state;
+        info.slot.res_id = grp->slot.id;
+        info.slot.ctx_id = grp->slot.ctx_id;
+        info.num_buffers = grp->live.count[_SG_LIVETYPE_BUFFER];
+        info.num_images = grp->live.count[_SG_LIVETYPE_IMAGE];
+        info.num_shaders = grp->live.count[_SG_LIVETYPE_SHADER];
+        info.num_pipelines = grp->live.count[_SG_LIVETYPE_PIPELINE];
+        info.num_passes = grp->live.count[_SG_LIVETYPE_PASS];
+    }
+    return info;
+}
+
 SOKOL_API_IMPL sg_trace_hooks sg_install_trace_hooks(const sg_trace_hooks* trace_hooks) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(trace_hooks);
@@ -14429,7 +19341,7 @@ SOKOL_API_IMPL void sg_fail_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(buf_id.id != SG_INVALID_ID);
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
     SOKOL_ASSERT(buf && buf->slot.state == SG_RESOURCESTATE_ALLOC);
-    buf->slot.ctx_id = _sg.active_context.id;
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_BUFFER, &buf->slot, _sg.active_context.id, _sg.active_group.id);
     buf->slot.state = SG_RESOURCESTATE_FAILED;
     _SG_TRACE_ARGS(fail_buffer, buf_id);
 }
@@ -14439,7 +19351,7 @@ SOKOL_API_IMPL void sg_fail_image(sg_image img_id) {
     SOKOL_ASSERT(img_id.id != SG_INVALID_ID);
     _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
     SOKOL_ASSERT(img && img->slot.state == SG_RESOURCESTATE_ALLOC);
-    img->slot.ctx_id = _sg.active_context.id;
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_IMAGE, &img->slot, _sg.active_context.id, _sg.active_group.id);
     img->slot.state = SG_RESOURCESTATE_FAILED;
     _SG_TRACE_ARGS(fail_image, img_id);
 }
@@ -14449,7 +19361,7 @@ SOKOL_API_IMPL void sg_fail_shader(sg_shader shd_id) {
     SOKOL_ASSERT(shd_id.id != SG_INVALID_ID);
     _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
     SOKOL_ASSERT(shd && shd->slot.state == SG_RESOURCESTATE_ALLOC);
-    shd->slot.ctx_id = _sg.active_context.id;
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_SHADER, &shd->slot, _sg.active_context.id, _sg.active_group.id);
     shd->slot.state = SG_RESOURCESTATE_FAILED;
     _SG_TRACE_ARGS(fail_shader, shd_id);
 }
@@ -14459,7 +19371,7 @@ SOKOL_API_IMPL void sg_fail_pipeline(sg_pipeline pip_id) {
     SOKOL_ASSERT(pip_id.id != SG_INVALID_ID);
     _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
     SOKOL_ASSERT(pip && pip->slot.state == SG_RESOURCESTATE_ALLOC);
-    pip->slot.ctx_id = _sg.active_context.id;
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_PIPELINE, &pip->slot, _sg.active_context.id, _sg.active_group.id);
     pip->slot.state = SG_RESOURCESTATE_FAILED;
     _SG_TRACE_ARGS(fail_pipeline, pip_id);
 }
@@ -14469,7 +19381,7 @@ SOKOL_API_IMPL void sg_fail_pass(sg_pass pass_id) {
     SOKOL_ASSERT(pass_id.id != SG_INVALID_ID);
     _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
     SOKOL_ASSERT(pass && pass->slot.state == SG_RESOURCESTATE_ALLOC);
-    pass->slot.ctx_id = _sg.active_context.id;
+    _sg_live_add(&_sg.pools, _SG_LIVETYPE_PASS, &pass->slot, _sg.active_context.id, _sg.active_group.id);
     pass->slot.state = SG_RESOURCESTATE_FAILED;
     _SG_TRACE_ARGS(fail_pass, pass_id);
 }
@@ -14563,6 +19475,16 @@ SOKOL_API_IMPL sg_pipeline sg_make_pipeline(const sg_pipeline_desc* desc) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(desc);
     sg_pipeline_desc desc_def = _sg_pipeline_desc_defaults(desc);
+    if (_sg.warmup.recording) {
+        _sg_warmup_record(&desc_def);
+    }
+    if (_sg.warmup.num_created > 0) {
+        sg_pipeline pip_id = _sg_warmup_claim(&desc_def);
+        if (pip_id.id != SG_INVALID_ID) {
+            _SG_TRACE_ARGS(make_pipeline, &desc_def, pip_id);
+            return pip_id;
+        }
+    }
     sg_pipeline pip_id = _sg_alloc_pipeline();
     if (pip_id.id != SG_INVALID_ID) {
         _sg_init_pipeline(pip_id, &desc_def);
@@ -14595,6 +19517,9 @@ SOKOL_API_IMPL sg_pass sg_make_pass(const sg_pass_desc* desc) {
 SOKOL_API_IMPL void sg_destroy_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
     _SG_TRACE_ARGS(destroy_buffer, buf_id);
+    if (_sg_retire_resource(_SG_LIVETYPE_BUFFER, buf_id.id)) {
+        return;
+    }
     if (_sg_uninit_buffer(buf_id)) {
         _sg_dealloc_buffer(buf_id);
     }
@@ -14603,6 +19528,9 @@ SOKOL_API_IMPL void sg_destroy_buffer(sg_buffer buf_id) {
 SOKOL_API_IMPL void sg_destroy_image(sg_image img_id) {
     SOKOL_ASSERT(_sg.valid);
     _SG_TRACE_ARGS(destroy_image, img_id);
+    if (_sg_retire_resource(_SG_LIVETYPE_IMAGE, img_id.id)) {
+        return;
+    }
     if (_sg_uninit_image(img_id)) {
         _sg_dealloc_image(img_id);
     }
@@ -14611,6 +19539,9 @@ SOKOL_API_IMPL void sg_destroy_image(sg_image img_id) {
 SOKOL_API_IMPL void sg_destroy_shader(sg_shader shd_id) {
     SOKOL_ASSERT(_sg.valid);
     _SG_TRACE_ARGS(destroy_shader, shd_id);
+    if (_sg_retire_resource(_SG_LIVETYPE_SHADER, shd_id.id)) {
+        return;
+    }
     if (_sg_uninit_shader(shd_id)) {
         _sg_dealloc_shader(shd_id);
     }
@@ -14619,6 +19550,9 @@ SOKOL_API_IMPL void sg_destroy_shader(sg_shader shd_id) {
 SOKOL_API_IMPL void sg_destroy_pipeline(sg_pipeline pip_id) {
     SOKOL_ASSERT(_sg.valid);
     _SG_TRACE_ARGS(destroy_pipeline, pip_id);
+    if (_sg_retire_resource(_SG_LIVETYPE_PIPELINE, pip_id.id)) {
+        return;
+    }
     if (_sg_uninit_pipeline(pip_id)) {
         _sg_dealloc_pipeline(pip_id);
     }
@@ -14627,6 +19561,9 @@ SOKOL_API_IMPL void sg_destroy_pipeline(sg_pipeline pip_id) {
 SOKOL_API_IMPL void sg_destroy_pass(sg_pass pass_id) {
     SOKOL_ASSERT(_sg.valid);
     _SG_TRACE_ARGS(destroy_pass, pass_id);
+    if (_sg_retire_resource(_SG_LIVETYPE_PASS, pass_id.id)) {
+        return;
+    }
     if (_sg_uninit_pass(pass_id)) {
         _sg_dealloc_pass(pass_id);
     }
@@ -14640,6 +19577,9 @@ SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int
     _sg_resolve_default_pass_action(pass_action, &pa);
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.pass_valid = true;
+    #if defined(SOKOL_PROFILER)
+    _sg_profiler_push(SG_PROFILERNODETYPE_PASS, "default pass", _sg.cur_pass);
+    #endif
     _sg_begin_pass(0, &pa, width, height);
     _SG_TRACE_ARGS(begin_default_pass, pass_action, width, height);
 }
@@ -14658,6 +19598,10 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
         SOKOL_ASSERT(img);
         const int w = img->cmn.width;
         const int h = img->cmn.height;
+        #if defined(SOKOL_PROFILER)
+        const char* name = _sg_strempty(&pass->cmn.label) ? "pass" : _sg_strptr(&pass->cmn.label);
+        _sg_profiler_push(SG_PROFILERNODETYPE_PASS, name, pass_id);
+        #endif
         _sg_begin_pass(pass, &pa, w, h);
         _SG_TRACE_ARGS(begin_pass, pass_id, pass_action);
     }
@@ -14839,6 +19783,9 @@ SOKOL_API_IMPL void sg_end_pass(void) {
         return;
     }
     _sg_end_pass();
+    #if defined(SOKOL_PROFILER)
+    _sg_profiler_end_pass();
+    #endif
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.cur_pipeline.id = SG_INVALID_ID;
     _sg.pass_valid = false;
@@ -14847,9 +19794,25 @@ SOKOL_API_IMPL void sg_end_pass(void) {
 
 SOKOL_API_IMPL void sg_commit(void) {
     SOKOL_ASSERT(_sg.valid);
+    if (_sg.desc.init_queue_frame_budget > 0) {
+        _sg_process_init_queue(_sg.desc.init_queue_frame_budget);
+    }
+    if (_sg.desc.reserve_pool_size > 0) {
+        _sg_refill_reserve_rings();
+    }
+    if ((_sg.desc.pipeline_warmup_frame_budget > 0) && (_sg.warmup.num_pending > 0)) {
+        _sg_process_pipeline_warmup(_sg.desc.pipeline_warmup_frame_budget);
+    }
+    _sg_flush_image_uploads();
     _sg_commit();
     _SG_TRACE_NOARGS(commit);
     _sg.frame_index++;
+    if (_sg.retire.num > 0) {
+        _sg_retire_collect(_sg.frame_index);
+    }
+    #if defined(SOKOL_PROFILER)
+    _sg_profiler_commit();
+    #endif
 }
 
 SOKOL_API_IMPL void sg_reset_state_cache(void) {
@@ -14886,6 +19849,10 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const void* data, int num_
             buf->cmn.append_overflow = false;
         }
         if ((buf->cmn.append_pos + _sg_roundup(num_bytes, 4)) > buf->cmn.size) {
+            if (!buf->cmn.append_overflow) {
+                /* overflown buffers fail validation in sg_apply_bindings() */
+                _sg_validate_cache_invalidate();
+            }
             buf->cmn.append_overflow = true;
         }
         const int start_pos = buf->cmn.append_pos;
@@ -14917,6 +19884,21 @@ SOKOL_API_IMPL bool sg_query_buffer_overflow(sg_buffer buf_id) {
     return result;
 }
 
+SOKOL_API_IMPL bool sg_query_buffer_will_overflow(sg_buffer buf_id, int data_size) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    bool result = false;
+    if (buf) {
+        /* the append cursor will be rewound in a new frame */
+        int append_pos = buf->cmn.append_pos;
+        if (buf->cmn.append_frame_index != _sg.frame_index) {
+            append_pos = 0;
+        }
+        result = (append_pos + _sg_roundup(data_size, 4)) > buf->cmn.size;
+    }
+    return result;
+}
+
 SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_content* data) {
     SOKOL_ASSERT(_sg.valid);
     _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
@@ -14930,15 +19912,234 @@ SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_content* dat
     _SG_TRACE_ARGS(update_image, img_id, data);
 }
 
+SOKOL_API_IMPL sg_image_upload sg_begin_image_upload(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_image_upload res;
+    memset(&res, 0, sizeof(res));
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
+        if (_sg_validate_begin_image_upload(img)) {
+            if (!_sg_begin_image_upload(img, &res)) {
+                SOKOL_LOG("sg_begin_image_upload: out of upload staging memory or upload slots for this frame\n");
+            }
+        }
+    }
+    _SG_TRACE_ARGS(begin_image_upload, img_id, &res);
+    return res;
+}
+
+SOKOL_API_IMPL void sg_end_image_upload(const sg_image_upload* upload) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(upload);
+    if (SG_INVALID_ID != upload->id) {
+        _sg_upload_t* upl = _sg_lookup_upload(upload->id);
+        if (_sg_validate_end_image_upload(upl)) {
+            if (upl && (SG_UPLOADSTATE_PENDING == upl->state)) {
+                upl->state = SG_UPLOADSTATE_QUEUED;
+            }
+        }
+    }
+    _SG_TRACE_ARGS(end_image_upload, upload);
+}
+
+SOKOL_API_IMPL sg_upload_state sg_query_image_upload_state(uint32_t upload_id) {
+    SOKOL_ASSERT(_sg.valid);
+    const _sg_upload_t* upl = _sg_lookup_upload(upload_id);
+    return upl ? upl->state : SG_UPLOADSTATE_INVALID;
+}
+
+SOKOL_API_IMPL sg_buffer sg_reserve_buffer(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_buffer res = { _sg_reserve_ring_take(&_sg.init_queue.buffers) };
+    return res;
+}
+
+SOKOL_API_IMPL sg_image sg_reserve_image(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_image res = { _sg_reserve_ring_take(&_sg.init_queue.images) };
+    return res;
+}
+
+SOKOL_API_IMPL bool sg_enqueue_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    if (SG_INVALID_ID == buf_id.id) {
+        return false;
+    }
+    return _sg_enqueue_init_buffer(buf_id.id, desc);
+}
+
+SOKOL_API_IMPL bool sg_enqueue_init_image(sg_image img_id, const sg_image_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    if (SG_INVALID_ID == img_id.id) {
+        return false;
+    }
+    return _sg_enqueue_init_image(img_id.id, desc);
+}
+
+SOKOL_API_IMPL int sg_process_init_queue(int max_bytes) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg_process_init_queue(max_bytes);
+}
+
+SOKOL_API_IMPL void sg_begin_pipeline_recording(void) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_discard_pipeline_recording();
+    _sg.warmup.recording = true;
+}
+
+SOKOL_API_IMPL int sg_save_pipeline_recording(void* ptr, int num_bytes) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_warmup_buf_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    const uint8_t magic[5] = { 'S', 'G', 'P', 'W', _SG_WARMUP_VERSION };
+    _sg_warmup_buf_append(&hdr, magic, 5);
+    _sg_warmup_put_varint(&hdr, (uint32_t)_sg.warmup.num_recorded);
+    const int size = hdr.size + _sg.warmup.rec.size;
+    if (ptr && (num_bytes >= size)) {
+        memcpy(ptr, hdr.ptr, (size_t)hdr.size);
+        if (_sg.warmup.rec.size > 0) {
+            memcpy((uint8_t*)ptr + hdr.size, _sg.warmup.rec.ptr, (size_t)_sg.warmup.rec.size);
+        }
+    }
+    _sg_warmup_buf_discard(&hdr);
+    return size;
+}
+
+SOKOL_API_IMPL void sg_end_pipeline_recording(void) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_discard_pipeline_recording();
+}
+
+SOKOL_API_IMPL bool sg_load_pipeline_warmup(const void* ptr, int num_bytes) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(ptr && (num_bytes >= 0));
+    _sg_discard_pipeline_warmup();
+    const uint8_t* data = (const uint8_t*) ptr;
+    if ((num_bytes < 5) || (data[0] != 'S') || (data[1] != 'G') || (data[2] != 'P') || (data[3] != 'W')) {
+        SOKOL_LOG("sg_load_pipeline_warmup: not a pipeline recording");
+        return false;
+    }
+    if (data[4] != _SG_WARMUP_VERSION) {
+        SOKOL_LOG("sg_load_pipeline_warmup: pipeline recording version mismatch");
+        return false;
+    }
+    _sg_warmup_stream_t s;
+    memset(&s, 0, sizeof(s));
+    s.ptr = data + 5;
+    s.end = data + num_bytes;
+    const uint32_t num_records = _sg_warmup_get_varint(&s);
+    if (s.error || (num_records > (uint32_t)num_bytes)) {
+        SOKOL_LOG("sg_load_pipeline_warmup: corrupt pipeline recording");
+        return false;
+    }
+    const int data_size = (int)(s.end - s.ptr);
+    _sg.warmup.data = (uint8_t*) SOKOL_MALLOC((size_t)_sg_max(data_size, 1));
+    _sg.warmup.items = (_sg_warmup_item_t*) SOKOL_MALLOC((size_t)_sg_max((int)num_records, 1) * sizeof(_sg_warmup_item_t));
+    SOKOL_ASSERT(_sg.warmup.data && _sg.warmup.items);
+    memcpy(_sg.warmup.data, s.ptr, (size_t)data_size);
+    s.ptr = _sg.warmup.data;
+    s.end = _sg.warmup.data + data_size;
+    for (uint32_t i = 0; i < num_records; i++) {
+        const uint32_t size = _sg_warmup_get_varint(&s);
+        uint64_t shader_hash;
+        sg_pipeline_desc desc;
+        if (s.error || (size > (uint32_t)(s.end - s.ptr)) || !_sg_warmup_decode(s.ptr, (int)size, &shader_hash, &desc)) {
+            SOKOL_LOG("sg_load_pipeline_warmup: corrupt pipeline recording");
+            _sg_discard_pipeline_warmup();
+            return false;
+        }
+        _sg_warmup_item_t* item = &_sg.warmup.items[_sg.warmup.num_items++];
+        memset(item, 0, sizeof(_sg_warmup_item_t));
+        item->state = _SG_WARMUPITEM_PENDING;
+        item->offset = (int)(s.ptr - _sg.warmup.data);
+        item->size = (int)size;
+        item->key = _sg_hash_bytes(0xCBF29CE484222325ULL, s.ptr, (int)size);
+        item->shader_hash = shader_hash;
+        s.ptr += size;
+    }
+    _sg.warmup.num_pending = _sg.warmup.num_items;
+    /* check the pending pipelines against the existing shaders in the next pass */
+    _sg.warmup.idle_epoch = _sg.warmup.shader_epoch - 1;
+    return true;
+}
+
+SOKOL_API_IMPL int sg_process_pipeline_warmup(int max_pipelines) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg_process_pipeline_warmup(max_pipelines);
+}
+
+SOKOL_API_IMPL void sg_discard_pipeline_warmup(void) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_discard_pipeline_warmup();
+}
+
+SOKOL_API_IMPL sg_pipeline_warmup_info sg_query_pipeline_warmup_info(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pipeline_warmup_info info;
+    memset(&info, 0, sizeof(info));
+    info.num_recorded = _sg.warmup.num_recorded;
+    info.num_pending = _sg.warmup.num_pending;
+    info.num_created = _sg.warmup.num_created;
+    info.num_claimed = _sg.warmup.num_claimed;
+    info.num_failed = _sg.warmup.num_failed;
+    return info;
+}
+
+SOKOL_API_IMPL sg_profiler_frame sg_query_profiler_frame(int frames_ago) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_profiler_frame res;
+    memset(&res, 0, sizeof(res));
+    #if defined(SOKOL_PROFILER)
+        const sg_profiler_frame* frame = _sg_profiler_completed_frame(frames_ago);
+        if (frame) {
+            res = *frame;
+        }
+    #else
+        _SOKOL_UNUSED(frames_ago);
+    #endif
+    return res;
+}
+
+SOKOL_API_IMPL int sg_save_profiler_trace(char* ptr, int num_bytes) {
+    SOKOL_ASSERT(_sg.valid);
+    #if defined(SOKOL_PROFILER)
+        _sg_profiler_writer_t w;
+        memset(&w, 0, sizeof(w));
+        _sg_profiler_write_trace(&w);
+        const int size = w.pos;
+        if (ptr && (num_bytes >= size)) {
+            memset(&w, 0, sizeof(w));
+            w.ptr = ptr;
+            _sg_profiler_write_trace(&w);
+            SOKOL_ASSERT(w.pos == size);
+        }
+        return size;
+    #else
+        _SOKOL_UNUSED(ptr);
+        _SOKOL_UNUSED(num_bytes);
+        SOKOL_LOG("sg_save_profiler_trace() called, but SOKOL_PROFILER is not defined!");
+        return 0;
+    #endif
+}
+
 SOKOL_API_IMPL void sg_push_debug_group(const char* name) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(name);
     _SOKOL_UNUSED(name);
+    #if defined(SOKOL_PROFILER)
+    sg_pass no_pass = { SG_INVALID_ID };
+    _sg_profiler_push(SG_PROFILERNODETYPE_GROUP, name, no_pass);
+    #endif
     _SG_TRACE_ARGS(push_debug_group, name);
 }
 
 SOKOL_API_IMPL void sg_pop_debug_group(void) {
     SOKOL_ASSERT(_sg.valid);
+    #if defined(SOKOL_PROFILER)
+    _sg_profiler_pop_group();
+    #endif
     _SG_TRACE_NOARGS(pop_debug_group);
 }
 
@@ -15086,6 +20287,53 @@ SOKOL_API_IMPL const void* sg_mtl_render_command_encoder(void) {
     #endif
 }
 
+SOKOL_API_IMPL void sg_dummy_set_driver_costs(const sg_dummy_driver_costs* costs) {
+    SOKOL_ASSERT(_sg.valid && costs);
+    #if defined(SOKOL_DUMMY_BACKEND)
+        _sg.dmy.costs = *costs;
+    #else
+        _SOKOL_UNUSED(costs);
+    #endif
+}
+
+SOKOL_API_IMPL sg_dummy_frame_stats sg_dummy_query_frame_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    #if defined(SOKOL_DUMMY_BACKEND)
+        return _sg.dmy.last_frame;
+    #else
+        sg_dummy_frame_stats res;
+        memset(&res, 0, sizeof(res));
+        return res;
+    #endif
+}
+
+SOKOL_API_IMPL void sg_sw_sample(const sg_sw_texture* tex, float u, float v, float* out_rgba) {
+    SOKOL_ASSERT(out_rgba);
+    #if defined(SOKOL_SW)
+        _sg_sw_sample(tex, u, v, out_rgba);
+    #else
+        _SOKOL_UNUSED(tex); _SOKOL_UNUSED(u); _SOKOL_UNUSED(v);
+        out_rgba[0] = out_rgba[1] = out_rgba[2] = out_rgba[3] = 0.0f;
+    #endif
+}
+
+SOKOL_API_IMPL bool sg_sw_read_pixels(sg_image img_id, void* ptr, int num_bytes) {
+    SOKOL_ASSERT(_sg.valid && ptr && (num_bytes >= 0));
+    #if defined(SOKOL_SW)
+        const _sg_image_t* img = 0;
+        if (img_id.id != SG_INVALID_ID) {
+            img = _sg_lookup_image(&_sg.pools, img_id.id);
+            if (!img || (img->slot.state != SG_RESOURCESTATE_VALID)) {
+                return false;
+            }
+        }
+        return _sg_sw_read_pixels(img, ptr, num_bytes);
+    #else
+        _SOKOL_UNUSED(img_id); _SOKOL_UNUSED(ptr); _SOKOL_UNUSED(num_bytes);
+        return false;
+    #endif
+}
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -0,0 +1,862 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_ATLAS_IMPL)
+#define SOKOL_ATLAS_IMPL
+#endif
+#ifndef SOKOL_ATLAS_INCLUDED
+/*
+    sokol_atlas.h -- pack small RGBA8 images into shared sokol_gfx.h textures
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_ATLAS_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_atlas.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)     - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)       - your own free function (default: free(p))
+    SOKOL_ATLAS_API_DECL - public function declaration prefix (default: extern)
+    SOKOL_API_DECL      - same as SOKOL_ATLAS_API_DECL
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+
+    If sokol_atlas.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_ATLAS_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    When every UI icon or sprite lives in its own sg_image, each texture
+    switch needs its own sg_apply_bindings() call and usually its own
+    draw call. sokol_atlas.h packs many small RGBA8 images into a few
+    large 'pages', so that all of them can be rendered with the same
+    bindings.
+
+    The pages are either separate 2D images (SG_IMAGETYPE_2D), or the
+    layers of a single array image (SG_IMAGETYPE_ARRAY), in which case
+    everything in the atlas can be rendered with one binding.
+
+    Images are packed with a skyline bottom-left packer, each image
+    gets a 1-pixel border with its edge pixels replicated, so that
+    linear filtering doesn't bleed in pixels of the neighbours.
+
+    Images can be added, updated and removed at any time, the atlas
+    keeps a CPU copy of the pages and uploads the pages which have
+    changed once per frame in satl_commit(). The space of removed
+    images is reclaimed by satl_defrag(), which repacks all images.
+
+    STEP BY STEP
+    ============
+    --- call satl_setup() after sg_setup():
+
+            satl_setup(&(satl_desc_t){
+                .type = ...,            // SG_IMAGETYPE_2D (default) or SG_IMAGETYPE_ARRAY
+                .width = ...,           // page width, default: 1024
+                .height = ...,          // page height, default: 1024
+                .max_pages = ...,       // max number of pages or array layers, default: 4
+                .max_regions = ...,     // max number of images in the atlas, default: 1024
+                .min_filter = ...,      // default: SG_FILTER_LINEAR
+                .mag_filter = ...,      // default: SG_FILTER_LINEAR
+                .no_padding = ...,      // true to disable the 1-pixel border around images
+                .label = ...            // optional debug label for the sokol_gfx.h images
+            });
+
+        In array mode, the array image with max_pages layers and the CPU
+        copy of all layers are allocated upfront. In 2D mode, pages are
+        created when they are needed.
+
+    --- add an RGBA8 image to the atlas:
+
+            satl_region reg = satl_add_image(&(satl_image_desc_t){
+                .width = ...,
+                .height = ...,
+                .pixels = ...,      // width * height RGBA8 pixels
+                .row_pitch = ...    // optional, default: width * 4
+            });
+
+        The pixel data is copied, so it can be freed right away. If there's
+        no room left in the atlas, reg.id will be SATL_INVALID_ID. The
+        space of removed images is only reclaimed by satl_defrag(), so this
+        is a good time to call satl_defrag() and try again.
+
+    --- to render an image from the atlas, get the region info:
+
+            const satl_region_info_t info = satl_query_region(reg);
+
+        ...and use info.image, info.layer (the array layer in array mode)
+        and info.uv_scale / info.uv_offset to transform texture coordinates
+        from the image's own 0..1 range into the atlas page:
+
+            atlas_uv = uv * info.uv_scale + info.uv_offset
+
+        In 2D mode, images on the same page share the same sg_image.
+
+    --- to overwrite the pixels of an image (same size):
+
+            satl_update_image(reg, pixels, row_pitch);
+
+    --- to remove an image:
+
+            satl_remove_image(reg);
+
+    --- once per frame (before or after rendering, but outside of
+        the other sg_update_image() calls on the atlas images), upload
+        the pages which have been modified:
+
+            satl_commit();
+
+        sokol_gfx.h can only update whole images, so a page which
+        contains a modified rectangle is uploaded completely, and in
+        array mode all layers are uploaded together. The size of the
+        modified rectangles versus the uploaded bytes is reported by
+        satl_query_stats().
+
+    --- to reclaim the space of removed images and to reduce the number
+        of pages, repack all images:
+
+            bool satl_defrag(void)
+
+        This moves the images around (the region handles stay valid,
+        but the region infos change, so cached texture coordinates must
+        be updated) and marks all pages as modified. If the images can't
+        be packed into the available pages in the new order, nothing is
+        changed and the function returns false.
+
+    --- to check how well the atlas is used, call:
+
+            satl_stats_t satl_query_stats(void)
+
+        ...which returns the number of pages and regions, the occupancy
+        (the area of all images divided by the area of all used pages),
+        the area which has been lost to removed images, and the upload
+        statistics of the last satl_commit().
+
+    --- at shutdown, call satl_shutdown() before sg_shutdown()
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2020 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_ATLAS_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_atlas.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_ATLAS_API_DECL)
+#define SOKOL_ATLAS_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_ATLAS_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_ATLAS_IMPL)
+#define SOKOL_ATLAS_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_ATLAS_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_ATLAS_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    SATL_INVALID_ID = 0,
+};
+
+typedef struct satl_region { uint32_t id; } satl_region;
+
+typedef struct satl_desc_t {
+    sg_image_type type;         /* SG_IMAGETYPE_2D (default) or SG_IMAGETYPE_ARRAY */
+    int width;                  /* page width in pixels (default: 1024) */
+    int height;                 /* page height in pixels (default: 1024) */
+    int max_pages;              /* max number of pages or array layers (default: 4) */
+    int max_regions;            /* max number of images in the atlas (default: 1024, max 65535) */
+    sg_filter min_filter;       /* default: SG_FILTER_LINEAR */
+    sg_filter mag_filter;       /* default: SG_FILTER_LINEAR */
+    bool no_padding;            /* don't put a 1-pixel border around images */
+    const char* label;          /* optional debug label of the sokol_gfx.h images */
+} satl_desc_t;
+
+typedef struct satl_image_desc_t {
+    int width;
+    int height;
+    const void* pixels;         /* RGBA8 pixels */
+    int row_pitch;              /* bytes per row (default: width * 4) */
+} satl_image_desc_t;
+
+typedef struct satl_region_info_t {
+    sg_image image;             /* the page image (the array image in array mode) */
+    int layer;                  /* page index, which is the array layer in array mode */
+    int x, y, width, height;    /* pixel rectangle in the page */
+    float uv_scale[2];          /* atlas_uv = uv * uv_scale + uv_offset */
+    float uv_offset[2];
+} satl_region_info_t;
+
+typedef struct satl_stats_t {
+    int num_pages;              /* number of pages which contain images */
+    int num_regions;            /* number of images in the atlas */
+    int used_pixels;            /* area of all images, without padding */
+    int lost_pixels;            /* area of removed images which hasn't been reclaimed yet */
+    int capacity_pixels;        /* area of all pages which contain images */
+    float occupancy;            /* used_pixels / capacity_pixels */
+    int num_defrags;            /* number of successful satl_defrag() calls */
+    int num_uploads;            /* sg_update_image() calls in the last satl_commit() */
+    int upload_bytes;           /* bytes uploaded in the last satl_commit() */
+    int dirty_bytes;            /* bytes in modified rectangles in the last satl_commit() */
+} satl_stats_t;
+
+SOKOL_ATLAS_API_DECL void satl_setup(const satl_desc_t* desc);
+SOKOL_ATLAS_API_DECL void satl_shutdown(void);
+SOKOL_ATLAS_API_DECL satl_region satl_add_image(const satl_image_desc_t* desc);
+SOKOL_ATLAS_API_DECL void satl_update_image(satl_region reg, const void* pixels, int row_pitch);
+SOKOL_ATLAS_API_DECL void satl_remove_image(satl_region reg);
+SOKOL_ATLAS_API_DECL bool satl_query_region_valid(satl_region reg);
+SOKOL_ATLAS_API_DECL satl_region_info_t satl_query_region(satl_region reg);
+SOKOL_ATLAS_API_DECL void satl_commit(void);
+SOKOL_ATLAS_API_DECL bool satl_defrag(void);
+SOKOL_ATLAS_API_DECL satl_stats_t satl_query_stats(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+
+/* reference-based equivalents for c++ */
+inline void satl_setup(const satl_desc_t& desc) { return satl_setup(&desc); }
+inline satl_region satl_add_image(const satl_image_desc_t& desc) { return satl_add_image(&desc); }
+
+#endif
+#endif /* SOKOL_ATLAS_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_ATLAS_IMPL
+#define SOKOL_ATLAS_IMPL_INCLUDED (1)
+
+#include <string.h> // memset, memcpy
+#include <stdlib.h> // qsort
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+
+#define _satl_def(val, def) (((val) == 0) ? (def) : (val))
+#define _satl_min(a,b) ((a<b)?a:b)
+#define _satl_max(a,b) ((a>b)?a:b)
+#define _SATL_INIT_COOKIE (0xA71A5A71)
+#define _SATL_DEFAULT_PAGE_SIZE (1024)
+#define _SATL_DEFAULT_MAX_PAGES (4)
+#define _SATL_DEFAULT_MAX_REGIONS (1024)
+#define _SATL_SLOT_SHIFT (16)
+#define _SATL_SLOT_MASK ((1<<_SATL_SLOT_SHIFT)-1)
+
+/* a skyline segment, the segments of a page cover the page width without gaps */
+typedef struct {
+    int x;
+    int y;
+    int w;
+} _satl_node_t;
+
+typedef struct {
+    uint32_t id;        /* SATL_INVALID_ID if the slot is free */
+    int page;
+    int x, y, w, h;     /* the image rectangle, without padding */
+} _satl_slot_t;
+
+typedef struct {
+    int x0, y0, x1, y1; /* empty if x0 >= x1 */
+} _satl_rect_t;
+
+typedef struct {
+    int num_nodes;
+    _satl_node_t* nodes;
+} _satl_skyline_t;
+
+typedef struct {
+    sg_image img;       /* in 2D mode, created on first use */
+    _satl_rect_t dirty;
+} _satl_page_t;
+
+typedef struct {
+    uint32_t init_cookie;
+    satl_desc_t desc;
+    int padding;
+    int page_bytes;
+    int num_pages;          /* pages which have been packed into */
+    int cap_pages;          /* pages in the pixel buffer */
+    uint8_t* pixels;        /* CPU copy of all pages, in array mode also the upload data */
+    sg_image array_img;     /* only in array mode */
+    _satl_page_t* pages;
+    _satl_skyline_t* skylines;
+    _satl_node_t* node_buf; /* max_pages * width skyline nodes */
+    _satl_slot_t* slots;
+    int* free_slots;
+    int num_free_slots;
+    uint32_t unique_counter;
+    int used_pixels;
+    int lost_pixels;
+    satl_stats_t stats;
+} _satl_t;
+static _satl_t _satl;
+
+static satl_desc_t _satl_desc_defaults(const satl_desc_t* in_desc) {
+    satl_desc_t desc = *in_desc;
+    desc.type = _satl_def(desc.type, SG_IMAGETYPE_2D);
+    desc.width = _satl_def(desc.width, _SATL_DEFAULT_PAGE_SIZE);
+    desc.height = _satl_def(desc.height, _SATL_DEFAULT_PAGE_SIZE);
+    desc.max_pages = _satl_def(desc.max_pages, _SATL_DEFAULT_MAX_PAGES);
+    desc.max_regions = _satl_def(desc.max_regions, _SATL_DEFAULT_MAX_REGIONS);
+    desc.min_filter = _satl_def(desc.min_filter, SG_FILTER_LINEAR);
+    desc.mag_filter = _satl_def(desc.mag_filter, SG_FILTER_LINEAR);
+    return desc;
+}
+
+/*-- skyline packer ----------------------------------------------------------*/
+static void _satl_skyline_reset(_satl_skyline_t* sky) {
+    sky->num_nodes = 1;
+    sky->nodes[0].x = 0;
+    sky->nodes[0].y = 0;
+    sky->nodes[0].w = _satl.desc.width;
+}
+
+/* returns the y position of a w-wide rectangle starting at node index, or -1 if it doesn't fit */
+static int _satl_skyline_fit(const _satl_skyline_t* sky, int index, int w, int h) {
+    const int x = sky->nodes[index].x;
+    if ((x + w) > _satl.desc.width) {
+        return -1;
+    }
+    int y = 0;
+    int remaining = w;
+    while (remaining > 0) {
+        SOKOL_ASSERT(index < sky->num_nodes);
+        y = _satl_max(y, sky->nodes[index].y);
+        if ((y + h) > _satl.desc.height) {
+            return -1;
+        }
+        remaining -= sky->nodes[index].w;
+        index++;
+    }
+    return y;
+}
+
+/* find the bottom-left position for a rectangle, returns the node index or -1 */
+static int _satl_skyline_find(const _satl_skyline_t* sky, int w, int h, int* out_y) {
+    int best_index = -1;
+    int best_bottom = _satl.desc.height + 1;
+    int best_width = _satl.desc.width + 1;
+    for (int i = 0; i < sky->num_nodes; i++) {
+        const int y = _satl_skyline_fit(sky, i, w, h);
+        if (y >= 0) {
+            const int bottom = y + h;
+            /* prefer the lowest position, and the narrowest segment on ties */
+            if ((bottom < best_bottom) || ((bottom == best_bottom) && (sky->nodes[i].w < best_width))) {
+                best_index = i;
+                best_bottom = bottom;
+                best_width = sky->nodes[i].w;
+                *out_y = y;
+            }
+        }
+    }
+    return best_index;
+}
+
+static void _satl_skyline_insert(_satl_skyline_t* sky, int index, int w, int h, int y) {
+    SOKOL_ASSERT(sky->num_nodes < _satl.desc.width);
+    _satl_node_t node;
+    node.x = sky->nodes[index].x;
+    node.y = y + h;
+    node.w = w;
+    memmove(&sky->nodes[index + 1], &sky->nodes[index], (size_t)(sky->num_nodes - index) * sizeof(_satl_node_t));
+    sky->nodes[index] = node;
+    sky->num_nodes++;
+
+    /* shrink or remove the nodes which are covered by the new node */
+    for (int i = index + 1; i < sky->num_nodes; i++) {
+        const int right = sky->nodes[i-1].x + sky->nodes[i-1].w;
+        if (sky->nodes[i].x < right) {
+            const int shrink = right - sky->nodes[i].x;
+            sky->nodes[i].x += shrink;
+            sky->nodes[i].w -= shrink;
+            if (sky->nodes[i].w <= 0) {
+                memmove(&sky->nodes[i], &sky->nodes[i + 1], (size_t)(sky->num_nodes - i - 1) * sizeof(_satl_node_t));
+                sky->num_nodes--;
+                i--;
+            }
+            else {
+                break;
+            }
+        }
+        else {
+            break;
+        }
+    }
+    /* merge neighbours at the same height */
+    for (int i = 0; i < (sky->num_nodes - 1); i++) {
+        if (sky->nodes[i].y == sky->nodes[i + 1].y) {
+            sky->nodes[i].w += sky->nodes[i + 1].w;
+            memmove(&sky->nodes[i + 1], &sky->nodes[i + 2], (size_t)(sky->num_nodes - i - 2) * sizeof(_satl_node_t));
+            sky->num_nodes--;
+            i--;
+        }
+    }
+}
+
+/* pack a padded rectangle into the first page with room, returns the page index or -1 */
+static int _satl_pack(_satl_skyline_t* skylines, int* num_pages, int w, int h, int* out_x, int* out_y) {
+    for (int page = 0; page < _satl.desc.max_pages; page++) {
+        if (page == *num_pages) {
+            _satl_skyline_reset(&skylines[page]);
+        }
+        int y = 0;
+        const int index = _satl_skyline_find(&skylines[page], w, h, &y);
+        if (index >= 0) {
+            *out_x = skylines[page].nodes[index].x;
+            *out_y = y;
+            _satl_skyline_insert(&skylines[page], index, w, h, y);
+            *num_pages = _satl_max(*num_pages, page + 1);
+            return page;
+        }
+        if (page == *num_pages) {
+            /* doesn't even fit into an empty page */
+            return -1;
+        }
+    }
+    return -1;
+}
+
+/*-- pixel data --------------------------------------------------------------*/
+static uint8_t* _satl_page_pixels(uint8_t* pixels, int page) {
+    return pixels + (size_t)page * (size_t)_satl.page_bytes;
+}
+
+static void _satl_rect_add(_satl_rect_t* r, int x0, int y0, int x1, int y1) {
+    if (r->x0 >= r->x1) {
+        r->x0 = x0; r->y0 = y0; r->x1 = x1; r->y1 = y1;
+    }
+    else {
+        r->x0 = _satl_min(r->x0, x0);
+        r->y0 = _satl_min(r->y0, y0);
+        r->x1 = _satl_max(r->x1, x1);
+        r->y1 = _satl_max(r->y1, y1);
+    }
+}
+
+/* copy an image into a page, and replicate its edge pixels into the padding */
+static void _satl_write_pixels(uint8_t* page_pixels, const _satl_slot_t* slot, const uint8_t* src, int src_pitch) {
+    const int p = _satl.padding;
+    const int dst_pitch = _satl.desc.width * 4;
+    for (int y = -p; y < (slot->h + p); y++) {
+        const int sy = _satl_min(_satl_max(y, 0), slot->h - 1);
+        const uint8_t* src_row = src + sy * src_pitch;
+        uint8_t* dst_row = page_pixels + (slot->y + y) * dst_pitch + slot->x * 4;
+        memcpy(dst_row, src_row, (size_t)slot->w * 4);
+        for (int x = 1; x <= p; x++) {
+            memcpy(dst_row - x * 4, src_row, 4);
+            memcpy(dst_row + (slot->w - 1 + x) * 4, src_row + (slot->w - 1) * 4, 4);
+        }
+    }
+}
+
+static void _satl_mark_dirty(const _satl_slot_t* slot) {
+    const int p = _satl.padding;
+    _satl_rect_add(&_satl.pages[slot->page].dirty, slot->x - p, slot->y - p, slot->x + slot->w + p, slot->y + slot->h + p);
+}
+
+/* make room for pages in the CPU copy (only grows in 2D mode) */
+static void _satl_grow_pixels(int num_pages) {
+    if (num_pages <= _satl.cap_pages) {
+        return;
+    }
+    const int new_cap = _satl_min(_satl_max(num_pages, _satl.cap_pages * 2), _satl.desc.max_pages);
+    uint8_t* new_pixels = (uint8_t*) SOKOL_MALLOC((size_t)new_cap * (size_t)_satl.page_bytes);
+    SOKOL_ASSERT(new_pixels);
+    memset(new_pixels, 0, (size_t)new_cap * (size_t)_satl.page_bytes);
+    if (_satl.pixels) {
+        memcpy(new_pixels, _satl.pixels, (size_t)_satl.cap_pages * (size_t)_satl.page_bytes);
+        SOKOL_FREE(_satl.pixels);
+    }
+    _satl.pixels = new_pixels;
+    _satl.cap_pages = new_cap;
+}
+
+static sg_image _satl_make_image(int num_layers) {
+    sg_image_desc img_desc;
+    memset(&img_desc, 0, sizeof(img_desc));
+    img_desc.type = _satl.desc.type;
+    img_desc.width = _satl.desc.width;
+    img_desc.height = _satl.desc.height;
+    img_desc.num_slices = num_layers;
+    img_desc.usage = SG_USAGE_DYNAMIC;
+    img_desc.pixel_format = SG_PIXELFORMAT_RGBA8;
+    img_desc.min_filter = _satl.desc.min_filter;
+    img_desc.mag_filter = _satl.desc.mag_filter;
+    img_desc.wrap_u = SG_WRAP_CLAMP_TO_EDGE;
+    img_desc.wrap_v = SG_WRAP_CLAMP_TO_EDGE;
+    img_desc.label = _satl.desc.label;
+    return sg_make_image(&img_desc);
+}
+
+/*-- region slots ------------------------------------------------------------*/
+static _satl_slot_t* _satl_lookup(satl_region reg) {
+    if (reg.id != SATL_INVALID_ID) {
+        const int slot_index = (int)(reg.id & _SATL_SLOT_MASK) - 1;
+        if ((slot_index >= 0) && (slot_index < _satl.desc.max_regions)) {
+            _satl_slot_t* slot = &_satl.slots[slot_index];
+            if (slot->id == reg.id) {
+                return slot;
+            }
+        }
+    }
+    return 0;
+}
+
+/* sort regions by height, then width (both descending) for repacking */
+static int _satl_cmp_slots(const void* a, const void* b) {
+    const _satl_slot_t* sa = &_satl.slots[*(const int*)a];
+    const _satl_slot_t* sb = &_satl.slots[*(const int*)b];
+    if (sa->h != sb->h) {
+        return sb->h - sa->h;
+    }
+    if (sa->w != sb->w) {
+        return sb->w - sa->w;
+    }
+    return *(const int*)a - *(const int*)b;
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL void satl_setup(const satl_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    memset(&_satl, 0, sizeof(_satl));
+    _satl.init_cookie = _SATL_INIT_COOKIE;
+    _satl.desc = _satl_desc_defaults(desc);
+    SOKOL_ASSERT((_satl.desc.type == SG_IMAGETYPE_2D) || (_satl.desc.type == SG_IMAGETYPE_ARRAY));
+    SOKOL_ASSERT((_satl.desc.width > 0) && (_satl.desc.height > 0));
+    SOKOL_ASSERT(_satl.desc.max_pages > 0);
+    SOKOL_ASSERT((_satl.desc.max_regions > 0) && (_satl.desc.max_regions <= _SATL_SLOT_MASK));
+    _satl.padding = _satl.desc.no_padding ? 0 : 1;
+    _satl.page_bytes = _satl.desc.width * _satl.desc.height * 4;
+    const int max_pages = _satl.desc.max_pages;
+    _satl.pages = (_satl_page_t*) SOKOL_MALLOC((size_t)max_pages * sizeof(_satl_page_t));
+    SOKOL_ASSERT(_satl.pages);
+    memset(_satl.pages, 0, (size_t)max_pages * sizeof(_satl_page_t));
+    _satl.node_buf = (_satl_node_t*) SOKOL_MALLOC((size_t)max_pages * (size_t)_satl.desc.width * sizeof(_satl_node_t));
+    SOKOL_ASSERT(_satl.node_buf);
+    _satl.skylines = (_satl_skyline_t*) SOKOL_MALLOC((size_t)max_pages * sizeof(_satl_skyline_t));
+    SOKOL_ASSERT(_satl.skylines);
+    for (int i = 0; i < max_pages; i++) {
+        _satl.skylines[i].nodes = &_satl.node_buf[i * _satl.desc.width];
+        _satl.skylines[i].num_nodes = 0;
+    }
+    const int max_regions = _satl.desc.max_regions;
+    _satl.slots = (_satl_slot_t*) SOKOL_MALLOC((size_t)max_regions * sizeof(_satl_slot_t));
+    SOKOL_ASSERT(_satl.slots);
+    memset(_satl.slots, 0, (size_t)max_regions * sizeof(_satl_slot_t));
+    _satl.free_slots = (int*) SOKOL_MALLOC((size_t)max_regions * sizeof(int));
+    SOKOL_ASSERT(_satl.free_slots);
+    for (int i = max_regions - 1; i >= 0; i--) {
+        _satl.free_slots[_satl.num_free_slots++] = i;
+    }
+    if (_satl.desc.type == SG_IMAGETYPE_ARRAY) {
+        /* the upload data of an array image must contain all layers */
+        _satl_grow_pixels(max_pages);
+        _satl.array_img = _satl_make_image(max_pages);
+    }
+}
+
+SOKOL_API_IMPL void satl_shutdown(void) {
+    SOKOL_ASSERT(_SATL_INIT_COOKIE == _satl.init_cookie);
+    if (_satl.desc.type == SG_IMAGETYPE_ARRAY) {
+        sg_destroy_image(_satl.array_img);
+    }
+    else {
+        for (int i = 0; i < _satl.desc.max_pages; i++) {
+            if (_satl.pages[i].img.id != SG_INVALID_ID) {
+                sg_destroy_image(_satl.pages[i].img);
+            }
+        }
+    }
+    if (_satl.pixels) {
+        SOKOL_FREE(_satl.pixels); _satl.pixels = 0;
+    }
+    SOKOL_FREE(_satl.free_slots); _satl.free_slots = 0;
+    SOKOL_FREE(_satl.slots); _satl.slots = 0;
+    SOKOL_FREE(_satl.node_buf); _satl.node_buf = 0;
+    SOKOL_FREE(_satl.skylines); _satl.skylines = 0;
+    SOKOL_FREE(_satl.pages); _satl.pages = 0;
+    _satl.init_cookie = 0;
+}
+
+SOKOL_API_IMPL satl_region satl_add_image(const satl_image_desc_t* desc) {
+    SOKOL_ASSERT(_SATL_INIT_COOKIE == _satl.init_cookie);
+    SOKOL_ASSERT(desc && desc->pixels && (desc->width > 0) && (desc->height > 0));
+    satl_region res = { SATL_INVALID_ID };
+    if (0 == _satl.num_free_slots) {
+        return res;
+    }
+    const int p = _satl.padding;
+    int x = 0, y = 0;
+    const int page = _satl_pack(_satl.skylines, &_satl.num_pages, desc->width + 2 * p, desc->height + 2 * p, &x, &y);
+    if (page < 0) {
+        return res;
+    }
+    _satl_grow_pixels(_satl.num_pages);
+    if ((_satl.desc.type == SG_IMAGETYPE_2D) && (_satl.pages[page].img.id == SG_INVALID_ID)) {
+        _satl.pages[page].img = _satl_make_image(1);
+    }
+
+    const int slot_index = _satl.free_slots[--_satl.num_free_slots];
+    _satl_slot_t* slot = &_satl.slots[slot_index];
+    _satl.unique_counter = (_satl.unique_counter + 1) & ((1u<<(32-_SATL_SLOT_SHIFT))-1);
+    if (0 == _satl.unique_counter) {
+        _satl.unique_counter = 1;
+    }
+    slot->id = (_satl.unique_counter << _SATL_SLOT_SHIFT) | (uint32_t)(slot_index + 1);
+    slot->page = page;
+    slot->x = x + p;
+    slot->y = y + p;
+    slot->w = desc->width;
+    slot->h = desc->height;
+    _satl_write_pixels(_satl_page_pixels(_satl.pixels, page), slot, (const uint8_t*)desc->pixels, _satl_def(desc->row_pitch, desc->width * 4));
+    _satl_mark_dirty(slot);
+    _satl.used_pixels += slot->w * slot->h;
+    res.id = slot->id;
+    return res;
+}
+
+SOKOL_API_IMPL void satl_update_image(satl_region reg, const void* pixels, int row_pitch) {
+    SOKOL_ASSERT(_SATL_INIT_COOKIE == _satl.init_cookie);
+    SOKOL_ASSERT(pixels);
+    const _satl_slot_t* slot = _satl_lookup(reg);
+    if (slot) {
+        _satl_write_pixels(_satl_page_pixels(_satl.pixels, slot->page), slot, (const uint8_t*)pixels, _satl_def(row_pitch, slot->w * 4));
+        _satl_mark_dirty(slot);
+    }
+}
+
+SOKOL_API_IMPL void satl_remove_image(satl_region reg) {
+    SOKOL_ASSERT(_SATL_INIT_COOKIE == _satl.init_cookie);
+    _satl_slot_t* slot = _satl_lookup(reg);
+    if (slot) {
+        const int p = _satl.padding;
+        _satl.used_pixels -= slot->w * slot->h;
+        _satl.lost_pixels += (slot->w + 2 * p) * (slot->h + 2 * p);
+        slot->id = SATL_INVALID_ID;
+        _satl.free_slots[_satl.num_free_slots++] = (int)(slot - _satl.slots);
+    }
+}
+
+SOKOL_API_IMPL bool satl_query_region_valid(satl_region reg) {
+    SOKOL_ASSERT(_SATL_INIT_COOKIE == _satl.init_cookie);
+    return 0 != _satl_lookup(reg);
+}
+
+SOKOL_API_IMPL satl_region_info_t satl_query_region(satl_region reg) {
+    SOKOL_ASSERT(_SATL_INIT_COOKIE == _satl.init_cookie);
+    satl_region_info_t info;
+    memset(&info, 0, sizeof(info));
+    const _satl_slot_t* slot = _satl_lookup(reg);
+    if (slot) {
+        info.image = (_satl.desc.type == SG_IMAGETYPE_ARRAY) ? _satl.array_img : _satl.pages[slot->page].img;
+        info.layer = slot->page;
+        info.x = slot->x;
+        info.y = slot->y;
+        info.width = slot->w;
+        info.height = slot->h;
+        info.uv_scale[0] = (float)slot->w / (float)_satl.desc.width;
+        info.uv_scale[1] = (float)slot->h / (float)_satl.desc.height;
+        info.uv_offset[0] = (float)slot->x / (float)_satl.desc.width;
+        info.uv_offset[1] = (float)slot->y / (float)_satl.desc.height;
+    }
+    return info;
+}
+
+SOKOL_API_IMPL void satl_commit(void) {
+    SOKOL_ASSERT(_SATL_INIT_COOKIE == _satl.init_cookie);
+    _satl.stats.num_uploads = 0;
+    _satl.stats.upload_bytes = 0;
+    _satl.stats.dirty_bytes = 0;
+    bool any_dirty = false;
+    for (int i = 0; i < _satl.num_pages; i++) {
+        _satl_rect_t* dirty = &_satl.pages[i].dirty;
+        if (dirty->x0 < dirty->x1) {
+            any_dirty = true;
+            _satl.stats.dirty_bytes += (dirty->x1 - dirty->x0) * (dirty->y1 - dirty->y0) * 4;
+            if (_satl.desc.type == SG_IMAGETYPE_2D) {
+                sg_image_content content;
+                memset(&content, 0, sizeof(content));
+                content.subimage[0][0].ptr = _satl_page_pixels(_satl.pixels, i);
+                content.subimage[0][0].size = _satl.page_bytes;
+                sg_update_image(_satl.pages[i].img, &content);
+                _satl.stats.num_uploads++;
+                _satl.stats.upload_bytes += _satl.page_bytes;
+            }
+            memset(dirty, 0, sizeof(_satl_rect_t));
+        }
+    }
+    if (any_dirty && (_satl.desc.type == SG_IMAGETYPE_ARRAY)) {
+        sg_image_content content;
+        memset(&content, 0, sizeof(content));
+        content.subimage[0][0].ptr = _satl.pixels;
+        content.subimage[0][0].size = _satl.page_bytes * _satl.desc.max_pages;
+        sg_update_image(_satl.array_img, &content);
+        _satl.stats.num_uploads++;
+        _satl.stats.upload_bytes += content.subimage[0][0].size;
+    }
+}
+
+SOKOL_API_IMPL bool satl_defrag(void) {
+    SOKOL_ASSERT(_SATL_INIT_COOKIE == _satl.init_cookie);
+    const int max_pages = _satl.desc.max_pages;
+    const int max_regions = _satl.desc.max_regions;
+    const int p = _satl.padding;
+
+    /* gather the live regions, largest first */
+    int* order = (int*) SOKOL_MALLOC((size_t)max_regions * sizeof(int));
+    SOKOL_ASSERT(order);
+    int num = 0;
+    for (int i = 0; i < max_regions; i++) {
+        if (_satl.slots[i].id != SATL_INVALID_ID) {
+            order[num++] = i;
+        }
+    }
+    qsort(order, (size_t)num, sizeof(int), _satl_cmp_slots);
+
+    /* pack into fresh skylines, the current state stays untouched until everything fits */
+    _satl_node_t* node_buf = (_satl_node_t*) SOKOL_MALLOC((size_t)max_pages * (size_t)_satl.desc.width * sizeof(_satl_node_t));
+    _satl_skyline_t* skylines = (_satl_skyline_t*) SOKOL_MALLOC((size_t)max_pages * sizeof(_satl_skyline_t));
+    _satl_slot_t* new_slots = (_satl_slot_t*) SOKOL_MALLOC((size_t)num * sizeof(_satl_slot_t));
+    SOKOL_ASSERT(node_buf && skylines && (new_slots || (0 == num)));
+    for (int i = 0; i < max_pages; i++) {
+        skylines[i].nodes = &node_buf[i * _satl.desc.width];
+        skylines[i].num_nodes = 0;
+    }
+    int num_pages = 0;
+    bool success = true;
+    for (int i = 0; i < num; i++) {
+        const _satl_slot_t* slot = &_satl.slots[order[i]];
+        int x = 0, y = 0;
+        const int page = _satl_pack(skylines, &num_pages, slot->w + 2 * p, slot->h + 2 * p, &x, &y);
+        if (page < 0) {
+            success = false;
+            break;
+        }
+        new_slots[i] = *slot;
+        new_slots[i].page = page;
+        new_slots[i].x = x + p;
+        new_slots[i].y = y + p;
+    }
+
+    if (success) {
+        /* move the pixels (including the padding) into a new CPU copy */
+        const int cap_pages = _satl.cap_pages;
+        uint8_t* new_pixels = (uint8_t*) SOKOL_MALLOC((size_t)cap_pages * (size_t)_satl.page_bytes);
+        SOKOL_ASSERT(new_pixels);
+        memset(new_pixels, 0, (size_t)cap_pages * (size_t)_satl.page_bytes);
+        const int pitch = _satl.desc.width * 4;
+        for (int i = 0; i < num; i++) {
+            const _satl_slot_t* src = &_satl.slots[order[i]];
+            const _satl_slot_t* dst = &new_slots[i];
+            const uint8_t* src_pixels = _satl_page_pixels(_satl.pixels, src->page);
+            uint8_t* dst_pixels = _satl_page_pixels(new_pixels, dst->page);
+            for (int y = -p; y < (src->h + p); y++) {
+                memcpy(dst_pixels + (dst->y + y) * pitch + (dst->x - p) * 4,
+                       src_pixels + (src->y + y) * pitch + (src->x - p) * 4,
+                       (size_t)(src->w + 2 * p) * 4);
+            }
+        }
+        SOKOL_FREE(_satl.pixels);
+        _satl.pixels = new_pixels;
+        for (int i = 0; i < num; i++) {
+            _satl.slots[order[i]] = new_slots[i];
+        }
+        for (int i = 0; i < num_pages; i++) {
+            _satl.skylines[i].num_nodes = skylines[i].num_nodes;
+            memcpy(_satl.skylines[i].nodes, skylines[i].nodes, (size_t)skylines[i].num_nodes * sizeof(_satl_node_t));
+        }
+        /* all pages need to be uploaded, including pages which are empty now */
+        for (int i = 0; i < _satl.num_pages; i++) {
+            _satl.pages[i].dirty.x0 = 0;
+            _satl.pages[i].dirty.y0 = 0;
+            _satl.pages[i].dirty.x1 = _satl.desc.width;
+            _satl.pages[i].dirty.y1 = _satl.desc.height;
+        }
+        for (int i = num_pages; i < _satl.num_pages; i++) {
+            _satl_skyline_reset(&_satl.skylines[i]);
+        }
+        _satl.num_pages = _satl_max(num_pages, _satl.num_pages);
+        _satl.lost_pixels = 0;
+        _satl.stats.num_defrags++;
+    }
+    if (new_slots) {
+        SOKOL_FREE(new_slots);
+    }
+    SOKOL_FREE(skylines);
+    SOKOL_FREE(node_buf);
+    SOKOL_FREE(order);
+    return success;
+}
+
+SOKOL_API_IMPL satl_stats_t satl_query_stats(void) {
+    SOKOL_ASSERT(_SATL_INIT_COOKIE == _satl.init_cookie);
+    satl_stats_t stats = _satl.stats;
+    /* only count pages which actually contain images */
+    int num_pages = 0;
+    for (int i = 0; i < _satl.desc.max_regions; i++) {
+        if (_satl.slots[i].id != SATL_INVALID_ID) {
+            num_pages = _satl_max(num_pages, _satl.slots[i].page + 1);
+        }
+    }
+    stats.num_pages = num_pages;
+    stats.num_regions = _satl.desc.max_regions - _satl.num_free_slots;
+    stats.used_pixels = _satl.used_pixels;
+    stats.lost_pixels = _satl.lost_pixels;
+    stats.capacity_pixels = num_pages * _satl.desc.width * _satl.desc.height;
+    stats.occupancy = (stats.capacity_pixels > 0) ? ((float)stats.used_pixels / (float)stats.capacity_pixels) : 0.0f;
+    return stats;
+}
+
+#endif /* SOKOL_ATLAS_IMPL */
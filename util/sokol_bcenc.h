@@ -0,0 +1,1021 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_BCENC_IMPL)
+#define SOKOL_BCENC_IMPL
+#endif
+#ifndef SOKOL_BCENC_INCLUDED
+/*
+    sokol_bcenc.h -- encode RGBA8 images into BCn-compressed sokol_gfx.h images
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_BCENC_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_bcenc.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_BCENC_NO_SIMD - don't use the SSE2 or NEON code paths
+    SOKOL_BCENC_API_DECL - public function declaration prefix (default: extern)
+    SOKOL_API_DECL      - same as SOKOL_BCENC_API_DECL
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+
+    If sokol_bcenc.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_BCENC_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_bcenc.h compresses the RGBA8 pixel data of a 2D- or cubemap-image
+    (including all mipmaps) into one of the following block-compressed
+    pixel formats:
+
+        SG_PIXELFORMAT_BC1_RGBA     - RGB with 1-bit alpha, 8 bytes per 4x4 block
+        SG_PIXELFORMAT_BC3_RGBA     - RGBA, 16 bytes per 4x4 block
+        SG_PIXELFORMAT_BC4_R        - the R channel, 8 bytes per 4x4 block
+        SG_PIXELFORMAT_BC5_RG       - the R and G channels, 16 bytes per 4x4 block
+        SG_PIXELFORMAT_BC7_RGBA     - RGBA, 16 bytes per 4x4 block (only mode 6 is used)
+
+    The result is written into an sg_image_content struct which can be
+    plugged directly into sg_image_desc.content.
+
+    There are three quality tiers:
+
+        SBC_QUALITY_FAST    - endpoints from the bounding box of the block colors
+        SBC_QUALITY_NORMAL  - endpoints along the principal axis of the block colors,
+                              refined once with a least-squares fit (default)
+        SBC_QUALITY_HIGH    - like NORMAL, but with more refinement iterations,
+                              and the bounding box is tried as well
+
+    The hot loops (projecting pixels onto the endpoint line and measuring the
+    block error) are vectorized with SSE2 on x86 and NEON on ARM, on all
+    other platforms (or if SOKOL_BCENC_NO_SIMD is defined) scalar code is used.
+
+    sokol_bcenc.h doesn't create threads, instead the work is split into
+    jobs of up to 8 block rows which can be encoded in parallel on the
+    application's own worker threads (see below).
+
+    Please note that the encoder has been written for runtime-generated
+    content, it's fast but doesn't try to match the quality of offline
+    texture compression tools.
+
+    STEP BY STEP
+    ============
+    --- describe the image with an sbc_desc_t struct:
+
+        ```c
+        sbc_desc_t desc = {
+            .type = SG_IMAGETYPE_2D,            // or SG_IMAGETYPE_CUBE
+            .pixel_format = SG_PIXELFORMAT_BC7_RGBA,
+            .quality = SBC_QUALITY_NORMAL,
+            .width = 256,
+            .height = 256,
+            .num_mipmaps = 9,
+        };
+        ```
+
+    --- ask for the size of the memory buffer which will receive the
+        compressed data and provide the buffer:
+
+        ```c
+        desc.buffer.size = sbc_buffer_size(&desc);
+        desc.buffer.ptr = malloc(desc.buffer.size);
+        ```
+
+    --- provide the RGBA8 pixel data in an sg_image_content struct (for
+        instance generated with sokol_mipmap.h), and encode the image:
+
+        ```c
+        sg_image_content content;
+        if (sbc_encode(&desc, &rgba8_content, &content)) {
+            sg_image img = sg_make_image(&(sg_image_desc){
+                .width = 256,
+                .height = 256,
+                .num_mipmaps = 9,
+                .pixel_format = SG_PIXELFORMAT_BC7_RGBA,
+                .content = content
+            });
+        }
+        free(desc.buffer.ptr);
+        ```
+
+    --- ...or to encode the image on multiple threads, ask for the number of
+        jobs, call sbc_encode_job() for each job index (from any thread, but
+        each job index only once), and when all jobs have finished, get the
+        sg_image_content struct with sbc_image_content():
+
+        ```c
+        const int num_jobs = sbc_num_jobs(&desc);
+        for (int i = 0; i < num_jobs; i++) {
+            // on a worker thread:
+            sbc_encode_job(&desc, &rgba8_content, i);
+        }
+        // ...after all jobs have finished:
+        sg_image_content content = sbc_image_content(&desc);
+        ```
+
+    The sbc_desc_t struct, the source pixel data and the destination buffer
+    must not be modified until all jobs have finished.
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2020 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_BCENC_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_bcenc.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_BCENC_API_DECL)
+#define SOKOL_BCENC_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_BCENC_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_BCENC_IMPL)
+#define SOKOL_BCENC_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_BCENC_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_BCENC_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum sbc_quality_t {
+    _SBC_QUALITY_DEFAULT,       /* value 0 reserved for default-init */
+    SBC_QUALITY_FAST,
+    SBC_QUALITY_NORMAL,
+    SBC_QUALITY_HIGH,
+    _SBC_QUALITY_NUM,
+    _SBC_QUALITY_FORCE_U32 = 0x7FFFFFFF
+} sbc_quality_t;
+
+typedef struct sbc_buffer_t {
+    void* ptr;
+    int size;
+} sbc_buffer_t;
+
+typedef struct sbc_desc_t {
+    sg_image_type type;             /* SG_IMAGETYPE_2D (default) or SG_IMAGETYPE_CUBE */
+    sg_pixel_format pixel_format;   /* default: SG_PIXELFORMAT_BC7_RGBA */
+    sbc_quality_t quality;          /* default: SBC_QUALITY_NORMAL */
+    int width;
+    int height;
+    int num_mipmaps;                /* default: 1 */
+    sbc_buffer_t buffer;            /* receives the compressed data */
+} sbc_desc_t;
+
+SOKOL_BCENC_API_DECL int sbc_buffer_size(const sbc_desc_t* desc);
+SOKOL_BCENC_API_DECL bool sbc_encode(const sbc_desc_t* desc, const sg_image_content* src, sg_image_content* dst);
+SOKOL_BCENC_API_DECL int sbc_num_jobs(const sbc_desc_t* desc);
+SOKOL_BCENC_API_DECL bool sbc_encode_job(const sbc_desc_t* desc, const sg_image_content* src, int job_index);
+SOKOL_BCENC_API_DECL sg_image_content sbc_image_content(const sbc_desc_t* desc);
+
+#ifdef __cplusplus
+} /* extern "C" */
+
+/* reference-based equivalents for c++ */
+inline int sbc_buffer_size(const sbc_desc_t& desc) { return sbc_buffer_size(&desc); }
+inline bool sbc_encode(const sbc_desc_t& desc, const sg_image_content& src, sg_image_content& dst) { return sbc_encode(&desc, &src, &dst); }
+inline int sbc_num_jobs(const sbc_desc_t& desc) { return sbc_num_jobs(&desc); }
+inline bool sbc_encode_job(const sbc_desc_t& desc, const sg_image_content& src, int job_index) { return sbc_encode_job(&desc, &src, job_index); }
+inline sg_image_content sbc_image_content(const sbc_desc_t& desc) { return sbc_image_content(&desc); }
+
+#endif
+#endif /* SOKOL_BCENC_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_BCENC_IMPL
+#define SOKOL_BCENC_IMPL_INCLUDED (1)
+
+#include <string.h> // memset
+#include <float.h>  // FLT_MAX
+#include <math.h>   // sqrtf, fabsf
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#if !defined(SOKOL_BCENC_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define _SBC_SSE2 (1)
+        #include <emmintrin.h>
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define _SBC_NEON (1)
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#define _sbc_def(val, def) (((val) == 0) ? (def) : (val))
+#define _SBC_JOB_BLOCK_ROWS (8)
+
+/* a 4x4 pixel block, channels are stored separately (r[16], g[16], b[16], a[16])
+   in the 0..255 range to allow processing 4 pixels at once with SIMD
+*/
+typedef struct {
+    float ch[4][16];
+} _sbc_block_t;
+
+/* the interpolation factors of a block palette, from endpoint 0 to endpoint 1 */
+typedef struct {
+    int num_levels;
+    float frac[16];
+} _sbc_palette_t;
+
+static const _sbc_palette_t _sbc_palette_bc1_4 = { 4, { 0.0f, 1.0f/3.0f, 2.0f/3.0f, 1.0f } };
+static const _sbc_palette_t _sbc_palette_bc1_3 = { 3, { 0.0f, 0.5f, 1.0f } };
+static const _sbc_palette_t _sbc_palette_bc4 = { 8, { 0.0f, 1.0f/7.0f, 2.0f/7.0f, 3.0f/7.0f, 4.0f/7.0f, 5.0f/7.0f, 6.0f/7.0f, 1.0f } };
+static const _sbc_palette_t _sbc_palette_bc7 = { 16, {
+    0.0f/64.0f, 4.0f/64.0f, 9.0f/64.0f, 13.0f/64.0f, 17.0f/64.0f, 21.0f/64.0f, 26.0f/64.0f, 30.0f/64.0f,
+    34.0f/64.0f, 38.0f/64.0f, 43.0f/64.0f, 47.0f/64.0f, 51.0f/64.0f, 55.0f/64.0f, 60.0f/64.0f, 64.0f/64.0f
+} };
+
+/* how endpoints are stored in the compressed block */
+typedef enum {
+    _SBC_ENDPOINTS_RGB565,
+    _SBC_ENDPOINTS_U8,
+    _SBC_ENDPOINTS_RGBA7P,     /* BC7 mode 6: 7 bits per channel plus a shared p-bit */
+} _sbc_endpoint_format_t;
+
+typedef struct {
+    float e[2][4];      /* endpoints as seen by the decoder (0..255) */
+    int q[2][4];        /* quantized endpoint components */
+    int p[2];           /* p-bits (only BC7) */
+} _sbc_endpoints_t;
+
+/* a range of block rows of one surface */
+typedef struct {
+    int face_index;
+    int mip_index;
+    int width;
+    int height;
+    int first_block_row;
+    int num_block_rows;
+    int dst_offset;
+} _sbc_job_t;
+
+_SOKOL_PRIVATE int _sbc_min(int a, int b) {
+    return (a < b) ? a : b;
+}
+
+_SOKOL_PRIVATE int _sbc_max(int a, int b) {
+    return (a > b) ? a : b;
+}
+
+_SOKOL_PRIVATE int _sbc_clamp(int v, int lo, int hi) {
+    return (v < lo) ? lo : ((v > hi) ? hi : v);
+}
+
+_SOKOL_PRIVATE float _sbc_clampf(float v, float lo, float hi) {
+    return (v < lo) ? lo : ((v > hi) ? hi : v);
+}
+
+_SOKOL_PRIVATE int _sbc_block_size(sg_pixel_format fmt) {
+    switch (fmt) {
+        case SG_PIXELFORMAT_BC1_RGBA:
+        case SG_PIXELFORMAT_BC4_R:
+            return 8;
+        case SG_PIXELFORMAT_BC3_RGBA:
+        case SG_PIXELFORMAT_BC5_RG:
+        case SG_PIXELFORMAT_BC7_RGBA:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+_SOKOL_PRIVATE sbc_desc_t _sbc_desc_defaults(const sbc_desc_t* desc) {
+    sbc_desc_t res = *desc;
+    res.type = _sbc_def(res.type, SG_IMAGETYPE_2D);
+    res.pixel_format = _sbc_def(res.pixel_format, SG_PIXELFORMAT_BC7_RGBA);
+    res.quality = _sbc_def(res.quality, SBC_QUALITY_NORMAL);
+    res.num_mipmaps = _sbc_def(res.num_mipmaps, 1);
+    return res;
+}
+
+_SOKOL_PRIVATE bool _sbc_desc_valid(const sbc_desc_t* desc) {
+    return (desc->width > 0) && (desc->height > 0) &&
+           (desc->num_mipmaps > 0) && (desc->num_mipmaps <= SG_MAX_MIPMAPS) &&
+           ((desc->type == SG_IMAGETYPE_2D) || (desc->type == SG_IMAGETYPE_CUBE)) &&
+           (desc->quality > _SBC_QUALITY_DEFAULT) && (desc->quality < _SBC_QUALITY_NUM) &&
+           (_sbc_block_size(desc->pixel_format) > 0);
+}
+
+_SOKOL_PRIVATE int _sbc_num_faces(const sbc_desc_t* desc) {
+    return (desc->type == SG_IMAGETYPE_CUBE) ? SG_CUBEFACE_NUM : 1;
+}
+
+_SOKOL_PRIVATE int _sbc_mip_dim(int dim, int mip_index) {
+    return _sbc_max(dim >> mip_index, 1);
+}
+
+_SOKOL_PRIVATE int _sbc_surface_size(const sbc_desc_t* desc, int mip_index) {
+    const int blocks_x = (_sbc_mip_dim(desc->width, mip_index) + 3) / 4;
+    const int blocks_y = (_sbc_mip_dim(desc->height, mip_index) + 3) / 4;
+    return blocks_x * blocks_y * _sbc_block_size(desc->pixel_format);
+}
+
+_SOKOL_PRIVATE int _sbc_num_surface_jobs(const sbc_desc_t* desc, int mip_index) {
+    const int blocks_y = (_sbc_mip_dim(desc->height, mip_index) + 3) / 4;
+    return (blocks_y + _SBC_JOB_BLOCK_ROWS - 1) / _SBC_JOB_BLOCK_ROWS;
+}
+
+/* find the surface and block rows of a job, surfaces are stored face by face,
+   and mipmap by mipmap within a face
+*/
+_SOKOL_PRIVATE bool _sbc_lookup_job(const sbc_desc_t* desc, int job_index, _sbc_job_t* job) {
+    int offset = 0;
+    for (int face_index = 0; face_index < _sbc_num_faces(desc); face_index++) {
+        for (int mip_index = 0; mip_index < desc->num_mipmaps; mip_index++) {
+            const int num_jobs = _sbc_num_surface_jobs(desc, mip_index);
+            if (job_index < num_jobs) {
+                job->face_index = face_index;
+                job->mip_index = mip_index;
+                job->width = _sbc_mip_dim(desc->width, mip_index);
+                job->height = _sbc_mip_dim(desc->height, mip_index);
+                job->first_block_row = job_index * _SBC_JOB_BLOCK_ROWS;
+                const int blocks_x = (job->width + 3) / 4;
+                const int blocks_y = (job->height + 3) / 4;
+                job->num_block_rows = _sbc_min(_SBC_JOB_BLOCK_ROWS, blocks_y - job->first_block_row);
+                job->dst_offset = offset + job->first_block_row * blocks_x * _sbc_block_size(desc->pixel_format);
+                return true;
+            }
+            job_index -= num_jobs;
+            offset += _sbc_surface_size(desc, mip_index);
+        }
+    }
+    return false;
+}
+
+/*-- SIMD kernels ------------------------------------------------------------*/
+
+/* project the block pixels onto the line from e0 to e1, the result is
+   clamped to the 0..1 range
+*/
+_SOKOL_PRIVATE void _sbc_project(const _sbc_block_t* blk, int c0, int nc, const float* e0, const float* e1, float* t) {
+    float d[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float dd = 0.0f;
+    for (int c = 0; c < nc; c++) {
+        d[c] = e1[c] - e0[c];
+        dd += d[c] * d[c];
+    }
+    if (dd < 1e-8f) {
+        memset(t, 0, 16 * sizeof(float));
+        return;
+    }
+    const float inv_dd = 1.0f / dd;
+    #if defined(_SBC_SSE2)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(inv_dd);
+        for (int i = 0; i < 16; i += 4) {
+            __m128 acc = zero;
+            for (int c = 0; c < nc; c++) {
+                const __m128 p = _mm_sub_ps(_mm_loadu_ps(&blk->ch[c0 + c][i]), _mm_set1_ps(e0[c]));
+                acc = _mm_add_ps(acc, _mm_mul_ps(p, _mm_set1_ps(d[c])));
+            }
+            _mm_storeu_ps(t + i, _mm_min_ps(_mm_max_ps(_mm_mul_ps(acc, scale), zero), one));
+        }
+    #elif defined(_SBC_NEON)
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        for (int i = 0; i < 16; i += 4) {
+            float32x4_t acc = zero;
+            for (int c = 0; c < nc; c++) {
+                const float32x4_t p = vsubq_f32(vld1q_f32(&blk->ch[c0 + c][i]), vdupq_n_f32(e0[c]));
+                acc = vmlaq_n_f32(acc, p, d[c]);
+            }
+            vst1q_f32(t + i, vminq_f32(vmaxq_f32(vmulq_n_f32(acc, inv_dd), zero), one));
+        }
+    #else
+        for (int i = 0; i < 16; i++) {
+            float acc = 0.0f;
+            for (int c = 0; c < nc; c++) {
+                acc += (blk->ch[c0 + c][i] - e0[c]) * d[c];
+            }
+            t[i] = _sbc_clampf(acc * inv_dd, 0.0f, 1.0f);
+        }
+    #endif
+}
+
+/* weighted squared error of the block pixels against the interpolated
+   endpoint colors at the interpolation factors f
+*/
+_SOKOL_PRIVATE float _sbc_error(const _sbc_block_t* blk, int c0, int nc, const float* w, const float* e0, const float* e1, const float* f) {
+    #if defined(_SBC_SSE2)
+        __m128 err = _mm_setzero_ps();
+        for (int i = 0; i < 16; i += 4) {
+            const __m128 fi = _mm_loadu_ps(f + i);
+            __m128 acc = _mm_setzero_ps();
+            for (int c = 0; c < nc; c++) {
+                const __m128 rec = _mm_add_ps(_mm_set1_ps(e0[c]), _mm_mul_ps(fi, _mm_set1_ps(e1[c] - e0[c])));
+                const __m128 diff = _mm_sub_ps(rec, _mm_loadu_ps(&blk->ch[c0 + c][i]));
+                acc = _mm_add_ps(acc, _mm_mul_ps(diff, diff));
+            }
+            err = _mm_add_ps(err, _mm_mul_ps(acc, _mm_loadu_ps(w + i)));
+        }
+        float res[4];
+        _mm_storeu_ps(res, err);
+        return (res[0] + res[1]) + (res[2] + res[3]);
+    #elif defined(_SBC_NEON)
+        float32x4_t err = vdupq_n_f32(0.0f);
+        for (int i = 0; i < 16; i += 4) {
+            const float32x4_t fi = vld1q_f32(f + i);
+            float32x4_t acc = vdupq_n_f32(0.0f);
+            for (int c = 0; c < nc; c++) {
+                const float32x4_t rec = vmlaq_n_f32(vdupq_n_f32(e0[c]), fi, e1[c] - e0[c]);
+                const float32x4_t diff = vsubq_f32(rec, vld1q_f32(&blk->ch[c0 + c][i]));
+                acc = vmlaq_f32(acc, diff, diff);
+            }
+            err = vmlaq_f32(err, acc, vld1q_f32(w + i));
+        }
+        float res[4];
+        vst1q_f32(res, err);
+        return (res[0] + res[1]) + (res[2] + res[3]);
+    #else
+        float err = 0.0f;
+        for (int i = 0; i < 16; i++) {
+            float acc = 0.0f;
+            for (int c = 0; c < nc; c++) {
+                const float diff = (e0[c] + f[i] * (e1[c] - e0[c])) - blk->ch[c0 + c][i];
+                acc += diff * diff;
+            }
+            err += acc * w[i];
+        }
+        return err;
+    #endif
+}
+
+/*-- endpoint fitting --------------------------------------------------------*/
+_SOKOL_PRIVATE void _sbc_load_block(const uint8_t* src, int width, int height, int bx, int by, _sbc_block_t* blk) {
+    for (int y = 0; y < 4; y++) {
+        const int sy = _sbc_min(by * 4 + y, height - 1);
+        for (int x = 0; x < 4; x++) {
+            const int sx = _sbc_min(bx * 4 + x, width - 1);
+            const uint8_t* p = src + (sy * width + sx) * 4;
+            for (int c = 0; c < 4; c++) {
+                blk->ch[c][y * 4 + x] = (float) p[c];
+            }
+        }
+    }
+}
+
+/* endpoints from the bounding box of the block colors, inset by 1/16 of the range */
+_SOKOL_PRIVATE void _sbc_fit_bbox(const _sbc_block_t* blk, int c0, int nc, const float* w, float* e0, float* e1) {
+    for (int c = 0; c < nc; c++) {
+        float lo = 255.0f;
+        float hi = 0.0f;
+        for (int i = 0; i < 16; i++) {
+            if (w[i] > 0.0f) {
+                const float v = blk->ch[c0 + c][i];
+                lo = (v < lo) ? v : lo;
+                hi = (v > hi) ? v : hi;
+            }
+        }
+        if (lo > hi) {
+            lo = hi = 0.0f;
+        }
+        const float inset = (hi - lo) / 16.0f;
+        e0[c] = lo + inset;
+        e1[c] = hi - inset;
+    }
+}
+
+/* endpoints along the principal axis of the block colors, inset by 1/16 of the range */
+_SOKOL_PRIVATE void _sbc_fit_pca(const _sbc_block_t* blk, int c0, int nc, const float* w, float* e0, float* e1) {
+    float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float sum_w = 0.0f;
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < nc; c++) {
+            mean[c] += blk->ch[c0 + c][i] * w[i];
+        }
+        sum_w += w[i];
+    }
+    if (sum_w <= 0.0f) {
+        for (int c = 0; c < nc; c++) {
+            e0[c] = e1[c] = 0.0f;
+        }
+        return;
+    }
+    for (int c = 0; c < nc; c++) {
+        mean[c] /= sum_w;
+    }
+    float cov[4][4];
+    memset(cov, 0, sizeof(cov));
+    for (int i = 0; i < 16; i++) {
+        for (int a = 0; a < nc; a++) {
+            const float da = (blk->ch[c0 + a][i] - mean[a]) * w[i];
+            for (int b = a; b < nc; b++) {
+                cov[a][b] += da * (blk->ch[c0 + b][i] - mean[b]);
+            }
+        }
+    }
+    for (int a = 0; a < nc; a++) {
+        for (int b = 0; b < a; b++) {
+            cov[a][b] = cov[b][a];
+        }
+    }
+    /* power iteration, starting with the bounding box diagonal */
+    float axis[4];
+    _sbc_fit_bbox(blk, c0, nc, w, e0, e1);
+    for (int c = 0; c < nc; c++) {
+        axis[c] = e1[c] - e0[c];
+    }
+    for (int iter = 0; iter < 8; iter++) {
+        float tmp[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float max_abs = 0.0f;
+        for (int a = 0; a < nc; a++) {
+            for (int b = 0; b < nc; b++) {
+                tmp[a] += cov[a][b] * axis[b];
+            }
+            max_abs = (fabsf(tmp[a]) > max_abs) ? fabsf(tmp[a]) : max_abs;
+        }
+        if (max_abs < 1e-6f) {
+            break;
+        }
+        for (int c = 0; c < nc; c++) {
+            axis[c] = tmp[c] / max_abs;
+        }
+    }
+    float len = 0.0f;
+    for (int c = 0; c < nc; c++) {
+        len += axis[c] * axis[c];
+    }
+    if (len < 1e-12f) {
+        /* all pixels have the same color */
+        for (int c = 0; c < nc; c++) {
+            e0[c] = e1[c] = mean[c];
+        }
+        return;
+    }
+    len = 1.0f / sqrtf(len);
+    for (int c = 0; c < nc; c++) {
+        axis[c] *= len;
+    }
+    float t_min = FLT_MAX;
+    float t_max = -FLT_MAX;
+    for (int i = 0; i < 16; i++) {
+        if (w[i] > 0.0f) {
+            float t = 0.0f;
+            for (int c = 0; c < nc; c++) {
+                t += (blk->ch[c0 + c][i] - mean[c]) * axis[c];
+            }
+            t_min = (t < t_min) ? t : t_min;
+            t_max = (t > t_max) ? t : t_max;
+        }
+    }
+    const float inset = (t_max - t_min) / 16.0f;
+    t_min += inset;
+    t_max -= inset;
+    for (int c = 0; c < nc; c++) {
+        e0[c] = _sbc_clampf(mean[c] + axis[c] * t_min, 0.0f, 255.0f);
+        e1[c] = _sbc_clampf(mean[c] + axis[c] * t_max, 0.0f, 255.0f);
+    }
+}
+
+/* least-squares fit of the endpoints for fixed interpolation factors */
+_SOKOL_PRIVATE bool _sbc_refine(const _sbc_block_t* blk, int c0, int nc, const float* w, const float* f, float* e0, float* e1) {
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float x0[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float x1[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++) {
+        const float b = f[i];
+        const float a = 1.0f - b;
+        aa += w[i] * a * a;
+        ab += w[i] * a * b;
+        bb += w[i] * b * b;
+        for (int c = 0; c < nc; c++) {
+            x0[c] += w[i] * a * blk->ch[c0 + c][i];
+            x1[c] += w[i] * b * blk->ch[c0 + c][i];
+        }
+    }
+    const float det = aa * bb - ab * ab;
+    if (fabsf(det) < 1e-6f) {
+        return false;
+    }
+    const float inv_det = 1.0f / det;
+    for (int c = 0; c < nc; c++) {
+        e0[c] = _sbc_clampf((bb * x0[c] - ab * x1[c]) * inv_det, 0.0f, 255.0f);
+        e1[c] = _sbc_clampf((aa * x1[c] - ab * x0[c]) * inv_det, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+_SOKOL_PRIVATE void _sbc_quantize(_sbc_endpoint_format_t fmt, int nc, const float* e0, const float* e1, _sbc_endpoints_t* ep) {
+    memset(ep, 0, sizeof(_sbc_endpoints_t));
+    for (int i = 0; i < 2; i++) {
+        const float* e = (i == 0) ? e0 : e1;
+        switch (fmt) {
+            case _SBC_ENDPOINTS_RGB565:
+                {
+                    static const int bits[3] = { 5, 6, 5 };
+                    for (int c = 0; c < 3; c++) {
+                        const int max_val = (1 << bits[c]) - 1;
+                        const int q = _sbc_clamp((int)(e[c] * (float)max_val / 255.0f + 0.5f), 0, max_val);
+                        ep->q[i][c] = q;
+                        ep->e[i][c] = (float)((q << (8 - bits[c])) | (q >> (2 * bits[c] - 8)));
+                    }
+                }
+                break;
+            case _SBC_ENDPOINTS_U8:
+                for (int c = 0; c < nc; c++) {
+                    const int q = _sbc_clamp((int)(e[c] + 0.5f), 0, 255);
+                    ep->q[i][c] = q;
+                    ep->e[i][c] = (float)q;
+                }
+                break;
+            case _SBC_ENDPOINTS_RGBA7P:
+                {
+                    /* pick the p-bit with the smaller quantization error */
+                    float best_err = FLT_MAX;
+                    for (int p = 0; p < 2; p++) {
+                        int q[4];
+                        float err = 0.0f;
+                        for (int c = 0; c < 4; c++) {
+                            q[c] = _sbc_clamp((int)((e[c] - (float)p) * 0.5f + 0.5f), 0, 127);
+                            const float diff = (float)((q[c] << 1) | p) - e[c];
+                            err += diff * diff;
+                        }
+                        if (err < best_err) {
+                            best_err = err;
+                            ep->p[i] = p;
+                            for (int c = 0; c < 4; c++) {
+                                ep->q[i][c] = q[c];
+                                ep->e[i][c] = (float)((q[c] << 1) | p);
+                            }
+                        }
+                    }
+                }
+                break;
+        }
+    }
+}
+
+/* pick the nearest palette level for each pixel */
+_SOKOL_PRIVATE void _sbc_select_levels(const float* t, const _sbc_palette_t* pal, uint8_t* levels, float* f) {
+    const float scale = (float)(pal->num_levels - 1);
+    for (int i = 0; i < 16; i++) {
+        /* the palettes are close to uniform, so the rounded guess is off by at most one level */
+        int l = (int)(t[i] * scale + 0.5f);
+        if ((l > 0) && (fabsf(pal->frac[l - 1] - t[i]) < fabsf(pal->frac[l] - t[i]))) {
+            l--;
+        }
+        else if ((l < pal->num_levels - 1) && (fabsf(pal->frac[l + 1] - t[i]) < fabsf(pal->frac[l] - t[i]))) {
+            l++;
+        }
+        levels[i] = (uint8_t)l;
+        f[i] = pal->frac[l];
+    }
+}
+
+/* find quantized endpoints and per-pixel palette levels, returns the block error */
+_SOKOL_PRIVATE float _sbc_encode_endpoints(const _sbc_block_t* blk, int c0, int nc, const float* w, sbc_quality_t quality, const _sbc_palette_t* pal, _sbc_endpoint_format_t fmt, _sbc_endpoints_t* best_ep, uint8_t* best_levels) {
+    float best_err = FLT_MAX;
+    const int num_starts = (quality == SBC_QUALITY_HIGH) ? 2 : 1;
+    const int num_iters = (quality == SBC_QUALITY_FAST) ? 1 : ((quality == SBC_QUALITY_NORMAL) ? 2 : 4);
+    for (int start = 0; start < num_starts; start++) {
+        float e0[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float e1[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        if ((quality == SBC_QUALITY_FAST) || (start == 1)) {
+            _sbc_fit_bbox(blk, c0, nc, w, e0, e1);
+        }
+        else {
+            _sbc_fit_pca(blk, c0, nc, w, e0, e1);
+        }
+        for (int iter = 0; iter < num_iters; iter++) {
+            _sbc_endpoints_t ep;
+            float t[16], f[16];
+            uint8_t levels[16];
+            _sbc_quantize(fmt, nc, e0, e1, &ep);
+            _sbc_project(blk, c0, nc, ep.e[0], ep.e[1], t);
+            _sbc_select_levels(t, pal, levels, f);
+            const float err = _sbc_error(blk, c0, nc, w, ep.e[0], ep.e[1], f);
+            if (err < best_err) {
+                best_err = err;
+                *best_ep = ep;
+                memcpy(best_levels, levels, 16);
+            }
+            if ((err == 0.0f) || !_sbc_refine(blk, c0, nc, w, f, e0, e1)) {
+                break;
+            }
+        }
+    }
+    return best_err;
+}
+
+/*-- block encoders ----------------------------------------------------------*/
+_SOKOL_PRIVATE uint16_t _sbc_pack565(const int* q) {
+    return (uint16_t)((q[0] << 11) | (q[1] << 5) | q[2]);
+}
+
+_SOKOL_PRIVATE void _sbc_put_u16(uint8_t* dst, uint16_t val) {
+    dst[0] = (uint8_t)(val & 0xFF);
+    dst[1] = (uint8_t)(val >> 8);
+}
+
+/* writes bits in LSB-first order */
+_SOKOL_PRIVATE void _sbc_put_bits(uint8_t* dst, int* pos, uint32_t val, int num_bits) {
+    for (int i = 0; i < num_bits; i++, (*pos)++) {
+        if (val & (1u << i)) {
+            dst[*pos >> 3] |= (uint8_t)(1u << (*pos & 7));
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sbc_encode_bc1(const _sbc_block_t* blk, sbc_quality_t quality, bool allow_alpha, uint8_t* dst) {
+    float w[16];
+    bool has_transparent = false;
+    int num_opaque = 0;
+    for (int i = 0; i < 16; i++) {
+        if (allow_alpha && (blk->ch[3][i] < 128.0f)) {
+            w[i] = 0.0f;
+            has_transparent = true;
+        }
+        else {
+            w[i] = 1.0f;
+            num_opaque++;
+        }
+    }
+    memset(dst, 0, 8);
+    if (0 == num_opaque) {
+        /* 3-color mode (c0 <= c1) with all pixels transparent */
+        dst[4] = dst[5] = dst[6] = dst[7] = 0xFF;
+        return;
+    }
+    _sbc_endpoints_t ep;
+    uint8_t levels[16];
+    const _sbc_palette_t* pal = has_transparent ? &_sbc_palette_bc1_3 : &_sbc_palette_bc1_4;
+    _sbc_encode_endpoints(blk, 0, 3, w, quality, pal, _SBC_ENDPOINTS_RGB565, &ep, levels);
+    uint16_t c0 = _sbc_pack565(ep.q[0]);
+    uint16_t c1 = _sbc_pack565(ep.q[1]);
+    const int max_level = pal->num_levels - 1;
+    /* 4-color mode requires c0 > c1, 3-color mode requires c0 <= c1 */
+    if ((has_transparent && (c0 > c1)) || (!has_transparent && (c0 < c1))) {
+        const uint16_t tmp = c0; c0 = c1; c1 = tmp;
+        for (int i = 0; i < 16; i++) {
+            levels[i] = (uint8_t)(max_level - levels[i]);
+        }
+    }
+    else if (c0 == c1) {
+        memset(levels, 0, sizeof(levels));
+    }
+    static const uint8_t map4[4] = { 0, 2, 3, 1 };
+    static const uint8_t map3[3] = { 0, 2, 1 };
+    uint32_t indices = 0;
+    for (int i = 0; i < 16; i++) {
+        uint32_t index;
+        if (has_transparent) {
+            index = (w[i] == 0.0f) ? 3 : map3[levels[i]];
+        }
+        else {
+            index = map4[levels[i]];
+        }
+        indices |= index << (2 * i);
+    }
+    _sbc_put_u16(dst + 0, c0);
+    _sbc_put_u16(dst + 2, c1);
+    _sbc_put_u16(dst + 4, (uint16_t)(indices & 0xFFFF));
+    _sbc_put_u16(dst + 6, (uint16_t)(indices >> 16));
+}
+
+/* a single-channel block in 8-value mode (r0 > r1) */
+_SOKOL_PRIVATE void _sbc_encode_bc4(const _sbc_block_t* blk, int channel, sbc_quality_t quality, uint8_t* dst) {
+    static const float w[16] = { 1,1,1,1, 1,1,1,1, 1,1,1,1, 1,1,1,1 };
+    _sbc_endpoints_t ep;
+    uint8_t levels[16];
+    _sbc_encode_endpoints(blk, channel, 1, w, quality, &_sbc_palette_bc4, _SBC_ENDPOINTS_U8, &ep, levels);
+    int r0 = ep.q[0][0];
+    int r1 = ep.q[1][0];
+    if (r0 < r1) {
+        const int tmp = r0; r0 = r1; r1 = tmp;
+        for (int i = 0; i < 16; i++) {
+            levels[i] = (uint8_t)(7 - levels[i]);
+        }
+    }
+    else if (r0 == r1) {
+        memset(levels, 0, sizeof(levels));
+    }
+    static const uint8_t map8[8] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+    memset(dst, 0, 8);
+    dst[0] = (uint8_t)r0;
+    dst[1] = (uint8_t)r1;
+    int pos = 16;
+    for (int i = 0; i < 16; i++) {
+        _sbc_put_bits(dst, &pos, map8[levels[i]], 3);
+    }
+}
+
+/* BC7 mode 6: one subset, RGBA endpoints with 7 bits plus p-bit, 4-bit indices */
+_SOKOL_PRIVATE void _sbc_encode_bc7(const _sbc_block_t* blk, sbc_quality_t quality, uint8_t* dst) {
+    static const float w[16] = { 1,1,1,1, 1,1,1,1, 1,1,1,1, 1,1,1,1 };
+    _sbc_endpoints_t ep;
+    uint8_t levels[16];
+    _sbc_encode_endpoints(blk, 0, 4, w, quality, &_sbc_palette_bc7, _SBC_ENDPOINTS_RGBA7P, &ep, levels);
+    /* the MSB of the anchor index (pixel 0) is implicitly zero */
+    int e0 = 0, e1 = 1;
+    if (levels[0] >= 8) {
+        e0 = 1; e1 = 0;
+        for (int i = 0; i < 16; i++) {
+            levels[i] = (uint8_t)(15 - levels[i]);
+        }
+    }
+    memset(dst, 0, 16);
+    int pos = 0;
+    _sbc_put_bits(dst, &pos, 1 << 6, 7);
+    for (int c = 0; c < 4; c++) {
+        _sbc_put_bits(dst, &pos, (uint32_t)ep.q[e0][c], 7);
+        _sbc_put_bits(dst, &pos, (uint32_t)ep.q[e1][c], 7);
+    }
+    _sbc_put_bits(dst, &pos, (uint32_t)ep.p[e0], 1);
+    _sbc_put_bits(dst, &pos, (uint32_t)ep.p[e1], 1);
+    _sbc_put_bits(dst, &pos, levels[0], 3);
+    for (int i = 1; i < 16; i++) {
+        _sbc_put_bits(dst, &pos, levels[i], 4);
+    }
+    SOKOL_ASSERT(pos == 128);
+}
+
+_SOKOL_PRIVATE void _sbc_encode_block(const sbc_desc_t* desc, const _sbc_block_t* blk, uint8_t* dst) {
+    switch (desc->pixel_format) {
+        case SG_PIXELFORMAT_BC1_RGBA:
+            _sbc_encode_bc1(blk, desc->quality, true, dst);
+            break;
+        case SG_PIXELFORMAT_BC3_RGBA:
+            _sbc_encode_bc4(blk, 3, desc->quality, dst);
+            _sbc_encode_bc1(blk, desc->quality, false, dst + 8);
+            break;
+        case SG_PIXELFORMAT_BC4_R:
+            _sbc_encode_bc4(blk, 0, desc->quality, dst);
+            break;
+        case SG_PIXELFORMAT_BC5_RG:
+            _sbc_encode_bc4(blk, 0, desc->quality, dst);
+            _sbc_encode_bc4(blk, 1, desc->quality, dst + 8);
+            break;
+        case SG_PIXELFORMAT_BC7_RGBA:
+            _sbc_encode_bc7(blk, desc->quality, dst);
+            break;
+        default:
+            SOKOL_ASSERT(false);
+            break;
+    }
+}
+
+_SOKOL_PRIVATE bool _sbc_src_valid(const sbc_desc_t* desc, const sg_image_content* src) {
+    for (int face_index = 0; face_index < _sbc_num_faces(desc); face_index++) {
+        for (int mip_index = 0; mip_index < desc->num_mipmaps; mip_index++) {
+            const sg_subimage_content* sub = &src->subimage[face_index][mip_index];
+            const int size = _sbc_mip_dim(desc->width, mip_index) * _sbc_mip_dim(desc->height, mip_index) * 4;
+            if ((0 == sub->ptr) || (sub->size < size)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+_SOKOL_PRIVATE bool _sbc_buffer_valid(const sbc_desc_t* desc) {
+    return desc->buffer.ptr && (desc->buffer.size >= sbc_buffer_size(desc));
+}
+
+_SOKOL_PRIVATE void _sbc_encode_job(const sbc_desc_t* desc, const sg_image_content* src, const _sbc_job_t* job) {
+    const uint8_t* src_pixels = (const uint8_t*) src->subimage[job->face_index][job->mip_index].ptr;
+    uint8_t* dst = (uint8_t*)desc->buffer.ptr + job->dst_offset;
+    const int block_size = _sbc_block_size(desc->pixel_format);
+    const int blocks_x = (job->width + 3) / 4;
+    _sbc_block_t blk;
+    for (int by = job->first_block_row; by < (job->first_block_row + job->num_block_rows); by++) {
+        for (int bx = 0; bx < blocks_x; bx++) {
+            _sbc_load_block(src_pixels, job->width, job->height, bx, by, &blk);
+            _sbc_encode_block(desc, &blk, dst);
+            dst += block_size;
+        }
+    }
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL int sbc_buffer_size(const sbc_desc_t* in_desc) {
+    SOKOL_ASSERT(in_desc);
+    const sbc_desc_t desc = _sbc_desc_defaults(in_desc);
+    if (!_sbc_desc_valid(&desc)) {
+        return 0;
+    }
+    int size = 0;
+    for (int mip_index = 0; mip_index < desc.num_mipmaps; mip_index++) {
+        size += _sbc_surface_size(&desc, mip_index);
+    }
+    return size * _sbc_num_faces(&desc);
+}
+
+SOKOL_API_IMPL int sbc_num_jobs(const sbc_desc_t* in_desc) {
+    SOKOL_ASSERT(in_desc);
+    const sbc_desc_t desc = _sbc_desc_defaults(in_desc);
+    if (!_sbc_desc_valid(&desc)) {
+        return 0;
+    }
+    int num_jobs = 0;
+    for (int mip_index = 0; mip_index < desc.num_mipmaps; mip_index++) {
+        num_jobs += _sbc_num_surface_jobs(&desc, mip_index);
+    }
+    return num_jobs * _sbc_num_faces(&desc);
+}
+
+SOKOL_API_IMPL bool sbc_encode_job(const sbc_desc_t* in_desc, const sg_image_content* src, int job_index) {
+    SOKOL_ASSERT(in_desc && src);
+    const sbc_desc_t desc = _sbc_desc_defaults(in_desc);
+    if (!_sbc_desc_valid(&desc) || !_sbc_buffer_valid(&desc) || !_sbc_src_valid(&desc, src)) {
+        return false;
+    }
+    _sbc_job_t job;
+    if (!_sbc_lookup_job(&desc, job_index, &job)) {
+        return false;
+    }
+    _sbc_encode_job(&desc, src, &job);
+    return true;
+}
+
+SOKOL_API_IMPL sg_image_content sbc_image_content(const sbc_desc_t* in_desc) {
+    SOKOL_ASSERT(in_desc);
+    sg_image_content res;
+    memset(&res, 0, sizeof(res));
+    const sbc_desc_t desc = _sbc_desc_defaults(in_desc);
+    if (!_sbc_desc_valid(&desc) || !_sbc_buffer_valid(&desc)) {
+        return res;
+    }
+    uint8_t* ptr = (uint8_t*) desc.buffer.ptr;
+    for (int face_index = 0; face_index < _sbc_num_faces(&desc); face_index++) {
+        for (int mip_index = 0; mip_index < desc.num_mipmaps; mip_index++) {
+            const int size = _sbc_surface_size(&desc, mip_index);
+            res.subimage[face_index][mip_index].ptr = ptr;
+            res.subimage[face_index][mip_index].size = size;
+            ptr += size;
+        }
+    }
+    return res;
+}
+
+SOKOL_API_IMPL bool sbc_encode(const sbc_desc_t* in_desc, const sg_image_content* src, sg_image_content* dst) {
+    SOKOL_ASSERT(in_desc && src && dst);
+    const sbc_desc_t desc = _sbc_desc_defaults(in_desc);
+    if (!_sbc_desc_valid(&desc) || !_sbc_buffer_valid(&desc) || !_sbc_src_valid(&desc, src)) {
+        return false;
+    }
+    _sbc_job_t job;
+    for (int job_index = 0; _sbc_lookup_job(&desc, job_index, &job); job_index++) {
+        _sbc_encode_job(&desc, src, &job);
+    }
+    *dst = sbc_image_content(&desc);
+    return true;
+}
+
+#endif /* SOKOL_BCENC_IMPL */
@@ -54,6 +54,10 @@
     - comes with 6 embedded 8-bit home computer fonts (each taking up 2 KBytes)
     - easily plug in your own fonts
     - create multiple contexts for rendering text in different layers or render passes
+    - characters are rendered as instanced quads, with one 24-byte instance
+      per character (see "INSTANCED RENDERING" below)
+    - static text can be baked into cached text blocks which are redrawn
+      with a single draw call (see "CACHED TEXT BLOCKS" below)
 
     STEP BY STEP
     ============
@@ -68,6 +72,9 @@
         .context_pool_size (default: 8)
             The max number of text contexts that can be created.
 
+        .block_pool_size (default: 64)
+            The max number of cached text blocks that can be created.
+
         .printf_buf_size (default: 4096)
             The size of the internal text formatting buffer used by
             sdtx_printf() and sdtx_vprintf().
@@ -98,8 +105,8 @@
 
             .char_buf_size (default: 4096)
                 The number of characters that can be rendered per frame in this
-                context, defines the size of an internal fixed-size vertex
-                buffer.  Any additional characters will be silently ignored.
+                context, defines the size of an internal fixed-size character
+                and vertex buffer.  Any additional characters will be silently ignored.
 
             .canvas_width (default: 640)
             .canvas_height (default: 480)
@@ -230,7 +237,7 @@
         ...to actually render the text. Calling sdtx_draw() will also rewind
         the text context:
 
-            - the internal vertex buffer pointer is reset to the beginning
+            - the internal character buffer pointer is reset to the beginning
             - the current font is set to 0
             - the cursor position is reset
 
@@ -289,6 +296,72 @@
     If a context is set as active that no longer exists, all sokol-debugtext
     functions that require an active context will silently fail.
 
+    INSTANCED RENDERING
+    ===================
+    Text output functions record one compact 24-byte item per character
+    (position and size, character code, font index and color). Where
+    sokol-gfx supports instancing (sg_query_features().instancing), these
+    items are uploaded as is into a per-instance vertex buffer, and
+    expanded into quads on the GPU through a static 4-vertex 'unit quad'
+    (so a full 80x50 character screen uploads 96 KBytes per frame instead
+    of 384 KBytes).
+
+    On GLES2 without the instancing extension and on WebGPU (where the
+    instanced shader variant isn't available) sokol-debugtext falls back to
+    expanding each character into 6 vertices on the CPU inside sdtx_draw().
+    Both paths produce the same output, so this is transparent to the
+    application.
+
+    CACHED TEXT BLOCKS
+    ==================
+    Debug text which doesn't change from frame to frame (like labels, help
+    text or tables) can be baked into a cached text block, which keeps the
+    text's characters in an immutable sokol-gfx buffer and is drawn with
+    one draw call without recording any characters. Create a text block with:
+
+        sdtx_block blk = sdtx_make_block();
+
+    ...and use the following functions instead of sdtx_puts(), sdtx_putr()
+    and sdtx_printf() each frame:
+
+        sdtx_block_puts(blk, str)
+        sdtx_block_putr(blk, str, len)
+        sdtx_block_printf(blk, fmt, ...)
+
+    The block is keyed by the text content, and the current font, color,
+    cursor position, origin, canvas size and tab width. If all of those
+    match the previous call, the cached block is drawn as is (this only
+    computes a hash over the text), otherwise the text is recorded again and
+    baked into a new buffer. The text cursor is moved behind the block's
+    text as if the text had been output normally, and the block is drawn
+    inside sdtx_draw() in the same order relative to the regular text.
+
+    If the application knows that the text hasn't changed, it can skip the
+    content check completely and draw the cached block with:
+
+        sdtx_block_redraw(blk)
+
+    ...this ignores the current font, color and cursor position. To force a
+    rebuild on the next sdtx_block_puts(), sdtx_block_putr() or
+    sdtx_block_printf() call (sdtx_block_redraw() won't draw anything until
+    then), call:
+
+        sdtx_invalidate_block(blk)
+
+    Since rebuilding a block creates a new sokol-gfx buffer, text which
+    changes every frame should be rendered with the regular functions.
+    A block only holds one version of its text, so if the same block is
+    output again before sdtx_draw() was called for an earlier output (for
+    instance at a different position, or in a different color), the second
+    output is recorded as regular characters and the cached block isn't
+    touched.
+
+    A block may be drawn into any context, but each context can record at
+    most 'block_pool_size' block calls per frame (any additional calls are
+    silently ignored). Destroy a text block with:
+
+        sdtx_destroy_block(blk)
+
     USING YOUR OWN FONT DATA
     ========================
 
@@ -412,8 +485,10 @@
 
 #if defined(__GNUC__)
 #define SOKOL_DEBUGTEXT_PRINTF_ATTR __attribute__((format(printf, 1, 2)))
+#define SOKOL_DEBUGTEXT_BLOCK_PRINTF_ATTR __attribute__((format(printf, 2, 3)))
 #else
 #define SOKOL_DEBUGTEXT_PRINTF_ATTR
+#define SOKOL_DEBUGTEXT_BLOCK_PRINTF_ATTR
 #endif
 
 #ifdef __cplusplus
@@ -426,6 +501,9 @@ typedef struct sdtx_context { uint32_t id; } sdtx_context;
 /* the default context handle */
 static const sdtx_context SDTX_DEFAULT_CONTEXT = { 0x00010001 };
 
+/* a cached text block handle */
+typedef struct sdtx_block { uint32_t id; } sdtx_block;
+
 /*
     sdtx_font_desc_t
 
@@ -492,6 +570,7 @@ typedef struct sdtx_context_desc_t {
 */
 typedef struct sdtx_desc_t {
     int context_pool_size;                  // max number of rendering contexts that can be created, default: 8
+    int block_pool_size;                    // max number of cached text blocks that can be created, default: 64
     int printf_buf_size;                    // size of internal buffer for snprintf(), default: 4096
     sdtx_font_desc_t fonts[SDTX_MAX_FONTS]; // up to 8 fonts descriptions
     sdtx_context_desc_t context;            // the default context creation parameters
@@ -551,6 +630,15 @@ SOKOL_DEBUGTEXT_API_DECL void sdtx_putr(const char* str, int len);    // 'put ra
 SOKOL_DEBUGTEXT_API_DECL int sdtx_printf(const char* fmt, ...) SOKOL_DEBUGTEXT_PRINTF_ATTR;
 SOKOL_DEBUGTEXT_API_DECL int sdtx_vprintf(const char* fmt, va_list args);
 
+/* cached text blocks */
+SOKOL_DEBUGTEXT_API_DECL sdtx_block sdtx_make_block(void);
+SOKOL_DEBUGTEXT_API_DECL void sdtx_destroy_block(sdtx_block blk);
+SOKOL_DEBUGTEXT_API_DECL void sdtx_invalidate_block(sdtx_block blk);
+SOKOL_DEBUGTEXT_API_DECL void sdtx_block_puts(sdtx_block blk, const char* str);
+SOKOL_DEBUGTEXT_API_DECL void sdtx_block_putr(sdtx_block blk, const char* str, int len);
+SOKOL_DEBUGTEXT_API_DECL int sdtx_block_printf(sdtx_block blk, const char* fmt, ...) SOKOL_DEBUGTEXT_BLOCK_PRINTF_ATTR;
+SOKOL_DEBUGTEXT_API_DECL void sdtx_block_redraw(sdtx_block blk);     // draw the cached text without checking the content
+
 #ifdef __cplusplus
 } /* extern "C" */
 /* C++ const-ref wrappers */
@@ -564,6 +652,7 @@ inline sdtx_context sdtx_make_context(const sdtx_context_desc_t& desc) { return
 #define SOKOL_DEBUGTEXT_IMPL_INCLUDED (1)
 
 #include <string.h> // memset
+#include <stddef.h> // offsetof
 #include <math.h>   // fmodf
 #include <stdarg.h> // for vsnprintf
 
@@ -608,6 +697,7 @@ inline sdtx_context sdtx_make_context(const sdtx_context_desc_t& desc) { return
 #define _SDTX_INIT_COOKIE (0xACBAABCA)
 
 #define _SDTX_DEFAULT_CONTEXT_POOL_SIZE (8)
+#define _SDTX_DEFAULT_BLOCK_POOL_SIZE (64)
 #define _SDTX_DEFAULT_CHAR_BUF_SIZE (1<<12)
 #define _SDTX_DEFAULT_PRINTF_BUF_SIZE (1<<12)
 #define _SDTX_DEFAULT_CANVAS_WIDTH (640)
@@ -2201,6 +2291,30 @@ static const uint8_t _sdtx_font_oric[2048] = {
         @end
 
         @program debugtext vs fs
+
+    The instanced variant expands one per-glyph instance into a quad
+    using a static 'unit quad' vertex buffer. It shares the fragment
+    shader with the non-instanced variant, and is only embedded as
+    source code (on Metal and D3D11 it is compiled at runtime, for
+    WebGPU there is no instanced variant and the non-instanced fallback
+    is used instead):
+
+        @vs vs_inst
+        in vec2 corner;
+        in vec4 rect;
+        in vec4 glyph;
+        in vec4 color0;
+        out vec2 uv;
+        out vec4 color;
+        void main() {
+          vec2 pos = rect.xy + corner * rect.zw;
+          gl_Position = vec4(pos * vec2(2.0, -2.0) + vec2(-1.0, +1.0), 0.0, 1.0);
+          uv = (glyph.xy * 255.0 + corner) * vec2(1.0/256.0, 1.0/8.0);
+          color = color0;
+        }
+        @end
+
+        @program debugtext_inst vs_inst fs
 */
 #if defined(SOKOL_GLCORE33)
 static const char _sdtx_vs_src_glcore33[300] = {
@@ -2238,6 +2352,33 @@ static const char _sdtx_fs_src_glcore33[174] = {
     0x72,0x65,0x28,0x74,0x65,0x78,0x2c,0x20,0x75,0x76,0x29,0x2e,0x78,0x78,0x78,0x78,
     0x20,0x2a,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
 };
+static const char _sdtx_inst_vs_src_glcore33[397] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x33,0x33,0x30,0x0a,0x0a,0x6c,0x61,
+    0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,
+    0x31,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,0x72,0x65,0x63,0x74,0x3b,
+    0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,
+    0x20,0x3d,0x20,0x30,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,0x63,0x6f,
+    0x72,0x6e,0x65,0x72,0x3b,0x0a,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x32,0x20,0x75,
+    0x76,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,
+    0x6f,0x6e,0x20,0x3d,0x20,0x32,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,
+    0x67,0x6c,0x79,0x70,0x68,0x3b,0x0a,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x34,0x20,
+    0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,
+    0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x33,0x29,0x20,0x69,0x6e,0x20,0x76,
+    0x65,0x63,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x30,0x3b,0x0a,0x0a,0x76,0x6f,0x69,
+    0x64,0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x67,
+    0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x76,0x65,0x63,
+    0x34,0x28,0x28,0x28,0x72,0x65,0x63,0x74,0x2e,0x78,0x79,0x20,0x2b,0x20,0x28,0x63,
+    0x6f,0x72,0x6e,0x65,0x72,0x20,0x2a,0x20,0x72,0x65,0x63,0x74,0x2e,0x7a,0x77,0x29,
+    0x29,0x20,0x2a,0x20,0x76,0x65,0x63,0x32,0x28,0x32,0x2e,0x30,0x2c,0x20,0x2d,0x32,
+    0x2e,0x30,0x29,0x29,0x20,0x2b,0x20,0x76,0x65,0x63,0x32,0x28,0x2d,0x31,0x2e,0x30,
+    0x2c,0x20,0x31,0x2e,0x30,0x29,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x31,0x2e,0x30,
+    0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x75,0x76,0x20,0x3d,0x20,0x28,0x28,0x67,0x6c,
+    0x79,0x70,0x68,0x2e,0x78,0x79,0x20,0x2a,0x20,0x32,0x35,0x35,0x2e,0x30,0x29,0x20,
+    0x2b,0x20,0x63,0x6f,0x72,0x6e,0x65,0x72,0x29,0x20,0x2a,0x20,0x76,0x65,0x63,0x32,
+    0x28,0x30,0x2e,0x30,0x30,0x33,0x39,0x30,0x36,0x32,0x35,0x2c,0x20,0x30,0x2e,0x31,
+    0x32,0x35,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,
+    0x20,0x63,0x6f,0x6c,0x6f,0x72,0x30,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
 #elif defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
 static const char _sdtx_vs_src_gles2[266] = {
     0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x31,0x30,0x30,0x0a,0x0a,0x61,0x74,
@@ -2274,6 +2415,30 @@ static const char _sdtx_fs_src_gles2[212] = {
     0x29,0x2e,0x78,0x78,0x78,0x78,0x20,0x2a,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,
     0x7d,0x0a,0x0a,0x00,
 };
+static const char _sdtx_inst_vs_src_gles2[349] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x31,0x30,0x30,0x0a,0x0a,0x61,0x74,
+    0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x20,0x76,0x65,0x63,0x34,0x20,0x72,0x65,0x63,
+    0x74,0x3b,0x0a,0x61,0x74,0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x20,0x76,0x65,0x63,
+    0x32,0x20,0x63,0x6f,0x72,0x6e,0x65,0x72,0x3b,0x0a,0x76,0x61,0x72,0x79,0x69,0x6e,
+    0x67,0x20,0x76,0x65,0x63,0x32,0x20,0x75,0x76,0x3b,0x0a,0x61,0x74,0x74,0x72,0x69,
+    0x62,0x75,0x74,0x65,0x20,0x76,0x65,0x63,0x34,0x20,0x67,0x6c,0x79,0x70,0x68,0x3b,
+    0x0a,0x76,0x61,0x72,0x79,0x69,0x6e,0x67,0x20,0x76,0x65,0x63,0x34,0x20,0x63,0x6f,
+    0x6c,0x6f,0x72,0x3b,0x0a,0x61,0x74,0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x20,0x76,
+    0x65,0x63,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x30,0x3b,0x0a,0x0a,0x76,0x6f,0x69,
+    0x64,0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x67,
+    0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x76,0x65,0x63,
+    0x34,0x28,0x28,0x28,0x72,0x65,0x63,0x74,0x2e,0x78,0x79,0x20,0x2b,0x20,0x28,0x63,
+    0x6f,0x72,0x6e,0x65,0x72,0x20,0x2a,0x20,0x72,0x65,0x63,0x74,0x2e,0x7a,0x77,0x29,
+    0x29,0x20,0x2a,0x20,0x76,0x65,0x63,0x32,0x28,0x32,0x2e,0x30,0x2c,0x20,0x2d,0x32,
+    0x2e,0x30,0x29,0x29,0x20,0x2b,0x20,0x76,0x65,0x63,0x32,0x28,0x2d,0x31,0x2e,0x30,
+    0x2c,0x20,0x31,0x2e,0x30,0x29,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x31,0x2e,0x30,
+    0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x75,0x76,0x20,0x3d,0x20,0x28,0x28,0x67,0x6c,
+    0x79,0x70,0x68,0x2e,0x78,0x79,0x20,0x2a,0x20,0x32,0x35,0x35,0x2e,0x30,0x29,0x20,
+    0x2b,0x20,0x63,0x6f,0x72,0x6e,0x65,0x72,0x29,0x20,0x2a,0x20,0x76,0x65,0x63,0x32,
+    0x28,0x30,0x2e,0x30,0x30,0x33,0x39,0x30,0x36,0x32,0x35,0x2c,0x20,0x30,0x2e,0x31,
+    0x32,0x35,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,
+    0x20,0x63,0x6f,0x6c,0x6f,0x72,0x30,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
 #elif defined(SOKOL_METAL)
 static const uint8_t _sdtx_vs_bytecode_metal_macos[2896] = {
     0x4d,0x54,0x4c,0x42,0x01,0x80,0x02,0x00,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
@@ -3083,6 +3248,51 @@ static const char _sdtx_fs_src_metal_sim[475] = {
     0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,
     0x6e,0x20,0x6f,0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
 };
+static const char _sdtx_inst_vs_src_metal[683] = {
+    0x23,0x69,0x6e,0x63,0x6c,0x75,0x64,0x65,0x20,0x3c,0x6d,0x65,0x74,0x61,0x6c,0x5f,
+    0x73,0x74,0x64,0x6c,0x69,0x62,0x3e,0x0a,0x23,0x69,0x6e,0x63,0x6c,0x75,0x64,0x65,
+    0x20,0x3c,0x73,0x69,0x6d,0x64,0x2f,0x73,0x69,0x6d,0x64,0x2e,0x68,0x3e,0x0a,0x0a,
+    0x75,0x73,0x69,0x6e,0x67,0x20,0x6e,0x61,0x6d,0x65,0x73,0x70,0x61,0x63,0x65,0x20,
+    0x6d,0x65,0x74,0x61,0x6c,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x6d,
+    0x61,0x69,0x6e,0x30,0x5f,0x6f,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x32,0x20,0x75,0x76,0x20,0x5b,0x5b,0x75,0x73,0x65,0x72,0x28,
+    0x6c,0x6f,0x63,0x6e,0x30,0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x5b,0x5b,0x75,0x73,0x65,
+    0x72,0x28,0x6c,0x6f,0x63,0x6e,0x31,0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,
+    0x6f,0x6e,0x20,0x5b,0x5b,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x5d,0x5d,0x3b,
+    0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x6d,0x61,0x69,0x6e,
+    0x30,0x5f,0x69,0x6e,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x32,0x20,0x63,0x6f,0x72,0x6e,0x65,0x72,0x20,0x5b,0x5b,0x61,0x74,0x74,0x72,0x69,
+    0x62,0x75,0x74,0x65,0x28,0x30,0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x34,0x20,0x72,0x65,0x63,0x74,0x20,0x5b,0x5b,0x61,0x74,0x74,
+    0x72,0x69,0x62,0x75,0x74,0x65,0x28,0x31,0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x79,0x70,0x68,0x20,0x5b,0x5b,
+    0x61,0x74,0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x28,0x32,0x29,0x5d,0x5d,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,
+    0x30,0x20,0x5b,0x5b,0x61,0x74,0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x28,0x33,0x29,
+    0x5d,0x5d,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x76,0x65,0x72,0x74,0x65,0x78,0x20,0x6d,
+    0x61,0x69,0x6e,0x30,0x5f,0x6f,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,0x30,0x28,0x6d,
+    0x61,0x69,0x6e,0x30,0x5f,0x69,0x6e,0x20,0x69,0x6e,0x20,0x5b,0x5b,0x73,0x74,0x61,
+    0x67,0x65,0x5f,0x69,0x6e,0x5d,0x5d,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x6d,
+    0x61,0x69,0x6e,0x30,0x5f,0x6f,0x75,0x74,0x20,0x6f,0x75,0x74,0x20,0x3d,0x20,0x7b,
+    0x7d,0x3b,0x0a,0x20,0x20,0x20,0x20,0x6f,0x75,0x74,0x2e,0x67,0x6c,0x5f,0x50,0x6f,
+    0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x28,
+    0x28,0x28,0x69,0x6e,0x2e,0x72,0x65,0x63,0x74,0x2e,0x78,0x79,0x20,0x2b,0x20,0x28,
+    0x69,0x6e,0x2e,0x63,0x6f,0x72,0x6e,0x65,0x72,0x20,0x2a,0x20,0x69,0x6e,0x2e,0x72,
+    0x65,0x63,0x74,0x2e,0x7a,0x77,0x29,0x29,0x20,0x2a,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x32,0x28,0x32,0x2e,0x30,0x2c,0x20,0x2d,0x32,0x2e,0x30,0x29,0x29,0x20,0x2b,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x2d,0x31,0x2e,0x30,0x2c,0x20,0x31,0x2e,0x30,
+    0x29,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x31,0x2e,0x30,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x6f,0x75,0x74,0x2e,0x75,0x76,0x20,0x3d,0x20,0x28,0x28,0x69,0x6e,0x2e,
+    0x67,0x6c,0x79,0x70,0x68,0x2e,0x78,0x79,0x20,0x2a,0x20,0x32,0x35,0x35,0x2e,0x30,
+    0x29,0x20,0x2b,0x20,0x69,0x6e,0x2e,0x63,0x6f,0x72,0x6e,0x65,0x72,0x29,0x20,0x2a,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x30,0x2e,0x30,0x30,0x33,0x39,0x30,0x36,
+    0x32,0x35,0x2c,0x20,0x30,0x2e,0x31,0x32,0x35,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x6f,0x75,0x74,0x2e,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x69,0x6e,0x2e,0x63,
+    0x6f,0x6c,0x6f,0x72,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,
+    0x6e,0x20,0x6f,0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
 #elif defined(SOKOL_D3D11)
 static const uint8_t _sdtx_vs_bytecode_d3d11[692] = {
     0x44,0x58,0x42,0x43,0x07,0x05,0xa0,0xb3,0x53,0xc1,0x0a,0x0d,0x1e,0xf4,0xe4,0xa6,
@@ -3171,6 +3381,114 @@ static const uint8_t _sdtx_fs_bytecode_d3d11[620] = {
     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
 };
+static const char _sdtx_inst_vs_src_hlsl4[1027] = {
+    0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,
+    0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,
+    0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x72,0x65,0x63,0x74,0x3b,0x0a,0x73,
+    0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x63,0x6f,0x72,
+    0x6e,0x65,0x72,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x32,0x20,0x75,0x76,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x79,0x70,0x68,0x3b,0x0a,0x73,0x74,0x61,0x74,
+    0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,
+    0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x63,
+    0x6f,0x6c,0x6f,0x72,0x30,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,
+    0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,
+    0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x63,0x6f,
+    0x72,0x6e,0x65,0x72,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x72,0x65,0x63,
+    0x74,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x79,0x70,0x68,0x20,
+    0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x32,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x30,0x20,0x3a,
+    0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x33,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,
+    0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,
+    0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x75,0x76,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,
+    0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,
+    0x52,0x44,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,
+    0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3a,0x20,0x53,0x56,
+    0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x76,
+    0x6f,0x69,0x64,0x20,0x76,0x65,0x72,0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,
+    0x7b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,
+    0x6e,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x28,0x28,0x28,0x72,0x65,0x63,
+    0x74,0x2e,0x78,0x79,0x20,0x2b,0x20,0x28,0x63,0x6f,0x72,0x6e,0x65,0x72,0x20,0x2a,
+    0x20,0x72,0x65,0x63,0x74,0x2e,0x7a,0x77,0x29,0x29,0x20,0x2a,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x32,0x28,0x32,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x32,0x2e,0x30,0x66,0x29,
+    0x29,0x20,0x2b,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x2d,0x31,0x2e,0x30,0x66,
+    0x2c,0x20,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x31,
+    0x2e,0x30,0x66,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x75,0x76,0x20,0x3d,0x20,0x28,
+    0x28,0x67,0x6c,0x79,0x70,0x68,0x2e,0x78,0x79,0x20,0x2a,0x20,0x32,0x35,0x35,0x2e,
+    0x30,0x66,0x29,0x20,0x2b,0x20,0x63,0x6f,0x72,0x6e,0x65,0x72,0x29,0x20,0x2a,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x30,0x2e,0x30,0x30,0x33,0x39,0x30,0x36,0x32,
+    0x35,0x66,0x2c,0x20,0x30,0x2e,0x31,0x32,0x35,0x66,0x29,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x30,0x3b,
+    0x0a,0x7d,0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,
+    0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,0x28,0x53,0x50,0x49,0x52,
+    0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x20,0x73,0x74,
+    0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,
+    0x20,0x72,0x65,0x63,0x74,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,
+    0x70,0x75,0x74,0x2e,0x72,0x65,0x63,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x63,0x6f,
+    0x72,0x6e,0x65,0x72,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,
+    0x75,0x74,0x2e,0x63,0x6f,0x72,0x6e,0x65,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,
+    0x6c,0x79,0x70,0x68,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,
+    0x75,0x74,0x2e,0x67,0x6c,0x79,0x70,0x68,0x3b,0x0a,0x20,0x20,0x20,0x20,0x63,0x6f,
+    0x6c,0x6f,0x72,0x30,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,
+    0x75,0x74,0x2e,0x63,0x6f,0x6c,0x6f,0x72,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,
+    0x65,0x72,0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,
+    0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,
+    0x74,0x2e,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,
+    0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x75,0x76,
+    0x20,0x3d,0x20,0x75,0x76,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,
+    0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,
+    0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,
+    0x6e,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,
+    0x7d,0x0a,0x00,
+};
+static const char _sdtx_inst_fs_src_hlsl4[622] = {
+    0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x3c,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x3e,0x20,0x74,0x65,0x78,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,
+    0x28,0x74,0x30,0x29,0x3b,0x0a,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x53,0x74,0x61,
+    0x74,0x65,0x20,0x5f,0x74,0x65,0x78,0x5f,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x20,
+    0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x73,0x30,0x29,0x3b,0x0a,
+    0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x66,
+    0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,
+    0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x75,0x76,0x3b,0x0a,0x73,0x74,0x61,
+    0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,
+    0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,
+    0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x75,0x76,0x20,0x3a,0x20,0x54,0x45,
+    0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,
+    0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,
+    0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,
+    0x74,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x34,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3a,0x20,0x53,
+    0x56,0x5f,0x54,0x61,0x72,0x67,0x65,0x74,0x30,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x76,
+    0x6f,0x69,0x64,0x20,0x66,0x72,0x61,0x67,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,
+    0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,
+    0x20,0x3d,0x20,0x74,0x65,0x78,0x2e,0x53,0x61,0x6d,0x70,0x6c,0x65,0x28,0x5f,0x74,
+    0x65,0x78,0x5f,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x2c,0x20,0x75,0x76,0x29,0x2e,
+    0x78,0x78,0x78,0x78,0x20,0x2a,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x7d,0x0a,
+    0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,
+    0x70,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,0x28,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,
+    0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,
+    0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x75,0x76,
+    0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x75,
+    0x76,0x3b,0x0a,0x20,0x20,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x73,
+    0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x63,0x6f,0x6c,0x6f,0x72,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x72,0x61,0x67,0x5f,0x6d,0x61,0x69,0x6e,0x28,
+    0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,
+    0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,
+    0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,
+    0x6c,0x6f,0x72,0x20,0x3d,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x74,0x61,
+    0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x00,
+};
 #elif defined(SOKOL_WGPU)
 static const uint8_t _sdtx_vs_bytecode_wgpu[1648] = {
     0x03,0x02,0x23,0x07,0x00,0x00,0x01,0x00,0x08,0x00,0x08,0x00,0x2e,0x00,0x00,0x00,
@@ -3367,14 +3685,59 @@ typedef struct {
     uint32_t color;
 } _sdtx_vertex_t;
 
+/* one recorded character, this is also the per-instance vertex data of the instanced path */
+typedef struct {
+    float x, y, w, h;       // glyph rectangle in normalized canvas coordinates
+    uint8_t chr;
+    uint8_t font;
+    uint16_t reserved;
+    uint32_t color;
+} _sdtx_glyph_t;
+
+/* the state a cached text block's content depends on */
+typedef struct {
+    uint64_t hash;              // hash over the text
+    _sdtx_float2_t glyph_size;
+    _sdtx_float2_t origin;
+    _sdtx_float2_t pos;
+    float tab_width;
+    int font;
+    uint32_t color;
+} _sdtx_block_key_t;
+
+typedef struct {
+    _sdtx_slot_t slot;
+    bool valid;                 // false if the block must be rebuilt on next use
+    _sdtx_block_key_t key;
+    _sdtx_float2_t end_pos;     // cursor position after the block's text
+    int num_glyphs;
+    int num_calls;              // number of recorded block calls which haven't been drawn yet
+    sg_buffer vbuf;             // immutable instance- or vertex-buffer
+} _sdtx_block_t;
+
+typedef struct {
+    _sdtx_pool_t pool;
+    _sdtx_block_t* blocks;
+} _sdtx_block_pool_t;
+
+/* a cached text block drawn in the middle of a context's regular glyphs */
+typedef struct {
+    uint32_t block_id;
+    int glyph_index;
+} _sdtx_block_call_t;
+
 typedef struct {
     _sdtx_slot_t slot;
     sdtx_context_desc_t desc;
-    _sdtx_vertex_t* cur_vertex_ptr;
-    const _sdtx_vertex_t* max_vertex_ptr;
-    _sdtx_vertex_t* vertices;
-    sg_buffer vbuf;
+    _sdtx_glyph_t* cur_glyph_ptr;
+    const _sdtx_glyph_t* max_glyph_ptr;
+    _sdtx_glyph_t* glyphs;
+    _sdtx_vertex_t* vertices;   // only used by the non-instanced fallback
+    sg_buffer vbuf;             // instance buffer, or vertex buffer in the non-instanced fallback
     sg_pipeline pip;
+    int num_block_calls;
+    int max_block_calls;
+    _sdtx_block_call_t* block_calls;
     int cur_font;
     _sdtx_float2_t canvas_size;
     _sdtx_float2_t glyph_size;
@@ -3394,12 +3757,18 @@ typedef struct {
     sdtx_desc_t desc;
     sg_image font_img;
     sg_shader shader;
+    bool instanced;             // true if glyphs are rendered as instanced quads
+    sg_shader inst_shader;
+    sg_buffer quad_vbuf;        // the static unit quad for the instanced path
     uint32_t fmt_buf_size;
     char* fmt_buf;
     sdtx_context def_ctx_id;
     sdtx_context cur_ctx_id;
     _sdtx_context_t* cur_ctx;   // may be 0!
     _sdtx_context_pool_t context_pool;
+    _sdtx_block_pool_t block_pool;
+    int num_scratch_glyphs;
+    _sdtx_glyph_t* scratch_glyphs;  // for (re-)building cached text blocks
     uint8_t font_pixels[SDTX_MAX_FONTS * 256 * 8 * 8];
 } _sdtx_t;
 static _sdtx_t _sdtx;
@@ -3570,12 +3939,29 @@ static void _sdtx_init_context(sdtx_context ctx_id, const sdtx_context_desc_t* i
     SOKOL_ASSERT(ctx->desc.canvas_width > 0.0f);
     SOKOL_ASSERT(ctx->desc.canvas_height > 0.0f);
 
-    const uint32_t max_vertices = 6 * ctx->desc.char_buf_size;
-    const int vbuf_size = max_vertices * sizeof(_sdtx_vertex_t);
-    ctx->vertices = (_sdtx_vertex_t*) SOKOL_MALLOC(vbuf_size);
-    SOKOL_ASSERT(ctx->vertices);
-    ctx->cur_vertex_ptr = ctx->vertices;
-    ctx->max_vertex_ptr = ctx->vertices + max_vertices;
+    const int max_glyphs = ctx->desc.char_buf_size;
+    ctx->glyphs = (_sdtx_glyph_t*) SOKOL_MALLOC(max_glyphs * sizeof(_sdtx_glyph_t));
+    SOKOL_ASSERT(ctx->glyphs);
+    ctx->cur_glyph_ptr = ctx->glyphs;
+    ctx->max_glyph_ptr = ctx->glyphs + max_glyphs;
+
+    /* each cached text block is usually drawn once per frame and context */
+    ctx->max_block_calls = _sdtx.desc.block_pool_size;
+    ctx->block_calls = (_sdtx_block_call_t*) SOKOL_MALLOC(ctx->max_block_calls * sizeof(_sdtx_block_call_t));
+    SOKOL_ASSERT(ctx->block_calls);
+
+    /* the instanced path uploads the recorded glyphs as is, the
+       non-instanced fallback expands each glyph into 6 vertices
+    */
+    int vbuf_size;
+    if (_sdtx.instanced) {
+        vbuf_size = max_glyphs * sizeof(_sdtx_glyph_t);
+    }
+    else {
+        vbuf_size = 6 * max_glyphs * sizeof(_sdtx_vertex_t);
+        ctx->vertices = (_sdtx_vertex_t*) SOKOL_MALLOC(vbuf_size);
+        SOKOL_ASSERT(ctx->vertices);
+    }
 
     sg_buffer_desc vbuf_desc;
     memset(&vbuf_desc, 0, sizeof(vbuf_desc));
@@ -3588,11 +3974,30 @@ static void _sdtx_init_context(sdtx_context ctx_id, const sdtx_context_desc_t* i
 
     sg_pipeline_desc pip_desc;
     memset(&pip_desc, 0, sizeof(pip_desc));
-    pip_desc.layout.buffers[0].stride = sizeof(_sdtx_vertex_t);
-    pip_desc.layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT2;
-    pip_desc.layout.attrs[1].format = SG_VERTEXFORMAT_USHORT2N;
-    pip_desc.layout.attrs[2].format = SG_VERTEXFORMAT_UBYTE4N;
-    pip_desc.shader = _sdtx.shader;
+    if (_sdtx.instanced) {
+        pip_desc.layout.buffers[0].stride = sizeof(_sdtx_float2_t);
+        pip_desc.layout.buffers[1].stride = sizeof(_sdtx_glyph_t);
+        pip_desc.layout.buffers[1].step_func = SG_VERTEXSTEP_PER_INSTANCE;
+        pip_desc.layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT2;
+        pip_desc.layout.attrs[1].buffer_index = 1;
+        pip_desc.layout.attrs[1].offset = offsetof(_sdtx_glyph_t, x);
+        pip_desc.layout.attrs[1].format = SG_VERTEXFORMAT_FLOAT4;
+        pip_desc.layout.attrs[2].buffer_index = 1;
+        pip_desc.layout.attrs[2].offset = offsetof(_sdtx_glyph_t, chr);
+        pip_desc.layout.attrs[2].format = SG_VERTEXFORMAT_UBYTE4N;
+        pip_desc.layout.attrs[3].buffer_index = 1;
+        pip_desc.layout.attrs[3].offset = offsetof(_sdtx_glyph_t, color);
+        pip_desc.layout.attrs[3].format = SG_VERTEXFORMAT_UBYTE4N;
+        pip_desc.shader = _sdtx.inst_shader;
+        pip_desc.primitive_type = SG_PRIMITIVETYPE_TRIANGLE_STRIP;
+    }
+    else {
+        pip_desc.layout.buffers[0].stride = sizeof(_sdtx_vertex_t);
+        pip_desc.layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT2;
+        pip_desc.layout.attrs[1].format = SG_VERTEXFORMAT_USHORT2N;
+        pip_desc.layout.attrs[2].format = SG_VERTEXFORMAT_UBYTE4N;
+        pip_desc.shader = _sdtx.shader;
+    }
     pip_desc.index_type = SG_INDEXTYPE_NONE;
     pip_desc.blend.enabled = true;
     pip_desc.blend.src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA;
@@ -3619,11 +4024,19 @@ static void _sdtx_init_context(sdtx_context ctx_id, const sdtx_context_desc_t* i
 static void _sdtx_destroy_context(sdtx_context ctx_id) {
     _sdtx_context_t* ctx = _sdtx_lookup_context(ctx_id.id);
     if (ctx) {
+        if (ctx->glyphs) {
+            SOKOL_FREE(ctx->glyphs);
+            ctx->glyphs = 0;
+            ctx->cur_glyph_ptr = 0;
+            ctx->max_glyph_ptr = 0;
+        }
         if (ctx->vertices) {
             SOKOL_FREE(ctx->vertices);
             ctx->vertices = 0;
-            ctx->cur_vertex_ptr = 0;
-            ctx->max_vertex_ptr = 0;
+        }
+        if (ctx->block_calls) {
+            SOKOL_FREE(ctx->block_calls);
+            ctx->block_calls = 0;
         }
         sg_push_debug_group("sokol_debugtext");
         sg_destroy_buffer(ctx->vbuf);
@@ -3724,6 +4137,62 @@ static void _sdtx_setup_common(void) {
     _sdtx.shader = sg_make_shader(&shd_desc);
     SOKOL_ASSERT(SG_INVALID_ID != _sdtx.shader.id);
 
+    /* render glyphs as instanced quads where possible, otherwise
+       fall back to expanding each glyph into 6 vertices on the CPU
+    */
+    #if defined(SOKOL_WGPU)
+        _sdtx.instanced = false;
+    #else
+        _sdtx.instanced = sg_query_features().instancing;
+    #endif
+    if (_sdtx.instanced) {
+        shd_desc.label = "sokol-debugtext-instanced-shader";
+        shd_desc.attrs[0].name = "corner";
+        shd_desc.attrs[1].name = "rect";
+        shd_desc.attrs[2].name = "glyph";
+        shd_desc.attrs[3].name = "color0";
+        shd_desc.attrs[3].sem_name = "TEXCOORD";
+        shd_desc.attrs[3].sem_index = 3;
+        shd_desc.vs.byte_code = 0;
+        shd_desc.vs.byte_code_size = 0;
+        shd_desc.fs.byte_code = 0;
+        shd_desc.fs.byte_code_size = 0;
+        #if defined(SOKOL_GLCORE33)
+            shd_desc.vs.source = _sdtx_inst_vs_src_glcore33;
+        #elif defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+            shd_desc.vs.source = _sdtx_inst_vs_src_gles2;
+        #elif defined(SOKOL_METAL)
+            shd_desc.vs.source = _sdtx_inst_vs_src_metal;
+            shd_desc.fs.source = _sdtx_fs_src_metal_sim;
+        #elif defined(SOKOL_D3D11)
+            shd_desc.vs.source = _sdtx_inst_vs_src_hlsl4;
+            shd_desc.fs.source = _sdtx_inst_fs_src_hlsl4;
+        #endif
+        _sdtx.inst_shader = sg_make_shader(&shd_desc);
+        /* the instanced shaders are compiled at runtime on some backends,
+           if this fails, use the non-instanced fallback instead
+        */
+        if (sg_query_shader_state(_sdtx.inst_shader) != SG_RESOURCESTATE_VALID) {
+            SOKOL_LOG("sokol_debugtext.h: failed to create instanced shader, using non-instanced fallback");
+            sg_destroy_shader(_sdtx.inst_shader);
+            _sdtx.inst_shader.id = SG_INVALID_ID;
+            _sdtx.instanced = false;
+        }
+    }
+    if (_sdtx.instanced) {
+        /* the unit quad as triangle strip */
+        static const _sdtx_float2_t quad[4] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } };
+        sg_buffer_desc quad_desc;
+        memset(&quad_desc, 0, sizeof(quad_desc));
+        quad_desc.size = sizeof(quad);
+        quad_desc.type = SG_BUFFERTYPE_VERTEXBUFFER;
+        quad_desc.usage = SG_USAGE_IMMUTABLE;
+        quad_desc.content = quad;
+        quad_desc.label = "sdtx-quad-vbuf";
+        _sdtx.quad_vbuf = sg_make_buffer(&quad_desc);
+        SOKOL_ASSERT(SG_INVALID_ID != _sdtx.quad_vbuf.id);
+    }
+
     /* unpack font data */
     memset(_sdtx.font_pixels, 0xFF, sizeof(_sdtx.font_pixels));
     const int unpacked_font_size = 256 * 8 * 8;
@@ -3755,6 +4224,10 @@ static void _sdtx_discard_common(void) {
     sg_push_debug_group("sokol-debugtext");
     sg_destroy_image(_sdtx.font_img);
     sg_destroy_shader(_sdtx.shader);
+    if (_sdtx.instanced) {
+        sg_destroy_buffer(_sdtx.quad_vbuf);
+        sg_destroy_shader(_sdtx.inst_shader);
+    }
     if (_sdtx.fmt_buf) {
         SOKOL_FREE(_sdtx.fmt_buf);
         _sdtx.fmt_buf = 0;
@@ -3799,17 +4272,34 @@ static inline void _sdtx_ctrl_char(_sdtx_context_t* ctx, uint8_t c) {
 }
 
 static inline void _sdtx_draw_char(_sdtx_context_t* ctx, uint8_t c) {
-    if ((ctx->cur_vertex_ptr + 6) <= ctx->max_vertex_ptr) {
-        const float x0 = (ctx->origin.x + ctx->pos.x) * ctx->glyph_size.x;
-        const float y0 = (ctx->origin.y + ctx->pos.y) * ctx->glyph_size.y;
-        const float x1 = x0 + ctx->glyph_size.x;
-        const float y1 = y0 + ctx->glyph_size.y;
-
-        // glyph width and heigth in font texture space
-        const uint16_t uvw = 0x10000 / 0x100;
-        const uint16_t uvh = 0x10000 / SDTX_MAX_FONTS;
-        const uint16_t u0 = ((uint16_t)c) * uvw;
-        const uint16_t v0 = ((uint16_t)ctx->cur_font) * uvh;
+    if (ctx->cur_glyph_ptr < ctx->max_glyph_ptr) {
+        _sdtx_glyph_t* g = ctx->cur_glyph_ptr++;
+        g->x = (ctx->origin.x + ctx->pos.x) * ctx->glyph_size.x;
+        g->y = (ctx->origin.y + ctx->pos.y) * ctx->glyph_size.y;
+        g->w = ctx->glyph_size.x;
+        g->h = ctx->glyph_size.y;
+        g->chr = c;
+        g->font = (uint8_t) ctx->cur_font;
+        g->reserved = 0;
+        g->color = ctx->color;
+    }
+    ctx->pos.x += 1.0f;
+}
+
+/* non-instanced fallback: expand glyphs into 6 vertices each */
+static int _sdtx_expand_glyphs(const _sdtx_glyph_t* glyphs, int num_glyphs, _sdtx_vertex_t* vertices) {
+    SOKOL_ASSERT(glyphs && vertices);
+    // glyph width and heigth in font texture space
+    const uint16_t uvw = 0x10000 / 0x100;
+    const uint16_t uvh = 0x10000 / SDTX_MAX_FONTS;
+    _sdtx_vertex_t* vx = vertices;
+    for (const _sdtx_glyph_t* g = glyphs; g < (glyphs + num_glyphs); g++) {
+        const float x0 = g->x;
+        const float y0 = g->y;
+        const float x1 = x0 + g->w;
+        const float y1 = y0 + g->h;
+        const uint16_t u0 = ((uint16_t)g->chr) * uvw;
+        const uint16_t v0 = ((uint16_t)g->font) * uvh;
         uint16_t u1 = u0 + uvw;
         uint16_t v1 = v0 + uvh;
         if (u1 == 0x0000) {
@@ -3818,10 +4308,7 @@ static inline void _sdtx_draw_char(_sdtx_context_t* ctx, uint8_t c) {
         if (v1 == 0x0000) {
             v1 = 0xFFFF;
         }
-        const uint32_t color = ctx->color;
-
-        // write 6 vertices
-        _sdtx_vertex_t* vx = ctx->cur_vertex_ptr;
+        const uint32_t color = g->color;
 
         vx->x=x0; vx->y=y0; vx->u = u0; vx->v = v0; vx->color = color; vx++;
         vx->x=x1; vx->y=y0; vx->u = u1; vx->v = v0; vx->color = color; vx++;
@@ -3830,10 +4317,8 @@ static inline void _sdtx_draw_char(_sdtx_context_t* ctx, uint8_t c) {
         vx->x=x0; vx->y=y0; vx->u = u0; vx->v = v0; vx->color = color; vx++;
         vx->x=x1; vx->y=y1; vx->u = u1; vx->v = v1; vx->color = color; vx++;
         vx->x=x0; vx->y=y1; vx->u = u0; vx->v = v1; vx->color = color; vx++;
-
-        ctx->cur_vertex_ptr = vx;
     }
-    ctx->pos.x += 1.0f;
+    return (int) (vx - vertices);
 }
 
 static inline void _sdtx_put_char(_sdtx_context_t* ctx, char c) {
@@ -3849,6 +4334,7 @@ static inline void _sdtx_put_char(_sdtx_context_t* ctx, char c) {
 static sdtx_desc_t _sdtx_desc_defaults(const sdtx_desc_t* in_desc) {
     sdtx_desc_t desc = *in_desc;
     desc.context_pool_size = _sdtx_def(desc.context_pool_size, _SDTX_DEFAULT_CONTEXT_POOL_SIZE);
+    desc.block_pool_size = _sdtx_def(desc.block_pool_size, _SDTX_DEFAULT_BLOCK_POOL_SIZE);
     desc.printf_buf_size = _sdtx_def(desc.printf_buf_size, _SDTX_DEFAULT_PRINTF_BUF_SIZE);
     for (int i = 0; i < SDTX_MAX_FONTS; i++) {
         if (desc.fonts[i].ptr) {
@@ -3859,6 +4345,231 @@ static sdtx_desc_t _sdtx_desc_defaults(const sdtx_desc_t* in_desc) {
     return desc;
 }
 
+/*=== CACHED TEXT BLOCKS =====================================================*/
+static void _sdtx_setup_block_pool(const sdtx_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    /* note: the pool will have an additional item, since slot 0 is reserved */
+    SOKOL_ASSERT((desc->block_pool_size > 0) && (desc->block_pool_size < _SDTX_MAX_POOL_SIZE));
+    _sdtx_init_pool(&_sdtx.block_pool.pool, desc->block_pool_size);
+    size_t pool_byte_size = sizeof(_sdtx_block_t) * _sdtx.block_pool.pool.size;
+    _sdtx.block_pool.blocks = (_sdtx_block_t*) SOKOL_MALLOC(pool_byte_size);
+    SOKOL_ASSERT(_sdtx.block_pool.blocks);
+    memset(_sdtx.block_pool.blocks, 0, pool_byte_size);
+}
+
+static void _sdtx_discard_block_pool(void) {
+    SOKOL_ASSERT(_sdtx.block_pool.blocks);
+    SOKOL_FREE(_sdtx.block_pool.blocks);
+    _sdtx.block_pool.blocks = 0;
+    _sdtx_discard_pool(&_sdtx.block_pool.pool);
+}
+
+/* get block pointer with id-check, returns 0 if no match */
+static _sdtx_block_t* _sdtx_lookup_block(uint32_t blk_id) {
+    if (SG_INVALID_ID != blk_id) {
+        int slot_index = _sdtx_slot_index(blk_id);
+        SOKOL_ASSERT((slot_index > _SDTX_INVALID_SLOT_INDEX) && (slot_index < _sdtx.block_pool.pool.size));
+        _sdtx_block_t* blk = &_sdtx.block_pool.blocks[slot_index];
+        if (blk->slot.id == blk_id) {
+            return blk;
+        }
+    }
+    return 0;
+}
+
+/* make block handle from raw uint32_t id */
+static sdtx_block _sdtx_make_blk_id(uint32_t blk_id) {
+    sdtx_block blk;
+    blk.id = blk_id;
+    return blk;
+}
+
+static sdtx_block _sdtx_alloc_block(void) {
+    sdtx_block blk_id;
+    int slot_index = _sdtx_pool_alloc_index(&_sdtx.block_pool.pool);
+    if (_SDTX_INVALID_SLOT_INDEX != slot_index) {
+        blk_id = _sdtx_make_blk_id(_sdtx_slot_alloc(&_sdtx.block_pool.pool, &_sdtx.block_pool.blocks[slot_index].slot, slot_index));
+    }
+    else {
+        /* pool is exhausted */
+        blk_id = _sdtx_make_blk_id(SG_INVALID_ID);
+    }
+    return blk_id;
+}
+
+static void _sdtx_destroy_block(sdtx_block blk_id) {
+    _sdtx_block_t* blk = _sdtx_lookup_block(blk_id.id);
+    if (blk) {
+        if (SG_INVALID_ID != blk->vbuf.id) {
+            sg_push_debug_group("sokol-debugtext");
+            sg_destroy_buffer(blk->vbuf);
+            sg_pop_debug_group();
+        }
+        memset(blk, 0, sizeof(*blk));
+        _sdtx_pool_free_index(&_sdtx.block_pool.pool, _sdtx_slot_index(blk_id.id));
+    }
+}
+
+/* FNV-1a style hash which consumes 8 bytes per step (each step is a
+   bijection, so a change in a single 8-byte word always changes the hash)
+*/
+static uint64_t _sdtx_hash(const char* str, int len) {
+    uint64_t h = 0xCBF29CE484222325ULL ^ (uint64_t)len;
+    int i = 0;
+    for (; (i + 8) <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, str + i, sizeof(w));
+        h = (h ^ w) * 0x100000001B3ULL;
+    }
+    for (; i < len; i++) {
+        h = (h ^ (uint8_t)str[i]) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+static _sdtx_block_key_t _sdtx_block_key(const _sdtx_context_t* ctx, const char* str, int len) {
+    _sdtx_block_key_t key;
+    key.hash = _sdtx_hash(str, len);
+    key.glyph_size = ctx->glyph_size;
+    key.origin = ctx->origin;
+    key.pos = ctx->pos;
+    key.tab_width = ctx->tab_width;
+    key.font = ctx->cur_font;
+    key.color = ctx->color;
+    return key;
+}
+
+static bool _sdtx_block_key_equal(const _sdtx_block_key_t* a, const _sdtx_block_key_t* b) {
+    return (a->hash == b->hash) &&
+           (a->glyph_size.x == b->glyph_size.x) && (a->glyph_size.y == b->glyph_size.y) &&
+           (a->origin.x == b->origin.x) && (a->origin.y == b->origin.y) &&
+           (a->pos.x == b->pos.x) && (a->pos.y == b->pos.y) &&
+           (a->tab_width == b->tab_width) &&
+           (a->font == b->font) &&
+           (a->color == b->color);
+}
+
+/* record the block's text into the shared scratch buffer (instead of the
+   context's glyph buffer), and bake the result into an immutable buffer
+*/
+static void _sdtx_build_block(_sdtx_context_t* ctx, _sdtx_block_t* blk, const char* str, int len) {
+    if (len > _sdtx.num_scratch_glyphs) {
+        if (_sdtx.scratch_glyphs) {
+            SOKOL_FREE(_sdtx.scratch_glyphs);
+        }
+        _sdtx.num_scratch_glyphs = len;
+        _sdtx.scratch_glyphs = (_sdtx_glyph_t*) SOKOL_MALLOC(len * sizeof(_sdtx_glyph_t));
+        SOKOL_ASSERT(_sdtx.scratch_glyphs);
+    }
+    _sdtx_glyph_t* cur_glyph_ptr = ctx->cur_glyph_ptr;
+    const _sdtx_glyph_t* max_glyph_ptr = ctx->max_glyph_ptr;
+    ctx->cur_glyph_ptr = _sdtx.scratch_glyphs;
+    ctx->max_glyph_ptr = _sdtx.scratch_glyphs + len;
+    for (int i = 0; i < len; i++) {
+        _sdtx_put_char(ctx, str[i]);
+    }
+    blk->num_glyphs = (int) (ctx->cur_glyph_ptr - _sdtx.scratch_glyphs);
+    blk->end_pos = ctx->pos;
+    ctx->cur_glyph_ptr = cur_glyph_ptr;
+    ctx->max_glyph_ptr = max_glyph_ptr;
+
+    sg_push_debug_group("sokol-debugtext");
+    if (SG_INVALID_ID != blk->vbuf.id) {
+        sg_destroy_buffer(blk->vbuf);
+        blk->vbuf.id = SG_INVALID_ID;
+    }
+    if (blk->num_glyphs > 0) {
+        sg_buffer_desc vbuf_desc;
+        memset(&vbuf_desc, 0, sizeof(vbuf_desc));
+        vbuf_desc.type = SG_BUFFERTYPE_VERTEXBUFFER;
+        vbuf_desc.usage = SG_USAGE_IMMUTABLE;
+        vbuf_desc.label = "sdtx-block-vbuf";
+        if (_sdtx.instanced) {
+            vbuf_desc.size = blk->num_glyphs * sizeof(_sdtx_glyph_t);
+            vbuf_desc.content = _sdtx.scratch_glyphs;
+            blk->vbuf = sg_make_buffer(&vbuf_desc);
+        }
+        else {
+            vbuf_desc.size = 6 * blk->num_glyphs * sizeof(_sdtx_vertex_t);
+            _sdtx_vertex_t* vertices = (_sdtx_vertex_t*) SOKOL_MALLOC(vbuf_desc.size);
+            SOKOL_ASSERT(vertices);
+            _sdtx_expand_glyphs(_sdtx.scratch_glyphs, blk->num_glyphs, vertices);
+            vbuf_desc.content = vertices;
+            blk->vbuf = sg_make_buffer(&vbuf_desc);
+            SOKOL_FREE(vertices);
+        }
+    }
+    sg_pop_debug_group();
+}
+
+/* move the cursor behind the block's text and record a block call into the context */
+static void _sdtx_call_block(_sdtx_context_t* ctx, _sdtx_block_t* blk) {
+    ctx->pos = blk->end_pos;
+    if ((blk->num_glyphs > 0) && (ctx->num_block_calls < ctx->max_block_calls)) {
+        _sdtx_block_call_t* call = &ctx->block_calls[ctx->num_block_calls++];
+        call->block_id = blk->slot.id;
+        call->glyph_index = (int) (ctx->cur_glyph_ptr - ctx->glyphs);
+        blk->num_calls++;
+    }
+}
+
+/* forget the context's block calls without drawing them */
+static void _sdtx_discard_block_calls(_sdtx_context_t* ctx) {
+    for (int i = 0; i < ctx->num_block_calls; i++) {
+        _sdtx_block_t* blk = _sdtx_lookup_block(ctx->block_calls[i].block_id);
+        if (blk) {
+            SOKOL_ASSERT(blk->num_calls > 0);
+            blk->num_calls--;
+        }
+    }
+    ctx->num_block_calls = 0;
+}
+
+/* rebuild the block if its key doesn't match, move the cursor
+   behind the block's text, and record a block call into the context
+*/
+static void _sdtx_put_block(_sdtx_context_t* ctx, _sdtx_block_t* blk, const char* str, int len) {
+    const _sdtx_block_key_t key = _sdtx_block_key(ctx, str, len);
+    if (!blk->valid || !_sdtx_block_key_equal(&key, &blk->key)) {
+        if (blk->num_calls > 0) {
+            /* the block's current buffer is still needed by an earlier block
+               call which hasn't been drawn yet, output the text as regular
+               characters instead of rebuilding the block
+            */
+            for (int i = 0; i < len; i++) {
+                _sdtx_put_char(ctx, str[i]);
+            }
+            return;
+        }
+        _sdtx_build_block(ctx, blk, str, len);
+        blk->key = key;
+        blk->valid = true;
+    }
+    _sdtx_call_block(ctx, blk);
+}
+
+/* draw a range of glyphs from an instance buffer, or the matching vertices in the fallback */
+static void _sdtx_draw_glyphs(sg_buffer vbuf, int vbuf_offset, int first_glyph, int num_glyphs) {
+    if (num_glyphs > 0) {
+        sg_bindings bindings;
+        memset(&bindings, 0, sizeof(bindings));
+        bindings.fs_images[0] = _sdtx.font_img;
+        if (_sdtx.instanced) {
+            bindings.vertex_buffers[0] = _sdtx.quad_vbuf;
+            bindings.vertex_buffers[1] = vbuf;
+            bindings.vertex_buffer_offsets[1] = vbuf_offset + first_glyph * (int)sizeof(_sdtx_glyph_t);
+            sg_apply_bindings(&bindings);
+            sg_draw(0, 4, num_glyphs);
+        }
+        else {
+            bindings.vertex_buffers[0] = vbuf;
+            bindings.vertex_buffer_offsets[0] = vbuf_offset;
+            sg_apply_bindings(&bindings);
+            sg_draw(6 * first_glyph, 6 * num_glyphs, 1);
+        }
+    }
+}
+
 /*=== PUBLIC API FUNCTIONS ===================================================*/
 SOKOL_API_IMPL void sdtx_setup(const sdtx_desc_t* desc) {
     SOKOL_ASSERT(desc);
@@ -3866,6 +4577,7 @@ SOKOL_API_IMPL void sdtx_setup(const sdtx_desc_t* desc) {
     _sdtx.init_cookie = _SDTX_INIT_COOKIE;
     _sdtx.desc = _sdtx_desc_defaults(desc);
     _sdtx_setup_context_pool(&_sdtx.desc);
+    _sdtx_setup_block_pool(&_sdtx.desc);
     _sdtx_setup_common();
     _sdtx.def_ctx_id = sdtx_make_context(&_sdtx.desc.context);
     SOKOL_ASSERT(SDTX_DEFAULT_CONTEXT.id == _sdtx.def_ctx_id.id);
@@ -3878,7 +4590,16 @@ SOKOL_API_IMPL void sdtx_shutdown(void) {
         _sdtx_context_t* ctx = &_sdtx.context_pool.contexts[i];
         _sdtx_destroy_context(_sdtx_make_ctx_id(ctx->slot.id));
     }
+    for (int i = 0; i < _sdtx.block_pool.pool.size; i++) {
+        _sdtx_block_t* blk = &_sdtx.block_pool.blocks[i];
+        _sdtx_destroy_block(_sdtx_make_blk_id(blk->slot.id));
+    }
+    if (_sdtx.scratch_glyphs) {
+        SOKOL_FREE(_sdtx.scratch_glyphs);
+        _sdtx.scratch_glyphs = 0;
+    }
     _sdtx_discard_common();
+    _sdtx_discard_block_pool();
     _sdtx_discard_context_pool();
     _sdtx.init_cookie = 0;
 }
@@ -3932,6 +4653,10 @@ SOKOL_API_IMPL void sdtx_destroy_context(sdtx_context ctx_id) {
         SOKOL_LOG("sokol_debugtext.h: cannot destroy default context");
         return;
     }
+    _sdtx_context_t* ctx = _sdtx_lookup_context(ctx_id.id);
+    if (ctx) {
+        _sdtx_discard_block_calls(ctx);
+    }
     _sdtx_destroy_context(ctx_id);
     // re-validate the current context pointer (this will return a nullptr
     // if we just destroyed the current context)
@@ -4157,26 +4882,112 @@ SOKOL_API_IMPL void sdtx_draw(void) {
     SOKOL_ASSERT(_SDTX_INIT_COOKIE == _sdtx.init_cookie);
     _sdtx_context_t* ctx = _sdtx.cur_ctx;
     if (ctx) {
-        const int num_verts = (int) (ctx->cur_vertex_ptr - ctx->vertices);
-        if (num_verts > 0) {
-            SOKOL_ASSERT((num_verts % 6) == 0);
+        const int num_glyphs = (int) (ctx->cur_glyph_ptr - ctx->glyphs);
+        if ((num_glyphs > 0) || (ctx->num_block_calls > 0)) {
             sg_push_debug_group("sokol-debugtext");
-            int vbuf_offset = sg_append_buffer(ctx->vbuf, ctx->vertices, num_verts * sizeof(_sdtx_vertex_t));
+            int vbuf_offset = 0;
+            if (num_glyphs > 0) {
+                if (_sdtx.instanced) {
+                    vbuf_offset = sg_append_buffer(ctx->vbuf, ctx->glyphs, num_glyphs * sizeof(_sdtx_glyph_t));
+                }
+                else {
+                    const int num_verts = _sdtx_expand_glyphs(ctx->glyphs, num_glyphs, ctx->vertices);
+                    SOKOL_ASSERT(num_verts == (6 * num_glyphs));
+                    vbuf_offset = sg_append_buffer(ctx->vbuf, ctx->vertices, num_verts * sizeof(_sdtx_vertex_t));
+                }
+            }
             sg_apply_pipeline(ctx->pip);
-            sg_bindings bindings;
-            memset(&bindings, 0, sizeof(bindings));
-            bindings.vertex_buffers[0] = ctx->vbuf;
-            bindings.vertex_buffer_offsets[0] = vbuf_offset;
-            bindings.fs_images[0] = _sdtx.font_img;
-            sg_apply_bindings(&bindings);
-            sg_draw(0, num_verts, 1);
+            /* cached text blocks are drawn in between the regular glyphs recorded before and after them */
+            int first_glyph = 0;
+            for (int i = 0; i < ctx->num_block_calls; i++) {
+                const _sdtx_block_call_t* call = &ctx->block_calls[i];
+                _sdtx_draw_glyphs(ctx->vbuf, vbuf_offset, first_glyph, call->glyph_index - first_glyph);
+                first_glyph = call->glyph_index;
+                _sdtx_block_t* blk = _sdtx_lookup_block(call->block_id);
+                if (blk) {
+                    SOKOL_ASSERT(blk->num_calls > 0);
+                    blk->num_calls--;
+                    _sdtx_draw_glyphs(blk->vbuf, 0, 0, blk->num_glyphs);
+                }
+            }
+            _sdtx_draw_glyphs(ctx->vbuf, vbuf_offset, first_glyph, num_glyphs - first_glyph);
             sg_pop_debug_group();
         }
-        ctx->cur_vertex_ptr = ctx->vertices;
+        ctx->cur_glyph_ptr = ctx->glyphs;
+        ctx->num_block_calls = 0;
         ctx->cur_font = 0;
         ctx->pos.x = 0.0f;
         ctx->pos.y = 0.0f;
     }
 }
 
+SOKOL_API_IMPL sdtx_block sdtx_make_block(void) {
+    SOKOL_ASSERT(_SDTX_INIT_COOKIE == _sdtx.init_cookie);
+    sdtx_block blk_id = _sdtx_alloc_block();
+    if (blk_id.id == SG_INVALID_ID) {
+        SOKOL_LOG("sokol_debugtext.h: block pool exhausted!");
+    }
+    return blk_id;
+}
+
+SOKOL_API_IMPL void sdtx_destroy_block(sdtx_block blk_id) {
+    SOKOL_ASSERT(_SDTX_INIT_COOKIE == _sdtx.init_cookie);
+    _sdtx_destroy_block(blk_id);
+}
+
+SOKOL_API_IMPL void sdtx_invalidate_block(sdtx_block blk_id) {
+    SOKOL_ASSERT(_SDTX_INIT_COOKIE == _sdtx.init_cookie);
+    _sdtx_block_t* blk = _sdtx_lookup_block(blk_id.id);
+    if (blk) {
+        blk->valid = false;
+    }
+}
+
+SOKOL_API_IMPL void sdtx_block_puts(sdtx_block blk_id, const char* str) {
+    SOKOL_ASSERT(_SDTX_INIT_COOKIE == _sdtx.init_cookie);
+    SOKOL_ASSERT(str);
+    _sdtx_context_t* ctx = _sdtx.cur_ctx;
+    _sdtx_block_t* blk = _sdtx_lookup_block(blk_id.id);
+    if (ctx && blk) {
+        _sdtx_put_block(ctx, blk, str, (int) strlen(str));
+    }
+}
+
+SOKOL_API_IMPL void sdtx_block_putr(sdtx_block blk_id, const char* str, int len) {
+    SOKOL_ASSERT(_SDTX_INIT_COOKIE == _sdtx.init_cookie);
+    SOKOL_ASSERT(str && (len >= 0));
+    _sdtx_context_t* ctx = _sdtx.cur_ctx;
+    _sdtx_block_t* blk = _sdtx_lookup_block(blk_id.id);
+    if (ctx && blk) {
+        // like sdtx_putr(), also stop at the zero-char
+        int n = 0;
+        while ((n < len) && (0 != str[n])) {
+            n++;
+        }
+        _sdtx_put_block(ctx, blk, str, n);
+    }
+}
+
+SOKOL_API_IMPL void sdtx_block_redraw(sdtx_block blk_id) {
+    SOKOL_ASSERT(_SDTX_INIT_COOKIE == _sdtx.init_cookie);
+    _sdtx_context_t* ctx = _sdtx.cur_ctx;
+    _sdtx_block_t* blk = _sdtx_lookup_block(blk_id.id);
+    if (ctx && blk && blk->valid) {
+        _sdtx_call_block(ctx, blk);
+    }
+}
+
+SOKOL_API_IMPL int sdtx_block_printf(sdtx_block blk_id, const char* fmt, ...) {
+    SOKOL_ASSERT(_SDTX_INIT_COOKIE == _sdtx.init_cookie);
+    SOKOL_ASSERT(_sdtx.fmt_buf && (_sdtx.fmt_buf_size >= 2));
+    va_list args;
+    va_start(args, fmt);
+    int res = SOKOL_VSNPRINTF(_sdtx.fmt_buf, _sdtx.fmt_buf_size, fmt, args);
+    va_end(args);
+    // make sure we're 0-terminated in case we're on an old MSVC
+    _sdtx.fmt_buf[_sdtx.fmt_buf_size-1] = 0;
+    sdtx_block_puts(blk_id, _sdtx.fmt_buf);
+    return res;
+}
+
 #endif /* SOKOL_DEBUGTEXT_IMPL */
@@ -0,0 +1,492 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_DRAWQUEUE_IMPL)
+#define SOKOL_DRAWQUEUE_IMPL
+#endif
+#ifndef SOKOL_DRAWQUEUE_INCLUDED
+/*
+    sokol_drawqueue.h -- sort-key draw queue on top of sokol_gfx.h
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_DRAWQUEUE_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_drawqueue.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)     - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)       - your own free function (default: free(p))
+    SOKOL_DRAWQUEUE_API_DECL - public function declaration prefix (default: extern)
+    SOKOL_API_DECL      - same as SOKOL_DRAWQUEUE_API_DECL
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+
+    If sokol_drawqueue.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_DRAWQUEUE_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_gfx.h executes draw calls in the order they are issued, so
+    a renderer which walks its scene in 'scene order' usually ends up
+    switching pipelines and textures much more often than necessary.
+
+    sokol_drawqueue.h records draw calls (pipeline, bindings, uniform
+    data and draw parameters) together with a 64-bit sort key. When the
+    queue is flushed at the end of a render pass, the recorded draws are
+    radix-sorted by their key and replayed through sg_apply_pipeline(),
+    sg_apply_bindings(), sg_apply_uniforms() and sg_draw(), skipping
+    all calls which wouldn't change the current state.
+
+    The sort is stable, draws with identical keys are replayed in
+    the order they have been enqueued.
+
+    STEP BY STEP
+    ============
+    --- call sdq_setup() after sg_setup():
+
+            sdq_setup(&(sdq_desc_t){
+                .max_draws = ...,           // default: 4096
+                .uniform_buffer_size = ...  // default: 256 KBytes
+            });
+
+    --- inside a sokol_gfx render pass, enqueue draws instead of calling
+        the sg_apply_*() and sg_draw() functions directly:
+
+            sdq_enqueue(&(sdq_draw_t){
+                .key = ...,
+                .pipeline = pip,
+                .bindings = { .vertex_buffers[0] = vbuf, .fs_images[0] = img },
+                .vs_uniforms[0] = { .ptr = &vs_params, .size = sizeof(vs_params) },
+                .num_elements = 36,
+                .num_instances = 1
+            });
+
+        The uniform data is copied into an internal buffer, so the
+        pointers only need to be valid during the sdq_enqueue() call.
+        sdq_enqueue() returns false if the draw had to be dropped
+        because the queue or the uniform buffer is full.
+
+        A zero num_instances will be replaced with 1.
+
+    --- before calling sg_end_pass(), sort and replay the recorded draws:
+
+            sdq_flush();
+            sg_end_pass();
+
+    --- to check how effective the sorting was, call sdq_query_stats()
+        after sdq_flush(), this returns the number of sg_apply_*() calls
+        which have actually been issued, and how many sg_apply_*() calls
+        have been saved compared to replaying the same draws in the order
+        they were enqueued.
+
+    --- at shutdown, call sdq_shutdown() before sg_shutdown()
+
+    BUILDING SORT KEYS
+    ==================
+    The sort key is completely defined by the caller, the draw queue
+    only sorts by it in ascending order. A typical key puts the most
+    expensive state changes into the upper bits, for instance:
+
+        63     56 55            40 39            24 23                   0
+        +--------+----------------+----------------+---------------------+
+        | layer  | pipeline slot  | texture slot   | depth (front2back)  |
+        +--------+----------------+----------------+---------------------+
+
+    The lower 16 bits of sokol_gfx.h resource ids are the pool slot index,
+    which makes a good compact key component:
+
+        uint64_t key = ((uint64_t)layer << 56) |
+                       ((uint64_t)(pip.id & 0xFFFF) << 40) |
+                       ((uint64_t)(img.id & 0xFFFF) << 24) |
+                       (depth_bits & 0xFFFFFF);
+
+    Radix-sort passes over bytes which are identical in all keys are
+    skipped, so keys with unused bits don't cost extra sorting time.
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2020 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_DRAWQUEUE_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_drawqueue.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_DRAWQUEUE_API_DECL)
+#define SOKOL_DRAWQUEUE_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_DRAWQUEUE_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_DRAWQUEUE_IMPL)
+#define SOKOL_DRAWQUEUE_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_DRAWQUEUE_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_DRAWQUEUE_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sdq_desc_t {
+    int max_draws;              /* max number of draws between two sdq_flush() calls (default: 4096) */
+    int uniform_buffer_size;    /* size of the uniform data buffer in bytes (default: 256 KBytes) */
+} sdq_desc_t;
+
+typedef struct sdq_range_t {
+    const void* ptr;
+    int size;
+} sdq_range_t;
+
+typedef struct sdq_draw_t {
+    uint64_t key;
+    sg_pipeline pipeline;
+    sg_bindings bindings;
+    sdq_range_t vs_uniforms[SG_MAX_SHADERSTAGE_UBS];
+    sdq_range_t fs_uniforms[SG_MAX_SHADERSTAGE_UBS];
+    int base_element;
+    int num_elements;
+    int num_instances;
+} sdq_draw_t;
+
+typedef struct sdq_stats_t {
+    int num_draws;                  /* number of draws replayed by the last sdq_flush() */
+    int num_dropped;                /* number of draws dropped because the queue was full */
+    int num_apply_pipeline;         /* number of sg_apply_pipeline() calls issued */
+    int num_apply_bindings;         /* number of sg_apply_bindings() calls issued */
+    int num_apply_uniforms;         /* number of sg_apply_uniforms() calls issued */
+    int saved_apply_pipeline;       /* sg_apply_pipeline() calls saved versus submission order */
+    int saved_apply_bindings;       /* sg_apply_bindings() calls saved versus submission order */
+    int saved_apply_uniforms;       /* sg_apply_uniforms() calls saved versus submission order */
+} sdq_stats_t;
+
+SOKOL_DRAWQUEUE_API_DECL void sdq_setup(const sdq_desc_t* desc);
+SOKOL_DRAWQUEUE_API_DECL void sdq_shutdown(void);
+SOKOL_DRAWQUEUE_API_DECL bool sdq_enqueue(const sdq_draw_t* draw);
+SOKOL_DRAWQUEUE_API_DECL void sdq_flush(void);
+SOKOL_DRAWQUEUE_API_DECL sdq_stats_t sdq_query_stats(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+
+/* reference-based equivalents for c++ */
+inline void sdq_setup(const sdq_desc_t& desc) { return sdq_setup(&desc); }
+inline bool sdq_enqueue(const sdq_draw_t& draw) { return sdq_enqueue(&draw); }
+
+#endif
+#endif /* SOKOL_DRAWQUEUE_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_DRAWQUEUE_IMPL
+#define SOKOL_DRAWQUEUE_IMPL_INCLUDED (1)
+
+#include <string.h> // memset, memcpy, memcmp
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+
+#define _sdq_def(val, def) (((val) == 0) ? (def) : (val))
+#define _SDQ_INIT_COOKIE (0xDEADD0E5)
+#define _SDQ_DEFAULT_MAX_DRAWS (4096)
+#define _SDQ_DEFAULT_UNIFORM_BUFFER_SIZE (256 * 1024)
+#define _SDQ_NUM_UB_SLOTS (SG_NUM_SHADER_STAGES * SG_MAX_SHADERSTAGE_UBS)
+#define _SDQ_RADIX_BITS (8)
+#define _SDQ_RADIX_BUCKETS (1<<_SDQ_RADIX_BITS)
+#define _SDQ_RADIX_PASSES (64 / _SDQ_RADIX_BITS)
+
+/* a uniform data range in the uniform buffer, size == 0 means 'no update' */
+typedef struct {
+    int offset;
+    int size;
+} _sdq_ub_range_t;
+
+typedef struct {
+    sg_pipeline pipeline;
+    sg_bindings bindings;
+    _sdq_ub_range_t ub[_SDQ_NUM_UB_SLOTS];
+    int base_element;
+    int num_elements;
+    int num_instances;
+} _sdq_item_t;
+
+typedef struct {
+    uint64_t key;
+    uint32_t index;
+} _sdq_sort_item_t;
+
+typedef struct {
+    int num_apply_pipeline;
+    int num_apply_bindings;
+    int num_apply_uniforms;
+} _sdq_counts_t;
+
+typedef struct {
+    uint32_t init_cookie;
+    sdq_desc_t desc;
+    int num_items;
+    int num_dropped;
+    _sdq_item_t* items;
+    _sdq_sort_item_t* sort_items;
+    _sdq_sort_item_t* sort_tmp;
+    int ub_pos;
+    uint8_t* ub_data;
+    sdq_stats_t stats;
+} _sdq_t;
+static _sdq_t _sdq;
+
+static sdq_desc_t _sdq_desc_defaults(const sdq_desc_t* in_desc) {
+    sdq_desc_t desc = *in_desc;
+    desc.max_draws = _sdq_def(desc.max_draws, _SDQ_DEFAULT_MAX_DRAWS);
+    desc.uniform_buffer_size = _sdq_def(desc.uniform_buffer_size, _SDQ_DEFAULT_UNIFORM_BUFFER_SIZE);
+    return desc;
+}
+
+static int _sdq_roundup(int val, int round_to) {
+    return (val+(round_to-1)) & ~(round_to-1);
+}
+
+/* stable LSD radix sort over 8-bit digits, passes where all keys have the
+   same digit are skipped, returns pointer to the sorted array (which is
+   either _sdq.sort_items or _sdq.sort_tmp)
+*/
+static _sdq_sort_item_t* _sdq_radix_sort(int num) {
+    uint32_t hist[_SDQ_RADIX_PASSES][_SDQ_RADIX_BUCKETS];
+    memset(hist, 0, sizeof(hist));
+    _sdq_sort_item_t* src = _sdq.sort_items;
+    _sdq_sort_item_t* dst = _sdq.sort_tmp;
+    /* gather the histograms of all passes in one go */
+    for (int i = 0; i < num; i++) {
+        uint64_t key = src[i].key;
+        for (int pass = 0; pass < _SDQ_RADIX_PASSES; pass++) {
+            hist[pass][(key >> (pass * _SDQ_RADIX_BITS)) & (_SDQ_RADIX_BUCKETS-1)]++;
+        }
+    }
+    for (int pass = 0; pass < _SDQ_RADIX_PASSES; pass++) {
+        const int shift = pass * _SDQ_RADIX_BITS;
+        uint32_t* h = hist[pass];
+        /* skip the pass if all keys have the same digit */
+        if (h[(src[0].key >> shift) & (_SDQ_RADIX_BUCKETS-1)] == (uint32_t)num) {
+            continue;
+        }
+        /* histogram to start offsets */
+        uint32_t offset = 0;
+        for (int b = 0; b < _SDQ_RADIX_BUCKETS; b++) {
+            uint32_t cnt = h[b];
+            h[b] = offset;
+            offset += cnt;
+        }
+        for (int i = 0; i < num; i++) {
+            dst[h[(src[i].key >> shift) & (_SDQ_RADIX_BUCKETS-1)]++] = src[i];
+        }
+        _sdq_sort_item_t* tmp = src; src = dst; dst = tmp;
+    }
+    return src;
+}
+
+static bool _sdq_ub_equal(const _sdq_ub_range_t* a, const _sdq_ub_range_t* b) {
+    return (a->size == b->size) && ((a->offset == b->offset) ||
+        (0 == memcmp(&_sdq.ub_data[a->offset], &_sdq.ub_data[b->offset], (size_t)a->size)));
+}
+
+/* walk the draws in the given order and count (and optionally issue) all
+   state changes which are not redundant
+*/
+static _sdq_counts_t _sdq_replay(const _sdq_sort_item_t* order, int num, bool issue) {
+    _sdq_counts_t cnt;
+    memset(&cnt, 0, sizeof(cnt));
+    const _sdq_item_t* prev = 0;
+    _sdq_ub_range_t cur_ub[_SDQ_NUM_UB_SLOTS];
+    memset(cur_ub, 0, sizeof(cur_ub));
+    for (int i = 0; i < num; i++) {
+        const _sdq_item_t* item = &_sdq.items[order ? order[i].index : (uint32_t)i];
+        bool pip_changed = (0 == prev) || (prev->pipeline.id != item->pipeline.id);
+        if (pip_changed) {
+            /* a new pipeline invalidates the bindings and uniforms */
+            cnt.num_apply_pipeline++;
+            memset(cur_ub, 0, sizeof(cur_ub));
+            if (issue) {
+                sg_apply_pipeline(item->pipeline);
+            }
+        }
+        if (pip_changed || (0 != memcmp(&prev->bindings, &item->bindings, sizeof(sg_bindings)))) {
+            cnt.num_apply_bindings++;
+            if (issue) {
+                sg_apply_bindings(&item->bindings);
+            }
+        }
+        for (int slot = 0; slot < _SDQ_NUM_UB_SLOTS; slot++) {
+            const _sdq_ub_range_t* ub = &item->ub[slot];
+            if ((ub->size > 0) && !_sdq_ub_equal(ub, &cur_ub[slot])) {
+                cnt.num_apply_uniforms++;
+                cur_ub[slot] = *ub;
+                if (issue) {
+                    sg_shader_stage stage = (slot < SG_MAX_SHADERSTAGE_UBS) ? SG_SHADERSTAGE_VS : SG_SHADERSTAGE_FS;
+                    sg_apply_uniforms(stage, slot % SG_MAX_SHADERSTAGE_UBS, &_sdq.ub_data[ub->offset], ub->size);
+                }
+            }
+        }
+        if (issue) {
+            sg_draw(item->base_element, item->num_elements, item->num_instances);
+        }
+        prev = item;
+    }
+    return cnt;
+}
+
+static bool _sdq_copy_uniforms(_sdq_item_t* item, int slot, const sdq_range_t* range) {
+    if ((0 == range->ptr) || (0 == range->size)) {
+        return true;
+    }
+    SOKOL_ASSERT(range->size > 0);
+    /* sg_apply_uniforms() accepts unaligned data, 16-byte alignment only
+       keeps the copies fast
+    */
+    const int size = _sdq_roundup(range->size, 16);
+    if ((_sdq.ub_pos + size) > _sdq.desc.uniform_buffer_size) {
+        return false;
+    }
+    memcpy(&_sdq.ub_data[_sdq.ub_pos], range->ptr, (size_t)range->size);
+    item->ub[slot].offset = _sdq.ub_pos;
+    item->ub[slot].size = range->size;
+    _sdq.ub_pos += size;
+    return true;
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL void sdq_setup(const sdq_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    memset(&_sdq, 0, sizeof(_sdq));
+    _sdq.init_cookie = _SDQ_INIT_COOKIE;
+    _sdq.desc = _sdq_desc_defaults(desc);
+    SOKOL_ASSERT(_sdq.desc.max_draws > 0);
+    SOKOL_ASSERT(_sdq.desc.uniform_buffer_size > 0);
+    const int max_draws = _sdq.desc.max_draws;
+    _sdq.items = (_sdq_item_t*) SOKOL_MALLOC((size_t)max_draws * sizeof(_sdq_item_t));
+    SOKOL_ASSERT(_sdq.items);
+    _sdq.sort_items = (_sdq_sort_item_t*) SOKOL_MALLOC((size_t)max_draws * sizeof(_sdq_sort_item_t));
+    SOKOL_ASSERT(_sdq.sort_items);
+    _sdq.sort_tmp = (_sdq_sort_item_t*) SOKOL_MALLOC((size_t)max_draws * sizeof(_sdq_sort_item_t));
+    SOKOL_ASSERT(_sdq.sort_tmp);
+    _sdq.ub_data = (uint8_t*) SOKOL_MALLOC((size_t)_sdq.desc.uniform_buffer_size);
+    SOKOL_ASSERT(_sdq.ub_data);
+}
+
+SOKOL_API_IMPL void sdq_shutdown(void) {
+    SOKOL_ASSERT(_SDQ_INIT_COOKIE == _sdq.init_cookie);
+    SOKOL_FREE(_sdq.ub_data); _sdq.ub_data = 0;
+    SOKOL_FREE(_sdq.sort_tmp); _sdq.sort_tmp = 0;
+    SOKOL_FREE(_sdq.sort_items); _sdq.sort_items = 0;
+    SOKOL_FREE(_sdq.items); _sdq.items = 0;
+    _sdq.init_cookie = 0;
+}
+
+SOKOL_API_IMPL bool sdq_enqueue(const sdq_draw_t* draw) {
+    SOKOL_ASSERT(_SDQ_INIT_COOKIE == _sdq.init_cookie);
+    SOKOL_ASSERT(draw);
+    SOKOL_ASSERT((draw->bindings._start_canary == 0) && (draw->bindings._end_canary == 0));
+    if (_sdq.num_items >= _sdq.desc.max_draws) {
+        _sdq.num_dropped++;
+        return false;
+    }
+    const int ub_pos = _sdq.ub_pos;
+    _sdq_item_t* item = &_sdq.items[_sdq.num_items];
+    memset(item, 0, sizeof(_sdq_item_t));
+    item->pipeline = draw->pipeline;
+    item->bindings = draw->bindings;
+    item->base_element = draw->base_element;
+    item->num_elements = draw->num_elements;
+    item->num_instances = _sdq_def(draw->num_instances, 1);
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_UBS; i++) {
+        if (!_sdq_copy_uniforms(item, i, &draw->vs_uniforms[i]) ||
+            !_sdq_copy_uniforms(item, SG_MAX_SHADERSTAGE_UBS + i, &draw->fs_uniforms[i]))
+        {
+            /* uniform buffer exhausted, roll back */
+            _sdq.ub_pos = ub_pos;
+            _sdq.num_dropped++;
+            return false;
+        }
+    }
+    _sdq.sort_items[_sdq.num_items].key = draw->key;
+    _sdq.sort_items[_sdq.num_items].index = (uint32_t)_sdq.num_items;
+    _sdq.num_items++;
+    return true;
+}
+
+SOKOL_API_IMPL void sdq_flush(void) {
+    SOKOL_ASSERT(_SDQ_INIT_COOKIE == _sdq.init_cookie);
+    memset(&_sdq.stats, 0, sizeof(_sdq.stats));
+    const int num = _sdq.num_items;
+    _sdq.stats.num_draws = num;
+    _sdq.stats.num_dropped = _sdq.num_dropped;
+    if (num > 0) {
+        const _sdq_counts_t unsorted = _sdq_replay(0, num, false);
+        const _sdq_sort_item_t* order = _sdq_radix_sort(num);
+        const _sdq_counts_t sorted = _sdq_replay(order, num, true);
+        _sdq.stats.num_apply_pipeline = sorted.num_apply_pipeline;
+        _sdq.stats.num_apply_bindings = sorted.num_apply_bindings;
+        _sdq.stats.num_apply_uniforms = sorted.num_apply_uniforms;
+        _sdq.stats.saved_apply_pipeline = unsorted.num_apply_pipeline - sorted.num_apply_pipeline;
+        _sdq.stats.saved_apply_bindings = unsorted.num_apply_bindings - sorted.num_apply_bindings;
+        _sdq.stats.saved_apply_uniforms = unsorted.num_apply_uniforms - sorted.num_apply_uniforms;
+    }
+    _sdq.num_items = 0;
+    _sdq.num_dropped = 0;
+    _sdq.ub_pos = 0;
+}
+
+SOKOL_API_IMPL sdq_stats_t sdq_query_stats(void) {
+    SOKOL_ASSERT(_SDQ_INIT_COOKIE == _sdq.init_cookie);
+    return _sdq.stats;
+}
+
+#endif /* SOKOL_DRAWQUEUE_IMPL */
@@ -34,6 +34,7 @@
     SOKOL_API_IMPL      - public function implementation prefix (default: -)
     SOKOL_LOG(msg)      - your own logging function (default: puts(msg))
     SOKOL_UNREACHABLE() - a guard macro for unreachable code (default: assert(false))
+    SOKOL_GL_NO_SIMD    - don't use the SSE2 or NEON code path for CPU vertex transforms
 
     If sokol_gl.h is compiled as a DLL, define the following before
     including the declaration or implementation:
@@ -65,7 +66,7 @@
             - 2D texture coords (u, v)
             - color (r, g, b, a)
         - primitive types:
-            - triangle list and strip
+            - triangle list, strip and fan
             - line list and strip
             - quad list (TODO: quad strips)
             - point list (TODO: point size)
@@ -73,11 +74,12 @@
         - viewport and scissor-rect with selectable origin (top-left or bottom-left)
         - all GL 1.x matrix stack functions, and additionally equivalent
           functions for gluPerspective and gluLookat
+        - display lists (similar to glNewList / glCallList)
+        - vertex arrays (similar to glVertexPointer / glDrawArrays, but inside
+          sgl_begin_*() / sgl_end())
 
     Notable GLES 1.x features that are *NOT* implemented:
         - vertex lighting (this is the most likely GL feature that might be added later)
-        - vertex arrays (although providing whole chunks of vertex data at once
-          might be a useful feature for a later version)
         - texture coordinate generation
         - point size and line width
         - all pixel store functions
@@ -122,9 +124,11 @@
             int max_commands    - default is 16384
 
         You can adjust the size of the internal pipeline state object pool
-        with:
+        and context pool with:
 
-            int pipeline_pool_size  - default is 64
+            int pipeline_pool_size      - default is 64
+            int context_pool_size       - default is 4
+            int display_list_pool_size  - default is 64
 
         Finally you can change the face winding for front-facing triangles
         and quads:
@@ -134,6 +138,35 @@
         The default winding for front faces is counter-clock-wise. This is
         the same as OpenGL's default, but different from sokol-gfx.
 
+        Optionally enable the 'pretransform mode' (see ON DRAW COMMAND MERGING
+        below) with:
+
+            bool pretransform   - default is false
+
+        ...and optionally let the buffers grow on demand instead of
+        failing when max_vertices or max_commands is exceeded:
+
+            bool growable       - default is false
+
+        In a growable context, max_vertices and max_commands are only the
+        initial sizes. The CPU-side vertex-, uniform- and command-buffers
+        double their size when they run full, the sokol-gfx vertex- and
+        index-buffers are recreated with the new size in the first
+        sgl_draw() of the next frame. When the context is drawn several
+        times per frame, a draw which doesn't fit into the remaining
+        space of the sokol-gfx vertex buffer is still skipped in that frame.
+        Growable contexts always use 32-bit indices for quads and triangle fans.
+
+        ...and optionally select a more compact vertex layout (see COMPACT
+        VERTEX LAYOUTS below):
+
+            sgl_vertex_layout_t vertex_layout   - default is SGL_VERTEXLAYOUT_DEFAULT
+
+        sgl_setup() also creates the 'default context' from the pass
+        attributes and buffer sizes in sgl_desc_t, which is the current
+        context on all threads which haven't selected another context (see
+        below for more about contexts).
+
     --- Optionally create pipeline-state-objects if you need render state
         that differs from sokol-gl's default state:
 
@@ -156,10 +189,85 @@
 
             sgl_destroy_pipeline(sgl_pipeline pip)
 
+    --- Optionally create additional contexts. A context owns its own
+        vertex-, uniform- and command-buffers, state stacks and sokol-gfx
+        vertex buffer, this allows to render into render passes with
+        different pixel formats or sample counts, or to record
+        sokol-gl rendering on different threads in parallel:
+
+            sgl_context ctx = sgl_make_context(const sgl_context_desc_t* desc)
+
+        The sgl_context_desc_t struct has the following members, zero-initialized
+        members fall back to the same defaults as in sgl_desc_t:
+
+            int max_vertices                - default is 65536
+            int max_commands                - default is 16384
+            sg_pixel_format color_format    - color pixel format of render pass
+            sg_pixel_format depth_format    - depth pixel format of render pass
+            int sample_count                - MSAA sample count of render pass
+            bool pretransform               - enable the pretransform mode
+            bool growable                   - grow the buffers on demand
+            sgl_vertex_layout_t vertex_layout - the vertex layout
+
+        Pipeline objects belong to a context since the pixel formats and sample
+        count are baked into the sokol-gfx pipeline objects. sgl_make_pipeline()
+        creates a pipeline for the current context, to create a pipeline
+        for a specific context call:
+
+            sgl_pipeline pip = sgl_context_make_pipeline(sgl_context ctx, const sg_pipeline_desc* desc)
+
+        ...to select the context which is used by all the following sokol-gl
+        calls on the calling thread:
+
+            sgl_set_context(sgl_context ctx)
+
+        The current context is tracked per thread, a thread which hasn't called
+        sgl_set_context() uses the default context (so code which calls sokol-gl
+        from several threads under a lock keeps working). If the selected
+        context is invalid or has been destroyed, all sokol-gl functions (except
+        the functions which take an explicit context handle) are ignored, and
+        a message is logged once per thread. A context must only be used by
+        one thread at a time.
+
+        ...to get the current context, or the default context created in sgl_setup():
+
+            sgl_context sgl_get_context(void)
+            sgl_context sgl_default_context(void)
+
+        ...to record on worker threads and render everything with one
+        sgl_draw() on the render thread, give each worker its own context as
+        'recorder' (recording doesn't need any locks), and after the workers
+        have finished, merge the recorders into the current context in a
+        fixed order:
+
+            sgl_merge_context(sgl_context ctx)
+
+        This appends the vertices, uniforms and commands recorded in 'ctx' to
+        the current context (rebasing the vertex- and uniform-indices of the
+        draw commands), and rewinds 'ctx' as if it had been drawn. The result
+        is the same as if all sokol-gl calls had been made on the current
+        context in the merge order (except that draw commands are never merged
+        across recorders), so the rendered output doesn't depend on thread
+        scheduling. The recorders must be compatible with the current context:
+        same pixel formats and sample count, and both growable or with
+        max_vertices on the same side of 65536 (since this decides the index
+        type for quads and triangle fans). If a recorder is in an error state,
+        its error is passed to the current context. Creating or destroying
+        contexts, pipelines and display lists isn't thread-safe and must
+        happen on a single thread.
+
+        ...and to destroy a context (along with all its pipelines) before
+        sgl_shutdown():
+
+            sgl_destroy_context(sgl_context ctx)
+
+        The default context can't be destroyed, and sgl_shutdown() will destroy
+        all remaining contexts.
+
     --- After sgl_setup() you can call any of the sokol-gl functions anywhere
-        in a frame, *except* sgl_draw(). The 'vanilla' functions
-        will only change internal sokol-gl state, and not call any sokol-gfx
-        functions.
+        in a frame, *except* sgl_draw() and sgl_context_draw(). The 'vanilla'
+        functions will only change internal sokol-gl state, and not call any
+        sokol-gfx functions.
 
     --- Unlike OpenGL, sokol-gl has a function to reset internal state to
         a known default. This is useful at the start of a sequence of
@@ -285,6 +393,7 @@
             sgl_begin_line_strip()
             sgl_begin_triangles()
             sgl_begin_triangle_strip()
+            sgl_begin_triangle_fan()
             sgl_begin_quads()
 
         ...after sgl_begin_*() specify vertices:
@@ -299,6 +408,20 @@
         and/or color is missing, it will be taken from the current texture-coord
         and color 'register'.
 
+        ...or provide many vertices at once from arrays in memory:
+
+            sgl_vertex_arrays(const sgl_vertex_arrays_t* arrays)
+
+        The position, texture-coord and color arrays can be separate or
+        interleaved (use the stride items to skip over other data), colors
+        can be provided either as RGBA floats or as packed 32-bit values.
+        Missing texture-coords and colors are taken from the current
+        'registers', and the vertices are transformed on the CPU just like
+        individual vertices in 'pretransform mode'. This is considerably
+        faster than calling sgl_v*() in a loop. If the arrays don't fit into
+        the remaining vertex buffer space, the error SGL_ERROR_VERTICES_FULL
+        will be set and none of the vertices will be written.
+
         ...finally, after specifying vertices, call:
 
             sgl_end()
@@ -311,14 +434,77 @@
 
             sgl_draw()
 
-        This will render everything that has been recorded since the last
-        call to sgl_draw() through sokol-gfx, and will 'rewind' the internal
-        vertex-, uniform- and command-buffers.
-
-    --- sokol-gl tracks a single internal error code which can be
+        This will render everything that has been recorded into the current
+        context since the last call to sgl_draw() through sokol-gfx, and will
+        'rewind' the context's internal vertex-, uniform- and command-buffers.
+
+        ...or to render a specific context (this must be called on the
+        thread which owns the sokol-gfx render pass, but not necessarily on
+        the thread which recorded the context):
+
+            sgl_context_draw(sgl_context ctx)
+
+        sgl_draw() and sgl_context_draw() can be called several times per frame,
+        into the same or different render passes. Since the vertex data is
+        appended to the context's sokol-gfx vertex buffer, the max_vertices
+        limit is for all vertices drawn by a context in one frame.
+
+    --- static geometry (like grids, bounding boxes or navigation mesh overlays)
+        can be recorded once into a display list instead of being specified
+        vertex by vertex each frame:
+
+            sgl_begin_display_list()
+            ...sokol-gl calls...
+            sgl_display_list list = sgl_end_display_list()
+
+        All primitives, viewport- and scissor-rect commands between
+        sgl_begin_display_list() and sgl_end_display_list() are moved from the
+        current context into the display list, and the recorded vertices are
+        copied into an immutable sokol-gfx vertex buffer. The matrices are
+        set to identity at the start of the recording and restored at the end,
+        so that the matrices inside the display list are relative to the
+        transform the display list is called with. sgl_end_display_list()
+        returns an invalid handle if the context is in an error state (for
+        instance because the display list doesn't fit into the context's
+        vertex buffer) or the display list pool is exhausted.
+
+        ...replay a display list with:
+
+            sgl_call_display_list(sgl_display_list list)
+
+        This records a single command into the current context, and when
+        the command is rendered in sgl_draw(), the display list is rendered
+        with the current projection, modelview and texture matrices (at the
+        time sgl_call_display_list() was called) multiplied with the matrices
+        recorded in the display list. A display list can be called any number of
+        times per frame, this doesn't involve any per-vertex work on the CPU,
+        and doesn't consume any space in the context's vertex buffer.
+
+        Display lists can't be nested, sgl_call_display_list() and sgl_draw()
+        must not be called while recording a display list. A display list
+        belongs to the context it was recorded in (since it uses the context's
+        pipelines), and can be called in that context or in any compatible
+        context (same pixel formats, sample count, vertex layout and index
+        type, see sgl_merge_context() above), calls in an incompatible
+        context are skipped in sgl_draw(). A fixed-size context must have
+        room for the display list's vertices in its vertex buffer, otherwise
+        sgl_call_display_list() logs a message and ignores the call (if the
+        call reaches the context through sgl_merge_context(), the display
+        list is skipped in sgl_draw() and a message is logged once), a
+        growable context grows its vertex buffer in the next frame.
+
+        ...finally destroy a display list with:
+
+            sgl_destroy_display_list(sgl_display_list list)
+
+        Display lists which are still alive are destroyed together with their
+        context.
+
+    --- sokol-gl tracks an internal error code per context which can be
         queried with
 
             sgl_error_t sgl_error(void)
+            sgl_error_t sgl_context_error(sgl_context ctx)
 
         ...which can return the following error codes:
 
@@ -328,10 +514,38 @@
         SGL_ERROR_COMMANDS_FULL     - the internal command buffer is full (checked in sgl_end())
         SGL_ERROR_STACK_OVERFLOW    - matrix- or pipeline-stack overflow
         SGL_ERROR_STACK_UNDERFLOW   - matrix- or pipeline-stack underflow
+        SGL_ERROR_NO_CONTEXT        - sgl_error() was called without a current context,
+                                      or sgl_context_error() with an invalid context
 
         ...if sokol-gl is in an error-state, sgl_draw() will skip any rendering,
         and reset the error code to SGL_NO_ERROR.
 
+        The SGL_ERROR_*_FULL errors never happen in growable contexts.
+
+    --- to find out how large the buffers of a context actually need to be,
+        query the buffer sizes and high-water marks with:
+
+            sgl_stats_t sgl_stats(void)
+            sgl_stats_t sgl_context_stats(sgl_context ctx)
+
+        The sgl_stats_t struct has the following members:
+
+            int num_vertices        - current size of the vertex buffer
+            int num_uniforms        - current size of the uniform buffer
+            int num_commands        - current size of the command buffer
+            int max_used_vertices   - most vertices recorded between two sgl_draw()
+            int max_used_uniforms   - most uniform blocks recorded between two sgl_draw()
+            int max_used_commands   - most commands recorded between two sgl_draw()
+            int max_frame_vertices  - most vertices drawn by the context in one frame
+
+        The high-water marks are tracked since the context was created. Run
+        the application in a growable context (or with generous buffer sizes)
+        through its worst cases, and use the high-water marks to pick the
+        max_vertices and max_commands for the release build. max_vertices
+        must be at least max_frame_vertices if the context is drawn several
+        times per frame, and max_commands must cover both max_used_uniforms
+        and max_used_commands.
+
     UNDER THE HOOD:
     ===============
     sokol_gl.h works by recording vertex data and rendering commands into
@@ -340,11 +554,15 @@
     The only functions which call into sokol_gfx.h are:
         - sgl_setup()
         - sgl_shutdown()
-        - sgl_draw()
+        - sgl_make_context() / sgl_destroy_context()
+        - sgl_make_pipeline() / sgl_destroy_pipeline()
+        - sgl_end_display_list() / sgl_destroy_display_list()
+        - sgl_draw() / sgl_context_draw()
 
     sgl_setup() must be called after initializing sokol-gfx.
     sgl_shutdown() must be called before shutting down sokol-gfx.
-    sgl_draw() must be called once per frame inside a sokol-gfx render pass.
+    sgl_draw() must be called inside a sokol-gfx render pass, once or several
+    times per frame.
 
     All other sokol-gl function can be called anywhere in a frame, since
     they just record data into memory buffers owned by sokol-gl.
@@ -352,17 +570,33 @@
     What happens in:
 
         sgl_setup():
+            - sokol-gfx resources are created which are shared by all
+              contexts: a shader object (using embedded shader source or
+              byte code), and an 8x8 all-white default texture
+            - the default context is created
+
+        sgl_make_context():
             - 3 memory buffers are allocated, one for vertex data,
               one for uniform data, and one for commands
-            - sokol-gfx resources are created: a (dynamic) vertex buffer,
-              a shader object (using embedded shader source or byte code),
-              and an 8x8 all-white default texture
+            - sokol-gfx resources are created: a (stream) vertex buffer,
+              an immutable index buffer (see below), and the default
+              pipeline objects
 
             One vertex is 24 bytes:
                 - float3 position
                 - float2 texture coords
                 - uint32_t color
 
+            Quads and triangle fans are rendered as indexed triangles, so
+            that each quad only needs 4 vertices. The indices are static
+            and created once per context: first 6 indices for each quad
+            which fits into the vertex buffer (this requires that quads start
+            at a vertex index which is a multiple of 4, so that up to 3
+            vertices may be skipped in sgl_begin_quads()), followed by the
+            indices of a triangle fan spanning the whole vertex buffer. A
+            triangle fan is drawn by moving the vertex buffer offset to the
+            fan's first vertex.
+
             One uniform block is 128 bytes:
                 - mat4 model-view-projection matrix
                 - mat4 texture matrix
@@ -377,13 +611,14 @@
                 (152 + 24 * num_verts) bytes
 
         sgl_shutdown():
-            - all sokol-gfx resources (buffer, shader, default-texture and
-              all pipeline objects) are destroyed
-            - the 3 memory buffers are freed
+            - all contexts are destroyed (freeing their vertex buffers,
+              pipeline objects and memory buffers)
+            - the shared shader and default-texture are destroyed
 
         sgl_draw():
-            - copy all recorded vertex data into the dynamic sokol-gfx buffer
-              via a call to sg_update_buffer()
+            - append all recorded vertex data to the context's sokol-gfx
+              vertex buffer via a call to sg_append_buffer(), if this would
+              overflow the vertex buffer, nothing is rendered
             - for each recorded command:
                 - if it's a viewport command, call sg_apply_viewport()
                 - if it's a scissor-rect command, call sg_apply_scissor_rect()
@@ -392,6 +627,10 @@
                       call sg_apply_pipeline(), sg_apply_bindings() and
                       sg_apply_uniforms()
                     - finally call sg_draw()
+                - if it's a display list call, render the display list's
+                  commands in the same way, with the display list's vertex
+                  buffer, and the display list's matrices multiplied with
+                  the matrices of the call
 
     All other functions only modify the internally tracked state, add
     data to the vertex, uniform and command buffers, or manipulate
@@ -417,6 +656,52 @@
     to render in the previous draw command will be incremented by the
     number of vertices in the new draw command.
 
+    This means that by default, rendering many small objects with their
+    own transform (for instance with sgl_translate()) results in one draw
+    command per object. A context in 'pretransform mode' (enabled with
+    sgl_desc_t.pretransform or sgl_context_desc_t.pretransform) transforms
+    the vertex positions with the modelview matrix on the CPU instead (via
+    SSE2 or NEON if available). The shader then only gets the projection
+    matrix, so that a modelview matrix change doesn't prevent merging
+    draw commands, and the number of draw commands only depends on
+    pipeline-, texture-, projection- and texture-matrix-changes.
+
+    The tradeoff is a bit more CPU work for each vertex. Modelview matrices
+    with a projective part (where the last row isn't 0,0,0,1) are not
+    applied on the CPU, primitives rendered with such a matrix will start a
+    new draw command as usual.
+
+    COMPACT VERTEX LAYOUTS
+    ======================
+    By default, each vertex in the sokol-gfx vertex buffer takes 24 bytes
+    (float3 position, float2 texture coordinates and an RGBA8 color). For
+    2D- or UI-style rendering this wastes memory and bandwidth, so a
+    context can be created with a more compact vertex layout (via
+    sgl_desc_t.vertex_layout for the default context, or
+    sgl_context_desc_t.vertex_layout):
+
+        SGL_VERTEXLAYOUT_DEFAULT        24 bytes: float3 position, float2 uv
+        SGL_VERTEXLAYOUT_FLOAT2_UV16    16 bytes: float2 position, 16-bit normalized uv
+        SGL_VERTEXLAYOUT_HALF2_UV16     12 bytes: half-float xy position, 16-bit normalized uv
+        SGL_VERTEXLAYOUT_HALF4_UV16     16 bytes: half-float xyz position, 16-bit normalized uv
+
+    The color is always a packed RGBA8 value. The vertices are still
+    recorded in the default layout, and are converted to the compact layout
+    when they are uploaded in sgl_draw() (or copied into a display list),
+    so the sokol-gl API doesn't change. Keep the following in mind:
+
+    - the 2D layouts drop the z coordinate (z is 0.0)
+    - 16-bit normalized texture coordinates are clamped to the range 0..1,
+      use the texture matrix to repeat a texture (the texture matrix is
+      applied in the vertex shader, after the vertex data has been fetched)
+    - half-float positions have an 11-bit mantissa, they represent integer
+      coordinates exactly up to 2048, and fractional coordinates (for instance
+      in normalized device coordinates) with about 3 decimal digits. In
+      pretransform mode, positions are already transformed by the modelview
+      matrix before they are converted
+    - the half-float layouts need SG_VERTEXFORMAT_HALF2/HALF4 which are not
+      supported on WebGL/GLES2
+
     LICENSE
     =======
     zlib/libpng license
@@ -470,6 +755,12 @@ extern "C" {
 /* sokol_gl pipeline handle (created with sgl_make_pipeline()) */
 typedef struct sgl_pipeline { uint32_t id; } sgl_pipeline;
 
+/* sokol_gl context handle (created with sgl_make_context()) */
+typedef struct sgl_context { uint32_t id; } sgl_context;
+
+/* sokol_gl display list handle (created with sgl_begin_display_list() / sgl_end_display_list()) */
+typedef struct sgl_display_list { uint32_t id; } sgl_display_list;
+
 /*
     sgl_error_t
 
@@ -483,28 +774,119 @@ typedef enum sgl_error_t {
     SGL_ERROR_COMMANDS_FULL,
     SGL_ERROR_STACK_OVERFLOW,
     SGL_ERROR_STACK_UNDERFLOW,
+    SGL_ERROR_NO_CONTEXT,
 } sgl_error_t;
 
+/*
+    sgl_vertex_layout_t
+
+    The vertex layout of a context's sokol-gfx vertex buffer (see
+    COMPACT VERTEX LAYOUTS). The compact layouts need less memory and
+    bandwidth, but reduce the range and precision of the vertex data.
+*/
+typedef enum sgl_vertex_layout_t {
+    SGL_VERTEXLAYOUT_DEFAULT = 0,   /* float3 position, float2 uv, 24 bytes per vertex */
+    SGL_VERTEXLAYOUT_FLOAT2_UV16,   /* float2 position, 16-bit normalized uv, 16 bytes per vertex */
+    SGL_VERTEXLAYOUT_HALF2_UV16,    /* half-float xy position, 16-bit normalized uv, 12 bytes per vertex */
+    SGL_VERTEXLAYOUT_HALF4_UV16,    /* half-float xyz position, 16-bit normalized uv, 16 bytes per vertex */
+} sgl_vertex_layout_t;
+
+/*
+    sgl_context_desc_t
+
+    Describes the initialization parameters of a rendering context,
+    zero-initialized items are replaced with their default values.
+    The pixel formats and sample count must match the render pass
+    the context is drawn into.
+*/
+typedef struct sgl_context_desc_t {
+    int max_vertices;       /* size for vertex buffer, default is 65536 */
+    int max_commands;       /* size of uniform- and command-buffers, default is 16384 */
+    sg_pixel_format color_format;
+    sg_pixel_format depth_format;
+    int sample_count;
+    bool pretransform;      /* transform vertices by the modelview matrix on the CPU */
+    bool growable;          /* grow the buffers on demand instead of failing with SGL_ERROR_*_FULL */
+    sgl_vertex_layout_t vertex_layout;  /* default is SGL_VERTEXLAYOUT_DEFAULT */
+} sgl_context_desc_t;
+
 typedef struct sgl_desc_t {
-    int max_vertices;       /* size for vertex buffer */
-    int max_commands;       /* size of uniform- and command-buffers */
+    int max_vertices;       /* size for vertex buffer (of the default context) */
+    int max_commands;       /* size of uniform- and command-buffers (of the default context) */
+    int context_pool_size;  /* max number of contexts (including the default context), default is 4 */
     int pipeline_pool_size; /* size of the internal pipeline pool, default is 64 */
+    int display_list_pool_size; /* size of the internal display list pool, default is 64 */
     sg_pixel_format color_format;
     sg_pixel_format depth_format;
     int sample_count;
     sg_face_winding face_winding; /* default front face winding is CCW */
+    bool pretransform;      /* transform vertices by the modelview matrix on the CPU (in the default context) */
+    bool growable;          /* grow the buffers of the default context on demand */
+    sgl_vertex_layout_t vertex_layout;  /* vertex layout of the default context */
 } sgl_desc_t;
 
+/*
+    sgl_stats_t
+
+    The current buffer sizes and high-water marks of a context, returned
+    by sgl_stats() and sgl_context_stats(). The high-water marks are
+    tracked since the context was created and can be used to tune
+    max_vertices and max_commands.
+*/
+typedef struct sgl_stats_t {
+    int num_vertices;           /* current size of the vertex buffer */
+    int num_uniforms;           /* current size of the uniform buffer */
+    int num_commands;           /* current size of the command buffer */
+    int max_used_vertices;      /* most vertices recorded between two sgl_draw() */
+    int max_used_uniforms;      /* most uniform blocks recorded between two sgl_draw() */
+    int max_used_commands;      /* most commands recorded between two sgl_draw() */
+    int max_frame_vertices;     /* most vertices drawn by the context in one frame */
+} sgl_stats_t;
+
+/*
+    sgl_vertex_arrays_t
+
+    Describes arrays of vertex components for sgl_vertex_arrays(). The
+    components can come from separate arrays, or from an array of
+    interleaved vertices by pointing into the first vertex and
+    setting the strides to the size of a vertex. A zero stride means
+    that the array is tightly packed. Missing texture coordinates and
+    colors are taken from the current texture-coord and color 'register'.
+*/
+typedef struct sgl_vertex_arrays_t {
+    int num_vertices;
+    const float* pos;               /* positions (required) */
+    int pos_size;                   /* number of position components (2 or 3), default is 3 */
+    int pos_stride;                 /* default is pos_size * sizeof(float) */
+    const float* uv;                /* optional texture coordinates (2 floats) */
+    int uv_stride;                  /* default is 2 * sizeof(float) */
+    const float* colors;            /* optional float colors (RGBA, 4 floats) */
+    const uint32_t* packed_colors;  /* optional packed colors (same as sgl_c1i()), used when 'colors' is null */
+    int color_stride;               /* default is 4 * sizeof(float), or sizeof(uint32_t) for packed colors */
+} sgl_vertex_arrays_t;
+
 /* setup/shutdown/misc */
 SOKOL_GL_API_DECL void sgl_setup(const sgl_desc_t* desc);
 SOKOL_GL_API_DECL void sgl_shutdown(void);
 SOKOL_GL_API_DECL sgl_error_t sgl_error(void);
+SOKOL_GL_API_DECL sgl_error_t sgl_context_error(sgl_context ctx);
+SOKOL_GL_API_DECL sgl_stats_t sgl_stats(void);
+SOKOL_GL_API_DECL sgl_stats_t sgl_context_stats(sgl_context ctx);
 SOKOL_GL_API_DECL void sgl_defaults(void);
 SOKOL_GL_API_DECL float sgl_rad(float deg);
 SOKOL_GL_API_DECL float sgl_deg(float rad);
 
+/* context functions */
+SOKOL_GL_API_DECL sgl_context sgl_make_context(const sgl_context_desc_t* desc);
+SOKOL_GL_API_DECL void sgl_destroy_context(sgl_context ctx);
+SOKOL_GL_API_DECL void sgl_set_context(sgl_context ctx);
+SOKOL_GL_API_DECL sgl_context sgl_get_context(void);
+SOKOL_GL_API_DECL sgl_context sgl_default_context(void);
+SOKOL_GL_API_DECL void sgl_merge_context(sgl_context ctx);
+
 /* create and destroy pipeline objects */
 SOKOL_GL_API_DECL sgl_pipeline sgl_make_pipeline(const sg_pipeline_desc* desc);
+SOKOL_GL_API_DECL sgl_pipeline sgl_context_make_pipeline(sgl_context ctx, const sg_pipeline_desc* desc);
 SOKOL_GL_API_DECL void sgl_destroy_pipeline(sgl_pipeline pip);
 
 /* render state functions */
@@ -553,6 +935,7 @@ SOKOL_GL_API_DECL void sgl_begin_lines(void);
 SOKOL_GL_API_DECL void sgl_begin_line_strip(void);
 SOKOL_GL_API_DECL void sgl_begin_triangles(void);
 SOKOL_GL_API_DECL void sgl_begin_triangle_strip(void);
+SOKOL_GL_API_DECL void sgl_begin_triangle_fan(void);
 SOKOL_GL_API_DECL void sgl_begin_quads(void);
 SOKOL_GL_API_DECL void sgl_v2f(float x, float y);
 SOKOL_GL_API_DECL void sgl_v3f(float x, float y, float z);
@@ -578,17 +961,27 @@ SOKOL_GL_API_DECL void sgl_v3f_t2f_c3b(float x, float y, float z, float u, float
 SOKOL_GL_API_DECL void sgl_v3f_t2f_c4f(float x, float y, float z, float u, float v, float r, float g, float b, float a);
 SOKOL_GL_API_DECL void sgl_v3f_t2f_c4b(float x, float y, float z, float u, float v, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 SOKOL_GL_API_DECL void sgl_v3f_t2f_c1i(float x, float y, float z, float u, float v, uint32_t rgba);
+SOKOL_GL_API_DECL void sgl_vertex_arrays(const sgl_vertex_arrays_t* arrays);
 SOKOL_GL_API_DECL void sgl_end(void);
 
+/* record primitives once into a display list, and replay them any number of times */
+SOKOL_GL_API_DECL void sgl_begin_display_list(void);
+SOKOL_GL_API_DECL sgl_display_list sgl_end_display_list(void);
+SOKOL_GL_API_DECL void sgl_call_display_list(sgl_display_list list);
+SOKOL_GL_API_DECL void sgl_destroy_display_list(sgl_display_list list);
+
 /* render everything */
 SOKOL_GL_API_DECL void sgl_draw(void);
+SOKOL_GL_API_DECL void sgl_context_draw(sgl_context ctx);
 
 #ifdef __cplusplus
 } /* extern "C" */
 
 /* reference-based equivalents for C++ */
 inline void sgl_setup(const sgl_desc_t& desc) { return sgl_setup(&desc); }
+inline sgl_context sgl_make_context(const sgl_context_desc_t& desc) { return sgl_make_context(&desc); }
 inline sgl_pipeline sgl_make_pipeline(const sg_pipeline_desc& desc) { return sgl_make_pipeline(&desc); }
+inline sgl_pipeline sgl_context_make_pipeline(sgl_context ctx, const sg_pipeline_desc& desc) { return sgl_context_make_pipeline(ctx, &desc); }
 #endif
 #endif /* SOKOL_GL_INCLUDED */
 
@@ -633,6 +1026,16 @@ inline sgl_pipeline sgl_make_pipeline(const sg_pipeline_desc& desc) { return sgl
     #define SOKOL_UNREACHABLE SOKOL_ASSERT(false)
 #endif
 
+#if !defined(SOKOL_GL_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define _SGL_SSE2 (1)
+        #include <emmintrin.h>
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define _SGL_NEON (1)
+        #include <arm_neon.h>
+    #endif
+#endif
+
 #define _sgl_def(val, def) (((val) == 0) ? (def) : (val))
 #define _SGL_INIT_COOKIE (0xABCDABCD)
 
@@ -1933,6 +2336,7 @@ typedef enum {
     SGL_PRIMITIVETYPE_LINE_STRIP,
     SGL_PRIMITIVETYPE_TRIANGLES,
     SGL_PRIMITIVETYPE_TRIANGLE_STRIP,
+    SGL_PRIMITIVETYPE_TRIANGLE_FAN,
     SGL_PRIMITIVETYPE_QUADS,
     SGL_NUM_PRIMITIVE_TYPES,
 } _sgl_primitive_type_t;
@@ -1951,6 +2355,7 @@ typedef struct {
 
 typedef struct {
     _sgl_slot_t slot;
+    sgl_context ctx;    /* the context the pipeline was created for */
     sg_pipeline pip[SGL_NUM_PRIMITIVE_TYPES];
 } _sgl_pipeline_t;
 
@@ -1972,6 +2377,25 @@ typedef struct {
     uint32_t rgba;
 } _sgl_vertex_t;
 
+/* the compact vertex layouts, vertices are converted from _sgl_vertex_t when they are uploaded */
+typedef struct {
+    float pos[2];
+    uint16_t uv[2];
+    uint32_t rgba;
+} _sgl_vertex_float2_uv16_t;
+
+typedef struct {
+    uint16_t pos[2];
+    uint16_t uv[2];
+    uint32_t rgba;
+} _sgl_vertex_half2_uv16_t;
+
+typedef struct {
+    uint16_t pos[4];
+    uint16_t uv[2];
+    uint32_t rgba;
+} _sgl_vertex_half4_uv16_t;
+
 typedef struct {
     float v[4][4];
 } _sgl_matrix_t;
@@ -1985,11 +2409,13 @@ typedef enum {
     SGL_COMMAND_DRAW,
     SGL_COMMAND_VIEWPORT,
     SGL_COMMAND_SCISSOR_RECT,
+    SGL_COMMAND_CALL_DISPLAY_LIST,
 } _sgl_command_type_t;
 
 typedef struct {
     sg_pipeline pip;
     sg_image img;
+    _sgl_primitive_type_t prim_type;
     int base_vertex;
     int num_vertices;
     int uniform_index;
@@ -2005,10 +2431,16 @@ typedef struct {
     bool origin_top_left;
 } _sgl_scissor_rect_args_t;
 
+typedef struct {
+    sgl_display_list list;
+    int uniform_index;      /* the transform the display list is replayed with */
+} _sgl_call_display_list_args_t;
+
 typedef union {
     _sgl_draw_args_t draw;
     _sgl_viewport_args_t viewport;
     _sgl_scissor_rect_args_t scissor_rect;
+    _sgl_call_display_list_args_t call_display_list;
 } _sgl_args_t;
 
 typedef struct {
@@ -2016,18 +2448,51 @@ typedef struct {
     _sgl_args_t args;
 } _sgl_command_t;
 
+/* a display list owns copies of its recorded commands and uniforms, and an immutable vertex buffer */
+typedef struct {
+    _sgl_slot_t slot;
+    sgl_context ctx;    /* the context the display list was recorded in */
+    sg_buffer vbuf;
+    int num_vertices;
+    int num_uniforms;
+    int num_commands;
+    _sgl_uniform_t* uniforms;
+    _sgl_command_t* commands;
+    bool skip_logged;   /* set after logging that the display list was skipped for being too big */
+} _sgl_display_list_t;
+
+typedef struct {
+    _sgl_pool_t pool;
+    _sgl_display_list_t* lists;
+} _sgl_display_list_pool_t;
+
 #define _SGL_INVALID_SLOT_INDEX (0)
 #define _SGL_MAX_STACK_DEPTH (64)
+#define _SGL_DEFAULT_CONTEXT_POOL_SIZE (4)
 #define _SGL_DEFAULT_PIPELINE_POOL_SIZE (64)
+#define _SGL_DEFAULT_DISPLAY_LIST_POOL_SIZE (64)
 #define _SGL_DEFAULT_MAX_VERTICES (1<<16)
 #define _SGL_DEFAULT_MAX_COMMANDS (1<<14)
 #define _SGL_SLOT_SHIFT (16)
 #define _SGL_MAX_POOL_SIZE (1<<_SGL_SLOT_SHIFT)
 #define _SGL_SLOT_MASK (_SGL_MAX_POOL_SIZE-1)
 
+/* the current context is tracked per thread, so that threads can record into their own context */
+#if defined(_MSC_VER)
+    #define _SGL_THREAD_LOCAL __declspec(thread)
+#elif defined(__cplusplus) && (__cplusplus >= 201103L)
+    #define _SGL_THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_THREADS__)
+    #define _SGL_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+    #define _SGL_THREAD_LOCAL __thread
+#else
+    #error "sokol_gl.h: no thread-local storage for the per-thread current context"
+#endif
+
 typedef struct {
-    uint32_t init_cookie;
-    sgl_desc_t desc;
+    _sgl_slot_t slot;
+    sgl_context_desc_t desc;
 
     int num_vertices;
     int num_uniforms;
@@ -2039,6 +2504,12 @@ typedef struct {
     _sgl_uniform_t* uniforms;
     _sgl_command_t* commands;
 
+    /* high-water marks */
+    int max_used_vertices;
+    int max_used_uniforms;
+    int max_used_commands;
+    int max_frame_vertices;
+
     /* state tracking */
     int base_vertex;
     int vtx_count;          /* number of times vtx function has been called, used for non-triangle primitives */
@@ -2050,14 +2521,27 @@ typedef struct {
     sg_image cur_img;
     bool texturing_enabled;
     bool matrix_dirty;      /* reset in sgl_end(), set in any of the matrix stack functions */
+    bool uniform_proj_only; /* true if the current uniform has only the projection matrix (pretransform mode) */
+    bool cpu_transform;     /* true if the vertices of the current begin/end are transformed on the CPU */
+    _sgl_matrix_t cpu_transform_matrix;
+
+    /* display list recording */
+    bool in_display_list;
+    int list_base_vertex;
+    int list_base_uniform;
+    int list_base_command;
+    _sgl_matrix_t list_saved_matrix[SGL_NUM_MATRIXMODES];
 
     /* sokol-gfx resources */
     sg_buffer vbuf;
-    sg_image def_img;   /* a default white texture */
-    sg_shader shd;
+    int vertex_size;        /* size of a vertex in vbuf, depends on desc.vertex_layout */
+    int vbuf_num_vertices;  /* size of vbuf, lags behind num_vertices in growable contexts until the next frame */
+    int vbuf_wanted_vertices; /* the vbuf size needed by the last frame in growable contexts */
+    sg_buffer ibuf;         /* static indices for quads, followed by the indices for triangle fans */
+    sg_index_type index_type;
+    int fan_base_element;   /* start of the triangle fan indices in ibuf */
     sg_bindings bind;
     sgl_pipeline def_pip;
-    _sgl_pipeline_pool_t pip_pool;
 
     /* pipeline stack */
     int pip_tos;
@@ -2067,8 +2551,41 @@ typedef struct {
     _sgl_matrix_mode_t cur_matrix_mode;
     int matrix_tos[SGL_NUM_MATRIXMODES];
     _sgl_matrix_t matrix_stack[SGL_NUM_MATRIXMODES][_SGL_MAX_STACK_DEPTH];
+} _sgl_context_t;
+
+typedef struct {
+    _sgl_pool_t pool;
+    _sgl_context_t* contexts;
+} _sgl_context_pool_t;
+
+typedef struct {
+    uint32_t init_cookie;
+    sgl_desc_t desc;
+
+    /* sokol-gfx resources shared by all contexts */
+    sg_image def_img;   /* a default white texture */
+    sg_shader shd;
+    _sgl_pipeline_pool_t pip_pool;
+    _sgl_display_list_pool_t list_pool;
+    _sgl_context_pool_t context_pool;
+    sgl_context def_ctx_id;
+    uint32_t setup_serial;      /* unique for each sgl_setup(), 0 after sgl_shutdown() */
 } _sgl_t;
 static _sgl_t _sgl;
+static uint32_t _sgl_setup_count;
+/* the per-thread current context, stored as id so that a destroyed
+   context can't be used through a stale pointer on other threads
+*/
+typedef struct {
+    bool ctx_selected;      // false until sgl_set_context() is called on the thread
+    bool no_ctx_logged;
+    sgl_context ctx_id;
+    // the last lookup result, only trusted within the same sgl_setup()
+    _sgl_context_t* cached_ctx;
+    uint32_t cached_ctx_id;
+    uint32_t cached_setup_serial;
+} _sgl_thread_t;
+static _SGL_THREAD_LOCAL _sgl_thread_t _sgl_thread;
 
 /*== PRIVATE FUNCTIONS =======================================================*/
 
@@ -2220,34 +2737,53 @@ static sgl_pipeline _sgl_alloc_pipeline(void) {
     return res;
 }
 
-static void _sgl_init_pipeline(sgl_pipeline pip_id, const sg_pipeline_desc* in_desc) {
-    SOKOL_ASSERT((pip_id.id != SG_INVALID_ID) && in_desc);
+static void _sgl_init_pipeline(sgl_pipeline pip_id, const sg_pipeline_desc* in_desc, const _sgl_context_t* ctx) {
+    SOKOL_ASSERT((pip_id.id != SG_INVALID_ID) && in_desc && ctx);
 
     /* create a new desc with 'patched' shader and pixel format state */
     sg_pipeline_desc desc = *in_desc;
-    desc.layout.buffers[0].stride = sizeof(_sgl_vertex_t);
-    {
-        sg_vertex_attr_desc* pos = &desc.layout.attrs[0];
-        pos->offset = offsetof(_sgl_vertex_t, pos);
-        pos->format = SG_VERTEXFORMAT_FLOAT3;
-    }
-    {
-        sg_vertex_attr_desc* uv = &desc.layout.attrs[1];
-        uv->offset = offsetof(_sgl_vertex_t, uv);
-        uv->format = SG_VERTEXFORMAT_FLOAT2;
-    }
-    {
-        sg_vertex_attr_desc* rgba = &desc.layout.attrs[2];
-        rgba->offset = offsetof(_sgl_vertex_t, rgba);
-        rgba->format = SG_VERTEXFORMAT_UBYTE4N;
+    desc.layout.buffers[0].stride = ctx->vertex_size;
+    /* the shader's position input is a vec4, missing components are filled in with z=0 and w=1 */
+    sg_vertex_attr_desc* pos = &desc.layout.attrs[0];
+    sg_vertex_attr_desc* uv = &desc.layout.attrs[1];
+    sg_vertex_attr_desc* rgba = &desc.layout.attrs[2];
+    switch (ctx->desc.vertex_layout) {
+        case SGL_VERTEXLAYOUT_FLOAT2_UV16:
+            pos->offset = offsetof(_sgl_vertex_float2_uv16_t, pos);
+            pos->format = SG_VERTEXFORMAT_FLOAT2;
+            uv->offset = offsetof(_sgl_vertex_float2_uv16_t, uv);
+            uv->format = SG_VERTEXFORMAT_USHORT2N;
+            rgba->offset = offsetof(_sgl_vertex_float2_uv16_t, rgba);
+            break;
+        case SGL_VERTEXLAYOUT_HALF2_UV16:
+            pos->offset = offsetof(_sgl_vertex_half2_uv16_t, pos);
+            pos->format = SG_VERTEXFORMAT_HALF2;
+            uv->offset = offsetof(_sgl_vertex_half2_uv16_t, uv);
+            uv->format = SG_VERTEXFORMAT_USHORT2N;
+            rgba->offset = offsetof(_sgl_vertex_half2_uv16_t, rgba);
+            break;
+        case SGL_VERTEXLAYOUT_HALF4_UV16:
+            pos->offset = offsetof(_sgl_vertex_half4_uv16_t, pos);
+            pos->format = SG_VERTEXFORMAT_HALF4;
+            uv->offset = offsetof(_sgl_vertex_half4_uv16_t, uv);
+            uv->format = SG_VERTEXFORMAT_USHORT2N;
+            rgba->offset = offsetof(_sgl_vertex_half4_uv16_t, rgba);
+            break;
+        default:
+            pos->offset = offsetof(_sgl_vertex_t, pos);
+            pos->format = SG_VERTEXFORMAT_FLOAT3;
+            uv->offset = offsetof(_sgl_vertex_t, uv);
+            uv->format = SG_VERTEXFORMAT_FLOAT2;
+            rgba->offset = offsetof(_sgl_vertex_t, rgba);
+            break;
     }
+    rgba->format = SG_VERTEXFORMAT_UBYTE4N;
     if (in_desc->shader.id == SG_INVALID_ID) {
         desc.shader = _sgl.shd;
     }
-    desc.index_type = SG_INDEXTYPE_NONE;
-    desc.blend.color_format = _sgl.desc.color_format;
-    desc.blend.depth_format = _sgl.desc.depth_format;
-    desc.rasterizer.sample_count = _sgl.desc.sample_count;
+    desc.blend.color_format = ctx->desc.color_format;
+    desc.blend.depth_format = ctx->desc.depth_format;
+    desc.rasterizer.sample_count = ctx->desc.sample_count;
     if (desc.rasterizer.face_winding == _SG_FACEWINDING_DEFAULT) {
         desc.rasterizer.face_winding = _sgl.desc.face_winding;
     }
@@ -2258,6 +2794,7 @@ static void _sgl_init_pipeline(sgl_pipeline pip_id, const sg_pipeline_desc* in_d
     _sgl_pipeline_t* pip = _sgl_lookup_pipeline(pip_id.id);
     SOKOL_ASSERT(pip && (pip->slot.state == SG_RESOURCESTATE_ALLOC));
     pip->slot.state = SG_RESOURCESTATE_VALID;
+    pip->ctx.id = ctx->slot.id;
     for (int i = 0; i < SGL_NUM_PRIMITIVE_TYPES; i++) {
         switch (i) {
             case SGL_PRIMITIVETYPE_POINTS:
@@ -2273,29 +2810,33 @@ static void _sgl_init_pipeline(sgl_pipeline pip_id, const sg_pipeline_desc* in_d
                 desc.primitive_type = SG_PRIMITIVETYPE_TRIANGLES;
                 break;
             case SGL_PRIMITIVETYPE_TRIANGLE_STRIP:
-            case SGL_PRIMITIVETYPE_QUADS:
                 desc.primitive_type = SG_PRIMITIVETYPE_TRIANGLE_STRIP;
                 break;
+            case SGL_PRIMITIVETYPE_TRIANGLE_FAN:
+            case SGL_PRIMITIVETYPE_QUADS:
+                /* triangle fans and quads are rendered as triangles via the context's index buffer */
+                desc.primitive_type = SG_PRIMITIVETYPE_TRIANGLES;
+                break;
         }
-        if (SGL_PRIMITIVETYPE_QUADS == i) {
-            /* quads are emulated via triangles, use the same pipeline object */
-            pip->pip[i] = pip->pip[SGL_PRIMITIVETYPE_TRIANGLES];
+        if ((SGL_PRIMITIVETYPE_TRIANGLE_FAN == i) || (SGL_PRIMITIVETYPE_QUADS == i)) {
+            desc.index_type = ctx->index_type;
         }
         else {
-            pip->pip[i] = sg_make_pipeline(&desc);
-            if (pip->pip[i].id == SG_INVALID_ID) {
-                SOKOL_LOG("sokol_gl.h: failed to create pipeline object");
-                pip->slot.state = SG_RESOURCESTATE_FAILED;
-            }
+            desc.index_type = SG_INDEXTYPE_NONE;
+        }
+        pip->pip[i] = sg_make_pipeline(&desc);
+        if (pip->pip[i].id == SG_INVALID_ID) {
+            SOKOL_LOG("sokol_gl.h: failed to create pipeline object");
+            pip->slot.state = SG_RESOURCESTATE_FAILED;
         }
     }
 }
 
-static sgl_pipeline _sgl_make_pipeline(const sg_pipeline_desc* desc) {
-    SOKOL_ASSERT(desc);
+static sgl_pipeline _sgl_make_pipeline(const sg_pipeline_desc* desc, const _sgl_context_t* ctx) {
+    SOKOL_ASSERT(desc && ctx);
     sgl_pipeline pip_id = _sgl_alloc_pipeline();
     if (pip_id.id != SG_INVALID_ID) {
-        _sgl_init_pipeline(pip_id, desc);
+        _sgl_init_pipeline(pip_id, desc, ctx);
     }
     else {
         SOKOL_LOG("sokol_gl.h: pipeline pool exhausted!");
@@ -2307,9 +2848,7 @@ static void _sgl_destroy_pipeline(sgl_pipeline pip_id) {
     _sgl_pipeline_t* pip = _sgl_lookup_pipeline(pip_id.id);
     if (pip) {
         for (int i = 0; i < SGL_NUM_PRIMITIVE_TYPES; i++) {
-            if (i != SGL_PRIMITIVETYPE_QUADS) {
-                sg_destroy_pipeline(pip->pip[i]);
-            }
+            sg_destroy_pipeline(pip->pip[i]);
         }
         _sgl_reset_pipeline(pip);
         _sgl_pool_free_index(&_sgl.pip_pool.pool, _sgl_slot_index(pip_id.id));
@@ -2327,57 +2866,202 @@ static sg_pipeline _sgl_get_pipeline(sgl_pipeline pip_id, _sgl_primitive_type_t
     }
 }
 
-static inline void _sgl_begin(_sgl_primitive_type_t mode) {
-    _sgl.in_begin = true;
-    _sgl.base_vertex = _sgl.cur_vertex;
-    _sgl.vtx_count = 0;
-    _sgl.cur_prim_type = mode;
+static void _sgl_setup_display_list_pool(const sgl_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    /* note: the pools here will have an additional item, since slot 0 is reserved */
+    SOKOL_ASSERT((desc->display_list_pool_size > 0) && (desc->display_list_pool_size < _SGL_MAX_POOL_SIZE));
+    _sgl_init_pool(&_sgl.list_pool.pool, desc->display_list_pool_size);
+    size_t pool_byte_size = sizeof(_sgl_display_list_t) * _sgl.list_pool.pool.size;
+    _sgl.list_pool.lists = (_sgl_display_list_t*) SOKOL_MALLOC(pool_byte_size);
+    SOKOL_ASSERT(_sgl.list_pool.lists);
+    memset(_sgl.list_pool.lists, 0, pool_byte_size);
+}
+
+static void _sgl_discard_display_list_pool(void) {
+    SOKOL_FREE(_sgl.list_pool.lists); _sgl.list_pool.lists = 0;
+    _sgl_discard_pool(&_sgl.list_pool.pool);
+}
+
+/* get display list pointer without id-check */
+static _sgl_display_list_t* _sgl_display_list_at(uint32_t list_id) {
+    SOKOL_ASSERT(SG_INVALID_ID != list_id);
+    int slot_index = _sgl_slot_index(list_id);
+    SOKOL_ASSERT((slot_index > _SGL_INVALID_SLOT_INDEX) && (slot_index < _sgl.list_pool.pool.size));
+    return &_sgl.list_pool.lists[slot_index];
+}
+
+/* get display list pointer with id-check, returns 0 if no match */
+static _sgl_display_list_t* _sgl_lookup_display_list(uint32_t list_id) {
+    if (SG_INVALID_ID != list_id) {
+        _sgl_display_list_t* list = _sgl_display_list_at(list_id);
+        if (list->slot.id == list_id) {
+            return list;
+        }
+    }
+    return 0;
+}
+
+/* make display list id from uint32_t id */
+static sgl_display_list _sgl_make_list_id(uint32_t list_id) {
+    sgl_display_list list;
+    list.id = list_id;
+    return list;
+}
+
+static sgl_display_list _sgl_alloc_display_list(void) {
+    sgl_display_list res;
+    int slot_index = _sgl_pool_alloc_index(&_sgl.list_pool.pool);
+    if (_SGL_INVALID_SLOT_INDEX != slot_index) {
+        res = _sgl_make_list_id(_sgl_slot_alloc(&_sgl.list_pool.pool, &_sgl.list_pool.lists[slot_index].slot, slot_index));
+    }
+    else {
+        /* pool is exhausted */
+        res = _sgl_make_list_id(SG_INVALID_ID);
+    }
+    return res;
+}
+
+static void _sgl_destroy_display_list(sgl_display_list list_id) {
+    _sgl_display_list_t* list = _sgl_lookup_display_list(list_id.id);
+    if (list) {
+        sg_destroy_buffer(list->vbuf);
+        SOKOL_FREE(list->uniforms);
+        SOKOL_FREE(list->commands);
+        memset(list, 0, sizeof(_sgl_display_list_t));
+        _sgl_pool_free_index(&_sgl.list_pool.pool, _sgl_slot_index(list_id.id));
+    }
+}
+
+/* grows one of the CPU-side buffers of a growable context to at least min_num items by doubling its size */
+static void* _sgl_grow_buffer(void* items, int num_used, int* num_items, int min_num, int item_size) {
+    int new_num = *num_items;
+    while (new_num < min_num) {
+        new_num *= 2;
+    }
+    void* new_items = SOKOL_MALLOC((size_t)new_num * (size_t)item_size);
+    SOKOL_ASSERT(new_items);
+    memcpy(new_items, items, (size_t)num_used * (size_t)item_size);
+    SOKOL_FREE(items);
+    *num_items = new_num;
+    return new_items;
+}
+
+/* makes room for at least min_num vertices, returns false if the context isn't growable */
+static bool _sgl_reserve_vertices(_sgl_context_t* ctx, int min_num) {
+    if (min_num <= ctx->num_vertices) {
+        return true;
+    }
+    else if (ctx->desc.growable) {
+        ctx->vertices = (_sgl_vertex_t*) _sgl_grow_buffer(ctx->vertices, ctx->cur_vertex, &ctx->num_vertices, min_num, (int)sizeof(_sgl_vertex_t));
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+static bool _sgl_reserve_uniforms(_sgl_context_t* ctx, int min_num) {
+    if (min_num <= ctx->num_uniforms) {
+        return true;
+    }
+    else if (ctx->desc.growable) {
+        ctx->uniforms = (_sgl_uniform_t*) _sgl_grow_buffer(ctx->uniforms, ctx->cur_uniform, &ctx->num_uniforms, min_num, (int)sizeof(_sgl_uniform_t));
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+static bool _sgl_reserve_commands(_sgl_context_t* ctx, int min_num) {
+    if (min_num <= ctx->num_commands) {
+        return true;
+    }
+    else if (ctx->desc.growable) {
+        ctx->commands = (_sgl_command_t*) _sgl_grow_buffer(ctx->commands, ctx->cur_command, &ctx->num_commands, min_num, (int)sizeof(_sgl_command_t));
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+static inline void _sgl_begin(_sgl_context_t* ctx, _sgl_primitive_type_t mode) {
+    if (mode == SGL_PRIMITIVETYPE_QUADS) {
+        /* the quad indices in the static index buffer expect quads to start at a multiple of 4 */
+        const int aligned_vertex = (ctx->cur_vertex + 3) & ~3;
+        _sgl_reserve_vertices(ctx, aligned_vertex);
+        ctx->cur_vertex = (aligned_vertex < ctx->num_vertices) ? aligned_vertex : ctx->num_vertices;
+    }
+    ctx->in_begin = true;
+    /* in pretransform mode, an affine modelview matrix is applied on the CPU in _sgl_vtx() */
+    if (ctx->desc.pretransform) {
+        const _sgl_matrix_t* mv = &ctx->matrix_stack[SGL_MATRIXMODE_MODELVIEW][ctx->matrix_tos[SGL_MATRIXMODE_MODELVIEW]];
+        ctx->cpu_transform = (mv->v[0][3] == 0.0f) && (mv->v[1][3] == 0.0f) && (mv->v[2][3] == 0.0f) && (mv->v[3][3] == 1.0f);
+        ctx->cpu_transform_matrix = *mv;
+    }
+    ctx->base_vertex = ctx->cur_vertex;
+    ctx->vtx_count = 0;
+    ctx->cur_prim_type = mode;
+}
+
+static void _sgl_update_high_water_marks(_sgl_context_t* ctx) {
+    if (ctx->cur_vertex > ctx->max_used_vertices) {
+        ctx->max_used_vertices = ctx->cur_vertex;
+    }
+    if (ctx->cur_uniform > ctx->max_used_uniforms) {
+        ctx->max_used_uniforms = ctx->cur_uniform;
+    }
+    if (ctx->cur_command > ctx->max_used_commands) {
+        ctx->max_used_commands = ctx->cur_command;
+    }
 }
 
-static void _sgl_rewind(void) {
-    _sgl.base_vertex = 0;
-    _sgl.cur_vertex = 0;
-    _sgl.cur_uniform = 0;
-    _sgl.cur_command = 0;
-    _sgl.error = SGL_NO_ERROR;
-    _sgl.matrix_dirty = true;
+static void _sgl_rewind(_sgl_context_t* ctx) {
+    _sgl_update_high_water_marks(ctx);
+    ctx->base_vertex = 0;
+    ctx->cur_vertex = 0;
+    ctx->cur_uniform = 0;
+    ctx->cur_command = 0;
+    ctx->error = SGL_NO_ERROR;
+    ctx->matrix_dirty = true;
 }
 
-static inline _sgl_vertex_t* _sgl_next_vertex(void) {
-    if (_sgl.cur_vertex < _sgl.num_vertices) {
-        return &_sgl.vertices[_sgl.cur_vertex++];
+static inline _sgl_vertex_t* _sgl_next_vertex(_sgl_context_t* ctx) {
+    if ((ctx->cur_vertex < ctx->num_vertices) || _sgl_reserve_vertices(ctx, ctx->cur_vertex + 1)) {
+        return &ctx->vertices[ctx->cur_vertex++];
     }
     else {
-        _sgl.error = SGL_ERROR_VERTICES_FULL;
+        ctx->error = SGL_ERROR_VERTICES_FULL;
         return 0;
     }
 }
 
-static inline _sgl_uniform_t* _sgl_next_uniform(void) {
-    if (_sgl.cur_uniform < _sgl.num_uniforms) {
-        return &_sgl.uniforms[_sgl.cur_uniform++];
+static inline _sgl_uniform_t* _sgl_next_uniform(_sgl_context_t* ctx) {
+    if ((ctx->cur_uniform < ctx->num_uniforms) || _sgl_reserve_uniforms(ctx, ctx->cur_uniform + 1)) {
+        return &ctx->uniforms[ctx->cur_uniform++];
     }
     else {
-        _sgl.error = SGL_ERROR_UNIFORMS_FULL;
+        ctx->error = SGL_ERROR_UNIFORMS_FULL;
         return 0;
     }
 }
 
-static inline _sgl_command_t* _sgl_prev_command(void) {
-    if (_sgl.cur_command > 0) {
-        return &_sgl.commands[_sgl.cur_command - 1];
+static inline _sgl_command_t* _sgl_prev_command(_sgl_context_t* ctx) {
+    if (ctx->cur_command > 0) {
+        return &ctx->commands[ctx->cur_command - 1];
     }
     else {
         return 0;
     }
 }
 
-static inline _sgl_command_t* _sgl_next_command(void) {
-    if (_sgl.cur_command < _sgl.num_commands) {
-        return &_sgl.commands[_sgl.cur_command++];
+static inline _sgl_command_t* _sgl_next_command(_sgl_context_t* ctx) {
+    if ((ctx->cur_command < ctx->num_commands) || _sgl_reserve_commands(ctx, ctx->cur_command + 1)) {
+        return &ctx->commands[ctx->cur_command++];
     }
     else {
-        _sgl.error = SGL_ERROR_COMMANDS_FULL;
+        ctx->error = SGL_ERROR_COMMANDS_FULL;
         return 0;
     }
 }
@@ -2400,26 +3084,297 @@ static inline uint32_t _sgl_pack_rgbaf(float r, float g, float b, float a) {
     return _sgl_pack_rgbab(r_u8, g_u8, b_u8, a_u8);
 }
 
-static inline void _sgl_vtx(float x, float y, float z, float u, float v, uint32_t rgba) {
-    SOKOL_ASSERT(_sgl.in_begin);
-    _sgl_vertex_t* vtx;
-    /* handle non-native primitive types */
-    if ((_sgl.cur_prim_type == SGL_PRIMITIVETYPE_QUADS) && ((_sgl.vtx_count & 3) == 3)) {
-        /* for quads, before writing the last quad vertex, reuse
-           the first and third vertex to start the second triangle in the quad
-        */
-        vtx = _sgl_next_vertex();
-        if (vtx) { *vtx = *(vtx - 3); }
-        vtx = _sgl_next_vertex();
-        if (vtx) { *vtx = *(vtx - 2); }
-    }
-    vtx = _sgl_next_vertex();
+/* transform a position by an affine matrix (the matrix columns are contiguous in memory) */
+static inline void _sgl_transform_pos(const _sgl_matrix_t* m, float x, float y, float z, float* dst) {
+    #if defined(_SGL_SSE2)
+        __m128 r = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m->v[0]), _mm_set1_ps(x)), _mm_loadu_ps(m->v[3]));
+        r = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m->v[1]), _mm_set1_ps(y)), r);
+        r = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m->v[2]), _mm_set1_ps(z)), r);
+        _mm_storel_pi((__m64*)dst, r);
+        _mm_store_ss(dst + 2, _mm_movehl_ps(r, r));
+    #elif defined(_SGL_NEON)
+        float32x4_t r = vmlaq_n_f32(vld1q_f32(m->v[3]), vld1q_f32(m->v[0]), x);
+        r = vmlaq_n_f32(r, vld1q_f32(m->v[1]), y);
+        r = vmlaq_n_f32(r, vld1q_f32(m->v[2]), z);
+        vst1_f32(dst, vget_low_f32(r));
+        dst[2] = vgetq_lane_f32(r, 2);
+    #else
+        dst[0] = m->v[0][0]*x + m->v[1][0]*y + m->v[2][0]*z + m->v[3][0];
+        dst[1] = m->v[0][1]*x + m->v[1][1]*y + m->v[2][1]*z + m->v[3][1];
+        dst[2] = m->v[0][2]*x + m->v[1][2]*y + m->v[2][2]*z + m->v[3][2];
+    #endif
+}
+
+static inline void _sgl_vtx(_sgl_context_t* ctx, float x, float y, float z, float u, float v, uint32_t rgba) {
+    SOKOL_ASSERT(ctx->in_begin);
+    _sgl_vertex_t* vtx = _sgl_next_vertex(ctx);
     if (vtx) {
-        vtx->pos[0] = x; vtx->pos[1] = y; vtx->pos[2] = z;
+        if (ctx->cpu_transform) {
+            _sgl_transform_pos(&ctx->cpu_transform_matrix, x, y, z, vtx->pos);
+        }
+        else {
+            vtx->pos[0] = x; vtx->pos[1] = y; vtx->pos[2] = z;
+        }
         vtx->uv[0] = u; vtx->uv[1] = v;
         vtx->rgba = rgba;
     }
-    _sgl.vtx_count++;
+    ctx->vtx_count++;
+}
+
+/* pack a float RGBA color into RGBA8, same result as _sgl_pack_rgbaf() */
+static inline uint32_t _sgl_pack_rgbaf_ptr(const float* c) {
+    #if defined(_SGL_SSE2)
+        const __m128 cf = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(c), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        const __m128i ci = _mm_cvttps_epi32(_mm_mul_ps(cf, _mm_set1_ps(255.0f)));
+        const __m128i c16 = _mm_packs_epi32(ci, ci);
+        return (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(c16, c16));
+    #elif defined(_SGL_NEON)
+        const float32x4_t cf = vminq_f32(vmaxq_f32(vld1q_f32(c), vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+        const uint16x4_t c16 = vmovn_u32(vcvtq_u32_f32(vmulq_n_f32(cf, 255.0f)));
+        const uint8x8_t c8 = vmovn_u16(vcombine_u16(c16, c16));
+        return vget_lane_u32(vreinterpret_u32_u8(c8), 0);
+    #else
+        return _sgl_pack_rgbaf(c[0], c[1], c[2], c[3]);
+    #endif
+}
+
+/* write a whole array of vertices at once, this does the same as calling
+   _sgl_vtx() for each vertex, but without the per-vertex overhead
+*/
+static void _sgl_vtx_arrays(_sgl_context_t* ctx, const sgl_vertex_arrays_t* arrays) {
+    SOKOL_ASSERT(ctx->in_begin);
+    SOKOL_ASSERT(arrays->pos && (arrays->num_vertices >= 0));
+    const int num = arrays->num_vertices;
+    if (!_sgl_reserve_vertices(ctx, ctx->cur_vertex + num)) {
+        ctx->error = SGL_ERROR_VERTICES_FULL;
+        return;
+    }
+    _sgl_vertex_t* dst = &ctx->vertices[ctx->cur_vertex];
+    ctx->cur_vertex += num;
+    ctx->vtx_count += num;
+
+    const int pos_size = _sgl_def(arrays->pos_size, 3);
+    SOKOL_ASSERT((pos_size == 2) || (pos_size == 3));
+    const int pos_stride = _sgl_def(arrays->pos_stride, pos_size * (int)sizeof(float));
+    const int uv_stride = _sgl_def(arrays->uv_stride, 2 * (int)sizeof(float));
+    const bool float_colors = 0 != arrays->colors;
+    const int color_stride = _sgl_def(arrays->color_stride, float_colors ? 4 * (int)sizeof(float) : (int)sizeof(uint32_t));
+    const uint8_t* pos = (const uint8_t*) arrays->pos;
+    const uint8_t* uv = (const uint8_t*) arrays->uv;
+    const uint8_t* colors = float_colors ? (const uint8_t*) arrays->colors : (const uint8_t*) arrays->packed_colors;
+    const bool cpu_transform = ctx->cpu_transform;
+    if (!cpu_transform && (pos_size == 3) && uv && colors && !float_colors) {
+        /* fast path for complete vertices with packed colors */
+        for (int i = 0; i < num; i++, pos += pos_stride) {
+            const float* p = (const float*) pos;
+            const float* t = (const float*)(uv + i * uv_stride);
+            dst[i].pos[0] = p[0]; dst[i].pos[1] = p[1]; dst[i].pos[2] = p[2];
+            dst[i].uv[0] = t[0]; dst[i].uv[1] = t[1];
+            memcpy(&dst[i].rgba, colors + i * color_stride, sizeof(uint32_t));
+        }
+        return;
+    }
+    /* all conditions in the loop are loop-invariant */
+    for (int i = 0; i < num; i++, pos += pos_stride) {
+        const float* p = (const float*) pos;
+        const float z = (pos_size == 3) ? p[2] : 0.0f;
+        if (cpu_transform) {
+            _sgl_transform_pos(&ctx->cpu_transform_matrix, p[0], p[1], z, dst[i].pos);
+        }
+        else {
+            dst[i].pos[0] = p[0]; dst[i].pos[1] = p[1]; dst[i].pos[2] = z;
+        }
+        if (uv) {
+            const float* t = (const float*)(uv + i * uv_stride);
+            dst[i].uv[0] = t[0]; dst[i].uv[1] = t[1];
+        }
+        else {
+            dst[i].uv[0] = ctx->u; dst[i].uv[1] = ctx->v;
+        }
+        if (float_colors) {
+            dst[i].rgba = _sgl_pack_rgbaf_ptr((const float*)(colors + i * color_stride));
+        }
+        else if (colors) {
+            memcpy(&dst[i].rgba, colors + i * color_stride, sizeof(uint32_t));
+        }
+        else {
+            dst[i].rgba = ctx->rgba;
+        }
+    }
+}
+
+static uint16_t _sgl_float_to_half(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    const int exp = (int)((bits >> 23) & 0xFF);
+    const uint32_t mant = bits & 0x7FFFFF;
+    if (exp == 0xFF) {
+        /* inf or nan */
+        return (uint16_t)(sign | 0x7C00 | (mant ? 0x200 : 0));
+    }
+    const int half_exp = exp - 127 + 15;
+    if (half_exp >= 0x1F) {
+        /* overflow => inf */
+        return (uint16_t)(sign | 0x7C00);
+    }
+    if (half_exp <= 0) {
+        if (half_exp < -10) {
+            return sign;
+        }
+        /* denormal, round to nearest even */
+        const uint32_t m = mant | 0x800000;
+        const int shift = 14 - half_exp;
+        uint32_t half_mant = m >> shift;
+        const uint32_t rem = m & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if ((rem > halfway) || ((rem == halfway) && (half_mant & 1))) {
+            half_mant++;
+        }
+        return (uint16_t)(sign | half_mant);
+    }
+    /* normal, round to nearest even (a mantissa overflow correctly bumps the exponent) */
+    uint32_t h = ((uint32_t)half_exp << 10) | (mant >> 13);
+    const uint32_t rem = mant & 0x1FFF;
+    if ((rem > 0x1000) || ((rem == 0x1000) && (h & 1))) {
+        h++;
+    }
+    return (uint16_t)(sign | h);
+}
+
+/* texture coordinates are clamped to 0..1 in the 16-bit normalized layouts */
+static inline uint16_t _sgl_unorm16(float f) {
+    return (uint16_t)(_sgl_clamp(f, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
+static int _sgl_vertex_size(sgl_vertex_layout_t layout) {
+    switch (layout) {
+        case SGL_VERTEXLAYOUT_FLOAT2_UV16:  return (int)sizeof(_sgl_vertex_float2_uv16_t);
+        case SGL_VERTEXLAYOUT_HALF2_UV16:   return (int)sizeof(_sgl_vertex_half2_uv16_t);
+        case SGL_VERTEXLAYOUT_HALF4_UV16:   return (int)sizeof(_sgl_vertex_half4_uv16_t);
+        default:                            return (int)sizeof(_sgl_vertex_t);
+    }
+}
+
+#if defined(_SGL_SSE2)
+/* converts 4 floats to half-floats with round-to-nearest-even (after Fabian Giesen's
+   float_to_half_fast3_rtne), the results are sign-extended to 32 bits so that they
+   can be narrowed with _mm_packs_epi32()
+*/
+static inline __m128i _sgl_float_to_half_sse2(__m128 f) {
+    const __m128i f16max = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i min_normal = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i subnorm_magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i normal_bias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+    const __m128 sign = _mm_and_ps(_mm_castsi128_ps(_mm_set1_epi32((int)0x80000000)), f);
+    const __m128 absf = _mm_xor_ps(f, sign);
+    const __m128i absf_int = _mm_castps_si128(absf);
+    const __m128i is_nan = _mm_castps_si128(_mm_cmpunord_ps(absf, absf));
+    const __m128i is_regular = _mm_cmpgt_epi32(f16max, absf_int);
+    const __m128i inf_or_nan = _mm_or_si128(_mm_and_si128(is_nan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+    const __m128i is_subnormal = _mm_cmpgt_epi32(min_normal, absf_int);
+    const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absf, _mm_castsi128_ps(subnorm_magic))), subnorm_magic);
+    const __m128i mant_odd = _mm_srai_epi32(_mm_slli_epi32(absf_int, 31 - 13), 31);
+    const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absf_int, normal_bias), mant_odd), 13);
+    const __m128i nonspecial = _mm_or_si128(_mm_and_si128(subnormal, is_subnormal), _mm_andnot_si128(is_subnormal, normal));
+    const __m128i joined = _mm_or_si128(_mm_and_si128(nonspecial, is_regular), _mm_andnot_si128(is_regular, inf_or_nan));
+    return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+/* converts 4 floats to 16-bit unorm, biased by -32768 so that _mm_packs_epi32() doesn't saturate */
+static inline __m128i _sgl_unorm16_sse2(__m128 f) {
+    const __m128 c = _mm_min_ps(_mm_max_ps(f, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    const __m128i u = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(65535.0f)), _mm_set1_ps(0.5f)));
+    return _mm_sub_epi32(u, _mm_set1_epi32(32768));
+}
+#endif
+
+/* converts recorded vertices into a compact vertex layout, dst may be the same as src
+   since the compact vertices are smaller and each vertex is read before it is overwritten
+   (all accesses go through memcpy to keep this well-defined when converting in place),
+   the SIMD paths convert the half-float layouts two vertices at a time
+*/
+static void _sgl_convert_vertices(sgl_vertex_layout_t layout, const _sgl_vertex_t* src, void* dst, int num) {
+    uint8_t* ptr = (uint8_t*) dst;
+    _sgl_vertex_t v[2];
+    int i = 0;
+    switch (layout) {
+        case SGL_VERTEXLAYOUT_FLOAT2_UV16:
+            for (; i < num; i++, ptr += sizeof(_sgl_vertex_float2_uv16_t)) {
+                memcpy(v, &src[i], sizeof(v[0]));
+                _sgl_vertex_float2_uv16_t d;
+                d.pos[0] = v[0].pos[0];
+                d.pos[1] = v[0].pos[1];
+                d.uv[0] = _sgl_unorm16(v[0].uv[0]);
+                d.uv[1] = _sgl_unorm16(v[0].uv[1]);
+                d.rgba = v[0].rgba;
+                memcpy(ptr, &d, sizeof(d));
+            }
+            break;
+        case SGL_VERTEXLAYOUT_HALF2_UV16:
+            #if defined(_SGL_SSE2)
+            for (; (i + 2) <= num; i += 2, ptr += 2 * sizeof(_sgl_vertex_half2_uv16_t)) {
+                memcpy(v, &src[i], sizeof(v));
+                const __m128i pos = _sgl_float_to_half_sse2(_mm_setr_ps(v[0].pos[0], v[0].pos[1], v[1].pos[0], v[1].pos[1]));
+                const __m128i uv = _sgl_unorm16_sse2(_mm_setr_ps(v[0].uv[0], v[0].uv[1], v[1].uv[0], v[1].uv[1]));
+                const __m128i bias = _mm_set1_epi16((short)0x8000);
+                uint16_t pos16[8], uv16[8];
+                _mm_storeu_si128((__m128i*)pos16, _mm_packs_epi32(pos, pos));
+                _mm_storeu_si128((__m128i*)uv16, _mm_xor_si128(_mm_packs_epi32(uv, uv), bias));
+                _sgl_vertex_half2_uv16_t d[2];
+                memcpy(d[0].pos, &pos16[0], 4); memcpy(d[0].uv, &uv16[0], 4); d[0].rgba = v[0].rgba;
+                memcpy(d[1].pos, &pos16[2], 4); memcpy(d[1].uv, &uv16[2], 4); d[1].rgba = v[1].rgba;
+                memcpy(ptr, d, sizeof(d));
+            }
+            #endif
+            for (; i < num; i++, ptr += sizeof(_sgl_vertex_half2_uv16_t)) {
+                memcpy(v, &src[i], sizeof(v[0]));
+                _sgl_vertex_half2_uv16_t d;
+                d.pos[0] = _sgl_float_to_half(v[0].pos[0]);
+                d.pos[1] = _sgl_float_to_half(v[0].pos[1]);
+                d.uv[0] = _sgl_unorm16(v[0].uv[0]);
+                d.uv[1] = _sgl_unorm16(v[0].uv[1]);
+                d.rgba = v[0].rgba;
+                memcpy(ptr, &d, sizeof(d));
+            }
+            break;
+        case SGL_VERTEXLAYOUT_HALF4_UV16:
+            #if defined(_SGL_SSE2)
+            for (; (i + 2) <= num; i += 2, ptr += 2 * sizeof(_sgl_vertex_half4_uv16_t)) {
+                memcpy(v, &src[i], sizeof(v));
+                const __m128i bias = _mm_set1_epi16((short)0x8000);
+                const __m128i pos = _mm_packs_epi32(
+                    _sgl_float_to_half_sse2(_mm_setr_ps(v[0].pos[0], v[0].pos[1], v[0].pos[2], 1.0f)),
+                    _sgl_float_to_half_sse2(_mm_setr_ps(v[1].pos[0], v[1].pos[1], v[1].pos[2], 1.0f)));
+                const __m128i uv = _mm_xor_si128(_mm_packs_epi32(_sgl_unorm16_sse2(_mm_setr_ps(v[0].uv[0], v[0].uv[1], v[1].uv[0], v[1].uv[1])), bias), bias);
+                _sgl_vertex_half4_uv16_t d[2];
+                uint16_t pos16[8], uv16[8];
+                _mm_storeu_si128((__m128i*)pos16, pos);
+                _mm_storeu_si128((__m128i*)uv16, uv);
+                memcpy(d[0].pos, &pos16[0], 8); memcpy(d[0].uv, &uv16[0], 4); d[0].rgba = v[0].rgba;
+                memcpy(d[1].pos, &pos16[4], 8); memcpy(d[1].uv, &uv16[2], 4); d[1].rgba = v[1].rgba;
+                memcpy(ptr, d, sizeof(d));
+            }
+            #endif
+            for (; i < num; i++, ptr += sizeof(_sgl_vertex_half4_uv16_t)) {
+                memcpy(v, &src[i], sizeof(v[0]));
+                _sgl_vertex_half4_uv16_t d;
+                d.pos[0] = _sgl_float_to_half(v[0].pos[0]);
+                d.pos[1] = _sgl_float_to_half(v[0].pos[1]);
+                d.pos[2] = _sgl_float_to_half(v[0].pos[2]);
+                d.pos[3] = 0x3C00;     /* 1.0 */
+                d.uv[0] = _sgl_unorm16(v[0].uv[0]);
+                d.uv[1] = _sgl_unorm16(v[0].uv[1]);
+                d.rgba = v[0].rgba;
+                memcpy(ptr, &d, sizeof(d));
+            }
+            break;
+        default:
+            if (dst != (const void*)src) {
+                memcpy(dst, src, (size_t)num * sizeof(_sgl_vertex_t));
+            }
+            break;
+    }
 }
 
 static void _sgl_identity(_sgl_matrix_t* m) {
@@ -2613,59 +3568,388 @@ static void _sgl_lookat(_sgl_matrix_t* dst,
 }
 
 /* current top-of-stack projection matrix */
-static inline _sgl_matrix_t* _sgl_matrix_projection(void) {
-    return &_sgl.matrix_stack[SGL_MATRIXMODE_PROJECTION][_sgl.matrix_tos[SGL_MATRIXMODE_PROJECTION]];
+static inline _sgl_matrix_t* _sgl_matrix_projection(_sgl_context_t* ctx) {
+    return &ctx->matrix_stack[SGL_MATRIXMODE_PROJECTION][ctx->matrix_tos[SGL_MATRIXMODE_PROJECTION]];
 }
 
 /* get top-of-stack modelview matrix */
-static inline _sgl_matrix_t* _sgl_matrix_modelview(void) {
-    return &_sgl.matrix_stack[SGL_MATRIXMODE_MODELVIEW][_sgl.matrix_tos[SGL_MATRIXMODE_MODELVIEW]];
+static inline _sgl_matrix_t* _sgl_matrix_modelview(_sgl_context_t* ctx) {
+    return &ctx->matrix_stack[SGL_MATRIXMODE_MODELVIEW][ctx->matrix_tos[SGL_MATRIXMODE_MODELVIEW]];
 }
 
 /* get top-of-stack texture matrix */
-static inline _sgl_matrix_t* _sgl_matrix_texture(void) {
-    return &_sgl.matrix_stack[SGL_MATRIXMODE_TEXTURE][_sgl.matrix_tos[SGL_MATRIXMODE_TEXTURE]];
+static inline _sgl_matrix_t* _sgl_matrix_texture(_sgl_context_t* ctx) {
+    return &ctx->matrix_stack[SGL_MATRIXMODE_TEXTURE][ctx->matrix_tos[SGL_MATRIXMODE_TEXTURE]];
 }
 
 /* get pointer to current top-of-stack of current matrix mode */
-static inline _sgl_matrix_t* _sgl_matrix(void) {
-    return &_sgl.matrix_stack[_sgl.cur_matrix_mode][_sgl.matrix_tos[_sgl.cur_matrix_mode]];
+static inline _sgl_matrix_t* _sgl_matrix(_sgl_context_t* ctx) {
+    return &ctx->matrix_stack[ctx->cur_matrix_mode][ctx->matrix_tos[ctx->cur_matrix_mode]];
 }
 
-/*== PUBLIC FUNCTIONS ========================================================*/
-SOKOL_API_IMPL void sgl_setup(const sgl_desc_t* desc) {
+/* make sure that the current uniform matches the matrix stack, proj_only means
+   that the modelview matrix has already been applied on the CPU (pretransform mode),
+   a uniform of the other kind is never reused, returns true if a new uniform was added
+*/
+static bool _sgl_update_uniform(_sgl_context_t* ctx, bool proj_only) {
+    if (!ctx->matrix_dirty && (ctx->uniform_proj_only == proj_only)) {
+        return false;
+    }
+    ctx->matrix_dirty = false;
+    ctx->uniform_proj_only = proj_only;
+    _sgl_uniform_t new_uni;
+    if (proj_only) {
+        new_uni.mvp = *_sgl_matrix_projection(ctx);
+    }
+    else {
+        _sgl_matmul4(&new_uni.mvp, _sgl_matrix_projection(ctx), _sgl_matrix_modelview(ctx));
+    }
+    new_uni.tm = *_sgl_matrix_texture(ctx);
+    /* in pretransform mode a modelview change usually leaves the uniforms unchanged,
+       in this case the previous uniforms are reused and the draw command may be merged
+    */
+    const int min_uniform = ctx->in_display_list ? ctx->list_base_uniform : 0;
+    if (ctx->desc.pretransform &&
+        (ctx->cur_uniform > min_uniform) &&
+        (0 == memcmp(&ctx->uniforms[ctx->cur_uniform - 1], &new_uni, sizeof(new_uni))))
+    {
+        return false;
+    }
+    _sgl_uniform_t* uni = _sgl_next_uniform(ctx);
+    if (uni) {
+        *uni = new_uni;
+    }
+    return true;
+}
+
+static void _sgl_setup_context_pool(const sgl_desc_t* desc) {
     SOKOL_ASSERT(desc);
-    memset(&_sgl, 0, sizeof(_sgl));
-    _sgl.init_cookie = _SGL_INIT_COOKIE;
-    _sgl.desc = *desc;
-    _sgl.desc.pipeline_pool_size = _sgl_def(_sgl.desc.pipeline_pool_size, _SGL_DEFAULT_PIPELINE_POOL_SIZE);
-    _sgl.desc.max_vertices = _sgl_def(_sgl.desc.max_vertices, _SGL_DEFAULT_MAX_VERTICES);
-    _sgl.desc.max_commands = _sgl_def(_sgl.desc.max_commands, _SGL_DEFAULT_MAX_COMMANDS);
-    _sgl.desc.face_winding = _sgl_def(_sgl.desc.face_winding, SG_FACEWINDING_CCW);
+    /* note: the pools here will have an additional item, since slot 0 is reserved */
+    SOKOL_ASSERT((desc->context_pool_size > 0) && (desc->context_pool_size < _SGL_MAX_POOL_SIZE));
+    _sgl_init_pool(&_sgl.context_pool.pool, desc->context_pool_size);
+    size_t pool_byte_size = sizeof(_sgl_context_t) * _sgl.context_pool.pool.size;
+    _sgl.context_pool.contexts = (_sgl_context_t*) SOKOL_MALLOC(pool_byte_size);
+    SOKOL_ASSERT(_sgl.context_pool.contexts);
+    memset(_sgl.context_pool.contexts, 0, pool_byte_size);
+}
 
-    /* allocate buffers and pools */
-    _sgl.num_vertices = _sgl.desc.max_vertices;
-    _sgl.num_uniforms = _sgl.desc.max_commands;
-    _sgl.num_commands = _sgl.num_uniforms;
-    _sgl.vertices = (_sgl_vertex_t*) SOKOL_MALLOC(_sgl.num_vertices * sizeof(_sgl_vertex_t));
-    SOKOL_ASSERT(_sgl.vertices);
-    _sgl.uniforms = (_sgl_uniform_t*) SOKOL_MALLOC(_sgl.num_uniforms * sizeof(_sgl_uniform_t));
-    SOKOL_ASSERT(_sgl.uniforms);
-    _sgl.commands = (_sgl_command_t*) SOKOL_MALLOC(_sgl.num_commands * sizeof(_sgl_command_t));
-    SOKOL_ASSERT(_sgl.commands);
-    _sgl_setup_pipeline_pool(&_sgl.desc);
+static void _sgl_discard_context_pool(void) {
+    SOKOL_FREE(_sgl.context_pool.contexts); _sgl.context_pool.contexts = 0;
+    _sgl_discard_pool(&_sgl.context_pool.pool);
+}
 
-    /* create sokol-gfx resource objects */
-    sg_push_debug_group("sokol-gl");
+/* get context pointer without id-check */
+static _sgl_context_t* _sgl_context_at(uint32_t ctx_id) {
+    SOKOL_ASSERT(SG_INVALID_ID != ctx_id);
+    int slot_index = _sgl_slot_index(ctx_id);
+    SOKOL_ASSERT((slot_index > _SGL_INVALID_SLOT_INDEX) && (slot_index < _sgl.context_pool.pool.size));
+    return &_sgl.context_pool.contexts[slot_index];
+}
+
+/* get context pointer with id-check, returns 0 if no match */
+static _sgl_context_t* _sgl_lookup_context(uint32_t ctx_id) {
+    if (SG_INVALID_ID != ctx_id) {
+        _sgl_context_t* ctx = _sgl_context_at(ctx_id);
+        if (ctx->slot.id == ctx_id) {
+            return ctx;
+        }
+    }
+    return 0;
+}
+
+/* the calling thread's current context id, a thread which hasn't selected a
+   context with sgl_set_context() uses the default context
+*/
+static uint32_t _sgl_cur_ctx_id(void) {
+    return _sgl_thread.ctx_selected ? _sgl_thread.ctx_id.id : _sgl.def_ctx_id.id;
+}
+
+/* resolve the calling thread's current context id, logs once per thread if the context doesn't exist */
+static inline _sgl_context_t* _sgl_resolve_cur_context(void) {
+    const uint32_t ctx_id = _sgl_cur_ctx_id();
+    const int slot_index = (int)(ctx_id & _SGL_SLOT_MASK);
+    _sgl_context_t* ctx = 0;
+    if ((SG_INVALID_ID != ctx_id) && _sgl.context_pool.contexts && (slot_index < _sgl.context_pool.pool.size)) {
+        ctx = &_sgl.context_pool.contexts[slot_index];
+        if (ctx->slot.id != ctx_id) {
+            ctx = 0;
+        }
+    }
+    _sgl_thread.cached_ctx = ctx;
+    _sgl_thread.cached_ctx_id = ctx_id;
+    _sgl_thread.cached_setup_serial = _sgl.setup_serial;
+    if (!ctx && !_sgl_thread.no_ctx_logged) {
+        _sgl_thread.no_ctx_logged = true;
+        SOKOL_LOG("sokol_gl.h: no valid current context on this thread, sokol-gl calls are ignored");
+    }
+    return ctx;
+}
+
+/* the calling thread's current context, this is called for every vertex, so
+   the last lookup is reused as long as sokol-gl hasn't been shut down since, and
+   the slot still holds the same context (a destroyed or reused slot has a different id)
+*/
+static inline _sgl_context_t* _sgl_cur_context(void) {
+    _sgl_context_t* ctx = _sgl_thread.cached_ctx;
+    if (ctx && (_sgl_thread.cached_setup_serial == _sgl.setup_serial) && (ctx->slot.id == _sgl_thread.cached_ctx_id)) {
+        return ctx;
+    }
+    return _sgl_resolve_cur_context();
+}
+
+/* make context id from uint32_t id */
+static sgl_context _sgl_make_ctx_id(uint32_t ctx_id) {
+    sgl_context ctx;
+    ctx.id = ctx_id;
+    return ctx;
+}
+
+static sgl_context _sgl_alloc_context(void) {
+    sgl_context res;
+    int slot_index = _sgl_pool_alloc_index(&_sgl.context_pool.pool);
+    if (_SGL_INVALID_SLOT_INDEX != slot_index) {
+        res = _sgl_make_ctx_id(_sgl_slot_alloc(&_sgl.context_pool.pool, &_sgl.context_pool.contexts[slot_index].slot, slot_index));
+    }
+    else {
+        /* pool is exhausted */
+        res = _sgl_make_ctx_id(SG_INVALID_ID);
+    }
+    return res;
+}
+
+static sgl_context_desc_t _sgl_context_desc_defaults(const sgl_context_desc_t* desc) {
+    sgl_context_desc_t res = *desc;
+    res.max_vertices = _sgl_def(desc->max_vertices, _SGL_DEFAULT_MAX_VERTICES);
+    res.max_commands = _sgl_def(desc->max_commands, _SGL_DEFAULT_MAX_COMMANDS);
+    return res;
+}
 
+static void _sgl_init_vertex_buffer(_sgl_context_t* ctx, int num_vertices) {
+    ctx->vbuf_num_vertices = num_vertices;
     sg_buffer_desc vbuf_desc;
     memset(&vbuf_desc, 0, sizeof(vbuf_desc));
-    vbuf_desc.size = _sgl.num_vertices * sizeof(_sgl_vertex_t);
+    vbuf_desc.size = num_vertices * ctx->vertex_size;
     vbuf_desc.type = SG_BUFFERTYPE_VERTEXBUFFER;
     vbuf_desc.usage = SG_USAGE_STREAM;
     vbuf_desc.label = "sgl-vertex-buffer";
-    _sgl.vbuf = sg_make_buffer(&vbuf_desc);
-    SOKOL_ASSERT(SG_INVALID_ID != _sgl.vbuf.id);
+    ctx->vbuf = sg_make_buffer(&vbuf_desc);
+    SOKOL_ASSERT(SG_INVALID_ID != ctx->vbuf.id);
+}
+
+/* creates the static index buffer for quads (4 vertices per quad) and triangle fans:
+    - quads: 0,1,2, 0,2,3, 4,5,6, 4,6,7, ... for all quads in the vertex buffer
+    - triangle fans: 0,1,2, 0,2,3, 0,3,4, ... for a fan spanning the whole vertex buffer,
+      a triangle fan is drawn by moving the vertex buffer offset to its first vertex
+    growable contexts always use 32-bit indices, since the index type is baked
+    into the context's pipeline objects
+*/
+static void _sgl_init_index_buffer(_sgl_context_t* ctx) {
+    const int num_vertices = ctx->vbuf_num_vertices;
+    const int num_quads = num_vertices / 4;
+    const int num_fan_triangles = (num_vertices > 2) ? (num_vertices - 2) : 0;
+    const int num_indices = num_quads * 6 + num_fan_triangles * 3;
+    ctx->index_type = (!ctx->desc.growable && (num_vertices <= (1<<16))) ? SG_INDEXTYPE_UINT16 : SG_INDEXTYPE_UINT32;
+    ctx->fan_base_element = num_quads * 6;
+    const int index_size = (ctx->index_type == SG_INDEXTYPE_UINT16) ? 2 : 4;
+    void* indices = SOKOL_MALLOC(num_indices * index_size);
+    SOKOL_ASSERT(indices);
+    uint16_t* ptr16 = (uint16_t*) indices;
+    uint32_t* ptr32 = (uint32_t*) indices;
+    int i = 0;
+    for (int quad = 0; quad < num_quads; quad++) {
+        const uint32_t v = (uint32_t)quad * 4;
+        const uint32_t quad_indices[6] = { v, v+1, v+2, v, v+2, v+3 };
+        for (int j = 0; j < 6; j++, i++) {
+            if (index_size == 2) { ptr16[i] = (uint16_t)quad_indices[j]; }
+            else { ptr32[i] = quad_indices[j]; }
+        }
+    }
+    for (int tri = 0; tri < num_fan_triangles; tri++) {
+        const uint32_t fan_indices[3] = { 0, (uint32_t)tri + 1, (uint32_t)tri + 2 };
+        for (int j = 0; j < 3; j++, i++) {
+            if (index_size == 2) { ptr16[i] = (uint16_t)fan_indices[j]; }
+            else { ptr32[i] = fan_indices[j]; }
+        }
+    }
+    SOKOL_ASSERT(i == num_indices);
+    sg_buffer_desc ibuf_desc;
+    memset(&ibuf_desc, 0, sizeof(ibuf_desc));
+    ibuf_desc.size = num_indices * index_size;
+    ibuf_desc.type = SG_BUFFERTYPE_INDEXBUFFER;
+    ibuf_desc.usage = SG_USAGE_IMMUTABLE;
+    ibuf_desc.content = indices;
+    ibuf_desc.label = "sgl-index-buffer";
+    ctx->ibuf = sg_make_buffer(&ibuf_desc);
+    SOKOL_ASSERT(SG_INVALID_ID != ctx->ibuf.id);
+    SOKOL_FREE(indices);
+}
+
+static void _sgl_init_context(sgl_context ctx_id, const sgl_context_desc_t* in_desc) {
+    SOKOL_ASSERT((ctx_id.id != SG_INVALID_ID) && in_desc);
+    _sgl_context_t* ctx = _sgl_lookup_context(ctx_id.id);
+    SOKOL_ASSERT(ctx && (ctx->slot.state == SG_RESOURCESTATE_ALLOC));
+    ctx->desc = _sgl_context_desc_defaults(in_desc);
+    ctx->vertex_size = _sgl_vertex_size(ctx->desc.vertex_layout);
+
+    /* allocate buffers */
+    ctx->num_vertices = ctx->desc.max_vertices;
+    ctx->num_uniforms = ctx->desc.max_commands;
+    ctx->num_commands = ctx->num_uniforms;
+    ctx->vertices = (_sgl_vertex_t*) SOKOL_MALLOC(ctx->num_vertices * sizeof(_sgl_vertex_t));
+    SOKOL_ASSERT(ctx->vertices);
+    ctx->uniforms = (_sgl_uniform_t*) SOKOL_MALLOC(ctx->num_uniforms * sizeof(_sgl_uniform_t));
+    SOKOL_ASSERT(ctx->uniforms);
+    ctx->commands = (_sgl_command_t*) SOKOL_MALLOC(ctx->num_commands * sizeof(_sgl_command_t));
+    SOKOL_ASSERT(ctx->commands);
+
+    /* create sokol-gfx resource objects */
+    sg_push_debug_group("sokol-gl");
+    _sgl_init_vertex_buffer(ctx, ctx->num_vertices);
+    _sgl_init_index_buffer(ctx);
+
+    /* create default pipeline object */
+    sg_pipeline_desc def_pip_desc;
+    memset(&def_pip_desc, 0, sizeof(def_pip_desc));
+    def_pip_desc.depth_stencil.depth_write_enabled = true;
+    ctx->def_pip = _sgl_make_pipeline(&def_pip_desc, ctx);
+    sg_pop_debug_group();
+
+    /* default state */
+    ctx->cur_img = _sgl.def_img;
+    ctx->rgba = 0xFFFFFFFF;
+    for (int i = 0; i < SGL_NUM_MATRIXMODES; i++) {
+        _sgl_identity(&ctx->matrix_stack[i][0]);
+    }
+    ctx->pip_stack[0] = ctx->def_pip;
+    ctx->matrix_dirty = true;
+    ctx->slot.state = SG_RESOURCESTATE_VALID;
+}
+
+static sgl_context _sgl_make_context(const sgl_context_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    sgl_context ctx_id = _sgl_alloc_context();
+    if (ctx_id.id != SG_INVALID_ID) {
+        _sgl_init_context(ctx_id, desc);
+    }
+    else {
+        SOKOL_LOG("sokol_gl.h: context pool exhausted!");
+    }
+    return ctx_id;
+}
+
+/* destroys the context and all pipelines and display lists which were created for the context */
+static void _sgl_destroy_context(sgl_context ctx_id) {
+    _sgl_context_t* ctx = _sgl_lookup_context(ctx_id.id);
+    if (ctx) {
+        SOKOL_FREE(ctx->vertices);
+        SOKOL_FREE(ctx->uniforms);
+        SOKOL_FREE(ctx->commands);
+        sg_push_debug_group("sokol-gl");
+        sg_destroy_buffer(ctx->vbuf);
+        sg_destroy_buffer(ctx->ibuf);
+        for (int i = 0; i < _sgl.list_pool.pool.size; i++) {
+            _sgl_display_list_t* list = &_sgl.list_pool.lists[i];
+            if ((list->slot.id != SG_INVALID_ID) && (list->ctx.id == ctx_id.id)) {
+                _sgl_destroy_display_list(_sgl_make_list_id(list->slot.id));
+            }
+        }
+        for (int i = 0; i < _sgl.pip_pool.pool.size; i++) {
+            _sgl_pipeline_t* pip = &_sgl.pip_pool.pips[i];
+            if ((pip->slot.id != SG_INVALID_ID) && (pip->ctx.id == ctx_id.id)) {
+                _sgl_destroy_pipeline(_sgl_make_pip_id(pip->slot.id));
+            }
+        }
+        sg_pop_debug_group();
+        memset(ctx, 0, sizeof(_sgl_context_t));
+        _sgl_pool_free_index(&_sgl.context_pool.pool, _sgl_slot_index(ctx_id.id));
+    }
+}
+
+/* the sokol-gfx pipelines and display lists of compatible contexts can be rendered in each other's render passes */
+static bool _sgl_contexts_compatible(const _sgl_context_t* a, const _sgl_context_t* b) {
+    return (a->desc.color_format == b->desc.color_format) &&
+           (a->desc.depth_format == b->desc.depth_format) &&
+           (a->desc.sample_count == b->desc.sample_count) &&
+           (a->desc.vertex_layout == b->desc.vertex_layout) &&
+           (a->index_type == b->index_type);
+}
+
+/* appends the vertices, uniforms and commands recorded in src to dst, and rewinds src */
+static void _sgl_merge_context(_sgl_context_t* dst, _sgl_context_t* src) {
+    SOKOL_ASSERT(dst != src);
+    SOKOL_ASSERT(!dst->in_begin && !dst->in_display_list);
+    SOKOL_ASSERT(!src->in_begin && !src->in_display_list);
+    if (!_sgl_contexts_compatible(dst, src)) {
+        SOKOL_LOG("sokol_gl.h: sgl_merge_context(): incompatible contexts (pixel formats, sample count, vertex layout or index type differ)");
+    }
+    else if (src->error != SGL_NO_ERROR) {
+        /* same as if everything had been recorded into dst */
+        dst->error = src->error;
+    }
+    else if ((dst->error == SGL_NO_ERROR) && (src->cur_command > 0)) {
+        /* quads start at a multiple of 4 in src, this must remain true in dst */
+        const int base_vertex = (dst->cur_vertex + 3) & ~3;
+        const int base_uniform = dst->cur_uniform;
+        const int base_command = dst->cur_command;
+        if (!_sgl_reserve_vertices(dst, base_vertex + src->cur_vertex)) {
+            dst->error = SGL_ERROR_VERTICES_FULL;
+        }
+        else if (!_sgl_reserve_uniforms(dst, base_uniform + src->cur_uniform)) {
+            dst->error = SGL_ERROR_UNIFORMS_FULL;
+        }
+        else if (!_sgl_reserve_commands(dst, base_command + src->cur_command)) {
+            dst->error = SGL_ERROR_COMMANDS_FULL;
+        }
+        else {
+            memcpy(&dst->vertices[base_vertex], src->vertices, (size_t)src->cur_vertex * sizeof(_sgl_vertex_t));
+            memcpy(&dst->uniforms[base_uniform], src->uniforms, (size_t)src->cur_uniform * sizeof(_sgl_uniform_t));
+            memcpy(&dst->commands[base_command], src->commands, (size_t)src->cur_command * sizeof(_sgl_command_t));
+            for (int i = base_command; i < (base_command + src->cur_command); i++) {
+                _sgl_command_t* cmd = &dst->commands[i];
+                if (cmd->cmd == SGL_COMMAND_DRAW) {
+                    cmd->args.draw.base_vertex += base_vertex;
+                    cmd->args.draw.uniform_index += base_uniform;
+                }
+                else if (cmd->cmd == SGL_COMMAND_CALL_DISPLAY_LIST) {
+                    cmd->args.call_display_list.uniform_index += base_uniform;
+                }
+            }
+            dst->cur_vertex = base_vertex + src->cur_vertex;
+            dst->cur_uniform = base_uniform + src->cur_uniform;
+            dst->cur_command = base_command + src->cur_command;
+            dst->base_vertex = dst->cur_vertex;
+            /* the last uniform block now belongs to src, the next sgl_end() in dst needs its own */
+            dst->matrix_dirty = true;
+        }
+    }
+    _sgl_rewind(src);
+}
+
+/*== PUBLIC FUNCTIONS ========================================================*/
+SOKOL_API_IMPL void sgl_setup(const sgl_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    memset(&_sgl, 0, sizeof(_sgl));
+    _sgl.init_cookie = _SGL_INIT_COOKIE;
+    /* a new serial invalidates the cached current context of all threads */
+    if (0 == ++_sgl_setup_count) {
+        ++_sgl_setup_count;
+    }
+    _sgl.setup_serial = _sgl_setup_count;
+    _sgl.desc = *desc;
+    _sgl.desc.context_pool_size = _sgl_def(_sgl.desc.context_pool_size, _SGL_DEFAULT_CONTEXT_POOL_SIZE);
+    _sgl.desc.pipeline_pool_size = _sgl_def(_sgl.desc.pipeline_pool_size, _SGL_DEFAULT_PIPELINE_POOL_SIZE);
+    _sgl.desc.display_list_pool_size = _sgl_def(_sgl.desc.display_list_pool_size, _SGL_DEFAULT_DISPLAY_LIST_POOL_SIZE);
+    _sgl.desc.max_vertices = _sgl_def(_sgl.desc.max_vertices, _SGL_DEFAULT_MAX_VERTICES);
+    _sgl.desc.max_commands = _sgl_def(_sgl.desc.max_commands, _SGL_DEFAULT_MAX_COMMANDS);
+    _sgl.desc.face_winding = _sgl_def(_sgl.desc.face_winding, SG_FACEWINDING_CCW);
+
+    /* allocate pools */
+    _sgl_setup_pipeline_pool(&_sgl.desc);
+    _sgl_setup_display_list_pool(&_sgl.desc);
+    _sgl_setup_context_pool(&_sgl.desc);
+
+    /* create sokol-gfx resource objects which are shared by all contexts */
+    sg_push_debug_group("sokol-gl");
 
     uint32_t pixels[64];
     for (int i = 0; i < 64; i++) {
@@ -2685,7 +3969,6 @@ SOKOL_API_IMPL void sgl_setup(const sgl_desc_t* desc) {
     img_desc.label = "sgl-default-texture";
     _sgl.def_img = sg_make_image(&img_desc);
     SOKOL_ASSERT(SG_INVALID_ID != _sgl.def_img.id);
-    _sgl.cur_img = _sgl.def_img;
 
     sg_shader_desc shd_desc;
     memset(&shd_desc, 0, sizeof(shd_desc));
@@ -2745,35 +4028,36 @@ SOKOL_API_IMPL void sgl_setup(const sgl_desc_t* desc) {
         shd_desc.fs.byte_code = _sgl_fs_bytecode_wgpu;
         shd_desc.fs.byte_code_size = sizeof(_sgl_fs_bytecode_wgpu);
     #else
-        shd_desc.vs.source = _sgl_vs_src_dummy;
-        shd_desc.fs.source = _sgl_fs_src_dummy;
+        shd_desc.vs.source = _sgl_vs_source_dummy;
+        shd_desc.fs.source = _sgl_fs_source_dummy;
     #endif
     _sgl.shd = sg_make_shader(&shd_desc);
     SOKOL_ASSERT(SG_INVALID_ID != _sgl.shd.id);
-
-    /* create default pipeline object */
-    sg_pipeline_desc def_pip_desc;
-    memset(&def_pip_desc, 0, sizeof(def_pip_desc));
-    def_pip_desc.depth_stencil.depth_write_enabled = true;
-    _sgl.def_pip = _sgl_make_pipeline(&def_pip_desc);
     sg_pop_debug_group();
 
-    /* default state */
-    _sgl.rgba = 0xFFFFFFFF;
-    for (int i = 0; i < SGL_NUM_MATRIXMODES; i++) {
-        _sgl_identity(&_sgl.matrix_stack[i][0]);
-    }
-    _sgl.pip_stack[0] = _sgl.def_pip;
-    _sgl.matrix_dirty = true;
+    /* create the default context */
+    sgl_context_desc_t ctx_desc;
+    memset(&ctx_desc, 0, sizeof(ctx_desc));
+    ctx_desc.max_vertices = _sgl.desc.max_vertices;
+    ctx_desc.max_commands = _sgl.desc.max_commands;
+    ctx_desc.color_format = _sgl.desc.color_format;
+    ctx_desc.depth_format = _sgl.desc.depth_format;
+    ctx_desc.sample_count = _sgl.desc.sample_count;
+    ctx_desc.pretransform = _sgl.desc.pretransform;
+    ctx_desc.growable = _sgl.desc.growable;
+    ctx_desc.vertex_layout = _sgl.desc.vertex_layout;
+    _sgl.def_ctx_id = _sgl_make_context(&ctx_desc);
+    SOKOL_ASSERT(SG_INVALID_ID != _sgl.def_ctx_id.id);
+    memset(&_sgl_thread, 0, sizeof(_sgl_thread));
 }
 
 SOKOL_API_IMPL void sgl_shutdown(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_FREE(_sgl.vertices); _sgl.vertices = 0;
-    SOKOL_FREE(_sgl.uniforms); _sgl.uniforms = 0;
-    SOKOL_FREE(_sgl.commands); _sgl.commands = 0;
+    for (int i = 0; i < _sgl.context_pool.pool.size; i++) {
+        _sgl_context_t* ctx = &_sgl.context_pool.contexts[i];
+        _sgl_destroy_context(_sgl_make_ctx_id(ctx->slot.id));
+    }
     sg_push_debug_group("sokol-gl");
-    sg_destroy_buffer(_sgl.vbuf);
     sg_destroy_image(_sgl.def_img);
     sg_destroy_shader(_sgl.shd);
     for (int i = 0; i < _sgl.pip_pool.pool.size; i++) {
@@ -2781,12 +4065,48 @@ SOKOL_API_IMPL void sgl_shutdown(void) {
         _sgl_destroy_pipeline(_sgl_make_pip_id(pip->slot.id));
     }
     sg_pop_debug_group();
+    _sgl_discard_context_pool();
+    _sgl_discard_display_list_pool();
     _sgl_discard_pipeline_pool();
+    memset(&_sgl_thread, 0, sizeof(_sgl_thread));
+    _sgl.setup_serial = 0;
     _sgl.init_cookie = 0;
 }
 
 SOKOL_API_IMPL sgl_error_t sgl_error(void) {
-    return _sgl.error;
+    _sgl_context_t* ctx = _sgl_lookup_context(_sgl_cur_ctx_id());
+    return ctx ? ctx->error : SGL_ERROR_NO_CONTEXT;
+}
+
+SOKOL_API_IMPL sgl_error_t sgl_context_error(sgl_context ctx_id) {
+    const _sgl_context_t* ctx = _sgl_lookup_context(ctx_id.id);
+    return ctx ? ctx->error : SGL_ERROR_NO_CONTEXT;
+}
+
+static sgl_stats_t _sgl_stats(const _sgl_context_t* ctx) {
+    sgl_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    if (ctx) {
+        stats.num_vertices = ctx->num_vertices;
+        stats.num_uniforms = ctx->num_uniforms;
+        stats.num_commands = ctx->num_commands;
+        /* include what has been recorded since the last sgl_draw() */
+        stats.max_used_vertices = (ctx->cur_vertex > ctx->max_used_vertices) ? ctx->cur_vertex : ctx->max_used_vertices;
+        stats.max_used_uniforms = (ctx->cur_uniform > ctx->max_used_uniforms) ? ctx->cur_uniform : ctx->max_used_uniforms;
+        stats.max_used_commands = (ctx->cur_command > ctx->max_used_commands) ? ctx->cur_command : ctx->max_used_commands;
+        stats.max_frame_vertices = ctx->max_frame_vertices;
+    }
+    return stats;
+}
+
+SOKOL_API_IMPL sgl_stats_t sgl_stats(void) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    return _sgl_stats(_sgl_lookup_context(_sgl_cur_ctx_id()));
+}
+
+SOKOL_API_IMPL sgl_stats_t sgl_context_stats(sgl_context ctx_id) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    return _sgl_stats(_sgl_lookup_context(ctx_id.id));
 }
 
 SOKOL_API_IMPL float sgl_rad(float deg) {
@@ -2797,9 +4117,69 @@ SOKOL_API_IMPL float sgl_deg(float rad) {
     return (rad * 180.0f) / (float)M_PI;
 }
 
+SOKOL_API_IMPL sgl_context sgl_make_context(const sgl_context_desc_t* desc) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    return _sgl_make_context(desc);
+}
+
+SOKOL_API_IMPL void sgl_destroy_context(sgl_context ctx_id) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    if (ctx_id.id == _sgl.def_ctx_id.id) {
+        SOKOL_LOG("sokol_gl.h: cannot destroy the default context");
+        return;
+    }
+    _sgl_destroy_context(ctx_id);
+}
+
+SOKOL_API_IMPL void sgl_set_context(sgl_context ctx_id) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    _sgl_thread.ctx_selected = true;
+    _sgl_thread.no_ctx_logged = false;
+    _sgl_thread.ctx_id = ctx_id;
+    _sgl_thread.cached_ctx = 0;
+}
+
+SOKOL_API_IMPL sgl_context sgl_get_context(void) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    const _sgl_context_t* ctx = _sgl_lookup_context(_sgl_cur_ctx_id());
+    if (ctx) {
+        return _sgl_make_ctx_id(ctx->slot.id);
+    }
+    else {
+        return _sgl_make_ctx_id(SG_INVALID_ID);
+    }
+}
+
+SOKOL_API_IMPL sgl_context sgl_default_context(void) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    return _sgl.def_ctx_id;
+}
+
+SOKOL_API_IMPL void sgl_merge_context(sgl_context ctx_id) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    _sgl_context_t* dst = _sgl_cur_context();
+    _sgl_context_t* src = _sgl_lookup_context(ctx_id.id);
+    if (dst && src && (dst != src)) {
+        _sgl_merge_context(dst, src);
+    }
+}
+
 SOKOL_API_IMPL sgl_pipeline sgl_make_pipeline(const sg_pipeline_desc* desc) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    return _sgl_make_pipeline(desc);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return _sgl_make_pip_id(SG_INVALID_ID);
+    }
+    return _sgl_make_pipeline(desc, ctx);
+}
+
+SOKOL_API_IMPL sgl_pipeline sgl_context_make_pipeline(sgl_context ctx_id, const sg_pipeline_desc* desc) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    const _sgl_context_t* ctx = _sgl_lookup_context(ctx_id.id);
+    if (!ctx) {
+        return _sgl_make_pip_id(SG_INVALID_ID);
+    }
+    return _sgl_make_pipeline(desc, ctx);
 }
 
 SOKOL_API_IMPL void sgl_destroy_pipeline(sgl_pipeline pip_id) {
@@ -2809,56 +4189,80 @@ SOKOL_API_IMPL void sgl_destroy_pipeline(sgl_pipeline pip_id) {
 
 SOKOL_API_IMPL void sgl_load_pipeline(sgl_pipeline pip_id) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT((_sgl.pip_tos >= 0) && (_sgl.pip_tos < _SGL_MAX_STACK_DEPTH));
-    _sgl.pip_stack[_sgl.pip_tos] = pip_id;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT((ctx->pip_tos >= 0) && (ctx->pip_tos < _SGL_MAX_STACK_DEPTH));
+    ctx->pip_stack[ctx->pip_tos] = pip_id;
 }
 
 SOKOL_API_IMPL void sgl_default_pipeline(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT((_sgl.pip_tos >= 0) && (_sgl.pip_tos < _SGL_MAX_STACK_DEPTH));
-    _sgl.pip_stack[_sgl.pip_tos] = _sgl.def_pip;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT((ctx->pip_tos >= 0) && (ctx->pip_tos < _SGL_MAX_STACK_DEPTH));
+    ctx->pip_stack[ctx->pip_tos] = ctx->def_pip;
 }
 
 SOKOL_API_IMPL void sgl_push_pipeline(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    if (_sgl.pip_tos < (_SGL_MAX_STACK_DEPTH - 1)) {
-        _sgl.pip_tos++;
-        _sgl.pip_stack[_sgl.pip_tos] = _sgl.pip_stack[_sgl.pip_tos-1];
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    if (ctx->pip_tos < (_SGL_MAX_STACK_DEPTH - 1)) {
+        ctx->pip_tos++;
+        ctx->pip_stack[ctx->pip_tos] = ctx->pip_stack[ctx->pip_tos-1];
     }
     else {
-        _sgl.error = SGL_ERROR_STACK_OVERFLOW;
+        ctx->error = SGL_ERROR_STACK_OVERFLOW;
     }
 }
 
 SOKOL_API_IMPL void sgl_pop_pipeline(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    if (_sgl.pip_tos > 0) {
-        _sgl.pip_tos--;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    if (ctx->pip_tos > 0) {
+        ctx->pip_tos--;
     }
     else {
-        _sgl.error = SGL_ERROR_STACK_UNDERFLOW;
+        ctx->error = SGL_ERROR_STACK_UNDERFLOW;
     }
 }
 
 SOKOL_API_IMPL void sgl_defaults(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl.u = 0.0f; _sgl.v = 0.0f;
-    _sgl.rgba = 0xFFFFFFFF;
-    _sgl.texturing_enabled = false;
-    _sgl.cur_img = _sgl.def_img;
-    sgl_default_pipeline();
-    _sgl_identity(_sgl_matrix_texture());
-    _sgl_identity(_sgl_matrix_modelview());
-    _sgl_identity(_sgl_matrix_projection());
-    _sgl.cur_matrix_mode = SGL_MATRIXMODE_MODELVIEW;
-    _sgl.matrix_dirty = true;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    ctx->u = 0.0f; ctx->v = 0.0f;
+    ctx->rgba = 0xFFFFFFFF;
+    ctx->texturing_enabled = false;
+    ctx->cur_img = _sgl.def_img;
+    ctx->pip_stack[ctx->pip_tos] = ctx->def_pip;
+    _sgl_identity(_sgl_matrix_texture(ctx));
+    _sgl_identity(_sgl_matrix_modelview(ctx));
+    _sgl_identity(_sgl_matrix_projection(ctx));
+    ctx->cur_matrix_mode = SGL_MATRIXMODE_MODELVIEW;
+    ctx->matrix_dirty = true;
 }
 
 SOKOL_API_IMPL void sgl_viewport(int x, int y, int w, int h, bool origin_top_left) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl_command_t* cmd = _sgl_next_command();
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    _sgl_command_t* cmd = _sgl_next_command(ctx);
     if (cmd) {
         cmd->cmd = SGL_COMMAND_VIEWPORT;
         cmd->args.viewport.x = x;
@@ -2871,8 +4275,12 @@ SOKOL_API_IMPL void sgl_viewport(int x, int y, int w, int h, bool origin_top_lef
 
 SOKOL_API_IMPL void sgl_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl_command_t* cmd = _sgl_next_command();
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    _sgl_command_t* cmd = _sgl_next_command(ctx);
     if (cmd) {
         cmd->cmd = SGL_COMMAND_SCISSOR_RECT;
         cmd->args.scissor_rect.x = x;
@@ -2885,87 +4293,132 @@ SOKOL_API_IMPL void sgl_scissor_rect(int x, int y, int w, int h, bool origin_top
 
 SOKOL_API_IMPL void sgl_enable_texture(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl.texturing_enabled = true;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    ctx->texturing_enabled = true;
 }
 
 SOKOL_API_IMPL void sgl_disable_texture(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl.texturing_enabled = false;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    ctx->texturing_enabled = false;
 }
 
 SOKOL_API_IMPL void sgl_texture(sg_image img) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
     if (SG_INVALID_ID != img.id) {
-        _sgl.cur_img = img;
+        ctx->cur_img = img;
     }
     else {
-        _sgl.cur_img = _sgl.def_img;
+        ctx->cur_img = _sgl.def_img;
     }
 }
 
 SOKOL_API_IMPL void sgl_begin_points(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl_begin(SGL_PRIMITIVETYPE_POINTS);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    _sgl_begin(ctx, SGL_PRIMITIVETYPE_POINTS);
 }
 
 SOKOL_API_IMPL void sgl_begin_lines(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl_begin(SGL_PRIMITIVETYPE_LINES);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    _sgl_begin(ctx, SGL_PRIMITIVETYPE_LINES);
 }
 
 SOKOL_API_IMPL void sgl_begin_line_strip(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl_begin(SGL_PRIMITIVETYPE_LINE_STRIP);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    _sgl_begin(ctx, SGL_PRIMITIVETYPE_LINE_STRIP);
 }
 
 SOKOL_API_IMPL void sgl_begin_triangles(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl_begin(SGL_PRIMITIVETYPE_TRIANGLES);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    _sgl_begin(ctx, SGL_PRIMITIVETYPE_TRIANGLES);
 }
 
 SOKOL_API_IMPL void sgl_begin_triangle_strip(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl_begin(SGL_PRIMITIVETYPE_TRIANGLE_STRIP);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    _sgl_begin(ctx, SGL_PRIMITIVETYPE_TRIANGLE_STRIP);
+}
+
+SOKOL_API_IMPL void sgl_begin_triangle_fan(void) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    _sgl_begin(ctx, SGL_PRIMITIVETYPE_TRIANGLE_FAN);
 }
 
 SOKOL_API_IMPL void sgl_begin_quads(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(!_sgl.in_begin);
-    _sgl_begin(SGL_PRIMITIVETYPE_QUADS);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin);
+    _sgl_begin(ctx, SGL_PRIMITIVETYPE_QUADS);
 }
 
 SOKOL_API_IMPL void sgl_end(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT(_sgl.in_begin);
-    SOKOL_ASSERT(_sgl.cur_vertex >= _sgl.base_vertex);
-    _sgl.in_begin = false;
-    bool matrix_dirty = _sgl.matrix_dirty;
-    if (matrix_dirty) {
-        _sgl.matrix_dirty = false;
-        _sgl_uniform_t* uni = _sgl_next_uniform();
-        if (uni) {
-            _sgl_matmul4(&uni->mvp, _sgl_matrix_projection(), _sgl_matrix_modelview());
-            uni->tm = *_sgl_matrix_texture();
-        }
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
     }
+    SOKOL_ASSERT(ctx->in_begin);
+    SOKOL_ASSERT(ctx->cur_vertex >= ctx->base_vertex);
+    ctx->in_begin = false;
+    const bool matrix_dirty = _sgl_update_uniform(ctx, ctx->cpu_transform);
+    ctx->cpu_transform = false;
     /* check if command can be merged with previous command */
-    sg_pipeline pip = _sgl_get_pipeline(_sgl.pip_stack[_sgl.pip_tos], _sgl.cur_prim_type);
-    sg_image img = _sgl.texturing_enabled ? _sgl.cur_img : _sgl.def_img;
-    _sgl_command_t* prev_cmd = _sgl_prev_command();
+    sg_pipeline pip = _sgl_get_pipeline(ctx->pip_stack[ctx->pip_tos], ctx->cur_prim_type);
+    sg_image img = ctx->texturing_enabled ? ctx->cur_img : _sgl.def_img;
+    _sgl_command_t* prev_cmd = _sgl_prev_command(ctx);
     bool merge_cmd = false;
     if (prev_cmd) {
         if ((prev_cmd->cmd == SGL_COMMAND_DRAW) &&
-            (_sgl.cur_prim_type != SGL_PRIMITIVETYPE_LINE_STRIP) &&
-            (_sgl.cur_prim_type != SGL_PRIMITIVETYPE_TRIANGLE_STRIP) &&
+            (ctx->cur_prim_type != SGL_PRIMITIVETYPE_LINE_STRIP) &&
+            (ctx->cur_prim_type != SGL_PRIMITIVETYPE_TRIANGLE_STRIP) &&
+            (ctx->cur_prim_type != SGL_PRIMITIVETYPE_TRIANGLE_FAN) &&
             !matrix_dirty &&
+            ((prev_cmd->args.draw.base_vertex + prev_cmd->args.draw.num_vertices) == ctx->base_vertex) &&
             (prev_cmd->args.draw.img.id == img.id) &&
             (prev_cmd->args.draw.pip.id == pip.id))
         {
@@ -2974,314 +4427,797 @@ SOKOL_API_IMPL void sgl_end(void) {
     }
     if (merge_cmd) {
         /* draw command can be merged with the previous command */
-        prev_cmd->args.draw.num_vertices += _sgl.cur_vertex - _sgl.base_vertex;
+        prev_cmd->args.draw.num_vertices += ctx->cur_vertex - ctx->base_vertex;
     }
     else {
         /* append a new draw command */
-        _sgl_command_t* cmd = _sgl_next_command();
+        _sgl_command_t* cmd = _sgl_next_command(ctx);
         if (cmd) {
-            SOKOL_ASSERT(_sgl.cur_uniform > 0);
+            SOKOL_ASSERT(ctx->cur_uniform > 0);
             cmd->cmd = SGL_COMMAND_DRAW;
             cmd->args.draw.img = img;
-            cmd->args.draw.pip = _sgl_get_pipeline(_sgl.pip_stack[_sgl.pip_tos], _sgl.cur_prim_type);
-            cmd->args.draw.base_vertex = _sgl.base_vertex;
-            cmd->args.draw.num_vertices = _sgl.cur_vertex - _sgl.base_vertex;
-            cmd->args.draw.uniform_index = _sgl.cur_uniform - 1;
+            cmd->args.draw.pip = _sgl_get_pipeline(ctx->pip_stack[ctx->pip_tos], ctx->cur_prim_type);
+            cmd->args.draw.prim_type = ctx->cur_prim_type;
+            cmd->args.draw.base_vertex = ctx->base_vertex;
+            cmd->args.draw.num_vertices = ctx->cur_vertex - ctx->base_vertex;
+            cmd->args.draw.uniform_index = ctx->cur_uniform - 1;
         }
     }
 }
 
 SOKOL_API_IMPL void sgl_t2f(float u, float v) {
-    _sgl.u = u; _sgl.v = v;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->u = u; ctx->v = v;
 }
 
 SOKOL_API_IMPL void sgl_c3f(float r, float g, float b) {
-    _sgl.rgba = _sgl_pack_rgbaf(r, g, b, 1.0f);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->rgba = _sgl_pack_rgbaf(r, g, b, 1.0f);
 }
 
 SOKOL_API_IMPL void sgl_c4f(float r, float g, float b, float a) {
-    _sgl.rgba = _sgl_pack_rgbaf(r, g, b, a);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->rgba = _sgl_pack_rgbaf(r, g, b, a);
 }
 
 SOKOL_API_IMPL void sgl_c3b(uint8_t r, uint8_t g, uint8_t b) {
-    _sgl.rgba = _sgl_pack_rgbab(r, g, b, 255);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->rgba = _sgl_pack_rgbab(r, g, b, 255);
 }
 
 SOKOL_API_IMPL void sgl_c4b(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-    _sgl.rgba = _sgl_pack_rgbab(r, g, b, a);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->rgba = _sgl_pack_rgbab(r, g, b, a);
 }
 
 SOKOL_API_IMPL void sgl_c1i(uint32_t rgba) {
-    _sgl.rgba = rgba;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->rgba = rgba;
 }
 
 SOKOL_API_IMPL void sgl_v2f(float x, float y) {
-    _sgl_vtx(x, y, 0.0f, _sgl.u, _sgl.v, _sgl.rgba);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, ctx->u, ctx->v, ctx->rgba);
 }
 
 SOKOL_API_IMPL void sgl_v3f(float x, float y, float z) {
-    _sgl_vtx(x, y, z, _sgl.u, _sgl.v, _sgl.rgba);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, ctx->u, ctx->v, ctx->rgba);
 }
 
 SOKOL_API_IMPL void sgl_v2f_t2f(float x, float y, float u, float v) {
-    _sgl_vtx(x, y, 0.0f, u, v, _sgl.rgba);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, u, v, ctx->rgba);
 }
 
 SOKOL_API_IMPL void sgl_v3f_t2f(float x, float y, float z, float u, float v) {
-    _sgl_vtx(x, y, z, u, v, _sgl.rgba);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, u, v, ctx->rgba);
 }
 
 SOKOL_API_IMPL void sgl_v2f_c3f(float x, float y, float r, float g, float b) {
-    _sgl_vtx(x, y, 0.0f, _sgl.u, _sgl.v, _sgl_pack_rgbaf(r, g, b, 1.0f));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, ctx->u, ctx->v, _sgl_pack_rgbaf(r, g, b, 1.0f));
 }
 
 SOKOL_API_IMPL void sgl_v2f_c3b(float x, float y, uint8_t r, uint8_t g, uint8_t b) {
-    _sgl_vtx(x, y, 0.0f, _sgl.u, _sgl.v, _sgl_pack_rgbab(r, g, b, 255));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, ctx->u, ctx->v, _sgl_pack_rgbab(r, g, b, 255));
 }
 
 SOKOL_API_IMPL void sgl_v2f_c4f(float x, float y, float r, float g, float b, float a) {
-    _sgl_vtx(x, y, 0.0f, _sgl.u, _sgl.v, _sgl_pack_rgbaf(r, g, b, a));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, ctx->u, ctx->v, _sgl_pack_rgbaf(r, g, b, a));
 }
 
 SOKOL_API_IMPL void sgl_v2f_c4b(float x, float y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-    _sgl_vtx(x, y, 0.0f, _sgl.u, _sgl.v, _sgl_pack_rgbab(r, g, b, a));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, ctx->u, ctx->v, _sgl_pack_rgbab(r, g, b, a));
 }
 
 SOKOL_API_IMPL void sgl_v2f_c1i(float x, float y, uint32_t rgba) {
-    _sgl_vtx(x, y, 0.0f, _sgl.u, _sgl.v, rgba);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, ctx->u, ctx->v, rgba);
 }
 
 SOKOL_API_IMPL void sgl_v3f_c3f(float x, float y, float z, float r, float g, float b) {
-    _sgl_vtx(x, y, z, _sgl.u, _sgl.v, _sgl_pack_rgbaf(r, g, b, 1.0f));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, ctx->u, ctx->v, _sgl_pack_rgbaf(r, g, b, 1.0f));
 }
 
 SOKOL_API_IMPL void sgl_v3f_c3b(float x, float y, float z, uint8_t r, uint8_t g, uint8_t b) {
-    _sgl_vtx(x, y, z, _sgl.u, _sgl.v, _sgl_pack_rgbab(r, g, b, 255));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, ctx->u, ctx->v, _sgl_pack_rgbab(r, g, b, 255));
 }
 
 SOKOL_API_IMPL void sgl_v3f_c4f(float x, float y, float z, float r, float g, float b, float a) {
-    _sgl_vtx(x, y, z, _sgl.u, _sgl.v, _sgl_pack_rgbaf(r, g, b, a));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, ctx->u, ctx->v, _sgl_pack_rgbaf(r, g, b, a));
 }
 
 SOKOL_API_IMPL void sgl_v3f_c4b(float x, float y, float z, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-    _sgl_vtx(x, y, z, _sgl.u, _sgl.v, _sgl_pack_rgbab(r, g, b, a));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, ctx->u, ctx->v, _sgl_pack_rgbab(r, g, b, a));
 }
 
 SOKOL_API_IMPL void sgl_v3f_c1i(float x, float y, float z, uint32_t rgba) {
-    _sgl_vtx(x, y, z, _sgl.u, _sgl.v, rgba);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, ctx->u, ctx->v, rgba);
 }
 
 SOKOL_API_IMPL void sgl_v2f_t2f_c3f(float x, float y, float u, float v, float r, float g, float b) {
-    _sgl_vtx(x, y, 0.0f, u, v, _sgl_pack_rgbaf(r, g, b, 1.0f));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, u, v, _sgl_pack_rgbaf(r, g, b, 1.0f));
 }
 
 SOKOL_API_IMPL void sgl_v2f_t2f_c3b(float x, float y, float u, float v, uint8_t r, uint8_t g, uint8_t b) {
-    _sgl_vtx(x, y, 0.0f, u, v, _sgl_pack_rgbab(r, g, b, 255));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, u, v, _sgl_pack_rgbab(r, g, b, 255));
 }
 
 SOKOL_API_IMPL void sgl_v2f_t2f_c4f(float x, float y, float u, float v, float r, float g, float b, float a) {
-    _sgl_vtx(x, y, 0.0f, u, v, _sgl_pack_rgbaf(r, g, b, a));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, u, v, _sgl_pack_rgbaf(r, g, b, a));
 }
 
 SOKOL_API_IMPL void sgl_v2f_t2f_c4b(float x, float y, float u, float v, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-    _sgl_vtx(x, y, 0.0f, u, v, _sgl_pack_rgbab(r, g, b, a));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, u, v, _sgl_pack_rgbab(r, g, b, a));
 }
 
 SOKOL_API_IMPL void sgl_v2f_t2f_c1i(float x, float y, float u, float v, uint32_t rgba) {
-    _sgl_vtx(x, y, 0.0f, u, v, rgba);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, 0.0f, u, v, rgba);
 }
 
 SOKOL_API_IMPL void sgl_v3f_t2f_c3f(float x, float y, float z, float u, float v, float r, float g, float b) {
-    _sgl_vtx(x, y, z, u, v, _sgl_pack_rgbaf(r, g, b, 1.0f));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, u, v, _sgl_pack_rgbaf(r, g, b, 1.0f));
 }
 
 SOKOL_API_IMPL void sgl_v3f_t2f_c3b(float x, float y, float z, float u, float v, uint8_t r, uint8_t g, uint8_t b) {
-    _sgl_vtx(x, y, z, u, v, _sgl_pack_rgbab(r, g, b, 255));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, u, v, _sgl_pack_rgbab(r, g, b, 255));
 }
 
 SOKOL_API_IMPL void sgl_v3f_t2f_c4f(float x, float y, float z, float u, float v, float r, float g, float b, float a) {
-    _sgl_vtx(x, y, z, u, v, _sgl_pack_rgbaf(r, g, b, a));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, u, v, _sgl_pack_rgbaf(r, g, b, a));
 }
 
 SOKOL_API_IMPL void sgl_v3f_t2f_c4b(float x, float y, float z, float u, float v, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-    _sgl_vtx(x, y, z, u, v, _sgl_pack_rgbab(r, g, b, a));
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, u, v, _sgl_pack_rgbab(r, g, b, a));
 }
 
 SOKOL_API_IMPL void sgl_v3f_t2f_c1i(float x, float y, float z, float u, float v, uint32_t rgba) {
-    _sgl_vtx(x, y, z, u, v, rgba);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx(ctx, x, y, z, u, v, rgba);
+}
+
+SOKOL_API_IMPL void sgl_vertex_arrays(const sgl_vertex_arrays_t* arrays) {
+    SOKOL_ASSERT(arrays);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    _sgl_vtx_arrays(ctx, arrays);
 }
 
 SOKOL_API_IMPL void sgl_matrix_mode_modelview(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.cur_matrix_mode = SGL_MATRIXMODE_MODELVIEW;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->cur_matrix_mode = SGL_MATRIXMODE_MODELVIEW;
 }
 
 SOKOL_API_IMPL void sgl_matrix_mode_projection(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.cur_matrix_mode = SGL_MATRIXMODE_PROJECTION;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->cur_matrix_mode = SGL_MATRIXMODE_PROJECTION;
 }
 
 SOKOL_API_IMPL void sgl_matrix_mode_texture(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.cur_matrix_mode = SGL_MATRIXMODE_TEXTURE;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->cur_matrix_mode = SGL_MATRIXMODE_TEXTURE;
 }
 
 SOKOL_API_IMPL void sgl_load_identity(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    _sgl_identity(_sgl_matrix());
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    _sgl_identity(_sgl_matrix(ctx));
 }
 
 SOKOL_API_IMPL void sgl_load_matrix(const float m[16]) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    memcpy(&_sgl_matrix()->v[0][0], &m[0], 64);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    memcpy(&_sgl_matrix(ctx)->v[0][0], &m[0], 64);
 }
 
 SOKOL_API_IMPL void sgl_load_transpose_matrix(const float m[16]) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    _sgl_transpose(_sgl_matrix(), (const _sgl_matrix_t*) &m[0]);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    _sgl_transpose(_sgl_matrix(ctx), (const _sgl_matrix_t*) &m[0]);
 }
 
 SOKOL_API_IMPL void sgl_mult_matrix(const float m[16]) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
     const _sgl_matrix_t* m0  = (const _sgl_matrix_t*) &m[0];
-    _sgl_mul(_sgl_matrix(), m0);
+    _sgl_mul(_sgl_matrix(ctx), m0);
 }
 
 SOKOL_API_IMPL void sgl_mult_transpose_matrix(const float m[16]) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
     _sgl_matrix_t m0;
     _sgl_transpose(&m0, (const _sgl_matrix_t*) &m[0]);
-    _sgl_mul(_sgl_matrix(), &m0);
+    _sgl_mul(_sgl_matrix(ctx), &m0);
 }
 
 SOKOL_API_IMPL void sgl_rotate(float angle_rad, float x, float y, float z) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    _sgl_rotate(_sgl_matrix(), angle_rad, x, y, z);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    _sgl_rotate(_sgl_matrix(ctx), angle_rad, x, y, z);
 }
 
 SOKOL_API_IMPL void sgl_scale(float x, float y, float z) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    _sgl_scale(_sgl_matrix(), x, y, z);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    _sgl_scale(_sgl_matrix(ctx), x, y, z);
 }
 
 SOKOL_API_IMPL void sgl_translate(float x, float y, float z) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    _sgl_translate(_sgl_matrix(), x, y, z);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    _sgl_translate(_sgl_matrix(ctx), x, y, z);
 }
 
 SOKOL_API_IMPL void sgl_frustum(float l, float r, float b, float t, float n, float f) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    _sgl_frustum(_sgl_matrix(), l, r, b, t, n, f);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    _sgl_frustum(_sgl_matrix(ctx), l, r, b, t, n, f);
 }
 
 SOKOL_API_IMPL void sgl_ortho(float l, float r, float b, float t, float n, float f) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    _sgl_ortho(_sgl_matrix(), l, r, b, t, n, f);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    _sgl_ortho(_sgl_matrix(ctx), l, r, b, t, n, f);
 }
 
 SOKOL_API_IMPL void sgl_perspective(float fov_y, float aspect, float z_near, float z_far) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    _sgl_perspective(_sgl_matrix(), fov_y, aspect, z_near, z_far);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    _sgl_perspective(_sgl_matrix(ctx), fov_y, aspect, z_near, z_far);
 }
 
 SOKOL_API_IMPL void sgl_lookat(float eye_x, float eye_y, float eye_z, float center_x, float center_y, float center_z, float up_x, float up_y, float up_z) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    _sgl.matrix_dirty = true;
-    _sgl_lookat(_sgl_matrix(), eye_x, eye_y, eye_z, center_x, center_y, center_z, up_x, up_y, up_z);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    ctx->matrix_dirty = true;
+    _sgl_lookat(_sgl_matrix(ctx), eye_x, eye_y, eye_z, center_x, center_y, center_z, up_x, up_y, up_z);
 }
 
 SOKOL_GL_API_DECL void sgl_push_matrix(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT((_sgl.cur_matrix_mode >= 0) && (_sgl.cur_matrix_mode < SGL_NUM_MATRIXMODES));
-    _sgl.matrix_dirty = true;
-    if (_sgl.matrix_tos[_sgl.cur_matrix_mode] < (_SGL_MAX_STACK_DEPTH - 1)) {
-        const _sgl_matrix_t* src = _sgl_matrix();
-        _sgl.matrix_tos[_sgl.cur_matrix_mode]++;
-        _sgl_matrix_t* dst = _sgl_matrix();
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT((ctx->cur_matrix_mode >= 0) && (ctx->cur_matrix_mode < SGL_NUM_MATRIXMODES));
+    ctx->matrix_dirty = true;
+    if (ctx->matrix_tos[ctx->cur_matrix_mode] < (_SGL_MAX_STACK_DEPTH - 1)) {
+        const _sgl_matrix_t* src = _sgl_matrix(ctx);
+        ctx->matrix_tos[ctx->cur_matrix_mode]++;
+        _sgl_matrix_t* dst = _sgl_matrix(ctx);
         *dst = *src;
     }
     else {
-        _sgl.error = SGL_ERROR_STACK_OVERFLOW;
+        ctx->error = SGL_ERROR_STACK_OVERFLOW;
     }
 }
 
 SOKOL_GL_API_DECL void sgl_pop_matrix(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    SOKOL_ASSERT((_sgl.cur_matrix_mode >= 0) && (_sgl.cur_matrix_mode < SGL_NUM_MATRIXMODES));
-    _sgl.matrix_dirty = true;
-    if (_sgl.matrix_tos[_sgl.cur_matrix_mode] > 0) {
-        _sgl.matrix_tos[_sgl.cur_matrix_mode]--;
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT((ctx->cur_matrix_mode >= 0) && (ctx->cur_matrix_mode < SGL_NUM_MATRIXMODES));
+    ctx->matrix_dirty = true;
+    if (ctx->matrix_tos[ctx->cur_matrix_mode] > 0) {
+        ctx->matrix_tos[ctx->cur_matrix_mode]--;
     }
     else {
-        _sgl.error = SGL_ERROR_STACK_UNDERFLOW;
+        ctx->error = SGL_ERROR_STACK_UNDERFLOW;
     }
 }
 
-/* this renders the accumulated draw commands via sokol-gfx */
-SOKOL_API_IMPL void sgl_draw(void) {
+SOKOL_API_IMPL void sgl_begin_display_list(void) {
     SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
-    if ((_sgl.error == SGL_NO_ERROR) && (_sgl.cur_vertex > 0) && (_sgl.cur_command > 0)) {
-        uint32_t cur_pip_id = SG_INVALID_ID;
-        uint32_t cur_img_id = SG_INVALID_ID;
-        int cur_uniform_index = -1;
-        sg_push_debug_group("sokol-gl");
-        sg_update_buffer(_sgl.vbuf, _sgl.vertices, _sgl.cur_vertex * sizeof(_sgl_vertex_t));
-        _sgl.bind.vertex_buffers[0] = _sgl.vbuf;
-        for (int i = 0; i < _sgl.cur_command; i++) {
-            const _sgl_command_t* cmd = &_sgl.commands[i];
-            switch (cmd->cmd) {
-                case SGL_COMMAND_VIEWPORT:
-                    {
-                        const _sgl_viewport_args_t* args = &cmd->args.viewport;
-                        sg_apply_viewport(args->x, args->y, args->w, args->h, args->origin_top_left);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin && !ctx->in_display_list);
+    ctx->in_display_list = true;
+    ctx->list_base_vertex = ctx->cur_vertex;
+    ctx->list_base_uniform = ctx->cur_uniform;
+    ctx->list_base_command = ctx->cur_command;
+    /* the recorded matrices are relative to the transform the list is called with */
+    for (int i = 0; i < SGL_NUM_MATRIXMODES; i++) {
+        ctx->list_saved_matrix[i] = ctx->matrix_stack[i][ctx->matrix_tos[i]];
+        _sgl_identity(&ctx->matrix_stack[i][ctx->matrix_tos[i]]);
+    }
+    ctx->matrix_dirty = true;
+}
+
+SOKOL_API_IMPL sgl_display_list sgl_end_display_list(void) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    sgl_display_list list_id = _sgl_make_list_id(SG_INVALID_ID);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return list_id;
+    }
+    SOKOL_ASSERT(!ctx->in_begin && ctx->in_display_list);
+    if (ctx->error == SGL_NO_ERROR) {
+        list_id = _sgl_alloc_display_list();
+    }
+    if (list_id.id != SG_INVALID_ID) {
+        _sgl_display_list_t* list = _sgl_lookup_display_list(list_id.id);
+        SOKOL_ASSERT(list);
+        list->ctx = _sgl_make_ctx_id(ctx->slot.id);
+        /* keep the vertices at the same alignment, quads must start at a multiple of 4 */
+        const int first_vertex = ctx->list_base_vertex & ~3;
+        const int num_vertices = ctx->cur_vertex - first_vertex;
+        const int num_uniforms = ctx->cur_uniform - ctx->list_base_uniform;
+        const int num_commands = ctx->cur_command - ctx->list_base_command;
+        if (num_uniforms > 0) {
+            list->uniforms = (_sgl_uniform_t*) SOKOL_MALLOC(num_uniforms * sizeof(_sgl_uniform_t));
+            SOKOL_ASSERT(list->uniforms);
+            memcpy(list->uniforms, &ctx->uniforms[ctx->list_base_uniform], num_uniforms * sizeof(_sgl_uniform_t));
+            list->num_uniforms = num_uniforms;
+        }
+        if (num_commands > 0) {
+            list->commands = (_sgl_command_t*) SOKOL_MALLOC(num_commands * sizeof(_sgl_command_t));
+            SOKOL_ASSERT(list->commands);
+            /* rebase the commands to the list's own vertex buffer and uniforms, drop empty draws */
+            for (int i = 0; i < num_commands; i++) {
+                _sgl_command_t cmd = ctx->commands[ctx->list_base_command + i];
+                if (cmd.cmd == SGL_COMMAND_DRAW) {
+                    if (cmd.args.draw.num_vertices == 0) {
+                        continue;
+                    }
+                    cmd.args.draw.base_vertex -= first_vertex;
+                    cmd.args.draw.uniform_index -= ctx->list_base_uniform;
+                    SOKOL_ASSERT((cmd.args.draw.uniform_index >= 0) && (cmd.args.draw.uniform_index < num_uniforms));
+                }
+                list->commands[list->num_commands++] = cmd;
+            }
+        }
+        if (ctx->cur_vertex > ctx->list_base_vertex) {
+            /* can't convert in place, the first vertices may still belong to the context */
+            void* vertices = &ctx->vertices[first_vertex];
+            if (ctx->desc.vertex_layout != SGL_VERTEXLAYOUT_DEFAULT) {
+                vertices = SOKOL_MALLOC((size_t)num_vertices * (size_t)ctx->vertex_size);
+                SOKOL_ASSERT(vertices);
+                _sgl_convert_vertices(ctx->desc.vertex_layout, &ctx->vertices[first_vertex], vertices, num_vertices);
+            }
+            sg_buffer_desc vbuf_desc;
+            memset(&vbuf_desc, 0, sizeof(vbuf_desc));
+            vbuf_desc.size = num_vertices * ctx->vertex_size;
+            vbuf_desc.type = SG_BUFFERTYPE_VERTEXBUFFER;
+            vbuf_desc.usage = SG_USAGE_IMMUTABLE;
+            vbuf_desc.content = vertices;
+            vbuf_desc.label = "sgl-display-list";
+            sg_push_debug_group("sokol-gl");
+            list->vbuf = sg_make_buffer(&vbuf_desc);
+            sg_pop_debug_group();
+            if (vertices != &ctx->vertices[first_vertex]) {
+                SOKOL_FREE(vertices);
+            }
+            list->num_vertices = num_vertices;
+        }
+        list->slot.state = SG_RESOURCESTATE_VALID;
+    }
+    else if (ctx->error == SGL_NO_ERROR) {
+        SOKOL_LOG("sokol_gl.h: display list pool exhausted!");
+    }
+    /* remove the recorded data from the context and restore the matrices */
+    _sgl_update_high_water_marks(ctx);
+    ctx->cur_vertex = ctx->list_base_vertex;
+    ctx->cur_uniform = ctx->list_base_uniform;
+    ctx->cur_command = ctx->list_base_command;
+    for (int i = 0; i < SGL_NUM_MATRIXMODES; i++) {
+        ctx->matrix_stack[i][ctx->matrix_tos[i]] = ctx->list_saved_matrix[i];
+    }
+    ctx->matrix_dirty = true;
+    ctx->in_display_list = false;
+    return list_id;
+}
+
+SOKOL_API_IMPL void sgl_call_display_list(sgl_display_list list_id) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (!ctx) {
+        return;
+    }
+    SOKOL_ASSERT(!ctx->in_begin && !ctx->in_display_list);
+    /* a display list which doesn't fit into the vertex buffer of a fixed-size context can never be rendered */
+    const _sgl_display_list_t* list = _sgl_lookup_display_list(list_id.id);
+    if (list && !ctx->desc.growable && (list->num_vertices > ctx->vbuf_num_vertices)) {
+        SOKOL_LOG("sokol_gl.h: sgl_call_display_list(): display list has more vertices than the context's vertex buffer");
+        return;
+    }
+    /* display lists are always rendered with the full modelview-projection matrix */
+    _sgl_update_uniform(ctx, false);
+    _sgl_command_t* cmd = _sgl_next_command(ctx);
+    if (cmd) {
+        SOKOL_ASSERT(ctx->cur_uniform > 0);
+        cmd->cmd = SGL_COMMAND_CALL_DISPLAY_LIST;
+        cmd->args.call_display_list.list = list_id;
+        cmd->args.call_display_list.uniform_index = ctx->cur_uniform - 1;
+    }
+}
+
+SOKOL_API_IMPL void sgl_destroy_display_list(sgl_display_list list_id) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    sg_push_debug_group("sokol-gl");
+    _sgl_destroy_display_list(list_id);
+    sg_pop_debug_group();
+}
+
+/* this renders a range of recorded draw commands via sokol-gfx, if xform
+   is not null, the commands belong to a display list which is transformed by xform
+*/
+static void _sgl_draw_commands(_sgl_context_t* ctx, const _sgl_command_t* cmds, int num_cmds, const _sgl_uniform_t* uniforms, sg_bindings* bind, const _sgl_uniform_t* xform) {
+    uint32_t cur_pip_id = SG_INVALID_ID;
+    uint32_t cur_img_id = SG_INVALID_ID;
+    int cur_uniform_index = -1;
+    const int vb_offset = bind->vertex_buffer_offsets[0];
+    for (int i = 0; i < num_cmds; i++) {
+        const _sgl_command_t* cmd = &cmds[i];
+        switch (cmd->cmd) {
+            case SGL_COMMAND_VIEWPORT:
+                {
+                    const _sgl_viewport_args_t* args = &cmd->args.viewport;
+                    sg_apply_viewport(args->x, args->y, args->w, args->h, args->origin_top_left);
+                }
+                break;
+            case SGL_COMMAND_SCISSOR_RECT:
+                {
+                    const _sgl_scissor_rect_args_t* args = &cmd->args.scissor_rect;
+                    sg_apply_scissor_rect(args->x, args->y, args->w, args->h, args->origin_top_left);
+                }
+                break;
+            case SGL_COMMAND_DRAW:
+                {
+                    const _sgl_draw_args_t* args = &cmd->args.draw;
+                    const bool indexed = (args->prim_type == SGL_PRIMITIVETYPE_QUADS) || (args->prim_type == SGL_PRIMITIVETYPE_TRIANGLE_FAN);
+                    if (args->pip.id != cur_pip_id) {
+                        sg_apply_pipeline(args->pip);
+                        cur_pip_id = args->pip.id;
+                        if (indexed) {
+                            bind->index_buffer = ctx->ibuf;
+                        }
+                        else {
+                            bind->index_buffer.id = SG_INVALID_ID;
+                        }
+                        /* when pipeline changes, also need to re-apply uniforms and bindings */
+                        cur_img_id = SG_INVALID_ID;
+                        cur_uniform_index = -1;
                     }
-                    break;
-                case SGL_COMMAND_SCISSOR_RECT:
-                    {
-                        const _sgl_scissor_rect_args_t* args = &cmd->args.scissor_rect;
-                        sg_apply_scissor_rect(args->x, args->y, args->w, args->h, args->origin_top_left);
+                    if (args->prim_type == SGL_PRIMITIVETYPE_TRIANGLE_FAN) {
+                        /* the fan indices start at vertex 0, so move the vertex buffer offset to the fan */
+                        bind->fs_images[0] = args->img;
+                        bind->vertex_buffer_offsets[0] = vb_offset + args->base_vertex * ctx->vertex_size;
+                        sg_apply_bindings(bind);
+                        bind->vertex_buffer_offsets[0] = vb_offset;
+                        cur_img_id = SG_INVALID_ID;
                     }
-                    break;
-                case SGL_COMMAND_DRAW:
-                    {
-                        const _sgl_draw_args_t* args = &cmd->args.draw;
-                        if (args->pip.id != cur_pip_id) {
-                            sg_apply_pipeline(args->pip);
-                            cur_pip_id = args->pip.id;
-                            /* when pipeline changes, also need to re-apply uniforms and bindings */
-                            cur_img_id = SG_INVALID_ID;
-                            cur_uniform_index = -1;
+                    else if (cur_img_id != args->img.id) {
+                        bind->fs_images[0] = args->img;
+                        sg_apply_bindings(bind);
+                        cur_img_id = args->img.id;
+                    }
+                    if (cur_uniform_index != args->uniform_index) {
+                        if (xform) {
+                            _sgl_uniform_t uni;
+                            _sgl_matmul4(&uni.mvp, &xform->mvp, &uniforms[args->uniform_index].mvp);
+                            _sgl_matmul4(&uni.tm, &xform->tm, &uniforms[args->uniform_index].tm);
+                            sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &uni, sizeof(_sgl_uniform_t));
                         }
-                        if (cur_img_id != args->img.id) {
-                            _sgl.bind.fs_images[0] = args->img;
-                            sg_apply_bindings(&_sgl.bind);
-                            cur_img_id = args->img.id;
+                        else {
+                            sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &uniforms[args->uniform_index], sizeof(_sgl_uniform_t));
                         }
-                        if (cur_uniform_index != args->uniform_index) {
-                            sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &_sgl.uniforms[args->uniform_index], sizeof(_sgl_uniform_t));
-                            cur_uniform_index = args->uniform_index;
+                        cur_uniform_index = args->uniform_index;
+                    }
+                    /* FIXME: what if number of vertices doesn't match the primitive type? */
+                    int base_element = args->base_vertex;
+                    int num_elements = args->num_vertices;
+                    if (args->prim_type == SGL_PRIMITIVETYPE_QUADS) {
+                        SOKOL_ASSERT((args->base_vertex & 3) == 0);
+                        base_element = (args->base_vertex / 4) * 6;
+                        num_elements = (args->num_vertices / 4) * 6;
+                    }
+                    else if (args->prim_type == SGL_PRIMITIVETYPE_TRIANGLE_FAN) {
+                        base_element = ctx->fan_base_element;
+                        num_elements = (args->num_vertices > 2) ? (args->num_vertices - 2) * 3 : 0;
+                    }
+                    if (num_elements > 0) {
+                        sg_draw(base_element, num_elements, 1);
+                    }
+                }
+                break;
+            case SGL_COMMAND_CALL_DISPLAY_LIST:
+                {
+                    /* display lists can't be nested, so this recurses at most once */
+                    SOKOL_ASSERT(0 == xform);
+                    const _sgl_call_display_list_args_t* args = &cmd->args.call_display_list;
+                    _sgl_display_list_t* list = _sgl_lookup_display_list(args->list.id);
+                    /* display lists may come from a compatible context which was merged into this context,
+                       and in a growable context the index buffer may not cover the display list until the next frame
+                    */
+                    const _sgl_context_t* list_ctx = list ? _sgl_lookup_context(list->ctx.id) : 0;
+                    const bool compatible = list_ctx && ((list_ctx == ctx) || _sgl_contexts_compatible(list_ctx, ctx));
+                    if (compatible && (list->num_vertices > ctx->vbuf_num_vertices)) {
+                        if (ctx->desc.growable) {
+                            if (list->num_vertices > ctx->vbuf_wanted_vertices) {
+                                ctx->vbuf_wanted_vertices = list->num_vertices;
+                            }
                         }
-                        /* FIXME: what if number of vertices doesn't match the primitive type? */
-                        if (args->num_vertices > 0) {
-                            sg_draw(args->base_vertex, args->num_vertices, 1);
+                        else if (!list->skip_logged) {
+                            list->skip_logged = true;
+                            SOKOL_LOG("sokol_gl.h: display list skipped, it has more vertices than the context's vertex buffer");
                         }
                     }
-                    break;
+                    else if (compatible) {
+                        sg_bindings list_bind;
+                        memset(&list_bind, 0, sizeof(list_bind));
+                        list_bind.vertex_buffers[0] = list->vbuf;
+                        _sgl_draw_commands(ctx, list->commands, list->num_commands, list->uniforms, &list_bind, &uniforms[args->uniform_index]);
+                        /* the display list has applied its own pipelines, bindings and uniforms */
+                        cur_pip_id = SG_INVALID_ID;
+                        cur_img_id = SG_INVALID_ID;
+                        cur_uniform_index = -1;
+                    }
+                }
+                break;
+        }
+    }
+}
+
+/* recreates the sokol-gfx vertex- and index-buffer of a growable context
+   if they are too small, this only happens at the start of a frame, since
+   draw calls earlier in the frame may still use the old buffers
+*/
+static void _sgl_grow_gpu_buffers(_sgl_context_t* ctx) {
+    SOKOL_ASSERT(ctx->desc.growable);
+    int wanted = (ctx->num_vertices > ctx->vbuf_wanted_vertices) ? ctx->num_vertices : ctx->vbuf_wanted_vertices;
+    if (wanted <= ctx->vbuf_num_vertices) {
+        return;
+    }
+    /* nothing has been appended to the vertex buffer in this frame if the whole buffer is still available */
+    if (sg_query_buffer_will_overflow(ctx->vbuf, ctx->vbuf_num_vertices * ctx->vertex_size)) {
+        return;
+    }
+    int num_vertices = ctx->vbuf_num_vertices;
+    while (num_vertices < wanted) {
+        num_vertices *= 2;
+    }
+    sg_destroy_buffer(ctx->vbuf);
+    sg_destroy_buffer(ctx->ibuf);
+    _sgl_init_vertex_buffer(ctx, num_vertices);
+    _sgl_init_index_buffer(ctx);
+    ctx->vbuf_wanted_vertices = 0;
+}
+
+/* this renders the accumulated draw commands of a context via sokol-gfx */
+static void _sgl_draw(_sgl_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    SOKOL_ASSERT(!ctx->in_display_list);
+    if ((ctx->error == SGL_NO_ERROR) && (ctx->cur_command > 0)) {
+        sg_push_debug_group("sokol-gl");
+        if (ctx->desc.growable) {
+            _sgl_grow_gpu_buffers(ctx);
+        }
+        const int num_bytes = ctx->cur_vertex * ctx->vertex_size;
+        if (sg_query_buffer_will_overflow(ctx->vbuf, num_bytes)) {
+            if (ctx->desc.growable) {
+                /* only happens when a context is drawn several times per frame, grow at the start of the next frame */
+                const int num_frame_vertices = sg_query_buffer_info(ctx->vbuf).append_pos / ctx->vertex_size + ctx->cur_vertex;
+                if (num_frame_vertices > ctx->vbuf_wanted_vertices) {
+                    ctx->vbuf_wanted_vertices = num_frame_vertices;
+                }
+                if (num_frame_vertices > ctx->max_frame_vertices) {
+                    ctx->max_frame_vertices = num_frame_vertices;
+                }
+                SOKOL_LOG("sokol_gl.h: vertex buffer overflow in sgl_draw(), the vertex buffer will grow in the next frame");
+            }
+            else {
+                SOKOL_LOG("sokol_gl.h: vertex buffer overflow in sgl_draw(), more than max_vertices drawn in this frame");
+            }
+        }
+        else {
+            /* appending allows to draw the context (or other contexts) again in the same frame */
+            int offset = 0;
+            if (num_bytes > 0) {
+                /* the context is rewound after drawing, so the vertices can be converted in place */
+                _sgl_convert_vertices(ctx->desc.vertex_layout, ctx->vertices, ctx->vertices, ctx->cur_vertex);
+                offset = sg_append_buffer(ctx->vbuf, ctx->vertices, num_bytes);
+            }
+            const int num_frame_vertices = (offset + num_bytes) / ctx->vertex_size;
+            if (num_frame_vertices > ctx->max_frame_vertices) {
+                ctx->max_frame_vertices = num_frame_vertices;
             }
+            ctx->bind.vertex_buffers[0] = ctx->vbuf;
+            ctx->bind.vertex_buffer_offsets[0] = offset;
+            _sgl_draw_commands(ctx, ctx->commands, ctx->cur_command, ctx->uniforms, &ctx->bind, 0);
         }
         sg_pop_debug_group();
     }
-    _sgl_rewind();
+    _sgl_rewind(ctx);
+}
+
+SOKOL_API_IMPL void sgl_draw(void) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    _sgl_context_t* ctx = _sgl_cur_context();
+    if (ctx) {
+        _sgl_draw(ctx);
+    }
+}
+
+SOKOL_API_IMPL void sgl_context_draw(sgl_context ctx_id) {
+    SOKOL_ASSERT(_SGL_INIT_COOKIE == _sgl.init_cookie);
+    _sgl_context_t* ctx = _sgl_lookup_context(ctx_id.id);
+    if (ctx) {
+        _sgl_draw(ctx);
+    }
 }
 #endif /* SOKOL_GL_IMPL */
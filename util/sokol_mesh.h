@@ -0,0 +1,840 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_MESH_IMPL)
+#define SOKOL_MESH_IMPL
+#endif
+#ifndef SOKOL_MESH_INCLUDED
+/*
+    sokol_mesh.h -- prepare index- and vertex-data of imported meshes for sokol_gfx.h
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_MESH_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_mesh.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)     - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)       - your own free function (default: free(p))
+    SOKOL_MESH_API_DECL - public function declaration prefix (default: extern)
+    SOKOL_API_DECL      - same as SOKOL_MESH_API_DECL
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+
+    If sokol_mesh.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_MESH_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    Mesh importers usually produce 32-bit indices, even though most meshes
+    only reference a few thousand vertices. sokol_mesh.h takes a 32-bit
+    index stream and produces the narrowest index buffer which can render
+    the mesh:
+
+    - if all indices fit into 16 bits (after subtracting the smallest
+      index), the result is a single SG_INDEXTYPE_UINT16 chunk
+    - otherwise the primitives are split into chunks which each reference
+      at most 65535 vertices, and the indices of each chunk are rebased to
+      the chunk's first vertex, so the whole mesh still uses
+      SG_INDEXTYPE_UINT16
+    - if the primitives of a chunk reference vertices which are too far
+      apart, the vertices of each chunk are copied into a new vertex buffer
+      (vertices shared between chunks are duplicated)
+    - if chunking isn't possible (strip primitive types, or more chunks
+      than allowed by smesh_desc_t.max_chunks), the result is a single
+      SG_INDEXTYPE_UINT32 chunk
+
+    Since sokol_gfx.h doesn't have a 'base vertex' draw parameter, each
+    chunk is rendered with a vertex buffer offset which moves the start of
+    the vertex buffer to the chunk's first vertex.
+
+    Optionally, smesh_optimize_vertex_cache() reorders the triangles of an
+    index stream for better post-transform vertex cache usage (using the
+    'Tipsify' algorithm by Sander, Nehab and Barczak), and smesh_acmr()
+    computes the average number of vertex shader invocations per triangle
+    for a given cache size to measure the effect.
+
+    STEP BY STEP
+    ============
+    --- optionally reorder the triangles of a triangle-list for the vertex cache:
+
+        ```c
+        smesh_optimize_vertex_cache(indices, num_indices, num_vertices);
+        ```
+
+    --- describe the mesh with an smesh_desc_t struct:
+
+        ```c
+        smesh_desc_t desc = {
+            .indices = indices,             // const uint32_t*
+            .num_indices = num_indices,
+            .vertices = vertices,           // only needed if vertices must be copied
+            .num_vertices = num_vertices,
+            .vertex_stride = sizeof(vertex_t),
+        };
+        ```
+
+        The .primitive_type item is optional and defaults to
+        SG_PRIMITIVETYPE_TRIANGLES.
+
+    --- ask for the required output buffer sizes and provide the buffers:
+
+        ```c
+        smesh_sizes_t sizes = smesh_query_sizes(&desc);
+        desc.index_buffer = (smesh_buffer_t){ malloc(sizes.index_buffer_size), sizes.index_buffer_size };
+        desc.chunk_buffer = (smesh_buffer_t){ malloc(sizes.chunk_buffer_size), sizes.chunk_buffer_size };
+        if (sizes.vertex_buffer_size > 0) {
+            desc.vertex_buffer = (smesh_buffer_t){ malloc(sizes.vertex_buffer_size), sizes.vertex_buffer_size };
+        }
+        ```
+
+        The vertex buffer size is 0 if the vertices can be used as is.
+
+    --- build the mesh and create the sokol_gfx buffers:
+
+        ```c
+        smesh_mesh_t mesh = smesh_build(&desc);
+        if (mesh.valid) {
+            sg_buffer_desc vbuf_desc = smesh_vertex_buffer_desc(&mesh);
+            sg_buffer_desc ibuf_desc = smesh_index_buffer_desc(&mesh);
+            sg_buffer vbuf = sg_make_buffer(&vbuf_desc);
+            sg_buffer ibuf = sg_make_buffer(&ibuf_desc);
+            ...
+        }
+        ```
+
+        The buffer descs point into the caller-provided buffers (or the
+        original vertex data), so those must stay alive until the sokol_gfx
+        buffers have been created.
+
+        If the vertices didn't need to be copied and smesh_desc_t.vertices
+        was left at zero, the .content pointer of the vertex buffer desc
+        is a null pointer, and must be set to the original vertex data
+        before calling sg_make_buffer().
+
+    --- create the pipeline with the index type from the mesh:
+
+        ```c
+        sg_pipeline pip = sg_make_pipeline(&(sg_pipeline_desc){
+            .index_type = mesh.index_type,
+            ...
+        });
+        ```
+
+    --- render each chunk with a vertex buffer offset:
+
+        ```c
+        for (int i = 0; i < mesh.num_chunks; i++) {
+            const smesh_chunk_t* chunk = &mesh.chunks[i];
+            sg_apply_bindings(&(sg_bindings){
+                .vertex_buffers[0] = vbuf,
+                .vertex_buffer_offsets[0] = chunk->vertex_buffer_offset,
+                .index_buffer = ibuf
+            });
+            sg_draw(chunk->base_element, chunk->num_elements, 1);
+        }
+        ```
+
+        If the vertex attributes are spread over several vertex buffers,
+        offset each of them by chunk->base_vertex times its own stride
+        (this only works if the vertices didn't need to be copied, which
+        is the case when smesh_query_sizes() returns a vertex buffer size
+        of 0).
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2020 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_MESH_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_mesh.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_MESH_API_DECL)
+#define SOKOL_MESH_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_MESH_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_MESH_IMPL)
+#define SOKOL_MESH_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_MESH_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_MESH_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct smesh_buffer_t {
+    void* ptr;
+    int size;
+} smesh_buffer_t;
+
+typedef struct smesh_desc_t {
+    const uint32_t* indices;
+    int num_indices;
+    const void* vertices;           /* only needed if vertices must be copied */
+    int num_vertices;
+    int vertex_stride;              /* size of a vertex in bytes */
+    sg_primitive_type primitive_type;   /* default: SG_PRIMITIVETYPE_TRIANGLES */
+    int max_chunks;                 /* use 32-bit indices if more chunks are needed (default: no limit) */
+    smesh_buffer_t index_buffer;    /* receives the 16- or 32-bit indices */
+    smesh_buffer_t vertex_buffer;   /* receives the copied vertices (if needed) */
+    smesh_buffer_t chunk_buffer;    /* receives the smesh_chunk_t array */
+} smesh_desc_t;
+
+typedef struct smesh_sizes_t {
+    sg_index_type index_type;
+    int num_chunks;
+    int index_buffer_size;
+    int vertex_buffer_size;         /* 0 if the vertices can be used as is */
+    int chunk_buffer_size;
+} smesh_sizes_t;
+
+/* a range of primitives which is rendered with one draw call */
+typedef struct smesh_chunk_t {
+    int base_element;               /* first index in the index buffer */
+    int num_elements;
+    int base_vertex;                /* the vertex which index 0 of this chunk refers to */
+    int vertex_buffer_offset;       /* base_vertex * vertex_stride */
+} smesh_chunk_t;
+
+typedef struct smesh_mesh_t {
+    bool valid;
+    sg_index_type index_type;
+    int num_chunks;
+    const smesh_chunk_t* chunks;
+    int num_vertices;               /* number of vertices in the vertex buffer */
+    smesh_buffer_t vertices;        /* either the original or the copied vertices (ptr is 0 if not copied and smesh_desc_t.vertices was 0) */
+    smesh_buffer_t indices;
+} smesh_mesh_t;
+
+SOKOL_MESH_API_DECL smesh_sizes_t smesh_query_sizes(const smesh_desc_t* desc);
+SOKOL_MESH_API_DECL smesh_mesh_t smesh_build(const smesh_desc_t* desc);
+SOKOL_MESH_API_DECL sg_buffer_desc smesh_vertex_buffer_desc(const smesh_mesh_t* mesh);
+SOKOL_MESH_API_DECL sg_buffer_desc smesh_index_buffer_desc(const smesh_mesh_t* mesh);
+SOKOL_MESH_API_DECL void smesh_optimize_vertex_cache(uint32_t* indices, int num_indices, int num_vertices);
+SOKOL_MESH_API_DECL float smesh_acmr(const uint32_t* indices, int num_indices, int cache_size);
+
+#ifdef __cplusplus
+} /* extern "C" */
+
+/* reference-based equivalents for c++ */
+inline smesh_sizes_t smesh_query_sizes(const smesh_desc_t& desc) { return smesh_query_sizes(&desc); }
+inline smesh_mesh_t smesh_build(const smesh_desc_t& desc) { return smesh_build(&desc); }
+inline sg_buffer_desc smesh_vertex_buffer_desc(const smesh_mesh_t& mesh) { return smesh_vertex_buffer_desc(&mesh); }
+inline sg_buffer_desc smesh_index_buffer_desc(const smesh_mesh_t& mesh) { return smesh_index_buffer_desc(&mesh); }
+
+#endif
+#endif /* SOKOL_MESH_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_MESH_IMPL
+#define SOKOL_MESH_IMPL_INCLUDED (1)
+
+#include <string.h> // memset, memcpy
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#define _smesh_def(val, def) (((val) == 0) ? (def) : (val))
+
+/* vertices per 16-bit chunk, index 0xFFFF is kept free since it is the
+   primitive-restart index on some backends
+*/
+#define _SMESH_MAX_CHUNK_VERTICES (0xFFFF)
+
+typedef enum {
+    _SMESH_STRATEGY_INVALID,
+    _SMESH_STRATEGY_UINT32,         /* a single chunk with 32-bit indices */
+    _SMESH_STRATEGY_REBASE,         /* 16-bit chunks, indices rebased to the chunk's smallest index */
+    _SMESH_STRATEGY_COPY,           /* 16-bit chunks, vertices copied per chunk */
+} _smesh_strategy_t;
+
+typedef struct {
+    _smesh_strategy_t strategy;
+    int num_chunks;
+    int num_vertices;               /* output vertices of the COPY strategy */
+} _smesh_plan_t;
+
+_SOKOL_PRIVATE smesh_desc_t _smesh_desc_defaults(const smesh_desc_t* desc) {
+    smesh_desc_t res = *desc;
+    res.primitive_type = _smesh_def(res.primitive_type, SG_PRIMITIVETYPE_TRIANGLES);
+    return res;
+}
+
+_SOKOL_PRIVATE bool _smesh_desc_valid(const smesh_desc_t* desc) {
+    if ((0 == desc->indices) || (desc->num_indices <= 0) || (desc->num_vertices <= 0) || (desc->vertex_stride <= 0)) {
+        return false;
+    }
+    for (int i = 0; i < desc->num_indices; i++) {
+        if (desc->indices[i] >= (uint32_t)desc->num_vertices) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* number of indices per primitive, or 0 if the primitive type can't be split */
+_SOKOL_PRIVATE int _smesh_prim_size(sg_primitive_type prim_type) {
+    switch (prim_type) {
+        case SG_PRIMITIVETYPE_POINTS:       return 1;
+        case SG_PRIMITIVETYPE_LINES:        return 2;
+        case SG_PRIMITIVETYPE_TRIANGLES:    return 3;
+        default:                            return 0;
+    }
+}
+
+/* count the chunks needed when rebasing each chunk to its smallest index,
+   returns 0 if a single primitive spans too many vertices
+*/
+_SOKOL_PRIVATE int _smesh_count_rebase_chunks(const smesh_desc_t* desc, int prim_size) {
+    int num_chunks = 0;
+    uint32_t chunk_min = 0, chunk_max = 0;
+    for (int i = 0; i < desc->num_indices; i += prim_size) {
+        uint32_t prim_min = desc->indices[i], prim_max = desc->indices[i];
+        for (int k = 1; k < prim_size; k++) {
+            const uint32_t idx = desc->indices[i + k];
+            prim_min = (idx < prim_min) ? idx : prim_min;
+            prim_max = (idx > prim_max) ? idx : prim_max;
+        }
+        if ((prim_max - prim_min) >= _SMESH_MAX_CHUNK_VERTICES) {
+            return 0;
+        }
+        const uint32_t new_min = (prim_min < chunk_min) ? prim_min : chunk_min;
+        const uint32_t new_max = (prim_max > chunk_max) ? prim_max : chunk_max;
+        if ((0 == num_chunks) || ((new_max - new_min) >= _SMESH_MAX_CHUNK_VERTICES)) {
+            num_chunks++;
+            chunk_min = prim_min;
+            chunk_max = prim_max;
+        }
+        else {
+            chunk_min = new_min;
+            chunk_max = new_max;
+        }
+    }
+    return num_chunks;
+}
+
+/* a vertex => chunk-local index map for the COPY strategy, entries are
+   only valid if the stamp matches the current chunk
+*/
+typedef struct {
+    int* local;
+    int* stamp;
+} _smesh_remap_t;
+
+_SOKOL_PRIVATE void _smesh_remap_init(_smesh_remap_t* remap, int num_vertices) {
+    const size_t size = (size_t)num_vertices * sizeof(int);
+    remap->local = (int*) SOKOL_MALLOC(size);
+    remap->stamp = (int*) SOKOL_MALLOC(size);
+    SOKOL_ASSERT(remap->local && remap->stamp);
+    memset(remap->stamp, 0, size);
+}
+
+_SOKOL_PRIVATE void _smesh_remap_discard(_smesh_remap_t* remap) {
+    SOKOL_FREE(remap->stamp);
+    SOKOL_FREE(remap->local);
+}
+
+/* number of vertices of a primitive which aren't in the current chunk yet */
+_SOKOL_PRIVATE int _smesh_new_vertices(const _smesh_remap_t* remap, const uint32_t* prim, int prim_size, int chunk_stamp) {
+    int num = 0;
+    for (int k = 0; k < prim_size; k++) {
+        bool dup = remap->stamp[prim[k]] == chunk_stamp;
+        for (int j = 0; (j < k) && !dup; j++) {
+            dup = prim[j] == prim[k];
+        }
+        num += dup ? 0 : 1;
+    }
+    return num;
+}
+
+/* count the chunks and output vertices when copying the vertices of each chunk */
+_SOKOL_PRIVATE int _smesh_count_copy_chunks(const smesh_desc_t* desc, int prim_size, int* out_num_vertices) {
+    _smesh_remap_t remap;
+    _smesh_remap_init(&remap, desc->num_vertices);
+    int num_chunks = 0;
+    int chunk_vertices = 0;
+    int num_vertices = 0;
+    for (int i = 0; i < desc->num_indices; i += prim_size) {
+        const uint32_t* prim = &desc->indices[i];
+        int num_new = _smesh_new_vertices(&remap, prim, prim_size, num_chunks);
+        if ((0 == num_chunks) || ((chunk_vertices + num_new) > _SMESH_MAX_CHUNK_VERTICES)) {
+            num_chunks++;
+            chunk_vertices = 0;
+            num_new = _smesh_new_vertices(&remap, prim, prim_size, num_chunks);
+        }
+        for (int k = 0; k < prim_size; k++) {
+            remap.stamp[prim[k]] = num_chunks;
+        }
+        chunk_vertices += num_new;
+        num_vertices += num_new;
+    }
+    _smesh_remap_discard(&remap);
+    *out_num_vertices = num_vertices;
+    return num_chunks;
+}
+
+_SOKOL_PRIVATE _smesh_plan_t _smesh_make_plan(const smesh_desc_t* desc) {
+    _smesh_plan_t plan;
+    memset(&plan, 0, sizeof(plan));
+    if (!_smesh_desc_valid(desc)) {
+        return plan;
+    }
+    plan.strategy = _SMESH_STRATEGY_UINT32;
+    plan.num_chunks = 1;
+    const int prim_size = _smesh_prim_size(desc->primitive_type);
+    if (0 == prim_size) {
+        /* strips can't be split, but can still be rebased as a whole */
+        uint32_t min_idx = desc->indices[0], max_idx = desc->indices[0];
+        for (int i = 1; i < desc->num_indices; i++) {
+            min_idx = (desc->indices[i] < min_idx) ? desc->indices[i] : min_idx;
+            max_idx = (desc->indices[i] > max_idx) ? desc->indices[i] : max_idx;
+        }
+        if ((max_idx - min_idx) < _SMESH_MAX_CHUNK_VERTICES) {
+            plan.strategy = _SMESH_STRATEGY_REBASE;
+        }
+        return plan;
+    }
+    if ((desc->num_indices % prim_size) != 0) {
+        plan.strategy = _SMESH_STRATEGY_INVALID;
+        plan.num_chunks = 0;
+        return plan;
+    }
+    const int max_chunks = _smesh_def(desc->max_chunks, desc->num_indices);
+    const int num_rebase_chunks = _smesh_count_rebase_chunks(desc, prim_size);
+    if ((num_rebase_chunks == 1) || ((num_rebase_chunks > 0) && (0 == desc->vertices))) {
+        /* either a single chunk, or the vertices aren't available for copying */
+        if (num_rebase_chunks <= max_chunks) {
+            plan.strategy = _SMESH_STRATEGY_REBASE;
+            plan.num_chunks = num_rebase_chunks;
+        }
+        return plan;
+    }
+    if (desc->vertices) {
+        int num_copy_vertices = 0;
+        const int num_copy_chunks = _smesh_count_copy_chunks(desc, prim_size, &num_copy_vertices);
+        if ((num_rebase_chunks > 0) && (num_rebase_chunks <= num_copy_chunks)) {
+            if (num_rebase_chunks <= max_chunks) {
+                plan.strategy = _SMESH_STRATEGY_REBASE;
+                plan.num_chunks = num_rebase_chunks;
+            }
+        }
+        else if (num_copy_chunks <= max_chunks) {
+            plan.strategy = _SMESH_STRATEGY_COPY;
+            plan.num_chunks = num_copy_chunks;
+            plan.num_vertices = num_copy_vertices;
+        }
+    }
+    return plan;
+}
+
+_SOKOL_PRIVATE smesh_sizes_t _smesh_plan_sizes(const smesh_desc_t* desc, const _smesh_plan_t* plan) {
+    smesh_sizes_t sizes;
+    memset(&sizes, 0, sizeof(sizes));
+    if (plan->strategy == _SMESH_STRATEGY_INVALID) {
+        return sizes;
+    }
+    const bool is_u32 = plan->strategy == _SMESH_STRATEGY_UINT32;
+    sizes.index_type = is_u32 ? SG_INDEXTYPE_UINT32 : SG_INDEXTYPE_UINT16;
+    sizes.num_chunks = plan->num_chunks;
+    sizes.index_buffer_size = desc->num_indices * (is_u32 ? 4 : 2);
+    sizes.chunk_buffer_size = plan->num_chunks * (int)sizeof(smesh_chunk_t);
+    if (plan->strategy == _SMESH_STRATEGY_COPY) {
+        sizes.vertex_buffer_size = plan->num_vertices * desc->vertex_stride;
+    }
+    return sizes;
+}
+
+_SOKOL_PRIVATE void _smesh_build_uint32(const smesh_desc_t* desc, smesh_chunk_t* chunk) {
+    memcpy(desc->index_buffer.ptr, desc->indices, (size_t)desc->num_indices * sizeof(uint32_t));
+    chunk->base_element = 0;
+    chunk->num_elements = desc->num_indices;
+    chunk->base_vertex = 0;
+    chunk->vertex_buffer_offset = 0;
+}
+
+_SOKOL_PRIVATE void _smesh_write_rebased(const smesh_desc_t* desc, uint16_t* dst, int first, int num, uint32_t base, smesh_chunk_t* chunk) {
+    for (int i = first; i < (first + num); i++) {
+        dst[i] = (uint16_t)(desc->indices[i] - base);
+    }
+    chunk->base_element = first;
+    chunk->num_elements = num;
+    chunk->base_vertex = (int)base;
+    chunk->vertex_buffer_offset = (int)base * desc->vertex_stride;
+}
+
+/* same chunking as _smesh_count_rebase_chunks() (or a single chunk for strips) */
+_SOKOL_PRIVATE void _smesh_build_rebase(const smesh_desc_t* desc, smesh_chunk_t* chunks) {
+    uint16_t* dst = (uint16_t*) desc->index_buffer.ptr;
+    int prim_size = _smesh_prim_size(desc->primitive_type);
+    if (0 == prim_size) {
+        prim_size = desc->num_indices;
+    }
+    int num_chunks = 0;
+    int chunk_first = 0;
+    uint32_t chunk_min = 0, chunk_max = 0;
+    for (int i = 0; i < desc->num_indices; i += prim_size) {
+        uint32_t prim_min = desc->indices[i], prim_max = desc->indices[i];
+        for (int k = 1; k < prim_size; k++) {
+            const uint32_t idx = desc->indices[i + k];
+            prim_min = (idx < prim_min) ? idx : prim_min;
+            prim_max = (idx > prim_max) ? idx : prim_max;
+        }
+        const uint32_t new_min = (prim_min < chunk_min) ? prim_min : chunk_min;
+        const uint32_t new_max = (prim_max > chunk_max) ? prim_max : chunk_max;
+        if ((i == 0) || ((new_max - new_min) >= _SMESH_MAX_CHUNK_VERTICES)) {
+            if (i > 0) {
+                _smesh_write_rebased(desc, dst, chunk_first, i - chunk_first, chunk_min, &chunks[num_chunks++]);
+            }
+            chunk_first = i;
+            chunk_min = prim_min;
+            chunk_max = prim_max;
+        }
+        else {
+            chunk_min = new_min;
+            chunk_max = new_max;
+        }
+    }
+    _smesh_write_rebased(desc, dst, chunk_first, desc->num_indices - chunk_first, chunk_min, &chunks[num_chunks]);
+}
+
+/* same chunking as _smesh_count_copy_chunks() */
+_SOKOL_PRIVATE void _smesh_build_copy(const smesh_desc_t* desc, smesh_chunk_t* chunks) {
+    uint16_t* dst = (uint16_t*) desc->index_buffer.ptr;
+    const uint8_t* src_verts = (const uint8_t*) desc->vertices;
+    uint8_t* dst_verts = (uint8_t*) desc->vertex_buffer.ptr;
+    const int stride = desc->vertex_stride;
+    const int prim_size = _smesh_prim_size(desc->primitive_type);
+    _smesh_remap_t remap;
+    _smesh_remap_init(&remap, desc->num_vertices);
+    int num_chunks = 0;
+    int chunk_vertices = 0;
+    int num_vertices = 0;
+    smesh_chunk_t* chunk = 0;
+    for (int i = 0; i < desc->num_indices; i += prim_size) {
+        const uint32_t* prim = &desc->indices[i];
+        const int num_new = _smesh_new_vertices(&remap, prim, prim_size, num_chunks);
+        if ((0 == num_chunks) || ((chunk_vertices + num_new) > _SMESH_MAX_CHUNK_VERTICES)) {
+            chunk = &chunks[num_chunks++];
+            chunk->base_element = i;
+            chunk->base_vertex = num_vertices;
+            chunk->vertex_buffer_offset = num_vertices * stride;
+            chunk_vertices = 0;
+        }
+        for (int k = 0; k < prim_size; k++) {
+            const uint32_t idx = prim[k];
+            if (remap.stamp[idx] != num_chunks) {
+                remap.stamp[idx] = num_chunks;
+                remap.local[idx] = chunk_vertices++;
+                memcpy(dst_verts + (size_t)num_vertices * (size_t)stride, src_verts + (size_t)idx * (size_t)stride, (size_t)stride);
+                num_vertices++;
+            }
+            dst[i + k] = (uint16_t)remap.local[idx];
+        }
+        chunk->num_elements = i + prim_size - chunk->base_element;
+    }
+    _smesh_remap_discard(&remap);
+}
+
+/*-- vertex cache optimization (Tipsify) -------------------------------------*/
+#define _SMESH_TIPSIFY_CACHE_SIZE (16)
+
+typedef struct {
+    const uint32_t* indices;
+    int num_vertices;
+    int* adj_offsets;       /* start of each vertex's triangle list in adj_tris */
+    int* adj_tris;          /* triangle indices adjacent to each vertex */
+    int* live;              /* number of not yet emitted triangles per vertex */
+    int* cache_time;        /* timestamp when the vertex was last put into the cache */
+    int* dead_end;          /* stack of recently used vertices */
+    int dead_end_top;
+    int* candidates;
+    int num_candidates;
+    bool* emitted;
+    int cursor;             /* next vertex to look at when the dead-end stack is empty */
+} _smesh_tipsify_t;
+
+_SOKOL_PRIVATE int _smesh_tipsify_skip_dead_end(_smesh_tipsify_t* ts) {
+    while (ts->dead_end_top > 0) {
+        const int v = ts->dead_end[--ts->dead_end_top];
+        if (ts->live[v] > 0) {
+            return v;
+        }
+    }
+    while (ts->cursor < ts->num_vertices) {
+        if (ts->live[ts->cursor] > 0) {
+            return ts->cursor;
+        }
+        ts->cursor++;
+    }
+    return -1;
+}
+
+_SOKOL_PRIVATE int _smesh_tipsify_next_vertex(_smesh_tipsify_t* ts, int timestamp) {
+    int best_vertex = -1;
+    int best_priority = -1;
+    for (int i = 0; i < ts->num_candidates; i++) {
+        const int v = ts->candidates[i];
+        if (ts->live[v] > 0) {
+            /* prefer vertices which are still in the cache after emitting all their triangles */
+            int priority = 0;
+            if ((timestamp - ts->cache_time[v] + 2 * ts->live[v]) <= _SMESH_TIPSIFY_CACHE_SIZE) {
+                priority = timestamp - ts->cache_time[v];
+            }
+            if (priority > best_priority) {
+                best_priority = priority;
+                best_vertex = v;
+            }
+        }
+    }
+    if (best_vertex == -1) {
+        best_vertex = _smesh_tipsify_skip_dead_end(ts);
+    }
+    return best_vertex;
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL smesh_sizes_t smesh_query_sizes(const smesh_desc_t* in_desc) {
+    SOKOL_ASSERT(in_desc);
+    const smesh_desc_t desc = _smesh_desc_defaults(in_desc);
+    const _smesh_plan_t plan = _smesh_make_plan(&desc);
+    return _smesh_plan_sizes(&desc, &plan);
+}
+
+SOKOL_API_IMPL smesh_mesh_t smesh_build(const smesh_desc_t* in_desc) {
+    SOKOL_ASSERT(in_desc);
+    smesh_mesh_t mesh;
+    memset(&mesh, 0, sizeof(mesh));
+    const smesh_desc_t desc = _smesh_desc_defaults(in_desc);
+    const _smesh_plan_t plan = _smesh_make_plan(&desc);
+    const smesh_sizes_t sizes = _smesh_plan_sizes(&desc, &plan);
+    if (plan.strategy == _SMESH_STRATEGY_INVALID) {
+        return mesh;
+    }
+    if ((0 == desc.index_buffer.ptr) || (desc.index_buffer.size < sizes.index_buffer_size) ||
+        (0 == desc.chunk_buffer.ptr) || (desc.chunk_buffer.size < sizes.chunk_buffer_size) ||
+        ((sizes.vertex_buffer_size > 0) && ((0 == desc.vertex_buffer.ptr) || (desc.vertex_buffer.size < sizes.vertex_buffer_size))))
+    {
+        return mesh;
+    }
+    smesh_chunk_t* chunks = (smesh_chunk_t*) desc.chunk_buffer.ptr;
+    switch (plan.strategy) {
+        case _SMESH_STRATEGY_UINT32:
+            _smesh_build_uint32(&desc, chunks);
+            break;
+        case _SMESH_STRATEGY_REBASE:
+            _smesh_build_rebase(&desc, chunks);
+            break;
+        case _SMESH_STRATEGY_COPY:
+            _smesh_build_copy(&desc, chunks);
+            break;
+        default:
+            SOKOL_ASSERT(false);
+            break;
+    }
+    mesh.valid = true;
+    mesh.index_type = sizes.index_type;
+    mesh.num_chunks = plan.num_chunks;
+    mesh.chunks = chunks;
+    if (plan.strategy == _SMESH_STRATEGY_COPY) {
+        mesh.num_vertices = plan.num_vertices;
+        mesh.vertices.ptr = desc.vertex_buffer.ptr;
+        mesh.vertices.size = sizes.vertex_buffer_size;
+    }
+    else {
+        mesh.num_vertices = desc.num_vertices;
+        mesh.vertices.ptr = (void*) desc.vertices;
+        mesh.vertices.size = desc.num_vertices * desc.vertex_stride;
+    }
+    mesh.indices.ptr = desc.index_buffer.ptr;
+    mesh.indices.size = sizes.index_buffer_size;
+    return mesh;
+}
+
+SOKOL_API_IMPL sg_buffer_desc smesh_vertex_buffer_desc(const smesh_mesh_t* mesh) {
+    SOKOL_ASSERT(mesh && mesh->valid);
+    sg_buffer_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.size = mesh->vertices.size;
+    desc.type = SG_BUFFERTYPE_VERTEXBUFFER;
+    desc.usage = SG_USAGE_IMMUTABLE;
+    desc.content = mesh->vertices.ptr;
+    return desc;
+}
+
+SOKOL_API_IMPL sg_buffer_desc smesh_index_buffer_desc(const smesh_mesh_t* mesh) {
+    SOKOL_ASSERT(mesh && mesh->valid);
+    sg_buffer_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.size = mesh->indices.size;
+    desc.type = SG_BUFFERTYPE_INDEXBUFFER;
+    desc.usage = SG_USAGE_IMMUTABLE;
+    desc.content = mesh->indices.ptr;
+    return desc;
+}
+
+SOKOL_API_IMPL void smesh_optimize_vertex_cache(uint32_t* indices, int num_indices, int num_vertices) {
+    SOKOL_ASSERT(indices && (num_indices >= 0) && (num_vertices >= 0));
+    SOKOL_ASSERT((num_indices % 3) == 0);
+    const int num_tris = num_indices / 3;
+    if ((num_tris == 0) || (num_vertices == 0)) {
+        return;
+    }
+    _smesh_tipsify_t ts;
+    memset(&ts, 0, sizeof(ts));
+    ts.indices = indices;
+    ts.num_vertices = num_vertices;
+    const size_t vert_ints = (size_t)num_vertices * sizeof(int);
+    ts.adj_offsets = (int*) SOKOL_MALLOC(vert_ints + sizeof(int));
+    ts.adj_tris = (int*) SOKOL_MALLOC((size_t)num_indices * sizeof(int));
+    ts.live = (int*) SOKOL_MALLOC(vert_ints);
+    ts.cache_time = (int*) SOKOL_MALLOC(vert_ints);
+    ts.dead_end = (int*) SOKOL_MALLOC((size_t)num_indices * sizeof(int));
+    ts.candidates = (int*) SOKOL_MALLOC((size_t)num_indices * sizeof(int));
+    ts.emitted = (bool*) SOKOL_MALLOC((size_t)num_tris * sizeof(bool));
+    uint32_t* out = (uint32_t*) SOKOL_MALLOC((size_t)num_indices * sizeof(uint32_t));
+    SOKOL_ASSERT(ts.adj_offsets && ts.adj_tris && ts.live && ts.cache_time && ts.dead_end && ts.candidates && ts.emitted && out);
+    memset(ts.live, 0, vert_ints);
+    memset(ts.emitted, 0, (size_t)num_tris * sizeof(bool));
+
+    /* build the vertex => triangle adjacency */
+    for (int i = 0; i < num_indices; i++) {
+        SOKOL_ASSERT(indices[i] < (uint32_t)num_vertices);
+        ts.live[indices[i]]++;
+    }
+    ts.adj_offsets[0] = 0;
+    for (int v = 0; v < num_vertices; v++) {
+        ts.adj_offsets[v + 1] = ts.adj_offsets[v] + ts.live[v];
+    }
+    /* cache_time is used as fill cursor here, and cleared afterwards */
+    memcpy(ts.cache_time, ts.adj_offsets, vert_ints);
+    for (int i = 0; i < num_indices; i++) {
+        ts.adj_tris[ts.cache_time[indices[i]]++] = i / 3;
+    }
+    memset(ts.cache_time, 0, vert_ints);
+
+    int timestamp = _SMESH_TIPSIFY_CACHE_SIZE + 1;
+    int num_out = 0;
+    int fan_vertex = 0;
+    while (fan_vertex >= 0) {
+        ts.num_candidates = 0;
+        for (int a = ts.adj_offsets[fan_vertex]; a < ts.adj_offsets[fan_vertex + 1]; a++) {
+            const int tri = ts.adj_tris[a];
+            if (ts.emitted[tri]) {
+                continue;
+            }
+            for (int k = 0; k < 3; k++) {
+                const uint32_t v = indices[tri * 3 + k];
+                out[num_out++] = v;
+                ts.dead_end[ts.dead_end_top++] = (int)v;
+                ts.candidates[ts.num_candidates++] = (int)v;
+                ts.live[v]--;
+                if ((timestamp - ts.cache_time[v]) > _SMESH_TIPSIFY_CACHE_SIZE) {
+                    ts.cache_time[v] = timestamp++;
+                }
+            }
+            ts.emitted[tri] = true;
+        }
+        fan_vertex = _smesh_tipsify_next_vertex(&ts, timestamp);
+    }
+    SOKOL_ASSERT(num_out == num_indices);
+    memcpy(indices, out, (size_t)num_indices * sizeof(uint32_t));
+
+    SOKOL_FREE(out);
+    SOKOL_FREE(ts.emitted);
+    SOKOL_FREE(ts.candidates);
+    SOKOL_FREE(ts.dead_end);
+    SOKOL_FREE(ts.cache_time);
+    SOKOL_FREE(ts.live);
+    SOKOL_FREE(ts.adj_tris);
+    SOKOL_FREE(ts.adj_offsets);
+}
+
+SOKOL_API_IMPL float smesh_acmr(const uint32_t* indices, int num_indices, int cache_size) {
+    SOKOL_ASSERT(indices && (num_indices >= 0) && (cache_size > 0));
+    if (num_indices < 3) {
+        return 0.0f;
+    }
+    /* simulate a FIFO cache */
+    uint32_t* cache = (uint32_t*) SOKOL_MALLOC((size_t)cache_size * sizeof(uint32_t));
+    SOKOL_ASSERT(cache);
+    int cache_fill = 0;
+    int cache_pos = 0;
+    int num_misses = 0;
+    for (int i = 0; i < num_indices; i++) {
+        bool hit = false;
+        for (int c = 0; (c < cache_fill) && !hit; c++) {
+            hit = cache[c] == indices[i];
+        }
+        if (!hit) {
+            num_misses++;
+            cache[cache_pos] = indices[i];
+            cache_pos = (cache_pos + 1) % cache_size;
+            cache_fill = (cache_fill < cache_size) ? (cache_fill + 1) : cache_size;
+        }
+    }
+    SOKOL_FREE(cache);
+    return (float)num_misses / (float)(num_indices / 3);
+}
+
+#endif /* SOKOL_MESH_IMPL */
@@ -0,0 +1,736 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_MIPMAP_IMPL)
+#define SOKOL_MIPMAP_IMPL
+#endif
+#ifndef SOKOL_MIPMAP_INCLUDED
+/*
+    sokol_mipmap.h -- generate mipmap chains on the CPU for sokol_gfx.h images
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_MIPMAP_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_mipmap.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)     - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)       - your own free function (default: free(p))
+    SOKOL_MIPMAP_NO_SIMD - don't use the SSE2 or NEON code paths
+    SOKOL_MIPMAP_API_DECL - public function declaration prefix (default: extern)
+    SOKOL_API_DECL      - same as SOKOL_MIPMAP_API_DECL
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+
+    If sokol_mipmap.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_MIPMAP_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_mipmap.h takes the base level of a 2D- or cubemap-image and
+    computes the remaining mipmap levels with a 2x2 box filter, the results
+    are written into an sg_image_content struct which can be plugged
+    directly into sg_image_desc.content.
+
+    The following pixel formats are supported:
+
+        SG_PIXELFORMAT_RGBA8
+        SG_PIXELFORMAT_RG8
+        SG_PIXELFORMAT_R8
+        SG_PIXELFORMAT_RGBA16F
+        SG_PIXELFORMAT_RGBA32F
+
+    For the 8-bit formats, the pixel data can optionally be treated as
+    sRGB-encoded, in that case the color channels are converted to linear
+    space before filtering and back to sRGB after filtering (the alpha
+    channel of RGBA8 is always filtered linearly).
+
+    On x86 with SSE2 and on ARM with NEON, the filter kernels and the
+    8-bit pixel conversions are vectorized, on all other platforms (or if
+    SOKOL_MIPMAP_NO_SIMD is defined) scalar code is used. Both code paths
+    produce identical results.
+
+    Odd image dimensions are rounded down in the next mipmap level, the
+    last pixel column or row of an odd-sized image is ignored (except for
+    a size of 1, where the single pixel is duplicated).
+
+    STEP BY STEP
+    ============
+    --- describe the image with an smip_desc_t struct:
+
+        ```c
+        smip_desc_t desc = {
+            .type = SG_IMAGETYPE_2D,            // or SG_IMAGETYPE_CUBE
+            .pixel_format = SG_PIXELFORMAT_RGBA8,
+            .width = 256,
+            .height = 256,
+            .srgb = true,
+        };
+        ```
+
+        The .num_mipmaps item is optional and defaults to the full
+        mipmap chain down to 1x1 pixels (but at most SG_MAX_MIPMAPS).
+
+    --- ask for the size of the memory buffer which will receive the
+        generated mipmaps (everything except the base level), and provide
+        the buffer:
+
+        ```c
+        desc.buffer.size = smip_buffer_size(&desc);
+        desc.buffer.ptr = malloc(desc.buffer.size);
+        ```
+
+    --- setup an sg_image_content struct with the base level pixels (one
+        for each cubemap face), and call smip_generate():
+
+        ```c
+        sg_image_content content = {
+            .subimage[0][0] = { .ptr = pixels, .size = 256*256*4 }
+        };
+        int num_mipmaps = smip_generate(&desc, &content);
+        ```
+
+        smip_generate() returns the number of mipmaps in the image
+        (including the base level), or 0 if the parameters are invalid.
+
+    --- create the sokol_gfx image:
+
+        ```c
+        sg_image img = sg_make_image(&(sg_image_desc){
+            .width = 256,
+            .height = 256,
+            .pixel_format = SG_PIXELFORMAT_RGBA8,
+            .num_mipmaps = num_mipmaps,
+            .min_filter = SG_FILTER_LINEAR_MIPMAP_LINEAR,
+            .mag_filter = SG_FILTER_LINEAR,
+            .content = content
+        });
+        free(desc.buffer.ptr);
+        ```
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2020 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_MIPMAP_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_mipmap.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_MIPMAP_API_DECL)
+#define SOKOL_MIPMAP_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_MIPMAP_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_MIPMAP_IMPL)
+#define SOKOL_MIPMAP_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_MIPMAP_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_MIPMAP_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct smip_buffer_t {
+    void* ptr;
+    int size;
+} smip_buffer_t;
+
+typedef struct smip_desc_t {
+    sg_image_type type;             /* SG_IMAGETYPE_2D (default) or SG_IMAGETYPE_CUBE */
+    sg_pixel_format pixel_format;   /* default: SG_PIXELFORMAT_RGBA8 */
+    int width;
+    int height;
+    int num_mipmaps;                /* including the base level (default: full mipmap chain) */
+    bool srgb;                      /* only 8-bit formats: color channels are sRGB encoded */
+    smip_buffer_t buffer;           /* receives the generated mipmaps */
+} smip_desc_t;
+
+SOKOL_MIPMAP_API_DECL int smip_num_mipmaps(const smip_desc_t* desc);
+SOKOL_MIPMAP_API_DECL int smip_buffer_size(const smip_desc_t* desc);
+SOKOL_MIPMAP_API_DECL int smip_generate(const smip_desc_t* desc, sg_image_content* content);
+
+#ifdef __cplusplus
+} /* extern "C" */
+
+/* reference-based equivalents for c++ */
+inline int smip_num_mipmaps(const smip_desc_t& desc) { return smip_num_mipmaps(&desc); }
+inline int smip_buffer_size(const smip_desc_t& desc) { return smip_buffer_size(&desc); }
+inline int smip_generate(const smip_desc_t& desc, sg_image_content& content) { return smip_generate(&desc, &content); }
+
+#endif
+#endif /* SOKOL_MIPMAP_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_MIPMAP_IMPL
+#define SOKOL_MIPMAP_IMPL_INCLUDED (1)
+
+#include <string.h> // memset, memcpy
+#include <math.h>   // powf
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#if !defined(SOKOL_MIPMAP_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define _SMIP_SSE2 (1)
+        #include <emmintrin.h>
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define _SMIP_NEON (1)
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#define _smip_def(val, def) (((val) == 0) ? (def) : (val))
+#define _SMIP_SRGB_LUT_SIZE (4096)
+
+/* per-call conversion state */
+typedef struct {
+    sg_pixel_format fmt;
+    int num_channels;       /* 1, 2 or 4 */
+    int bytes_per_pixel;
+    bool srgb;
+    float srgb_to_linear[256];                  /* sRGB byte => linear in 0..255 */
+    uint8_t linear_to_srgb[_SMIP_SRGB_LUT_SIZE];/* linear in 0..1 (quantized) => sRGB byte */
+    float* row0;            /* decoded source rows, and filtered destination row */
+    float* row1;
+    float* dst_row;
+} _smip_state_t;
+
+_SOKOL_PRIVATE int _smip_num_channels(sg_pixel_format fmt) {
+    switch (fmt) {
+        case SG_PIXELFORMAT_R8:         return 1;
+        case SG_PIXELFORMAT_RG8:        return 2;
+        case SG_PIXELFORMAT_RGBA8:
+        case SG_PIXELFORMAT_RGBA16F:
+        case SG_PIXELFORMAT_RGBA32F:    return 4;
+        default:                        return 0;
+    }
+}
+
+_SOKOL_PRIVATE int _smip_bytes_per_pixel(sg_pixel_format fmt) {
+    switch (fmt) {
+        case SG_PIXELFORMAT_R8:         return 1;
+        case SG_PIXELFORMAT_RG8:        return 2;
+        case SG_PIXELFORMAT_RGBA8:      return 4;
+        case SG_PIXELFORMAT_RGBA16F:    return 8;
+        case SG_PIXELFORMAT_RGBA32F:    return 16;
+        default:                        return 0;
+    }
+}
+
+_SOKOL_PRIVATE bool _smip_is_8bit(sg_pixel_format fmt) {
+    return (fmt == SG_PIXELFORMAT_R8) || (fmt == SG_PIXELFORMAT_RG8) || (fmt == SG_PIXELFORMAT_RGBA8);
+}
+
+_SOKOL_PRIVATE int _smip_max(int a, int b) {
+    return (a > b) ? a : b;
+}
+
+_SOKOL_PRIVATE int _smip_mip_dim(int dim, int mip_index) {
+    return _smip_max(dim >> mip_index, 1);
+}
+
+_SOKOL_PRIVATE smip_desc_t _smip_desc_defaults(const smip_desc_t* desc) {
+    smip_desc_t res = *desc;
+    res.type = _smip_def(res.type, SG_IMAGETYPE_2D);
+    res.pixel_format = _smip_def(res.pixel_format, SG_PIXELFORMAT_RGBA8);
+    int full_chain = 1;
+    for (int dim = _smip_max(res.width, res.height); dim > 1; dim >>= 1) {
+        full_chain++;
+    }
+    if (full_chain > SG_MAX_MIPMAPS) {
+        full_chain = SG_MAX_MIPMAPS;
+    }
+    res.num_mipmaps = _smip_def(res.num_mipmaps, full_chain);
+    if (res.num_mipmaps > full_chain) {
+        res.num_mipmaps = full_chain;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE bool _smip_desc_valid(const smip_desc_t* desc) {
+    return (desc->width > 0) && (desc->height > 0) &&
+           (desc->num_mipmaps > 0) &&
+           ((desc->type == SG_IMAGETYPE_2D) || (desc->type == SG_IMAGETYPE_CUBE)) &&
+           (_smip_num_channels(desc->pixel_format) > 0);
+}
+
+_SOKOL_PRIVATE int _smip_num_faces(const smip_desc_t* desc) {
+    return (desc->type == SG_IMAGETYPE_CUBE) ? SG_CUBEFACE_NUM : 1;
+}
+
+_SOKOL_PRIVATE int _smip_surface_size(const smip_desc_t* desc, int mip_index) {
+    return _smip_mip_dim(desc->width, mip_index) * _smip_mip_dim(desc->height, mip_index) * _smip_bytes_per_pixel(desc->pixel_format);
+}
+
+/*-- half-float conversion ---------------------------------------------------*/
+_SOKOL_PRIVATE float _smip_half_to_float(uint16_t h) {
+    const uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    const uint32_t exp = (h >> 10) & 0x1F;
+    uint32_t mant = h & 0x3FF;
+    uint32_t bits;
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        }
+        else {
+            /* denormal, normalize */
+            int e = -1;
+            do {
+                e++;
+                mant <<= 1;
+            } while ((mant & 0x400) == 0);
+            bits = sign | ((uint32_t)(127 - 15 - e) << 23) | ((mant & 0x3FF) << 13);
+        }
+    }
+    else if (exp == 0x1F) {
+        bits = sign | 0x7F800000 | (mant << 13);
+    }
+    else {
+        bits = sign | ((exp + (127 - 15)) << 23) | (mant << 13);
+    }
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+_SOKOL_PRIVATE uint16_t _smip_float_to_half(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    const int exp = (int)((bits >> 23) & 0xFF);
+    const uint32_t mant = bits & 0x7FFFFF;
+    if (exp == 0xFF) {
+        /* inf or nan */
+        return (uint16_t)(sign | 0x7C00 | (mant ? 0x200 : 0));
+    }
+    const int half_exp = exp - 127 + 15;
+    if (half_exp >= 0x1F) {
+        /* overflow => inf */
+        return (uint16_t)(sign | 0x7C00);
+    }
+    if (half_exp <= 0) {
+        if (half_exp < -10) {
+            return sign;
+        }
+        /* denormal, round to nearest even */
+        const uint32_t m = mant | 0x800000;
+        const int shift = 14 - half_exp;
+        uint32_t half_mant = m >> shift;
+        const uint32_t rem = m & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if ((rem > halfway) || ((rem == halfway) && (half_mant & 1))) {
+            half_mant++;
+        }
+        return (uint16_t)(sign | half_mant);
+    }
+    /* normal, round to nearest even (a mantissa overflow correctly bumps the exponent) */
+    uint32_t h = ((uint32_t)half_exp << 10) | (mant >> 13);
+    const uint32_t rem = mant & 0x1FFF;
+    if ((rem > 0x1000) || ((rem == 0x1000) && (h & 1))) {
+        h++;
+    }
+    return (uint16_t)(sign | h);
+}
+
+/*-- row conversion ----------------------------------------------------------*/
+
+/* 8-bit values are kept in the 0..255 range to get exact integer rounding */
+_SOKOL_PRIVATE void _smip_decode_u8(const uint8_t* src, float* dst, int num) {
+    int i = 0;
+    #if defined(_SMIP_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= num; i += 16) {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+            const __m128i lo = _mm_unpacklo_epi8(v, zero);
+            const __m128i hi = _mm_unpackhi_epi8(v, zero);
+            _mm_storeu_ps(dst + i + 0, _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)));
+            _mm_storeu_ps(dst + i + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)));
+            _mm_storeu_ps(dst + i + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)));
+            _mm_storeu_ps(dst + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)));
+        }
+    #elif defined(_SMIP_NEON)
+        for (; i + 16 <= num; i += 16) {
+            const uint8x16_t v = vld1q_u8(src + i);
+            const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+            const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+            vst1q_f32(dst + i + 0, vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))));
+            vst1q_f32(dst + i + 4, vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))));
+            vst1q_f32(dst + i + 8, vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))));
+            vst1q_f32(dst + i + 12, vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))));
+        }
+    #endif
+    for (; i < num; i++) {
+        dst[i] = (float)src[i];
+    }
+}
+
+/* values are in the 0..255 range and never negative, so truncation after
+   adding 0.5 is round-half-up, same as (a+b+c+d+2)>>2 in integer math
+*/
+_SOKOL_PRIVATE void _smip_encode_u8(const float* src, uint8_t* dst, int num) {
+    int i = 0;
+    #if defined(_SMIP_SSE2)
+        const __m128 half = _mm_set1_ps(0.5f);
+        for (; i + 16 <= num; i += 16) {
+            const __m128i a = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(src + i + 0), half));
+            const __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(src + i + 4), half));
+            const __m128i c = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(src + i + 8), half));
+            const __m128i d = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(src + i + 12), half));
+            const __m128i ab = _mm_packs_epi32(a, b);
+            const __m128i cd = _mm_packs_epi32(c, d);
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(ab, cd));
+        }
+    #elif defined(_SMIP_NEON)
+        const float32x4_t half = vdupq_n_f32(0.5f);
+        for (; i + 16 <= num; i += 16) {
+            const uint32x4_t a = vcvtq_u32_f32(vaddq_f32(vld1q_f32(src + i + 0), half));
+            const uint32x4_t b = vcvtq_u32_f32(vaddq_f32(vld1q_f32(src + i + 4), half));
+            const uint32x4_t c = vcvtq_u32_f32(vaddq_f32(vld1q_f32(src + i + 8), half));
+            const uint32x4_t d = vcvtq_u32_f32(vaddq_f32(vld1q_f32(src + i + 12), half));
+            const uint16x8_t ab = vcombine_u16(vqmovn_u32(a), vqmovn_u32(b));
+            const uint16x8_t cd = vcombine_u16(vqmovn_u32(c), vqmovn_u32(d));
+            vst1q_u8(dst + i, vcombine_u8(vqmovn_u16(ab), vqmovn_u16(cd)));
+        }
+    #endif
+    for (; i < num; i++) {
+        dst[i] = (uint8_t)(src[i] + 0.5f);
+    }
+}
+
+_SOKOL_PRIVATE bool _smip_is_srgb_channel(const _smip_state_t* st, int i) {
+    /* the alpha channel of RGBA8 is always linear */
+    return (st->num_channels != 4) || ((i & 3) != 3);
+}
+
+_SOKOL_PRIVATE void _smip_decode_row(const _smip_state_t* st, const void* src, float* dst, int num_pixels) {
+    const int num = num_pixels * st->num_channels;
+    switch (st->fmt) {
+        case SG_PIXELFORMAT_R8:
+        case SG_PIXELFORMAT_RG8:
+        case SG_PIXELFORMAT_RGBA8:
+            if (st->srgb) {
+                const uint8_t* s = (const uint8_t*) src;
+                for (int i = 0; i < num; i++) {
+                    dst[i] = _smip_is_srgb_channel(st, i) ? st->srgb_to_linear[s[i]] : (float)s[i];
+                }
+            }
+            else {
+                _smip_decode_u8((const uint8_t*)src, dst, num);
+            }
+            break;
+        case SG_PIXELFORMAT_RGBA16F:
+            {
+                const uint8_t* s = (const uint8_t*) src;
+                for (int i = 0; i < num; i++) {
+                    uint16_t h;
+                    memcpy(&h, s + i * 2, sizeof(h));
+                    dst[i] = _smip_half_to_float(h);
+                }
+            }
+            break;
+        case SG_PIXELFORMAT_RGBA32F:
+            memcpy(dst, src, (size_t)num * sizeof(float));
+            break;
+        default:
+            SOKOL_ASSERT(false);
+            break;
+    }
+}
+
+_SOKOL_PRIVATE void _smip_encode_row(const _smip_state_t* st, const float* src, void* dst, int num_pixels) {
+    const int num = num_pixels * st->num_channels;
+    switch (st->fmt) {
+        case SG_PIXELFORMAT_R8:
+        case SG_PIXELFORMAT_RG8:
+        case SG_PIXELFORMAT_RGBA8:
+            if (st->srgb) {
+                uint8_t* d = (uint8_t*) dst;
+                const float scale = (float)(_SMIP_SRGB_LUT_SIZE - 1) / 255.0f;
+                for (int i = 0; i < num; i++) {
+                    if (_smip_is_srgb_channel(st, i)) {
+                        d[i] = st->linear_to_srgb[(int)(src[i] * scale + 0.5f)];
+                    }
+                    else {
+                        d[i] = (uint8_t)(src[i] + 0.5f);
+                    }
+                }
+            }
+            else {
+                _smip_encode_u8(src, (uint8_t*)dst, num);
+            }
+            break;
+        case SG_PIXELFORMAT_RGBA16F:
+            {
+                uint8_t* d = (uint8_t*) dst;
+                for (int i = 0; i < num; i++) {
+                    const uint16_t h = _smip_float_to_half(src[i]);
+                    memcpy(d + i * 2, &h, sizeof(h));
+                }
+            }
+            break;
+        case SG_PIXELFORMAT_RGBA32F:
+            memcpy(dst, src, (size_t)num * sizeof(float));
+            break;
+        default:
+            SOKOL_ASSERT(false);
+            break;
+    }
+}
+
+/*-- filter kernels ----------------------------------------------------------*/
+_SOKOL_PRIVATE void _smip_add_rows(float* a, const float* b, int num) {
+    int i = 0;
+    #if defined(_SMIP_SSE2)
+        for (; i + 4 <= num; i += 4) {
+            _mm_storeu_ps(a + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+    #elif defined(_SMIP_NEON)
+        for (; i + 4 <= num; i += 4) {
+            vst1q_f32(a + i, vaddq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+        }
+    #endif
+    for (; i < num; i++) {
+        a[i] += b[i];
+    }
+}
+
+/* sum horizontal pixel pairs of a row which already contains the sum
+   of two source rows and scale by 1/4
+*/
+_SOKOL_PRIVATE void _smip_halve_row(const float* src, float* dst, int src_width, int nc) {
+    const int dst_width = _smip_max(src_width >> 1, 1);
+    if (src_width == 1) {
+        for (int c = 0; c < nc; c++) {
+            dst[c] = src[c] * 0.5f;
+        }
+        return;
+    }
+    int x = 0;
+    #if defined(_SMIP_SSE2)
+        const __m128 quarter = _mm_set1_ps(0.25f);
+        if (nc == 4) {
+            for (; x < dst_width; x++) {
+                const __m128 p0 = _mm_loadu_ps(src + x * 8);
+                const __m128 p1 = _mm_loadu_ps(src + x * 8 + 4);
+                _mm_storeu_ps(dst + x * 4, _mm_mul_ps(_mm_add_ps(p0, p1), quarter));
+            }
+        }
+        else if (nc == 2) {
+            for (; x + 2 <= dst_width; x += 2) {
+                const __m128 a = _mm_loadu_ps(src + x * 4);
+                const __m128 b = _mm_loadu_ps(src + x * 4 + 4);
+                const __m128 even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1,0,1,0));
+                const __m128 odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,2,3,2));
+                _mm_storeu_ps(dst + x * 2, _mm_mul_ps(_mm_add_ps(even, odd), quarter));
+            }
+        }
+        else {
+            for (; x + 4 <= dst_width; x += 4) {
+                const __m128 a = _mm_loadu_ps(src + x * 2);
+                const __m128 b = _mm_loadu_ps(src + x * 2 + 4);
+                const __m128 even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+                const __m128 odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+                _mm_storeu_ps(dst + x, _mm_mul_ps(_mm_add_ps(even, odd), quarter));
+            }
+        }
+    #elif defined(_SMIP_NEON)
+        if (nc == 4) {
+            for (; x < dst_width; x++) {
+                const float32x4_t p0 = vld1q_f32(src + x * 8);
+                const float32x4_t p1 = vld1q_f32(src + x * 8 + 4);
+                vst1q_f32(dst + x * 4, vmulq_n_f32(vaddq_f32(p0, p1), 0.25f));
+            }
+        }
+        else if (nc == 2) {
+            for (; x + 4 <= dst_width; x += 4) {
+                /* val[0],val[1]: even pixels, val[2],val[3]: odd pixels */
+                const float32x4x4_t v = vld4q_f32(src + x * 4);
+                float32x4x2_t r;
+                r.val[0] = vmulq_n_f32(vaddq_f32(v.val[0], v.val[2]), 0.25f);
+                r.val[1] = vmulq_n_f32(vaddq_f32(v.val[1], v.val[3]), 0.25f);
+                vst2q_f32(dst + x * 2, r);
+            }
+        }
+        else {
+            for (; x + 4 <= dst_width; x += 4) {
+                const float32x4x2_t v = vld2q_f32(src + x * 2);
+                vst1q_f32(dst + x, vmulq_n_f32(vaddq_f32(v.val[0], v.val[1]), 0.25f));
+            }
+        }
+    #endif
+    for (; x < dst_width; x++) {
+        for (int c = 0; c < nc; c++) {
+            dst[x * nc + c] = (src[(2 * x) * nc + c] + src[(2 * x + 1) * nc + c]) * 0.25f;
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _smip_downsample(_smip_state_t* st, const uint8_t* src, int src_width, int src_height, uint8_t* dst) {
+    const int dst_width = _smip_max(src_width >> 1, 1);
+    const int dst_height = _smip_max(src_height >> 1, 1);
+    const int src_pitch = src_width * st->bytes_per_pixel;
+    const int dst_pitch = dst_width * st->bytes_per_pixel;
+    const int row_num = src_width * st->num_channels;
+    for (int y = 0; y < dst_height; y++) {
+        const int y0 = 2 * y;
+        const int y1 = (y0 + 1 < src_height) ? (y0 + 1) : y0;
+        _smip_decode_row(st, src + y0 * src_pitch, st->row0, src_width);
+        _smip_decode_row(st, src + y1 * src_pitch, st->row1, src_width);
+        _smip_add_rows(st->row0, st->row1, row_num);
+        _smip_halve_row(st->row0, st->dst_row, src_width, st->num_channels);
+        _smip_encode_row(st, st->dst_row, dst + y * dst_pitch, dst_width);
+    }
+}
+
+_SOKOL_PRIVATE void _smip_init_srgb_tables(_smip_state_t* st) {
+    for (int i = 0; i < 256; i++) {
+        const float c = (float)i / 255.0f;
+        const float lin = (c <= 0.04045f) ? (c / 12.92f) : powf((c + 0.055f) / 1.055f, 2.4f);
+        st->srgb_to_linear[i] = lin * 255.0f;
+    }
+    for (int i = 0; i < _SMIP_SRGB_LUT_SIZE; i++) {
+        const float lin = (float)i / (float)(_SMIP_SRGB_LUT_SIZE - 1);
+        const float c = (lin <= 0.0031308f) ? (lin * 12.92f) : (1.055f * powf(lin, 1.0f / 2.4f) - 0.055f);
+        st->linear_to_srgb[i] = (uint8_t)(c * 255.0f + 0.5f);
+    }
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL int smip_num_mipmaps(const smip_desc_t* in_desc) {
+    SOKOL_ASSERT(in_desc);
+    const smip_desc_t desc = _smip_desc_defaults(in_desc);
+    if (!_smip_desc_valid(&desc)) {
+        return 0;
+    }
+    return desc.num_mipmaps;
+}
+
+SOKOL_API_IMPL int smip_buffer_size(const smip_desc_t* in_desc) {
+    SOKOL_ASSERT(in_desc);
+    const smip_desc_t desc = _smip_desc_defaults(in_desc);
+    if (!_smip_desc_valid(&desc)) {
+        return 0;
+    }
+    int size = 0;
+    for (int mip_index = 1; mip_index < desc.num_mipmaps; mip_index++) {
+        size += _smip_surface_size(&desc, mip_index);
+    }
+    return size * _smip_num_faces(&desc);
+}
+
+SOKOL_API_IMPL int smip_generate(const smip_desc_t* in_desc, sg_image_content* content) {
+    SOKOL_ASSERT(in_desc && content);
+    const smip_desc_t desc = _smip_desc_defaults(in_desc);
+    if (!_smip_desc_valid(&desc)) {
+        return 0;
+    }
+    const int num_faces = _smip_num_faces(&desc);
+    const int base_size = _smip_surface_size(&desc, 0);
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        const sg_subimage_content* base = &content->subimage[face_index][0];
+        if ((0 == base->ptr) || (base->size < base_size)) {
+            return 0;
+        }
+    }
+    if ((desc.num_mipmaps > 1) && ((0 == desc.buffer.ptr) || (desc.buffer.size < smip_buffer_size(&desc)))) {
+        return 0;
+    }
+    _smip_state_t* st = (_smip_state_t*) SOKOL_MALLOC(sizeof(_smip_state_t));
+    SOKOL_ASSERT(st);
+    memset(st, 0, sizeof(_smip_state_t));
+    st->fmt = desc.pixel_format;
+    st->num_channels = _smip_num_channels(desc.pixel_format);
+    st->bytes_per_pixel = _smip_bytes_per_pixel(desc.pixel_format);
+    st->srgb = desc.srgb && _smip_is_8bit(desc.pixel_format);
+    if (st->srgb) {
+        _smip_init_srgb_tables(st);
+    }
+    const size_t row_bytes = (size_t)(desc.width * st->num_channels) * sizeof(float);
+    st->row0 = (float*) SOKOL_MALLOC(row_bytes);
+    st->row1 = (float*) SOKOL_MALLOC(row_bytes);
+    st->dst_row = (float*) SOKOL_MALLOC(row_bytes);
+    SOKOL_ASSERT(st->row0 && st->row1 && st->dst_row);
+
+    uint8_t* dst_ptr = (uint8_t*) desc.buffer.ptr;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 1; mip_index < desc.num_mipmaps; mip_index++) {
+            const sg_subimage_content* src = &content->subimage[face_index][mip_index - 1];
+            _smip_downsample(st, (const uint8_t*) src->ptr,
+                _smip_mip_dim(desc.width, mip_index - 1),
+                _smip_mip_dim(desc.height, mip_index - 1),
+                dst_ptr);
+            const int size = _smip_surface_size(&desc, mip_index);
+            content->subimage[face_index][mip_index].ptr = dst_ptr;
+            content->subimage[face_index][mip_index].size = size;
+            dst_ptr += size;
+        }
+    }
+    SOKOL_FREE(st->dst_row);
+    SOKOL_FREE(st->row1);
+    SOKOL_FREE(st->row0);
+    SOKOL_FREE(st);
+    return desc.num_mipmaps;
+}
+
+#endif /* SOKOL_MIPMAP_IMPL */